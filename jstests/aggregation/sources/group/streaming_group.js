@@ -0,0 +1,49 @@
+/**
+ * Tests that a $group whose input is sorted on the group key by an index returns the same groups
+ * as a $group that hashes its whole input, including for null, missing and array keys.
+ */
+(function() {
+    "use strict";
+    const coll = db.streaming_group;
+
+    coll.drop();
+
+    let value = 0;
+    for (let a of [null, undefined, 1, 2, [1, 2], [2, 1], "x", {sub: 1}]) {
+        for (let i = 0; i < 3; i++) {
+            assert.writeOK(coll.insert({a: a, b: {c: a}, value: value++}));
+        }
+    }
+    for (let i = 0; i < 3; i++) {
+        assert.writeOK(coll.insert({value: value++}));
+        assert.writeOK(coll.insert({b: 1, value: value++}));
+    }
+
+    const pipelines = [
+        [{$sort: {a: 1}}, {$group: {_id: "$a", s: {$sum: "$value"}, n: {$sum: 1}}}],
+        [{$sort: {a: -1}}, {$group: {_id: {x: "$a"}, s: {$sum: "$value"}}}],
+        [{$sort: {"b.c": 1}}, {$group: {_id: "$b.c", s: {$sum: "$value"}}}],
+        [{$sort: {a: 1, "b.c": 1}}, {$group: {_id: {x: "$a", y: "$b.c"}, s: {$push: "$value"}}}],
+    ];
+
+    function runAll(withSort) {
+        return pipelines.map(function(pipeline) {
+            const results = coll.aggregate(withSort ? pipeline : pipeline.slice(1)).toArray();
+            results.forEach(function(result) {
+                if (result.s instanceof Array) {
+                    result.s.sort((lhs, rhs) => lhs - rhs);
+                }
+            });
+            return results.sort((lhs, rhs) => bsonWoCompare(lhs, rhs));
+        });
+    }
+
+    // Without a sorted input the $group stages must read all of their input before returning.
+    const expected = runAll(false);
+    assert.eq(expected, runAll(true));
+
+    // With indexes the sorts are provided by the index scans instead of $sort stages.
+    assert.commandWorked(coll.createIndex({a: 1, "b.c": 1}));
+    assert.commandWorked(coll.createIndex({"b.c": 1}));
+    assert.eq(expected, runAll(true));
+}());
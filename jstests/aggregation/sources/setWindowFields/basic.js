@@ -0,0 +1,78 @@
+/**
+ * Tests that $setWindowFields computes running and moving aggregates over sorted partitions.
+ */
+
+(function() {
+    "use strict";
+
+    const coll = db.set_window_fields_basic;
+    coll.drop();
+
+    // Two sensors, each with a reading every minute, inserted out of order.
+    for (let minute = 9; minute >= 0; minute--) {
+        assert.writeOK(coll.insert({sensor: "a", minute: minute, reading: minute}));
+        assert.writeOK(coll.insert({sensor: "b", minute: minute, reading: 10 * minute}));
+    }
+
+    let results = coll.aggregate([
+                          {
+                            $setWindowFields: {
+                                partitionBy: "$sensor",
+                                sortBy: {minute: 1},
+                                output: {
+                                    total:
+                                        {$sum: "$reading", window: {documents: ["unbounded", 0]}},
+                                    movingAvg: {$avg: "$reading", window: {documents: [-2, 0]}},
+                                    recentMax: {$max: "$reading", window: {documents: [-1, 1]}},
+                                    count: {$sum: 1}
+                                }
+                            }
+                          },
+                          {$project: {_id: 0}}
+                      ])
+                      .toArray();
+    assert.eq(20, results.length, tojson(results));
+
+    for (let i = 0; i < 20; i++) {
+        const sensor = i < 10 ? "a" : "b";
+        const scale = i < 10 ? 1 : 10;
+        const minute = i % 10;
+        const windowStart = Math.max(0, minute - 2);
+        assert.eq({
+            sensor: sensor,
+            minute: minute,
+            reading: scale * minute,
+            total: scale * minute * (minute + 1) / 2,
+            movingAvg: scale * (windowStart + minute) / 2,
+            recentMax: scale * Math.min(9, minute + 1),
+            count: 10
+        },
+                  results[i]);
+    }
+
+    // A computed partition key is not visible in the output.
+    results = coll.aggregate([
+                      {$match: {sensor: "a"}},
+                      {
+                        $setWindowFields: {
+                            partitionBy: {$mod: ["$minute", 2]},
+                            sortBy: {minute: 1},
+                            output: {evenOrOddTotal: {$sum: "$reading"}}
+                        }
+                      },
+                      {$sort: {minute: 1}},
+                      {$project: {_id: 0, sensor: 0, reading: 0}}
+                  ])
+                  .toArray();
+    assert.eq(10, results.length, tojson(results));
+    for (let i = 0; i < 10; i++) {
+        assert.eq({minute: i, evenOrOddTotal: i % 2 === 0 ? 20 : 25}, results[i]);
+    }
+
+    // Invalid window bounds are rejected.
+    assert.commandFailedWithCode(db.runCommand({
+        aggregate: coll.getName(),
+        pipeline: [{$setWindowFields: {output: {x: {$sum: 1, window: {documents: [1, 0]}}}}}]
+    }),
+                                 40404);
+}());
@@ -0,0 +1,36 @@
+// Tests that the index keys of a batch of inserted documents are all added, including multikey
+// and unique indexes, whatever the order of the keys across the batch.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    var coll = db.batch_insert_index_keys;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: -1}, {unique: true}));
+
+    var docs = [];
+    for (var i = 0; i < 100; i++) {
+        docs.push({_id: i, a: (i % 2 === 0) ? [100 - i, i] : 100 - i, b: (i * 37) % 100});
+    }
+    assert.writeOK(coll.insert(docs));
+
+    assert.eq(100, coll.find().hint({a: 1}).itcount());
+    assert.eq(100, coll.find().hint({b: -1}).itcount());
+    assert.eq(2, coll.find({a: 50}).hint({a: 1}).itcount());
+
+    var explain = coll.find({a: 1}).hint({a: 1}).explain();
+    var ixscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+    assert(ixscan.isMultiKey, tojson(explain));
+
+    // A duplicate within the batch fails the second document only.
+    var res = coll.insert([{_id: 100, b: 1000}, {_id: 101, b: 1000}, {_id: 102, b: 1001}],
+                          {ordered: false});
+    assert.writeError(res);
+    assert.eq(1, res.getWriteErrors().length, tojson(res));
+    assert.eq(1, res.getWriteErrors()[0].index, tojson(res));
+    assert.eq(102, coll.find().itcount());
+    assert(coll.validate(true).valid);
+})();
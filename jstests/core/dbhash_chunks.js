@@ -0,0 +1,78 @@
+// Tests dbHash's chunkSize option, which also returns a digest for every range of about chunkSize
+// documents in _id order. The ranges are cut on _id values, so that a document which is missing
+// on one node only changes the digest of its own range.
+(function() {
+    "use strict";
+
+    var t = db.dbhash_chunks;
+    t.drop();
+    var bulk = t.initializeUnorderedBulkOp();
+    for (var i = 0; i < 200; i++) {
+        bulk.insert({_id: i, x: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    function getChunks() {
+        var res = assert.commandWorked(
+            db.runCommand({dbHash: 1, collections: [t.getName()], chunkSize: 10}));
+        return res.chunks[t.getName()];
+    }
+
+    var whole = assert.commandWorked(db.runCommand({dbHash: 1, collections: [t.getName()]}));
+    assert(!whole.hasOwnProperty("chunks"), tojson(whole));
+
+    var res = assert.commandWorked(
+        db.runCommand({dbHash: 1, collections: [t.getName()], chunkSize: 10}));
+    assert.eq(whole.collections[t.getName()], res.collections[t.getName()], tojson(res));
+
+    // The ranges cover every document, in _id order and without overlapping.
+    var chunks = res.chunks[t.getName()];
+    assert.gt(chunks.length, 1, tojson(chunks));
+    var total = 0;
+    for (var i = 0; i < chunks.length; i++) {
+        assert.lte(chunks[i].min, chunks[i].max, tojson(chunks));
+        if (i > 0) {
+            assert.lt(chunks[i - 1].max, chunks[i].min, tojson(chunks));
+        }
+        total += chunks[i].count;
+    }
+    assert.eq(0, chunks[0].min, tojson(chunks));
+    assert.eq(199, chunks[chunks.length - 1].max, tojson(chunks));
+    assert.eq(200, total, tojson(chunks));
+
+    // The same data is always cut into the same ranges.
+    assert.eq(chunks, getChunks());
+
+    function changedDigests(before, after) {
+        var digests = {};
+        before.forEach(function(chunk) {
+            digests[chunk.md5] = true;
+        });
+        return after.filter(function(chunk) {
+            return !digests[chunk.md5];
+        });
+    }
+
+    // Changing one document only changes the digest of its own range.
+    assert.writeOK(t.update({_id: 55}, {$set: {x: -1}}));
+    var changed = getChunks();
+    assert.eq(chunks.length, changed.length, tojson(changed));
+    var diff = changedDigests(chunks, changed);
+    assert.eq(1, diff.length, tojson(diff));
+    assert.lte(diff[0].min, 55);
+    assert.gte(diff[0].max, 55);
+
+    // Removing a document does not shift the later ranges: only the range it was in changes, and
+    // it merges with the next one if the removed document ended it.
+    assert.writeOK(t.update({_id: 55}, {$set: {x: 55}}));
+    assert.writeOK(t.remove({_id: 20}));
+    diff = changedDigests(chunks, getChunks());
+    assert.lte(diff.length, 1, tojson(diff));
+    if (diff.length) {
+        assert.lte(diff[0].min, 21, tojson(diff));
+        assert.gte(diff[0].max, 19, tojson(diff));
+    }
+
+    assert.commandFailedWithCode(db.runCommand({dbHash: 1, chunkSize: 0}), ErrorCodes.BadValue);
+    assert.commandFailedWithCode(db.runCommand({dbHash: 1, chunkSize: "a"}), ErrorCodes.BadValue);
+})();
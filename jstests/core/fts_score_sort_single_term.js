@@ -0,0 +1,42 @@
+// Tests that a single-term text search sorted by text score is answered in index order, without a
+// blocking sort, and that a limit stops it early.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    var t = db.fts_score_sort_single_term;
+    t.drop();
+
+    for (var i = 0; i < 50; i++) {
+        // Documents with more occurrences of 'quick' relative to their length score higher.
+        var words = ["quick"];
+        for (var j = 0; j < i; j++) {
+            words.push("filler" + j);
+        }
+        assert.writeOK(t.insert({_id: i, a: words.join(" ")}));
+    }
+    assert.writeOK(t.insert({_id: 50, a: "unrelated"}));
+    assert.commandWorked(t.ensureIndex({a: "text"}));
+
+    var query = {$text: {$search: "quick"}};
+    var proj = {score: {$meta: "textScore"}};
+    var sort = {score: {$meta: "textScore"}};
+
+    var results = t.find(query, proj).sort(sort).toArray();
+    assert.eq(50, results.length);
+    for (var k = 1; k < results.length; k++) {
+        assert.gte(results[k - 1].score, results[k].score, tojson(results));
+    }
+
+    var limited = t.find(query, proj).sort(sort).limit(5).toArray();
+    assert.eq(results.slice(0, 5), limited);
+
+    var explain = t.find(query, proj).sort(sort).limit(5).explain("executionStats");
+    assert(!planHasStage(explain.queryPlanner.winningPlan, "SORT"), tojson(explain));
+    assert.lt(explain.executionStats.totalKeysExamined, 50, tojson(explain));
+
+    // A search for two terms still needs the sort, since the scores of both terms add up.
+    explain = t.find({$text: {$search: "quick filler1"}}, proj).sort(sort).limit(5).explain();
+    assert(planHasStage(explain.queryPlanner.winningPlan, "SORT"), tojson(explain));
+})();
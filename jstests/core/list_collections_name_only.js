@@ -0,0 +1,50 @@
+// Test that listCollections with nameOnly returns just the name and type of each collection.
+(function() {
+    "use strict";
+    var mydb = db.getSiblingDB("list_collections_name_only");
+    assert.commandWorked(mydb.dropDatabase());
+
+    assert.commandWorked(mydb.createCollection("capped", {capped: true, size: 4096}));
+    assert.commandWorked(mydb.createCollection("plain"));
+    assert.commandWorked(mydb.createView("view", "plain", []));
+
+    function listCollections(cmd) {
+        var res = assert.commandWorked(mydb.runCommand(cmd));
+        return new DBCommandCursor(mydb.getMongo(), res)
+            .toArray()
+            .filter(function(entry) {
+                return entry.name !== "system.indexes" && entry.name !== "system.views";
+            })
+            .sort(function(a, b) {
+                return a.name < b.name ? -1 : (a.name > b.name ? 1 : 0);
+            });
+    }
+
+    assert.eq(
+        [
+          {name: "capped", type: "collection"},
+          {name: "plain", type: "collection"},
+          {name: "view", type: "view"}
+        ],
+        listCollections({listCollections: 1, nameOnly: true}));
+
+    // The filter is applied to the reduced entries.
+    assert.eq([{name: "plain", type: "collection"}],
+              listCollections({listCollections: 1, nameOnly: true, filter: {name: "plain"}}));
+    assert.eq([],
+              listCollections(
+                  {listCollections: 1, nameOnly: true, filter: {"options.capped": true}}));
+
+    // Without nameOnly the full entries are returned.
+    var full = listCollections({listCollections: 1, filter: {name: "capped"}});
+    assert.eq(1, full.length, tojson(full));
+    assert(full[0].options.capped, tojson(full));
+
+    assert.commandFailedWithCode(mydb.runCommand({listCollections: 1, nameOnly: "yes"}),
+                                 ErrorCodes.TypeMismatch);
+
+    assert.eq(["capped", "plain", "view"],
+              mydb.getCollectionNames().filter(function(name) {
+                  return name !== "system.indexes" && name !== "system.views";
+              }));
+})();
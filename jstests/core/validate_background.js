@@ -0,0 +1,32 @@
+// Tests validate's background option, which validates under intent locks on storage engines with
+// document-level locking.
+(function() {
+    "use strict";
+
+    if (db.isMaster().msg === "isdbgrid") {
+        return;
+    }
+
+    var t = db.validate_background;
+    t.drop();
+    assert.commandWorked(t.createIndex({a: 1}));
+    for (var i = 0; i < 100; i++) {
+        assert.writeOK(t.insert({_id: i, a: i}));
+    }
+
+    var isMMAPv1 = db.serverStatus().storageEngine.name === "mmapv1";
+
+    [{}, {full: true}].forEach(function(options) {
+        var cmd = Object.extend({validate: t.getName(), background: true}, options);
+        var res = db.runCommand(cmd);
+        if (isMMAPv1) {
+            assert.commandFailedWithCode(res, ErrorCodes.CommandNotSupported);
+            return;
+        }
+
+        assert.commandWorked(res);
+        assert(res.valid, tojson(res));
+        assert.eq(100, res.nrecords, tojson(res));
+        assert.eq(100, res.keysPerIndex[t.getFullName() + ".$a_1"], tojson(res));
+    });
+})();
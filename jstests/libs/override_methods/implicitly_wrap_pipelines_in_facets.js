@@ -39,6 +39,7 @@
             '$geoNear',
             '$indexStats',
             '$out',
+            '$queryStats',
         ];
         for (let stageSpec of originalPipeline) {
             // Skip wrapping the pipeline in a $facet stage if it has an invalid stage
@@ -0,0 +1,56 @@
+// Test that getDiagnosticDataChunks returns the chunks FTDC writes as it writes them.
+
+(function() {
+    'use strict';
+
+    var conn = MongoRunner.runMongod({
+        setParameter: {
+            diagnosticDataCollectionPeriodMillis: 100,
+            diagnosticDataCollectionSamplesPerChunk: 10,
+            diagnosticDataCollectionSamplesPerInterimUpdate: 2,
+        }
+    });
+    var admin = conn.getDB("admin");
+
+    // The command requires the admin database.
+    assert.commandFailed(conn.getDB("test").runCommand({getDiagnosticDataChunks: 1}));
+
+    assert.commandFailed(admin.runCommand({getDiagnosticDataChunks: 1, after: -1}));
+    assert.commandFailed(admin.runCommand({getDiagnosticDataChunks: 1, maxAwaitTimeMS: -1}));
+
+    // Follow the chunks until both metadata and metric chunks have been returned.
+    var after = 0;
+    var seenMetadata = false;
+    var seenMetrics = false;
+    var seenInterim = false;
+    assert.soon(function() {
+        var res = assert.commandWorked(
+            admin.runCommand({getDiagnosticDataChunks: 1, after: after, maxAwaitTimeMS: 1000}));
+        assert.gte(res.nextAfter, after, tojson(res));
+
+        res.chunks.forEach(function(chunk) {
+            assert.gt(chunk.seq, after, tojson(res));
+            if (chunk.doc.type === 0) {
+                seenMetadata = true;
+            } else if (chunk.doc.type === 1) {
+                assert(chunk.doc.hasOwnProperty("data"), tojson(chunk));
+                seenMetrics = true;
+            }
+        });
+        if (res.hasOwnProperty("interim")) {
+            assert.eq(res.interim.doc.type, 1, tojson(res));
+            seenInterim = true;
+        }
+
+        after = res.nextAfter;
+        return seenMetadata && seenMetrics && seenInterim;
+    }, "did not receive metadata, metric and interim chunks");
+
+    // Asking for chunks after the latest returns promptly with nothing new.
+    var res = assert.commandWorked(
+        admin.runCommand({getDiagnosticDataChunks: 1, after: 1 << 30, maxAwaitTimeMS: 0}));
+    assert.eq(res.chunks.length, 0, tojson(res));
+    assert(!res.hasOwnProperty("interim"), tojson(res));
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,131 @@
+/**
+ * Tests that materialized views are populated on creation, are kept up to date by inserts, updates
+ * and deletes on their source collection, and are replicated to secondaries.
+ */
+(function() {
+    'use strict';
+
+    const rst = new ReplSetTest({nodes: 2});
+    rst.startSet();
+    rst.initiate();
+
+    const primaryDB = rst.getPrimary().getDB('test');
+    const source = primaryDB.source;
+
+    function assertContents(viewName, expected) {
+        assert.eq(expected, primaryDB[viewName].find().sort({_id: 1}).toArray());
+    }
+
+    assert.writeOK(source.insert({_id: 1, status: 'open', region: 'eu', amount: 10}));
+    assert.writeOK(source.insert({_id: 2, status: 'closed', region: 'eu', amount: 5}));
+
+    // Pipelines which cannot be maintained incrementally are rejected.
+    assert.commandFailedWithCode(
+        primaryDB.runCommand(
+            {create: 'bad', viewOn: 'source', pipeline: [{$sort: {a: 1}}], materialized: true}),
+        ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(primaryDB.runCommand({
+        create: 'bad',
+        viewOn: 'source',
+        pipeline: [{$group: {_id: '$region', total: {$sum: '$amount'}}}],
+        materialized: true
+    }),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(primaryDB.runCommand({
+        create: 'bad',
+        viewOn: 'source',
+        pipeline: [{$project: {_id: 0, amount: 1}}],
+        materialized: true
+    }),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(
+        primaryDB.runCommand({create: 'bad', viewOn: 'bad', materialized: true}),
+        ErrorCodes.GraphContainsCycle);
+
+    assert.commandWorked(primaryDB.runCommand({
+        create: 'openAmounts',
+        viewOn: 'source',
+        pipeline: [{$match: {status: 'open'}}, {$project: {amount: 1}}],
+        materialized: true
+    }));
+    assert.commandWorked(primaryDB.runCommand({
+        create: 'regionTotals',
+        viewOn: 'source',
+        pipeline: [{$group: {_id: '$region', total: {$sum: '$amount'}, count: {$sum: 1}}}],
+        materialized: true
+    }));
+
+    // The views are populated from the existing documents.
+    assertContents('openAmounts', [{_id: 1, amount: 10}]);
+    assertContents('regionTotals', [{_id: 'eu', total: 15, count: 2}]);
+
+    assert.writeOK(source.insert([
+        {_id: 3, status: 'open', region: 'us', amount: 7},
+        {_id: 4, status: 'closed', region: 'us', amount: 1}
+    ]));
+    assertContents('openAmounts', [{_id: 1, amount: 10}, {_id: 3, amount: 7}]);
+    assertContents('regionTotals',
+                   [{_id: 'eu', total: 15, count: 2}, {_id: 'us', total: 8, count: 2}]);
+
+    // An update may move a document into or out of the view, or from one group to another.
+    assert.writeOK(source.update({_id: 1}, {$set: {status: 'closed'}}));
+    assert.writeOK(source.update({_id: 2}, {$set: {status: 'open', region: 'us'}}));
+    assertContents('openAmounts', [{_id: 2, amount: 5}, {_id: 3, amount: 7}]);
+    assertContents('regionTotals',
+                   [{_id: 'eu', total: 10, count: 1}, {_id: 'us', total: 13, count: 3}]);
+
+    // A group is removed once its last document is deleted.
+    assert.writeOK(source.remove({_id: 1}));
+    assert.writeOK(source.remove({_id: 3}));
+    assertContents('openAmounts', [{_id: 2, amount: 5}]);
+    assertContents('regionTotals', [{_id: 'us', total: 6, count: 2}]);
+
+    // Population spans several batches, each committed on its own.
+    const bulk = primaryDB.many.initializeUnorderedBulkOp();
+    for (let i = 0; i < 2500; ++i) {
+        bulk.insert({_id: i, parity: i % 2});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(primaryDB.runCommand({
+        create: 'parityCounts',
+        viewOn: 'many',
+        pipeline: [{$group: {_id: '$parity', count: {$sum: 1}}}],
+        materialized: true
+    }));
+    assertContents('parityCounts', [{_id: 0, count: 1250}, {_id: 1, count: 1250}]);
+
+    // Documents a capped collection deletes to make room leave its views as well.
+    assert.commandWorked(primaryDB.createCollection('capped', {capped: true, size: 4096, max: 3}));
+    assert.commandWorked(primaryDB.runCommand({
+        create: 'cappedCount',
+        viewOn: 'capped',
+        pipeline: [{$group: {_id: null, count: {$sum: 1}}}],
+        materialized: true
+    }));
+    for (let i = 0; i < 5; ++i) {
+        assert.writeOK(primaryDB.capped.insert({_id: i}));
+    }
+    assert.eq(3, primaryDB.capped.count());
+    assertContents('cappedCount', [{_id: null, count: 3}]);
+
+    // Only the create command populates materialized views.
+    assert.commandFailed(primaryDB.adminCommand({
+        applyOps: [{
+            op: 'c',
+            ns: 'test.$cmd',
+            o: {create: 'viaApplyOps', viewOn: 'source', pipeline: [], materialized: true}
+        }]
+    }));
+    assert.eq(0, primaryDB.getCollectionInfos({name: 'viaApplyOps'}).length);
+
+    // Secondaries apply the replicated writes to the views rather than maintaining them again.
+    rst.awaitReplication();
+    const secondaryDB = rst.getSecondary().getDB('test');
+    secondaryDB.getMongo().setSlaveOk();
+    assert.eq(primaryDB.openAmounts.find().sort({_id: 1}).toArray(),
+              secondaryDB.openAmounts.find().sort({_id: 1}).toArray());
+    assert.eq(primaryDB.regionTotals.find().sort({_id: 1}).toArray(),
+              secondaryDB.regionTotals.find().sort({_id: 1}).toArray());
+
+    rst.stopSet();
+}());
@@ -0,0 +1,77 @@
+/**
+ * Tests that index filters survive a restart when internalQueryPersistIndexFilters is set.
+ *
+ * This test requires persistence to ensure data survives a restart.
+ * @tags: [requires_persistence]
+ */
+(function() {
+    'use strict';
+
+    let dbpath = MongoRunner.dataPath + '_persisted_index_filters';
+    resetDbpath(dbpath);
+
+    let mongodArgs = {
+        dbpath: dbpath,
+        noCleanData: true,
+        setParameter: "internalQueryPersistIndexFilters=true"
+    };
+
+    let conn = MongoRunner.runMongod(mongodArgs);
+    assert.neq(null, conn, 'mongod was unable to start up');
+
+    let coll = conn.getDB('test').persisted_index_filters;
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: 1}));
+    assert.writeOK(coll.insert({a: 1, b: 1}));
+
+    assert.commandWorked(coll.runCommand(
+        'planCacheSetFilter', {query: {a: 1, b: 1}, sort: {a: -1}, indexes: [{a: 1}]}));
+    assert.commandWorked(
+        coll.runCommand('planCacheSetFilter', {query: {b: 1}, indexes: [{b: 1}, "a_1"]}));
+    assert.commandWorked(coll.runCommand('planCacheClearFilters', {query: {b: 1}}));
+
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod(mongodArgs);
+    assert.neq(null, conn, 'mongod was unable to restart');
+    coll = conn.getDB('test').persisted_index_filters;
+
+    // Only the filter which was not cleared comes back.
+    let res = assert.commandWorked(coll.runCommand('planCacheListFilters'));
+    assert.eq(1, res.filters.length, tojson(res));
+    assert.eq({a: 1, b: 1}, res.filters[0].query, tojson(res));
+    assert.eq({a: -1}, res.filters[0].sort, tojson(res));
+    assert.eq([{a: 1}], res.filters[0].indexes, tojson(res));
+
+    // The restored filter is applied to queries of its shape.
+    let explain = coll.find({a: 5, b: 5}).sort({a: -1}).explain();
+    assert(explain.queryPlanner.indexFilterSet, tojson(explain));
+
+    // Clearing every filter on the collection also removes them from the persisted filters.
+    assert.commandWorked(coll.runCommand('planCacheClearFilters'));
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod(mongodArgs);
+    assert.neq(null, conn, 'mongod was unable to restart');
+    coll = conn.getDB('test').persisted_index_filters;
+    res = assert.commandWorked(coll.runCommand('planCacheListFilters'));
+    assert.eq(0, res.filters.length, tojson(res));
+
+    // Dropping a collection, or its database, removes its persisted filters.
+    let persistedFilters = conn.getDB('admin').system.indexFilters;
+    let otherColl = conn.getDB('other').persisted_index_filters;
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(otherColl.createIndex({a: 1}));
+    for (let c of [coll, otherColl]) {
+        assert.commandWorked(
+            c.runCommand('planCacheSetFilter', {query: {a: 1}, indexes: [{a: 1}]}));
+    }
+    assert.eq(2, persistedFilters.find().itcount());
+
+    assert(coll.drop());
+    assert.eq(0, persistedFilters.find({ns: coll.getFullName()}).itcount());
+    assert.eq(1, persistedFilters.find({ns: otherColl.getFullName()}).itcount());
+
+    assert.commandWorked(otherColl.getDB().dropDatabase());
+    assert.eq(0, persistedFilters.find().itcount());
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,78 @@
+// Tests that the results of an aggregation are replayed from the pipeline result cache while the
+// collection is unchanged, and that any write to the collection stops them from being used.
+
+(function() {
+    "use strict";
+
+    load("jstests/libs/profiler.js");
+
+    const options = {setParameter: "internalQueryPipelineResultCacheSizeBytes=1048576"};
+    const conn = MongoRunner.runMongod(options);
+    assert.neq(null, conn, "mongod was unable to start up with options: " + tojson(options));
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.getCollection("coll");
+
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i % 3, s: "abc"[i % 3]}));
+    }
+
+    const pipeline =
+        [{$match: {a: {$gte: 1}}}, {$group: {_id: "$a", n: {$sum: 1}}}, {$sort: {_id: 1}}];
+
+    // Runs 'pipeline' and returns its results, along with the number of documents it examined.
+    function runAggregate(options) {
+        testDB.setProfilingLevel(2);
+        const results = coll.aggregate(pipeline, options).toArray();
+        testDB.setProfilingLevel(0);
+        return {results: results, docsExamined: getLatestProfilerEntry(testDB).docsExamined};
+    }
+
+    let run = runAggregate();
+    assert.eq([{_id: 1, n: 3}, {_id: 2, n: 3}], run.results);
+    assert.eq(10, run.docsExamined);
+
+    // The same aggregation on the unchanged collection does not examine any documents.
+    run = runAggregate();
+    assert.eq([{_id: 1, n: 3}, {_id: 2, n: 3}], run.results);
+    assert.eq(0, run.docsExamined);
+
+    // A different collation is a different aggregation.
+    run = runAggregate({collation: {locale: "en", strength: 2}});
+    assert.eq([{_id: 1, n: 3}, {_id: 2, n: 3}], run.results);
+    assert.eq(10, run.docsExamined);
+
+    // Inserts, updates and deletes all invalidate the cached results.
+    assert.writeOK(coll.insert({_id: 10, a: 1}));
+    run = runAggregate();
+    assert.eq([{_id: 1, n: 4}, {_id: 2, n: 3}], run.results);
+    assert.eq(11, run.docsExamined);
+
+    assert.writeOK(coll.update({_id: 10}, {$set: {a: 2}}));
+    run = runAggregate();
+    assert.eq([{_id: 1, n: 3}, {_id: 2, n: 4}], run.results);
+    assert.eq(11, run.docsExamined);
+
+    assert.writeOK(coll.remove({_id: 10}));
+    run = runAggregate();
+    assert.eq([{_id: 1, n: 3}, {_id: 2, n: 3}], run.results);
+    assert.eq(10, run.docsExamined);
+
+    // A collection created with the same name does not see the results cached for the old one.
+    coll.drop();
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: 1}));
+    }
+    run = runAggregate();
+    assert.eq([{_id: 1, n: 10}], run.results);
+    assert.eq(10, run.docsExamined);
+
+    // Aggregations which read other collections are not cached.
+    const lookupPipeline =
+        [{$lookup: {from: "other", localField: "a", foreignField: "_id", as: "o"}}];
+    assert.eq(0, coll.aggregate(lookupPipeline).toArray()[0].o.length);
+    assert.writeOK(testDB.other.insert({_id: 1}));
+    assert.eq(1, coll.aggregate(lookupPipeline).toArray()[0].o.length);
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,43 @@
+// Tests that sampled operations report a breakdown of their waits in the profiler, and that the
+// waitEventSampleRate parameter is validated.
+
+(function() {
+    "use strict";
+
+    load("jstests/libs/profiler.js");
+
+    const options = {setParameter: "waitEventSampleRate=1"};
+    const conn = MongoRunner.runMongod(options);
+    assert.neq(null, conn, "mongod was unable to start up with options: " + tojson(options));
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.getCollection("coll");
+    assert.commandWorked(testDB.createCollection(coll.getName()));
+
+    testDB.setProfilingLevel(2);
+
+    // A journaled write waits for its write concern.
+    assert.writeOK(coll.insert({_id: 0}, {writeConcern: {j: true}}));
+    let profileObj = getLatestProfilerEntry(testDB, {op: "insert"});
+    assert(profileObj.hasOwnProperty("waitEvents"), tojson(profileObj));
+    assert.eq(1, profileObj.waitEvents.journal.count, tojson(profileObj));
+    assert.gte(profileObj.waitEvents.journal.micros, 0, tojson(profileObj));
+
+    // Operations that did not wait report no breakdown.
+    assert.eq(1, coll.find({_id: 0}).itcount());
+    profileObj = getLatestProfilerEntry(testDB, {op: "query"});
+    assert(!profileObj.hasOwnProperty("waitEvents") ||
+               !profileObj.waitEvents.hasOwnProperty("journal"),
+           tojson(profileObj));
+
+    // Once sampling is turned off, no breakdown is collected.
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, waitEventSampleRate: 0}));
+    assert.writeOK(coll.insert({_id: 1}, {writeConcern: {j: true}}));
+    profileObj = getLatestProfilerEntry(testDB, {op: "insert"});
+    assert(!profileObj.hasOwnProperty("waitEvents"), tojson(profileObj));
+
+    assert.commandFailed(testDB.adminCommand({setParameter: 1, waitEventSampleRate: -0.5}));
+    assert.commandFailed(testDB.adminCommand({setParameter: 1, waitEventSampleRate: 2}));
+
+    MongoRunner.stopMongod(conn);
+})();
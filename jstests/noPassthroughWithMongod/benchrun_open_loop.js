@@ -0,0 +1,103 @@
+// Tests benchRun's rate-limited (open loop) mode, weighted op selection, skewed key
+// distributions and latency percentiles.
+(function() {
+    "use strict";
+
+    var t = db.benchrun_open_loop;
+    t.drop();
+    for (var i = 0; i < 1000; i++) {
+        assert.writeOK(t.insert({_id: i, x: 0}));
+    }
+
+    function runBench(args) {
+        args.host = db.getMongo().host;
+        if (jsTest.options().auth) {
+            args.db = 'admin';
+            args.username = jsTest.options().authUser;
+            args.password = jsTest.options().authPassword;
+        }
+        return benchRun(args);
+    }
+
+    function assertPercentiles(p) {
+        assert(p, "missing percentiles");
+        assert.lte(p.p50, p.p90, tojson(p));
+        assert.lte(p.p90, p.p95, tojson(p));
+        assert.lte(p.p95, p.p99, tojson(p));
+        assert.lte(p.p99, p.p999, tojson(p));
+        assert.lte(p.p999, p.max, tojson(p));
+    }
+
+    // A 9:1 read/write mix at a fixed overall rate, with zipfian distributed keys.
+    var seconds = 5;
+    var opsPerSecond = 200;
+    var res = runBench({
+        ops: [
+            {
+              op: "findOne",
+              ns: t.getFullName(),
+              query: {_id: {"#ZIPFIAN_INT": [0, 1000]}},
+              weight: 9
+            },
+            {
+              op: "update",
+              ns: t.getFullName(),
+              query: {_id: {"#ZIPFIAN_INT": [0, 1000]}},
+              update: {$inc: {x: 1}},
+              writeCmd: true,
+              weight: 1
+            }
+        ],
+        parallel: 2,
+        seconds: seconds,
+        opsPerSecond: opsPerSecond
+    });
+
+    assert.eq(0, res.errCount, tojson(res));
+    assertPercentiles(res.findOneLatencyPercentilesMicros);
+    assertPercentiles(res.updateLatencyPercentilesMicros);
+
+    // The client must not run faster than the requested rate, and on an idle mongod it should
+    // come reasonably close to it.
+    assert.lte(res["totalOps/s"], opsPerSecond * 1.2, tojson(res));
+    assert.gte(res["totalOps/s"], opsPerSecond * 0.5, tojson(res));
+    assert.gt(res.findOne, res.update, tojson(res));
+
+    // Low keys are updated far more often than high ones.
+    var hot = t.find({_id: {$lt: 10}}).toArray().reduce((sum, doc) => sum + doc.x, 0);
+    var cold = t.find({_id: {$gte: 990}}).toArray().reduce((sum, doc) => sum + doc.x, 0);
+    assert.gt(hot, cold, "expected a skewed update distribution");
+
+    // Poisson arrivals together with reads of recently inserted documents.
+    res = runBench({
+        ops: [
+            {
+              op: "insert",
+              ns: t.getFullName(),
+              doc: {_id: {"#SEQ_INT": {seq_id: 0, start: 100000, step: 1, unique: true}}},
+              writeCmd: true
+            },
+            {
+              op: "find",
+              ns: t.getFullName(),
+              query: {_id: {"#LATEST_INT": {seq_id: 0, range: 100}}},
+              expected: 1,
+              readCmd: true
+            }
+        ],
+        parallel: 1,
+        seconds: 2,
+        opsPerSecond: 100,
+        poissonArrivals: true
+    });
+    assert.eq(0, res.errCount, tojson(res));
+    assertPercentiles(res.insertLatencyPercentilesMicros);
+    assertPercentiles(res.queryLatencyPercentilesMicros);
+
+    assert.throws(function() {
+        runBench({ops: [{op: "nop", ns: t.getFullName(), weight: 0}], seconds: 1});
+    });
+    assert.throws(function() {
+        runBench({ops: [{op: "nop", ns: t.getFullName()}], seconds: 1, opsPerSecond: -1});
+    });
+})();
@@ -0,0 +1,80 @@
+// Tests that the $queryStats aggregation stage reports execution statistics by query shape.
+(function() {
+    "use strict";
+
+    // Collecting statistics is off by default.
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryStatsStoreSizeBytes: 16 * 1024 * 1024}));
+
+    const coll = db.query_stats;
+    coll.drop();
+
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i, b: i % 2}));
+    }
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    // Sums the statistics reported for shapes whose filter has the same fields as 'query', across
+    // all hosts.
+    function getShapeStats(query) {
+        let total = {count: 0, docsExamined: 0, keysExamined: 0, nreturned: 0, ops: 0};
+        coll.aggregate([{$queryStats: {}}]).forEach(function(entry) {
+            assert.eq(coll.getFullName(), entry.ns, tojson(entry));
+            if (Object.keySet(entry.queryShape.query).join() !== Object.keySet(query).join()) {
+                return;
+            }
+            total.count += entry.count;
+            total.docsExamined += entry.docsExamined;
+            total.keysExamined += entry.keysExamined;
+            total.nreturned += entry.nreturned;
+            total.ops += entry.latencyStats.reads.ops + entry.latencyStats.writes.ops +
+                entry.latencyStats.commands.ops;
+            assert(entry.hasOwnProperty("host"), tojson(entry));
+            assert(entry.hasOwnProperty("planCacheKey"), tojson(entry));
+            assert.lte(entry.firstSeen, entry.lastSeen, tojson(entry));
+        });
+        return total;
+    }
+
+    // Queries with different values have the same shape.
+    assert.eq(1, coll.find({a: 3}).itcount());
+    assert.eq(1, coll.find({a: 4}).itcount());
+    let stats = getShapeStats({a: 3});
+    assert.eq(2, stats.count, tojson(stats));
+    assert.eq(2, stats.ops, tojson(stats));
+    assert.eq(2, stats.nreturned, tojson(stats));
+    assert.eq(2, stats.keysExamined, tojson(stats));
+    assert.eq(2, stats.docsExamined, tojson(stats));
+
+    // The shape hides the values the query was run with.
+    const shapes = coll.aggregate([{$queryStats: {}}]).toArray();
+    assert.eq(1, shapes.length, tojson(shapes));
+    assert.eq({a: "?"}, shapes[0].queryShape.query, tojson(shapes));
+
+    // So do shapes of queries whose values are in arrays, however many there are.
+    assert.eq(2, coll.find({a: {$in: [1, 2]}}).itcount());
+    assert.eq(3, coll.find({a: {$in: [1, 2, 3]}}).itcount());
+    stats = coll.aggregate([{$queryStats: {}}]).toArray().filter(function(entry) {
+        return entry.queryShape.query.a.hasOwnProperty("$in");
+    });
+    assert.eq(1, stats.length, tojson(stats));
+    assert.eq({$in: ["?"]}, stats[0].queryShape.query.a, tojson(stats));
+    assert.eq(2, stats[0].count, tojson(stats));
+
+    // A query on another field has a shape of its own.
+    assert.eq(5, coll.find({b: 1}).itcount());
+    stats = getShapeStats({b: 1});
+    assert.eq(1, stats.count, tojson(stats));
+    assert.eq(10, stats.docsExamined, tojson(stats));
+    assert.eq(0, stats.keysExamined, tojson(stats));
+
+    // Dropping the collection forgets its shapes.
+    assert(coll.drop());
+    assert.writeOK(coll.insert({_id: 0, a: 0}));
+    assert.eq(0, coll.aggregate([{$queryStats: {}}]).itcount());
+
+    assert.commandFailed(db.runCommand(
+        {aggregate: coll.getName(), pipeline: [{$queryStats: {bad: 1}}], cursor: {}}));
+
+    assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryStatsStoreSizeBytes: 0}));
+})();
@@ -0,0 +1,68 @@
+// Tests isMaster's topologyVersion and the awaitable isMaster that replies as soon as the topology
+// differs from the version the caller already knows about.
+(function() {
+    "use strict";
+
+    var name = "awaitable_ismaster";
+    var rst = new ReplSetTest({name: name, nodes: [{}, {rsConfig: {priority: 0}}]});
+    rst.startSet();
+    rst.initiate();
+
+    var primary = rst.getPrimary();
+    var secondary = rst.getSecondary();
+
+    var res = assert.commandWorked(secondary.adminCommand({isMaster: 1}));
+    var topologyVersion = res.topologyVersion;
+    assert.eq("object", typeof topologyVersion, tojson(res));
+    assert(topologyVersion.hasOwnProperty("processId"), tojson(res));
+    assert(topologyVersion.hasOwnProperty("counter"), tojson(res));
+
+    // maxAwaitTimeMS needs a topologyVersion, and must not be negative.
+    assert.commandFailedWithCode(secondary.adminCommand({isMaster: 1, maxAwaitTimeMS: 100}),
+                                 ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        secondary.adminCommand(
+            {isMaster: 1, topologyVersion: topologyVersion, maxAwaitTimeMS: -1}),
+        ErrorCodes.BadValue);
+
+    // Without a topology change, the reply only comes once maxAwaitTimeMS has passed.
+    var start = new Date();
+    res = assert.commandWorked(secondary.adminCommand(
+        {isMaster: 1, topologyVersion: topologyVersion, maxAwaitTimeMS: 500}));
+    assert.gte(new Date() - start, 400, tojson(res));
+    assert.eq(topologyVersion, res.topologyVersion, tojson(res));
+
+    // A version the node never reported is answered right away.
+    start = new Date();
+    res = assert.commandWorked(secondary.adminCommand({
+        isMaster: 1,
+        topologyVersion: {processId: ObjectId(), counter: NumberLong(0)},
+        maxAwaitTimeMS: 60 * 1000
+    }));
+    assert.lt(new Date() - start, 30 * 1000, tojson(res));
+
+    // Wait on the secondary from another shell, then make the primary step down. The secondary
+    // replies as soon as it learns that there is no primary anymore.
+    var awaitIsMaster = startParallelShell(
+        "var res = assert.commandWorked(db.adminCommand({isMaster: 1, topologyVersion: " +
+            tojson(topologyVersion) + ", maxAwaitTimeMS: 5 * 60 * 1000}));" +
+            "assert.neq(0, bsonWoCompare(" + tojson(topologyVersion) +
+            ", res.topologyVersion), tojson(res));",
+        secondary.port);
+
+    assert.soon(function() {
+        return secondary.getDB("admin").currentOp().inprog.some(function(op) {
+            var cmd = op.command || op.query;
+            return cmd && cmd.hasOwnProperty("maxAwaitTimeMS");
+        });
+    }, "the awaitable isMaster never started");
+
+    start = new Date();
+    assert.throws(function() {
+        primary.adminCommand({replSetStepDown: 60, force: true});
+    });
+    awaitIsMaster();
+    assert.lt(new Date() - start, 60 * 1000);
+
+    rst.stopSet();
+})();
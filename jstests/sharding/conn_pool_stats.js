@@ -28,5 +28,18 @@
         assert.lte(stats["totalInUse"] + stats["totalAvailable"] + stats["totalRefreshing"],
                    stats["totalCreated"],
                    tojson(stats));
+
+        // Every pool reports how long requests waited for their connections.
+        Object.keys(stats.pools).forEach(function(poolName) {
+            var waitTimes = stats.pools[poolName].acquisitionWaitTimes;
+            assert(waitTimes, tojson(stats.pools[poolName]));
+            var bucketTotal = 0;
+            Object.keys(waitTimes).forEach(function(bucket) {
+                if (bucket != "totalCount") {
+                    bucketTotal += waitTimes[bucket];
+                }
+            });
+            assert.eq(waitTimes.totalCount, bucketTotal, tojson(waitTimes));
+        });
     }
 })();
@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds a document of 'fields' fields of mixed types, like a typical user document.
+ */
+BSONObj makeDocument(std::int64_t fields) {
+    BSONObjBuilder builder;
+    for (std::int64_t i = 0; i < fields; ++i) {
+        const std::string name = "field" + std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                builder.append(name, static_cast<int>(i));
+                break;
+            case 1:
+                builder.append(name, static_cast<double>(i) / 3);
+                break;
+            case 2:
+                builder.append(name, "a string value of moderate length");
+                break;
+            default:
+                builder.append(name, BSON("nested" << static_cast<long long>(i) << "flag" << true));
+                break;
+        }
+    }
+    return builder.obj();
+}
+
+void BM_bsonObjBuilderAppend(benchmark::State& state) {
+    const std::int64_t fields = state.arg();
+    while (state.keepRunning()) {
+        BSONObjBuilder builder;
+        for (std::int64_t i = 0; i < fields; ++i) {
+            builder.append("field", static_cast<int>(i));
+        }
+        BSONObj obj = builder.obj();
+        benchmark::doNotOptimize(obj.objdata());
+    }
+    state.setItemsProcessed(state.iterations() * fields);
+}
+MONGO_BENCHMARK(BM_bsonObjBuilderAppend)->arg(1)->arg(16)->arg(256);
+
+void BM_bsonIterate(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.arg());
+    while (state.keepRunning()) {
+        int count = 0;
+        for (auto&& element : obj) {
+            benchmark::doNotOptimize(element.type());
+            ++count;
+        }
+        benchmark::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+MONGO_BENCHMARK(BM_bsonIterate)->arg(16)->arg(256);
+
+void BM_bsonGetField(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.arg());
+    const std::string last = "field" + std::to_string(state.arg() - 1);
+    while (state.keepRunning()) {
+        benchmark::doNotOptimize(obj.getField(last));
+    }
+}
+MONGO_BENCHMARK(BM_bsonGetField)->arg(16)->arg(256);
+
+void BM_bsonValidate(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.arg());
+    while (state.keepRunning()) {
+        benchmark::doNotOptimize(obj.valid(BSONVersion::kLatest));
+    }
+}
+MONGO_BENCHMARK(BM_bsonValidate)->arg(16)->arg(256);
+
+void BM_bsonWoCompare(benchmark::State& state) {
+    const BSONObj lhs = makeDocument(state.arg());
+    const BSONObj rhs = lhs.getOwned();
+    while (state.keepRunning()) {
+        benchmark::doNotOptimize(lhs.woCompare(rhs));
+    }
+}
+MONGO_BENCHMARK(BM_bsonWoCompare)->arg(16)->arg(256);
+
+}  // namespace
+}  // namespace mongo
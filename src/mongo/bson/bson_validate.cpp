@@ -27,9 +27,9 @@
  *    then also delete it in the license file.
  */
 
+#include <boost/container/small_vector.hpp>
 #include <cstring>
 #include <limits>
-#include <vector>
 
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_validate.h"
@@ -315,9 +315,12 @@ Status validateElementInfo(Buffer* buffer,
     }
 }
 
+// Nearly all documents are nested less deeply than this, so the frame stack for them lives on the
+// C++ stack and validating a document does not need to allocate.
+const size_t kNumInlineValidationFrames = 32;
+
 Status validateBSONIterative(Buffer* buffer) {
-    std::vector<ValidationObjectFrame> frames;
-    frames.reserve(16);
+    boost::container::small_vector<ValidationObjectFrame, kNumInlineValidationFrames> frames;
     ValidationObjectFrame* curr = NULL;
     ValidationState::State state = ValidationState::BeginObj;
 
@@ -248,6 +248,17 @@ TEST(BSONValidateFast, NestedObject) {
     ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize() / 2, BSONVersion::kLatest));
 }
 
+TEST(BSONValidateFast, DeeplyNestedObject) {
+    // Nest deeper than the validator keeps on its stack to exercise growing the frame stack.
+    BSONObj x = BSON("a" << 1);
+    for (int i = 0; i < 100; ++i) {
+        x = BSON("a" << x << "b" << BSON_ARRAY(i));
+    }
+    ASSERT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
+    ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize() / 2, BSONVersion::kLatest));
+    ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize() - 1, BSONVersion::kLatest));
+}
+
 TEST(BSONValidateFast, ErrorWithId) {
     BufBuilder bb;
     BSONObjBuilder ob(bb);
@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <iosfwd>
 #include <string.h>  // strlen
 #include <string>
 #include <vector>
@@ -198,6 +199,10 @@ public:
     std::string jsonString(JsonStringFormat format,
                            bool includeFieldNames = true,
                            int pretty = 0) const;
+    void jsonStringStream(JsonStringFormat format,
+                          bool includeFieldNames,
+                          int pretty,
+                          std::ostream& s) const;
     operator std::string() const {
         return toString();
     }
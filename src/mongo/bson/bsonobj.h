@@ -236,6 +236,10 @@ public:
                            int pretty = 0,
                            bool isArray = false) const;
 
+    /** Writes the same text as jsonString() to 's', without building intermediate strings for
+        the nested elements. */
+    void jsonStringStream(JsonStringFormat format, int pretty, bool isArray, std::ostream& s) const;
+
     /** note: addFields always adds _id even if not specified */
     int addFields(BSONObj& from, std::set<std::string>& fields); /* returns n added */
 
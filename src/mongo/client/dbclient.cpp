@@ -92,6 +92,11 @@ using executor::RemoteCommandResponse;
 
 namespace {
 
+// Bounds each batch prefetched by the function-based query() when exhaust is unavailable. The
+// batch being consumed and the one in flight are held at once, and the server would otherwise fill
+// each getMore reply up to 16MB.
+const int kQueryPrefetchBytes = 4 * 1024 * 1024;
+
 #ifdef MONGO_CONFIG_SSL
 static SimpleMutex s_mtx;
 static SSLManagerInterface* s_sslMgr(NULL);
@@ -1081,7 +1086,21 @@ unsigned long long DBClientConnection::query(stdx::function<void(DBClientCursorB
                                              const BSONObj* fieldsToReturn,
                                              int queryOptions) {
     if (!(availableOptions() & QueryOption_Exhaust)) {
-        return DBClientBase::query(f, ns, query, fieldsToReturn, queryOptions);
+        // Without exhaust, prefetch each next batch instead. Like the exhaust path below, this
+        // relies on 'f' not using this connection.
+        queryOptions &= (int)(QueryOption_NoCursorTimeout | QueryOption_SlaveOk);
+
+        unique_ptr<DBClientCursor> c(this->query(ns, query, 0, 0, fieldsToReturn, queryOptions));
+        uassert(40424, "socket error for mapping query", c.get());
+        c->setPrefetchBytes(kQueryPrefetchBytes);
+
+        unsigned long long n = 0;
+        while (c->more()) {
+            DBClientCursorBatchIterator i(*c);
+            f(i);
+            n += i.n();
+        }
+        return n;
     }
 
     // mask options
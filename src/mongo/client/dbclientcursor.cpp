@@ -153,6 +153,7 @@ bool DBClientCursor::init() {
         return false;
     }
     dataReceived();
+    _prefetchMore();
     return true;
 }
 
@@ -188,6 +189,28 @@ bool DBClientCursor::initLazyFinish(bool& retry) {
 void DBClientCursor::requestMore() {
     verify(cursorId && batch.pos == batch.nReturned);
 
+    if (_prefetchPending) {
+        if (_prefetchReply.empty()) {
+            _receivePrefetch();
+        }
+        _prefetchPending = false;
+        batch.m = std::move(_prefetchReply);
+        _prefetchReply.reset();
+        if (_client) {
+            dataReceived();
+            _prefetchMore();
+        } else {
+            // The cursor was attached to a pooled connection after the reply was received.
+            verify(_scopedHost.size());
+            ScopedDbConnection conn(_scopedHost);
+            _client = conn.get();
+            ON_BLOCK_EXIT([this] { _client = nullptr; });
+            dataReceived();
+            conn.done();
+        }
+        return;
+    }
+
     if (haveLimit) {
         nToReturn -= batch.nReturned;
         verify(nToReturn > 0);
@@ -206,6 +229,7 @@ void DBClientCursor::requestMore() {
         _client->call(toSend, response);
         this->batch.m = std::move(response);
         dataReceived();
+        _prefetchMore();
     } else {
         verify(_scopedHost.size());
         ScopedDbConnection conn(_scopedHost);
@@ -218,6 +242,53 @@ void DBClientCursor::requestMore() {
     }
 }
 
+void DBClientCursor::setPrefetchBytes(int maxBytes) {
+    _prefetchBytes = maxBytes;
+
+    // Prefetch behind a batch that has just been received, but not before the first one.
+    if (!_prefetchPending && !batch.m.empty() && batch.pos == 0) {
+        _prefetchMore();
+    }
+}
+
+void DBClientCursor::_prefetchMore() {
+    if (!_prefetchBytes || !cursorId || !_client || haveLimit || wasError ||
+        (opts & (QueryOption_CursorTailable | QueryOption_Exhaust)) || !_client->lazySupported()) {
+        return;
+    }
+
+    int nextSize = nextBatchSize();
+    if (batch.nReturned > 0) {
+        // Called right after a batch arrived, so remainingBytes still spans the whole batch.
+        const int avgObjSize = std::max(1, batch.remainingBytes / batch.nReturned);
+        const int budgetSize = std::max(2, _prefetchBytes / avgObjSize);
+        if (nextSize == 0 || budgetSize < nextSize) {
+            nextSize = budgetSize;
+        }
+    }
+
+    BufBuilder b;
+    b.appendNum(opts);
+    b.appendStr(ns);
+    b.appendNum(nextSize);
+    b.appendNum(cursorId);
+
+    Message toSend;
+    toSend.setData(dbGetMore, b.buf(), b.len());
+    _client->say(toSend);
+    _prefetchPending = true;
+}
+
+void DBClientCursor::_receivePrefetch() {
+    invariant(_prefetchPending && _prefetchReply.empty());
+    verify(_client);
+    if (!_client->recv(_prefetchReply)) {
+        // The reply is lost along with the connection, so there is nothing left to wait for.
+        _prefetchPending = false;
+        uasserted(40412, "recv failed while receiving prefetched batch");
+    }
+}
+
 /** with QueryOption_Exhaust, the server just blasts data at us (marked at end with cursorid==0). */
 void DBClientCursor::exhaustReceiveMore() {
     verify(cursorId && batch.pos == batch.nReturned);
@@ -438,6 +509,11 @@ void DBClientCursor::attach(AScopedConnection* conn) {
     verify(conn);
     verify(conn->get());
 
+    // The connection goes back to its pool, so take the prefetched reply off it first.
+    if (_prefetchPending && _prefetchReply.empty()) {
+        _receivePrefetch();
+    }
+
     if (conn->get()->type() == ConnectionString::SET) {
         if (_lazyHost.size() > 0)
             _scopedHost = _lazyHost;
@@ -520,6 +596,14 @@ DBClientCursor::~DBClientCursor() {
 }
 
 void DBClientCursor::kill() {
+    // Drain the reply to an outstanding prefetched getMore, so that it isn't taken as the reply
+    // to the next request made on this connection.
+    if (_prefetchPending) {
+        DESTRUCTOR_GUARD(if (_prefetchReply.empty()) { _receivePrefetch(); });
+        _prefetchPending = false;
+        _prefetchReply.reset();
+    }
+
     DESTRUCTOR_GUARD(
 
         if (cursorId && _ownCursor && !globalInShutdownDeprecated()) {
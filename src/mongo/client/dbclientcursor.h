@@ -155,6 +155,19 @@ public:
         batchSize = newBatchSize;
     }
 
+    /**
+     * Enables prefetching: as soon as a batch arrives, the getMore for the following one is sent,
+     * so the server produces it and the network carries it while the caller consumes the
+     * current batch. 'maxBytes' bounds each prefetched batch, based on the average size of the
+     * documents received so far; 0 disables prefetching.
+     *
+     * While a prefetched getMore is outstanding its reply is pending on the connection, so the
+     * caller must not use the connection for anything else until more() returns false or the
+     * cursor is killed. Prefetching is only done on connections that support lazy replies, and
+     * never for tailable, exhaust or limited cursors.
+     */
+    void setPrefetchBytes(int maxBytes);
+
     DBClientCursor(DBClientBase* client,
                    const std::string& ns,
                    const BSONObj& query,
@@ -268,6 +281,11 @@ private:
     std::string _lazyHost;
     bool wasError;
     BSONVersion _enabledBSONVersion;
+    int _prefetchBytes{0};
+    // True from sending a prefetched getMore until its reply becomes the current batch.
+    bool _prefetchPending{false};
+    // The reply to the prefetched getMore, once received from the connection.
+    Message _prefetchReply;
 
     void dataReceived() {
         bool retry;
@@ -285,6 +303,12 @@ private:
 
     void requestMore();
 
+    // Sends the getMore for the batch after the current one, if prefetching applies.
+    void _prefetchMore();
+
+    // Receives the reply to the outstanding prefetched getMore into _prefetchReply.
+    void _receivePrefetch();
+
     // init pieces
     void _assembleInit(Message& toSend);
 };
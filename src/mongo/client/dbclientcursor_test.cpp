@@ -0,0 +1,270 @@
+/**
+ *    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "mongo/client/dbclientcursor.h"
+#include "mongo/client/dbclientinterface.h"
+#include "mongo/db/dbmessage.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const char kNs[] = "test.coll";
+const long long kCursorId = 42;
+
+/**
+ * A connection to a fake server with 'numDocs' documents, which it returns at most
+ * 'serverBatchSize' at a time. Replies to getMores sent with say() are queued for recv().
+ */
+class FakeDBClient final : public DBClientBase {
+public:
+    FakeDBClient(int numDocs, int serverBatchSize, int docPaddingBytes, bool lazySupported)
+        : _numDocs(numDocs),
+          _serverBatchSize(serverBatchSize),
+          _padding(docPaddingBytes, 'x'),
+          _lazySupported(lazySupported) {}
+
+    bool call(Message& toSend,
+              Message& response,
+              bool assertOk,
+              std::string* actualServer) final {
+        if (toSend.operation() == dbQuery) {
+            response = _makeReply(0);
+        } else {
+            invariant(toSend.operation() == dbGetMore);
+            ++getMoresCalled;
+            response = _makeReply(_parseGetMore(toSend));
+        }
+        return true;
+    }
+
+    void say(Message& toSend, bool isRetry, std::string* actualServer) final {
+        if (toSend.operation() == dbKillCursors) {
+            ++killCursorsSaid;
+            return;
+        }
+
+        invariant(toSend.operation() == dbGetMore);
+        const int nToReturn = _parseGetMore(toSend);
+        getMoreSizes.push_back(nToReturn);
+        pendingReplies.push_back(_makeReply(nToReturn));
+    }
+
+    bool recv(Message& m) final {
+        if (pendingReplies.empty()) {
+            return false;
+        }
+        m = std::move(pendingReplies.front());
+        pendingReplies.pop_front();
+        return true;
+    }
+
+    bool lazySupported() const final {
+        return _lazySupported;
+    }
+
+    std::string getServerAddress() const final {
+        return "fake:27017";
+    }
+
+    std::string toString() const final {
+        return getServerAddress();
+    }
+
+    int getMinWireVersion() final {
+        return 0;
+    }
+
+    int getMaxWireVersion() final {
+        return 0;
+    }
+
+    bool isFailed() const final {
+        return false;
+    }
+
+    bool isStillConnected() final {
+        return true;
+    }
+
+    ConnectionString::ConnectionType type() const final {
+        return ConnectionString::MASTER;
+    }
+
+    double getSoTimeout() const final {
+        return 0;
+    }
+
+    // The numberToReturn of every getMore sent with say(), that is, prefetched.
+    std::vector<int> getMoreSizes;
+
+    // Number of getMores sent with call(), that is, not prefetched.
+    int getMoresCalled = 0;
+
+    int killCursorsSaid = 0;
+
+    std::deque<Message> pendingReplies;
+
+private:
+    static int _parseGetMore(const Message& getMore) {
+        DbMessage d(getMore);
+        const int nToReturn = d.pullInt();
+        invariant(d.pullInt64() == kCursorId);
+        return nToReturn;
+    }
+
+    Message _makeReply(int nToReturn) {
+        int n = std::min(_serverBatchSize, _numDocs - _nextDoc);
+        if (nToReturn > 0) {
+            n = std::min(n, nToReturn);
+        }
+
+        OpQueryReplyBuilder reply;
+        for (int i = 0; i < n; ++i) {
+            BSON("_id" << _nextDoc++ << "padding" << _padding)
+                .appendSelfToBufBuilder(reply.bufBuilderForResults());
+        }
+
+        Message response;
+        reply.putInMessage(&response, 0, n, 0, _nextDoc < _numDocs ? kCursorId : 0);
+        return response;
+    }
+
+    const int _numDocs;
+    const int _serverBatchSize;
+    const std::string _padding;
+    const bool _lazySupported;
+    int _nextDoc = 0;
+};
+
+/**
+ * Reads every document of 'cursor', checking that they come in _id order.
+ */
+int readAll(DBClientCursor* cursor) {
+    int n = 0;
+    while (cursor->more()) {
+        ASSERT_EQ(n, cursor->next()["_id"].numberInt());
+        ++n;
+    }
+    return n;
+}
+
+TEST(DBClientCursorPrefetchTest, PrefetchesEachNextBatchAsSoonAsTheCurrentOneArrives) {
+    FakeDBClient client(10, 2, 0, true);
+    DBClientCursor cursor(&client, kNs, BSONObj(), 0, 0, nullptr, 0, 0);
+    ASSERT(cursor.init());
+
+    cursor.setPrefetchBytes(1024 * 1024);
+    ASSERT_EQ(1U, client.getMoreSizes.size());
+    ASSERT_EQ(1U, client.pendingReplies.size());
+
+    // The first batch is still being consumed while the second one is already on its way.
+    ASSERT(cursor.more());
+    ASSERT_EQ(0, cursor.next()["_id"].numberInt());
+    ASSERT_EQ(1U, client.getMoreSizes.size());
+
+    ASSERT(cursor.more());
+    ASSERT_EQ(1, cursor.next()["_id"].numberInt());
+
+    // Moving to the second batch receives it and prefetches the third.
+    ASSERT(cursor.more());
+    ASSERT_EQ(2, cursor.next()["_id"].numberInt());
+    ASSERT_EQ(2U, client.getMoreSizes.size());
+    ASSERT_EQ(1U, client.pendingReplies.size());
+
+    int n = 3;
+    while (cursor.more()) {
+        ASSERT_EQ(n++, cursor.next()["_id"].numberInt());
+    }
+    ASSERT_EQ(10, n);
+
+    // Every getMore was prefetched, and none is left outstanding once the cursor is exhausted.
+    ASSERT_EQ(4U, client.getMoreSizes.size());
+    ASSERT_EQ(0, client.getMoresCalled);
+    ASSERT(client.pendingReplies.empty());
+}
+
+TEST(DBClientCursorPrefetchTest, ByteBudgetBoundsEachPrefetchedBatch) {
+    FakeDBClient client(20, 5, 1000, true);
+    DBClientCursor cursor(&client, kNs, BSONObj(), 0, 0, nullptr, 0, 0);
+    ASSERT(cursor.init());
+
+    // Each document is a little over 1000 bytes, so a budget of 4000 bytes allows 3 of them.
+    cursor.setPrefetchBytes(4000);
+    ASSERT_EQ(20, readAll(&cursor));
+
+    ASSERT_FALSE(client.getMoreSizes.empty());
+    for (int nToReturn : client.getMoreSizes) {
+        ASSERT_EQ(3, nToReturn);
+    }
+    ASSERT_EQ(0, client.getMoresCalled);
+}
+
+TEST(DBClientCursorPrefetchTest, KillDrainsOutstandingPrefetchedReply) {
+    FakeDBClient client(10, 2, 0, true);
+    DBClientCursor cursor(&client, kNs, BSONObj(), 0, 0, nullptr, 0, 0);
+    ASSERT(cursor.init());
+    cursor.setPrefetchBytes(1024 * 1024);
+    ASSERT_EQ(1U, client.pendingReplies.size());
+
+    // The prefetched reply must not be taken as the reply to the next request on the connection.
+    cursor.kill();
+    ASSERT(client.pendingReplies.empty());
+    ASSERT_EQ(1, client.killCursorsSaid);
+}
+
+TEST(DBClientCursorPrefetchTest, NoPrefetchingWithoutLazyReplies) {
+    FakeDBClient client(10, 2, 0, false);
+    DBClientCursor cursor(&client, kNs, BSONObj(), 0, 0, nullptr, 0, 0);
+    ASSERT(cursor.init());
+    cursor.setPrefetchBytes(1024 * 1024);
+
+    ASSERT_EQ(10, readAll(&cursor));
+    ASSERT(client.getMoreSizes.empty());
+    ASSERT_EQ(4, client.getMoresCalled);
+}
+
+TEST(DBClientCursorPrefetchTest, NoPrefetchingForLimitedCursors) {
+    FakeDBClient client(10, 2, 0, true);
+    DBClientCursor cursor(&client, kNs, BSONObj(), 5, 0, nullptr, 0, 0);
+    ASSERT(cursor.init());
+    cursor.setPrefetchBytes(1024 * 1024);
+
+    ASSERT_EQ(5, readAll(&cursor));
+    ASSERT(client.getMoreSizes.empty());
+}
+
+}  // namespace
+}  // namespace mongo
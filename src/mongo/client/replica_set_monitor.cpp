@@ -42,6 +42,9 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/bson_extract_optime.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/executor/remote_command_request.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/grid.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
@@ -163,8 +166,18 @@ struct HostNotIn {
  * Replica set refresh period on the task executor.
  */
 const Seconds kRefreshPeriod(30);
+
+/**
+ * How much longer than the time a host may hold it an awaitable isMaster is given to complete.
+ */
+const Seconds kAwaitIsMasterNetworkTimeout(10);
 }  // namespace
 
+// How long each monitored host may hold an isMaster before replying when its view of the set has
+// not changed. A host replies as soon as its topology changes, so topology changes are noticed
+// without waiting for the next periodic refresh. Zero disables awaitable isMaster.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(replicaSetMonitorMaxAwaitTimeMS, int, 10000);
+
 // If we cannot find a host after 15 seconds of refreshing, give up
 const Seconds ReplicaSetMonitor::kDefaultFindHostTimeout(15);
 
@@ -211,6 +224,9 @@ ReplicaSetMonitor::~ReplicaSetMonitor() {
     }
 
     _executor->cancel(_refresherHandle);
+    for (const auto& entry : _awaitIsMasterHandles) {
+        _executor->cancel(entry.second);
+    }
     // Note: calling _executor->wait(_refresherHandle); from the dispatcher thread will cause hang
     // Its ok not to call it because the d-tor is called only when the last owning pointer goes out
     // of scope, so as taskExecutor queue holds a weak pointer to RSM it will not be able to get a
@@ -227,6 +243,7 @@ void ReplicaSetMonitor::_refresh(const CallbackArgs& cbArgs) {
     Timer t;
     startOrContinueRefresh().refreshAll();
     LOG(1) << "Refreshing replica set " << getName() << " took " << t.millis() << " msec";
+    _startAwaitingIsMaster();
     {
         // reschedule itself
         invariant(_executor);
@@ -260,6 +277,132 @@ void ReplicaSetMonitor::_refresh(const CallbackArgs& cbArgs) {
     }
 }
 
+void ReplicaSetMonitor::_startAwaitingIsMaster() {
+    if (replicaSetMonitorMaxAwaitTimeMS <= 0 || _isRemovedFromManager.load()) {
+        return;
+    }
+
+    std::vector<HostAndPort> hosts;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+        for (const auto& node : _state->nodes) {
+            hosts.push_back(node.host);
+        }
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (const auto& host : hosts) {
+        if (!_awaitIsMasterHandles.count(host)) {
+            _awaitIsMaster_inlock(host, BSONObj());
+        }
+    }
+}
+
+void ReplicaSetMonitor::_awaitIsMaster_inlock(const HostAndPort& host,
+                                              const BSONObj& topologyVersion) {
+    invariant(_executor);
+    BSONObjBuilder cmd;
+    cmd.append("isMaster", 1);
+    Milliseconds timeout(kAwaitIsMasterNetworkTimeout);
+    if (!topologyVersion.isEmpty()) {
+        cmd.append("topologyVersion", topologyVersion);
+        cmd.append("maxAwaitTimeMS", replicaSetMonitorMaxAwaitTimeMS);
+        timeout += Milliseconds(replicaSetMonitorMaxAwaitTimeMS);
+    }
+
+    std::weak_ptr<ReplicaSetMonitor> that(shared_from_this());
+    auto status = _executor->scheduleRemoteCommand(
+        executor::RemoteCommandRequest(host, "admin", cmd.obj(), nullptr, timeout),
+        [=](const executor::TaskExecutor::RemoteCommandCallbackArgs& cbArgs) {
+            if (auto ptr = that.lock()) {
+                ptr->_onAwaitIsMasterResponse(host, topologyVersion, cbArgs);
+            }
+        });
+
+    if (!status.isOK()) {
+        LOG(1) << "Can't wait for topology changes of " << host << " in replica set "
+               << getName() << causedBy(redact(status.getStatus()));
+        return;
+    }
+
+    _awaitIsMasterHandles[host] = status.getValue();
+}
+
+void ReplicaSetMonitor::_onAwaitIsMasterResponse(
+    const HostAndPort& host,
+    const BSONObj& topologyVersion,
+    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbArgs) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _awaitIsMasterHandles.erase(host);
+    }
+
+    const auto& response = cbArgs.response;
+    if (response.status == ErrorCodes::CallbackCanceled || _isRemovedFromManager.load()) {
+        return;
+    }
+
+    Status status = response.isOK() ? getStatusFromCommandResult(response.data) : response.status;
+    if (!status.isOK()) {
+        // The host may have gone down or stepped down and closed its connections. Either way, the
+        // next periodic refresh takes care of waiting on it again.
+        LOG(1) << "Awaitable isMaster to " << host << " failed" << causedBy(redact(status));
+        _scheduleRefreshForTopologyChange();
+        return;
+    }
+
+    const BSONElement newTopologyVersion = response.data["topologyVersion"];
+    if (newTopologyVersion.type() != Object) {
+        // Not a replica set member that supports awaitable isMaster, or no longer in the set.
+        return;
+    }
+
+    if (!topologyVersion.isEmpty() && !topologyVersion.binaryEqual(newTopologyVersion.Obj())) {
+        LOG(1) << "Topology of replica set " << getName() << " changed according to " << host;
+        _scheduleRefreshForTopologyChange();
+    }
+
+    if (!contains(host)) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_awaitIsMasterHandles.count(host)) {
+        _awaitIsMaster_inlock(host, newTopologyVersion.Obj().getOwned());
+    }
+}
+
+void ReplicaSetMonitor::_scheduleRefreshForTopologyChange() {
+    if (_topologyRefreshPending.swap(true)) {
+        return;
+    }
+
+    std::weak_ptr<ReplicaSetMonitor> that(shared_from_this());
+    auto status = _executor->scheduleWork([=](const CallbackArgs& cbArgs) {
+        auto ptr = that.lock();
+        if (!ptr) {
+            return;
+        }
+
+        ptr->_topologyRefreshPending.store(false);
+        if (!cbArgs.status.isOK()) {
+            return;
+        }
+
+        {
+            // A scan that is already in progress may have contacted the changed hosts before the
+            // change, so start over rather than joining it.
+            stdx::lock_guard<stdx::mutex> lk(ptr->_state->mutex);
+            ptr->_state->currentScan.reset();
+        }
+        ptr->startOrContinueRefresh().refreshAll();
+    });
+
+    if (!status.isOK()) {
+        _topologyRefreshPending.store(false);
+    }
+}
+
 StatusWith<HostAndPort> ReplicaSetMonitor::getHostOrRefresh(const ReadPreferenceSetting& criteria,
                                                             Milliseconds maxWait) {
     if (_isRemovedFromManager.load()) {
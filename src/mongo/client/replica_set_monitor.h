@@ -28,6 +28,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <memory>
 #include <set>
@@ -267,9 +268,34 @@ private:
      */
     void _refresh(const executor::TaskExecutor::CallbackArgs&);
 
-    // Serializes refresh and protects _refresherHandle
+    /**
+     * Starts an awaitable isMaster against every known host of the set that doesn't have one
+     * outstanding yet.
+     */
+    void _startAwaitingIsMaster();
+
+    /**
+     * Sends "host" an isMaster that the host holds on to until its topology differs from
+     * "topologyVersion", or until replicaSetMonitorMaxAwaitTimeMS passes. An empty
+     * "topologyVersion" asks for an immediate reply, to learn the host's current version.
+     */
+    void _awaitIsMaster_inlock(const HostAndPort& host, const BSONObj& topologyVersion);
+
+    void _onAwaitIsMasterResponse(const HostAndPort& host,
+                                  const BSONObj& topologyVersion,
+                                  const executor::TaskExecutor::RemoteCommandCallbackArgs& cbArgs);
+
+    /**
+     * Refreshes the entire set right away, rather than waiting for the next periodic refresh.
+     * Concurrent requests are coalesced into a single refresh.
+     */
+    void _scheduleRefreshForTopologyChange();
+
+    // Serializes refresh and protects _refresherHandle and _awaitIsMasterHandles
     stdx::mutex _mutex;
     executor::TaskExecutor::CallbackHandle _refresherHandle;
+    std::map<HostAndPort, executor::TaskExecutor::CallbackHandle> _awaitIsMasterHandles;
+    AtomicBool _topologyRefreshPending{false};
 
     const SetStatePtr _state;
     executor::TaskExecutor* _executor;
@@ -32,6 +32,8 @@
 
 #include "mongo/db/assemble_response.h"
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/cursor_manager.h"
@@ -46,16 +48,22 @@
 #include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/ops/write_ops_parsers.h"
 #include "mongo/db/query/find.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/run_commands.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/stats/wait_event_profile.h"
+#include "mongo/platform/atomic_proxy.h"
 #include "mongo/rpc/command_reply_builder.h"
 #include "mongo/rpc/command_request.h"
 #include "mongo/rpc/legacy_reply_builder.h"
 #include "mongo/rpc/legacy_request.h"
 #include "mongo/s/stale_exception.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
@@ -69,6 +77,28 @@ MONGO_FP_DECLARE(rsStopGetMore);
 namespace {
 using logger::LogComponent;
 
+// Fraction of client operations for which a WaitEventProfile is collected and reported in the
+// slow query log, the profiler and currentOp.
+AtomicDouble waitEventSampleRate{0.01};
+
+class WaitEventSampleRateSetting
+    : public ExportedServerParameter<double, ServerParameterType::kStartupAndRuntime> {
+public:
+    WaitEventSampleRateSetting()
+        : ExportedServerParameter<double, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(), "waitEventSampleRate", &waitEventSampleRate) {}
+
+    Status validate(const double& potentialNewValue) override {
+        if (potentialNewValue < 0.0 || potentialNewValue > 1.0) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "waitEventSampleRate must be between 0 and 1, but "
+                                           "attempted to set to: "
+                                        << potentialNewValue);
+        }
+        return Status::OK();
+    }
+} waitEventSampleRateSetting;
+
 inline void opread(Message& m) {
     if (_diaglog.getLevel() & 2) {
         _diaglog.readop(m.singleData().view2ptr(), m.header().getLen());
@@ -537,10 +567,22 @@ void assembleResponse(OperationContext* txn,
         // which is logically a basic CRUD operation like query, insert, etc.
         currentOp.setNetworkOp_inlock(op);
         currentOp.setLogicalOp_inlock(networkOpToLogicalOp(op));
+
+        const double sampleRate = waitEventSampleRate.load();
+        if (!c.isInDirectClient() && sampleRate > 0.0 &&
+            (sampleRate == 1.0 || c.getPrng().nextCanonicalDouble() < sampleRate)) {
+            currentOp.debug().waitEvents = stdx::make_unique<WaitEventProfile>();
+        }
     }
 
     OpDebug& debug = currentOp.debug();
 
+    // Direct client operations run nested in another operation, whose profile keeps collecting.
+    boost::optional<ScopedWaitEventProfile> waitEventScope;
+    if (!c.isInDirectClient()) {
+        waitEventScope.emplace(debug.waitEvents.get());
+    }
+
     long long logThresholdMs = serverGlobalParams.slowMS;
     bool shouldLogOpDebug = shouldLog(logger::LogSeverity::Debug(1));
 
@@ -619,6 +661,7 @@ void assembleResponse(OperationContext* txn,
             shouldLogOpDebug = true;
         }
     }
+    waitEventScope = boost::none;
     currentOp.ensureStarted();
     currentOp.done();
     debug.executionTimeMicros = currentOp.totalTimeMicros();
@@ -628,6 +671,22 @@ void assembleResponse(OperationContext* txn,
         .incrementGlobalLatencyStats(
             txn, currentOp.totalTimeMicros(), currentOp.getReadWriteType());
 
+    const int queryStatsBudgetBytes = internalQueryStatsStoreSizeBytes.load();
+    if (queryStatsBudgetBytes > 0 && !debug.queryShapeKey.empty() && !c.isInDirectClient()) {
+        QueryStatsStore::Execution execution;
+        execution.micros = debug.executionTimeMicros;
+        execution.readWriteType = currentOp.getReadWriteType();
+        execution.docsExamined = std::max(debug.docsExamined, 0LL);
+        execution.keysExamined = std::max(debug.keysExamined, 0LL);
+        execution.nreturned = std::max(debug.nreturned, 0LL);
+        QueryStatsStore::get(txn->getServiceContext())
+            .record(debug.queryShapeNs,
+                    debug.queryShapeKey,
+                    debug.queryShape,
+                    execution,
+                    static_cast<size_t>(queryStatsBudgetBytes));
+    }
+
     const bool shouldSample = serverGlobalParams.sampleRate == 1.0
         ? true
         : c.getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
@@ -283,7 +283,8 @@ Status AuthorizationSession::checkAuthForAggregate(const NamespaceString& ns,
         if (str::equals("$indexStats", firstPipelineStage.firstElementFieldName())) {
             Privilege::addPrivilegeToPrivilegeVector(
                 &privileges, Privilege(inputResource, ActionType::indexStats));
-        } else if (str::equals("$collStats", firstPipelineStage.firstElementFieldName())) {
+        } else if (str::equals("$collStats", firstPipelineStage.firstElementFieldName()) ||
+                   str::equals("$queryStats", firstPipelineStage.firstElementFieldName())) {
             Privilege::addPrivilegeToPrivilegeVector(
                 &privileges, Privilege(inputResource, ActionType::collStats));
         } else {
@@ -732,6 +733,7 @@ bool AuthorizationSession::isAuthenticatedAsUserWithRole(const RoleName& roleNam
 
 void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* txn) {
     AuthorizationManager& authMan = getAuthorizationManager();
+    bool usersChanged = false;
     UserSet::iterator it = _authenticatedUsers.begin();
     while (it != _authenticatedUsers.end()) {
         User* user = *it;
@@ -748,6 +750,7 @@ void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* txn) {
                     // Success! Replace the old User object with the updated one.
                     fassert(17067, _authenticatedUsers.replaceAt(it, updatedUser) == user);
                     authMan.releaseUser(user);
+                    usersChanged = true;
                     LOG(1) << "Updated session cache of user information for " << name;
                     break;
                 }
@@ -755,6 +758,7 @@ void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* txn) {
                     // User does not exist anymore; remove it from _authenticatedUsers.
                     fassert(17068, _authenticatedUsers.removeAt(it) == user);
                     authMan.releaseUser(user);
+                    usersChanged = true;
                     log() << "Removed deleted user " << name
                           << " from session cache of user information.";
                     continue;  // No need to advance "it" in this case.
@@ -770,7 +774,12 @@ void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* txn) {
         }
         ++it;
     }
-    _buildAuthenticatedRolesVector();
+
+    // This runs at the start of every request, and in the common case every User is still
+    // valid and the roles vector is already up to date.
+    if (usersChanged) {
+        _buildAuthenticatedRolesVector();
+    }
 }
 
 void AuthorizationSession::_buildAuthenticatedRolesVector() {
@@ -292,6 +292,9 @@ protected:
 private:
     // If any users authenticated on this session are marked as invalid this updates them with
     // up-to-date information. May require a read lock on the "admin" db to read the user data.
+    //
+    // Checking whether a User is still valid is a single atomic load, so the common case where
+    // nothing changed does not touch the AuthorizationManager's user cache or its mutex.
     void _refreshUserInfoAsNeeded(OperationContext* txn);
 
 
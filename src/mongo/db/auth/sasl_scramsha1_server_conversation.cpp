@@ -34,11 +34,13 @@
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <map>
 
 #include "mongo/crypto/mechanism_scram.h"
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/db/auth/sasl_options.h"
 #include "mongo/platform/random.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -51,6 +53,47 @@ namespace mongo {
 using std::unique_ptr;
 using std::string;
 
+namespace {
+
+/**
+ * Remembers the SCRAM-SHA-1 credentials generated on the fly for users that only have
+ * MONGODB-CR credentials.
+ *
+ * Deriving them costs a full PBKDF2 run, and since each run picks a new salt, clients could
+ * never reuse their own cached secrets either. Entries are keyed by the MONGODB-CR password
+ * hash they were derived from, so a changed password never matches a stale entry.
+ */
+class MixedModeCredentialsCache {
+public:
+    bool get(const UserName& user, const std::string& password, User::SCRAMCredentials* creds) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _entries.find(user);
+        if (it == _entries.end() || it->second.first != password) {
+            return false;
+        }
+        *creds = it->second.second;
+        return true;
+    }
+
+    void set(const UserName& user, const std::string& password, User::SCRAMCredentials creds) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_entries.size() >= kMaxEntries && _entries.find(user) == _entries.end()) {
+            _entries.clear();
+        }
+        _entries[user] = std::make_pair(password, std::move(creds));
+    }
+
+private:
+    static const size_t kMaxEntries = 10000;
+
+    stdx::mutex _mutex;
+    std::map<UserName, std::pair<std::string, User::SCRAMCredentials>> _entries;
+};
+
+MixedModeCredentialsCache mixedModeCredentialsCache;
+
+}  // namespace
+
 SaslSCRAMSHA1ServerConversation::SaslSCRAMSHA1ServerConversation(
     SaslAuthenticationSession* saslAuthSession)
     : SaslServerConversation(saslAuthSession), _step(0), _authMessage(""), _nonce("") {}
@@ -186,7 +229,8 @@ StatusWith<bool> SaslSCRAMSHA1ServerConversation::_firstStep(std::vector<string>
     }
 
     // Generate SCRAM credentials on the fly for mixed MONGODB-CR/SCRAM mode.
-    if (_creds.scram.salt.empty() && !_creds.password.empty()) {
+    if (_creds.scram.salt.empty() && !_creds.password.empty() &&
+        !mixedModeCredentialsCache.get(userName, _creds.password, &_creds.scram)) {
         // Use a default value of 5000 for the scramIterationCount when in mixed mode,
         // overriding the default value (10000) used for SCRAM mode or the user-given value.
         const int mixedModeScramIterationCount = 5000;
@@ -196,6 +240,7 @@ StatusWith<bool> SaslSCRAMSHA1ServerConversation::_firstStep(std::vector<string>
         _creds.scram.salt = scramCreds[scram::saltFieldName].String();
         _creds.scram.storedKey = scramCreds[scram::storedKeyFieldName].String();
         _creds.scram.serverKey = scramCreds[scram::serverKeyFieldName].String();
+        mixedModeCredentialsCache.set(userName, _creds.password, _creds.scram);
     }
 
     // Generate server-first-message
@@ -438,6 +438,44 @@ TEST_F(SCRAMSHA1Fixture, testMONGODBCR) {
     ASSERT_EQ(goalState, runSteps(saslServerSession.get(), saslClientSession.get()));
 }
 
+TEST_F(SCRAMSHA1Fixture, testMONGODBCRReusesGeneratedCredentials) {
+    authzManagerExternalState->insertPrivilegeDocument(
+        txn.get(), generateMONGODBCRUserDocument("sajack", "sajack"), BSONObj());
+
+    auto authenticate = [&] {
+        saslServerSession = stdx::make_unique<NativeSaslAuthenticationSession>(authzSession.get());
+        saslServerSession->setOpCtxt(txn.get());
+        saslServerSession->start("test", "SCRAM-SHA-1", "mongodb", "MockServer.test", 1, false);
+        saslClientSession = stdx::make_unique<NativeSaslClientSession>();
+        saslClientSession->setParameter(NativeSaslClientSession::parameterMechanism,
+                                        "SCRAM-SHA-1");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterServiceName,
+                                        "mongodb");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterServiceHostname,
+                                        "MockServer.test");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterServiceHostAndPort,
+                                        "MockServer.test:27017");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterUser, "sajack");
+        saslClientSession->setParameter(NativeSaslClientSession::parameterPassword,
+                                        createPasswordDigest("sajack", "sajack"));
+        ASSERT_OK(saslClientSession->initialize());
+
+        // Keep the salt and iteration count, which follow the nonce in server-first-message.
+        std::string saltAndIterations;
+        SCRAMMutators mutator;
+        mutator.setMutator(SaslTestState(SaslTestState::kServer, 1),
+                           [&saltAndIterations](std::string& serverMessage) {
+                               saltAndIterations = serverMessage.substr(serverMessage.find(','));
+                           });
+        ASSERT_EQ(goalState, runSteps(saslServerSession.get(), saslClientSession.get(), mutator));
+        return saltAndIterations;
+    };
+
+    const std::string first = authenticate();
+    ASSERT_FALSE(first.empty());
+    ASSERT_EQ(first, authenticate());
+}
+
 TEST(SCRAMSHA1Cache, testGetFromEmptyCache) {
     SCRAMSHA1ClientCache cache;
     std::string saltStr("saltsaltsaltsalt");
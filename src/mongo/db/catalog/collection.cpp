@@ -49,6 +49,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -58,6 +59,7 @@
 #include "mongo/db/ops/update_driver.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
@@ -79,6 +81,9 @@ namespace {
 // Used below to fail during inserts.
 MONGO_FP_DECLARE(failCollectionInserts);
 
+// The incarnation of the next Collection object to be created.
+AtomicUInt64 nextIncarnation;
+
 const auto bannedExpressionsInValidators = std::set<StringData>{
     "$geoNear", "$near", "$nearSphere", "$text", "$where",
 };
@@ -229,6 +234,8 @@ Collection::Collection(OperationContext* txn,
       _validationLevel(uassertStatusOK(
           parseValidationLevel(_details->getCollectionOptions(txn).validationLevel))),
       _cursorManager(fullNS),
+      _incarnation(nextIncarnation.fetchAndAdd(1)),
+      _writeGeneration(std::make_shared<AtomicUInt64>()),
       _cappedNotifier(_recordStore->isCapped() ? new CappedInsertNotifier() : nullptr),
       _mustTakeCappedLockOnInsert(isCapped() && !_ns.isSystemDotProfile() && !_ns.isOplog()) {
 
@@ -361,6 +368,7 @@ Status Collection::insertDocumentsForOplog(OperationContext* txn,
     invariant(!_indexCatalog.haveAnyIndexes());
     invariant(!_mustTakeCappedLockOnInsert);
 
+    _notifyOfWrite(txn);
     Status status = _recordStore->insertRecordsWithDocWriter(txn, docs, nDocs);
     if (!status.isOK())
         return status;
@@ -412,6 +420,7 @@ Status Collection::insertDocuments(OperationContext* txn,
     if (_mustTakeCappedLockOnInsert)
         synchronizeOnCappedInFlightResource(txn->lockState(), _ns);
 
+    _notifyOfWrite(txn);
     Status status = _insertDocuments(txn, begin, end, enforceQuota, opDebug);
     if (!status.isOK())
         return status;
@@ -463,6 +472,7 @@ Status Collection::insertDocument(OperationContext* txn,
     if (_mustTakeCappedLockOnInsert)
         synchronizeOnCappedInFlightResource(txn->lockState(), _ns);
 
+    _notifyOfWrite(txn);
     StatusWith<RecordId> loc =
         _recordStore->insertRecord(txn, doc.objdata(), doc.objsize(), _enforceQuota(enforceQuota));
 
@@ -554,10 +564,14 @@ void Collection::notifyCappedWaitersIfNeeded() {
 Status Collection::aboutToDeleteCapped(OperationContext* txn,
                                        const RecordId& loc,
                                        RecordData data) {
+    _notifyOfWrite(txn);
+
     /* check if any cursors point to us.  if so, advance them. */
     _cursorManager.invalidateDocument(txn, loc, INVALIDATION_DELETION);
 
     BSONObj doc = data.releaseToBson();
+    getGlobalServiceContext()->getOpObserver()->aboutToDeleteCapped(txn, ns(), doc);
+
     int64_t* const nullKeysDeleted = nullptr;
     _indexCatalog.unindexRecord(txn, doc, loc, false, nullKeysDeleted);
 
@@ -583,6 +597,8 @@ void Collection::deleteDocument(
     auto deleteState =
         getGlobalServiceContext()->getOpObserver()->aboutToDelete(txn, ns(), doc.value());
 
+    _notifyOfWrite(txn);
+
     /* check if any cursors point to us.  if so, advance them. */
     _cursorManager.invalidateDocument(txn, loc, INVALIDATION_DELETION);
 
@@ -608,7 +624,8 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* txn,
                                                 bool enforceQuota,
                                                 bool indexesAffected,
                                                 OpDebug* opDebug,
-                                                OplogUpdateEntryArgs* args) {
+                                                OplogUpdateEntryArgs* args,
+                                                const FieldRefSet* updatedFields) {
     {
         auto status = checkValidation(txn, newDoc);
         if (!status.isOK()) {
@@ -659,14 +676,34 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* txn,
                               << " != "
                               << newDoc.objsize()};
 
-    // At the end of this step, we will have a map of UpdateTickets, one per index, which
-    // represent the index updates needed to be done, based on the changes between oldDoc and
-    // newDoc.
+    // At the end of this step, we will have a map of UpdateTickets, one per index the update may
+    // affect, which represent the index updates needed to be done, based on the changes between
+    // oldDoc and newDoc.
     OwnedPointerMap<IndexDescriptor*, UpdateTicket> updateTickets;
     if (indexesAffected) {
+        auto mightAffectIndex = [&](const IndexDescriptor* descriptor) {
+            if (!updatedFields) {
+                return true;
+            }
+            const UpdateIndexData* indexedPaths =
+                _infoCache.getIndexKeys(txn, descriptor->indexName());
+            if (!indexedPaths) {
+                return true;
+            }
+            for (const FieldRef* field : *updatedFields) {
+                if (indexedPaths->mightBeIndexed(field->dottedField())) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(txn, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            if (!mightAffectIndex(descriptor)) {
+                continue;
+            }
             IndexCatalogEntry* entry = ii.catalogEntry(descriptor);
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
@@ -687,6 +724,7 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* txn,
         }
     }
 
+    _notifyOfWrite(txn);
     Status updateStatus = _recordStore->updateRecord(
         txn, oldLocation, newDoc.objdata(), newDoc.objsize(), _enforceQuota(enforceQuota), this);
 
@@ -702,12 +740,15 @@ StatusWith<RecordId> Collection::updateDocument(OperationContext* txn,
         IndexCatalog::IndexIterator ii = _indexCatalog.getIndexIterator(txn, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            auto updateTicket = updateTickets.map().find(descriptor);
+            if (updateTicket == updateTickets.map().end()) {
+                continue;  // The update can't change this index's keys.
+            }
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
             int64_t keysInserted;
             int64_t keysDeleted;
-            Status ret = iam->update(
-                txn, *updateTickets.mutableMap()[descriptor], &keysInserted, &keysDeleted);
+            Status ret = iam->update(txn, *updateTicket->second, &keysInserted, &keysDeleted);
             if (!ret.isOK())
                 return StatusWith<RecordId>(ret);
             if (opDebug) {
@@ -805,6 +846,7 @@ StatusWith<RecordData> Collection::updateDocumentWithDamages(
     // Broadcast the mutation so that query results stay correct.
     _cursorManager.invalidateDocument(txn, loc, INVALIDATION_MUTATION);
 
+    _notifyOfWrite(txn);
     auto newRecStatus =
         _recordStore->updateWithDamages(txn, loc, oldRec.value(), damageSource, damages);
 
@@ -900,6 +942,7 @@ Status Collection::truncate(OperationContext* txn) {
     _cursorManager.invalidateAll(false, "collection truncated");
 
     // 3) truncate record store
+    _notifyOfWrite(txn);
     status = _recordStore->truncate(txn);
     if (!status.isOK())
         return status;
@@ -921,9 +964,21 @@ void Collection::cappedTruncateAfter(OperationContext* txn, RecordId end, bool i
     invariant(_indexCatalog.numIndexesInProgress(txn) == 0);
 
     _cursorManager.invalidateAll(false, "capped collection truncated");
+    _notifyOfWrite(txn);
     _recordStore->cappedTruncateAfter(txn, end, inclusive);
 }
 
+void Collection::_notifyOfWrite(OperationContext* txn) {
+    // Only the pipeline result cache reads the write generation.
+    if (internalQueryPipelineResultCacheSizeBytes <= 0) {
+        return;
+    }
+
+    _writeGeneration->fetchAndAdd(1);
+    txn->recoveryUnit()->onCommit(
+        [writeGeneration = _writeGeneration]() { writeGeneration->fetchAndAdd(1); });
+}
+
 Status Collection::setValidator(OperationContext* txn, BSONObj validatorDoc) {
     invariant(txn->lockState()->isCollectionLockedForMode(ns().toString(), MODE_X));
 
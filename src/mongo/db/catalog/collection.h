@@ -50,6 +50,7 @@
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/snapshot.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 
@@ -58,6 +59,7 @@ namespace mongo {
 class CollectionCatalogEntry;
 class DatabaseCatalogEntry;
 class ExtentManager;
+class FieldRefSet;
 class IndexCatalog;
 class MatchExpression;
 class MultiIndexBlock;
@@ -315,6 +317,8 @@ public:
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     * 'updatedFields' Optional argument. When not null, it holds every path the update may have
+     * modified, and only the indexes on those paths have their keys recomputed.
      * @return the post update location of the doc (may or may not be the same as oldLocation)
      */
     StatusWith<RecordId> updateDocument(OperationContext* txn,
@@ -324,7 +328,8 @@ public:
                                         bool enforceQuota,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
-                                        OplogUpdateEntryArgs* args);
+                                        OplogUpdateEntryArgs* args,
+                                        const FieldRefSet* updatedFields = nullptr);
 
     bool updateWithDamagesSupported() const;
 
@@ -432,6 +437,25 @@ public:
 
     uint64_t getIndexSize(OperationContext* opCtx, BSONObjBuilder* details = NULL, int scale = 1);
 
+    /**
+     * Returns a number which is different for every Collection object ever created in this
+     * process, so that it distinguishes this one from earlier ones with the same namespace.
+     */
+    uint64_t getIncarnation() const {
+        return _incarnation;
+    }
+
+    /**
+     * Returns a counter which advances whenever a write to this collection is made, and again
+     * when it commits. A read which opens its snapshot after loading the counter, and finds it
+     * unchanged once it is done, saw the same data as any other such read with the same
+     * incarnation and counter value. The counter remains valid after the collection is dropped.
+     * It only advances while internalQueryPipelineResultCacheSizeBytes is enabled.
+     */
+    std::shared_ptr<const AtomicUInt64> getWriteGeneration() const {
+        return _writeGeneration;
+    }
+
     /**
      * If return value is not boost::none, reads with majority read concern using an older snapshot
      * must error.
@@ -493,6 +517,12 @@ private:
 
     bool _enforceQuota(bool userEnforeQuota) const;
 
+    /**
+     * Advances the write generation now and once the write unit of work of 'txn' commits, if the
+     * pipeline result cache is enabled.
+     */
+    void _notifyOfWrite(OperationContext* txn);
+
     int _magic;
 
     const NamespaceString _ns;
@@ -522,6 +552,9 @@ private:
     // should be about the data.
     mutable CursorManager _cursorManager;
 
+    const uint64_t _incarnation;
+    const std::shared_ptr<AtomicUInt64> _writeGeneration;
+
     // Notifier object for awaitData. Threads polling a capped collection for new data can wait
     // on this object until notified of the arrival of new data.
     //
@@ -109,7 +109,8 @@ private:
 
 StatusWith<CompactStats> Collection::compact(OperationContext* txn,
                                              const CompactOptions* compactOptions) {
-    dassert(txn->lockState()->isCollectionLockedForMode(ns().toString(), MODE_X));
+    dassert(txn->lockState()->isCollectionLockedForMode(
+        ns().toString(), _recordStore->compactsInPlace() ? MODE_IX : MODE_X));
 
     DisableDocumentValidation validationDisabler(txn);
 
@@ -120,14 +121,23 @@ StatusWith<CompactStats> Collection::compact(OperationContext* txn,
                                             << _recordStore->name());
 
     if (_recordStore->compactsInPlace()) {
+        // Report progress in currentOp as one step for the collection and one for each index.
+        stdx::unique_lock<Client> lk(*txn->getClient());
+        ProgressMeterHolder pm(*txn->setMessage_inlock(
+            "compact", "Compacting Progress", 1 + _indexCatalog.numIndexesReady(txn)));
+        lk.unlock();
+
         CompactStats stats;
         Status status = _recordStore->compact(txn, NULL, compactOptions, &stats);
         if (!status.isOK())
             return StatusWith<CompactStats>(status);
+        pm.hit();
 
         // Compact all indexes (not including unfinished indexes)
         IndexCatalog::IndexIterator ii(_indexCatalog.getIndexIterator(txn, false));
         while (ii.more()) {
+            txn->checkForInterrupt();
+
             IndexDescriptor* descriptor = ii.next();
             IndexAccessMethod* index = _indexCatalog.getIndex(descriptor);
 
@@ -137,6 +147,7 @@ StatusWith<CompactStats> Collection::compact(OperationContext* txn,
                 error() << "failed to compact index: " << descriptor->toString();
                 return status;
             }
+            pm.hit();
         }
 
         return StatusWith<CompactStats>(stats);
@@ -66,6 +66,13 @@ public:
     */
     const UpdateIndexData& getIndexKeys(OperationContext* txn) const;
 
+    /**
+     * Returns the paths an update must modify to possibly change the keys of the index named
+     * 'indexName', or whether the document belongs in it at all. Returns nullptr if the index is
+     * not known to the cache, in which case it must be assumed to be affected by any update.
+     */
+    const UpdateIndexData* getIndexKeys(OperationContext* txn, StringData indexName) const;
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
@@ -113,6 +120,8 @@ private:
     // ---  index keys cache
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
+    // The same paths split up by index name, so that updates only maintain the indexes they touch.
+    std::map<std::string, UpdateIndexData> _indexedPathsByIndex;
 
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
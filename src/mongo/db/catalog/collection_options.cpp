@@ -115,6 +115,7 @@ void CollectionOptions::reset() {
     collation = BSONObj();
     viewOn = "";
     pipeline = BSONObj();
+    materialized = false;
 }
 
 bool CollectionOptions::isValid() const {
@@ -122,7 +123,11 @@ bool CollectionOptions::isValid() const {
 }
 
 bool CollectionOptions::isView() const {
-    return !viewOn.empty();
+    return !viewOn.empty() && !materialized;
+}
+
+bool CollectionOptions::isMaterializedView() const {
+    return !viewOn.empty() && materialized;
 }
 
 Status CollectionOptions::validate() const {
@@ -264,6 +269,12 @@ Status CollectionOptions::parse(const BSONObj& options) {
             }
 
             pipeline = e.Obj().getOwned();
+        } else if (fieldName == "materialized") {
+            if (!e.isBoolean()) {
+                return Status(ErrorCodes::BadValue, "'materialized' has to be a boolean.");
+            }
+
+            materialized = e.boolean();
         } else if (!createdOn24OrEarlier &&
                    collectionOptionsWhitelist.find(fieldName) == collectionOptionsWhitelist.end()) {
             return Status(ErrorCodes::InvalidOptions,
@@ -277,6 +288,10 @@ Status CollectionOptions::parse(const BSONObj& options) {
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (viewOn.empty() && materialized) {
+        return Status(ErrorCodes::BadValue, "'materialized' cannot be specified without 'viewOn'");
+    }
+
     return Status::OK();
 }
 
@@ -336,6 +351,10 @@ BSONObj CollectionOptions::toBSON() const {
         b.append("pipeline", pipeline);
     }
 
+    if (materialized) {
+        b.appendBool("materialized", true);
+    }
+
     return b.obj();
 }
 }
@@ -52,6 +52,13 @@ struct CollectionOptions {
      */
     bool isView() const;
 
+    /**
+     * Returns true if the options indicate the namespace is a materialized view: a real collection
+     * holding the results of 'pipeline' run on 'viewOn', which is kept up to date on every write to
+     * 'viewOn'.
+     */
+    bool isMaterializedView() const;
+
     /**
      * Confirms that collection options can be converted to BSON and back without errors.
      */
@@ -120,5 +127,7 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+    // Whether the results of the view are stored in this collection rather than computed on read.
+    bool materialized;
 };
 }
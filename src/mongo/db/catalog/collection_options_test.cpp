@@ -263,6 +263,26 @@ TEST(CollectionOptions, PipelineFieldRequiresViewOn) {
     ASSERT_NOT_OK(options.parse(fromjson("{pipeline: [{$match: {}}]}")));
 }
 
+TEST(CollectionOptions, MaterializedViewParsesCorrectly) {
+    CollectionOptions options;
+    ASSERT_OK(
+        options.parse(fromjson("{viewOn: 'c', pipeline: [{$match: {}}], materialized: true}")));
+    ASSERT_TRUE(options.isMaterializedView());
+    ASSERT_FALSE(options.isView());
+    ASSERT_BSONOBJ_EQ(options.toBSON(),
+                      fromjson("{viewOn: 'c', pipeline: [{$match: {}}], materialized: true}"));
+}
+
+TEST(CollectionOptions, MaterializedFieldRequiresViewOn) {
+    CollectionOptions options;
+    ASSERT_NOT_OK(options.parse(fromjson("{materialized: true}")));
+}
+
+TEST(CollectionOptions, MaterializedFieldMustBeBoolean) {
+    CollectionOptions options;
+    ASSERT_NOT_OK(options.parse(fromjson("{viewOn: 'c', materialized: 1}")));
+}
+
 TEST(CollectionOptions, UnknownTopLevelOptionFailsToParse) {
     CollectionOptions options;
     auto status = options.parse(fromjson("{invalidOption: 1}"));
@@ -327,71 +327,85 @@ void CursorManager::invalidateAll(bool collectionGoingAway, const std::string& r
     vector<ClientCursor*> toDelete;
 
     {
-        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        auto lks = _lockAllPartitions();
         fassert(28819, !BackgroundOperation::inProgForNs(_nss));
 
-        for (ExecSet::iterator it = _nonCachedExecutors.begin(); it != _nonCachedExecutors.end();
-             ++it) {
-            // we kill the executor, but it deletes itself
-            PlanExecutor* exec = *it;
-            exec->kill(reason);
+        for (auto&& partition : _executorPartitions) {
+            for (ExecSet::iterator it = partition.executors.begin();
+                 it != partition.executors.end();
+                 ++it) {
+                // we kill the executor, but it deletes itself
+                PlanExecutor* exec = *it;
+                exec->kill(reason);
+            }
+            partition.executors.clear();
+            partition.size.store(0);
         }
-        _nonCachedExecutors.clear();
 
         if (collectionGoingAway) {
             // we're going to wipe out the world
-            for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-                ClientCursor* cc = i->second;
-
-                cc->kill();
-
-                // If the CC is pinned, somebody is actively using it and we do not delete it.
-                // Instead we notify the holder that we killed it.  The holder will then delete the
-                // CC.
-                //
-                // If the CC is not pinned, there is nobody actively holding it.  We can safely
-                // delete it.
-                if (!cc->_isPinned) {
-                    toDelete.push_back(cc);
+            for (auto&& partition : _cursorPartitions) {
+                for (CursorMap::const_iterator i = partition.cursors.begin();
+                     i != partition.cursors.end();
+                     ++i) {
+                    ClientCursor* cc = i->second;
+
+                    cc->kill();
+
+                    // If the CC is pinned, somebody is actively using it and we do not delete it.
+                    // Instead we notify the holder that we killed it.  The holder will then delete
+                    // the CC.
+                    //
+                    // If the CC is not pinned, there is nobody actively holding it.  We can safely
+                    // delete it.
+                    if (!cc->_isPinned) {
+                        toDelete.push_back(cc);
+                    }
                 }
             }
         } else {
-            CursorMap newMap;
-
             // collection will still be around, just all PlanExecutors are invalid
-            for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-                ClientCursor* cc = i->second;
-
-                // Note that a valid ClientCursor state is "no cursor no executor."  This is because
-                // the set of active cursor IDs in ClientCursor is used as representation of query
-                // state.
-                if (!cc->getExecutor()) {
-                    newMap.insert(*i);
-                    continue;
+            for (auto&& partition : _cursorPartitions) {
+                CursorMap newMap;
+
+                for (CursorMap::const_iterator i = partition.cursors.begin();
+                     i != partition.cursors.end();
+                     ++i) {
+                    ClientCursor* cc = i->second;
+
+                    // Note that a valid ClientCursor state is "no cursor no executor."  This is
+                    // because the set of active cursor IDs in ClientCursor is used as
+                    // representation of query state.
+                    if (!cc->getExecutor()) {
+                        newMap.insert(*i);
+                        continue;
+                    }
+
+                    if (cc->_isPinned || cc->isAggCursor()) {
+                        // Pinned cursors need to stay alive, so we leave them around.  Aggregation
+                        // cursors also can stay alive (since they don't have their lifetime bound
+                        // to the underlying collection).  However, if they have an associated
+                        // executor, we need to kill it, because it's now invalid.
+                        if (cc->getExecutor())
+                            cc->getExecutor()->kill(reason);
+                        newMap.insert(*i);
+                    } else {
+                        cc->kill();
+                        toDelete.push_back(cc);
+                    }
                 }
 
-                if (cc->_isPinned || cc->isAggCursor()) {
-                    // Pinned cursors need to stay alive, so we leave them around.  Aggregation
-                    // cursors also can stay alive (since they don't have their lifetime bound to
-                    // the underlying collection).  However, if they have an associated executor, we
-                    // need to kill it, because it's now invalid.
-                    if (cc->getExecutor())
-                        cc->getExecutor()->kill(reason);
-                    newMap.insert(*i);
-                } else {
-                    cc->kill();
-                    toDelete.push_back(cc);
-                }
+                partition.cursors = newMap;
+                partition.size.store(partition.cursors.size());
             }
-
-            _cursors = newMap;
         }
     }
 
-    // ClientCursors must be destroyed without holding '_mutex'. This is because the destruction of
-    // a ClientCursor may itself require accessing another CursorManager (e.g. when deregistering a
-    // non-cached PlanExecutor from a $lookup stage). We won't access this CursorManger when
-    // destroying a ClientCursor because we've already killed all of its non-cached PlanExecutors.
+    // ClientCursors must be destroyed without holding the partition locks. This is because the
+    // destruction of a ClientCursor may itself require accessing another CursorManager (e.g. when
+    // deregistering a non-cached PlanExecutor from a $lookup stage). We won't access this
+    // CursorManger when destroying a ClientCursor because we've already killed all of its
+    // non-cached PlanExecutors.
     for (auto* cursor : toDelete) {
         delete cursor;
     }
@@ -406,18 +420,33 @@ void CursorManager::invalidateDocument(OperationContext* txn,
         return;
     }
 
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-
-    for (ExecSet::iterator it = _nonCachedExecutors.begin(); it != _nonCachedExecutors.end();
-         ++it) {
-        PlanExecutor* exec = *it;
-        exec->invalidate(txn, dl, type);
+    // Without document level locking, the caller holds the collection lock exclusively. Executors
+    // and cursors are only registered under a collection lock, so none can be added to a partition
+    // while this runs. It is therefore safe to skip the empty partitions, and to lock the others
+    // one at a time rather than all at once.
+    for (auto&& partition : _executorPartitions) {
+        if (partition.size.load() == 0) {
+            continue;
+        }
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        for (ExecSet::iterator it = partition.executors.begin(); it != partition.executors.end();
+             ++it) {
+            PlanExecutor* exec = *it;
+            exec->invalidate(txn, dl, type);
+        }
     }
 
-    for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        PlanExecutor* exec = i->second->getExecutor();
-        if (exec) {
-            exec->invalidate(txn, dl, type);
+    for (auto&& partition : _cursorPartitions) {
+        if (partition.size.load() == 0) {
+            continue;
+        }
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        for (CursorMap::const_iterator i = partition.cursors.begin(); i != partition.cursors.end();
+             ++i) {
+            PlanExecutor* exec = i->second->getExecutor();
+            if (exec) {
+                exec->invalidate(txn, dl, type);
+            }
         }
     }
 }
@@ -425,26 +454,28 @@ void CursorManager::invalidateDocument(OperationContext* txn,
 std::size_t CursorManager::timeoutCursors(int millisSinceLastCall) {
     vector<ClientCursor*> toDelete;
 
-    {
-        stdx::lock_guard<SimpleMutex> lk(_mutex);
+    for (auto&& partition : _cursorPartitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-        for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
+        const size_t firstToDelete = toDelete.size();
+        for (CursorMap::const_iterator i = partition.cursors.begin(); i != partition.cursors.end();
+             ++i) {
             ClientCursor* cc = i->second;
             // shouldTimeout() ensures that we skip pinned cursors.
             if (cc->shouldTimeout(millisSinceLastCall))
                 toDelete.push_back(cc);
         }
 
-        for (vector<ClientCursor*>::const_iterator i = toDelete.begin(); i != toDelete.end(); ++i) {
-            ClientCursor* cc = *i;
+        for (size_t i = firstToDelete; i < toDelete.size(); ++i) {
+            ClientCursor* cc = toDelete[i];
             _deregisterCursor_inlock(cc);
             cc->kill();
         }
     }
 
-    // ClientCursors must be destroyed without holding '_mutex'. This is because the destruction of
-    // a ClientCursor may itself require accessing this CursorManager (e.g. when deregistering a
-    // non-cached PlanExecutor).
+    // ClientCursors must be destroyed without holding the partition locks. This is because the
+    // destruction of a ClientCursor may itself require accessing this CursorManager (e.g. when
+    // deregistering a non-cached PlanExecutor).
     for (auto* cursor : toDelete) {
         delete cursor;
     }
@@ -453,20 +484,25 @@ std::size_t CursorManager::timeoutCursors(int millisSinceLastCall) {
 }
 
 void CursorManager::registerExecutor(PlanExecutor* exec) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    const std::pair<ExecSet::iterator, bool> result = _nonCachedExecutors.insert(exec);
+    auto& partition = _executorPartition(exec);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    const std::pair<ExecSet::iterator, bool> result = partition.executors.insert(exec);
     invariant(result.second);  // make sure this was inserted
+    partition.size.store(partition.executors.size());
 }
 
 void CursorManager::deregisterExecutor(PlanExecutor* exec) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    _nonCachedExecutors.erase(exec);
+    auto& partition = _executorPartition(exec);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    partition.executors.erase(exec);
+    partition.size.store(partition.executors.size());
 }
 
 StatusWith<ClientCursorPin> CursorManager::pinCursor(CursorId id) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorMap::const_iterator it = _cursors.find(id);
-    if (it == _cursors.end()) {
+    auto& partition = _cursorPartition(id);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    CursorMap::const_iterator it = partition.cursors.find(id);
+    if (it == partition.cursors.end()) {
         return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
     }
 
@@ -477,7 +513,8 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(CursorId id) {
 }
 
 void CursorManager::unpin(ClientCursor* cursor) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    auto& partition = _cursorPartition(cursor->cursorid());
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
     invariant(cursor->_isPinned);
     cursor->_isPinned = false;
@@ -488,40 +525,81 @@ bool CursorManager::ownsCursorId(CursorId cursorId) const {
 }
 
 void CursorManager::getCursorIds(std::set<CursorId>* openCursors) const {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    for (auto&& partition : _cursorPartitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-    for (CursorMap::const_iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        ClientCursor* cc = i->second;
-        openCursors->insert(cc->cursorid());
+        for (CursorMap::const_iterator i = partition.cursors.begin(); i != partition.cursors.end();
+             ++i) {
+            ClientCursor* cc = i->second;
+            openCursors->insert(cc->cursorid());
+        }
     }
 }
 
 size_t CursorManager::numCursors() const {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    return _cursors.size();
+    size_t numCursors = 0;
+    for (auto&& partition : _cursorPartitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        numCursors += partition.cursors.size();
+    }
+    return numCursors;
+}
+
+CursorManager::ExecutorPartition& CursorManager::_executorPartition(PlanExecutor* exec) {
+    // Drop the low bits, which are the same for every heap allocated executor.
+    return _executorPartitions[(reinterpret_cast<uintptr_t>(exec) >> 6) % kNumPartitions];
 }
 
-CursorId CursorManager::_allocateCursorId_inlock() {
+CursorManager::CursorPartition& CursorManager::_cursorPartition(CursorId id) {
+    return _cursorPartitions[static_cast<uint32_t>(id) % kNumPartitions];
+}
+
+const CursorManager::CursorPartition& CursorManager::_cursorPartition(CursorId id) const {
+    return _cursorPartitions[static_cast<uint32_t>(id) % kNumPartitions];
+}
+
+std::vector<stdx::unique_lock<SimpleMutex>> CursorManager::_lockAllPartitions() const {
+    std::vector<stdx::unique_lock<SimpleMutex>> lks;
+    lks.reserve(2 * kNumPartitions);
+    for (auto&& partition : _executorPartitions) {
+        lks.emplace_back(partition.mutex);
+    }
+    for (auto&& partition : _cursorPartitions) {
+        lks.emplace_back(partition.mutex);
+    }
+    return lks;
+}
+
+CursorId CursorManager::_allocateCursorId(stdx::unique_lock<SimpleMutex>* partitionLock) {
     for (int i = 0; i < 10000; i++) {
-        unsigned mypart = static_cast<unsigned>(_random->nextInt32());
+        unsigned mypart;
+        {
+            stdx::lock_guard<SimpleMutex> lk(_randomMutex);
+            mypart = static_cast<unsigned>(_random->nextInt32());
+        }
         CursorId id = cursorIdFromParts(_collectionCacheRuntimeId, mypart);
-        if (_cursors.count(id) == 0)
+
+        auto& partition = _cursorPartition(id);
+        stdx::unique_lock<SimpleMutex> lk(partition.mutex);
+        if (partition.cursors.count(id) == 0) {
+            *partitionLock = std::move(lk);
             return id;
+        }
     }
     fassertFailed(17360);
 }
 
 ClientCursorPin CursorManager::registerCursor(const ClientCursorParams& cursorParams) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorId cursorId = _allocateCursorId_inlock();
+    stdx::unique_lock<SimpleMutex> lk;
+    CursorId cursorId = _allocateCursorId(&lk);
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
         new ClientCursor(cursorParams, this, cursorId));
     return _registerCursor_inlock(std::move(clientCursor));
 }
 
 ClientCursorPin CursorManager::registerRangePreserverCursor(const Collection* collection) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
-    CursorId cursorId = _allocateCursorId_inlock();
+    stdx::unique_lock<SimpleMutex> lk;
+    CursorId cursorId = _allocateCursorId(&lk);
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(
         new ClientCursor(collection, this, cursorId));
     return _registerCursor_inlock(std::move(clientCursor));
@@ -532,14 +610,17 @@ ClientCursorPin CursorManager::_registerCursor_inlock(
     CursorId cursorId = clientCursor->cursorid();
     invariant(cursorId);
 
-    // Transfer ownership of the cursor to '_cursors'.
+    // Transfer ownership of the cursor to its partition.
     ClientCursor* unownedCursor = clientCursor.release();
-    _cursors[cursorId] = unownedCursor;
+    auto& partition = _cursorPartition(cursorId);
+    partition.cursors[cursorId] = unownedCursor;
+    partition.size.store(partition.cursors.size());
     return ClientCursorPin(unownedCursor);
 }
 
 void CursorManager::deregisterCursor(ClientCursor* cc) {
-    stdx::lock_guard<SimpleMutex> lk(_mutex);
+    auto& partition = _cursorPartition(cc->cursorid());
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
     _deregisterCursor_inlock(cc);
 }
 
@@ -547,10 +628,11 @@ Status CursorManager::eraseCursor(OperationContext* txn, CursorId id, bool shoul
     ClientCursor* cursor;
 
     {
-        stdx::lock_guard<SimpleMutex> lk(_mutex);
+        auto& partition = _cursorPartition(id);
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-        CursorMap::iterator it = _cursors.find(id);
-        if (it == _cursors.end()) {
+        CursorMap::iterator it = partition.cursors.find(id);
+        if (it == partition.cursors.end()) {
             if (shouldAudit) {
                 audit::logKillCursorsAuthzCheck(
                     txn->getClient(), _nss, id, ErrorCodes::CursorNotFound);
@@ -577,9 +659,9 @@ Status CursorManager::eraseCursor(OperationContext* txn, CursorId id, bool shoul
         _deregisterCursor_inlock(cursor);
     }
 
-    // ClientCursors must be destroyed without holding '_mutex'. This is because the destruction of
-    // a ClientCursor may itself require accessing this CursorManager (e.g. when deregistering a
-    // non-cached PlanExecutor).
+    // ClientCursors must be destroyed without holding the partition lock. This is because the
+    // destruction of a ClientCursor may itself require accessing this CursorManager (e.g. when
+    // deregistering a non-cached PlanExecutor).
     delete cursor;
     return Status::OK();
 }
@@ -587,6 +669,8 @@ Status CursorManager::eraseCursor(OperationContext* txn, CursorId id, bool shoul
 void CursorManager::_deregisterCursor_inlock(ClientCursor* cc) {
     invariant(cc);
     CursorId id = cc->cursorid();
-    _cursors.erase(id);
+    auto& partition = _cursorPartition(id);
+    partition.cursors.erase(id);
+    partition.size.store(partition.cursors.size());
 }
 }  // namespace mongo
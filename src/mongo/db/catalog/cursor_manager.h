@@ -30,11 +30,14 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/invalidation_type.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/util/concurrency/mutex.h"
 
@@ -187,7 +190,48 @@ public:
 private:
     friend class ClientCursorPin;
 
-    CursorId _allocateCursorId_inlock();
+    typedef unordered_set<PlanExecutor*> ExecSet;
+    typedef std::map<CursorId, ClientCursor*> CursorMap;
+
+    // The registered executors and the cursors are each spread over kNumPartitions partitions,
+    // so that registering an executor or pinning a cursor only contends with operations on the
+    // same partition. Executors are partitioned by address and cursors by the random part of
+    // their id. invalidateAll() locks every partition, while invalidateDocument() only locks the
+    // non-empty ones, one at a time. There is a CursorManager per collection, so the number of
+    // partitions is kept small.
+    static const size_t kNumPartitions = 8;
+
+    // 'size' mirrors the size of the partition's container. It is only written with 'mutex' held,
+    // but may be read without it to skip empty partitions.
+    struct ExecutorPartition {
+        mutable SimpleMutex mutex;
+        ExecSet executors;
+        AtomicUInt32 size;
+    };
+
+    struct CursorPartition {
+        mutable SimpleMutex mutex;
+        CursorMap cursors;
+        AtomicUInt32 size;
+    };
+
+    ExecutorPartition& _executorPartition(PlanExecutor* exec);
+    CursorPartition& _cursorPartition(CursorId id);
+    const CursorPartition& _cursorPartition(CursorId id) const;
+
+    /**
+     * Locks all the executor partitions and then all the cursor partitions, always in the same
+     * order. The locks are released when the returned vector goes out of scope.
+     */
+    std::vector<stdx::unique_lock<SimpleMutex>> _lockAllPartitions() const;
+
+    /**
+     * Returns an id that isn't in use, with the lock of its partition held in 'partitionLock'
+     * until the cursor is registered.
+     */
+    CursorId _allocateCursorId(stdx::unique_lock<SimpleMutex>* partitionLock);
+
+    // These require the lock of the cursor's partition.
     void _deregisterCursor_inlock(ClientCursor* cc);
     ClientCursorPin _registerCursor_inlock(
         std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor);
@@ -198,14 +242,11 @@ private:
 
     NamespaceString _nss;
     unsigned _collectionCacheRuntimeId;
-    std::unique_ptr<PseudoRandom> _random;
-
-    mutable SimpleMutex _mutex;
 
-    typedef unordered_set<PlanExecutor*> ExecSet;
-    ExecSet _nonCachedExecutors;
+    SimpleMutex _randomMutex;  // Guards '_random'.
+    std::unique_ptr<PseudoRandom> _random;
 
-    typedef std::map<CursorId, ClientCursor*> CursorMap;
-    CursorMap _cursors;
+    std::array<ExecutorPartition, kNumPartitions> _executorPartitions;
+    std::array<CursorPartition, kNumPartitions> _cursorPartitions;
 };
 }  // namespace mongo
@@ -59,6 +59,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_d.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_engine.h"
@@ -107,6 +108,7 @@ public:
 
         delete it->second;
         _db->_collections.erase(it);
+        _db->_invalidateMaterializedViews();
     }
 
     OperationContext* const _txn;
@@ -127,6 +129,7 @@ public:
         Collection*& inMap = _db->_collections[_coll->ns().ns()];
         invariant(!inMap);
         inMap = _coll;
+        _db->_invalidateMaterializedViews();
     }
 
     Database* const _db;
@@ -394,6 +397,7 @@ Status Database::dropCollectionEvenIfSystem(OperationContext* txn, const Namespa
     LOG(1) << "\t dropIndexes done";
 
     Top::get(txn->getClient()->getServiceContext()).collectionDropped(fullns.toString());
+    QueryStatsStore::get(txn->getServiceContext()).collectionDropped(fullns.ns());
 
     // We want to destroy the Collection object before telling the StorageEngine to destroy the
     // RecordStore.
@@ -434,6 +438,55 @@ void Database::_clearCollectionCache(OperationContext* txn,
 
     it->second->_cursorManager.invalidateAll(false, reason);
     _collections.erase(it);
+    _invalidateMaterializedViews();
+}
+
+void Database::_invalidateMaterializedViews() {
+    stdx::lock_guard<stdx::mutex> lk(_materializedViewsMutex);
+    _materializedViewsValid = false;
+    _materializedViews.clear();
+    _mayHaveMaterializedViews.store(true);
+}
+
+void Database::setMaterializedViewPopulating(const NamespaceString& nss, bool populating) {
+    stdx::lock_guard<stdx::mutex> lk(_materializedViewsMutex);
+    if (populating) {
+        _populatingMaterializedViews.insert(nss.ns());
+    } else {
+        _populatingMaterializedViews.erase(nss.ns());
+    }
+}
+
+std::vector<Database::MaterializedView> Database::getMaterializedViewsOn(
+    OperationContext* txn, const NamespaceString& viewOn) {
+    invariant(txn->lockState()->isDbLockedForMode(name(), MODE_IS));
+
+    stdx::lock_guard<stdx::mutex> lk(_materializedViewsMutex);
+    if (!_materializedViewsValid) {
+        for (auto&& entry : _collections) {
+            CollectionOptions options = entry.second->getCatalogEntry()->getCollectionOptions(txn);
+            if (!options.isMaterializedView()) {
+                continue;
+            }
+            NamespaceString viewOnNss(_name, options.viewOn);
+            _materializedViews[viewOnNss.ns()].push_back(
+                {NamespaceString(entry.first), options.pipeline});
+        }
+        _materializedViewsValid = true;
+        _mayHaveMaterializedViews.store(!_materializedViews.empty());
+    }
+
+    std::vector<MaterializedView> views;
+    auto it = _materializedViews.find(viewOn.ns());
+    if (it == _materializedViews.end()) {
+        return views;
+    }
+    for (auto&& view : it->second) {
+        if (!_populatingMaterializedViews.count(view.nss.ns())) {
+            views.push_back(view);
+        }
+    }
+    return views;
 }
 
 Collection* Database::getCollection(StringData ns) const {
@@ -472,11 +525,13 @@ Status Database::renameCollection(OperationContext* txn,
         _clearCollectionCache(txn, toNS, clearCacheReason);
 
         Top::get(txn->getClient()->getServiceContext()).collectionDropped(fromNS.toString());
+        QueryStatsStore::get(txn->getServiceContext()).collectionDropped(fromNS);
     }
 
     txn->recoveryUnit()->registerChange(new AddCollectionChange(txn, this, toNS));
     Status s = _dbEntry->renameCollection(txn, fromNS, toNS, stayTemp);
     _collections[toNS] = _getOrCreateCollectionInstance(txn, toNS);
+    _invalidateMaterializedViews();
     return s;
 }
 
@@ -547,6 +602,7 @@ Collection* Database::createCollection(OperationContext* txn,
     Collection* collection = _getOrCreateCollectionInstance(txn, ns);
     invariant(collection);
     _collections[ns] = collection;
+    _invalidateMaterializedViews();
 
     BSONObj fullIdIndexSpec;
 
@@ -624,6 +680,7 @@ void Database::dropDatabase(OperationContext* txn, Database* db) {
 
     for (auto&& coll : *db) {
         Top::get(txn->getClient()->getServiceContext()).collectionDropped(coll->ns().ns(), true);
+        QueryStatsStore::get(txn->getServiceContext()).collectionDropped(coll->ns().ns());
     }
 
     dbHolder().close(txn, name);
@@ -31,7 +31,9 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
@@ -40,6 +42,9 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/string_map.h"
 
@@ -61,6 +66,14 @@ class Database {
 public:
     typedef StringMap<Collection*> CollectionMap;
 
+    /**
+     * The definition of a materialized view, as recorded in the options of its collection.
+     */
+    struct MaterializedView {
+        NamespaceString nss;
+        BSONObj pipeline;
+    };
+
     /**
      * Iterating over a Database yields Collection* pointers.
      */
@@ -181,6 +194,28 @@ public:
         return &_views;
     }
 
+    /**
+     * Returns the materialized views in this database which are defined on 'viewOn', other than
+     * those which are still being populated. You must be holding at least an intent lock on this
+     * database.
+     */
+    std::vector<MaterializedView> getMaterializedViewsOn(OperationContext* txn,
+                                                          const NamespaceString& viewOn);
+
+    /**
+     * Returns false if this database is known to have no materialized views, in which case writes
+     * can skip looking for views to maintain. Safe to call without any lock on the database.
+     */
+    bool mayHaveMaterializedViews() const {
+        return _mayHaveMaterializedViews.load();
+    }
+
+    /**
+     * While a materialized view is being populated, getMaterializedViewsOn() leaves it out, so
+     * that writes to its source are not applied to it a second time.
+     */
+    void setMaterializedViewPopulating(const NamespaceString& nss, bool populating);
+
     Collection* getOrCreateCollection(OperationContext* txn, StringData ns);
 
     Status renameCollection(OperationContext* txn,
@@ -228,6 +263,12 @@ private:
      */
     void _clearCollectionCache(OperationContext* txn, StringData fullns, const std::string& reason);
 
+    /**
+     * Marks '_materializedViews' as needing to be rebuilt on next use. Must be called whenever a
+     * collection is added to or removed from '_collections'.
+     */
+    void _invalidateMaterializedViews();
+
     class AddCollectionChange;
     class RemoveCollectionChange;
 
@@ -246,6 +287,17 @@ private:
     DurableViewCatalogImpl _durableViews;  // interface for system.views operations
     ViewCatalog _views;                    // in-memory representation of _durableViews
 
+    // Maps the full namespace of each collection to the materialized views defined on it. Built
+    // lazily from the collection options, since writers only hold intent locks. Invalidating it
+    // requires an exclusive lock on the database, so it cannot change while one is rebuilding it.
+    stdx::mutex _materializedViewsMutex;
+    bool _materializedViewsValid = false;
+    stdx::unordered_map<std::string, std::vector<MaterializedView>> _materializedViews;
+    std::set<std::string> _populatingMaterializedViews;
+
+    // False once '_materializedViews' has been built and found empty. Set again on invalidation.
+    AtomicWord<bool> _mayHaveMaterializedViews{true};
+
     friend class Collection;
     friend class NamespaceDetails;
     friend class IndexCatalog;
@@ -81,23 +81,37 @@ DatabaseHolder& dbHolder() {
 }
 
 
+DatabaseHolder::Partition& DatabaseHolder::_getPartition(StringData dbName) {
+    return const_cast<Partition&>(static_cast<const DatabaseHolder*>(this)->_getPartition(dbName));
+}
+
+const DatabaseHolder::Partition& DatabaseHolder::_getPartition(StringData dbName) const {
+    size_t hash = 0;
+    for (char c : dbName) {
+        hash = hash * 31 + static_cast<unsigned char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return _partitions[hash % kNumPartitions];
+}
+
 Database* DatabaseHolder::get(OperationContext* txn, StringData ns) const {
     const StringData db = _todb(ns);
     invariant(txn->lockState()->isDbLockedForMode(db, MODE_IS));
 
-    stdx::lock_guard<SimpleMutex> lk(_m);
-    DBs::const_iterator it = _dbs.find(db);
-    if (it != _dbs.end()) {
+    const Partition& partition = _getPartition(db);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    DBs::const_iterator it = partition.dbs.find(db);
+    if (it != partition.dbs.end()) {
         return it->second;
     }
 
     return NULL;
 }
 
-std::set<std::string> DatabaseHolder::_getNamesWithConflictingCasing_inlock(StringData name) {
+std::set<std::string> DatabaseHolder::_getNamesWithConflictingCasing_inlock(
+    const Partition& partition, StringData name) {
     std::set<std::string> duplicates;
 
-    for (const auto& nameAndPointer : _dbs) {
+    for (const auto& nameAndPointer : partition.dbs) {
         // A name that's equal with case-insensitive match must be identical, or it's a duplicate.
         if (name.equalCaseInsensitive(nameAndPointer.first) && name != nameAndPointer.first)
             duplicates.insert(nameAndPointer.first);
@@ -106,8 +120,9 @@ std::set<std::string> DatabaseHolder::_getNamesWithConflictingCasing_inlock(Stri
 }
 
 std::set<std::string> DatabaseHolder::getNamesWithConflictingCasing(StringData name) {
-    stdx::lock_guard<SimpleMutex> lk(_m);
-    return _getNamesWithConflictingCasing_inlock(name);
+    const Partition& partition = _getPartition(name);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+    return _getNamesWithConflictingCasing_inlock(partition, name);
 }
 
 Database* DatabaseHolder::openDb(OperationContext* txn, StringData ns, bool* justCreated) {
@@ -117,22 +132,23 @@ Database* DatabaseHolder::openDb(OperationContext* txn, StringData ns, bool* jus
     if (justCreated)
         *justCreated = false;  // Until proven otherwise.
 
-    stdx::unique_lock<SimpleMutex> lk(_m);
+    Partition& partition = _getPartition(dbname);
+    stdx::unique_lock<SimpleMutex> lk(partition.mutex);
 
     // The following will insert a nullptr for dbname, which will treated the same as a non-
     // existant database by the get method, yet still counts in getNamesWithConflictingCasing.
-    if (auto db = _dbs[dbname])
+    if (auto db = partition.dbs[dbname])
         return db;
 
     // We've inserted a nullptr entry for dbname: make sure to remove it on unsuccessful exit.
-    auto removeDbGuard = MakeGuard([this, &lk, dbname] {
+    auto removeDbGuard = MakeGuard([&partition, &lk, dbname] {
         if (!lk.owns_lock())
             lk.lock();
-        _dbs.erase(dbname);
+        partition.dbs.erase(dbname);
     });
 
     // Check casing in lock to avoid transient duplicates.
-    auto duplicates = _getNamesWithConflictingCasing_inlock(dbname);
+    auto duplicates = _getNamesWithConflictingCasing_inlock(partition, dbname);
     uassert(ErrorCodes::DatabaseDifferCase,
             str::stream() << "db already exists with different case already have: ["
                           << *duplicates.cbegin()
@@ -161,10 +177,10 @@ Database* DatabaseHolder::openDb(OperationContext* txn, StringData ns, bool* jus
     // Finally replace our nullptr entry with the new Database pointer.
     removeDbGuard.Dismiss();
     lk.lock();
-    auto it = _dbs.find(dbname);
-    invariant(it != _dbs.end() && it->second == nullptr);
+    auto it = partition.dbs.find(dbname);
+    invariant(it != partition.dbs.end() && it->second == nullptr);
     it->second = newDb.release();
-    invariant(_getNamesWithConflictingCasing_inlock(dbname.toString()).empty());
+    invariant(_getNamesWithConflictingCasing_inlock(partition, dbname.toString()).empty());
 
     return it->second;
 }
@@ -174,16 +190,17 @@ void DatabaseHolder::close(OperationContext* txn, StringData ns) {
 
     const StringData dbName = _todb(ns);
 
-    stdx::lock_guard<SimpleMutex> lk(_m);
+    Partition& partition = _getPartition(dbName);
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
 
-    DBs::const_iterator it = _dbs.find(dbName);
-    if (it == _dbs.end()) {
+    DBs::const_iterator it = partition.dbs.find(dbName);
+    if (it == partition.dbs.end()) {
         return;
     }
 
     it->second->close(txn);
     delete it->second;
-    _dbs.erase(it);
+    partition.dbs.erase(it);
 
     getGlobalServiceContext()->getGlobalStorageEngine()->closeDatabase(txn, dbName.toString());
 }
@@ -191,11 +208,12 @@ void DatabaseHolder::close(OperationContext* txn, StringData ns) {
 bool DatabaseHolder::closeAll(OperationContext* txn, BSONObjBuilder& result, bool force) {
     invariant(txn->lockState()->isW());
 
-    stdx::lock_guard<SimpleMutex> lk(_m);
-
     set<string> dbs;
-    for (DBs::const_iterator i = _dbs.begin(); i != _dbs.end(); ++i) {
-        dbs.insert(i->first);
+    for (const Partition& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        for (DBs::const_iterator i = partition.dbs.begin(); i != partition.dbs.end(); ++i) {
+            dbs.insert(i->first);
+        }
     }
 
     BSONArrayBuilder bb(result.subarrayStart("dbs"));
@@ -212,11 +230,14 @@ bool DatabaseHolder::closeAll(OperationContext* txn, BSONObjBuilder& result, boo
             continue;
         }
 
-        Database* db = _dbs[name];
+        Partition& partition = _getPartition(name);
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+
+        Database* db = partition.dbs[name];
         db->close(txn);
         delete db;
 
-        _dbs.erase(name);
+        partition.dbs.erase(name);
 
         getGlobalServiceContext()->getGlobalStorageEngine()->closeDatabase(txn, name);
 
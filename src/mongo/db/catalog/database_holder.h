@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <array>
 #include <set>
 #include <string>
 
@@ -83,11 +84,27 @@ public:
     std::set<std::string> getNamesWithConflictingCasing(StringData name);
 
 private:
-    std::set<std::string> _getNamesWithConflictingCasing_inlock(StringData name);
-
     typedef StringMap<Database*> DBs;
-    mutable SimpleMutex _m;
-    DBs _dbs;
+
+    // The opened databases are spread over kNumPartitions partitions, each with its own mutex,
+    // so that operations resolving different databases don't serialize on a single lock. The
+    // partition is picked from the lower-cased name, so names that differ only in casing always
+    // share a partition and can be checked for conflicts under that partition's lock alone.
+    static const size_t kNumPartitions = 16;
+
+    struct Partition {
+        mutable SimpleMutex mutex;
+        DBs dbs;
+    };
+
+    Partition& _getPartition(StringData dbName);
+    const Partition& _getPartition(StringData dbName) const;
+
+    // Requires the lock of the partition that 'name' maps to.
+    static std::set<std::string> _getNamesWithConflictingCasing_inlock(const Partition& partition,
+                                                                       StringData name);
+
+    std::array<Partition, kNumPartitions> _partitions;
 };
 
 DatabaseHolder& dbHolder();
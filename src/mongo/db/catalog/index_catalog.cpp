@@ -1256,6 +1256,19 @@ Status IndexCatalog::_indexFilteredRecords(OperationContext* txn,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(txn, index->descriptor(), &options);
 
+    // Insert the keys of a batch in index order rather than one document at a time.
+    if (bsonRecords.size() > 1) {
+        int64_t inserted;
+        Status status = index->accessMethod()->insertMany(txn, bsonRecords, options, &inserted);
+        if (!status.isOK())
+            return status;
+
+        if (keysInsertedOut) {
+            *keysInsertedOut += inserted;
+        }
+        return Status::OK();
+    }
+
     for (auto bsonRecord : bsonRecords) {
         int64_t inserted;
         invariant(bsonRecord.id != RecordId());
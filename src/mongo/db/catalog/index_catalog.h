@@ -229,6 +229,13 @@ public:
      */
     std::vector<BSONObj> getAndClearUnfinishedIndexes(OperationContext* txn);
 
+    /**
+     * Returns whether init() found index builds that did not finish before the last shutdown.
+     */
+    bool hasUnfinishedIndexes() const {
+        return !_unfinishedIndexes.empty();
+    }
+
 
     struct IndexKillCriteria {
         std::string ns;
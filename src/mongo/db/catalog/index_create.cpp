@@ -49,12 +49,14 @@
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -89,6 +91,71 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+// The number of threads used to sort index keys during an index build. They are shared evenly
+// between the indexes being built together, each of which uses them to sort its batches of keys,
+// and are also used to sort the final batches of the different indexes concurrently once the
+// collection scan is done. A value of 1 or less sorts everything on the building thread.
+MONGO_EXPORT_SERVER_PARAMETER(maxIndexBuildSortThreads, int, 4);
+
+namespace {
+
+/**
+ * Finishes sorting the keys of each of 'builders' using up to 'maxIndexBuildSortThreads' threads,
+ * including the calling one. The sorts do not touch the catalog or the storage engine, so no locks
+ * or OperationContext are needed beyond those the caller already holds.
+ */
+Status sortBulkBuildersInParallel(const std::vector<IndexAccessMethod::BulkBuilder*>& builders) {
+    const size_t numThreads = std::min(
+        builders.size(), static_cast<size_t>(std::max(1, maxIndexBuildSortThreads.load())));
+    if (numThreads <= 1) {
+        // commitBulk() will sort each index as it gets to it.
+        return Status::OK();
+    }
+
+    std::vector<Status> statuses(builders.size(), Status::OK());
+    AtomicUInt32 nextBuilder;
+    auto sortRemainingBuilders = [&] {
+        for (size_t i = nextBuilder.fetchAndAdd(1); i < builders.size();
+             i = nextBuilder.fetchAndAdd(1)) {
+            try {
+                builders[i]->sort();
+            } catch (...) {
+                // An exception escaping a worker thread would terminate the server. Sorting may
+                // also throw std::exceptions such as std::bad_alloc.
+                statuses[i] = exceptionToStatus();
+            }
+        }
+    };
+
+    {
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+        try {
+            for (size_t i = 1; i < numThreads; ++i) {
+                threads.emplace_back(sortRemainingBuilders);
+            }
+        } catch (const std::system_error& ex) {
+            // Not being able to start more threads only means sorting with fewer of them.
+            warning() << "could only start " << threads.size()
+                      << " additional threads to sort index keys: " << ex.what();
+        }
+        sortRemainingBuilders();
+    }
+
+    for (auto&& status : statuses) {
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
 
 /**
  * On rollback sets MultiIndexBlock::_needToCleanup to true.
@@ -211,10 +278,14 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
     std::vector<BSONObj> indexInfoObjs;
     indexInfoObjs.reserve(indexSpecs.size());
     std::size_t eachIndexBuildMaxMemoryUsageBytes = 0;
+    std::size_t eachIndexBuildMaxSortThreads = 1;
     if (!indexSpecs.empty()) {
         eachIndexBuildMaxMemoryUsageBytes =
             static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
             indexSpecs.size();
+        eachIndexBuildMaxSortThreads = std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::max(0, maxIndexBuildSortThreads.load())) /
+                indexSpecs.size());
     }
 
     for (size_t i = 0; i < indexSpecs.size(); i++) {
@@ -241,7 +312,8 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
         if (!_buildInBackground) {
             // Bulk build process requires foreground building as it assumes nothing is changing
             // under it.
-            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes,
+                                                  eachIndexBuildMaxSortThreads);
         }
 
         const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
@@ -421,6 +493,19 @@ Status MultiIndexBlock::insert(const BSONObj& doc, const RecordId& loc) {
 }
 
 Status MultiIndexBlock::doneInserting(std::set<RecordId>* dupsOut) {
+    // Sorting each index's keys is CPU bound and independent of the other indexes, so do it for
+    // all of them at once before loading them one at a time.
+    std::vector<IndexAccessMethod::BulkBuilder*> builders;
+    for (auto&& index : _indexes) {
+        if (index.bulk) {
+            builders.push_back(index.bulk.get());
+        }
+    }
+    Status sortStatus = sortBulkBuildersInParallel(builders);
+    if (!sortStatus.isOK()) {
+        return sortStatus;
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].bulk == NULL)
             continue;
@@ -132,6 +132,19 @@ public:
      */
     static void destroy();
 
+    /**
+     * Detaches the Client object stored in TLS for the current thread and returns it, leaving
+     * the current thread without a Client. Used to hand a Client off between the threads of a
+     * pool which service many sessions, so that the Client can follow its session around.
+     */
+    static ServiceContext::UniqueClient releaseCurrent();
+
+    /**
+     * Attaches 'client' to the current thread, which must not already have a Client. The
+     * Client's reported thread id and the thread name are updated to the current thread.
+     */
+    static void setCurrent(ServiceContext::UniqueClient client);
+
     std::string clientAddress(bool includePort = false) const;
     const std::string& desc() const {
         return _desc;
@@ -212,7 +225,7 @@ private:
     const std::string _desc;
 
     // OS id of the thread, which owns this client
-    const stdx::thread::id _threadId;
+    stdx::thread::id _threadId;
 
     // > 0 for things "conn", 0 otherwise
     const ConnectionId _connectionId;
@@ -33,10 +33,32 @@
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/concurrency/threadlocal.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 
+namespace {
+// Threads are spread round-robin over the counter stripes the first time they record an access.
+AtomicUInt32 nextStripe;
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL unsigned threadStripePlusOne = 0;
+
+size_t currentThreadStripe(size_t numStripes) {
+    if (!threadStripePlusOne) {
+        threadStripePlusOne = nextStripe.fetchAndAdd(1) % numStripes + 1;
+    }
+    return threadStripePlusOne - 1;
+}
+}  // namespace
+
+long long CollectionIndexUsageTracker::IndexUsage::totalAccesses() const {
+    long long total = 0;
+    for (size_t i = 0; i < kNumStripes; ++i) {
+        total += stripes[i].accesses.loadRelaxed();
+    }
+    return total;
+}
+
 CollectionIndexUsageTracker::CollectionIndexUsageTracker(ClockSource* clockSource)
     : _clockSource(clockSource) {
     invariant(_clockSource);
@@ -44,9 +66,13 @@ CollectionIndexUsageTracker::CollectionIndexUsageTracker(ClockSource* clockSourc
 
 void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
     invariant(!indexName.empty());
-    dassert(_indexUsageMap.find(indexName) != _indexUsageMap.end());
+    auto it = _indexUsageMap.find(indexName);
+    if (it == _indexUsageMap.end()) {
+        // The index was dropped after the plan that used it was chosen.
+        return;
+    }
 
-    _indexUsageMap[indexName].accesses.fetchAndAdd(1);
+    it->second.stripes[currentThreadStripe(IndexUsage::kNumStripes)].accesses.fetchAndAdd(1);
 }
 
 void CollectionIndexUsageTracker::registerIndex(StringData indexName, const BSONObj& indexKey) {
@@ -54,7 +80,7 @@ void CollectionIndexUsageTracker::registerIndex(StringData indexName, const BSON
     dassert(_indexUsageMap.find(indexName) == _indexUsageMap.end());
 
     // Create map entry.
-    _indexUsageMap[indexName] = IndexUsageStats(_clockSource->now(), indexKey);
+    _indexUsageMap[indexName] = IndexUsage(_clockSource->now(), indexKey);
 }
 
 void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
@@ -64,7 +90,14 @@ void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
 }
 
 CollectionIndexUsageMap CollectionIndexUsageTracker::getUsageStats() const {
-    return _indexUsageMap;
+    CollectionIndexUsageMap stats;
+    for (auto&& entry : _indexUsageMap) {
+        auto& indexStats = stats[entry.first];
+        indexStats.accesses.store(entry.second.totalAccesses());
+        indexStats.trackerStartTime = entry.second.trackerStartTime;
+        indexStats.indexKey = entry.second.indexKey;
+    }
+    return stats;
 }
 
 }  // namespace mongo
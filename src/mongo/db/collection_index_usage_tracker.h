@@ -111,8 +111,48 @@ public:
     StringMap<CollectionIndexUsageTracker::IndexUsageStats> getUsageStats() const;
 
 private:
+    /**
+     * Internal per-index state. The access count is split into cache line aligned stripes so that
+     * threads hitting the same index do not all bounce a single cache line; getUsageStats() sums
+     * them.
+     */
+    struct IndexUsage {
+        static const size_t kNumStripes = 8;
+
+        IndexUsage() = default;
+        explicit IndexUsage(Date_t now, const BSONObj& key)
+            : trackerStartTime(now), indexKey(key.getOwned()) {}
+
+        IndexUsage(const IndexUsage& other)
+            : trackerStartTime(other.trackerStartTime), indexKey(other.indexKey) {
+            for (size_t i = 0; i < kNumStripes; ++i) {
+                stripes[i].accesses.store(other.stripes[i].accesses.load());
+            }
+        }
+
+        IndexUsage& operator=(const IndexUsage& other) {
+            for (size_t i = 0; i < kNumStripes; ++i) {
+                stripes[i].accesses.store(other.stripes[i].accesses.load());
+            }
+            trackerStartTime = other.trackerStartTime;
+            indexKey = other.indexKey;
+            return *this;
+        }
+
+        long long totalAccesses() const;
+
+        // Each stripe occupies and starts its own 64 byte cache line.
+        struct alignas(64) Stripe {
+            AtomicInt64 accesses;
+        };
+        Stripe stripes[kNumStripes];
+
+        Date_t trackerStartTime;
+        BSONObj indexKey;
+    };
+
     // Map from index name to usage statistics.
-    StringMap<CollectionIndexUsageTracker::IndexUsageStats> _indexUsageMap;
+    StringMap<IndexUsage> _indexUsageMap;
 
     // Clock source. Used when the 'trackerStartTime' time for an IndexUsageStats object needs to
     // be set.
@@ -30,6 +30,7 @@
 
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
@@ -83,6 +84,29 @@ TEST_F(CollectionIndexUsageTrackerTest, MultipleHit) {
     ASSERT_EQUALS(2, statsMap["foo"].accesses.loadRelaxed());
 }
 
+// Test that hits recorded concurrently from many threads are all counted.
+TEST_F(CollectionIndexUsageTrackerTest, HitsFromManyThreads) {
+    const int kThreads = 16;
+    const int kHitsPerThread = 1000;
+    getTracker()->registerIndex("foo", BSON("foo" << 1));
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([this] {
+            for (int j = 0; j < kHitsPerThread; ++j) {
+                getTracker()->recordIndexAccess("foo");
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    CollectionIndexUsageMap statsMap = getTracker()->getUsageStats();
+    ASSERT(statsMap.find("foo") != statsMap.end());
+    ASSERT_EQUALS(kThreads * kHitsPerThread, statsMap["foo"].accesses.loadRelaxed());
+}
+
 TEST_F(CollectionIndexUsageTrackerTest, IndexKey) {
     getTracker()->registerIndex("foo", BSON("foo" << 1));
     CollectionIndexUsageMap statsMap = getTracker()->getUsageStats();
@@ -76,8 +76,8 @@ public:
     }
     virtual void help(stringstream& help) const {
         help << "compact collection\n"
-                "warning: this operation locks the database and is slow. you can cancel with "
-                "killOp()\n"
+                "warning: this operation is slow, and unless the storage engine compacts in place "
+                "it locks the database. you can cancel with killOp()\n"
                 "{ compact : <collection_name>, [force:<bool>], [validate:<bool>],\n"
                 "  [paddingFactor:<num>], [paddingBytes:<num>] }\n"
                 "  force - allows to run on a replica set primary\n"
@@ -145,7 +145,23 @@ public:
             compactOptions.validateDocuments = cmdObj["validate"].trueValue();
 
         ScopedTransaction transaction(txn, MODE_IX);
-        AutoGetDb autoDb(txn, db, MODE_X);
+
+        // Record stores that compact in place, such as WiredTiger's, don't move documents or
+        // rebuild indexes, so the collection can stay in use while they compact. Those only need
+        // intent locks, which still keep the catalog from changing underneath the compaction.
+        bool compactsInPlace = false;
+        {
+            AutoGetCollection autoColl(txn, nss, MODE_IS);
+            if (Collection* collection = autoColl.getCollection()) {
+                compactsInPlace = collection->getRecordStore()->compactsInPlace();
+            }
+        }
+
+        AutoGetDb autoDb(txn, db, compactsInPlace ? MODE_IX : MODE_X);
+        boost::optional<Lock::CollectionLock> collLock;
+        if (compactsInPlace) {
+            collLock.emplace(txn->lockState(), nss.ns(), MODE_IX);
+        }
         Database* const collDB = autoDb.getDb();
 
         Collection* collection = collDB ? collDB->getCollection(nss) : nullptr;
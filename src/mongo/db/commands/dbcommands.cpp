@@ -58,6 +58,7 @@
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/index_filter_commands.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/shutdown.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -93,6 +94,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/stats/storage_stats.h"
+#include "mongo/db/views/materialized_view.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/rpc/metadata.h"
 #include "mongo/rpc/metadata/config_server_metadata.h"
@@ -244,6 +246,7 @@ public:
             return appendCommandStatus(result, Status::OK());
         }
         if (status.isOK()) {
+            removePersistedIndexFiltersOnDrop(txn, NamespaceString(dbname));
             result.append("dropped", dbname);
         }
         return appendCommandStatus(result, status);
@@ -550,7 +553,11 @@ public:
             return false;
         }
 
-        return appendCommandStatus(result, dropCollection(txn, nsToDrop, result));
+        Status status = dropCollection(txn, nsToDrop, result);
+        if (status.isOK()) {
+            removePersistedIndexFiltersOnDrop(txn, nsToDrop);
+        }
+        return appendCommandStatus(result, status);
     }
 
 } cmdDrop;
@@ -609,6 +616,14 @@ public:
                  "view with a default collation. See "
                  "http://dochub.mongodb.org/core/3.4-feature-compatibility."});
         }
+        if (ServerGlobalParams::FeatureCompatibility::Version::k32 == featureCompatibilityVersion &&
+            validateFeaturesAsMaster && cmdObj["materialized"].trueValue()) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::InvalidOptions,
+                 "The featureCompatibilityVersion must be 3.4 to create a materialized view. See "
+                 "http://dochub.mongodb.org/core/3.4-feature-compatibility."});
+        }
 
         // Validate _id index spec and fill in missing fields.
         if (auto idIndexElem = cmdObj["idIndex"]) {
@@ -682,7 +697,26 @@ public:
         }
 
         BSONObj idIndexSpec;
-        return appendCommandStatus(result, createCollection(txn, dbname, cmdObj, idIndexSpec));
+        Status status = createCollection(txn, dbname, cmdObj, idIndexSpec);
+        if (!status.isOK() || !cmdObj["materialized"].trueValue()) {
+            return appendCommandStatus(result, status);
+        }
+
+        // The view is filled once it exists, so that the database is not locked exclusively while
+        // the whole of the source is read.
+        try {
+            materialized_view::populate(txn, ns);
+        } catch (const DBException& ex) {
+            // Do not leave behind a view which does not reflect its source.
+            BSONObjBuilder dropResult;
+            Status dropStatus = dropCollection(txn, ns, dropResult);
+            if (!dropStatus.isOK()) {
+                warning() << "Failed to drop materialized view " << ns
+                          << " after failing to populate it: " << redact(dropStatus);
+            }
+            return appendCommandStatus(result, ex.toStatus());
+        }
+        return appendCommandStatus(result, Status::OK());
     }
 } cmdCreate;
 
@@ -1556,19 +1590,21 @@ void mongo::execCommandDatabase(OperationContext* txn,
 
             if (!command->maintenanceOk() &&
                 replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet &&
-                !replCoord->canAcceptWritesForDatabase(dbname) &&
-                !replCoord->getMemberState().secondary()) {
-
-                uassert(ErrorCodes::NotMasterOrSecondary,
-                        "node is recovering",
-                        !replCoord->getMemberState().recovering());
-                uassert(ErrorCodes::NotMasterOrSecondary,
-                        "node is not in primary or recovering state",
-                        replCoord->getMemberState().primary());
-                // Check ticket SERVER-21432, slaveOk commands are allowed in drain mode
-                uassert(ErrorCodes::NotMasterOrSecondary,
-                        "node is in drain mode",
-                        commandIsOverriddenToRunOnSecondary || commandCanRunOnSecondary);
+                !iAmPrimary) {
+                // Each call takes the replication coordinator's mutex, so we look at one state.
+                const repl::MemberState memberState = replCoord->getMemberState();
+                if (!memberState.secondary()) {
+                    uassert(ErrorCodes::NotMasterOrSecondary,
+                            "node is recovering",
+                            !memberState.recovering());
+                    uassert(ErrorCodes::NotMasterOrSecondary,
+                            "node is not in primary or recovering state",
+                            memberState.primary());
+                    // Check ticket SERVER-21432, slaveOk commands are allowed in drain mode
+                    uassert(ErrorCodes::NotMasterOrSecondary,
+                            "node is in drain mode",
+                            commandIsOverriddenToRunOnSecondary || commandCanRunOnSecondary);
+                }
             }
         }
 
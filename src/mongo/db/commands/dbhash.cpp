@@ -43,6 +43,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/stdx/mutex.h"
@@ -101,6 +102,17 @@ public:
             }
         }
 
+        // With chunkSize, every collection is also hashed in consecutive ranges of about that
+        // many documents in _id order, so that a consistency check can narrow a mismatch down to
+        // the ranges whose digests differ.
+        long long chunkSize = 0;
+        if (BSONElement chunkSizeElem = cmdObj["chunkSize"]) {
+            uassert(ErrorCodes::BadValue,
+                    "chunkSize must be a positive number",
+                    chunkSizeElem.isNumber() && chunkSizeElem.safeNumberLong() > 0);
+            chunkSize = chunkSizeElem.safeNumberLong();
+        }
+
         list<string> colls;
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
@@ -133,6 +145,8 @@ public:
                                                                             "system.views"};
 
 
+        BSONObjBuilder chunksBuilder;
+
         BSONObjBuilder bb(result.subobjStart("collections"));
         for (list<string>::iterator i = colls.begin(); i != colls.end(); i++) {
             string fullCollectionName = *i;
@@ -152,7 +166,13 @@ public:
                 continue;
 
             bool fromCache = false;
-            string hash = _hashCollection(txn, db, fullCollectionName, &fromCache);
+            string hash;
+            if (chunkSize) {
+                BSONArrayBuilder chunks(chunksBuilder.subarrayStart(shortCollectionName));
+                hash = _hashCollection(txn, db, fullCollectionName, chunkSize, &chunks, &fromCache);
+            } else {
+                hash = _hashCollection(txn, db, fullCollectionName, 0, nullptr, &fromCache);
+            }
 
             bb.append(shortCollectionName, hash);
 
@@ -167,6 +187,9 @@ public:
         string hash = digestToString(d);
 
         result.append("md5", hash);
+        if (chunkSize) {
+            result.append("chunks", chunksBuilder.obj());
+        }
         result.appendNumber("timeMillis", timer.millis());
 
         result.append("fromCache", cached);
@@ -196,15 +219,53 @@ private:
         return ns.isConfigDB();
     }
 
+    // Returns {<fieldName>: <_id of 'doc'>}, with null for capped collections without an _id.
+    static BSONObj _idBound(const BSONObj& doc, StringData fieldName) {
+        BSONObjBuilder builder;
+        BSONElement id = doc["_id"];
+        if (id.eoo()) {
+            builder.appendNull(fieldName);
+        } else {
+            builder.appendAs(id, fieldName);
+        }
+        return builder.obj();
+    }
+
+    // Bounds the size of the "chunks" reply field, leaving the rest of the 16MB reply for the
+    // collection hashes.
+    static const int kMaxChunksBytes = BSONObjMaxUserSize / 2;
+
+    // A range ends after each document whose _id hashes to a multiple of 'chunkSize'. The cuts
+    // depend only on the _id values, so a document which is missing or extra on one node only
+    // changes the digests of the range it falls into, instead of shifting every later range.
+    static bool _endsChunk(const BSONObj& doc, long long chunkSize) {
+        BSONElement id = doc["_id"];
+        if (id.eoo()) {
+            return false;
+        }
+        const unsigned long long hash = static_cast<unsigned long long>(
+            BSONElementHasher::hash64(id, BSONElementHasher::DEFAULT_HASH_SEED));
+        return hash % static_cast<unsigned long long>(chunkSize) == 0;
+    }
+
+    /**
+     * Returns the md5 of all the documents of the collection. If 'chunks' is given, it is also
+     * filled with {min, max, count, md5} for consecutive ranges of about 'chunkSize' documents in
+     * _id order, where min and max are the _id values of the first and last document of the range.
+     * Fails if the ranges would not fit in kMaxChunksBytes.
+     */
     std::string _hashCollection(OperationContext* opCtx,
                                 Database* db,
                                 const std::string& fullCollectionName,
+                                long long chunkSize,
+                                BSONArrayBuilder* chunks,
                                 bool* fromCache) {
         stdx::unique_lock<stdx::mutex> cachedHashedLock(_cachedHashedMutex, stdx::defer_lock);
 
         NamespaceString ns(fullCollectionName);
 
-        if (_isCachable(ns)) {
+        // The cache only holds whole-collection hashes.
+        if (!chunks && _isCachable(ns)) {
             cachedHashedLock.lock();
             string hash = _cachedHashed[ns.db().toString()][ns.coll().toString()];
             if (hash.size() > 0) {
@@ -242,6 +303,26 @@ private:
         md5_state_t st;
         md5_init(&st);
 
+        md5_state_t chunkState;
+        long long chunkCount = 0;
+        BSONObj chunkMin;
+        BSONObj chunkMax;
+        auto finishChunk = [&] {
+            md5digest d;
+            md5_finish(&chunkState, d);
+            BSONObjBuilder chunkBuilder;
+            chunkBuilder.appendElements(chunkMin);
+            chunkBuilder.appendElements(chunkMax);
+            chunkBuilder.append("count", chunkCount);
+            chunkBuilder.append("md5", digestToString(d));
+            chunks->append(chunkBuilder.obj());
+            chunkCount = 0;
+            uassert(40421,
+                    str::stream() << "dbHash ranges for " << fullCollectionName
+                                  << " exceed the reply size limit, use a larger chunkSize",
+                    chunks->len() <= kMaxChunksBytes);
+        };
+
         long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
@@ -249,6 +330,22 @@ private:
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
             md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
             n++;
+
+            if (chunks) {
+                if (chunkCount == 0) {
+                    md5_init(&chunkState);
+                    chunkMin = _idBound(c, "min");
+                }
+                md5_append(&chunkState, (const md5_byte_t*)c.objdata(), c.objsize());
+                chunkMax = _idBound(c, "max");
+                ++chunkCount;
+                if (_endsChunk(c, chunkSize)) {
+                    finishChunk();
+                }
+            }
+        }
+        if (chunks && chunkCount > 0) {
+            finishChunk();
         }
         if (PlanExecutor::IS_EOF != state) {
             warning() << "error while hashing, db dropped? ns=" << fullCollectionName;
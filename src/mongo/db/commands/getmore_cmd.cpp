@@ -382,11 +382,9 @@ public:
             // Return immediately if we need to update the commit time.
             if (!request.lastKnownCommittedOpTime ||
                 (request.lastKnownCommittedOpTime == replCoord->getLastCommittedOpTime())) {
-                // Retrieve the notifier which we will wait on until new data arrives. We make sure
-                // to do this in the lock because once we drop the lock it is possible for the
-                // collection to become invalid. The notifier itself will outlive the collection if
-                // the collection is dropped, as we keep a shared_ptr to it.
-                auto notifier = ctx->getCollection()->getCappedInsertNotifier();
+                // Wait on the notifier retrieved before generating the first batch. Our shared_ptr
+                // keeps it valid after the locks are dropped, even if the collection is dropped.
+                invariant(notifier);
 
                 // Save the PlanExecutor and drop our locks.
                 exec->saveState();
@@ -43,11 +43,19 @@
 #include "mongo/db/client.h"
 #include "mongo/db/commands/index_filter_commands.h"
 #include "mongo/db/commands/plan_cache_commands.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/ops/delete.h"
+#include "mongo/db/ops/update.h"
+#include "mongo/db/ops/update_lifecycle_impl.h"
+#include "mongo/db/ops/update_request.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/log.h"
 
@@ -88,6 +96,97 @@ static Status getQuerySettingsAndPlanCache(OperationContext* txn,
     return Status::OK();
 }
 
+BSONObj persistedFilterId(const std::string& ns, const PlanCacheKey& key) {
+    return BSON("ns" << ns << "key" << key);
+}
+
+/**
+ * Returns whether this node may write to the persisted index filters. Index filter commands can
+ * run on secondaries, where they only change the filters in memory.
+ */
+bool canPersistIndexFilters() {
+    if (repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(
+            kPersistedIndexFiltersNamespace)) {
+        return true;
+    }
+    LOG(1) << "Not persisting index filter change because this node is not primary";
+    return false;
+}
+
+/**
+ * Records the index filter that 'cmdObj', a planCacheSetFilter command, set on 'ns'.
+ */
+Status persistIndexFilter(OperationContext* txn,
+                          const std::string& ns,
+                          const PlanCacheKey& key,
+                          const BSONObj& cmdObj) {
+    BSONObjBuilder docBuilder;
+    docBuilder.append("_id", persistedFilterId(ns, key));
+    docBuilder.append("ns", ns);
+    for (auto fieldName : {"query", "sort", "projection", "collation", "indexes"}) {
+        BSONElement elt = cmdObj[fieldName];
+        if (!elt.eoo()) {
+            docBuilder.append(elt);
+        }
+    }
+    const BSONObj doc = docBuilder.obj();
+    const NamespaceString& nss = kPersistedIndexFiltersNamespace;
+
+    try {
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
+            ScopedTransaction transaction(txn, MODE_IX);
+            AutoGetOrCreateDb autoDb(txn, nss.db(), MODE_X);
+            if (!canPersistIndexFilters()) {
+                return Status::OK();
+            }
+
+            UpdateRequest request(nss);
+            request.setQuery(BSON("_id" << doc["_id"]));
+            request.setUpdates(doc);
+            request.setUpsert();
+            request.setGod();
+            UpdateLifecycleImpl updateLifecycle(nss);
+            request.setLifecycle(&updateLifecycle);
+            update(txn, autoDb.getDb(), request);
+        }
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_END(txn, "persistIndexFilter", nss.ns());
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+
+/**
+ * Removes the persisted index filters matching 'pattern'.
+ */
+Status removePersistedIndexFilters(OperationContext* txn, const BSONObj& pattern) {
+    const NamespaceString& nss = kPersistedIndexFiltersNamespace;
+
+    try {
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_BEGIN {
+            ScopedTransaction transaction(txn, MODE_IX);
+            AutoGetCollection autoColl(txn, nss, MODE_IX);
+            if (!autoColl.getCollection() || !canPersistIndexFilters()) {
+                return Status::OK();
+            }
+
+            const bool justOne = false;
+            const bool god = true;
+            deleteObjects(txn,
+                          autoColl.getCollection(),
+                          nss.ns(),
+                          pattern,
+                          PlanExecutor::YIELD_MANUAL,
+                          justOne,
+                          god);
+        }
+        MONGO_WRITE_CONFLICT_RETRY_LOOP_END(txn, "removePersistedIndexFilters", nss.ns());
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+
 //
 // Command instances.
 // Registers commands with the command system and make commands
@@ -112,6 +211,8 @@ using std::stringstream;
 using std::vector;
 using std::unique_ptr;
 
+const NamespaceString kPersistedIndexFiltersNamespace("admin.system.indexFilters");
+
 IndexFilterCommand::IndexFilterCommand(const string& name, const string& helpText)
     : Command(name), helpText(helpText) {}
 
@@ -232,18 +333,37 @@ Status ClearFilters::runIndexFilterCommand(OperationContext* txn,
                                            const std::string& ns,
                                            BSONObj& cmdObj,
                                            BSONObjBuilder* bob) {
-    // This is a read lock. The query settings is owned by the collection.
-    AutoGetCollectionForRead ctx(txn, NamespaceString(ns));
+    BSONObj persistedFiltersToRemove;
+    {
+        // This is a read lock. The query settings is owned by the collection.
+        AutoGetCollectionForRead ctx(txn, NamespaceString(ns));
+
+        QuerySettings* querySettings;
+        PlanCache* planCache;
+        Status status =
+            getQuerySettingsAndPlanCache(txn, ctx.getCollection(), ns, &querySettings, &planCache);
+        if (!status.isOK()) {
+            // No collection - do nothing.
+            return Status::OK();
+        }
+        status = clear(txn, querySettings, planCache, ns, cmdObj);
+        if (!status.isOK() || !internalQueryPersistIndexFilters.load()) {
+            return status;
+        }
 
-    QuerySettings* querySettings;
-    PlanCache* planCache;
-    Status status =
-        getQuerySettingsAndPlanCache(txn, ctx.getCollection(), ns, &querySettings, &planCache);
-    if (!status.isOK()) {
-        // No collection - do nothing.
-        return Status::OK();
+        if (cmdObj.hasField("query")) {
+            // clear() already canonicalized this query successfully.
+            auto statusWithCQ = PlanCacheCommand::canonicalize(txn, ns, cmdObj);
+            invariantOK(statusWithCQ.getStatus());
+            persistedFiltersToRemove = BSON(
+                "_id" << persistedFilterId(ns, planCache->computeKey(*statusWithCQ.getValue())));
+        } else {
+            persistedFiltersToRemove = BSON("ns" << ns);
+        }
     }
-    return clear(txn, querySettings, planCache, ns, cmdObj);
+
+    // Write to the persisted filters only once we no longer hold the lock on 'ns'.
+    return removePersistedIndexFilters(txn, persistedFiltersToRemove);
 }
 
 // static
@@ -333,18 +453,32 @@ Status SetFilter::runIndexFilterCommand(OperationContext* txn,
                                         const std::string& ns,
                                         BSONObj& cmdObj,
                                         BSONObjBuilder* bob) {
-    // This is a read lock. The query settings is owned by the collection.
     const NamespaceString nss(ns);
-    AutoGetCollectionForRead ctx(txn, nss);
+    PlanCacheKey key;
+    {
+        // This is a read lock. The query settings is owned by the collection.
+        AutoGetCollectionForRead ctx(txn, nss);
+
+        QuerySettings* querySettings;
+        PlanCache* planCache;
+        Status status =
+            getQuerySettingsAndPlanCache(txn, ctx.getCollection(), ns, &querySettings, &planCache);
+        if (!status.isOK()) {
+            return status;
+        }
+        status = set(txn, querySettings, planCache, ns, cmdObj);
+        if (!status.isOK() || !internalQueryPersistIndexFilters.load()) {
+            return status;
+        }
 
-    QuerySettings* querySettings;
-    PlanCache* planCache;
-    Status status =
-        getQuerySettingsAndPlanCache(txn, ctx.getCollection(), ns, &querySettings, &planCache);
-    if (!status.isOK()) {
-        return status;
+        // set() already canonicalized this query successfully.
+        auto statusWithCQ = PlanCacheCommand::canonicalize(txn, ns, cmdObj);
+        invariantOK(statusWithCQ.getStatus());
+        key = planCache->computeKey(*statusWithCQ.getValue());
     }
-    return set(txn, querySettings, planCache, ns, cmdObj);
+
+    // Write to the persisted filters only once we no longer hold the lock on 'ns'.
+    return persistIndexFilter(txn, ns, key, cmdObj);
 }
 
 // static
@@ -403,4 +537,74 @@ Status SetFilter::set(OperationContext* txn,
     return Status::OK();
 }
 
+void restoreIndexFilters(OperationContext* txn) {
+    if (!internalQueryPersistIndexFilters.load()) {
+        return;
+    }
+
+    std::vector<BSONObj> filters;
+    {
+        DBDirectClient client(txn);
+        auto cursor = client.query(kPersistedIndexFiltersNamespace.ns(), Query());
+        while (cursor->more()) {
+            filters.push_back(cursor->nextSafe().getOwned());
+        }
+    }
+
+    size_t numRestored = 0;
+    for (const auto& filter : filters) {
+        BSONElement nsElt = filter["ns"];
+        if (nsElt.type() != BSONType::String) {
+            warning() << "Skipping malformed persisted index filter " << redact(filter);
+            continue;
+        }
+        const std::string ns = nsElt.String();
+
+        AutoGetCollectionForRead ctx(txn, NamespaceString(ns));
+
+        QuerySettings* querySettings;
+        PlanCache* planCache;
+        Status status =
+            getQuerySettingsAndPlanCache(txn, ctx.getCollection(), ns, &querySettings, &planCache);
+        if (!status.isOK()) {
+            LOG(1) << "Skipping persisted index filter on missing collection " << ns;
+            continue;
+        }
+
+        status = SetFilter::set(txn, querySettings, planCache, ns, filter);
+        if (!status.isOK()) {
+            warning() << "Could not restore persisted index filter " << redact(filter) << ": "
+                      << redact(status);
+            continue;
+        }
+        ++numRestored;
+    }
+
+    log() << "Restored " << numRestored << " of " << filters.size()
+          << " persisted index filters";
+}
+
+void removePersistedIndexFiltersOnDrop(OperationContext* txn, const NamespaceString& nss) {
+    if (!internalQueryPersistIndexFilters.load()) {
+        return;
+    }
+
+    BSONObj pattern;
+    if (nss.coll().empty()) {
+        // Every namespace in the database starts with "<db>.", and '/' sorts right after '.'.
+        const std::string db = nss.db().toString();
+        pattern = BSON("ns" << BSON("$gte" << db + "." << "$lt" << db + "/"));
+    } else {
+        pattern = BSON("ns" << nss.ns());
+    }
+
+    // The drop itself has already succeeded, so a failure here only leaves filters behind which
+    // restoreIndexFilters() skips while their collection does not exist.
+    Status status = removePersistedIndexFilters(txn, pattern);
+    if (!status.isOK()) {
+        warning() << "Could not remove the persisted index filters of dropped namespace " << nss
+                  << ": " << redact(status);
+    }
+}
+
 }  // namespace mongo
@@ -29,6 +29,7 @@
 #pragma once
 
 #include "mongo/db/commands.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 
@@ -183,4 +184,39 @@ public:
                       const BSONObj& cmdObj);
 };
 
+/**
+ * Index filters live in each collection's in-memory QuerySettings, so they are lost on restart.
+ * If internalQueryPersistIndexFilters is set, planCacheSetFilter and planCacheClearFilters also
+ * record their effect on a primary in this replicated collection, one document per query shape:
+ *
+ * {
+ *     _id: {ns: <namespace>, key: <plan cache key>},
+ *     ns: <namespace>,
+ *     query: <query>,
+ *     sort: <sort>,
+ *     projection: <projection>,
+ *     collation: <collation>,
+ *     indexes: [ <index1>, <index2>, <index3>, ... ]
+ * }
+ */
+extern const NamespaceString kPersistedIndexFiltersNamespace;
+
+/**
+ * Sets every index filter recorded in kPersistedIndexFiltersNamespace on its collection, on top
+ * of any filters already in memory. Filters whose collection does not exist are skipped. Does
+ * nothing unless internalQueryPersistIndexFilters is set.
+ *
+ * Called on startup and when a node becomes primary, since filters replicated to a secondary
+ * are not applied to its in-memory query settings as they arrive.
+ */
+void restoreIndexFilters(OperationContext* txn);
+
+/**
+ * Removes the persisted index filters of 'nss' once that collection has been dropped, or, if
+ * 'nss' only names a database, those of every collection in the dropped database. Only a primary
+ * writes to the persisted filters, so this does nothing elsewhere, or unless
+ * internalQueryPersistIndexFilters is set. Must not be called with any locks held.
+ */
+void removePersistedIndexFiltersOnDrop(OperationContext* txn, const NamespaceString& nss);
+
 }  // namespace mongo
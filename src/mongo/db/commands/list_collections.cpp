@@ -34,6 +34,7 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
@@ -129,10 +130,16 @@ void _addWorkingSetMember(OperationContext* txn,
     root->pushBack(id);
 }
 
-BSONObj buildViewBson(const ViewDefinition& view) {
+/**
+ * Builds the listCollections entry for 'view'. With 'nameOnly', only its name and type.
+ */
+BSONObj buildViewBson(const ViewDefinition& view, bool nameOnly) {
     BSONObjBuilder b;
     b.append("name", view.name().coll());
     b.append("type", "view");
+    if (nameOnly) {
+        return b.obj();
+    }
 
     BSONObjBuilder optionsBuilder(b.subobjStart("options"));
     optionsBuilder.append("viewOn", view.viewOn().coll());
@@ -147,7 +154,11 @@ BSONObj buildViewBson(const ViewDefinition& view) {
     return b.obj();
 }
 
-BSONObj buildCollectionBson(OperationContext* txn, const Collection* collection) {
+/**
+ * Builds the listCollections entry for 'collection'. With 'nameOnly', only its name and type, which
+ * saves reading the collection's options from the catalog and looking up its _id index.
+ */
+BSONObj buildCollectionBson(OperationContext* txn, const Collection* collection, bool nameOnly) {
 
     if (!collection) {
         return {};
@@ -161,6 +172,9 @@ BSONObj buildCollectionBson(OperationContext* txn, const Collection* collection)
     BSONObjBuilder b;
     b.append("name", collectionName);
     b.append("type", "collection");
+    if (nameOnly) {
+        return b.obj();
+    }
 
     CollectionOptions options = collection->getCatalogEntry()->getCollectionOptions(txn);
     b.append("options", options.toBSON());
@@ -239,6 +253,13 @@ public:
             matcher = std::move(statusWithMatcher.getValue());
         }
 
+        bool nameOnly;
+        Status nameOnlyStatus =
+            bsonExtractBooleanFieldWithDefault(jsobj, "nameOnly", false, &nameOnly);
+        if (!nameOnlyStatus.isOK()) {
+            return appendCommandStatus(result, nameOnlyStatus);
+        }
+
         const long long defaultBatchSize = std::numeric_limits<long long>::max();
         long long batchSize;
         Status parseCursorStatus =
@@ -260,14 +281,14 @@ public:
                 for (auto&& collName : *collNames) {
                     auto nss = NamespaceString(db->name(), collName);
                     Collection* collection = db->getCollection(nss);
-                    BSONObj collBson = buildCollectionBson(txn, collection);
+                    BSONObj collBson = buildCollectionBson(txn, collection, nameOnly);
                     if (!collBson.isEmpty()) {
                         _addWorkingSetMember(txn, collBson, matcher.get(), ws.get(), root.get());
                     }
                 }
             } else {
                 for (auto&& collection : *db) {
-                    BSONObj collBson = buildCollectionBson(txn, collection);
+                    BSONObj collBson = buildCollectionBson(txn, collection, nameOnly);
                     if (!collBson.isEmpty()) {
                         _addWorkingSetMember(txn, collBson, matcher.get(), ws.get(), root.get());
                     }
@@ -280,7 +301,7 @@ public:
                     filterElt.Obj() == ListCollectionsFilter::makeTypeCollectionFilter());
             if (!skipViews) {
                 db->getViewCatalog()->iterate(txn, [&](const ViewDefinition& view) {
-                    BSONObj viewBson = buildViewBson(view);
+                    BSONObj viewBson = buildViewBson(view, nameOnly);
                     if (!viewBson.isEmpty()) {
                         _addWorkingSetMember(txn, viewBson, matcher.get(), ws.get(), root.get());
                     }
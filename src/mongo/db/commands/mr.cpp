@@ -66,6 +66,7 @@
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/chunk.h"
@@ -99,6 +100,15 @@ namespace dps = ::mongo::dotted_path_support;
 
 namespace mr {
 
+namespace {
+
+// Defaults for the in-memory limits of each mapReduce job, see Config.
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMapReduceJSMaxKeys, int, 500000);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMapReduceReduceTriggerRatio, double, 10.0);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMapReduceMaxInMemorySizeBytes, long long, 500 * 1024);
+
+}  // namespace
+
 AtomicUInt32 Config::JOB_NUMBER;
 
 JSFunction::JSFunction(const std::string& type, const BSONElement& e) {
@@ -294,9 +304,9 @@ Config::Config(const string& _dbname, const BSONObj& cmdObj) {
         splitInfo = cmdObj["splitInfo"].Int();
     }
 
-    jsMaxKeys = 500000;
-    reduceTriggerRatio = 10.0;
-    maxInMemSize = 500 * 1024;
+    jsMaxKeys = internalQueryMapReduceJSMaxKeys.load();
+    reduceTriggerRatio = internalQueryMapReduceReduceTriggerRatio.load();
+    maxInMemSize = internalQueryMapReduceMaxInMemorySizeBytes.load();
 
     uassert(13602, "outType is no longer a valid option", cmdObj["outType"].eoo());
 
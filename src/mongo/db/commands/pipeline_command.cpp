@@ -55,6 +55,7 @@
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/pipeline_d.h"
+#include "mongo/db/pipeline/pipeline_result_cache.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/find_common.h"
@@ -480,9 +481,27 @@ public:
                 pipeline = reparsePipeline(pipeline, request, expCtx);
             }
 
-            // This does mongod-specific stuff like creating the input PlanExecutor and adding
-            // it to the front of the pipeline if needed.
-            PipelineD::prepareCursorSource(collection, &request, pipeline);
+            // If this aggregation ran before on the same version of the collection, replay its
+            // results instead of running it again.
+            boost::optional<PipelineResultCache::Key> resultCacheKey;
+            if (collection) {
+                resultCacheKey = PipelineResultCache::makeKey(txn, collection, *pipeline);
+            }
+            auto& resultCache = PipelineResultCache::get(txn->getServiceContext());
+            auto cachedPipeline =
+                resultCacheKey ? resultCache.makeCachedPipeline(*resultCacheKey, expCtx) : nullptr;
+
+            if (cachedPipeline) {
+                pipeline = std::move(cachedPipeline);
+            } else {
+                // This does mongod-specific stuff like creating the input PlanExecutor and adding
+                // it to the front of the pipeline if needed.
+                PipelineD::prepareCursorSource(collection, &request, pipeline);
+
+                if (resultCacheKey) {
+                    resultCache.addResultRecorder(pipeline.get(), std::move(*resultCacheKey));
+                }
+            }
 
             // Create the PlanExecutor which returns results from the pipeline. The WorkingSet
             // ('ws') and the PipelineProxyStage ('proxy') will be owned by the created
@@ -237,11 +237,13 @@ Status PlanCacheListQueryShapes::runPlanCacheCommand(OperationContext* txn,
         arrayBuilder.doneFast();
         return Status::OK();
     }
-    return list(*planCache, bob);
+    return list(*planCache, bob, cmdObj["includeStats"].trueValue());
 }
 
 // static
-Status PlanCacheListQueryShapes::list(const PlanCache& planCache, BSONObjBuilder* bob) {
+Status PlanCacheListQueryShapes::list(const PlanCache& planCache,
+                                      BSONObjBuilder* bob,
+                                      bool includeStats) {
     invariant(bob);
 
     // Fetch all cached solutions from plan cache.
@@ -259,6 +261,14 @@ Status PlanCacheListQueryShapes::list(const PlanCache& planCache, BSONObjBuilder
         if (!entry->collation.isEmpty()) {
             shapeBuilder.append("collation", entry->collation);
         }
+        if (includeStats) {
+            BSONObjBuilder statsBuilder(shapeBuilder.subobjStart("stats"));
+            statsBuilder.append("hits", entry->numHits);
+            statsBuilder.append("replans", entry->numReplans);
+            statsBuilder.append("estimatedSizeBytes",
+                                static_cast<long long>(entry->estimatedEntrySizeBytes));
+            statsBuilder.doneFast();
+        }
         shapeBuilder.doneFast();
 
         // Release resources for cached solution after extracting query shape.
@@ -106,8 +106,11 @@ private:
 /**
  * planCacheListQueryShapes
  *
- * { planCacheListQueryShapes: <collection> }
+ * { planCacheListQueryShapes: <collection>, includeStats: <bool> }
  *
+ * If 'includeStats' is true, each shape also reports the number of times its cached plan was
+ * used ('hits'), the number of times it was replanned ('replans'), and the estimated size of its
+ * cache entry in bytes.
  */
 class PlanCacheListQueryShapes : public PlanCacheCommand {
 public:
@@ -119,9 +122,10 @@ public:
 
     /**
      * Looks up cache keys for collection's plan cache.
-     * Inserts keys for query into BSON builder.
+     * Inserts keys for query into BSON builder, along with their usage stats if 'includeStats'
+     * is true.
      */
-    static Status list(const PlanCache& planCache, BSONObjBuilder* bob);
+    static Status list(const PlanCache& planCache, BSONObjBuilder* bob, bool includeStats = false);
 };
 
 /**
@@ -60,9 +60,9 @@ static const NamespaceString nss("test.collection");
 /**
  * Utility function to get list of keys in the cache.
  */
-std::vector<BSONObj> getShapes(const PlanCache& planCache) {
+std::vector<BSONObj> getShapes(const PlanCache& planCache, bool includeStats = false) {
     BSONObjBuilder bob;
-    ASSERT_OK(PlanCacheListQueryShapes::list(planCache, &bob));
+    ASSERT_OK(PlanCacheListQueryShapes::list(planCache, &bob, includeStats));
     BSONObj resultObj = bob.obj();
     BSONElement shapesElt = resultObj.getField("shapes");
     ASSERT_EQUALS(shapesElt.type(), mongo::Array);
@@ -162,6 +162,47 @@ TEST(PlanCacheCommandsTest, planCacheListQueryShapesOneKey) {
     ASSERT_BSONOBJ_EQ(shapes[0].getObjectField("collation"), cq->getCollator()->getSpec().toBSON());
 }
 
+TEST(PlanCacheCommandsTest, planCacheListQueryShapesIncludesStats) {
+    QueryTestServiceContext serviceContext;
+    auto txn = serviceContext.makeOperationContext();
+
+    // Create a canonical query
+    auto qr = stdx::make_unique<QueryRequest>(nss);
+    qr->setFilter(fromjson("{a: 1}"));
+    auto statusWithCQ = CanonicalQuery::canonicalize(
+        txn.get(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+    ASSERT_OK(statusWithCQ.getStatus());
+    unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+    // Plan cache with one entry
+    PlanCache planCache;
+    QuerySolution qs;
+    qs.cacheData.reset(createSolutionCacheData());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+    planCache.add(*cq, solns, createDecision(1U));
+
+    // Stats are only reported on request.
+    vector<BSONObj> shapes = getShapes(planCache);
+    ASSERT_EQUALS(shapes.size(), 1U);
+    ASSERT_FALSE(shapes[0].hasField("stats"));
+
+    // Use the cached plan twice, then plan the query again.
+    for (int i = 0; i < 2; ++i) {
+        CachedSolution* rawCachedSolution;
+        ASSERT_OK(planCache.get(*cq, &rawCachedSolution));
+        delete rawCachedSolution;
+    }
+    planCache.add(*cq, solns, createDecision(1U));
+
+    shapes = getShapes(planCache, true);
+    ASSERT_EQUALS(shapes.size(), 1U);
+    BSONObj stats = shapes[0].getObjectField("stats");
+    ASSERT_EQUALS(stats["hits"].numberLong(), 2LL);
+    ASSERT_EQUALS(stats["replans"].numberLong(), 1LL);
+    ASSERT_GREATER_THAN(stats["estimatedSizeBytes"].numberLong(), 0LL);
+}
+
 /**
  * Tests for planCacheClear
  */
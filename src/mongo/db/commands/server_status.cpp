@@ -117,6 +117,10 @@ public:
 
         // --- all sections
 
+        // The per-section timings are only reported when the command is slow, so keep them aside
+        // rather than formatting a field name for every section on every call.
+        std::vector<std::pair<const std::string*, long long>> sectionTimes;
+
         for (SectionMap::const_iterator i = _sections->begin(); i != _sections->end(); ++i) {
             ServerStatusSection* section = i->second;
 
@@ -136,9 +140,8 @@ public:
             }
 
             section->appendSection(txn, elem, &result);
-            timeBuilder.appendNumber(
-                static_cast<string>(str::stream() << "after " << section->getSectionName()),
-                durationCount<Milliseconds>(clock->now() - runStart));
+            sectionTimes.emplace_back(&section->getSectionName(),
+                                      durationCount<Milliseconds>(clock->now() - runStart));
         }
 
         // --- counters
@@ -164,8 +167,13 @@ public:
         }
 
         auto runElapsed = clock->now() - runStart;
-        timeBuilder.appendNumber("at end", durationCount<Milliseconds>(runElapsed));
         if (runElapsed > Milliseconds(1000)) {
+            for (const auto& sectionTime : sectionTimes) {
+                timeBuilder.appendNumber(
+                    static_cast<string>(str::stream() << "after " << *sectionTime.first),
+                    sectionTime.second);
+            }
+            timeBuilder.appendNumber("at end", durationCount<Milliseconds>(runElapsed));
             BSONObj t = timeBuilder.obj();
             log() << "serverStatus was very slow: " << t;
             result.append("timing", t);
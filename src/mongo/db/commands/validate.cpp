@@ -37,7 +37,9 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 
@@ -60,7 +62,11 @@ public:
     virtual void help(stringstream& h) const {
         h << "Validate contents of a namespace by scanning its data structures for correctness.  "
              "Slow.\n"
-             "Add full:true option to do a more thorough check";
+             "Add full:true option to do a more thorough check.\n"
+             "Add background:true to validate on a snapshot under intent locks, without blocking "
+             "writes (document-level locking storage engines only). The snapshot is held for the "
+             "whole run, which keeps the storage engine from discarding the old versions of "
+             "documents written meanwhile, so prefer quiet periods for large collections";
     }
 
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
@@ -73,7 +79,8 @@ public:
         actions.addAction(ActionType::validate);
         out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
     }
-    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool> } */
+    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool>]
+    //  [, background: <bool>] } */
 
     bool run(OperationContext* txn,
              const string& dbname,
@@ -91,6 +98,7 @@ public:
 
         const bool full = cmdObj["full"].trueValue();
         const bool scanData = cmdObj["scandata"].trueValue();
+        const bool background = cmdObj["background"].trueValue();
 
         ValidateCmdLevel level = kValidateIndex;
 
@@ -105,12 +113,28 @@ public:
             return false;
         }
 
+        // Without document-level locking, an intent lock doesn't keep writers from changing the
+        // collection while it is being scanned.
+        StorageEngine* storageEngine = getGlobalServiceContext()->getGlobalStorageEngine();
+        if (background && !storageEngine->supportsDocLocking()) {
+            return appendCommandStatus(
+                result,
+                {ErrorCodes::CommandNotSupported,
+                 "background validation requires a document-level locking storage engine"});
+        }
+
         if (!serverGlobalParams.quiet.load()) {
-            LOG(0) << "CMD: validate " << nss.ns();
+            LOG(0) << "CMD: validate " << nss.ns() << (background ? " (background)" : "");
         }
 
-        AutoGetDb ctx(txn, nss.db(), MODE_IX);
-        Lock::CollectionLock collLk(txn->lockState(), nss.ns(), MODE_X);
+        // A background validate doesn't yield, so all of it reads from the same snapshot and the
+        // index and record store checks stay consistent with each other. Releasing the snapshot
+        // part way would let the index key counts and the record count disagree. The cost is that
+        // every version written to the database while the snapshot is open stays in the
+        // WiredTiger cache until validation ends, which adds cache pressure on a busy server. The
+        // scan checks for interrupts, so killOp ends it and releases the snapshot.
+        AutoGetDb ctx(txn, nss.db(), background ? MODE_IS : MODE_IX);
+        Lock::CollectionLock collLk(txn->lockState(), nss.ns(), background ? MODE_IS : MODE_X);
         Collection* collection = ctx.getDb() ? ctx.getDb()->getCollection(nss) : NULL;
         if (!collection) {
             if (ctx.getDb() && ctx.getDb()->getViewCatalog()->lookup(txn, nss.ns())) {
@@ -134,6 +158,12 @@ public:
                 "Some checks omitted for speed. use {full:true} option to do more thorough scan.");
         }
 
+        if (background) {
+            results.warnings.push_back(
+                "Structural checks that need exclusive access were skipped, and the collection's "
+                "size counters were not corrected, because of the background option.");
+        }
+
         result.appendBool("valid", results.valid);
         result.append("warnings", results.warnings);
         result.append("errors", results.errors);
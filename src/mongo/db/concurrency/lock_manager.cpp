@@ -402,16 +402,10 @@ void LockHead::migratePartitionedLockHeads() {
 //
 
 // Have more buckets than CPUs to reduce contention on lock and caches
-const unsigned LockManager::_numLockBuckets(128);
+const unsigned LockManager::_numLockBuckets;
+const unsigned LockManager::_numPartitions;
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
-
-LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
-}
+LockManager::LockManager() = default;
 
 LockManager::~LockManager() {
     cleanupUnusedLocks();
@@ -420,9 +414,6 @@ LockManager::~LockManager() {
         // TODO: dump more information about the non-empty bucket to see what locks were leaked
         invariant(_lockBuckets[i].data.empty());
     }
-
-    delete[] _lockBuckets;
-    delete[] _partitions;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -138,9 +138,11 @@ private:
     // The lockheads need access to the partitions
     friend struct LockHead;
 
-    // These types describe the locks hash table
+    // These types describe the locks hash table. Every operation takes the mutex of a bucket or
+    // partition at least once per lock, and different threads usually take different ones, so
+    // each of them is aligned to its own cache line to avoid false sharing between neighbours.
 
-    struct LockBucket {
+    struct MONGO_COMPILER_ALIGN_TYPE(128) LockBucket {
         SimpleMutex mutex;
         typedef unordered_map<ResourceId, LockHead*> Map;
         Map data;
@@ -150,7 +152,7 @@ private:
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
     // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    struct MONGO_COMPILER_ALIGN_TYPE(128) Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef unordered_map<ResourceId, PartitionedLockHead*> Map;
@@ -211,11 +213,15 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
-    static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    // The buckets and partitions are members rather than separately allocated arrays, so that
+    // their alignment is honoured.
+    static const unsigned _numLockBuckets = 128;
+    LockBucket _lockBuckets[_numLockBuckets];
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    // Balance scalability of intent locks against potential added cost of conflicting locks.
+    // The exact value doesn't appear very important, but should be power of two
+    static const unsigned _numPartitions = 32;
+    Partition _partitions[_numPartitions];
 };
 
 
@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/lock_state.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Locks and unlocks a collection in MODE_IX under the global lock, as every CRUD operation does.
+ * With argument 0 all threads lock the same collection, otherwise each thread its own.
+ */
+void BM_lockUnlockCollection(benchmark::State& state) {
+    const std::string ns = "test.coll" + std::to_string(state.arg() ? state.threadIndex() : 0);
+    const ResourceId resId(RESOURCE_COLLECTION, ns);
+    const ResourceId dbId(RESOURCE_DATABASE, "test"_sd);
+
+    DefaultLockerImpl locker;
+    while (state.keepRunning()) {
+        invariant(locker.lockGlobal(MODE_IX) == LOCK_OK);
+        invariant(locker.lock(dbId, MODE_IX) == LOCK_OK);
+        invariant(locker.lock(resId, MODE_IX) == LOCK_OK);
+        locker.unlock(resId);
+        locker.unlock(dbId);
+        locker.unlockGlobal();
+    }
+}
+MONGO_BENCHMARK(BM_lockUnlockCollection)
+    ->arg(0)
+    ->arg(1)
+    ->threads(1)
+    ->threads(2)
+    ->threads(4)
+    ->threads(8);
+
+/**
+ * Locks and unlocks a resource directly in the LockManager, without a Locker's bookkeeping.
+ */
+void BM_lockManagerLockUnlock(benchmark::State& state) {
+    static LockManager lockManager;
+    const ResourceId resId(RESOURCE_COLLECTION,
+                           "test.coll" + std::to_string(state.arg() ? state.threadIndex() : 0));
+
+    DefaultLockerImpl locker;
+    LockRequest request;
+    request.initNew(&locker, nullptr);
+    while (state.keepRunning()) {
+        invariant(lockManager.lock(resId, &request, MODE_IS) == LOCK_OK);
+        lockManager.unlock(&request);
+    }
+}
+MONGO_BENCHMARK(BM_lockManagerLockUnlock)->arg(0)->arg(1)->threads(1)->threads(4)->threads(8);
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/wait_event_profile.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
@@ -311,11 +312,13 @@ LockResult LockerImpl<IsForMMAPV1>::lockGlobalBegin(LockMode mode) {
     dassert(isLocked() == (_modeForTicket != MODE_NONE));
     if (_modeForTicket == MODE_NONE) {
         const bool reader = isSharedLockMode(mode);
-        auto holder = ticketHolders[mode];
+        auto holder = shouldAcquireTicket() ? ticketHolders[mode] : nullptr;
         if (holder) {
             _clientState.store(reader ? kQueuedReader : kQueuedWriter);
+            ScopedWaitEvent ticketWait(WaitEvent::kTicket);
             holder->waitForTicket();
         }
+        _holdsTicket = (holder != nullptr);
         _clientState.store(reader ? kActiveReader : kActiveWriter);
         _modeForTicket = mode;
     }
@@ -569,6 +572,15 @@ void LockerImpl<IsForMMAPV1>::getLockerInfo(LockerInfo* lockerInfo) const {
     lockerInfo->stats.append(_stats);
 }
 
+template <bool IsForMMAPV1>
+bool LockerImpl<IsForMMAPV1>::canSaveLockState() const {
+    scoped_spinlock scopedLock(_lock);
+
+    // Mirrors the checks at the start of saveLockStateAndUnlock.
+    const LockRequestsMap::ConstIterator globalRequest = _requests.find(resourceIdGlobal);
+    return !globalRequest.finished() && globalRequest->recursiveCount == 1;
+}
+
 template <bool IsForMMAPV1>
 bool LockerImpl<IsForMMAPV1>::saveLockStateAndUnlock(Locker::LockSnapshot* stateOut) {
     // We shouldn't be saving and restoring lock state from inside a WriteUnitOfWork.
@@ -782,6 +794,11 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
         }
     }
 
+    // Charge the whole wait once, rather than once per slice of at most DeadlockTimeoutMs.
+    if (auto profile = WaitEventProfile::getForCurrentThread()) {
+        profile->record(WaitEvent::kLock, curTimeMicros64() - startOfTotalWaitTime);
+    }
+
     // Cleanup the state, since this is an unused lock now
     if (result != LOCK_OK) {
         LockRequestsMap::Iterator it = _requests.find(resId);
@@ -802,8 +819,9 @@ bool LockerImpl<IsForMMAPV1>::_unlockImpl(LockRequestsMap::Iterator* it) {
     if (globalLockManager.unlock(it->objAddr())) {
         if (it->key() == resourceIdGlobal) {
             invariant(_modeForTicket != MODE_NONE);
-            auto holder = ticketHolders[_modeForTicket];
+            auto holder = _holdsTicket ? ticketHolders[_modeForTicket] : nullptr;
             _modeForTicket = MODE_NONE;
+            _holdsTicket = false;
             if (holder) {
                 holder->release();
             }
@@ -136,6 +136,8 @@ public:
 
     virtual bool saveLockStateAndUnlock(LockSnapshot* stateOut);
 
+    virtual bool canSaveLockState() const;
+
     virtual void restoreLockState(const LockSnapshot& stateToRestore);
 
     /**
@@ -222,6 +224,10 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // Whether a ticket was actually taken from the TicketHolder for _modeForTicket. This is false
+    // for modes without throttling, and for lockers which opted out of acquiring tickets.
+    bool _holdsTicket = false;
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
@@ -38,7 +38,9 @@
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -145,7 +147,9 @@ TEST(LockerImpl, saveAndRestoreGlobal) {
     ASSERT_EQUALS(0U, lockInfo.locks.size());
 
     // Lock the global lock, but just once.
+    ASSERT(!locker.canSaveLockState());
     locker.lockGlobal(MODE_IX);
+    ASSERT(locker.canSaveLockState());
 
     // We've locked the global lock.  This should be reflected in the lockInfo.
     locker.saveLockStateAndUnlock(&lockInfo);
@@ -176,6 +180,7 @@ TEST(LockerImpl, saveAndRestoreGlobalAcquiredTwice) {
     locker.lockGlobal(MODE_IX);
 
     // This shouldn't actually unlock as we're in a nested scope.
+    ASSERT(!locker.canSaveLockState());
     ASSERT(!locker.saveLockStateAndUnlock(&lockInfo));
 
     ASSERT(locker.isLocked());
@@ -386,4 +391,27 @@ TEST(LockerImpl, GetLockerInfoShouldReportPendingLocks) {
     ASSERT(conflictingLocker.unlockGlobal());
 }
 
+TEST(LockerImpl, LockerWhichSkipsTicketsIsNotThrottled) {
+    TicketHolder readTickets(1);
+    TicketHolder writeTickets(1);
+    Locker::setGlobalThrottling(&readTickets, &writeTickets);
+    ON_BLOCK_EXIT([] { Locker::setGlobalThrottling(nullptr, nullptr); });
+
+    // Use up the only write ticket.
+    DefaultLockerImpl throttledLocker;
+    ASSERT_EQ(LOCK_OK, throttledLocker.lockGlobal(MODE_IX));
+    ASSERT_EQ(0, writeTickets.available());
+
+    // A locker which opts out of tickets neither waits for nor consumes one.
+    DefaultLockerImpl internalLocker;
+    internalLocker.setShouldAcquireTicket(false);
+    ASSERT_EQ(LOCK_OK, internalLocker.lockGlobal(MODE_IX));
+    ASSERT_EQ(0, writeTickets.available());
+    ASSERT(internalLocker.unlockGlobal());
+    ASSERT_EQ(0, writeTickets.available());
+
+    ASSERT(throttledLocker.unlockGlobal());
+    ASSERT_EQ(1, writeTickets.available());
+}
+
 }  // namespace mongo
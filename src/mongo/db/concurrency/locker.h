@@ -289,6 +289,12 @@ public:
      */
     virtual bool saveLockStateAndUnlock(LockSnapshot* stateOut) = 0;
 
+    /**
+     * Returns true if a call to saveLockStateAndUnlock(...) would release locks, that is, if the
+     * global lock is held and has not been acquired recursively.
+     */
+    virtual bool canSaveLockState() const = 0;
+
     /**
      * Re-locks all locks whose state was stored in 'stateToRestore'.
      */
@@ -327,11 +333,29 @@ public:
         return _shouldConflictWithSecondaryBatchApplication;
     }
 
+    /**
+     * If set to false, global lock acquisitions by this locker skip the read/write tickets set up
+     * through setGlobalThrottling(), so that they are never queued behind throttled user
+     * operations. This is meant for internal work which the rest of the system waits on, such as
+     * oplog application, and must be set before the global lock is acquired. User operations
+     * should *never* opt out. Nor should background work which nothing waits on, such as TTL
+     * deletes and chunk migrations: it is as heavy as user writes and must stay throttled with
+     * them.
+     */
+    void setShouldAcquireTicket(bool newValue) {
+        invariant(!isLocked());
+        _shouldAcquireTicket = newValue;
+    }
+    bool shouldAcquireTicket() const {
+        return _shouldAcquireTicket;
+    }
+
 protected:
     Locker() {}
 
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
+    bool _shouldAcquireTicket = true;
 };
 
 }  // namespace mongo
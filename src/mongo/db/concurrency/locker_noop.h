@@ -132,6 +132,10 @@ public:
         invariant(false);
     }
 
+    virtual bool canSaveLockState() const {
+        invariant(false);
+    }
+
     virtual void restoreLockState(const LockSnapshot& stateToRestore) {
         invariant(false);
     }
@@ -32,6 +32,7 @@
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/stats/wait_event_profile.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stacktrace.h"
 
@@ -51,15 +52,20 @@ void WriteConflictException::logAndBackoff(int attempt, StringData operation, St
            << ", attempt: " << attempt << " retrying";
 
     // All numbers below chosen by guess and check against a few random benchmarks.
+    int backoffMillis;
     if (attempt < 4) {
         // no-op
+        return;
     } else if (attempt < 10) {
-        sleepmillis(1);
+        backoffMillis = 1;
     } else if (attempt < 100) {
-        sleepmillis(5);
+        backoffMillis = 5;
     } else {
-        sleepmillis(10);
+        backoffMillis = 10;
     }
+
+    ScopedWaitEvent backoffWait(WaitEvent::kWriteConflict);
+    sleepmillis(backoffMillis);
 }
 
 namespace {
@@ -393,6 +393,14 @@ void CurOp::reportState(BSONObjBuilder* builder) {
     }
 
     builder->append("numYields", _numYields);
+
+    if (_debug.waitEvents) {
+        BSONObjBuilder waitEvents;
+        _debug.waitEvents->append(&waitEvents);
+        if (!waitEvents.asTempObj().isEmpty()) {
+            builder->append("waitEvents", waitEvents.obj());
+        }
+    }
 }
 
 namespace {
@@ -525,6 +533,14 @@ string OpDebug::report(Client* client,
         s << " locks:" << locks.obj().toString();
     }
 
+    if (waitEvents) {
+        BSONObjBuilder events;
+        waitEvents->append(&events);
+        if (!events.asTempObj().isEmpty()) {
+            s << " waitEvents:" << events.obj().toString();
+        }
+    }
+
     if (iscommand) {
         s << " protocol:" << getProtoString(networkOp);
     }
@@ -617,6 +633,14 @@ void OpDebug::append(const CurOp& curop,
         lockStats.report(&locks);
     }
 
+    if (waitEvents) {
+        BSONObjBuilder events;
+        waitEvents->append(&events);
+        if (!events.asTempObj().isEmpty()) {
+            b.append("waitEvents", events.obj());
+        }
+    }
+
     if (!exceptionInfo.empty()) {
         exceptionInfo.append(b, "exception", "exceptionCode");
     }
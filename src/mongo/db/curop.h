@@ -31,10 +31,13 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/stats/wait_event_profile.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/net/message.h"
 #include "mongo/util/progress_meter.h"
@@ -120,6 +123,17 @@ public:
 
     BSONObj execStats;  // Owned here.
 
+    // Time spent waiting, broken out by WaitEvent. Only allocated for operations sampled by
+    // waitEventSampleRate. Unlike the rest of OpDebug, this may be read by currentOp while the
+    // operation runs, so it is only set while holding the Client lock.
+    std::unique_ptr<WaitEventProfile> waitEvents;
+
+    // The namespace and shape of the first query planned by this operation, under which its
+    // execution statistics are aggregated in the QueryStatsStore. Empty if it planned no query.
+    std::string queryShapeNs;
+    std::string queryShapeKey;
+    BSONObj queryShape;
+
     // error handling
     ExceptionInfo exceptionInfo;
 
@@ -57,6 +57,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
+#include "mongo/db/commands/index_filter_commands.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/db_raii.h"
@@ -120,6 +121,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/transport/transport_layer_legacy.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
@@ -473,10 +475,6 @@ ExitCode _initAndListen(int listenPort) {
 
     checked_cast<ServiceContextMongoD*>(getGlobalServiceContext())->createLockFile();
 
-    transport::TransportLayerLegacy::Options options;
-    options.port = listenPort;
-    options.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongod>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
@@ -484,8 +482,26 @@ ExitCode _initAndListen(int listenPort) {
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
     // Create, start, and attach the TL
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
-    auto res = transportLayer->setup();
+    std::unique_ptr<transport::TransportLayer> transportLayer;
+    Status res = Status::OK();
+    if (transport::isTransportLayerASIOEnabled()) {
+        transport::TransportLayerASIO::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+
+        auto asioTransportLayer = stdx::make_unique<transport::TransportLayerASIO>(options, sepPtr);
+        res = asioTransportLayer->setup();
+        transportLayer = std::move(asioTransportLayer);
+    } else {
+        transport::TransportLayerLegacy::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+
+        auto legacyTransportLayer =
+            stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
+        res = legacyTransportLayer->setup();
+        transportLayer = std::move(legacyTransportLayer);
+    }
     if (!res.isOK()) {
         error() << "Failed to set up listener: " << res;
         return EXIT_NET_ERROR;
@@ -664,6 +680,8 @@ ExitCode _initAndListen(int listenPort) {
 
         restartInProgressIndexesFromLastShutdown(startupOpCtx.get());
 
+        restoreIndexFilters(startupOpCtx.get());
+
         if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
             // Note: For replica sets, ShardingStateRecovery happens on transition to primary.
             if (!repl::getGlobalReplicationCoordinator()->isReplEnabled()) {
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/deadline_scheduler.h"
+
+#include "mongo/db/service_context.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getDeadlineScheduler = ServiceContext::declareDecoration<DeadlineScheduler>();
+
+}  // namespace
+
+constexpr DeadlineScheduler::TimerId DeadlineScheduler::kNoTimer;
+const Milliseconds DeadlineScheduler::kResolution{1};
+
+DeadlineScheduler::DeadlineScheduler() : _wheel(Date_t::now(), kResolution) {}
+
+DeadlineScheduler::~DeadlineScheduler() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _inShutdown = true;
+        _wakeup.notify_one();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+DeadlineScheduler* DeadlineScheduler::get(ServiceContext* serviceContext) {
+    return &getDeadlineScheduler(serviceContext);
+}
+
+DeadlineScheduler::TimerId DeadlineScheduler::arm(Date_t deadline, Callback callback) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_thread.joinable()) {
+        _thread = stdx::thread(&DeadlineScheduler::_run, this);
+    }
+
+    const auto id = _wheel.arm(deadline, std::move(callback));
+    if (deadline < _nextWakeup) {
+        _nextWakeup = deadline;
+        _wakeup.notify_one();
+    }
+    return id;
+}
+
+bool DeadlineScheduler::disarm(TimerId id) {
+    // '_running' is kNoTimer whenever no callback runs, so there is nothing to wait for.
+    if (id == kNoTimer) {
+        return false;
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (_wheel.disarm(id) || _expired.erase(id)) {
+        return true;
+    }
+
+    if (stdx::this_thread::get_id() != _thread.get_id()) {
+        _callbackDone.wait(lk, [&] { return _running != id; });
+    }
+    return false;
+}
+
+void DeadlineScheduler::_run() {
+    setThreadName("DeadlineScheduler");
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (!_inShutdown) {
+        auto expired = _wheel.advance(Date_t::now());
+        for (auto&& timer : expired) {
+            _expired.insert(timer.first);
+        }
+
+        for (auto&& timer : expired) {
+            // Skip the timers disarmed while an earlier callback ran.
+            if (!_expired.erase(timer.first)) {
+                continue;
+            }
+
+            _running = timer.first;
+            lk.unlock();
+            timer.second();
+            lk.lock();
+            _running = kNoTimer;
+            _callbackDone.notify_all();
+        }
+
+        auto next = _wheel.nextWakeup();
+        _nextWakeup = next ? *next : Date_t::max();
+        if (_nextWakeup == Date_t::max()) {
+            _wakeup.wait(lk);
+        } else if (_nextWakeup > Date_t::now()) {
+            _wakeup.wait_until(lk, _nextWakeup.toSystemTimePoint());
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer_wheel.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Runs callbacks at deadlines on a single thread shared by the whole process, so that the number
+ * of threads and wakeups does not grow with the number of deadlines being watched. Timers are kept
+ * in a TimerWheel, so arming and disarming one takes constant time.
+ *
+ * Callbacks run one at a time on the scheduler's thread, must be short, and must not block on
+ * anything which may itself be waiting to disarm a timer.
+ *
+ * The thread is started when the first timer is armed.
+ *
+ * Thread-safe.
+ */
+class DeadlineScheduler {
+    MONGO_DISALLOW_COPYING(DeadlineScheduler);
+
+public:
+    using TimerId = TimerWheel::TimerId;
+    using Callback = TimerWheel::Callback;
+
+    static constexpr TimerId kNoTimer = TimerWheel::kNoTimer;
+
+    // The granularity at which deadlines are met.
+    static const Milliseconds kResolution;
+
+    DeadlineScheduler();
+    ~DeadlineScheduler();
+
+    static DeadlineScheduler* get(ServiceContext* serviceContext);
+
+    /**
+     * Arms a timer which runs 'callback' at 'deadline', or as soon as possible if it has already
+     * passed.
+     */
+    TimerId arm(Date_t deadline, Callback callback);
+
+    /**
+     * Disarms a timer. Returns true if its callback will not run. Otherwise the callback has
+     * already finished running, because if it is running, waits for it to finish, unless called
+     * from the callback itself. Disarming kNoTimer does nothing and returns false.
+     */
+    bool disarm(TimerId id);
+
+private:
+    void _run();
+
+    stdx::mutex _mutex;
+
+    // Signaled when a timer is armed which expires before the thread would otherwise wake up,
+    // and on shutdown.
+    stdx::condition_variable _wakeup;
+
+    // Signaled when a callback has finished running.
+    stdx::condition_variable _callbackDone;
+
+    TimerWheel _wheel;
+
+    // The timers which have expired and whose callbacks have not run yet.
+    stdx::unordered_set<TimerId> _expired;
+
+    // The timer whose callback is running, or kNoTimer.
+    TimerId _running = kNoTimer;
+
+    // When the thread will next wake up to process the wheel.
+    Date_t _nextWakeup = Date_t::max();
+
+    bool _inShutdown = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -58,6 +59,7 @@ AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws, const Collec
     : PlanStage(kStageType, opCtx),
       _collection(collection),
       _ws(ws),
+      _useBloomFilter(internalQueryAndHashUseBloomFilter.load()),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
@@ -70,6 +72,7 @@ AndHashStage::AndHashStage(OperationContext* opCtx,
     : PlanStage(kStageType, opCtx),
       _collection(collection),
       _ws(ws),
+      _useBloomFilter(internalQueryAndHashUseBloomFilter.load()),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
@@ -224,7 +227,8 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
         return PlanStage::NEED_TIME;
     }
 
-    DataMap::iterator it = _dataMap.find(member->recordId);
+    DataMap::iterator it =
+        mayBeHashed(member->recordId) ? _dataMap.find(member->recordId) : _dataMap.end();
     if (_dataMap.end() == it) {
         // Child's output wasn't in every previous child.  Throw it out.
         _ws->free(*out);
@@ -232,7 +236,7 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
     } else {
         // Child's output was in every previous child.  Merge any key data in
         // the child's output and free the child's just-outputted WSM.
-        WorkingSetID hashID = it->second;
+        WorkingSetID hashID = it->second.id;
         _dataMap.erase(it);
 
         AndCommon::mergeFrom(_ws, hashID, *member);
@@ -269,7 +273,7 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
 
-        if (!_dataMap.insert(std::make_pair(member->recordId, id)).second) {
+        if (!_dataMap.insert(std::make_pair(member->recordId, HashedMember{id, false})).second) {
             // Didn't insert because we already had this RecordId inside the map. This should only
             // happen if we're seeing a newer copy of the same doc in a more recent snapshot.
             // Throw out the newer copy of the doc.
@@ -295,6 +299,7 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         }
 
         _specificStats.mapAfterChild.push_back(_dataMap.size());
+        rebuildBloomFilter();
 
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childStatus || PlanStage::DEAD == childStatus) {
@@ -335,12 +340,14 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         }
 
         verify(member->hasRecordId());
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        DataMap::iterator it =
+            mayBeHashed(member->recordId) ? _dataMap.find(member->recordId) : _dataMap.end();
+        if (_dataMap.end() == it) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
-            _seenMap.insert(member->recordId);
-            WorkingSetID olderMemberID = _dataMap[member->recordId];
+            it->second.seen = true;
+            WorkingSetID olderMemberID = it->second.id;
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
 
@@ -355,27 +362,27 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // Finished with a child.
         ++_currentChild;
 
-        // Keep elements of _dataMap that are in _seenMap.
+        // Keep elements of _dataMap that this child has seen.
         DataMap::iterator it = _dataMap.begin();
         while (it != _dataMap.end()) {
-            if (_seenMap.end() == _seenMap.find(it->first)) {
+            if (!it->second.seen) {
                 DataMap::iterator toErase = it;
                 ++it;
 
                 // Update memory stats.
-                WorkingSetMember* member = _ws->get(toErase->second);
+                WorkingSetMember* member = _ws->get(toErase->second.id);
                 _memUsage -= member->getMemUsage();
 
-                _ws->free(toErase->second);
+                _ws->free(toErase->second.id);
                 _dataMap.erase(toErase);
             } else {
+                it->second.seen = false;
                 ++it;
             }
         }
 
         _specificStats.mapAfterChild.push_back(_dataMap.size());
-
-        _seenMap.clear();
+        rebuildBloomFilter();
 
         // _dataMap is now the intersection of the first _currentChild nodes.
 
@@ -412,6 +419,26 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
     }
 }
 
+bool AndHashStage::mayBeHashed(const RecordId& rid) {
+    if (!_useBloomFilter || _bloomFilter.mayContain(rid)) {
+        return true;
+    }
+    ++_specificStats.bloomFilterRejects;
+    return false;
+}
+
+void AndHashStage::rebuildBloomFilter() {
+    if (!_useBloomFilter) {
+        return;
+    }
+
+    _bloomFilter.reset(_dataMap.size());
+    for (auto&& hashed : _dataMap) {
+        _bloomFilter.add(hashed.first);
+    }
+    _specificStats.bloomFilterBytes = _bloomFilter.getMemUsage();
+}
+
 void AndHashStage::doInvalidate(OperationContext* txn, const RecordId& dl, InvalidationType type) {
     // TODO remove this since calling isEOF is illegal inside of doInvalidate().
     if (isEOF()) {
@@ -439,7 +466,7 @@ void AndHashStage::doInvalidate(OperationContext* txn, const RecordId& dl, Inval
     // So, we flag and try to pick it up later.
     DataMap::iterator it = _dataMap.find(dl);
     if (_dataMap.end() != it) {
-        WorkingSetID id = it->second;
+        WorkingSetID id = it->second.id;
         WorkingSetMember* member = _ws->get(id);
         verify(member->recordId == dl);
 
@@ -31,11 +31,11 @@
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bloom_filter.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 #include "mongo/platform/unordered_map.h"
-#include "mongo/platform/unordered_set.h"
 
 namespace mongo {
 
@@ -92,6 +92,16 @@ private:
     StageState hashOtherChildren(WorkingSetID* out);
     StageState workChild(size_t childNo, WorkingSetID* out);
 
+    /**
+     * Returns false if 'rid' is certainly not in _dataMap, counting the rejection in our stats.
+     */
+    bool mayBeHashed(const RecordId& rid);
+
+    /**
+     * Refills _bloomFilter from the RecordIds currently in _dataMap.
+     */
+    void rebuildBloomFilter();
+
     // Not owned by us.
     const Collection* _collection;
 
@@ -103,15 +113,23 @@ private:
     // we place that result here.
     std::vector<WorkingSetID> _lookAheadResults;
 
+    // What we hold for each RecordId in _dataMap. 'seen' records whether the child currently
+    // being hashed has produced this RecordId, and is only used while _hashingChildren.
+    struct HashedMember {
+        WorkingSetID id;
+        bool seen;
+    };
+
     // _dataMap is filled out by the first child and probed by subsequent children.  This is the
     // hash table that we create by intersecting _children and probe with the last child.
-    typedef unordered_map<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
+    typedef unordered_map<RecordId, HashedMember, RecordId::Hasher> DataMap;
     DataMap _dataMap;
 
-    // Keeps track of what elements from _dataMap subsequent children have seen.
-    // Only used while _hashingChildren.
-    typedef unordered_set<RecordId, RecordId::Hasher> SeenMap;
-    SeenMap _seenMap;
+    // Summarizes the RecordIds in _dataMap, so that most RecordIds which aren't in it are
+    // rejected without probing it. Rebuilt whenever _dataMap shrinks to the intersection of
+    // another child; RecordIds erased in between remain in the filter, which is harmless.
+    const bool _useBloomFilter;
+    RecordIdBloomFilter _bloomFilter;
 
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
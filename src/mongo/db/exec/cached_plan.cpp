@@ -50,6 +50,14 @@
 
 namespace mongo {
 
+namespace {
+
+// With adaptive replanning, the trial period is never cut short before the cached plan has done
+// this many times the work which originally won it the race.
+const size_t kMinDecisionWorksBeforeEarlyReplan = 2;
+
+}  // namespace
+
 // static
 const char* CachedPlanStage::kStageType = "CACHED_PLAN";
 
@@ -84,6 +92,8 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // The trial period ends without replanning if the cached plan produces this many results.
     size_t numResults = MultiPlanStage::getTrialPeriodNumToReturn(*_canonicalQuery);
 
+    const bool adaptive = internalQueryCacheAdaptiveReplanning.load();
+
     for (size_t i = 0; i < maxWorksBeforeReplan; ++i) {
         // Might need to yield between calls to work due to the timer elapsing.
         Status yieldStatus = tryYield(yieldPolicy);
@@ -105,6 +115,12 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
                 // Once a plan returns enough results, stop working. Update cache with stats
                 // from this run and return.
                 updatePlanCache();
+                if (adaptive) {
+                    _monitorAfterTrial = true;
+                    _maxWorksBeforeReplan = maxWorksBeforeReplan;
+                    _trialWorks = i + 1;
+                    _trialResults = _results.size();
+                }
                 return Status::OK();
             }
         } else if (PlanStage::IS_EOF == state) {
@@ -158,6 +174,18 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         } else {
             invariant(PlanStage::NEED_TIME == state);
         }
+
+        if (adaptive &&
+            shouldReplanEarly(i + 1, _results.size(), numResults, maxWorksBeforeReplan)) {
+            LOG(1) << "Execution of cached plan produced " << _results.size() << " results in "
+                   << (i + 1) << " works, which projects past the budget of "
+                   << maxWorksBeforeReplan << " works. Evicting cache entry and replanning query: "
+                   << redact(_canonicalQuery->toStringShort()) << " plan summary before replan: "
+                   << redact(Explain::getPlanSummary(child().get()));
+
+            const bool shouldCache = true;
+            return replan(yieldPolicy, shouldCache);
+        }
     }
 
     // If we're here, the trial period took more than 'maxWorksBeforeReplan' work cycles. This
@@ -296,7 +324,60 @@ PlanStage::StageState CachedPlanStage::doWork(WorkingSetID* out) {
     }
 
     // Nothing left in trial period buffer.
-    return child()->work(out);
+    StageState state = child()->work(out);
+    if (_monitorAfterTrial) {
+        monitorAfterTrial(state);
+    }
+    return state;
+}
+
+bool CachedPlanStage::shouldReplanEarly(size_t numWorks,
+                                        size_t numResults,
+                                        size_t numResultsWanted,
+                                        size_t maxWorksBeforeReplan) const {
+    if (numWorks < kMinDecisionWorksBeforeEarlyReplan * _decisionWorks) {
+        return false;
+    }
+
+    // Project the works needed for the remaining results from the works per result so far. The
+    // extra result in the denominator keeps a plan which has produced nothing yet from projecting
+    // to infinity.
+    const double worksPerResult = static_cast<double>(numWorks) / (numResults + 1);
+    const double projectedWorks = numWorks + worksPerResult * (numResultsWanted - numResults);
+    return projectedWorks > maxWorksBeforeReplan;
+}
+
+void CachedPlanStage::monitorAfterTrial(StageState state) {
+    ++_worksAfterTrial;
+    if (PlanStage::ADVANCED == state) {
+        ++_resultsAfterTrial;
+    } else if (PlanStage::IS_EOF == state) {
+        _monitorAfterTrial = false;
+        return;
+    }
+
+    // Give the plan as long as its trial period budget before judging it.
+    if (_worksAfterTrial < _maxWorksBeforeReplan) {
+        return;
+    }
+
+    const double trialWorksPerResult = static_cast<double>(_trialWorks) / (_trialResults + 1);
+    const double worksPerResult = static_cast<double>(_worksAfterTrial) / (_resultsAfterTrial + 1);
+    if (worksPerResult <= internalQueryCacheEvictionRatio * trialWorksPerResult) {
+        return;
+    }
+
+    // We have already returned results, so we cannot switch plans. Evict the entry so that the
+    // next query of this shape picks a new plan rather than repeating this one.
+    LOG(1) << "Cached plan needed " << worksPerResult << " works per result after its trial "
+           << "period, compared to " << trialWorksPerResult << " during it. Evicting cache entry "
+           << "for query: " << redact(_canonicalQuery->toStringShort())
+           << " plan summary: " << redact(Explain::getPlanSummary(child().get()));
+
+    PlanCache* cache = _collection->infoCache()->getPlanCache();
+    cache->remove(*_canonicalQuery);
+    _specificStats.evictedAfterTrial = true;
+    _monitorAfterTrial = false;
 }
 
 void CachedPlanStage::doInvalidate(OperationContext* txn,
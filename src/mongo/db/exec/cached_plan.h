@@ -115,6 +115,23 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Returns true if the cached plan, having produced 'numResults' results in 'numWorks' work
+     * cycles of its trial period, is not expected to produce 'numResultsWanted' results within
+     * 'maxWorksBeforeReplan' work cycles.
+     */
+    bool shouldReplanEarly(size_t numWorks,
+                           size_t numResults,
+                           size_t numResultsWanted,
+                           size_t maxWorksBeforeReplan) const;
+
+    /**
+     * Called for each work cycle of the cached plan after a successful trial period. Evicts the
+     * plan cache entry if the plan's works per result have degraded well beyond what they were
+     * during the trial period, so that the next query of this shape is replanned.
+     */
+    void monitorAfterTrial(StageState state);
+
     // Not owned. Must be non-null.
     Collection* _collection;
 
@@ -143,6 +160,15 @@ private:
     // just pass a NULL fetcher.
     std::unique_ptr<RecordFetcher> _fetcher;
 
+    // Set when the trial period succeeds without replanning and adaptive replanning is enabled.
+    // The cached plan's progress is then monitored by monitorAfterTrial().
+    bool _monitorAfterTrial = false;
+    size_t _maxWorksBeforeReplan = 0;
+    size_t _trialWorks = 0;
+    size_t _trialResults = 0;
+    size_t _worksAfterTrial = 0;
+    size_t _resultsAfterTrial = 0;
+
     // Stats
     CachedPlanStats _specificStats;
 };
@@ -34,10 +34,10 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/collection_scan_common.h"
-#include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
@@ -88,10 +88,8 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    boost::optional<Record> record;
-    const bool needToMakeCursor = !_cursor;
-    try {
-        if (needToMakeCursor) {
+    if (!_cursor) {
+        try {
             const bool forward = _params.direction == CollectionScanParams::FORWARD;
 
             if (forward && !_params.tailable && _params.collection->ns().isOplog()) {
@@ -128,71 +126,87 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                     return PlanStage::DEAD;
                 }
             }
-
-            return PlanStage::NEED_TIME;
+        } catch (const WriteConflictException& wce) {
+            // Leave us in a state to try again next time.
+            _cursor.reset();
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
         }
 
-        if (_lastSeenId.isNull() && !_params.start.isNull()) {
-            record = _cursor->seekExact(_params.start);
-        } else {
-            // See if the record we're about to access is in memory. If not, pass a fetch
-            // request up.
-            if (auto fetcher = _cursor->fetcherForNext()) {
-                // Pass the RecordFetcher up.
-                WorkingSetMember* member = _workingSet->get(_wsidForFetch);
-                member->setFetcher(fetcher.release());
-                *out = _wsidForFetch;
-                return PlanStage::NEED_YIELD;
-            }
-
-            record = _cursor->next();
-        }
-    } catch (const WriteConflictException& wce) {
-        // Leave us in a state to try again next time.
-        if (needToMakeCursor)
-            _cursor.reset();
-        *out = WorkingSet::INVALID_ID;
-        return PlanStage::NEED_YIELD;
+        return PlanStage::NEED_TIME;
     }
 
-    if (!record) {
-        // We just hit EOF. If we are tailable and have already returned data, leave us in a
-        // state to pick up where we left off on the next call to work(). Otherwise EOF is
-        // permanent.
-        if (_params.tailable && !_lastSeenId.isNull()) {
-            _cursor.reset();
-        } else {
-            _commonStats.isEOF = true;
+    // Records which do not pass the filter are skipped without leaving this function, up to
+    // internalQueryExecCollectionScanBatchSize records per call, so that they do not each pay
+    // for a WorkingSetMember and a trip up and down the plan tree. Every record still counts as
+    // one work cycle in the stats. Multi-planning and yielding count calls to work() instead, so
+    // a batch size above 1 lets the scan examine more records per trial and between yields.
+    const int batchSize = std::max(1, internalQueryExecCollectionScanBatchSize.load());
+    for (int numExamined = 1;; ++numExamined) {
+        boost::optional<Record> record;
+        try {
+            if (_lastSeenId.isNull() && !_params.start.isNull()) {
+                record = _cursor->seekExact(_params.start);
+            } else {
+                // See if the record we're about to access is in memory. If not, pass a fetch
+                // request up.
+                if (auto fetcher = _cursor->fetcherForNext()) {
+                    // Pass the RecordFetcher up.
+                    WorkingSetMember* member = _workingSet->get(_wsidForFetch);
+                    member->setFetcher(fetcher.release());
+                    *out = _wsidForFetch;
+                    return PlanStage::NEED_YIELD;
+                }
+
+                record = _cursor->next();
+            }
+        } catch (const WriteConflictException& wce) {
+            // Leave us in a state to try again next time.
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
         }
 
-        return PlanStage::IS_EOF;
-    }
+        if (!record) {
+            // We just hit EOF. If we are tailable and have already returned data, leave us in a
+            // state to pick up where we left off on the next call to work(). Otherwise EOF is
+            // permanent.
+            if (_params.tailable && !_lastSeenId.isNull()) {
+                _cursor.reset();
+            } else {
+                _commonStats.isEOF = true;
+            }
 
-    _lastSeenId = record->id;
+            return PlanStage::IS_EOF;
+        }
 
-    WorkingSetID id = _workingSet->allocate();
-    WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
-    _workingSet->transitionToRecordIdAndObj(id);
+        _lastSeenId = record->id;
+        ++_specificStats.docsTested;
 
-    return returnIfMatches(member, id, out);
-}
+        BSONObj obj = record->data.releaseToBson();
+        if (!_filter || _filter->matchesBSON(obj)) {
+            if (_params.stopApplyingFilterAfterFirstMatch) {
+                _filter = nullptr;
+            }
 
-PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
-                                                      WorkingSetID memberID,
-                                                      WorkingSetID* out) {
-    ++_specificStats.docsTested;
+            WorkingSetID id = _workingSet->allocate();
+            WorkingSetMember* member = _workingSet->get(id);
+            member->recordId = record->id;
+            member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), std::move(obj)};
+            _workingSet->transitionToRecordIdAndObj(id);
 
-    if (Filter::passes(member, _filter)) {
-        if (_params.stopApplyingFilterAfterFirstMatch) {
-            _filter = nullptr;
+            *out = id;
+            return PlanStage::ADVANCED;
         }
-        *out = memberID;
-        return PlanStage::ADVANCED;
-    } else {
-        _workingSet->free(memberID);
-        return PlanStage::NEED_TIME;
+
+        const bool reachedMaxScan =
+            (0 != _params.maxScan) && (_specificStats.docsTested >= _params.maxScan);
+        if (numExamined >= batchSize || reachedMaxScan) {
+            return PlanStage::NEED_TIME;
+        }
+
+        // Account for the skipped record as if it had been its own call to work().
+        ++_commonStats.works;
+        ++_commonStats.needTime;
     }
 }
 
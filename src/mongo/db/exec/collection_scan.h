@@ -74,12 +74,6 @@ public:
     static const char* kStageType;
 
 private:
-    /**
-     * If the member (with id memberID) passes our filter, set *out to memberID and return that
-     * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
-     */
-    StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
-
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -102,17 +102,18 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     boost::optional<IndexKeyEntry> entry;
     const bool needInit = !_cursor;
     try {
-        // We don't care about the keys.
-        const auto kWantLoc = SortedDataInterface::Cursor::kWantLoc;
+        // We don't care about the keys, and only need the RecordIds in order to dedup.
+        const auto parts = _shouldDedup ? SortedDataInterface::Cursor::kWantLoc
+                                        : SortedDataInterface::Cursor::kJustExistance;
 
         if (needInit) {
             // First call to work().  Perform cursor init.
             _cursor = _iam->newCursor(getOpCtx());
             _cursor->setEndPosition(_params.endKey, _params.endKeyInclusive);
 
-            entry = _cursor->seek(_params.startKey, _params.startKeyInclusive, kWantLoc);
+            entry = _cursor->seek(_params.startKey, _params.startKeyInclusive, parts);
         } else {
-            entry = _cursor->next(kWantLoc);
+            entry = _cursor->next(parts);
         }
     } catch (const WriteConflictException& wce) {
         if (needInit) {
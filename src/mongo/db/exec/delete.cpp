@@ -212,6 +212,11 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     }
 
     // Do the write, unless this is an explain.
+    //
+    // Each document is deleted and logged on its own, even when the child stage returns a
+    // contiguous range of them. RecordIds are local to each node, so a truncated range of the
+    // record store could not be replicated as a single oplog entry, and secondaries need the
+    // per-document entries to keep their own indexes and records in step.
     if (!_params.isExplain) {
         try {
             WriteUnitOfWork wunit(getOpCtx());
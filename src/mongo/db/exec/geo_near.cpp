@@ -49,6 +49,7 @@
 #include "mongo/util/log.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace mongo {
 
@@ -94,6 +95,59 @@ struct StoredGeometry {
 };
 }
 
+namespace {
+/**
+ * Returns the area of the annulus between distances 'inner' and 'outer'. For SPHERE, distances
+ * are meters along the surface of the earth and the annulus is the difference of two spherical
+ * caps.
+ */
+double annulusArea(double inner, double outer, CRS queryCRS) {
+    if (FLAT == queryCRS) {
+        return M_PI * (outer * outer - inner * inner);
+    }
+    const double R = kRadiusOfEarthInMeters;
+    return 2 * M_PI * R * R * (std::cos(inner / R) - std::cos(outer / R));
+}
+
+/**
+ * Returns the distance beyond 'outer' at which the annulus starting at 'outer' has area
+ * 'targetArea'. For SPHERE, the result is at most the distance to the antipode.
+ */
+double incrementForArea(double outer, double targetArea, CRS queryCRS) {
+    if (FLAT == queryCRS) {
+        return std::sqrt(outer * outer + targetArea / M_PI) - outer;
+    }
+    const double R = kRadiusOfEarthInMeters;
+    const double cosNewOuter = std::cos(outer / R) - targetArea / (2 * M_PI * R * R);
+    return R * std::acos(std::max(-1.0, cosNewOuter)) - outer;
+}
+}  // namespace
+
+double nextGeoNearBoundsIncrement(const IntervalStats& lastIntervalStats,
+                                  double boundsIncrement,
+                                  CRS queryCRS) {
+    const double kTargetIntervalResults = 300;
+    const double kMaxIncrementGrowth = 8;
+
+    const double numResults = lastIntervalStats.numResultsReturned;
+    const double inner = std::max(0.0, lastIntervalStats.minDistanceAllowed);
+    const double outer = lastIntervalStats.maxDistanceAllowed;
+    const double area = annulusArea(inner, outer, queryCRS);
+
+    if (numResults <= 0 || !(area > 0))
+        return boundsIncrement * 2;
+
+    // Size the next annulus to have an area of kTargetIntervalResults / density.
+    const double targetArea = kTargetIntervalResults * area / numResults;
+    const double increment = incrementForArea(outer, targetArea, queryCRS);
+
+    if (!std::isfinite(increment) || increment <= 0)
+        return boundsIncrement;
+
+    return std::max(boundsIncrement / kMaxIncrementGrowth,
+                    std::min(boundsIncrement * kMaxIncrementGrowth, increment));
+}
+
 /**
  * Find and parse all geometry elements on the appropriate field path from the document.
  */
@@ -605,12 +659,8 @@ StatusWith<NearStage::CoveredInterval*>  //
 
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextGeoNearBoundsIncrement(
+            lastIntervalStats, _boundsIncrement, _nearParams.nearQuery->centroid->crs);
     }
 
     _boundsIncrement =
@@ -1037,12 +1087,8 @@ StatusWith<NearStage::CoveredInterval*>  //
 
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        // Internal bounds come in SPHERE CRS units.
+        _boundsIncrement = nextGeoNearBoundsIncrement(lastIntervalStats, _boundsIncrement, SPHERE);
     }
 
     invariant(_boundsIncrement > 0.0);
@@ -60,6 +60,23 @@ struct GeoNearParams {
     bool addDistMeta;
 };
 
+/**
+ * Returns the width of the next annulus for a GeoNear search to cover, given the stats of the
+ * last, fully returned interval and its width.
+ *
+ * The result density of the last annulus is used to size the next one so that it holds about 300
+ * documents, assuming the density stays the same further out. The width changes by at most a
+ * factor of 8 per interval, so a single sparse or dense annulus cannot throw the search too far
+ * off. An empty annulus just doubles the width.
+ *
+ * Distances are in the plane for FLAT, and meters along the surface of the earth for SPHERE.
+ *
+ * Exposed for unit testing.
+ */
+double nextGeoNearBoundsIncrement(const IntervalStats& lastIntervalStats,
+                                  double boundsIncrement,
+                                  CRS queryCRS);
+
 /**
  * Implementation of GeoNear on top of a 2D index
  */
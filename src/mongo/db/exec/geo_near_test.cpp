@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+//
+// This file contains tests for the annulus sizing of mongo/db/exec/geo_near.cpp
+//
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/geo_near.h"
+
+#include <cmath>
+
+#include "mongo/db/geo/geoconstants.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+IntervalStats makeIntervalStats(double inner, double outer, long long numResultsReturned) {
+    IntervalStats stats;
+    stats.minDistanceAllowed = inner;
+    stats.maxDistanceAllowed = outer;
+    stats.numResultsReturned = numResultsReturned;
+    return stats;
+}
+
+TEST(GeoNearBoundsIncrementTest, FlatSizesNextAnnulusFromDensity) {
+    // 300 results in a disc of radius 10: the next annulus should have the same area.
+    const double increment = nextGeoNearBoundsIncrement(makeIntervalStats(0, 10, 300), 10, FLAT);
+    ASSERT_APPROX_EQUAL(increment, std::sqrt(200.0) - 10, 1e-9);
+}
+
+TEST(GeoNearBoundsIncrementTest, EmptyAnnulusDoublesIncrement) {
+    ASSERT_EQUALS(nextGeoNearBoundsIncrement(makeIntervalStats(0, 10, 0), 10, FLAT), 20);
+    ASSERT_EQUALS(nextGeoNearBoundsIncrement(makeIntervalStats(0, 1000, 0), 1000, SPHERE), 2000);
+}
+
+TEST(GeoNearBoundsIncrementTest, IncrementChangesByAtMostEightTimes) {
+    ASSERT_EQUALS(nextGeoNearBoundsIncrement(makeIntervalStats(0, 10, 1), 10, FLAT), 80);
+    ASSERT_EQUALS(nextGeoNearBoundsIncrement(makeIntervalStats(0, 10, 1000000), 10, FLAT), 1.25);
+}
+
+TEST(GeoNearBoundsIncrementTest, SphereMatchesFlatOverShortDistances) {
+    const double flat = nextGeoNearBoundsIncrement(makeIntervalStats(0, 1000, 300), 1000, FLAT);
+    const double sphere = nextGeoNearBoundsIncrement(makeIntervalStats(0, 1000, 300), 1000, SPHERE);
+    ASSERT_APPROX_EQUAL(sphere, flat, 0.01);
+}
+
+TEST(GeoNearBoundsIncrementTest, SphereUsesSphericalArea) {
+    // 300 results in a hemisphere: the other hemisphere has the same area, and ends at the
+    // antipode. A flat area would give a next annulus of only (sqrt(2) - 1) * quarter.
+    const double quarter = M_PI / 2 * kRadiusOfEarthInMeters;
+    const double increment =
+        nextGeoNearBoundsIncrement(makeIntervalStats(0, quarter, 300), quarter, SPHERE);
+    ASSERT_APPROX_EQUAL(increment, quarter, 1.0);
+}
+
+TEST(GeoNearBoundsIncrementTest, SphereDoesNotSizePastAntipode) {
+    // Few results in a large cap would call for more area than the rest of the earth has.
+    const double quarter = M_PI / 2 * kRadiusOfEarthInMeters;
+    const double increment =
+        nextGeoNearBoundsIncrement(makeIntervalStats(0, quarter, 1), quarter / 4, SPHERE);
+    ASSERT_APPROX_EQUAL(increment, quarter, 1.0);
+}
+
+}  // namespace
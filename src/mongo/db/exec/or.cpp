@@ -31,6 +31,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -44,14 +45,27 @@ using stdx::make_unique;
 const char* OrStage::kStageType = "OR";
 
 OrStage::OrStage(OperationContext* opCtx, WorkingSet* ws, bool dedup, const MatchExpression* filter)
-    : PlanStage(kStageType, opCtx), _ws(ws), _filter(filter), _currentChild(0), _dedup(dedup) {}
+    : PlanStage(kStageType, opCtx),
+      _ws(ws),
+      _filter(filter),
+      _currentChild(0),
+      _interleaveChildren(internalQueryOrStageInterleaveChildren.load()),
+      _numEOFChildren(0),
+      _dedup(dedup) {}
 
 void OrStage::addChild(PlanStage* child) {
     _children.emplace_back(child);
+    _childIsEOF.push_back(false);
 }
 
 bool OrStage::isEOF() {
-    return _currentChild >= _children.size();
+    return _numEOFChildren >= _children.size();
+}
+
+void OrStage::advanceToNextChild() {
+    do {
+        _currentChild = (_currentChild + 1) % _children.size();
+    } while (_childIsEOF[_currentChild]);
 }
 
 PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
@@ -60,8 +74,15 @@ PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
     }
 
     WorkingSetID id = WorkingSet::INVALID_ID;
+    const size_t workedChild = _currentChild;
     StageState childStatus = _children[_currentChild]->work(&id);
 
+    // A child which asked to yield is worked again once we are back, so stay on it.
+    if (_interleaveChildren && PlanStage::IS_EOF != childStatus &&
+        PlanStage::NEED_YIELD != childStatus) {
+        advanceToNextChild();
+    }
+
     if (PlanStage::ADVANCED == childStatus) {
         WorkingSetMember* member = _ws->get(id);
 
@@ -91,15 +112,21 @@ PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
     } else if (PlanStage::IS_EOF == childStatus) {
-        // Done with _currentChild, move to the next one.
-        ++_currentChild;
+        // Done with this child, move to the next one.
+        _childIsEOF[workedChild] = true;
+        ++_numEOFChildren;
 
         // Maybe we're out of children.
         if (isEOF()) {
             return PlanStage::IS_EOF;
+        }
+
+        if (_interleaveChildren) {
+            advanceToNextChild();
         } else {
-            return PlanStage::NEED_TIME;
+            ++_currentChild;
         }
+        return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childStatus || PlanStage::DEAD == childStatus) {
         *out = id;
         // If a stage fails, it may create a status WSM to indicate why it
@@ -107,7 +134,7 @@ PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
         // create our own error message.
         if (WorkingSet::INVALID_ID == id) {
             mongoutils::str::stream ss;
-            ss << "OR stage failed to read in results from child " << _currentChild;
+            ss << "OR stage failed to read in results from child " << workedChild;
             Status status(ErrorCodes::InternalError, ss);
             *out = WorkingSetCommon::allocateStatusMember(_ws, status);
         }
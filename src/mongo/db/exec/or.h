@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -42,6 +44,9 @@ namespace mongo {
  * Preconditions: Valid RecordId.
  *
  * If we're deduping, we may fail to dedup any invalidated RecordId properly.
+ *
+ * Children are drained one after another unless 'internalQueryOrStageInterleaveChildren' is set,
+ * in which case each call to work() advances the next child which has not yet hit EOF.
  */
 class OrStage final : public PlanStage {
 public:
@@ -66,6 +71,12 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Moves _currentChild to the next child, in round-robin order, which has not hit EOF. There
+     * must be at least one such child.
+     */
+    void advanceToNextChild();
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -75,6 +86,14 @@ private:
     // Which of _children are we calling work(...) on now?
     size_t _currentChild;
 
+    // True if we move on to the next child after every call to work(...), false if we only move
+    // on once _currentChild hits EOF.
+    const bool _interleaveChildren;
+
+    // Which of _children have hit EOF, and how many of them have.
+    std::vector<bool> _childIsEOF;
+    size_t _numEOFChildren;
+
     // True if we dedup on RecordId, false otherwise.
     bool _dedup;
 
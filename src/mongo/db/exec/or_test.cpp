@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+//
+// This file contains tests for mongo/db/exec/or.cpp
+//
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/or.h"
+
+#include <vector>
+
+#include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context_noop.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+using namespace mongo;
+
+namespace {
+
+using stdx::make_unique;
+
+class OrStageTest : public unittest::Test {
+public:
+    OrStageTest() {
+        _service = stdx::make_unique<ServiceContextNoop>();
+        _client = _service.get()->makeClient("test");
+        _opCtxNoop.reset(new OperationContextNoop(_client.get(), 0));
+        _opCtx = _opCtxNoop.get();
+    }
+
+protected:
+    OperationContext* getOpCtx() {
+        return _opCtx;
+    }
+
+    /**
+     * Builds a child which returns, in order, a document {a: <recordId>} for each of
+     * 'recordIds', with a NEED_TIME before each one.
+     */
+    std::unique_ptr<QueuedDataStage> makeChild(const std::vector<int>& recordIds) {
+        auto child = make_unique<QueuedDataStage>(getOpCtx(), &_ws);
+        for (int recordId : recordIds) {
+            WorkingSetID id = _ws.allocate();
+            WorkingSetMember* member = _ws.get(id);
+            member->recordId = RecordId(recordId);
+            member->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("a" << recordId));
+            _ws.transitionToRecordIdAndObj(id);
+            child->pushBack(PlanStage::NEED_TIME);
+            child->pushBack(id);
+        }
+        return child;
+    }
+
+    /**
+     * Works 'stage' until EOF, returning the record ids of the results in the order they came.
+     */
+    std::vector<int> drain(OrStage* stage) {
+        std::vector<int> out;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (PlanStage::IS_EOF != state) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            state = stage->work(&id);
+            ASSERT_NE(PlanStage::FAILURE, state);
+            ASSERT_NE(PlanStage::DEAD, state);
+            if (PlanStage::ADVANCED == state) {
+                out.push_back(static_cast<int>(_ws.get(id)->recordId.repr()));
+                _ws.free(id);
+            }
+        }
+        return out;
+    }
+
+    WorkingSet _ws;
+
+private:
+    OperationContext* _opCtx;
+
+    // Members of a class are destroyed in reverse order of declaration.
+    // The UniqueClient must be destroyed before the ServiceContextNoop is destroyed.
+    // The OperationContextNoop must be destroyed before the UniqueClient is destroyed.
+    std::unique_ptr<ServiceContextNoop> _service;
+    ServiceContext::UniqueClient _client;
+    std::unique_ptr<OperationContextNoop> _opCtxNoop;
+};
+
+TEST_F(OrStageTest, DrainsChildrenInOrderByDefault) {
+    OrStage orStage(getOpCtx(), &_ws, true, nullptr);
+    orStage.addChild(makeChild({1, 2, 3}).release());
+    orStage.addChild(makeChild({4, 2, 5}).release());
+
+    ASSERT(std::vector<int>({1, 2, 3, 4, 5}) == drain(&orStage));
+}
+
+TEST_F(OrStageTest, InterleavesChildrenAndDedups) {
+    bool oldInterleaveChildren = internalQueryOrStageInterleaveChildren.load();
+    internalQueryOrStageInterleaveChildren.store(true);
+    ON_BLOCK_EXIT([&] { internalQueryOrStageInterleaveChildren.store(oldInterleaveChildren); });
+
+    OrStage orStage(getOpCtx(), &_ws, true, nullptr);
+    orStage.addChild(makeChild({1, 2, 3}).release());
+    orStage.addChild(makeChild({4}).release());
+    orStage.addChild(makeChild({2, 6}).release());
+
+    ASSERT(std::vector<int>({1, 4, 2, 6, 3}) == drain(&orStage));
+
+    const OrStats* stats = static_cast<const OrStats*>(orStage.getSpecificStats());
+    ASSERT_EQUALS(1U, stats->dupsDropped);
+}
+
+}  // namespace
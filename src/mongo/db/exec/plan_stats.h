@@ -138,7 +138,13 @@ private:
 };
 
 struct AndHashStats : public SpecificStats {
-    AndHashStats() : flaggedButPassed(0), flaggedInProgress(0), memUsage(0), memLimit(0) {}
+    AndHashStats()
+        : flaggedButPassed(0),
+          flaggedInProgress(0),
+          memUsage(0),
+          memLimit(0),
+          bloomFilterRejects(0),
+          bloomFilterBytes(0) {}
 
     SpecificStats* clone() const final {
         AndHashStats* specific = new AndHashStats(*this);
@@ -165,6 +171,11 @@ struct AndHashStats : public SpecificStats {
 
     // What's our memory limit?
     size_t memLimit;
+
+    // How many results from the second and later children were rejected by the Bloom filter
+    // without probing the hash table, and how big is the filter?
+    size_t bloomFilterRejects;
+    size_t bloomFilterBytes;
 };
 
 struct AndSortedStats : public SpecificStats {
@@ -183,13 +194,17 @@ struct AndSortedStats : public SpecificStats {
 };
 
 struct CachedPlanStats : public SpecificStats {
-    CachedPlanStats() : replanned(false) {}
+    CachedPlanStats() : replanned(false), evictedAfterTrial(false) {}
 
     SpecificStats* clone() const final {
         return new CachedPlanStats(*this);
     }
 
     bool replanned;
+
+    // True if the cached plan passed its trial period but then slowed down enough while running
+    // that its plan cache entry was evicted.
+    bool evictedAfterTrial;
 };
 
 struct CollectionScanStats : public SpecificStats {
@@ -508,7 +523,7 @@ struct ProjectionStats : public SpecificStats {
 };
 
 struct SortStats : public SpecificStats {
-    SortStats() : forcedFetches(0), memUsage(0), memLimit(0) {}
+    SortStats() : forcedFetches(0), memUsage(0), memLimit(0), usedDisk(false) {}
 
     SpecificStats* clone() const final {
         SortStats* specific = new SortStats(*this);
@@ -529,6 +544,9 @@ struct SortStats : public SpecificStats {
 
     // The pattern according to which we are sorting.
     BSONObj sortPattern;
+
+    // Did the sort run out of memory and spill its data to disk?
+    bool usedDisk;
 };
 
 struct MergeSortStats : public SpecificStats {
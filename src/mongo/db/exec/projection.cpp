@@ -81,20 +81,17 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
             _coveredKeyObj = params.coveredKeyObj;
             invariant(_coveredKeyObj.isOwned());
 
+            size_t keyIndex = 0;
             BSONObjIterator kpIt(_coveredKeyObj);
             while (kpIt.more()) {
                 BSONElement elt = kpIt.next();
                 auto fieldIt = _includedFields.find(elt.fieldNameStringData());
-                if (_includedFields.end() == fieldIt) {
-                    // Push an unused value on the back to keep _includeKey and _keyFieldNames
-                    // in sync.
-                    _keyFieldNames.push_back(StringData());
-                    _includeKey.push_back(false);
-                } else {
-                    // If we are including this key field store its field name.
-                    _keyFieldNames.push_back(fieldIt->first);
-                    _includeKey.push_back(true);
+                if (_includedFields.end() != fieldIt) {
+                    // If we are including this key field store its position and field name.
+                    _coveredFields.push_back({keyIndex, fieldIt->first});
+                    _coveredFieldNamesSize += fieldIt->first.size();
                 }
+                ++keyIndex;
             }
         } else {
             invariant(ProjectionStageParams::SIMPLE_DOC == params.projImpl);
@@ -148,7 +145,7 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
         return _exec->transform(member);
     }
 
-    BSONObjBuilder bob;
+    BSONObj out;
 
     // Note that even if our fast path analysis is bug-free something that is
     // covered might be invalidated and just be an obj.  In this case we just go
@@ -161,29 +158,34 @@ Status ProjectionStage::transform(WorkingSetMember* member) {
         invariant(member->hasObj());
 
         // Apply the SIMPLE_DOC projection.
+        BSONObjBuilder bob;
         transformSimpleInclusion(member->obj.value(), _includedFields, bob);
+        out = bob.obj();
     } else {
         invariant(ProjectionStageParams::COVERED_ONE_INDEX == _projImpl);
         // We're pulling data out of the key.
         invariant(1 == member->keyData.size());
-        size_t keyIndex = 0;
-
-        // Look at every key element...
-        BSONObjIterator keyIterator(member->keyData[0].keyData);
-        while (keyIterator.more()) {
-            BSONElement elt = keyIterator.next();
-            // If we're supposed to include it...
-            if (_includeKey[keyIndex]) {
-                // Do so.
-                bob.appendAs(elt, _keyFieldNames[keyIndex]);
+        const BSONObj& keyData = member->keyData[0].keyData;
+
+        BSONObjBuilder bob(keyData.objsize() + _coveredFieldNamesSize);
+
+        // Walk the key only as far as the last field we include. 'nextKeyIndex' is the position
+        // of the element keyIterator returns next.
+        size_t nextKeyIndex = 0;
+        BSONObjIterator keyIterator(keyData);
+        for (const auto& coveredField : _coveredFields) {
+            for (; nextKeyIndex < coveredField.keyIndex; ++nextKeyIndex) {
+                keyIterator.next();
             }
-            ++keyIndex;
+            bob.appendAs(keyIterator.next(), coveredField.fieldName);
+            ++nextKeyIndex;
         }
+        out = bob.obj();
     }
 
     member->keyData.clear();
     member->recordId = RecordId();
-    member->obj = Snapshotted<BSONObj>(SnapshotId(), bob.obj());
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), out);
     member->transitionToOwnedObj();
     return Status::OK();
 }
@@ -144,12 +144,18 @@ private:
     //
     BSONObj _coveredKeyObj;
 
-    // Field names can be empty in 2.4 and before so we can't use them as a sentinel value.
-    // If the i-th entry is true we include the i-th field in the key.
-    std::vector<bool> _includeKey;
+    // The key fields we include, in key pattern order: the position of each in the key, and the
+    // field name to give it in the output. Field names can be empty in 2.4 and before, which is
+    // why we keep positions rather than matching on names.
+    struct CoveredField {
+        size_t keyIndex;
+        StringData fieldName;
+    };
+    std::vector<CoveredField> _coveredFields;
 
-    // If the i-th entry of _includeKey is true this is the field name for the i-th key field.
-    std::vector<StringData> _keyFieldNames;
+    // The total length of the field names in _coveredFields. An output document is never larger
+    // than the key it is built from plus this, so it is the size we allocate for its builder.
+    int _coveredFieldNamesSize = 0;
 };
 
 }  // namespace mongo
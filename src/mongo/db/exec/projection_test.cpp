@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+//
+// This file contains tests for mongo/db/exec/projection.cpp
+//
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/projection.h"
+
+#include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/service_context_noop.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+using namespace mongo;
+
+namespace {
+
+using stdx::make_unique;
+
+class ProjectionStageTest : public unittest::Test {
+public:
+    ProjectionStageTest() {
+        _service = stdx::make_unique<ServiceContextNoop>();
+        _client = _service.get()->makeClient("test");
+        _opCtxNoop.reset(new OperationContextNoop(_client.get(), 0));
+        _opCtx = _opCtxNoop.get();
+    }
+
+protected:
+    /**
+     * Projects 'key', an index key for 'keyPattern', with the covered fast path for
+     * 'projection', and returns the result.
+     */
+    BSONObj projectCoveredKey(const char* keyPattern, const char* key, const char* projection) {
+        WorkingSet ws;
+        auto child = make_unique<QueuedDataStage>(_opCtx, &ws);
+        WorkingSetID id = ws.allocate();
+        WorkingSetMember* member = ws.get(id);
+        member->keyData.push_back(IndexKeyDatum(fromjson(keyPattern), fromjson(key), nullptr));
+        ws.transitionToRecordIdAndIdx(id);
+        child->pushBack(id);
+
+        ExtensionsCallbackDisallowExtensions extensionsCallback;
+        ProjectionStageParams params(extensionsCallback);
+        params.projImpl = ProjectionStageParams::COVERED_ONE_INDEX;
+        params.projObj = fromjson(projection);
+        params.coveredKeyObj = fromjson(keyPattern);
+        ProjectionStage stage(_opCtx, params, &ws, child.release());
+
+        WorkingSetID outId = WorkingSet::INVALID_ID;
+        ASSERT_EQUALS(PlanStage::ADVANCED, stage.work(&outId));
+        WorkingSetMember* outMember = ws.get(outId);
+        ASSERT(outMember->hasOwnedObj());
+        return outMember->obj.value().getOwned();
+    }
+
+private:
+    OperationContext* _opCtx;
+
+    // Members of a class are destroyed in reverse order of declaration.
+    // The UniqueClient must be destroyed before the ServiceContextNoop is destroyed.
+    // The OperationContextNoop must be destroyed before the UniqueClient is destroyed.
+    std::unique_ptr<ServiceContextNoop> _service;
+    ServiceContext::UniqueClient _client;
+    std::unique_ptr<OperationContextNoop> _opCtxNoop;
+};
+
+TEST_F(ProjectionStageTest, CoveredProjectionSkipsExcludedKeyFields) {
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, c: 'three'}"),
+                      projectCoveredKey("{a: 1, b: 1, c: 1, d: 1}",
+                                        "{'': 1, '': 2, '': 'three', '': 4}",
+                                        "{_id: 0, c: 1, a: 1}"));
+}
+
+TEST_F(ProjectionStageTest, CoveredProjectionOfEveryKeyField) {
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 5, a: {b: 1}}"),
+                      projectCoveredKey("{_id: 1, a: 1}", "{'': 5, '': {b: 1}}", "{a: 1}"));
+}
+
+}  // namespace
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bloom_filter.h"
+
+namespace mongo {
+
+namespace {
+
+// With these settings roughly two to three percent of the RecordIds which were not added pass
+// mayContain().
+const size_t kMinBitsPerEntry = 8;
+const size_t kNumHashes = 4;
+
+const size_t kBitsPerWord = 64;
+
+/**
+ * The 64-bit finalizer from MurmurHash3. RecordIds are often dense integers, so they have to be
+ * mixed before their bits can be used as independent hashes.
+ */
+uint64_t mix(int64_t repr) {
+    uint64_t h = static_cast<uint64_t>(repr);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace
+
+void RecordIdBloomFilter::reset(size_t expectedEntries) {
+    size_t numBits = kBitsPerWord;
+    while (numBits < expectedEntries * kMinBitsPerEntry) {
+        numBits *= 2;
+    }
+
+    _words.assign(numBits / kBitsPerWord, 0);
+    _bitMask = numBits - 1;
+}
+
+void RecordIdBloomFilter::add(const RecordId& rid) {
+    if (_words.empty()) {
+        return;
+    }
+
+    // Derive every hash from two halves of one mixed value (Kirsch and Mitzenmacher).
+    const uint64_t h = mix(rid.repr());
+    const uint64_t h1 = h;
+    const uint64_t h2 = (h >> 32) | (h << 32) | 1;
+    for (size_t i = 0; i < kNumHashes; ++i) {
+        const uint64_t bit = (h1 + i * h2) & _bitMask;
+        _words[bit / kBitsPerWord] |= uint64_t(1) << (bit % kBitsPerWord);
+    }
+}
+
+bool RecordIdBloomFilter::mayContain(const RecordId& rid) const {
+    if (_words.empty()) {
+        return true;
+    }
+
+    const uint64_t h = mix(rid.repr());
+    const uint64_t h1 = h;
+    const uint64_t h2 = (h >> 32) | (h << 32) | 1;
+    for (size_t i = 0; i < kNumHashes; ++i) {
+        const uint64_t bit = (h1 + i * h2) & _bitMask;
+        if (!(_words[bit / kBitsPerWord] & (uint64_t(1) << (bit % kBitsPerWord)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * A Bloom filter over RecordIds. mayContain() never returns false for a RecordId which was
+ * added since the last call to reset(), and returns true for other RecordIds only rarely (a few
+ * percent of the time). Until reset() is first called, mayContain() returns true for everything.
+ *
+ * Used by stages which probe a hash table of RecordIds with many RecordIds that are not in it,
+ * so that most misses never touch the hash table.
+ */
+class RecordIdBloomFilter {
+public:
+    /**
+     * Empties the filter and sizes it for 'expectedEntries' RecordIds.
+     */
+    void reset(size_t expectedEntries);
+
+    void add(const RecordId& rid);
+
+    bool mayContain(const RecordId& rid) const;
+
+    /**
+     * Returns the number of bytes used by the filter's bit array.
+     */
+    size_t getMemUsage() const {
+        return _words.size() * sizeof(uint64_t);
+    }
+
+private:
+    std::vector<uint64_t> _words;
+
+    // The number of bits in '_words' minus one. The number of bits is a power of two.
+    uint64_t _bitMask = 0;
+};
+
+}  // namespace mongo
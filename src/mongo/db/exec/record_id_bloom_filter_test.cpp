@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bloom_filter.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBloomFilterTest, ContainsEverythingBeforeReset) {
+    RecordIdBloomFilter filter;
+    ASSERT_TRUE(filter.mayContain(RecordId(1)));
+    ASSERT_EQUALS(0U, filter.getMemUsage());
+}
+
+TEST(RecordIdBloomFilterTest, ContainsEverythingAdded) {
+    const int kNumEntries = 10000;
+    RecordIdBloomFilter filter;
+    filter.reset(kNumEntries);
+    for (int i = 0; i < kNumEntries; ++i) {
+        filter.add(RecordId(2 * i));
+    }
+
+    for (int i = 0; i < kNumEntries; ++i) {
+        ASSERT_TRUE(filter.mayContain(RecordId(2 * i)));
+    }
+
+    // Most RecordIds which were not added must be rejected.
+    int falsePositives = 0;
+    for (int i = 0; i < kNumEntries; ++i) {
+        if (filter.mayContain(RecordId(2 * i + 1))) {
+            ++falsePositives;
+        }
+    }
+    ASSERT_LT(falsePositives, kNumEntries / 10);
+}
+
+TEST(RecordIdBloomFilterTest, ResetEmptiesFilter) {
+    RecordIdBloomFilter filter;
+    filter.reset(1);
+    filter.add(RecordId(42));
+    ASSERT_TRUE(filter.mayContain(RecordId(42)));
+
+    filter.reset(1);
+    ASSERT_FALSE(filter.mayContain(RecordId(42)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -28,8 +28,11 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/s/metadata_manager.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 
@@ -98,6 +101,10 @@ private:
     // Note: it is important that this is the metadata from the time this stage is constructed.
     // See class comment for details.
     ScopedCollectionMetadata _metadata;
+
+    // Parsed once from '_metadata' so that extracting each document's shard key does not have to
+    // rebuild the key pattern's field paths. Not set if the collection is unsharded.
+    boost::optional<ShardKeyPattern> _shardKeyPattern;
 };
 
 }  // namespace mongo
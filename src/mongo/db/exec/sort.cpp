@@ -41,6 +41,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -51,6 +52,37 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+const char kSpillKeyField[] = "k";
+const char kSpillRecordIdField[] = "r";
+
+/**
+ * Orders spilled data the same way WorkingSetComparator orders buffered data: on the sort key,
+ * with the RecordId as a tie-breaker.
+ */
+class SpillComparator {
+public:
+    explicit SpillComparator(BSONObj pattern) : _pattern(std::move(pattern)) {}
+
+    int operator()(const std::pair<BSONObj, BSONObj>& lhs,
+                   const std::pair<BSONObj, BSONObj>& rhs) const {
+        // False means ignore field names.
+        int result = lhs.first[kSpillKeyField].Obj().woCompare(
+            rhs.first[kSpillKeyField].Obj(), _pattern, false);
+        if (0 != result) {
+            return result;
+        }
+        return RecordId(lhs.first[kSpillRecordIdField].numberLong())
+            .compare(RecordId(rhs.first[kSpillRecordIdField].numberLong()));
+    }
+
+private:
+    BSONObj _pattern;
+};
+
+}  // namespace
+
 // static
 const char* SortStage::kStageType = "SORT";
 
@@ -58,8 +90,14 @@ SortStage::WorkingSetComparator::WorkingSetComparator(BSONObj p) : pattern(p) {}
 
 bool SortStage::WorkingSetComparator::operator()(const SortableDataItem& lhs,
                                                  const SortableDataItem& rhs) const {
-    // False means ignore field names.
-    int result = lhs.sortKey.woCompare(rhs.sortKey, pattern, false);
+    int result;
+    if (!lhs.encodedSortKey.empty()) {
+        // KeyString encodings are ordered by their bytes, and ignore field names.
+        result = lhs.encodedSortKey.compare(rhs.encodedSortKey);
+    } else {
+        // False means ignore field names.
+        result = lhs.sortKey.woCompare(rhs.sortKey, pattern, false);
+    }
     if (0 != result) {
         return result < 0;
     }
@@ -76,6 +114,7 @@ SortStage::SortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _limit(params.limit),
+      _allowDiskUse(params.allowDiskUse),
       _sorted(false),
       _resultIterator(_data.end()),
       _memUsage(0) {
@@ -84,6 +123,11 @@ SortStage::SortStage(OperationContext* opCtx,
     BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
     _sortKeyComparator = stdx::make_unique<WorkingSetComparator>(sortComparator);
 
+    // An Ordering holds at most one direction bit per field.
+    if (sortComparator.nFields() <= 32) {
+        _sortKeyOrdering = Ordering::make(sortComparator);
+    }
+
     // If limit > 1, we need to initialize _dataSet here to maintain ordered set of data items while
     // fetching from the child stage.
     if (_limit > 1) {
@@ -97,12 +141,15 @@ SortStage::~SortStage() {}
 bool SortStage::isEOF() {
     // We're done when our child has no more results, we've sorted the child's results, and
     // we've returned all sorted results.
-    return child()->isEOF() && _sorted && (_data.end() == _resultIterator);
+    if (!child()->isEOF() || !_sorted) {
+        return false;
+    }
+    return _spillIterator ? !_spillIterator->more() : _data.end() == _resultIterator;
 }
 
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
-    if (_memUsage > maxBytes) {
+    if (_memUsage > maxBytes && !(_allowDiskUse && spillBuffer())) {
         mongoutils::str::stream ss;
         ss << "Sort operation used more than the maximum " << maxBytes
            << " bytes of RAM. Add an index, or specify a smaller limit.";
@@ -142,20 +189,40 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
             auto sortKeyComputedData =
                 static_cast<const SortKeyComputedData*>(member->getComputed(WSM_SORT_KEY));
             item.sortKey = sortKeyComputedData->getSortKey();
+            if (_sortKeyOrdering) {
+                _sortKeyBuilder.resetToKey(item.sortKey, *_sortKeyOrdering);
+                item.encodedSortKey.assign(_sortKeyBuilder.getBuffer(),
+                                           _sortKeyBuilder.getSize());
+            }
 
             if (member->hasRecordId()) {
                 // The RecordId breaks ties when sorting two WSMs with the same sort key.
                 item.recordId = member->recordId;
             }
 
-            addToBuffer(item);
+            if (!_spillSorter) {
+                addToBuffer(item);
+            } else if (canSpill(*member)) {
+                addToSpillSorter(item);
+            } else {
+                Status status(ErrorCodes::OperationFailed,
+                              "Sort operation spilled to disk, but received a result with "
+                              "computed data which cannot be spilled");
+                *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+                return PlanStage::FAILURE;
+            }
 
             return PlanStage::NEED_TIME;
         } else if (PlanStage::IS_EOF == code) {
             // TODO: We don't need the lock for this.  We could ask for a yield and do this work
             // unlocked.  Also, this is performing a lot of work for one call to work(...)
-            sortBuffer();
-            _resultIterator = _data.begin();
+            if (_spillSorter) {
+                _spillIterator.reset(_spillSorter->done());
+                _spillSorter.reset();
+            } else {
+                sortBuffer();
+                _resultIterator = _data.begin();
+            }
             _sorted = true;
             return PlanStage::NEED_TIME;
         } else if (PlanStage::FAILURE == code || PlanStage::DEAD == code) {
@@ -178,6 +245,17 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     }
 
     // Returning results.
+    if (_spillIterator) {
+        // Spilled results are owned copies of the documents, with no RecordId attached.
+        SpillSorter::Data next = _spillIterator->next();
+        *out = _ws->allocate();
+        WorkingSetMember* member = _ws->get(*out);
+        member->obj = Snapshotted<BSONObj>(SnapshotId(), next.second.getOwned());
+        member->addComputed(new SortKeyComputedData(next.first[kSpillKeyField].Obj()));
+        _ws->transitionToOwnedObj(*out);
+        return PlanStage::ADVANCED;
+    }
+
     verify(_resultIterator != _data.end());
     verify(_sorted);
     *out = _resultIterator->wsid;
@@ -221,7 +299,7 @@ unique_ptr<PlanStageStats> SortStage::getStats() {
     _commonStats.isEOF = isEOF();
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
     _specificStats.memLimit = maxBytes;
-    _specificStats.memUsage = _memUsage;
+    _specificStats.memUsage = _spillSorter ? _spillSorter->memUsed() : _memUsage;
     _specificStats.limit = _limit;
     _specificStats.sortPattern = _pattern.getOwned();
 
@@ -260,16 +338,20 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
     WorkingSetID wsidToFree = WorkingSet::INVALID_ID;
 
     WorkingSetMember* member = _ws->get(item.wsid);
+
+    // The encoded sort key is buffered along with the member. Called once the member's object is
+    // owned, so that its size is counted.
+    auto itemMemUsage = [&] { return member->getMemUsage() + item.encodedSortKey.size(); };
     if (_limit == 0) {
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         member->makeObjOwnedIfNeeded();
         _data.push_back(item);
-        _memUsage += member->getMemUsage();
+        _memUsage += itemMemUsage();
     } else if (_limit == 1) {
         if (_data.empty()) {
             member->makeObjOwnedIfNeeded();
             _data.push_back(item);
-            _memUsage = member->getMemUsage();
+            _memUsage = itemMemUsage();
             return;
         }
         wsidToFree = item.wsid;
@@ -279,7 +361,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
             wsidToFree = _data[0].wsid;
             member->makeObjOwnedIfNeeded();
             _data[0] = item;
-            _memUsage = member->getMemUsage();
+            _memUsage = itemMemUsage();
         }
     } else {
         // Update data item set instead of vector
@@ -288,7 +370,7 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         if (_dataSet->size() < limit) {
             member->makeObjOwnedIfNeeded();
             _dataSet->insert(item);
-            _memUsage += member->getMemUsage();
+            _memUsage += itemMemUsage();
             return;
         }
         // Limit will be exceeded - compare with item with lowest key
@@ -299,8 +381,8 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         const SortableDataItem& lastItem = *lastItemIt;
         const WorkingSetComparator& cmp = *_sortKeyComparator;
         if (cmp(item, lastItem)) {
-            _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
-            _memUsage += member->getMemUsage();
+            _memUsage -= _ws->get(lastItem.wsid)->getMemUsage() + lastItem.encodedSortKey.size();
+            _memUsage += itemMemUsage();
             wsidToFree = lastItem.wsid;
             // According to std::set iterator validity rules,
             // it does not matter which of erase()/insert() happens first.
@@ -340,4 +422,71 @@ void SortStage::sortBuffer() {
     }
 }
 
+// static
+bool SortStage::canSpill(const WorkingSetMember& member) {
+    for (int type = 0; type < WSM_COMPUTED_NUM_TYPES; ++type) {
+        if (type != WSM_SORT_KEY &&
+            member.hasComputed(static_cast<WorkingSetComputedDataType>(type))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SortStage::spillBuffer() {
+    invariant(!_spillSorter);
+
+    vector<SortableDataItem> buffered;
+    if (_dataSet) {
+        buffered.assign(_dataSet->begin(), _dataSet->end());
+    } else {
+        buffered = _data;
+    }
+
+    for (const SortableDataItem& item : buffered) {
+        if (!canSpill(*_ws->get(item.wsid))) {
+            return false;
+        }
+    }
+
+    const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
+    SortOptions opts = SortOptions()
+                           .Limit(_limit)
+                           .MaxMemoryUsageBytes(maxBytes)
+                           .ExtSortAllowed()
+                           .TempDir(storageGlobalParams.dbpath + "/_tmp");
+    _spillSorter.reset(SpillSorter::make(opts, SpillComparator(_sortKeyComparator->pattern)));
+
+    LOG(1) << "Sort operation used more than " << maxBytes << " bytes of RAM, spilling "
+           << buffered.size() << " results to disk";
+
+    for (const SortableDataItem& item : buffered) {
+        addToSpillSorter(item);
+    }
+    _data.clear();
+    if (_dataSet) {
+        _dataSet->clear();
+    }
+    _memUsage = 0;
+    _specificStats.usedDisk = true;
+    return true;
+}
+
+void SortStage::addToSpillSorter(const SortableDataItem& item) {
+    WorkingSetMember* member = _ws->get(item.wsid);
+
+    BSONObjBuilder key;
+    key.append(kSpillKeyField, item.sortKey);
+    key.append(kSpillRecordIdField, static_cast<long long>(item.recordId.repr()));
+    _spillSorter->add(key.obj(), member->obj.value().getOwned());
+
+    if (member->hasRecordId()) {
+        _wsidByRecordId.erase(member->recordId);
+    }
+    _ws->free(item.wsid);
+}
+
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+MONGO_CREATE_SORTER(mongo::BSONObj, mongo::BSONObj, mongo::SpillComparator);
@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -37,6 +39,8 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/platform/unordered_map.h"
 
 namespace mongo {
@@ -46,7 +50,7 @@ class BtreeKeyGenerator;
 // Parameters that must be provided to a SortStage
 class SortStageParams {
 public:
-    SortStageParams() : collection(NULL), limit(0) {}
+    SortStageParams() : collection(NULL), limit(0), allowDiskUse(false) {}
 
     // Used for resolving RecordIds to BSON
     const Collection* collection;
@@ -56,6 +60,10 @@ public:
 
     // Equal to 0 for no limit.
     size_t limit;
+
+    // If true, the sort spills to disk rather than failing when it uses more than
+    // internalQueryExecMaxBlockingSortBytes of memory.
+    bool allowDiskUse;
 };
 
 /**
@@ -65,6 +73,10 @@ public:
  *   -- For each field in 'pattern', all inputs in the child must handle a getFieldDotted for that
  *   field.
  *   -- All WSMs produced by the child stage must have the sort key available as WSM computed data.
+ *
+ * If the sort is allowed to use the disk and outgrows its memory limit, all of the buffered data
+ * is handed over to an external Sorter. Results which come back from the Sorter are owned copies
+ * of the documents, just as if their RecordIds had been invalidated.
  */
 class SortStage final : public PlanStage {
 public:
@@ -106,6 +118,8 @@ private:
     // Equal to 0 for no limit.
     size_t _limit;
 
+    const bool _allowDiskUse;
+
     //
     // Data storage
     //
@@ -118,6 +132,9 @@ private:
     struct SortableDataItem {
         WorkingSetID wsid;
         BSONObj sortKey;
+        // 'sortKey' encoded as a KeyString under the sort pattern's ordering, so that comparing
+        // two items is a memcmp. Empty if the pattern has too many fields to be encoded.
+        std::string encodedSortKey;
         // Since we must replicate the behavior of a covered sort as much as possible we use the
         // RecordId to break sortKey ties.
         // See sorta.js.
@@ -125,8 +142,9 @@ private:
     };
 
     // Comparison object for data buffers (vector and set). Items are compared on (sortKey, loc).
-    // This is also how the items are ordered in the indices. Keys are compared using
-    // BSONObj::woCompare() with RecordId as a tie-breaker.
+    // This is also how the items are ordered in the indices. Keys are compared on their KeyString
+    // encoding if they have one, and using BSONObj::woCompare() otherwise, with RecordId as a
+    // tie-breaker.
     //
     // We are comparing keys generated by the SortKeyGenerator, which are already ordered with
     // respect the collation. Therefore, we explicitly avoid comparing using a collator here.
@@ -152,10 +170,41 @@ private:
      */
     void sortBuffer();
 
+    // Spilled data is keyed by {k: <sort key>, r: <RecordId repr>}, and the value is the document.
+    typedef Sorter<BSONObj, BSONObj> SpillSorter;
+
+    /**
+     * Returns whether 'member' may be spilled to disk. Computed data other than the sort key
+     * would be lost by spilling, so members carrying any other computed data cannot be.
+     */
+    static bool canSpill(const WorkingSetMember& member);
+
+    /**
+     * Moves everything buffered so far into a new external Sorter. Returns false, leaving the
+     * buffer untouched, if some buffered member cannot be spilled.
+     */
+    bool spillBuffer();
+
+    /**
+     * Adds the member 'item' refers to to the external Sorter and frees it.
+     */
+    void addToSpillSorter(const SortableDataItem& item);
+
+    // Set once the data no longer fits in memory. All further input goes here.
+    std::unique_ptr<SpillSorter> _spillSorter;
+
+    // Iterates over the sorted results of '_spillSorter' once all input has been added.
+    std::unique_ptr<SpillSorter::Iterator> _spillIterator;
+
     // Comparator for data buffer
     // Initialization follows sort key generator
     std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
 
+    // Ordering used to encode sort keys into SortableDataItem::encodedSortKey, and the KeyString
+    // reused to do so. Not set if the sort pattern has more fields than an Ordering can hold.
+    boost::optional<Ordering> _sortKeyOrdering;
+    KeyString _sortKeyBuilder{KeyString::Version::V1};
+
     // The data we buffer and sort.
     // _data will contain sorted data when all data is gathered
     // and sorted.
@@ -229,6 +229,26 @@ TEST_F(SortStageTest, SortDescending) {
              "{output: [{a: 3}, {a: 2}, {a: 1}]}");
 }
 
+// Numbers of different types compare by value, and types sort in BSON type order, exactly as
+// they would under BSONObj::woCompare().
+TEST_F(SortStageTest, SortMixedTypes) {
+    testWork("{a: 1}",
+             nullptr,
+             "{}",
+             0,
+             "{input: [{a: 'x'}, {a: 2.5}, {a: null}, {a: NumberLong(2)}, {a: 3}, {a: {b: 1}}]}",
+             "{output: [{a: null}, {a: NumberLong(2)}, {a: 2.5}, {a: 3}, {a: 'x'}, {a: {b: 1}}]}");
+}
+
+TEST_F(SortStageTest, SortCompoundMixedDirections) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             "{}",
+             0,
+             "{input: [{a: 1, b: 1}, {a: 2, b: 1}, {a: 1, b: 2}, {a: 2, b: 'z'}]}",
+             "{output: [{a: 1, b: 2}, {a: 1, b: 1}, {a: 2, b: 'z'}, {a: 2, b: 1}]}");
+}
+
 TEST_F(SortStageTest, SortIrrelevantSortKey) {
     testWork("{b: 1}",
              nullptr,
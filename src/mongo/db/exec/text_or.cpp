@@ -100,6 +100,12 @@ void TextOrStage::doReattachToOperationContext() {
 }
 
 void TextOrStage::doInvalidate(OperationContext* txn, const RecordId& dl, InvalidationType type) {
+    // With a single term, the ScoreMap only records the documents already returned or rejected,
+    // which must not be returned if they are seen again.
+    if (_children.size() == 1) {
+        return;
+    }
+
     // Remove the RecordID from the ScoreMap.
     ScoreMap::iterator scoreIt = _scores.find(dl);
     if (scoreIt != _scores.end()) {
@@ -334,7 +340,8 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
     if (textRecordData->score < 0) {
-        // We have already rejected this document for not matching the filter.
+        // We have already rejected this document for not matching the filter, or, with a single
+        // term, already returned it.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
         _ws->free(wsid);
         return NEED_TIME;
@@ -419,6 +426,22 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     BSONElement scoreElement = keyIt.next();
     double documentTermScore = scoreElement.number();
 
+    // With a single term, the score of a document is final as soon as we find it. Return it
+    // right away, which keeps the documents in the descending score order of the index scan.
+    if (_children.size() == 1) {
+        const WorkingSetID resultId = textRecordData->wsid;
+
+        // Keep the entry, so that the document is not returned again if the index scan sees it
+        // again, as it may after a yield. It is marked like a rejected document, which also keeps
+        // returnResults() from returning it.
+        textRecordData->wsid = WorkingSet::INVALID_ID;
+        textRecordData->score = -1;
+
+        wsm->addComputed(new TextScoreComputedData(documentTermScore));
+        *out = resultId;
+        return ADVANCED;
+    }
+
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
@@ -51,6 +51,9 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * With a single child, i.e. a single term, nothing needs to be buffered: documents are returned as
+ * they are read, in the order of the index scan.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public PlanStage {
@@ -565,7 +565,10 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 oldObj.value(), updatedFields, _doc, immutableFields, driver->modOptions()));
         }
 
-        // Prepare to write back the modified document
+        // Prepare to write back the modified document. Each document gets its own unit of work,
+        // even for multi-updates: the child stages are saved and restored around it, a write
+        // conflict only has to retry this one document, and _updatedRecordIds and the stats must
+        // never count a document whose write was rolled back.
         WriteUnitOfWork wunit(getOpCtx());
 
         RecordId newRecordId;
@@ -581,6 +584,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 args.ns = _collection->ns().ns();
                 args.update = logObj;
                 args.criteria = idQuery;
+                args.preImageDoc = oldObj.value();
                 args.fromMigrate = request->isFromMigration();
                 StatusWith<RecordData> newRecStatus = _collection->updateDocumentWithDamages(
                     getOpCtx(),
@@ -610,6 +614,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 args.ns = _collection->ns().ns();
                 args.update = logObj;
                 args.criteria = idQuery;
+                args.preImageDoc = oldObj.value();
                 args.fromMigrate = request->isFromMigration();
                 StatusWith<RecordId> res = _collection->updateDocument(getOpCtx(),
                                                                        recordId,
@@ -618,7 +623,10 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                                                        true,
                                                                        driver->modsAffectIndices(),
                                                                        _params.opDebug,
-                                                                       &args);
+                                                                       &args,
+                                                                       driver->isDocReplacement()
+                                                                           ? nullptr
+                                                                           : &updatedFields);
                 uassertStatusOK(res.getStatus());
                 newRecordId = res.getValue();
             }
@@ -39,15 +39,25 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+const size_t WorkingSet::kMinMembersPerBlock;
+const size_t WorkingSet::kMaxMembersPerBlock;
+
 WorkingSet::MemberHolder::MemberHolder() : member(NULL) {}
 WorkingSet::MemberHolder::~MemberHolder() {}
 
 WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
-WorkingSet::~WorkingSet() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
+WorkingSet::~WorkingSet() = default;
+
+WorkingSetMember* WorkingSet::_newMember() {
+    if (_lastBlockUsed == _lastBlockSize) {
+        _lastBlockSize = _memberBlocks.empty()
+            ? kMinMembersPerBlock
+            : std::min(_lastBlockSize * 2, kMaxMembersPerBlock);
+        _memberBlocks.emplace_back(new WorkingSetMember[_lastBlockSize]);
+        _lastBlockUsed = 0;
     }
+    return &_memberBlocks.back()[_lastBlockUsed++];
 }
 
 WorkingSetID WorkingSet::allocate() {
@@ -58,7 +68,7 @@ WorkingSetID WorkingSet::allocate() {
         WorkingSetID id = _data.size();
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
-        _data.back().member = new WorkingSetMember();
+        _data.back().member = _newMember();
         return id;
     }
 
@@ -96,10 +106,10 @@ bool WorkingSet::isFlagged(WorkingSetID id) const {
 }
 
 void WorkingSet::clear() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
     _data.clear();
+    _memberBlocks.clear();
+    _lastBlockSize = 0;
+    _lastBlockUsed = 0;
 
     // Since working set is now empty, the free list pointer should
     // point to nothing.
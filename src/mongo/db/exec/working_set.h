@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
@@ -147,14 +148,33 @@ private:
         // Free list link if freed. Points to self if in use.
         WorkingSetID nextFreeOrSelf;
 
-        // Owning pointer
+        // Points into one of the blocks in '_memberBlocks', which own the member.
         WorkingSetMember* member;
     };
 
+    /**
+     * Returns a pointer to a default-constructed member carved out of '_memberBlocks', allocating
+     * a new block if the last one has been used up.
+     */
+    WorkingSetMember* _newMember();
+
+    // The first block of members holds this many; each subsequent block is twice as large as the
+    // previous one, up to kMaxMembersPerBlock.
+    static const size_t kMinMembersPerBlock = 4;
+    static const size_t kMaxMembersPerBlock = 512;
+
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
     // Elements are added to _freeList rather than removed when freed.
     std::vector<MemberHolder> _data;
 
+    // Members are constructed in blocks rather than individually, so that a stage tree which
+    // holds many results at once (e.g. a blocking sort) does not pay for one heap allocation per
+    // member, and all of them are released together when the WorkingSet is destroyed or cleared.
+    // Blocks are never moved or resized once allocated, so pointers to members remain stable.
+    std::vector<std::unique_ptr<WorkingSetMember[]>> _memberBlocks;
+    size_t _lastBlockSize = 0;
+    size_t _lastBlockUsed = 0;
+
     // Index into _data, forming a linked-list using MemberHolder::nextFreeOrSelf as the next
     // link. INVALID_ID is the list terminator since 0 is a valid index.
     // If _freeList == INVALID_ID, the free list is empty and all elements in _data are in use.
@@ -31,6 +31,10 @@
  */
 
 
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
@@ -154,4 +158,37 @@ TEST_F(WorkingSetFixture, getDottedFieldFromIndex) {
     ASSERT_FALSE(member->getFieldDotted("y", &elt));
 }
 
+TEST_F(WorkingSetFixture, MembersRemainValidAcrossManyAllocations) {
+    // Allocate enough members to span several blocks, making sure that every member has a distinct
+    // address which does not change as later members are allocated.
+    std::vector<std::pair<WorkingSetID, WorkingSetMember*>> allocated;
+    for (int i = 0; i < 2000; ++i) {
+        WorkingSetID newId = ws->allocate();
+        WorkingSetMember* newMember = ws->get(newId);
+        ASSERT_EQUALS(WorkingSetMember::INVALID, newMember->getState());
+        newMember->obj = Snapshotted<BSONObj>(SnapshotId(), BSON("a" << i));
+        allocated.emplace_back(newId, newMember);
+    }
+
+    std::set<WorkingSetMember*> distinctMembers;
+    for (size_t i = 0; i < allocated.size(); ++i) {
+        ASSERT_EQUALS(allocated[i].second, ws->get(allocated[i].first));
+        ASSERT_EQUALS(static_cast<int>(i), allocated[i].second->obj.value()["a"].numberInt());
+        distinctMembers.insert(allocated[i].second);
+    }
+    ASSERT_EQUALS(allocated.size(), distinctMembers.size());
+
+    // Freed members are cleared and handed out again rather than consuming new storage.
+    ws->free(allocated[10].first);
+    WorkingSetID reusedId = ws->allocate();
+    ASSERT_EQUALS(allocated[10].first, reusedId);
+    ASSERT_EQUALS(allocated[10].second, ws->get(reusedId));
+    ASSERT_TRUE(ws->get(reusedId)->obj.value().isEmpty());
+
+    // Members allocated after clear() are usable as well.
+    ws->clear();
+    WorkingSetID idAfterClear = ws->allocate();
+    ASSERT_EQUALS(WorkingSetMember::INVALID, ws->get(idAfterClear)->getState());
+}
+
 }  // namespace
@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/chunk_buffer.h"
+
+#include "mongo/db/operation_context.h"
+
+namespace mongo {
+
+void FTDCChunkBuffer::addArchived(BSONObj doc) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _archived.push_back({++_lastSequence, doc.getOwned()});
+    while (_archived.size() > _maxArchivedChunks) {
+        _lastDiscardedSequence = _archived.front().sequence;
+        _archived.pop_front();
+    }
+    _interim = boost::none;
+    _condvar.notify_all();
+}
+
+void FTDCChunkBuffer::setInterim(BSONObj doc) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _interim = Chunk{++_lastSequence, doc.getOwned()};
+    _condvar.notify_all();
+}
+
+FTDCChunkBuffer::Chunks FTDCChunkBuffer::getChunksAfter(OperationContext* txn,
+                                                        std::uint64_t after,
+                                                        Date_t deadline) {
+    stdx::unique_lock<stdx::mutex> lock(_mutex);
+    txn->waitForConditionOrInterruptUntil(
+        _condvar, lock, deadline, [&] { return _lastSequence > after; });
+    return _getChunksAfter_inlock(after);
+}
+
+FTDCChunkBuffer::Chunks FTDCChunkBuffer::_getChunksAfter_inlock(std::uint64_t after) const {
+    Chunks chunks;
+    for (auto&& chunk : _archived) {
+        if (chunk.sequence > after) {
+            chunks.archived.push_back(chunk);
+        }
+    }
+
+    // Interim chunks take sequence numbers too, but are superseded rather than kept, so only an
+    // archived document discarded after 'after' was missed.
+    chunks.truncated = _lastDiscardedSequence > after;
+
+    if (_interim && _interim->sequence > after) {
+        chunks.interim = _interim;
+    }
+    return chunks;
+}
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Keeps the most recent documents FTDC wrote to its archive file, metadata and compressed metric
+ * chunks alike, and the latest interim metric chunk, so that monitoring tools can read the samples
+ * FTDC already collected and compressed rather than collecting their own.
+ *
+ * Each document is given a sequence number one higher than the document before it, so that a
+ * reader can ask for only the documents it has not seen yet. An interim chunk holds the samples
+ * which are not in an archived chunk yet, and is superseded by the next interim or archived chunk.
+ *
+ * Thread-safe.
+ */
+class FTDCChunkBuffer {
+    MONGO_DISALLOW_COPYING(FTDCChunkBuffer);
+
+public:
+    struct Chunk {
+        std::uint64_t sequence;
+        BSONObj doc;
+    };
+
+    struct Chunks {
+        // The archived documents after the requested sequence number, oldest first.
+        std::vector<Chunk> archived;
+
+        // The current interim chunk, if it is after the requested sequence number.
+        boost::optional<Chunk> interim;
+
+        // True if archived documents after the requested sequence number were discarded before
+        // they were read.
+        bool truncated = false;
+    };
+
+    explicit FTDCChunkBuffer(std::size_t maxArchivedChunks)
+        : _maxArchivedChunks(maxArchivedChunks) {}
+
+    /**
+     * Adds a document written to the archive file. Discards the interim chunk, whose samples are
+     * in this document if it is a metric chunk.
+     */
+    void addArchived(BSONObj doc);
+
+    /**
+     * Replaces the interim chunk.
+     */
+    void setInterim(BSONObj doc);
+
+    /**
+     * Returns the documents after sequence number 'after', waiting until 'deadline' for there to be
+     * any. Throws if 'txn' is interrupted while waiting.
+     */
+    Chunks getChunksAfter(OperationContext* txn, std::uint64_t after, Date_t deadline);
+
+private:
+    Chunks _getChunksAfter_inlock(std::uint64_t after) const;
+
+    const std::size_t _maxArchivedChunks;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+
+    // The sequence number of the last document added, or 0 if there is none.
+    std::uint64_t _lastSequence = 0;
+
+    // The sequence number of the last archived document discarded, or 0 if there is none.
+    std::uint64_t _lastDiscardedSequence = 0;
+
+    std::deque<Chunk> _archived;
+    boost::optional<Chunk> _interim;
+};
+
+}  // namespace mongo
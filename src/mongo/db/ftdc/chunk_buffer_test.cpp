@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/ftdc/chunk_buffer.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+Date_t now() {
+    return getGlobalServiceContext()->getPreciseClockSource()->now();
+}
+
+TEST(FTDCChunkBufferTest, ReturnsOnlyChunksAfterSequence) {
+    FTDCChunkBuffer buffer(4);
+    buffer.addArchived(BSON("chunk" << 1));
+    buffer.addArchived(BSON("chunk" << 2));
+    buffer.addArchived(BSON("chunk" << 3));
+
+    auto txn = cc().makeOperationContext();
+    auto all = buffer.getChunksAfter(txn.get(), 0, now());
+    ASSERT_EQUALS(all.archived.size(), 3U);
+    ASSERT_EQUALS(all.archived[0].sequence, 1U);
+    ASSERT_BSONOBJ_EQ(all.archived[2].doc, BSON("chunk" << 3));
+    ASSERT_FALSE(all.interim);
+    ASSERT_FALSE(all.truncated);
+
+    auto later = buffer.getChunksAfter(txn.get(), 2, now());
+    ASSERT_EQUALS(later.archived.size(), 1U);
+    ASSERT_EQUALS(later.archived[0].sequence, 3U);
+
+    auto none = buffer.getChunksAfter(txn.get(), 3, now());
+    ASSERT_TRUE(none.archived.empty());
+    ASSERT_FALSE(none.truncated);
+}
+
+TEST(FTDCChunkBufferTest, InterimChunkIsSupersededByNextChunk) {
+    FTDCChunkBuffer buffer(4);
+    auto txn = cc().makeOperationContext();
+
+    buffer.setInterim(BSON("interim" << 1));
+    buffer.setInterim(BSON("interim" << 2));
+    auto interim = buffer.getChunksAfter(txn.get(), 0, now());
+    ASSERT_TRUE(interim.archived.empty());
+    ASSERT_TRUE(interim.interim);
+    ASSERT_EQUALS(interim.interim->sequence, 2U);
+    ASSERT_BSONOBJ_EQ(interim.interim->doc, BSON("interim" << 2));
+
+    // A reader of the interim chunk has missed nothing when it is archived.
+    buffer.addArchived(BSON("chunk" << 1));
+    auto archived = buffer.getChunksAfter(txn.get(), 2, now());
+    ASSERT_EQUALS(archived.archived.size(), 1U);
+    ASSERT_EQUALS(archived.archived[0].sequence, 3U);
+    ASSERT_FALSE(archived.interim);
+    ASSERT_FALSE(archived.truncated);
+}
+
+TEST(FTDCChunkBufferTest, ReportsDiscardedChunks) {
+    FTDCChunkBuffer buffer(2);
+    for (int i = 0; i < 4; ++i) {
+        buffer.addArchived(BSON("chunk" << i));
+    }
+
+    auto txn = cc().makeOperationContext();
+    auto chunks = buffer.getChunksAfter(txn.get(), 1, now());
+    ASSERT_TRUE(chunks.truncated);
+    ASSERT_EQUALS(chunks.archived.size(), 2U);
+    ASSERT_EQUALS(chunks.archived[0].sequence, 3U);
+
+    ASSERT_FALSE(buffer.getChunksAfter(txn.get(), 2, now()).truncated);
+}
+
+TEST(FTDCChunkBufferTest, InterimChunksDoNotLookLikeDiscardedChunks) {
+    FTDCChunkBuffer buffer(1);
+    buffer.addArchived(BSON("chunk" << 1));
+    buffer.setInterim(BSON("interim" << 1));
+    buffer.setInterim(BSON("interim" << 2));
+    buffer.addArchived(BSON("chunk" << 2));
+
+    // The reader of the first chunk only missed interim chunks, which the second one supersedes.
+    auto txn = cc().makeOperationContext();
+    auto chunks = buffer.getChunksAfter(txn.get(), 1, now());
+    ASSERT_FALSE(chunks.truncated);
+    ASSERT_EQUALS(chunks.archived.size(), 1U);
+    ASSERT_EQUALS(chunks.archived[0].sequence, 4U);
+
+    // A reader which had not seen the first chunk did miss it.
+    ASSERT_TRUE(buffer.getChunksAfter(txn.get(), 0, now()).truncated);
+}
+
+TEST(FTDCChunkBufferTest, WaitsForNextChunk) {
+    FTDCChunkBuffer buffer(4);
+    buffer.addArchived(BSON("chunk" << 1));
+
+    stdx::thread writer([&] { buffer.addArchived(BSON("chunk" << 2)); });
+
+    auto txn = cc().makeOperationContext();
+    auto chunks = buffer.getChunksAfter(txn.get(), 1, Date_t::max());
+    writer.join();
+
+    ASSERT_EQUALS(chunks.archived.size(), 1U);
+    ASSERT_BSONOBJ_EQ(chunks.archived[0].doc, BSON("chunk" << 2));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -30,6 +30,8 @@
 
 #include "mongo/db/ftdc/collector.h"
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -38,16 +40,183 @@
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
-void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+namespace {
+
+/**
+ * Appends a sample of 'collector' to 'builder', bracketed by the times at which collecting started
+ * and ended.
+ */
+void collectOne(Client* client,
+                OperationContext* txn,
+                FTDCCollectorInterface* collector,
+                Date_t start,
+                BSONObjBuilder* builder) {
+    builder->appendDate(kFTDCCollectStartField, start);
+
+    {
+        ScopedTransaction st(txn, MODE_IS);
+        collector->collect(txn, *builder);
+    }
+
+    builder->appendDate(kFTDCCollectEndField,
+                        client->getServiceContext()->getPreciseClockSource()->now());
+}
+
+}  // namespace
+
+/**
+ * Collects samples of a collector on a thread of its own, one whenever a sample is requested.
+ */
+class FTDCCollectorCollection::AsyncCollector {
+    MONGO_DISALLOW_COPYING(AsyncCollector);
+
+public:
+    explicit AsyncCollector(FTDCCollectorInterface* collector) : _collector(collector) {}
+
+    ~AsyncCollector() {
+        stop();
+    }
+
+    /**
+     * Stops the thread, waiting for a sample it is collecting to finish. No sample is collected
+     * after this returns.
+     */
+    void stop() {
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            _shutdown = true;
+            _condvar.notify_all();
+        }
+
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    /**
+     * Asks for a new sample, unless the previously requested one is still being collected or the
+     * collector has been stopped.
+     */
+    void request() {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        if (_shutdown) {
+            return;
+        }
+
+        if (!_thread.joinable()) {
+            _thread = stdx::thread([this] { _run(); });
+        }
+
+        if (_requested == _completed) {
+            ++_requested;
+            _condvar.notify_all();
+        }
+    }
+
+    /**
+     * Waits until 'deadline' for the requested sample. Returns the most recently collected sample,
+     * which is an older one if the requested one was not collected in time, or boost::none if no
+     * sample has been collected yet.
+     */
+    boost::optional<BSONObj> waitForSample(Date_t deadline) {
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        _condvar.wait_until(
+            lock, deadline.toSystemTimePoint(), [&] { return _requested == _completed; });
+
+        if (_completed == 0) {
+            return boost::none;
+        }
+        return _sample;
+    }
+
+private:
+    void _run() {
+        Client::initThread(("ftdc-" + _collector->name()).c_str());
+        Client* client = &cc();
+
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        while (true) {
+            _condvar.wait(lock, [&] { return _shutdown || _requested != _completed; });
+            if (_shutdown) {
+                return;
+            }
+
+            lock.unlock();
+
+            BSONObj sample;
+            try {
+                auto txn = client->makeOperationContext();
+                txn->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+
+                BSONObjBuilder builder;
+                collectOne(client,
+                           txn.get(),
+                           _collector,
+                           client->getServiceContext()->getPreciseClockSource()->now(),
+                           &builder);
+                sample = builder.obj();
+            } catch (...) {
+                // Report the failure in place of the sample rather than losing this thread.
+                sample = BSON("errmsg" << exceptionToStatus().toString());
+            }
+
+            lock.lock();
+            _sample = std::move(sample);
+            ++_completed;
+            _condvar.notify_all();
+        }
+    }
+
+    FTDCCollectorInterface* const _collector;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+
+    // Number of samples requested and collected so far.
+    std::uint64_t _requested = 0;
+    std::uint64_t _completed = 0;
+
+    // Most recently collected sample.
+    BSONObj _sample;
+
+    bool _shutdown = false;
+
+    stdx::thread _thread;
+};
+
+FTDCCollectorCollection::FTDCCollectorCollection() = default;
+
+FTDCCollectorCollection::~FTDCCollectorCollection() = default;
+
+void FTDCCollectorCollection::stop() {
+    for (auto& entry : _collectors) {
+        if (entry.async) {
+            entry.async->stop();
+        }
+    }
+}
+
+void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector, Mode mode) {
     // TODO: ensure the collectors all have unique names.
-    _collectors.emplace_back(std::move(collector));
+    Entry entry;
+    entry.collector = std::move(collector);
+    if (mode == Mode::kAsynchronous) {
+        entry.async = stdx::make_unique<AsyncCollector>(entry.collector.get());
+    }
+    _collectors.emplace_back(std::move(entry));
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             const FTDCConfig* config) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -62,36 +231,64 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
     builder.appendDate(kFTDCCollectStartField, start);
 
+    // Decide which collectors are due, and start the asynchronous ones so that they run alongside
+    // the synchronous ones.
+    std::vector<bool> due(_collectors.size(), true);
+    for (size_t i = 0; i < _collectors.size(); ++i) {
+        auto& entry = _collectors[i];
+        if (config && !entry.lastSample.isEmpty()) {
+            auto period = config->collectorPeriods.find(entry.collector->name());
+            if (period != config->collectorPeriods.end() &&
+                start - entry.lastCollected < period->second) {
+                due[i] = false;
+                continue;
+            }
+        }
+
+        if (entry.async) {
+            entry.async->request();
+        }
+    }
+    const Date_t asyncDeadline = start + (config ? config->period / 2 : Milliseconds(0));
+
     // All collectors should be ok seeing the inconsistent states in the middle of replication
     // batches. This is desirable because we want to be able to collect data in the middle of
     // batches that are taking a long time.
     auto txn = client->makeOperationContext();
     txn->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
-    for (auto& collector : _collectors) {
-        BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
+    for (size_t i = 0; i < _collectors.size(); ++i) {
+        auto& entry = _collectors[i];
 
-        // Add a Date_t before and after each BSON is collected so that we can track timing of the
-        // collector.
-        Date_t now = start;
+        if (due[i] && entry.async) {
+            if (auto sample = entry.async->waitForSample(asyncDeadline)) {
+                entry.lastSample = std::move(*sample);
+                entry.lastCollected = start;
+            }
+        } else if (due[i]) {
+            // Add a Date_t before and after each BSON is collected so that we can track timing of
+            // the collector.
+            Date_t now = start;
 
-        if (!firstLoop) {
-            now = client->getServiceContext()->getPreciseClockSource()->now();
-        }
+            if (!firstLoop) {
+                now = client->getServiceContext()->getPreciseClockSource()->now();
+            }
 
-        firstLoop = false;
+            firstLoop = false;
 
-        subObjBuilder.appendDate(kFTDCCollectStartField, now);
-
-        {
-            ScopedTransaction st(txn.get(), MODE_IS);
-            collector->collect(txn.get(), subObjBuilder);
+            BSONObjBuilder subObjBuilder;
+            collectOne(client, txn.get(), entry.collector.get(), now, &subObjBuilder);
+            entry.lastSample = subObjBuilder.obj();
+            entry.lastCollected = start;
         }
 
-        end = client->getServiceContext()->getPreciseClockSource()->now();
-        subObjBuilder.appendDate(kFTDCCollectEndField, end);
+        // An asynchronous collector has nothing to show until its first sample completes.
+        if (!entry.lastSample.isEmpty()) {
+            builder.append(entry.collector->name(), entry.lastSample);
+        }
     }
 
+    end = client->getServiceContext()->getPreciseClockSource()->now();
     builder.appendDate(kFTDCCollectEndField, end);
 
     return std::tuple<BSONObj, Date_t>(builder.obj(), start);
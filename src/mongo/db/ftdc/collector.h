@@ -33,12 +33,13 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/ftdc/config.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
-class Date_t;
 class Client;
 class OperationContext;
 
@@ -81,18 +82,37 @@ class FTDCCollectorCollection {
     MONGO_DISALLOW_COPYING(FTDCCollectorCollection);
 
 public:
-    FTDCCollectorCollection() = default;
+    /**
+     * How a collector is run by collect().
+     */
+    enum class Mode {
+        // On the thread calling collect().
+        kSynchronous,
+
+        // On a thread of its own, so that a slow collector does not delay the others. collect()
+        // waits for it until half of the configured period has passed, and otherwise repeats its
+        // previous sample.
+        kAsynchronous,
+    };
+
+    FTDCCollectorCollection();
+    ~FTDCCollectorCollection();
 
     /**
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
      */
-    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+    void add(std::unique_ptr<FTDCCollectorInterface> collector,
+             Mode mode = Mode::kSynchronous);
 
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
      * Returns a tuple of a sample, and the time at which collecting started.
      *
+     * If 'config' is given, a collector listed in its collectorPeriods is only run once its period
+     * has passed since it last ran. Until then its previous sample is repeated, so that the schema
+     * of the samples does not change and the repeated values compress to almost nothing.
+     *
      * Sample schema:
      * {
      *    "start" : Date_t,    <- Time at which all collecting started
@@ -105,11 +125,31 @@ public:
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(Client* client, const FTDCConfig* config = nullptr);
+
+    /**
+     * Stops the threads of the asynchronous collectors, waiting for the samples they are collecting
+     * to finish. Afterwards, collect() repeats their last samples instead of collecting new ones.
+     */
+    void stop();
 
 private:
+    class AsyncCollector;
+
+    struct Entry {
+        std::unique_ptr<FTDCCollectorInterface> collector;
+
+        // Runs 'collector' in the background if it was added as asynchronous. Declared after
+        // 'collector' so that its thread is stopped first.
+        std::unique_ptr<AsyncCollector> async;
+
+        // The last sample of this collector, including its start and end dates.
+        BSONObj lastSample;
+        Date_t lastCollected;
+    };
+
     // collection of collectors
-    std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+    std::vector<Entry> _collectors;
 };
 
 }  // namespace mongo
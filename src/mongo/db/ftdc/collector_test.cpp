@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/config.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Appends the number of times it has been collected.
+ */
+class CountingCollector final : public FTDCCollectorInterface {
+public:
+    explicit CountingCollector(std::string name) : _name(std::move(name)) {}
+
+    void collect(OperationContext* txn, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+private:
+    const std::string _name;
+    int _count = 0;
+};
+
+/**
+ * Blocks its first collection until released.
+ */
+class BlockingCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* txn, BSONObjBuilder& builder) final {
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        _started = true;
+        _condvar.notify_all();
+        _condvar.wait(lock, [&] { return _released; });
+        builder.append("count", ++_count);
+        _condvar.notify_all();
+    }
+
+    std::string name() const final {
+        return "blocking";
+    }
+
+    void release() {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        _released = true;
+        _condvar.notify_all();
+    }
+
+    void waitForFirstSample() {
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        _condvar.wait(lock, [&] { return _count > 0; });
+    }
+
+    void waitForCollectStarted() {
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        _condvar.wait(lock, [&] { return _started; });
+    }
+
+    int count() {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        return _count;
+    }
+
+private:
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    bool _started = false;
+    bool _released = false;
+    int _count = 0;
+};
+
+ClockSourceMock* getMockClock() {
+    return static_cast<ClockSourceMock*>(getGlobalServiceContext()->getPreciseClockSource());
+}
+
+TEST(FTDCCollectorCollectionTest, SlowCollectorRepeatsSampleUntilItsPeriodPasses) {
+    FTDCCollectorCollection collection;
+    collection.add(stdx::make_unique<CountingCollector>("fast"));
+    collection.add(stdx::make_unique<CountingCollector>("slow"));
+
+    FTDCConfig config;
+    config.period = Milliseconds(100);
+    config.collectorPeriods["slow"] = Milliseconds(1000);
+
+    Client* client = &cc();
+    auto first = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(first["fast"]["count"].numberInt(), 1);
+    ASSERT_EQUALS(first["slow"]["count"].numberInt(), 1);
+
+    getMockClock()->advance(Milliseconds(100));
+    auto second = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(second["fast"]["count"].numberInt(), 2);
+    ASSERT_BSONOBJ_EQ(second["slow"].Obj(), first["slow"].Obj());
+
+    getMockClock()->advance(Milliseconds(900));
+    auto third = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(third["fast"]["count"].numberInt(), 3);
+    ASSERT_EQUALS(third["slow"]["count"].numberInt(), 2);
+
+    // Without a configuration, every collector is sampled.
+    auto fourth = std::get<0>(collection.collect(client));
+    ASSERT_EQUALS(fourth["slow"]["count"].numberInt(), 3);
+}
+
+TEST(FTDCCollectorCollectionTest, BlockedAsynchronousCollectorDoesNotDelayOthers) {
+    auto blocking = stdx::make_unique<BlockingCollector>();
+    auto blockingPtr = blocking.get();
+
+    FTDCCollectorCollection collection;
+    collection.add(std::move(blocking), FTDCCollectorCollection::Mode::kAsynchronous);
+    collection.add(stdx::make_unique<CountingCollector>("sync"));
+
+    FTDCConfig config;
+    config.period = Milliseconds(100);
+
+    // The asynchronous collector has no sample to show until its first one is collected.
+    Client* client = &cc();
+    auto first = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(first["sync"]["count"].numberInt(), 1);
+    ASSERT_FALSE(first.hasField("blocking"));
+
+    blockingPtr->release();
+    blockingPtr->waitForFirstSample();
+
+    auto second = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(second["sync"]["count"].numberInt(), 2);
+    ASSERT_GREATER_THAN_OR_EQUALS(second["blocking"]["count"].numberInt(), 1);
+}
+
+TEST(FTDCCollectorCollectionTest, StopWaitsForRunningAsynchronousCollector) {
+    auto blocking = stdx::make_unique<BlockingCollector>();
+    auto blockingPtr = blocking.get();
+
+    FTDCCollectorCollection collection;
+    collection.add(std::move(blocking), FTDCCollectorCollection::Mode::kAsynchronous);
+
+    FTDCConfig config;
+    config.period = Milliseconds(100);
+
+    Client* client = &cc();
+    collection.collect(client, &config);
+    blockingPtr->waitForCollectStarted();
+
+    AtomicBool stopped(false);
+    stdx::thread stopThread([&] {
+        collection.stop();
+        stopped.store(true);
+    });
+
+    sleepmillis(50);
+    ASSERT_FALSE(stopped.load());
+
+    blockingPtr->release();
+    stopThread.join();
+    ASSERT_TRUE(stopped.load());
+    ASSERT_EQUALS(blockingPtr->count(), 1);
+
+    // Once stopped, the collector is not run again and its last sample is repeated.
+    auto sample = std::get<0>(collection.collect(client, &config));
+    ASSERT_EQUALS(sample["blocking"]["count"].numberInt(), 1);
+    ASSERT_EQUALS(blockingPtr->count(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
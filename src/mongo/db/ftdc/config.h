@@ -29,6 +29,8 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
+#include <string>
 
 #include "mongo/util/time_support.h"
 
@@ -83,6 +85,12 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Minimum time between two samples of the periodic collectors named here, for collectors which
+     * are too expensive to run every period. Collectors which are not named run every period.
+     */
+    std::map<std::string, Milliseconds> collectorPeriods;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
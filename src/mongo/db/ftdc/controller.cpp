@@ -81,12 +81,23 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
-void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCController::setCollectorPeriod(StringData name, Milliseconds period) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    if (period <= Milliseconds(0)) {
+        _configTemp.collectorPeriods.erase(name.toString());
+    } else {
+        _configTemp.collectorPeriods[name.toString()] = period;
+    }
+    _condvar.notify_one();
+}
+
+void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                                          FTDCCollectorCollection::Mode mode) {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
         invariant(_state == State::kNotStarted);
 
-        _periodicCollectors.add(std::move(collector));
+        _periodicCollectors.add(std::move(collector), mode);
     }
 }
 
@@ -145,6 +156,10 @@ void FTDCController::stop() {
 
     _thread.join();
 
+    // The asynchronous collectors may still be collecting a sample that the loop stopped waiting
+    // for. Wait for them, so that none runs once shutdown continues past FTDC.
+    _periodicCollectors.stop();
+
     _state = State::kDone;
 
     if (_mgr) {
@@ -206,13 +221,13 @@ void FTDCController::doLoop() {
                 // Delay initialization of FTDCFileManager until we are sure the user has enabled
                 // FTDC
                 if (!_mgr) {
-                    auto swMgr =
-                        FTDCFileManager::create(&_config, _path, &_rotateCollectors, client);
+                    auto swMgr = FTDCFileManager::create(
+                        &_config, _path, &_rotateCollectors, client, &_chunkBuffer);
 
                     _mgr = uassertStatusOK(std::move(swMgr));
                 }
 
-                auto collectSample = _periodicCollectors.collect(client);
+                auto collectSample = _periodicCollectors.collect(client, &_config);
 
                 Status s = _mgr->writeSampleAndRotateIfNeeded(
                     client, std::get<0>(collectSample), std::get<1>(collectSample));
@@ -33,6 +33,7 @@
 #include <memory>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/db/ftdc/chunk_buffer.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/file_manager.h"
@@ -94,10 +95,20 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the minimum time between two samples of the periodic collector 'name'. A period of zero
+     * samples it every period.
+     */
+    void setCollectorPeriod(StringData name, Milliseconds period);
+
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
+     *
+     * An asynchronous collector runs on a thread of its own, so that it cannot delay the others.
      */
-    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+    void addPeriodicCollector(
+        std::unique_ptr<FTDCCollectorInterface> collector,
+        FTDCCollectorCollection::Mode mode = FTDCCollectorCollection::Mode::kSynchronous);
 
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
@@ -130,7 +141,18 @@ public:
      */
     BSONObj getMostRecentPeriodicDocument();
 
+    /**
+     * Get the buffer of the documents most recently written to the diagnostic data files.
+     */
+    FTDCChunkBuffer* getChunkBuffer() {
+        return &_chunkBuffer;
+    }
+
 private:
+    // Number of archived documents kept for getDiagnosticDataChunks. A metric chunk holds the
+    // samples of maxSamplesPerArchiveMetricChunk collection periods, five minutes by default.
+    static constexpr std::size_t kChunkBufferSize = 16;
+
     /**
      * Do periodic statistics collection, and all other work on the background thread.
      */
@@ -195,6 +217,9 @@ private:
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
+    // Recently written documents for getDiagnosticDataChunks
+    FTDCChunkBuffer _chunkBuffer{kChunkBufferSize};
+
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
@@ -51,8 +51,12 @@ namespace mongo {
 
 FTDCFileManager::FTDCFileManager(const FTDCConfig* config,
                                  const boost::filesystem::path& path,
-                                 FTDCCollectorCollection* collection)
-    : _config(config), _writer(_config), _path(path), _rotateCollectors(collection) {}
+                                 FTDCCollectorCollection* collection,
+                                 FTDCChunkBuffer* chunkBuffer)
+    : _config(config),
+      _writer(_config, chunkBuffer),
+      _path(path),
+      _rotateCollectors(collection) {}
 
 FTDCFileManager::~FTDCFileManager() {
     close();
@@ -62,7 +66,8 @@ StatusWith<std::unique_ptr<FTDCFileManager>> FTDCFileManager::create(
     const FTDCConfig* config,
     const boost::filesystem::path& path,
     FTDCCollectorCollection* collection,
-    Client* client) {
+    Client* client,
+    FTDCChunkBuffer* chunkBuffer) {
     const boost::filesystem::path dir = boost::filesystem::absolute(path);
 
     // We don't expect to ever pass "" to create_directories below, but catch
@@ -80,8 +85,8 @@ StatusWith<std::unique_ptr<FTDCFileManager>> FTDCFileManager::create(
         }
     }
 
-    auto mgr =
-        std::unique_ptr<FTDCFileManager>(new FTDCFileManager(config, dir, std::move(collection)));
+    auto mgr = std::unique_ptr<FTDCFileManager>(
+        new FTDCFileManager(config, dir, std::move(collection), chunkBuffer));
 
     // Enumerate the metrics files
     auto files = mgr->scanDirectory();
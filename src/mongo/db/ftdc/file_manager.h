@@ -66,11 +66,15 @@ public:
      *
      * Recovers data from the interim file as needed.
      * Rotates files if needed.
+     *
+     * If 'chunkBuffer' is not null, every document written is also added to it.
      */
-    static StatusWith<std::unique_ptr<FTDCFileManager>> create(const FTDCConfig* config,
-                                                               const boost::filesystem::path& path,
-                                                               FTDCCollectorCollection* collection,
-                                                               Client* client);
+    static StatusWith<std::unique_ptr<FTDCFileManager>> create(
+        const FTDCConfig* config,
+        const boost::filesystem::path& path,
+        FTDCCollectorCollection* collection,
+        Client* client,
+        FTDCChunkBuffer* chunkBuffer = nullptr);
 
     /**
      * Rotates files
@@ -100,7 +104,8 @@ public:
 private:
     FTDCFileManager(const FTDCConfig* config,
                     const boost::filesystem::path& path,
-                    FTDCCollectorCollection* collection);
+                    FTDCCollectorCollection* collection,
+                    FTDCChunkBuffer* chunkBuffer);
 
     /**
      * Gets a list of metrics files in a directory.
@@ -114,6 +114,10 @@ Status FTDCFileWriter::writeInterimFileBuffer(ConstDataRange buf) {
 
     _sizeInterim = buf.length();
 
+    if (_chunkBuffer) {
+        _chunkBuffer->setInterim(BSONObj(buf.data()));
+    }
+
     return Status::OK();
 }
 
@@ -142,6 +146,10 @@ Status FTDCFileWriter::writeArchiveFileBuffer(ConstDataRange buf) {
 
     _size += buf.length();
 
+    if (_chunkBuffer) {
+        _chunkBuffer->addArchived(BSONObj(buf.data()));
+    }
+
     return Status::OK();
 }
 
@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "mongo/base/status.h"
+#include "mongo/db/ftdc/chunk_buffer.h"
 #include "mongo/db/ftdc/compressor.h"
 #include "mongo/db/jsobj.h"
 
@@ -61,7 +62,12 @@ class FTDCFileWriter {
     MONGO_DISALLOW_COPYING(FTDCFileWriter);
 
 public:
-    FTDCFileWriter(const FTDCConfig* config) : _config(config), _compressor(_config) {}
+    /**
+     * If 'chunkBuffer' is not null, every document written to the archive or interim file is also
+     * added to it.
+     */
+    FTDCFileWriter(const FTDCConfig* config, FTDCChunkBuffer* chunkBuffer = nullptr)
+        : _config(config), _chunkBuffer(chunkBuffer), _compressor(_config) {}
     ~FTDCFileWriter();
 
     /**
@@ -119,6 +125,9 @@ private:
     // Config
     const FTDCConfig* const _config;
 
+    // Optional buffer of recently written documents for live readers
+    FTDCChunkBuffer* const _chunkBuffer;
+
     // Archive file name
     boost::filesystem::path _archiveFile;
 
@@ -28,7 +28,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/client.h"
@@ -40,6 +43,33 @@
 namespace mongo {
 namespace {
 
+// Upper bound on how long getDiagnosticDataChunks waits for a new chunk.
+const Milliseconds kMaxAwaitTime = Seconds(60);
+
+/**
+ * The diagnostic data contains serverStatus, replSetGetStatus and the oplog's collStats, so those
+ * who read it need the privileges of all three.
+ */
+Status checkAuthForDiagnosticData(Client* client) {
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forClusterResource(), ActionType::serverStatus)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forClusterResource(), ActionType::replSetGetStatus)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forExactNamespace(NamespaceString("local", "oplog.rs")),
+            ActionType::collStats)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+
+    return Status::OK();
+}
+
 /**
  * Get the most recent document FTDC collected from its periodic collectors.
  *
@@ -68,24 +98,58 @@ public:
     Status checkAuthForCommand(Client* client,
                                const std::string& dbname,
                                const BSONObj& cmdObj) override {
+        return checkAuthForDiagnosticData(client);
+    }
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forClusterResource(), ActionType::serverStatus)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+    bool run(OperationContext* txn,
+             const std::string& db,
+             BSONObj& cmdObj,
+             int options,
+             std::string& errmsg,
+             BSONObjBuilder& result) override {
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forClusterResource(), ActionType::replSetGetStatus)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+        result.append(
+            "data", FTDCController::get(txn->getServiceContext())->getMostRecentPeriodicDocument());
 
-        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
-                ResourcePattern::forExactNamespace(NamespaceString("local", "oplog.rs")),
-                ActionType::collStats)) {
-            return Status(ErrorCodes::Unauthorized, "Unauthorized");
-        }
+        return true;
+    }
+};
 
-        return Status::OK();
+/**
+ * Get the documents FTDC most recently wrote to its diagnostic data files, in the same compressed
+ * format, so that a monitoring tool can follow the metrics FTDC collects as it collects them.
+ *
+ * {getDiagnosticDataChunks: 1, after: <sequence number>, maxAwaitTimeMS: <milliseconds>}
+ *
+ * Returns the archived documents whose sequence numbers are greater than 'after', and the interim
+ * metric chunk, which holds the samples not yet archived, if it is newer. Waits up to
+ * 'maxAwaitTimeMS' for there to be one. 'truncated' is true if some of the requested documents have
+ * already been discarded. Pass 'nextAfter' as 'after' in the next request.
+ */
+class GetDiagnosticDataChunksCommand final : public Command {
+public:
+    GetDiagnosticDataChunksCommand() : Command("getDiagnosticDataChunks") {}
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    void help(std::stringstream& help) const override {
+        help << "get the latest compressed diagnostic data chunks";
+    }
+
+    bool slaveOk() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) override {
+        return checkAuthForDiagnosticData(client);
     }
 
     bool run(OperationContext* txn,
@@ -94,18 +158,57 @@ public:
              int options,
              std::string& errmsg,
              BSONObjBuilder& result) override {
+        long long after;
+        uassertStatusOK(bsonExtractIntegerFieldWithDefault(cmdObj, "after", 0, &after));
+        uassert(40407, "'after' must not be negative", after >= 0);
+
+        long long maxAwaitTimeMS;
+        uassertStatusOK(
+            bsonExtractIntegerFieldWithDefault(cmdObj, "maxAwaitTimeMS", 0, &maxAwaitTimeMS));
+        uassert(40408, "'maxAwaitTimeMS' must not be negative", maxAwaitTimeMS >= 0);
+        const auto awaitTime = std::min(Milliseconds(maxAwaitTimeMS), kMaxAwaitTime);
+
+        auto chunkBuffer = FTDCController::get(txn->getServiceContext())->getChunkBuffer();
+        auto chunks = chunkBuffer->getChunksAfter(
+            txn, static_cast<std::uint64_t>(after), Date_t::now() + awaitTime);
+
+        // Leave the rest for the next request rather than exceed the maximum response size. The
+        // first document is always returned so that the reader makes progress.
+        std::uint64_t nextAfter = after;
+        int size = 0;
+        BSONArrayBuilder chunksBuilder(result.subarrayStart("chunks"));
+        for (auto&& chunk : chunks.archived) {
+            size += chunk.doc.objsize();
+            if (nextAfter != static_cast<std::uint64_t>(after) && size > BSONObjMaxUserSize / 2) {
+                chunks.interim = boost::none;
+                break;
+            }
+            chunksBuilder.append(BSON("seq" << static_cast<long long>(chunk.sequence) << "doc"
+                                            << chunk.doc));
+            nextAfter = chunk.sequence;
+        }
+        chunksBuilder.doneFast();
 
-        result.append(
-            "data", FTDCController::get(txn->getServiceContext())->getMostRecentPeriodicDocument());
+        if (chunks.interim) {
+            result.append("interim",
+                          BSON("seq" << static_cast<long long>(chunks.interim->sequence) << "doc"
+                                     << chunks.interim->doc));
+            nextAfter = chunks.interim->sequence;
+        }
+
+        result.append("nextAfter", static_cast<long long>(nextAfter));
+        result.append("truncated", chunks.truncated);
 
         return true;
     }
 };
 
 Command* ftdcCommand;
+Command* ftdcChunksCommand;
 
 MONGO_INITIALIZER(CreateDiagnosticDataCommand)(InitializerContext* context) {
     ftdcCommand = new GetDiagnosticDataCommand();
+    ftdcChunksCommand = new GetDiagnosticDataChunksCommand();
 
     return Status::OK();
 }
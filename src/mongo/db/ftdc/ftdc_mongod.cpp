@@ -113,6 +113,41 @@ public:
 
 } exportedFTDCPeriodParameter;
 
+// The periodic collectors which are expensive enough, or take locks which may be held for long
+// enough, that they are worth sampling less often than the rest.
+const StringData kSlowCollectorNames[] = {"replSetGetStatus"_sd, "local.oplog.rs.stats"_sd};
+
+// 0 samples the slow collectors every period like the others.
+AtomicInt32 localSlowPeriodMillis(0);
+
+class ExportedFTDCSlowPeriodParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCSlowPeriodParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionSlowPeriodMillis",
+              &localSlowPeriodMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue != 0 && potentialNewValue < 100) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionSlowPeriodMillis must be 0 or greater than or "
+                          "equal to 100ms");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            for (auto&& name : kSlowCollectorNames) {
+                controller->setCollectorPeriod(name, Milliseconds(potentialNewValue));
+            }
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCSlowPeriodParameter;
+
 // Scale the values down since are defaults are in bytes, but the user interface is MB
 AtomicInt32 localMaxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024));
 
@@ -299,11 +334,18 @@ void startFTDC() {
     config.maxDirectorySizeBytes = localMaxDirectorySizeMB.load() * 1024 * 1024;
     config.maxSamplesPerArchiveMetricChunk = localMaxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk = localMaxSamplesPerInterimMetricChunk.load();
+    if (localSlowPeriodMillis.load() > 0) {
+        for (auto&& name : kSlowCollectorNames) {
+            config.collectorPeriods[name.toString()] = Milliseconds(localSlowPeriodMillis.load());
+        }
+    }
 
     auto controller = stdx::make_unique<FTDCController>(dir, config);
 
     // Install periodic collectors
-    // These are collected on the period interval in FTDCConfig.
+    // These are collected on the period interval in FTDCConfig, except for the ones in
+    // kSlowCollectorNames when diagnosticDataCollectionSlowPeriodMillis is set. The commands run
+    // asynchronously, so that one blocked behind a lock does not hold up the others.
     // NOTE: For each command here, there must be an equivalent privilege check in
     // GetDiagnosticDataCommand
 
@@ -312,18 +354,22 @@ void startFTDC() {
     // migration status. This section triggers too many schema changes in the serverStatus which
     // hurt ftdc compression efficiency, because its output varies depending on the list of active
     // migrations.
-    controller->addPeriodicCollector(stdx::make_unique<FTDCSimpleInternalCommandCollector>(
-        "serverStatus",
-        "serverStatus",
-        "",
-        BSON("serverStatus" << 1 << "tcMalloc" << true << "sharding" << false)));
+    controller->addPeriodicCollector(
+        stdx::make_unique<FTDCSimpleInternalCommandCollector>(
+            "serverStatus",
+            "serverStatus",
+            "",
+            BSON("serverStatus" << 1 << "tcMalloc" << true << "sharding" << false)),
+        FTDCCollectorCollection::Mode::kAsynchronous);
 
     // These metrics are only collected if replication is enabled
     if (repl::getGlobalReplicationCoordinator()->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
         // CmdReplSetGetStatus
-        controller->addPeriodicCollector(stdx::make_unique<FTDCSimpleInternalCommandCollector>(
-            "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)));
+        controller->addPeriodicCollector(
+            stdx::make_unique<FTDCSimpleInternalCommandCollector>(
+                "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)),
+            FTDCCollectorCollection::Mode::kAsynchronous);
 
         // CollectionStats
         controller->addPeriodicCollector(
@@ -331,7 +377,8 @@ void startFTDC() {
                                                                   "local.oplog.rs.stats",
                                                                   "local",
                                                                   BSON("collStats"
-                                                                       << "oplog.rs")));
+                                                                       << "oplog.rs")),
+            FTDCCollectorCollection::Mode::kAsynchronous);
     }
 
     // Install System Metric Collector as a periodic collector
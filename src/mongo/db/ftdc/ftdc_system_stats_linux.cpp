@@ -26,6 +26,8 @@
  * then also delete it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kFTDC
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/ftdc/ftdc_system_stats.h"
@@ -38,7 +40,10 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+#include "mongo/util/perf_event_collect.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/procparser.h"
 
@@ -46,6 +51,18 @@ namespace mongo {
 
 namespace {
 
+// Hardware counters slow down context switches a little, and use file descriptors, so they are
+// only collected when asked for.
+bool diagnosticDataCollectionEnablePerfEvents = false;
+
+ExportedServerParameter<bool, ServerParameterType::kStartupOnly> perfEventsParameter(
+    ServerParameterSet::getGlobal(),
+    "diagnosticDataCollectionEnablePerfEvents",
+    &diagnosticDataCollectionEnablePerfEvents);
+
+// Each thread counted uses one file descriptor per event.
+const std::size_t kMaxPerfEventThreads = 512;
+
 static const std::vector<StringData> kCpuKeys{
     "btime"_sd, "cpu"_sd, "ctxt"_sd, "processes"_sd, "procs_blocked"_sd, "procs_running"_sd};
 
@@ -71,7 +88,9 @@ static const std::vector<StringData> kMemKeys{
  */
 class LinuxSystemMetricsCollector final : public SystemMetricsCollector {
 public:
-    LinuxSystemMetricsCollector() : _disks(procparser::findPhysicalDisks("/sys/block"_sd)) {
+    LinuxSystemMetricsCollector(std::unique_ptr<PerfEventCollector> perfEvents)
+        : _disks(procparser::findPhysicalDisks("/sys/block"_sd)),
+          _perfEvents(std::move(perfEvents)) {
         for (const auto& disk : _disks) {
             _disksStringData.emplace_back(disk);
         }
@@ -108,6 +127,12 @@ public:
                                 &subObjBuilder);
             subObjBuilder.doneFast();
         }
+
+        if (_perfEvents) {
+            BSONObjBuilder subObjBuilder(builder.subobjStart("perf"_sd));
+            processStatusErrors(_perfEvents->collect(&subObjBuilder), &subObjBuilder);
+            subObjBuilder.doneFast();
+        }
     }
 
 private:
@@ -116,12 +141,27 @@ private:
 
     // List of physical disks to collect stats from as StringData to pass to parseProcDiskStatsFile.
     std::vector<StringData> _disksStringData;
+
+    // Hardware performance counters by thread category, if enabled.
+    std::unique_ptr<PerfEventCollector> _perfEvents;
 };
 
 }  // namespace
 
 void installSystemMetricsCollector(FTDCController* controller) {
-    controller->addPeriodicCollector(stdx::make_unique<LinuxSystemMetricsCollector>());
+    std::unique_ptr<PerfEventCollector> perfEvents;
+    if (diagnosticDataCollectionEnablePerfEvents) {
+        auto swPerfEvents = PerfEventCollector::create(kMaxPerfEventThreads);
+        if (swPerfEvents.isOK()) {
+            perfEvents = std::move(swPerfEvents.getValue());
+        } else {
+            warning() << "Failed to start collecting hardware performance counters: "
+                      << swPerfEvents.getStatus();
+        }
+    }
+
+    controller->addPeriodicCollector(
+        stdx::make_unique<LinuxSystemMetricsCollector>(std::move(perfEvents)));
 }
 
 }  // namespace mongo
@@ -91,6 +91,12 @@ public:
      */
     virtual Status parse(TextIndexVersion textIndexVersion) = 0;
 
+    /**
+     * Returns true if the parsed query looks up a single term in the text index. The index scan
+     * for that term returns documents in descending order of text score.
+     */
+    virtual bool hasSingleTermForBounds() const = 0;
+
     /**
      * Returns a copy of this FTSQuery.
      */
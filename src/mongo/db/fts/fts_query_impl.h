@@ -65,6 +65,10 @@ public:
         return _termsForBounds;
     }
 
+    bool hasSingleTermForBounds() const final {
+        return _termsForBounds.size() == 1;
+    }
+
     /**
      * Returns a BSON object with the following format:
      * {
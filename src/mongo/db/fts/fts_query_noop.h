@@ -42,6 +42,10 @@ public:
         return Status::OK();
     }
 
+    bool hasSingleTermForBounds() const final {
+        return false;
+    }
+
     std::unique_ptr<FTSQuery> clone() const final;
 };
 
@@ -77,6 +77,19 @@ void String::resetData(const StringData utf8_src) {
 }
 
 void String::setData(const StringData utf8_src) {
+    // Most text is ASCII, where every byte is its own codepoint. Like copyString8to32, stop at the
+    // first null byte.
+    size_t asciiLen = 0;
+    while (asciiLen < utf8_src.size() && utf8_src[asciiLen] != '\0' &&
+           static_cast<unsigned char>(utf8_src[asciiLen]) <= 0x7f) {
+        ++asciiLen;
+    }
+    if (asciiLen == utf8_src.size() || utf8_src[asciiLen] == '\0') {
+        _data.assign(utf8_src.begin(), utf8_src.begin() + asciiLen);
+        _needsOutputConversion = true;
+        return;
+    }
+
     // _data is the target, resize it so that it's guaranteed to fit all of the input characters,
     // plus a null character if there isn't one.
     _data.resize(utf8_src.size() + 1);
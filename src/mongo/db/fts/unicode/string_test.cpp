@@ -80,6 +80,17 @@ TEST(UnicodeString, SubstrTest) {
     ASSERT_EQ("", indexes.substrToBuf(&buf, 1, 0));   // len == 0.
 }
 
+TEST(UnicodeString, ASCIIStopsAtNullByte) {
+    StackBufBuilder buf;
+    String ascii(StringData("abc\0def", 7));
+    ASSERT_EQ(3U, ascii.size());
+    ASSERT_EQ("abc", ascii.substrToBuf(&buf, 0, 7));
+
+    std::string nonASCII = std::string(UTF8("é")) + std::string("\0def", 4);
+    String mixed(nonASCII);
+    ASSERT_EQ(1U, mixed.size());
+}
+
 TEST(UnicodeString, RemoveDiacritics) {
     // Test all ascii chars.
     for (unsigned char ch = 0; ch <= 0x7F; ch++) {
@@ -115,6 +115,18 @@ inline static long long mask64For(const int i) {
     return 1LL << (63 - i);
 }
 
+// Spreads the 32 bits of 'val' over the even bits of the result, so that bit i of 'val' ends up
+// at bit 2 * i. Used to interleave x and y into a GeoHash without looping over each bit.
+inline static unsigned long long spreadBits(unsigned val) {
+    unsigned long long v = val;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2)) & 0x3333333333333333ULL;
+    v = (v | (v << 1)) & 0x5555555555555555ULL;
+    return v;
+}
+
 // copyAndReverse is used to reverse the order of bytes when copying between BinData and GeoHash.
 // GeoHashes are meant to be compared from MSB to LSB, where the first 2 MSB indicate the quadrant.
 // In BinData, the GeoHash of a 2D index is compared from LSB to MSB, so the bytes should be
@@ -156,14 +168,12 @@ void GeoHash::initFromString(const char* s) {
 
 GeoHash::GeoHash(unsigned x, unsigned y, unsigned bits) {
     verify(bits <= 32);
-    _hash = 0;
     _bits = bits;
-    for (unsigned i = 0; i < bits; i++) {
-        if (isBitSet(x, i))
-            _hash |= mask64For(i * 2);
-        if (isBitSet(y, i))
-            _hash |= mask64For((i * 2) + 1);
-    }
+
+    // Only the 'bits' most significant bits of x and y are part of the hash. Each x bit lands on
+    // the higher bit of its pair, so that x bit 31 becomes hash bit 63 and y bit 31 hash bit 62.
+    const unsigned usedMask = bits == 0 ? 0 : ~0U << (32 - bits);
+    _hash = static_cast<long long>((spreadBits(x & usedMask) << 1) | spreadBits(y & usedMask));
 }
 
 GeoHash::GeoHash(const GeoHash& old) {
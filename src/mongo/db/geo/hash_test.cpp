@@ -147,6 +147,23 @@ TEST(GeoHash, UnhashFastMatchesUnhashSlow) {
     }
 }
 
+// The interleaved hash of (x, y) must match setting each bit one at a time, for every precision.
+TEST(GeoHash, InterleaveMatchesBitByBit) {
+    mongo::PseudoRandom random(12345);
+    for (int i = 0; i < 1000; i++) {
+        unsigned x = static_cast<unsigned>(random.nextInt32());
+        unsigned y = static_cast<unsigned>(random.nextInt32());
+        for (unsigned bits = 0; bits <= 32; bits++) {
+            string expected;
+            for (unsigned bit = 0; bit < bits; bit++) {
+                expected += GeoHash::isBitSet(x, bit) ? '1' : '0';
+                expected += GeoHash::isBitSet(y, bit) ? '1' : '0';
+            }
+            ASSERT_EQUALS(GeoHash(expected), GeoHash(x, y, bits));
+        }
+    }
+}
+
 TEST(GeoHashConvertor, EdgeLength) {
     const double kError = 10E-15;
     GeoHashConverter::Parameters params;
@@ -34,6 +34,7 @@
 
 #include "mongo/db/hasher.h"
 
+#include <cstring>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
@@ -128,10 +129,42 @@ struct HasherUnitTest : public StartupTest {
 }  // namespace
 
 long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
-    Hasher h(seed);
-    recursiveHash(&h, e, false);
     HashDigest d;
-    h.finish(d);
+
+    // Most hashed keys are short scalars such as ObjectIds, numbers and small strings. For
+    // those, lay out exactly the bytes recursiveHash() would feed to MD5 and hash them with a
+    // single md5_append, which saves the per-call overhead of the three separate appends.
+    const size_t kMaxInlineValueSize = 64;
+    const size_t valueSize = e.isNumber() ? sizeof(long long) : e.valuesize();
+    if (!e.mayEncapsulate() && valueSize <= kMaxInlineValueSize) {
+        char buf[sizeof(HashSeed) + sizeof(int) + kMaxInlineValueSize];
+        char* p = buf;
+
+        std::memcpy(p, &seed, sizeof(seed));
+        p += sizeof(seed);
+
+        const int canonicalType = endian::nativeToLittle(e.canonicalType());
+        std::memcpy(p, &canonicalType, sizeof(canonicalType));
+        p += sizeof(canonicalType);
+
+        if (e.isNumber()) {
+            // Use safeNumberLong, it is well-defined for troublesome doubles.
+            const auto i = endian::nativeToLittle(e.safeNumberLong());
+            std::memcpy(p, &i, sizeof(i));
+        } else {
+            std::memcpy(p, e.value(), valueSize);
+        }
+        p += valueSize;
+
+        md5_state_t st;
+        md5_init(&st);
+        md5_append(&st, reinterpret_cast<const md5_byte_t*>(buf), p - buf);
+        md5_finish(&st, d);
+    } else {
+        Hasher h(seed);
+        recursiveHash(&h, e, false);
+        h.finish(d);
+    }
     // HashDigest is actually 16 bytes, but we just read 8 bytes
     ConstDataView digestView(reinterpret_cast<const char*>(d));
     return digestView.read<LittleEndian<long long int>>();
@@ -32,6 +32,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -46,6 +47,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/util/log.h"
 #include "mongo/util/progress_meter.h"
@@ -174,6 +176,74 @@ Status IndexAccessMethod::insert(OperationContext* txn,
     return ret;
 }
 
+Status IndexAccessMethod::insertMany(OperationContext* txn,
+                                     const std::vector<BsonRecord>& bsonRecords,
+                                     const InsertDeleteOptions& options,
+                                     int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+
+    struct KeyToInsert {
+        BSONObj key;
+        RecordId loc;
+        size_t docIndex;
+    };
+
+    std::vector<KeyToInsert> keysToInsert;
+    keysToInsert.reserve(bsonRecords.size());
+    std::vector<MultikeyPaths> multikeyPaths(bsonRecords.size());
+    for (size_t docIndex = 0; docIndex < bsonRecords.size(); ++docIndex) {
+        const BsonRecord& bsonRecord = bsonRecords[docIndex];
+        invariant(bsonRecord.id != RecordId());
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        // Delegate to the subclass.
+        getKeys(*bsonRecord.docPtr, options.getKeysMode, &keys, &multikeyPaths[docIndex]);
+        for (const auto& key : keys) {
+            keysToInsert.push_back({key, bsonRecord.id, docIndex});
+        }
+    }
+
+    const Ordering& ordering = _btreeState->ordering();
+    std::sort(keysToInsert.begin(),
+              keysToInsert.end(),
+              [&ordering](const KeyToInsert& lhs, const KeyToInsert& rhs) {
+                  int cmp = lhs.key.woCompare(rhs.key, ordering, false);
+                  return cmp != 0 ? cmp < 0 : lhs.loc < rhs.loc;
+              });
+
+    std::vector<int64_t> numInsertedPerDoc(bsonRecords.size(), 0);
+    for (const auto& keyToInsert : keysToInsert) {
+        Status status =
+            _newInterface->insert(txn, keyToInsert.key, keyToInsert.loc, options.dupsAllowed);
+
+        if (status.isOK()) {
+            ++numInsertedPerDoc[keyToInsert.docIndex];
+            ++*numInserted;
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(txn)) {
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::DuplicateKeyValue && !_btreeState->isReady(txn)) {
+            LOG(3) << "key " << keyToInsert.key
+                   << " already in index during background indexing (ok)";
+            continue;
+        }
+
+        return status;
+    }
+
+    for (size_t docIndex = 0; docIndex < bsonRecords.size(); ++docIndex) {
+        if (numInsertedPerDoc[docIndex] > 1 || isMultikeyFromPaths(multikeyPaths[docIndex])) {
+            _btreeState->setMultikey(txn, multikeyPaths[docIndex]);
+        }
+    }
+
+    return Status::OK();
+}
+
 void IndexAccessMethod::removeOneKey(OperationContext* txn,
                                      const BSONObj& key,
                                      const RecordId& loc,
@@ -302,14 +372,20 @@ pair<vector<BSONObj>, vector<BSONObj>> IndexAccessMethod::setDifference(const BS
     vector<BSONObj> onlyRight;
 
     while (leftIt != left.end() && rightIt != right.end()) {
+        // Most updates leave most keys untouched, and identical keys are found with a memcmp
+        // alone, without walking the elements of both keys in woCompare().
+        if (leftIt->binaryEqual(*rightIt)) {
+            ++leftIt;
+            ++rightIt;
+            continue;
+        }
+
         const int cmp = leftIt->woCompare(*rightIt);
         if (cmp == 0) {
-            // 'leftIt' and 'rightIt' compare equal using woCompare(), but may not be identical,
+            // 'leftIt' and 'rightIt' compare equal using woCompare(), but are not identical,
             // which should result in an index change.
-            if (!leftIt->binaryEqual(*rightIt)) {
-                onlyLeft.push_back(*leftIt);
-                onlyRight.push_back(*rightIt);
-            }
+            onlyLeft.push_back(*leftIt);
+            onlyRight.push_back(*rightIt);
             ++leftIt;
             ++rightIt;
             continue;
@@ -404,18 +480,21 @@ Status IndexAccessMethod::compact(OperationContext* txn) {
 }
 
 std::unique_ptr<IndexAccessMethod::BulkBuilder> IndexAccessMethod::initiateBulk(
-    size_t maxMemoryUsageBytes) {
-    return std::unique_ptr<BulkBuilder>(new BulkBuilder(this, _descriptor, maxMemoryUsageBytes));
+    size_t maxMemoryUsageBytes, size_t maxSortThreads) {
+    return std::unique_ptr<BulkBuilder>(
+        new BulkBuilder(this, _descriptor, maxMemoryUsageBytes, maxSortThreads));
 }
 
 IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
                                             const IndexDescriptor* descriptor,
-                                            size_t maxMemoryUsageBytes)
+                                            size_t maxMemoryUsageBytes,
+                                            size_t maxSortThreads)
     : _sorter(Sorter::make(
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .MaxSortThreads(maxSortThreads),
           BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
       _real(index) {}
 
@@ -454,6 +533,10 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* txn,
     return Status::OK();
 }
 
+void IndexAccessMethod::BulkBuilder::sort() {
+    invariant(!_sortedKeys);
+    _sortedKeys.reset(_sorter->done());
+}
 
 Status IndexAccessMethod::commitBulk(OperationContext* txn,
                                      std::unique_ptr<BulkBuilder> bulk,
@@ -462,7 +545,10 @@ Status IndexAccessMethod::commitBulk(OperationContext* txn,
                                      set<RecordId>* dupsToDrop) {
     Timer timer;
 
-    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(bulk->_sorter->done());
+    if (!bulk->_sortedKeys) {
+        bulk->sort();
+    }
+    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(std::move(bulk->_sortedKeys));
 
     stdx::unique_lock<Client> lk(*txn->getClient());
     ProgressMeterHolder pm(*txn->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
@@ -47,6 +47,7 @@ extern AtomicBool failIndexKeyTooLong;
 class BSONObjBuilder;
 class MatchExpression;
 class UpdateTicket;
+struct BsonRecord;
 struct InsertDeleteOptions;
 
 /**
@@ -84,6 +85,19 @@ public:
                   const InsertDeleteOptions& options,
                   int64_t* numInserted);
 
+    /**
+     * Like insert(), but for a batch of documents. The keys of all the documents are generated
+     * up front and inserted in index order, which keeps the index writes of a large batch close
+     * together. 'numInserted' will be set to the number of keys added for the whole batch.
+     *
+     * On error, keys of the batch may remain in the index. The caller is expected to roll back
+     * its WriteUnitOfWork.
+     */
+    Status insertMany(OperationContext* txn,
+                      const std::vector<BsonRecord>& bsonRecords,
+                      const InsertDeleteOptions& options,
+                      int64_t* numInserted);
+
     /**
      * Analogous to above, but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
@@ -207,6 +221,14 @@ public:
                       const InsertDeleteOptions& options,
                       int64_t* numInserted);
 
+        /**
+         * Sorts all of the keys inserted so far, after which no more keys may be inserted. This
+         * only touches this BulkBuilder's own state and does not use an OperationContext, so
+         * the sorts for several indexes being built together may run on separate threads.
+         * commitBulk() sorts the keys itself if this has not been called.
+         */
+        void sort();
+
     private:
         friend class IndexAccessMethod;
 
@@ -214,9 +236,11 @@ public:
 
         BulkBuilder(const IndexAccessMethod* index,
                     const IndexDescriptor* descriptor,
-                    size_t maxMemoryUsageBytes);
+                    size_t maxMemoryUsageBytes,
+                    size_t maxSortThreads);
 
         std::unique_ptr<Sorter> _sorter;
+        std::unique_ptr<Sorter::Iterator> _sortedKeys;  // set by sort()
         const IndexAccessMethod* _real;
         int64_t _keysInserted = 0;
 
@@ -238,8 +262,10 @@ public:
      *
      * maxMemoryUsageBytes: amount of memory consumed before the external sorter starts spilling to
      *                      disk
+     * maxSortThreads: number of threads the external sorter may use to sort each batch of keys
      */
-    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes);
+    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes,
+                                              size_t maxSortThreads = 1);
 
     /**
      * Call this when you are ready to finish your bulk work.
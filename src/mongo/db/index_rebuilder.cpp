@@ -55,20 +55,28 @@ using std::string;
 using std::vector;
 
 namespace {
-void checkNS(OperationContext* txn, const std::list<std::string>& nsToCheck) {
-    bool firstTime = true;
+/**
+ * Checks the collections 'nsToCheck' of database 'dbName', and rebuilds any indexes whose build
+ * was interrupted by the last shutdown. 'firstTime' is cleared once the note about
+ * --noIndexBuildRetry has been logged.
+ */
+void checkNS(OperationContext* txn,
+             const std::string& dbName,
+             const std::list<std::string>& nsToCheck,
+             bool* firstTime) {
+    // This write lock is held throughout the index building process for all the collections of
+    // this database. Nothing else runs yet, so there is no point in taking it per collection,
+    // which gets costly for databases with very many collections.
+    ScopedTransaction transaction(txn, MODE_IX);
+    Lock::DBLock lk(txn->lockState(), dbName, MODE_X);
+    OldClientContext ctx(txn, dbName, false /* no shard version check */);
+
     for (std::list<std::string>::const_iterator it = nsToCheck.begin(); it != nsToCheck.end();
          ++it) {
         string ns = *it;
 
         LOG(3) << "IndexRebuilder::checkNS: " << ns;
 
-        // This write lock is held throughout the index building process
-        // for this namespace.
-        ScopedTransaction transaction(txn, MODE_IX);
-        Lock::DBLock lk(txn->lockState(), nsToDatabaseSubstring(ns), MODE_X);
-        OldClientContext ctx(txn, ns);
-
         Collection* collection = ctx.db()->getCollection(ns);
         if (collection == NULL)
             continue;
@@ -81,6 +89,10 @@ void checkNS(OperationContext* txn, const std::list<std::string>& nsToCheck) {
             continue;
         }
 
+        if (!indexCatalog->hasUnfinishedIndexes()) {
+            continue;
+        }
+
 
         MultiIndexBlock indexer(txn, collection);
 
@@ -102,10 +114,10 @@ void checkNS(OperationContext* txn, const std::list<std::string>& nsToCheck) {
 
             log() << "found " << indexesToBuild.size() << " interrupted index build(s) on " << ns;
 
-            if (firstTime) {
+            if (*firstTime) {
                 log() << "note: restart the server with --noIndexBuildRetry "
                       << "to skip index rebuilds";
-                firstTime = false;
+                *firstTime = false;
             }
 
             if (!serverGlobalParams.indexBuildRetry) {
@@ -151,17 +163,20 @@ void restartInProgressIndexesFromLastShutdown(OperationContext* txn) {
     storageEngine->listDatabases(&dbNames);
 
     try {
-        std::list<std::string> collNames;
+        bool firstTime = true;
         for (std::vector<std::string>::const_iterator dbName = dbNames.begin();
              dbName < dbNames.end();
              ++dbName) {
-            ScopedTransaction scopedXact(txn, MODE_IS);
-            AutoGetDb autoDb(txn, *dbName, MODE_S);
+            std::list<std::string> collNames;
+            {
+                ScopedTransaction scopedXact(txn, MODE_IS);
+                AutoGetDb autoDb(txn, *dbName, MODE_S);
 
-            Database* db = autoDb.getDb();
-            db->getDatabaseCatalogEntry()->getCollectionNamespaces(&collNames);
+                Database* db = autoDb.getDb();
+                db->getDatabaseCatalogEntry()->getCollectionNamespaces(&collNames);
+            }
+            checkNS(txn, *dbName, collNames, &firstTime);
         }
-        checkNS(txn, collNames);
     } catch (const DBException& e) {
         error() << "Index verification did not complete: " << redact(e);
         fassertFailedNoTrace(18643);
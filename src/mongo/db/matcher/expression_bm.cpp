@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    auto expr =
+        MatchExpressionParser::parse(query, ExtensionsCallbackDisallowExtensions(), nullptr);
+    invariantOK(expr.getStatus());
+    return std::move(expr.getValue());
+}
+
+std::vector<BSONObj> makeDocuments() {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 64; ++i) {
+        docs.push_back(BSON("_id" << i << "status" << (i % 2 ? "active" : "inactive") << "score"
+                                  << i * 1.5
+                                  << "tags"
+                                  << BSON_ARRAY("a"
+                                                << "b"
+                                                << (i % 4 ? "c" : "d"))
+                                  << "address"
+                                  << BSON("city"
+                                          << "Dublin"
+                                          << "zip"
+                                          << i)));
+    }
+    return docs;
+}
+
+/**
+ * Returns the query chosen by 'kind': 0 for an equality, 1 for a conjunction of ranges, 2 for a
+ * disjunction, 3 for a dotted path and an array element match.
+ */
+BSONObj makeQuery(std::int64_t kind) {
+    switch (kind) {
+        case 0:
+            return BSON("status"
+                        << "active");
+        case 1:
+            return BSON("score" << BSON("$gte" << 10 << "$lt" << 60) << "_id" << BSON("$ne" << 7));
+        case 2:
+            return BSON("$or" << BSON_ARRAY(BSON("status"
+                                                 << "inactive")
+                                            << BSON("score" << BSON("$gt" << 80))));
+        default:
+            return BSON("address.zip" << BSON("$lt" << 32) << "tags"
+                                      << BSON("$in" << BSON_ARRAY("d"
+                                                                  << "e")));
+    }
+}
+
+void BM_matchExpressionParse(benchmark::State& state) {
+    const BSONObj query = makeQuery(state.arg());
+    while (state.keepRunning()) {
+        auto expr = parse(query);
+        benchmark::doNotOptimize(expr.get());
+    }
+}
+MONGO_BENCHMARK(BM_matchExpressionParse)->arg(0)->arg(1)->arg(2)->arg(3);
+
+void BM_matchExpressionMatches(benchmark::State& state) {
+    const auto expr = parse(makeQuery(state.arg()));
+    const auto docs = makeDocuments();
+    while (state.keepRunning()) {
+        for (auto&& doc : docs) {
+            benchmark::doNotOptimize(expr->matchesBSON(doc));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * docs.size());
+}
+MONGO_BENCHMARK(BM_matchExpressionMatches)->arg(0)->arg(1)->arg(2)->arg(3);
+
+}  // namespace
+}  // namespace mongo
@@ -556,6 +556,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
     next->_originalEqualityVector = _originalEqualityVector;
+    next->updateEqualityHashSet();
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -568,7 +569,11 @@ bool InMatchExpression::matchesSingleElement(const BSONElement& e) const {
     if (_hasNull && e.eoo()) {
         return true;
     }
-    if (_equalitySet.find(e) != _equalitySet.end()) {
+    if (_equalityHashSet) {
+        if (_equalityHashSet->count(e)) {
+            return true;
+        }
+    } else if (_equalitySet.find(e) != _equalitySet.end()) {
         return true;
     }
     for (auto&& regex : _regexes) {
@@ -661,6 +666,22 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     BSONElementSet equalitiesWithNewComparator(
         _originalEqualityVector.begin(), _originalEqualityVector.end(), collator);
     _equalitySet = std::move(equalitiesWithNewComparator);
+    updateEqualityHashSet();
+}
+
+void InMatchExpression::updateEqualityHashSet() {
+    if (_equalitySet.size() < kMinEqualitiesForHashLookup) {
+        _equalityHashSet.reset();
+        _equalityHashSetComparator.reset();
+        return;
+    }
+
+    _equalityHashSetComparator = stdx::make_unique<BSONElementComparator>(
+        BSONElementComparator::FieldNamesMode::kIgnore, _collator);
+    _equalityHashSet = stdx::make_unique<BSONEltUnorderedSet>(
+        _equalityHashSetComparator->makeBSONEltUnorderedSet());
+    _equalityHashSet->reserve(_equalitySet.size());
+    _equalityHashSet->insert(_equalitySet.begin(), _equalitySet.end());
 }
 
 Status InMatchExpression::addEquality(const BSONElement& elt) {
@@ -679,6 +700,11 @@ Status InMatchExpression::addEquality(const BSONElement& elt) {
     }
     _equalitySet.insert(elt);
     _originalEqualityVector.push_back(elt);
+    if (_equalityHashSet) {
+        _equalityHashSet->insert(elt);
+    } else if (_equalitySet.size() >= kMinEqualitiesForHashLookup) {
+        updateEqualityHashSet();
+    }
     return Status::OK();
 }
 
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -374,6 +375,15 @@ public:
     }
 
 private:
+    // $in lists with at least this many equalities are matched through a hash set.
+    static const size_t kMinEqualitiesForHashLookup = 16;
+
+    /**
+     * Rebuilds '_equalityHashSet' from '_equalitySet' if the list is long enough to be matched
+     * through a hash set, or discards it otherwise.
+     */
+    void updateEqualityHashSet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -391,6 +401,11 @@ private:
     // '_equalitySet' in case '_collator' changes after elements have been added.
     std::vector<BSONElement> _originalEqualityVector;
 
+    // Hash-based copy of '_equalitySet', used for lookups in long lists. Null for short lists.
+    // Its equivalence classes are given by '_equalityHashSetComparator', which uses '_collator'.
+    std::unique_ptr<BSONElementComparator> _equalityHashSetComparator;
+    std::unique_ptr<BSONEltUnorderedSet> _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
@@ -1735,6 +1735,50 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.getEqualities().count(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, MatchesElementInLongList) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 1000; i += 2) {
+        operandBuilder.append(i);
+    }
+    BSONArray operand = operandBuilder.arr();
+
+    InMatchExpression in;
+    for (auto&& elt : operand) {
+        in.addEquality(elt);
+    }
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 998LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 500.0)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 501)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "0")["a"]));
+    ASSERT(!in.matchesSingleElement(BSONObj().firstElement()));
+}
+
+TEST(InMatchExpression, LongListStringMatchingRespectsCollation) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 100; ++i) {
+        operandBuilder.append(std::to_string(i));
+    }
+    BSONArray operand = operandBuilder.arr();
+    BSONObj match = BSON("a"
+                         << "string");
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    InMatchExpression in;
+    for (auto&& elt : operand) {
+        in.addEquality(elt);
+    }
+    ASSERT(!in.matchesSingleElement(match["a"]));
+
+    in.setCollator(&collator);
+    ASSERT(in.matchesSingleElement(match["a"]));
+
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(match["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -30,11 +30,15 @@
 
 #include "mongo/db/matcher/matchable.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/platform/basic.h"
 
 namespace mongo {
 
-BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMatchPathsBeforeCachingFields, int, 2);
+
+BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj)
+    : _obj(obj), _pathsBeforeCachingFields(internalQueryMatchPathsBeforeCachingFields.load()) {
     _iteratorUsed = false;
 }
 
@@ -30,9 +30,13 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/memory.h"
 
 namespace mongo {
 
@@ -74,6 +78,19 @@ public:
     };
 };
 
+// How many paths a BSONMatchableDocument looks up by scanning its document before it resolves all
+// of the document's top-level fields at once. Indexing the fields takes a full scan and a sort,
+// while a getField() scan stops at the field it finds, so the best value depends on the width of
+// the documents and the position of the queried fields in them.
+extern AtomicInt32 internalQueryMatchPathsBeforeCachingFields;
+
+/**
+ * A MatchableDocument over a BSONObj.
+ *
+ * Once enough paths have been looked up in the same document, which happens when several
+ * predicates of one MatchExpression are evaluated against it, its top-level fields are all
+ * resolved in one pass and later lookups start from that cache.
+ */
 class BSONMatchableDocument : public MatchableDocument {
 public:
     BSONMatchableDocument(const BSONObj& obj);
@@ -84,10 +101,13 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
+        if (!_topLevelFields && ++_numIteratorsAllocated > _pathsBeforeCachingFields) {
+            _topLevelFields = stdx::make_unique<TopLevelFieldCache>(_obj);
+        }
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, _topLevelFields.get());
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, _topLevelFields.get());
         return &_iterator;
     }
 
@@ -103,5 +123,10 @@ private:
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    // Read from internalQueryMatchPathsBeforeCachingFields on construction.
+    const int _pathsBeforeCachingFields;
+    mutable int _numIteratorsAllocated = 0;
+    mutable std::unique_ptr<TopLevelFieldCache> _topLevelFields;
 };
 }
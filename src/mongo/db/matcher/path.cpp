@@ -29,6 +29,9 @@
  */
 
 #include "mongo/db/matcher/path.h"
+
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/path_internal.h"
 #include "mongo/platform/basic.h"
@@ -59,6 +62,36 @@ void ElementIterator::Context::reset(BSONElement element,
 }
 
 
+// ------
+
+namespace {
+
+bool fieldNameLessThan(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.fieldNameStringData() < rhs.fieldNameStringData();
+}
+
+}  // namespace
+
+TopLevelFieldCache::TopLevelFieldCache(const BSONObj& obj) {
+    for (auto&& elt : obj) {
+        _fields.push_back(elt);
+    }
+    // Stable, so that the first of several fields with the same name is the one found, just as
+    // with BSONObj::getField().
+    std::stable_sort(_fields.begin(), _fields.end(), fieldNameLessThan);
+}
+
+BSONElement TopLevelFieldCache::getField(StringData name) const {
+    auto it = std::lower_bound(
+        _fields.begin(), _fields.end(), name, [](const BSONElement& elt, StringData name) {
+            return elt.fieldNameStringData() < name;
+        });
+    if (it == _fields.end() || it->fieldNameStringData() != name) {
+        return BSONElement();
+    }
+    return *it;
+}
+
 // ------
 
 SimpleArrayElementIterator::SimpleArrayElementIterator(const BSONElement& theArray,
@@ -88,15 +121,23 @@ BSONElementIterator::BSONElementIterator() {
 }
 
 BSONElementIterator::BSONElementIterator(const ElementPath* path, const BSONObj& context)
-    : _path(path), _context(context) {
+    : BSONElementIterator(path, context, nullptr) {}
+
+BSONElementIterator::BSONElementIterator(const ElementPath* path,
+                                         const BSONObj& context,
+                                         const TopLevelFieldCache* topLevelFields)
+    : _path(path), _context(context), _topLevelFields(topLevelFields) {
     _state = BEGIN;
 }
 
 BSONElementIterator::~BSONElementIterator() {}
 
-void BSONElementIterator::reset(const ElementPath* path, const BSONObj& context) {
+void BSONElementIterator::reset(const ElementPath* path,
+                                const BSONObj& context,
+                                const TopLevelFieldCache* topLevelFields) {
     _path = path;
     _context = context;
+    _topLevelFields = topLevelFields;
     _state = BEGIN;
     _next.reset();
 
@@ -191,7 +232,8 @@ bool BSONElementIterator::more() {
 
     if (_state == BEGIN) {
         size_t idxPath = 0;
-        BSONElement e = getFieldDottedOrArray(_context, _path->fieldRef(), &idxPath);
+        BSONElement e =
+            getFieldDottedOrArray(_context, _path->fieldRef(), &idxPath, _topLevelFields);
 
         if (e.type() != Array) {
             _next.reset(e, BSONElement(), false);
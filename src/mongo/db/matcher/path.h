@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
@@ -99,6 +100,27 @@ public:
     virtual Context next() = 0;
 };
 
+/**
+ * Resolves all of the top-level fields of a BSONObj in a single pass over it. Looking up many
+ * paths in the same object through a TopLevelFieldCache costs one scan of the object rather than
+ * one scan per path.
+ *
+ * The BSONObj must outlive the cache.
+ */
+class TopLevelFieldCache {
+public:
+    explicit TopLevelFieldCache(const BSONObj& obj);
+
+    /**
+     * Returns the same element as obj.getField(name), or EOO if there is no such field.
+     */
+    BSONElement getField(StringData name) const;
+
+private:
+    // The object's fields, ordered by field name. Fields with the same name keep their order.
+    std::vector<BSONElement> _fields;
+};
+
 // ---------------------------------------------------------------
 
 class SingleElementElementIterator : public ElementIterator {
@@ -139,9 +161,19 @@ public:
     BSONElementIterator();
     BSONElementIterator(const ElementPath* path, const BSONObj& context);
 
+    /**
+     * 'topLevelFields', if not null, must be a cache of 'context' which outlives this iterator.
+     * It is used to find the first part of the path.
+     */
+    BSONElementIterator(const ElementPath* path,
+                        const BSONObj& context,
+                        const TopLevelFieldCache* topLevelFields);
+
     virtual ~BSONElementIterator();
 
-    void reset(const ElementPath* path, const BSONObj& context);
+    void reset(const ElementPath* path,
+               const BSONObj& context,
+               const TopLevelFieldCache* topLevelFields = nullptr);
 
     bool more();
     Context next();
@@ -155,6 +187,7 @@ private:
 
     const ElementPath* _path;
     BSONObj _context;
+    const TopLevelFieldCache* _topLevelFields = nullptr;
 
     enum State { BEGIN, IN_ARRAY, DONE } _state;
     Context _next;
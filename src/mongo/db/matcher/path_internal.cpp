@@ -30,6 +30,8 @@
 
 #include "mongo/db/matcher/path_internal.h"
 
+#include "mongo/db/matcher/path.h"
+
 namespace mongo {
 
 bool isAllDigits(StringData str) {
@@ -40,7 +42,10 @@ bool isAllDigits(StringData str) {
     return true;
 }
 
-BSONElement getFieldDottedOrArray(const BSONObj& doc, const FieldRef& path, size_t* idxPath) {
+BSONElement getFieldDottedOrArray(const BSONObj& doc,
+                                  const FieldRef& path,
+                                  size_t* idxPath,
+                                  const TopLevelFieldCache* topLevelFields) {
     if (path.numParts() == 0)
         return doc.getField("");
 
@@ -50,7 +55,11 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc, const FieldRef& path, size
     bool stop = false;
     size_t partNum = 0;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        if (partNum == 0 && topLevelFields) {
+            res = topLevelFields->getField(path.getPart(partNum));
+        } else {
+            res = curr.getField(path.getPart(partNum));
+        }
 
         switch (res.type()) {
             case EOO:
@@ -38,10 +38,17 @@
 
 namespace mongo {
 
+class TopLevelFieldCache;
+
 bool isAllDigits(StringData str);
 
 // XXX document me
 // Replaces getFieldDottedOrArray without recursion nor std::string manipulation
-BSONElement getFieldDottedOrArray(const BSONObj& doc, const FieldRef& path, size_t* idxPath);
+// If 'topLevelFields' is not null, it must be a cache of 'doc', and is used to find the first part
+// of 'path'.
+BSONElement getFieldDottedOrArray(const BSONObj& doc,
+                                  const FieldRef& path,
+                                  size_t* idxPath,
+                                  const TopLevelFieldCache* topLevelFields = nullptr);
 
 }  // namespace mongo
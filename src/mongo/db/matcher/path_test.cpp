@@ -53,6 +53,33 @@ TEST(Path, Root1) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, TopLevelFieldCache) {
+    BSONObj doc = BSON("z" << 1 << "a" << 2 << "m" << 3 << "a" << 4);
+    TopLevelFieldCache cache(doc);
+
+    ASSERT_EQUALS(1, cache.getField("z").numberInt());
+    ASSERT_EQUALS(3, cache.getField("m").numberInt());
+    // The first of two fields with the same name is found, as with BSONObj::getField().
+    ASSERT_EQUALS(2, cache.getField("a").numberInt());
+    ASSERT(cache.getField("b").eoo());
+    ASSERT(cache.getField("").eoo());
+}
+
+TEST(Path, NestedWithTopLevelFieldCache) {
+    ElementPath p;
+    ASSERT(p.init("b.c").isOK());
+
+    BSONObj doc = BSON("a" << 1 << "b" << BSON_ARRAY(BSON("c" << 5) << BSON("c" << 6)));
+    TopLevelFieldCache cache(doc);
+
+    BSONElementIterator cursor(&p, doc, &cache);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(5, cursor.next().element().numberInt());
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(6, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+}
+
 TEST(Path, RootArray1) {
     ElementPath p;
     ASSERT(p.init("a").isOK());
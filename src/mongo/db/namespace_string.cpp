@@ -92,6 +92,8 @@ bool legalClientSystemNS(StringData ns) {
         return true;
     if (ns == "admin.system.backup_users")
         return true;
+    if (ns == "admin.system.indexFilters")
+        return true;
 
     if (ns.find(".system.js") != string::npos)
         return true;
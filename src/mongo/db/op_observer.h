@@ -49,6 +49,9 @@ struct OplogUpdateEntryArgs {
     // Fully updated document with damages (update modifiers) applied.
     BSONObj updatedDoc;
 
+    // The document before the update, if the caller provided it. Must be owned.
+    BSONObj preImageDoc;
+
     // Document containing update modifiers -- e.g. $set and $unset
     BSONObj update;
 
@@ -92,6 +95,14 @@ public:
                           const NamespaceString& ns,
                           CollectionShardingState::DeleteState deleteState,
                           bool fromMigrate) = 0;
+    /**
+     * Called before 'doc' is deleted from the capped collection 'ns' to make room for new
+     * documents. Such deletes are not replicated, since every node trims its own capped
+     * collections.
+     */
+    virtual void aboutToDeleteCapped(OperationContext* txn,
+                                     const NamespaceString& ns,
+                                     const BSONObj& doc) = 0;
     virtual void onOpMessage(OperationContext* txn, const BSONObj& msgObj) = 0;
     virtual void onCreateCollection(OperationContext* txn,
                                     const NamespaceString& collectionName,
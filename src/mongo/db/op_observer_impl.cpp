@@ -41,6 +41,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/views/durable_view_catalog.h"
+#include "mongo/db/views/materialized_view.h"
 #include "mongo/scripting/engine.h"
 
 namespace mongo {
@@ -78,6 +79,10 @@ void OpObserverImpl::onInserts(OperationContext* txn,
         }
     }
 
+    if (!fromMigrate) {
+        materialized_view::onInserts(txn, nss, begin, end);
+    }
+
     if (nss.ns() == FeatureCompatibilityVersion::kCollection) {
         for (auto it = begin; it != end; it++) {
             FeatureCompatibilityVersion::onInsertOrUpdate(*it);
@@ -108,12 +113,16 @@ void OpObserverImpl::onUpdate(OperationContext* txn, const OplogUpdateEntryArgs&
         css->onUpdateOp(txn, args.updatedDoc);
     }
 
+    NamespaceString nss(args.ns);
+    if (!args.fromMigrate) {
+        materialized_view::onUpdate(txn, nss, args.preImageDoc, args.updatedDoc);
+    }
+
     logOpForDbHash(txn, args.ns.c_str());
     if (strstr(args.ns.c_str(), ".system.js")) {
         Scope::storedFuncMod(txn);
     }
 
-    NamespaceString nss(args.ns);
     if (nss.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onExternalChange(txn, nss);
     }
@@ -135,6 +144,11 @@ CollectionShardingState::DeleteState OpObserverImpl::aboutToDelete(OperationCont
     auto css = CollectionShardingState::get(txn, ns.ns());
     deleteState.isMigrating = css->isDocumentInMigratingChunk(txn, doc);
 
+    // The whole document is only available here, so keep it for onDelete().
+    if (materialized_view::hasViewsOn(txn, ns)) {
+        deleteState.fullDoc = doc.getOwned();
+    }
+
     return deleteState;
 }
 
@@ -142,6 +156,10 @@ void OpObserverImpl::onDelete(OperationContext* txn,
                               const NamespaceString& ns,
                               CollectionShardingState::DeleteState deleteState,
                               bool fromMigrate) {
+    if (!fromMigrate && !deleteState.fullDoc.isEmpty()) {
+        materialized_view::onDelete(txn, ns, deleteState.fullDoc);
+    }
+
     if (deleteState.idDoc.isEmpty())
         return;
 
@@ -166,6 +184,12 @@ void OpObserverImpl::onDelete(OperationContext* txn,
     }
 }
 
+void OpObserverImpl::aboutToDeleteCapped(OperationContext* txn,
+                                         const NamespaceString& ns,
+                                         const BSONObj& doc) {
+    materialized_view::onDelete(txn, ns, doc);
+}
+
 void OpObserverImpl::onOpMessage(OperationContext* txn, const BSONObj& msgObj) {
     repl::logOp(txn, "n", "", msgObj, nullptr, false);
 }
@@ -198,6 +222,10 @@ void OpObserverImpl::onCreateCollection(OperationContext* txn,
 
     getGlobalAuthorizationManager()->logOp(txn, "c", dbName.c_str(), cmdObj, nullptr);
     logOpForDbHash(txn, dbName.c_str());
+
+    if (options.isMaterializedView()) {
+        materialized_view::onCreate(txn, collectionName, options);
+    }
 }
 
 void OpObserverImpl::onCollMod(OperationContext* txn,
@@ -56,6 +56,9 @@ public:
                   const NamespaceString& ns,
                   CollectionShardingState::DeleteState deleteState,
                   bool fromMigrate) override;
+    void aboutToDeleteCapped(OperationContext* txn,
+                             const NamespaceString& ns,
+                             const BSONObj& doc) override;
     void onOpMessage(OperationContext* txn, const BSONObj& msgObj) override;
     void onCreateCollection(OperationContext* txn,
                             const NamespaceString& collectionName,
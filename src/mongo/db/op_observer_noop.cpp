@@ -53,6 +53,10 @@ void OpObserverNoop::onDelete(OperationContext*,
                               CollectionShardingState::DeleteState,
                               bool) {}
 
+void OpObserverNoop::aboutToDeleteCapped(OperationContext*,
+                                         const NamespaceString&,
+                                         const BSONObj&) {}
+
 void OpObserverNoop::onOpMessage(OperationContext*, const BSONObj&) {}
 
 void OpObserverNoop::onCreateCollection(OperationContext*,
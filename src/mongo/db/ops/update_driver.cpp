@@ -142,6 +142,14 @@ Status UpdateDriver::parse(const BSONObj& updateExpr, const bool multi) {
     // replacement.
     _replacementMode = false;
 
+    // A non-positional update made of a single $set logs exactly what it was given, as long as
+    // every one of its mods gets applied. Remember it so that update() can skip building the
+    // oplog entry field by field in that case.
+    if (!_positional && updateExpr.nFields() == 1 &&
+        modifiertable::getType(updateExpr.firstElementFieldName()) == modifiertable::MOD_SET) {
+        _setOnlyUpdateExpr = updateExpr;
+    }
+
     return Status::OK();
 }
 
@@ -247,6 +255,11 @@ Status UpdateDriver::update(StringData matchedField,
     _logDoc.reset();
     LogBuilder logBuilder(_logDoc.root());
 
+    // While this holds, every mod so far was applied and the update expression itself is the
+    // oplog entry. The first mod that is skipped makes us log the ones before it, and from then
+    // on each mod is logged as usual.
+    bool logUpdateExpr = _logOp && logOpRec && !_setOnlyUpdateExpr.isEmpty();
+
     // Ask each of the mods to type check whether they can operate over the current document
     // and, if so, to change that document accordingly.
     for (vector<ModifierInterface*>::iterator it = _mods.begin(); it != _mods.end(); ++it) {
@@ -262,12 +275,22 @@ Status UpdateDriver::update(StringData matchedField,
         const bool validContext = (execInfo.context == ModifierInterface::ExecInfo::ANY_CONTEXT ||
                                    execInfo.context == _context);
 
+        if (logUpdateExpr && (!validContext || execInfo.noOp)) {
+            logUpdateExpr = false;
+            for (vector<ModifierInterface*>::iterator logIt = _mods.begin(); logIt != it;
+                 ++logIt) {
+                status = (*logIt)->log(&logBuilder);
+                if (!status.isOK()) {
+                    return status;
+                }
+            }
+        }
+
         // Nothing to do if not in a valid context.
         if (!validContext) {
             continue;
         }
 
-
         // Gather which fields this mod is interested on and whether these fields were
         // "taken" by previous mods.  Note that not all mods are multi-field mods. When we
         // see an empty field, we may stop looking for others.
@@ -311,7 +334,7 @@ Status UpdateDriver::update(StringData matchedField,
         }
 
         // If we require a replication oplog entry for this update, go ahead and generate one.
-        if (!execInfo.noOp && _logOp && logOpRec) {
+        if (!execInfo.noOp && _logOp && logOpRec && !logUpdateExpr) {
             status = (*it)->log(&logBuilder);
             if (!status.isOK()) {
                 return status;
@@ -319,7 +342,9 @@ Status UpdateDriver::update(StringData matchedField,
         }
     }
 
-    if (_logOp && logOpRec)
+    if (logUpdateExpr)
+        *logOpRec = _setOnlyUpdateExpr;
+    else if (_logOp && logOpRec)
         *logOpRec = _logDoc.getObject();
 
     return Status::OK();
@@ -400,6 +425,7 @@ void UpdateDriver::clear() {
     _indexedFields = NULL;
     _replacementMode = false;
     _positional = false;
+    _setOnlyUpdateExpr = BSONObj();
 }
 
 }  // namespace mongo
@@ -183,6 +183,10 @@ private:
     // Do any of the mods require positional match details when calling 'prepare'?
     bool _positional;
 
+    // The update expression, if it is a single non-positional $set. Such an update is logged
+    // as is whenever all of its mods apply, instead of through '_logDoc'.
+    BSONObj _setOnlyUpdateExpr;
+
     // Is this update going to be an upsert?
     ModifierInterface::ExecInfo::UpdateContext _context;
 
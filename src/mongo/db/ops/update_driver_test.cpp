@@ -152,6 +152,31 @@ TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     ASSERT_TRUE(modified);
 }
 
+TEST(LogOp, SetOnlyUpdateLogsTheAppliedMods) {
+    BSONObj updateDocument = fromjson("{$set: {a: 1, b: 2}}");
+    UpdateDriver::Options opts;
+    opts.logOp = true;
+    UpdateDriver driver(opts);
+    ASSERT_OK(driver.parse(updateDocument));
+
+    BSONObj logObj;
+    Document doc(fromjson("{a: 0, b: 0}"));
+    ASSERT_OK(driver.update(StringData(), &doc, &logObj));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, b: 2}"), doc.getObject());
+    ASSERT_BSONOBJ_EQ(updateDocument, logObj);
+
+    // Setting 'a' is a no-op here, so only 'b' gets logged.
+    Document otherDoc(fromjson("{a: 1, b: 0}"));
+    ASSERT_OK(driver.update(StringData(), &otherDoc, &logObj));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, b: 2}"), otherDoc.getObject());
+    ASSERT_BSONOBJ_EQ(fromjson("{$set: {b: 2}}"), logObj);
+
+    // Neither is a no-op for a document missing both fields.
+    Document emptyDoc;
+    ASSERT_OK(driver.update(StringData(), &emptyDoc, &logObj));
+    ASSERT_BSONOBJ_EQ(updateDocument, logObj);
+}
+
 //
 // Tests of creating a base for an upsert from a query document
 // $or, $and, $all get special handling, as does the _id field
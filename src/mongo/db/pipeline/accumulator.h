@@ -76,6 +76,15 @@ public:
     /// Reset this accumulator to a fresh state ready to receive input.
     virtual void reset() = 0;
 
+    /**
+     * Undoes an earlier process(input, false), so that accumulating over a sliding window does not
+     * need to process the whole window again for each document. Returns false, leaving the state
+     * undefined, if this accumulator cannot undo 'input'; the caller must then reset() it and
+     * process the remaining inputs again.
+     */
+    virtual bool remove(const Value& input) {
+        return false;
+    }
 
     virtual bool isAssociative() const {
         return false;
@@ -170,6 +179,12 @@ public:
     const char* getOpName() const final;
     void reset() final;
 
+    /**
+     * Subtracts 'input' from the total. The type of the total stays the widest of all of the
+     * inputs processed since the last reset(). Returns false for infinities and NaN.
+     */
+    bool remove(const Value& input) final;
+
     static boost::intrusive_ptr<Accumulator> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
@@ -258,6 +273,11 @@ public:
     const char* getOpName() const final;
     void reset() final;
 
+    /**
+     * Subtracts 'input' from the total and the count. Returns false for infinities and NaN.
+     */
+    bool remove(const Value& input) final;
+
     static boost::intrusive_ptr<Accumulator> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
@@ -306,4 +326,95 @@ public:
     static boost::intrusive_ptr<Accumulator> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 };
+
+/**
+ * Estimates the number of distinct values with a HyperLogLog sketch, which takes the same small
+ * amount of memory however many values there are. Values which compare equal under the collation
+ * are counted once. The sketches of several partitions merge into the sketch of all of the values
+ * in them, so the estimate is as good when the accumulation is split across shards.
+ */
+class AccumulatorApproxCountDistinct final : public Accumulator {
+public:
+    // The number of hash bits which select a register. The standard error of the estimate is
+    // about 1.04 / sqrt(2^kPrecision), or 1.6%.
+    static const int kPrecision = 12;
+    static const size_t kNumRegisters = size_t(1) << kPrecision;
+
+    explicit AccumulatorApproxCountDistinct(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) const final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<Accumulator> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    void _allocateRegisters();
+
+    // Each register holds the largest number of leading zero bits, plus one, seen in the hashes
+    // of the values assigned to it. Empty until the first value, so that empty groups stay small.
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * Estimates percentiles of the numeric values with a KLL sketch, which keeps a sample of the
+ * values of bounded size, each standing for a power of two of the values seen. Takes an object of
+ * the form {input: <number>, p: <number or array of numbers between 0 and 1>}, and returns the
+ * estimate for each percentile in the same form as 'p'. Like the exact percentiles, each estimate
+ * is one of the input values.
+ */
+class AccumulatorApproxPercentile final : public Accumulator {
+public:
+    // The number of values kept by the top level of the sketch; lower levels keep geometrically
+    // fewer. The rank of an estimate is typically within 1% of the requested one.
+    static const size_t kMaxLevelCapacity = 200;
+
+    explicit AccumulatorApproxPercentile(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) const final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<Accumulator> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+private:
+    /**
+     * Validates the requested percentiles 'p', and checks that they are the same as in all
+     * previous input.
+     */
+    void _setPercentiles(const Value& p);
+
+    size_t _levelCapacity(size_t level) const;
+
+    /**
+     * Halves the lowest level which is over its capacity, if the sketch holds too many values.
+     */
+    void _compress();
+
+    void _updateMemUsage();
+
+    // The percentiles requested, as given and as doubles. Missing until the first input.
+    Value _p;
+    std::vector<double> _percentiles;
+
+    // Each value in _levels[i] stands for 2^i of the input values. Only numeric values are kept.
+    std::vector<std::vector<Value>> _levels;
+    size_t _numRetained = 0;
+    long long _count = 0;
+
+    // Alternates which half of a level is kept each time one is compacted.
+    bool _keepOddValues = false;
+};
 }
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(approxCountDistinct, AccumulatorApproxCountDistinct::create);
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+namespace {
+const char registersName[] = "registers";
+
+/**
+ * Mixes the bits of 'hash', so that each bit of the result depends on all of them. The hashes of
+ * Values are meant for hash tables, and are not necessarily uniform in their high bits.
+ */
+uint64_t mixHash(uint64_t hash) {
+    // The finalizer of MurmurHash3.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (merging) {
+        // 'input' is what getValue(true) produced below.
+        verify(input.getType() == Object);
+        BSONObjBuilder registersBuilder;
+        input[registersName].addToBsonObj(&registersBuilder, registersName);
+        BSONObj registersObj = registersBuilder.done();
+        BSONElement registers = registersObj.firstElement();
+        verify(registers.type() == BinData);
+
+        int len;
+        const char* otherRegisters = registers.binData(len);
+        if (len == 0) {
+            return;  // This partition had no data to contribute.
+        }
+        verify(static_cast<size_t>(len) == kNumRegisters);
+
+        _allocateRegisters();
+        for (size_t i = 0; i < kNumRegisters; ++i) {
+            _registers[i] = std::max(_registers[i], static_cast<uint8_t>(otherRegisters[i]));
+        }
+        return;
+    }
+
+    // Like $addToSet, ignore missing values.
+    if (input.missing()) {
+        return;
+    }
+
+    _allocateRegisters();
+    const uint64_t hash = mixHash(getExpressionContext()->getValueComparator().hash(input));
+    const size_t index = hash >> (64 - kPrecision);
+    const uint64_t remainingBits = hash << kPrecision;
+    const uint8_t rank = remainingBits == 0 ? 64 - kPrecision + 1
+                                            : countLeadingZeros64(remainingBits) + 1;
+    _registers[index] = std::max(_registers[index], rank);
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) const {
+    if (toBeMerged) {
+        return Value(Document{{registersName,
+                               Value(BSONBinData(_registers.data(),
+                                                 static_cast<int>(_registers.size()),
+                                                 BinDataGeneral))}});
+    }
+
+    if (_registers.empty()) {
+        return Value(0LL);
+    }
+
+    const double numRegisters = kNumRegisters;
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (auto&& reg : _registers) {
+        sum += std::ldexp(1.0, -reg);
+        if (reg == 0) {
+            ++numZeroRegisters;
+        }
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / numRegisters);
+    double estimate = alpha * numRegisters * numRegisters / sum;
+    if (estimate <= 2.5 * numRegisters && numZeroRegisters > 0) {
+        // The raw estimate is biased for small cardinalities, for which counting the empty
+        // registers gives a better one.
+        estimate = numRegisters * std::log(numRegisters / numZeroRegisters);
+    }
+    return Value(static_cast<long long>(std::llround(estimate)));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : Accumulator(expCtx) {
+    _memUsageBytes = sizeof(*this);
+}
+
+void AccumulatorApproxCountDistinct::_allocateRegisters() {
+    if (_registers.empty()) {
+        _registers.resize(kNumRegisters, 0);
+        _memUsageBytes = sizeof(*this) + _registers.capacity();
+    }
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    std::vector<uint8_t>().swap(_registers);
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<Accumulator> AccumulatorApproxCountDistinct::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+}
@@ -0,0 +1,276 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::vector;
+
+REGISTER_ACCUMULATOR(approxPercentile, AccumulatorApproxPercentile::create);
+
+const char* AccumulatorApproxPercentile::getOpName() const {
+    return "$approxPercentile";
+}
+
+namespace {
+const char inputName[] = "input";
+const char pName[] = "p";
+const char countName[] = "count";
+const char levelsName[] = "levels";
+}  // namespace
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    if (merging) {
+        // 'input' is what getValue(true) produced below.
+        verify(input.getType() == Object);
+        const long long count = input[countName].getLong();
+        if (count == 0) {
+            return;  // This partition had no data to contribute.
+        }
+        _setPercentiles(input[pName]);
+
+        const auto& levels = input[levelsName].getArray();
+        if (_levels.size() < levels.size()) {
+            _levels.resize(levels.size());
+        }
+        for (size_t i = 0; i < levels.size(); ++i) {
+            for (auto&& val : levels[i].getArray()) {
+                _levels[i].push_back(val);
+            }
+            _numRetained += levels[i].getArrayLength();
+        }
+        _count += count;
+        _compress();
+        return;
+    }
+
+    uassert(40392,
+            str::stream() << "$approxPercentile requires an object of the form {input: "
+                             "<expression>, p: <number or array of numbers>}, but found: "
+                          << input.toString(),
+            input.getType() == Object);
+    _setPercentiles(input[pName]);
+
+    // Non-numeric values have no impact on percentiles. NaN is not ordered against the other
+    // numbers, so it is ignored too. The values are kept as they are, rather than as doubles, so
+    // that large integers are compared and returned exactly.
+    Value val = input[inputName];
+    if (!val.numeric() || std::isnan(val.coerceToDouble())) {
+        return;
+    }
+
+    if (_levels.empty()) {
+        _levels.resize(1);
+    }
+    _levels[0].push_back(std::move(val));
+    _numRetained++;
+    _count++;
+    _compress();
+}
+
+void AccumulatorApproxPercentile::_setPercentiles(const Value& p) {
+    if (!_p.missing()) {
+        uassert(40393,
+                str::stream() << "$approxPercentile requires 'p' to be the same for every input, "
+                                 "but found both "
+                              << _p.toString()
+                              << " and "
+                              << p.toString(),
+                ValueComparator().evaluate(_p == p));
+        return;
+    }
+
+    vector<Value> percentiles;
+    if (p.getType() == Array) {
+        percentiles = p.getArray();
+    } else {
+        percentiles.push_back(p);
+    }
+    uassert(40394,
+            str::stream() << "$approxPercentile requires 'p' to be a number or a non-empty "
+                             "array of numbers, but found: "
+                          << p.toString(),
+            !percentiles.empty());
+
+    for (auto&& percentile : percentiles) {
+        uassert(40395,
+                str::stream() << "$approxPercentile requires each percentile in 'p' to be a "
+                                 "number between 0 and 1, but found: "
+                              << percentile.toString(),
+                percentile.numeric() && percentile.coerceToDouble() >= 0.0 &&
+                    percentile.coerceToDouble() <= 1.0);
+        _percentiles.push_back(percentile.coerceToDouble());
+    }
+    _p = p;
+}
+
+size_t AccumulatorApproxPercentile::_levelCapacity(size_t level) const {
+    // Each level below the top one keeps two thirds as many values as the one above it, so the
+    // sketch as a whole keeps at most about three times as many as the top level.
+    const size_t depth = _levels.size() - 1 - level;
+    const double capacity = std::ceil(kMaxLevelCapacity * std::pow(2.0 / 3.0, depth));
+    return std::max(size_t(2), static_cast<size_t>(capacity));
+}
+
+void AccumulatorApproxPercentile::_compress() {
+    while (!_levels.empty()) {
+        size_t totalCapacity = 0;
+        for (size_t level = 0; level < _levels.size(); ++level) {
+            totalCapacity += _levelCapacity(level);
+        }
+        if (_numRetained < totalCapacity) {
+            break;
+        }
+
+        // Some level must be at or over its capacity. Sort it and keep every other value, giving
+        // each kept value twice the weight by moving it to the level above.
+        size_t level = 0;
+        while (_levels[level].size() < _levelCapacity(level)) {
+            ++level;
+        }
+        if (level + 1 == _levels.size()) {
+            _levels.emplace_back();
+        }
+
+        auto& values = _levels[level];
+        std::sort(values.begin(), values.end(), ValueComparator().getLessThan());
+
+        // An odd value out stays behind with its current weight.
+        boost::optional<Value> leftover;
+        if (values.size() % 2 == 1) {
+            leftover = std::move(values.back());
+            values.pop_back();
+        }
+
+        auto& nextLevel = _levels[level + 1];
+        for (size_t i = _keepOddValues ? 1 : 0; i < values.size(); i += 2) {
+            nextLevel.push_back(values[i]);
+        }
+        _keepOddValues = !_keepOddValues;
+        _numRetained -= values.size() / 2;
+
+        values.clear();
+        if (leftover) {
+            values.push_back(*leftover);
+        }
+    }
+    _updateMemUsage();
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) const {
+    if (toBeMerged) {
+        vector<Value> levels;
+        for (auto&& level : _levels) {
+            levels.push_back(Value(level));
+        }
+        return Value(
+            Document{{pName, _p}, {countName, _count}, {levelsName, Value(std::move(levels))}});
+    }
+
+    if (_count == 0) {
+        return Value(BSONNULL);
+    }
+
+    // Order the retained values, and find the total weight of the values up to each of them.
+    vector<std::pair<Value, long long>> weighted;
+    weighted.reserve(_numRetained);
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        for (auto&& val : _levels[level]) {
+            weighted.emplace_back(val, 1LL << level);
+        }
+    }
+    const ValueComparator comparator;
+    std::sort(weighted.begin(),
+              weighted.end(),
+              [&](const std::pair<Value, long long>& lhs, const std::pair<Value, long long>& rhs) {
+                  return comparator.compare(lhs.first, rhs.first) < 0;
+              });
+    long long totalWeight = 0;
+    for (auto&& entry : weighted) {
+        totalWeight += entry.second;
+        entry.second = totalWeight;
+    }
+
+    vector<Value> estimates;
+    for (auto&& percentile : _percentiles) {
+        // The estimate is the first value whose rank, counting from one, reaches the percentile.
+        const long long rank =
+            std::max(1LL, static_cast<long long>(std::ceil(percentile * totalWeight)));
+        auto it = std::lower_bound(weighted.begin(),
+                                   weighted.end(),
+                                   rank,
+                                   [](const std::pair<Value, long long>& entry, long long r) {
+                                       return entry.second < r;
+                                   });
+        estimates.push_back(it == weighted.end() ? weighted.back().first : it->first);
+    }
+
+    return _p.getType() == Array ? Value(std::move(estimates)) : estimates.front();
+}
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : Accumulator(expCtx) {
+    _updateMemUsage();
+}
+
+void AccumulatorApproxPercentile::_updateMemUsage() {
+    _memUsageBytes = sizeof(*this) + _levels.capacity() * sizeof(vector<Value>) +
+        _numRetained * sizeof(Value);
+}
+
+void AccumulatorApproxPercentile::reset() {
+    _p = Value();
+    _percentiles.clear();
+    _levels.clear();
+    _numRetained = 0;
+    _count = 0;
+    _keepOddValues = false;
+    _updateMemUsage();
+}
+
+intrusive_ptr<Accumulator> AccumulatorApproxPercentile::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorApproxPercentile(expCtx);
+}
+}
@@ -30,6 +30,9 @@
 
 #include "mongo/db/pipeline/accumulator.h"
 
+#include <cmath>
+#include <limits>
+
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/expression.h"
@@ -92,6 +95,41 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+bool AccumulatorAvg::remove(const Value& input) {
+    switch (input.getType()) {
+        case NumberDecimal: {
+            const Decimal128 val = input.getDecimal();
+            if (val.isNaN() || val.isInfinite()) {
+                return false;
+            }
+            _decimalTotal = _decimalTotal.subtract(val);
+            break;
+        }
+        case NumberLong: {
+            const long long val = input.getLong();
+            if (val == std::numeric_limits<long long>::min()) {
+                return false;  // Cannot be negated.
+            }
+            _nonDecimalTotal.addLong(-val);
+            break;
+        }
+        case NumberInt:
+        case NumberDouble: {
+            const double val = input.getDouble();
+            if (!std::isfinite(val)) {
+                return false;
+            }
+            _nonDecimalTotal.addDouble(-val);
+            break;
+        }
+        default:
+            dassert(!input.numeric());
+            return true;  // Non-numeric values were ignored.
+    }
+    _count--;
+    return true;
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorAvg(expCtx);
@@ -84,6 +84,39 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+bool AccumulatorSum::remove(const Value& input) {
+    switch (input.getType()) {
+        case NumberInt:
+        case NumberLong: {
+            const long long val = input.coerceToLong();
+            if (val == std::numeric_limits<long long>::min()) {
+                return false;  // Cannot be negated.
+            }
+            nonDecimalTotal.addLong(-val);
+            return true;
+        }
+        case NumberDouble: {
+            const double val = input.getDouble();
+            if (!std::isfinite(val)) {
+                return false;
+            }
+            nonDecimalTotal.addDouble(-val);
+            return true;
+        }
+        case NumberDecimal: {
+            const Decimal128 val = input.getDecimal();
+            if (val.isNaN() || val.isInfinite()) {
+                return false;
+            }
+            decimalTotal = decimalTotal.subtract(val);
+            return true;
+        }
+        default:
+            dassert(!input.numeric());
+            return true;  // Non-numeric values were ignored.
+    }
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorSum(expCtx);
@@ -344,4 +344,172 @@ TEST(Accumulators, AddToSetRespectsCollation) {
                             Value(std::vector<Value>{Value("a"_sd)})}});
 }
 
+TEST(Accumulators, SumAndAvgCanRemoveFiniteInputs) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    for (auto&& name : {"$sum", "$avg"}) {
+        intrusive_ptr<Accumulator> accum(AccumulationStatement::getFactory(name)(expCtx));
+        for (auto&& val : {Value(1), Value(2LL), Value(3.5), Value("a"_sd), Value(4)}) {
+            accum->process(val, false);
+        }
+        ASSERT_TRUE(accum->remove(Value(1)));
+        ASSERT_TRUE(accum->remove(Value(3.5)));
+        ASSERT_TRUE(accum->remove(Value("a"_sd)));
+        ASSERT_VALUE_EQ(accum->getValue(false), Value(name == std::string("$sum") ? 6 : 3));
+
+        ASSERT_FALSE(accum->remove(Value(numeric_limits<double>::infinity())));
+        ASSERT_FALSE(accum->remove(Value(numeric_limits<double>::quiet_NaN())));
+    }
+
+    // Other accumulators cannot remove their inputs.
+    intrusive_ptr<Accumulator> max(AccumulationStatement::getFactory("$max")(expCtx));
+    max->process(Value(1), false);
+    ASSERT_FALSE(max->remove(Value(1)));
+}
+
+/**
+ * Processes each of 'inputs' with a separate accumulator of type 'accumulatorName', as if on
+ * 'numShards' shards, and returns the result of merging them.
+ */
+static Value accumulateAcrossShards(std::string accumulatorName,
+                                    const intrusive_ptr<ExpressionContext>& expCtx,
+                                    const std::vector<Value>& inputs,
+                                    size_t numShards) {
+    auto factory = AccumulationStatement::getFactory(accumulatorName);
+    std::vector<intrusive_ptr<Accumulator>> shards;
+    for (size_t i = 0; i < numShards; ++i) {
+        shards.push_back(factory(expCtx));
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        shards[i % numShards]->process(inputs[i], false);
+    }
+
+    intrusive_ptr<Accumulator> merger(factory(expCtx));
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+    return merger->getValue(false);
+}
+
+TEST(Accumulators, ApproxCountDistinct) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    assertExpectedResults(
+        "$approxCountDistinct",
+        expCtx,
+        {// No documents evaluated.
+         {{}, Value(0LL)},
+         // Small numbers of distinct values are counted exactly.
+         {{Value(1), Value(2), Value(3)}, Value(3LL)},
+         // Numbers which compare equal are counted once.
+         {{Value(1), Value(1.0), Value(1LL), Value("1"_sd)}, Value(2LL)},
+         // Null values are counted, but missing values are ignored.
+         {{Value(BSONNULL), Value(), Value(BSONNULL)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    expCtx->setCollator(
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual));
+    assertExpectedResults("$approxCountDistinct",
+                          expCtx,
+                          {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctOfManyValuesIsCloseAndMergeable) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    const long long numDistinct = 100000;
+    std::vector<Value> inputs;
+    for (long long i = 0; i < numDistinct; ++i) {
+        inputs.push_back(Value(i));
+        inputs.push_back(Value(i));
+    }
+
+    Value estimate = accumulateAcrossShards("$approxCountDistinct", expCtx, inputs, 1);
+    ASSERT_LT(std::abs(estimate.getLong() - numDistinct), numDistinct / 20);
+
+    // Merging the sketches of the values on each shard gives the same sketch as for all of them.
+    ASSERT_VALUE_EQ(estimate, accumulateAcrossShards("$approxCountDistinct", expCtx, inputs, 7));
+}
+
+/**
+ * Returns the input to $approxPercentile for the value 'input' and the percentiles 'p'.
+ */
+static Value percentileInput(Value input, Value p) {
+    return Value(Document{{"input", input}, {"p", p}});
+}
+
+TEST(Accumulators, ApproxPercentile) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    const Value median(0.5);
+    const Value extremes(std::vector<Value>{Value(0), Value(1)});
+    assertExpectedResults(
+        "$approxPercentile",
+        expCtx,
+        {// No documents evaluated.
+         {{}, Value(BSONNULL)},
+         // Small numbers of values give exact percentiles, which are input values.
+         {{percentileInput(Value(5), median),
+           percentileInput(Value(1), median),
+           percentileInput(Value(4LL), median),
+           percentileInput(Value(2.5), median)},
+          Value(2.5)},
+         // An array of percentiles gives an array of estimates.
+         {{percentileInput(Value(3), extremes),
+           percentileInput(Value(-1), extremes),
+           percentileInput(Value(7), extremes)},
+          Value(std::vector<Value>{Value(-1), Value(7)})},
+         // Non-numeric and NaN values are ignored.
+         {{percentileInput(Value(3), median),
+           percentileInput(Value("a"_sd), median),
+           percentileInput(Value(numeric_limits<double>::quiet_NaN()), median),
+           percentileInput(Value(), median)},
+          Value(3)},
+         // Integers too large to be represented exactly as doubles are returned exactly.
+         {{percentileInput(Value((1LL << 60) + 1), median),
+           percentileInput(Value((1LL << 60) + 3), median),
+           percentileInput(Value((1LL << 60) + 5), median)},
+          Value((1LL << 60) + 3)}});
+}
+
+TEST(Accumulators, ApproxPercentileOfManyValuesIsCloseAndMergeable) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    const long long numValues = 100000;
+    const Value p(std::vector<Value>{Value(0.01), Value(0.5), Value(0.99)});
+    std::vector<Value> inputs;
+    for (long long i = 0; i < numValues; ++i) {
+        // Visit the values out of order.
+        inputs.push_back(percentileInput(Value((i * 7919) % numValues), p));
+    }
+
+    for (size_t numShards : {1, 7}) {
+        auto estimates =
+            accumulateAcrossShards("$approxPercentile", expCtx, inputs, numShards).getArray();
+        ASSERT_EQ(3U, estimates.size());
+        ASSERT_LT(std::abs(estimates[0].getLong() - 1000), numValues / 50);
+        ASSERT_LT(std::abs(estimates[1].getLong() - 50000), numValues / 50);
+        ASSERT_LT(std::abs(estimates[2].getLong() - 99000), numValues / 50);
+    }
+}
+
+TEST(Accumulators, ApproxPercentileRejectsInvalidPercentiles) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto factory = AccumulationStatement::getFactory("$approxPercentile");
+
+    ASSERT_THROWS_CODE(factory(expCtx)->process(Value(5), false), UserException, 40392);
+    ASSERT_THROWS_CODE(
+        factory(expCtx)->process(percentileInput(Value(5), Value(std::vector<Value>{})), false),
+        UserException,
+        40394);
+    ASSERT_THROWS_CODE(factory(expCtx)->process(percentileInput(Value(5), Value(1.5)), false),
+                       UserException,
+                       40395);
+    ASSERT_THROWS_CODE(factory(expCtx)->process(percentileInput(Value(5), Value("a"_sd)), false),
+                       UserException,
+                       40395);
+
+    auto accum = factory(expCtx);
+    accum->process(percentileInput(Value(5), Value(0.5)), false);
+    ASSERT_THROWS_CODE(
+        accum->process(percentileInput(Value(5), Value(0.9)), false), UserException, 40393);
+}
+
 }  // namespace AccumulatorTests
@@ -44,7 +44,7 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
-Position DocumentStorage::findField(StringData requested) const {
+Position DocumentStorage::findLoadedField(StringData requested) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
     if (_numFields >= HASH_TAB_MIN) {  // hash lookup
@@ -61,7 +61,7 @@ Position DocumentStorage::findField(StringData requested) const {
             pos = elem.nextCollision;
         }
     } else {  // linear scan
-        for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
+        for (DocumentStorageIterator it = loadedFieldsIteratorAll(); !it.atEnd(); it.advance()) {
             if (it->nameLen == reqSize && memcmp(requested.rawData(), it->_name, reqSize) == 0) {
                 return it.position();
             }
@@ -72,6 +72,64 @@ Position DocumentStorage::findField(StringData requested) const {
     return Position();
 }
 
+void DocumentStorage::setLazyBson(const BSONObj& bson, bool withMetaData) {
+    dassert(bson.isOwned());
+    fassert(40385, !_buffer && !hasUnloadedFields());
+
+    if (withMetaData) {
+        // Metadata must be known up front, so scan the names without converting any values.
+        BSONObjIterator it(bson);
+        while (it.more()) {
+            BSONElement elem(it.next());
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName[0] != '$')
+                continue;
+            if (fieldName == Document::metaFieldTextScore) {
+                setTextScore(elem.Double());
+            } else if (fieldName == Document::metaFieldRandVal) {
+                setRandMetaField(elem.Double());
+            }
+        }
+    }
+
+    if (bson.isEmpty())
+        return;
+
+    _lazyBson = bson;
+    _lazyBsonOffset = sizeof(int32_t);  // first element follows the object size
+    _lazyBsonHasMetaData = withMetaData;
+}
+
+Position DocumentStorage::loadLazyFields(StringData requested, bool all) const {
+    // Converting a field does not change the logical contents of the document, it only moves the
+    // field from _lazyBson into _buffer. Positions of already-loaded fields stay the same.
+    DocumentStorage* self = const_cast<DocumentStorage*>(this);
+
+    while (hasUnloadedFields()) {
+        BSONElement elem(_lazyBson.objdata() + _lazyBsonOffset);
+        if (elem.eoo()) {
+            self->_lazyBson = BSONObj();
+            self->_lazyBsonOffset = 0;
+            break;
+        }
+        self->_lazyBsonOffset += elem.size();
+
+        auto fieldName = elem.fieldNameStringData();
+        if (_lazyBsonHasMetaData && fieldName[0] == '$' &&
+            (fieldName == Document::metaFieldTextScore ||
+             fieldName == Document::metaFieldRandVal)) {
+            continue;
+        }
+
+        const Position pos = getNextPosition();
+        self->appendField(fieldName) = Value(elem);
+        if (!all && fieldName == requested)
+            return pos;
+    }
+
+    return Position();
+}
+
 Value& DocumentStorage::appendField(StringData name) {
     Position pos = getNextPosition();
     const int nameSize = name.size();
@@ -200,9 +258,12 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     out->_metaFields = _metaFields;
     out->_textScore = _textScore;
     out->_randVal = _randVal;
+    out->_lazyBson = _lazyBson;
+    out->_lazyBsonOffset = _lazyBsonOffset;
+    out->_lazyBsonHasMetaData = _lazyBsonHasMetaData;
 
     // Tell values that they have been memcpyed (updates ref counts)
-    for (DocumentStorageIterator it = out->iteratorAll(); !it.atEnd(); it.advance()) {
+    for (DocumentStorageIterator it = out->loadedFieldsIteratorAll(); !it.atEnd(); it.advance()) {
         it->val.memcpyed();
     }
 
@@ -212,7 +273,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
 DocumentStorage::~DocumentStorage() {
     std::unique_ptr<char[]> deleteBufferAtScopeEnd(_buffer);
 
-    for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
+    for (DocumentStorageIterator it = loadedFieldsIteratorAll(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 }
@@ -295,6 +356,12 @@ Document Document::fromBsonWithMetaData(const BSONObj& bson) {
     return md.freeze();
 }
 
+Document Document::fromBsonWithMetaDataLazily(const BSONObj& bson) {
+    intrusive_ptr<DocumentStorage> storage(new DocumentStorage());
+    storage->setLazyBson(bson.getOwned(), true);
+    return Document(storage.get());
+}
+
 MutableDocument::MutableDocument(size_t expectedFields)
     : _storageHolder(NULL), _storage(_storageHolder) {
     if (expectedFields) {
@@ -365,8 +432,9 @@ size_t Document::getApproximateSize() const {
 
     size_t size = sizeof(DocumentStorage);
     size += storage().allocatedBytes();
+    size += storage().unloadedBsonBytes();
 
-    for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
+    for (DocumentStorageIterator it = storage().loadedFieldsIterator(); !it.atEnd(); it.advance()) {
         size += it->val.getApproximateSize();
         size -= sizeof(Value);  // already accounted for above
     }
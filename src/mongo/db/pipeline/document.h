@@ -210,6 +210,14 @@ public:
      */
     static Document fromBsonWithMetaData(const BSONObj& bson);
 
+    /**
+     * Same as fromBsonWithMetaData(), but keeps an owned copy of 'bson' and only converts its
+     * top-level fields to Values as they are looked up. This is cheaper when most fields of a
+     * large document are never read. Iterating, comparing or modifying the result converts
+     * all of it.
+     */
+    static Document fromBsonWithMetaDataLazily(const BSONObj& bson);
+
     // Support BSONObjBuilder and BSONArrayBuilder "stream" API
     friend BSONObjBuilder& operator<<(BSONObjBuilderValueStream& builder, const Document& d);
 
@@ -259,6 +267,15 @@ public:
         return *this;
     }
 
+    /**
+     * Converts any fields which a document from fromBsonWithMetaDataLazily() still holds as BSON.
+     * Looking fields up converts them in place, so this must be called before the same Document
+     * is read by several threads at once.
+     */
+    void loadAllLazyFields() const {
+        storage().loadAllLazyFields();
+    }
+
     /// only for testing
     const void* getPtr() const {
         return _storage.get();
@@ -542,7 +559,11 @@ private:
             return clonedStorage();
 
         // This function exists to ensure this is safe
-        return const_cast<DocumentStorage&>(*storagePtr());
+        DocumentStorage& ds = const_cast<DocumentStorage&>(*storagePtr());
+
+        // Fields must not be appended lazily behind fields added here.
+        ds.loadAllLazyFields();
+        return ds;
     }
     DocumentStorage& newStorage() {
         reset(new DocumentStorage);
@@ -550,7 +571,9 @@ private:
     }
     DocumentStorage& clonedStorage() {
         reset(storagePtr()->clone());
-        return const_cast<DocumentStorage&>(*storagePtr());
+        DocumentStorage& ds = const_cast<DocumentStorage&>(*storagePtr());
+        ds.loadAllLazyFields();
+        return ds;
     }
 
     // recursive helpers for same-named public methods
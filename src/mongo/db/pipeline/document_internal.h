@@ -34,6 +34,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include "mongo/base/static_assert.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -189,7 +190,9 @@ public:
           _hashTabMask(0),
           _metaFields(),
           _textScore(0),
-          _randVal(0) {}
+          _randVal(0),
+          _lazyBsonOffset(0),
+          _lazyBsonHasMetaData(false) {}
 
     ~DocumentStorage();
 
@@ -218,7 +221,12 @@ public:
     }
 
     /// Returns the position of the named field (may be missing) or Position()
-    Position findField(StringData name) const;
+    Position findField(StringData name) const {
+        Position pos = findLoadedField(name);
+        if (MONGO_unlikely(!pos.found() && hasUnloadedFields()))
+            return loadLazyFields(name, false);
+        return pos;
+    }
 
     // Document uses these
     const ValueElement& getField(Position pos) const {
@@ -254,14 +262,48 @@ public:
 
     /// This skips missing values
     DocumentStorageIterator iterator() const {
+        loadAllLazyFields();
         return DocumentStorageIterator(_firstElement, end(), false);
     }
 
     /// This includes missing values
     DocumentStorageIterator iteratorAll() const {
+        loadAllLazyFields();
         return DocumentStorageIterator(_firstElement, end(), true);
     }
 
+    /// Like iterator(), but does not convert any fields still waiting in the backing BSONObj.
+    DocumentStorageIterator loadedFieldsIterator() const {
+        return DocumentStorageIterator(_firstElement, end(), false);
+    }
+
+    /**
+     * Makes this storage lazily backed by 'bson', which must be owned. Its top-level fields are
+     * converted to Values in order, only as far as needed to answer a lookup by name; iterating
+     * the document converts everything that is left. If 'withMetaData' is true, top-level
+     * metadata fields are parsed out as in Document::fromBsonWithMetaData().
+     *
+     * Only valid on a new DocumentStorage. Callers that modify the storage in place must call
+     * loadAllLazyFields() first, as MutableDocument does.
+     */
+    void setLazyBson(const BSONObj& bson, bool withMetaData);
+
+    /// True if some fields of the backing BSONObj have not been converted yet.
+    bool hasUnloadedFields() const {
+        return _lazyBsonOffset != 0;
+    }
+
+    /// Bytes of the backing BSONObj that have not been converted yet.
+    size_t unloadedBsonBytes() const {
+        return hasUnloadedFields() ? _lazyBson.objsize() - _lazyBsonOffset : 0;
+    }
+
+    /// Converts whatever is left of the backing BSONObj. Cheap if nothing is.
+    void loadAllLazyFields() const {
+        if (MONGO_unlikely(hasUnloadedFields()))
+            loadLazyFields(StringData(), true);
+    }
+
     /// Shallow copy of this. Caller owns memory.
     boost::intrusive_ptr<DocumentStorage> clone() const;
 
@@ -305,6 +347,20 @@ public:
     }
 
 private:
+    /// Only looks at fields that have already been converted.
+    Position findLoadedField(StringData name) const;
+
+    /**
+     * Converts fields of the backing BSONObj until one named 'requested' is appended, returning
+     * its position, or until there are none left. If 'all' is true, 'requested' is ignored.
+     */
+    Position loadLazyFields(StringData requested, bool all) const;
+
+    /// Unlike iteratorAll(), does not convert anything. Used by the members that maintain _buffer.
+    DocumentStorageIterator loadedFieldsIteratorAll() const {
+        return DocumentStorageIterator(_firstElement, end(), true);
+    }
+
     /// Same as lastElement->next() or firstElement() if empty.
     const ValueElement* end() const {
         return _firstElement ? _firstElement->plusBytes(_usedBytes) : nullptr;
@@ -348,7 +404,7 @@ private:
     /// Adds all fields to the hash table
     void rehash() {
         hashTabInit();
-        for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance())
+        for (DocumentStorageIterator it = loadedFieldsIteratorAll(); !it.atEnd(); it.advance())
             addFieldToHashTable(it.position());
     }
 
@@ -385,6 +441,12 @@ private:
     std::bitset<MetaType::NUM_FIELDS> _metaFields;
     double _textScore;
     double _randVal;
+
+    // Top-level fields of _lazyBson starting at _lazyBsonOffset have not been appended to _buffer
+    // yet. An offset of 0 means there are none, and _lazyBson is then released.
+    BSONObj _lazyBson;
+    unsigned _lazyBsonOffset;
+    bool _lazyBsonHasMetaData;  // skip top-level metadata fields, they are already parsed
     // When adding a field, make sure to update clone() method
 
     // Defined in document.cpp
@@ -83,6 +83,29 @@ const char* DocumentSource::getSourceName() const {
     return unknown;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSource::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    if (_pendingBatchStatus) {
+        auto status = *_pendingBatchStatus;
+        _pendingBatchStatus = boost::none;
+        return status;
+    }
+
+    const size_t initialSize = batch->size();
+    while (batch->size() - initialSize < maxDocs) {
+        auto next = getNext();
+        if (!next.isAdvanced()) {
+            if (batch->size() == initialSize) {
+                return next.getStatus();
+            }
+            _pendingBatchStatus = next.getStatus();
+            break;
+        }
+        batch->push_back(next.releaseDocument());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSource::setSource(DocumentSource* pTheSource) {
     verify(!isValidInitialSource());
     pSource = pTheSource;
@@ -207,6 +207,18 @@ public:
      */
     virtual GetNextResult getNext() = 0;
 
+    /**
+     * Batched form of getNext(). Appends up to 'maxDocs' results to 'batch' and returns kAdvanced
+     * if it appended at least one, or else the kEOF or kPauseExecution status that was reached
+     * first. A status reached after some results were appended is returned by the next call.
+     *
+     * The default implementation calls getNext() repeatedly. Streaming stages can override it to
+     * process the whole batch from their child at once, which saves a virtual call and a
+     * GetNextResult per document and stage. A consumer must use either getNext() or
+     * getNextBatch() on a given stage, not both.
+     */
+    virtual GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs);
+
     /**
      * Inform the source that it is no longer needed and may release its resources.  After
      * dispose() is called the source must still be able to handle iteration requests, but may
@@ -257,6 +269,15 @@ public:
         return false;
     }
 
+    /**
+     * Returns true if this stage uses its OperationContext for more than checking for interrupts,
+     * for example to draw from the random number generator of its Client. Such stages must run on
+     * the thread executing the operation.
+     */
+    virtual bool usesOperationContext() const {
+        return false;
+    }
+
     /**
      * Returns true if the DocumentSource needs to be run on the primary shard.
      */
@@ -467,6 +488,9 @@ protected:
     boost::intrusive_ptr<ExpressionContext> pExpCtx;
 
 private:
+    // Set by the default getNextBatch() when a batch ends on a status it cannot return yet.
+    boost::optional<GetNextResult::ReturnStatus> _pendingBatchStatus;
+
     /**
      * Create a Value that represents the document source.
      *
@@ -542,6 +566,11 @@ public:
                                         bool includeHistograms,
                                         BSONObjBuilder* builder) const = 0;
 
+        /**
+         * Returns the execution statistics aggregated for each query shape run on "nss".
+         */
+        virtual std::vector<BSONObj> getQueryStats(const NamespaceString& nss) const = 0;
+
         /**
          * Appends storage statistics for collection "nss" to "builder"
          */
@@ -554,6 +583,12 @@ public:
          */
         virtual BSONObj getCollectionOptions(const NamespaceString& nss) = 0;
 
+        /**
+         * Returns the specs of the indexes on the collection given by 'nss', or an empty list if
+         * the collection does not exist.
+         */
+        virtual std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) = 0;
+
         /**
          * Performs the given rename command if the collection given by 'targetNs' has the same
          * options as specified in 'originalCollectionOptions', and has the same indexes as
@@ -581,6 +616,11 @@ public:
     DocumentSourceNeedsMongod(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : DocumentSource(expCtx) {}
 
+    // Accessing mongod goes through the operation's context.
+    bool usesOperationContext() const override {
+        return true;
+    }
+
     void injectMongodInterface(std::shared_ptr<MongodInterface> mongod) {
         _mongod = mongod;
         doInjectMongodInterface(mongod);
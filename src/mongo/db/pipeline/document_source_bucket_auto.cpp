@@ -58,18 +58,41 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::getNext() {
         }
         invariant(populationResult.isEOF());
 
-        populateBuckets();
-
+        initializeBucketIteration();
         _populated = true;
-        _bucketsIterator = _buckets.begin();
     }
 
-    if (_bucketsIterator == _buckets.end()) {
-        dispose();
-        return GetNextResult::makeEOF();
+    // A bucket is returned once the bucket after it has been populated, since the boundaries of
+    // adjacent buckets depend on each other. So at most two buckets are in memory at a time.
+    while (auto nextBucket = populateNextBucket()) {
+        if (!_pendingBucket) {
+            if (_granularityRounder) {
+                // If we have a granularity, we round the first bucket's minimum down and the last
+                // bucket's maximum up. This way all of the bucket boundaries are rounded to
+                // numbers in the granularity specification.
+                nextBucket->_min = _granularityRounder->roundDown(nextBucket->_min);
+            }
+            _pendingBucket = std::move(nextBucket);
+            continue;
+        }
+
+        updateBoundaries(*_pendingBucket, *nextBucket);
+        auto out = makeDocument(*_pendingBucket);
+        _pendingBucket = std::move(nextBucket);
+        return out;
+    }
+
+    if (_pendingBucket) {
+        if (_granularityRounder) {
+            _pendingBucket->_max = _granularityRounder->roundUp(_pendingBucket->_max);
+        }
+        auto out = makeDocument(*_pendingBucket);
+        _pendingBucket = boost::none;
+        return out;
     }
 
-    return makeDocument(*(_bucketsIterator++));
+    dispose();
+    return GetNextResult::makeEOF();
 }
 
 DocumentSource::GetDepsReturn DocumentSourceBucketAuto::getDependencies(DepsTracker* deps) const {
@@ -157,115 +180,98 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
     }
 }
 
-void DocumentSourceBucketAuto::populateBuckets() {
+void DocumentSourceBucketAuto::initializeBucketIteration() {
     invariant(_sorter);
     _sortedInput.reset(_sorter->done());
     _sorter.reset();
 
-    // If there are no buckets, then we don't need to populate anything.
-    if (_nBuckets == 0) {
-        return;
-    }
-
     // Calculate the approximate bucket size. We attempt to fill each bucket with this many
     // documents.
-    long long approxBucketSize = std::round(double(_nDocuments) / double(_nBuckets));
+    _approxBucketSize = std::round(double(_nDocuments) / double(_nBuckets));
 
-    if (approxBucketSize < 1) {
+    if (_approxBucketSize < 1) {
         // If the number of buckets is larger than the number of documents, then we try to make as
         // many buckets as possible by placing each document in its own bucket.
-        approxBucketSize = 1;
+        _approxBucketSize = 1;
     }
+}
 
-    boost::optional<pair<Value, Document>> firstEntryInNextBucket;
-
-    // Start creating and populating the buckets.
-    for (int i = 0; i < _nBuckets; i++) {
-        bool isLastBucket = (i == _nBuckets - 1);
+boost::optional<pair<Value, Document>> DocumentSourceBucketAuto::nextSortedEntry() {
+    return _sortedInput->more() ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+                                : boost::none;
+}
 
-        // Get the first value to place in this bucket.
-        pair<Value, Document> currentValue;
-        if (firstEntryInNextBucket) {
-            currentValue = *firstEntryInNextBucket;
-            firstEntryInNextBucket = boost::none;
-        } else if (_sortedInput->more()) {
-            currentValue = _sortedInput->next();
-        } else {
-            // No more values to process.
-            break;
-        }
+boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::populateNextBucket() {
+    // There are no more buckets if we have made as many as allowed, or have been disposed.
+    if (_nBucketsPopulated == _nBuckets || !_sortedInput) {
+        return boost::none;
+    }
+    bool isLastBucket = (_nBucketsPopulated == _nBuckets - 1);
+
+    // Get the first value to place in this bucket.
+    pair<Value, Document> currentValue;
+    if (_firstEntryInNextBucket) {
+        currentValue = std::move(*_firstEntryInNextBucket);
+        _firstEntryInNextBucket = boost::none;
+    } else if (_sortedInput->more()) {
+        currentValue = _sortedInput->next();
+    } else {
+        // No more values to process.
+        return boost::none;
+    }
 
-        // Initialize the current bucket.
-        Bucket currentBucket(
-            pExpCtx, currentValue.first, currentValue.first, _accumulatorFactories);
+    // Initialize the current bucket.
+    Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatorFactories);
 
-        // Add the first value into the current bucket.
-        addDocumentToBucket(currentValue, currentBucket);
+    // Add the first value into the current bucket.
+    addDocumentToBucket(currentValue, currentBucket);
 
-        if (isLastBucket) {
-            // If this is the last bucket allowed, we need to put any remaining documents in
-            // the current bucket.
-            while (_sortedInput->more()) {
+    if (isLastBucket) {
+        // If this is the last bucket allowed, we need to put any remaining documents in the
+        // current bucket.
+        while (_sortedInput->more()) {
+            addDocumentToBucket(_sortedInput->next(), currentBucket);
+        }
+    } else {
+        // We go to _approxBucketSize - 1 because we already added the first value in order to
+        // keep track of the minimum value.
+        for (long long j = 0; j < _approxBucketSize - 1; j++) {
+            if (_sortedInput->more()) {
                 addDocumentToBucket(_sortedInput->next(), currentBucket);
+            } else {
+                // No more values to process.
+                break;
             }
-        } else {
-            // We go to approxBucketSize - 1 because we already added the first value in order
-            // to keep track of the minimum value.
-            for (long long j = 0; j < approxBucketSize - 1; j++) {
-                if (_sortedInput->more()) {
-                    addDocumentToBucket(_sortedInput->next(), currentBucket);
-                } else {
-                    // No more values to process.
-                    break;
-                }
-            }
+        }
 
-            boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
-                ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                : boost::none;
+        auto nextValue = nextSortedEntry();
 
-            if (_granularityRounder) {
-                Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
-                // If there are any values that now fall into this bucket after we round the
-                // boundary, absorb them into this bucket too.
-                while (nextValue &&
-                       pExpCtx->getValueComparator().evaluate(boundaryValue > nextValue->first)) {
-                    addDocumentToBucket(*nextValue, currentBucket);
-                    nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                        : boost::none;
-                }
-                if (nextValue) {
-                    currentBucket._max = boundaryValue;
-                }
-            } else {
-                // If there are any more values that are equal to the boundary value, then absorb
-                // them into the current bucket too.
-                while (nextValue &&
-                       pExpCtx->getValueComparator().evaluate(currentBucket._max ==
-                                                              nextValue->first)) {
-                    addDocumentToBucket(*nextValue, currentBucket);
-                    nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                        : boost::none;
-                }
+        if (_granularityRounder) {
+            Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
+            // If there are any values that now fall into this bucket after we round the boundary,
+            // absorb them into this bucket too.
+            while (nextValue &&
+                   pExpCtx->getValueComparator().evaluate(boundaryValue > nextValue->first)) {
+                addDocumentToBucket(*nextValue, currentBucket);
+                nextValue = nextSortedEntry();
+            }
+            if (nextValue) {
+                currentBucket._max = boundaryValue;
+            }
+        } else {
+            // If there are any more values that are equal to the boundary value, then absorb them
+            // into the current bucket too.
+            while (nextValue &&
+                   pExpCtx->getValueComparator().evaluate(currentBucket._max == nextValue->first)) {
+                addDocumentToBucket(*nextValue, currentBucket);
+                nextValue = nextSortedEntry();
             }
-            firstEntryInNextBucket = nextValue;
         }
-
-        // Add the current bucket to the vector of buckets.
-        addBucket(currentBucket);
+        _firstEntryInNextBucket = std::move(nextValue);
     }
 
-    if (!_buckets.empty() && _granularityRounder) {
-        // If we we have a granularity, we round the first bucket's minimum down and the last
-        // bucket's maximum up. This way all of the bucket boundaries are rounded to numbers in the
-        // granularity specification.
-        Bucket& firstBucket = _buckets.front();
-        Bucket& lastBucket = _buckets.back();
-        firstBucket._min = _granularityRounder->roundDown(firstBucket._min);
-        lastBucket._max = _granularityRounder->roundUp(lastBucket._max);
-    }
+    _nBucketsPopulated++;
+    return std::move(currentBucket);
 }
 
 DocumentSourceBucketAuto::Bucket::Bucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -279,35 +285,31 @@ DocumentSourceBucketAuto::Bucket::Bucket(const boost::intrusive_ptr<ExpressionCo
     }
 }
 
-void DocumentSourceBucketAuto::addBucket(Bucket& newBucket) {
-    if (!_buckets.empty()) {
-        Bucket& previous = _buckets.back();
-        if (_granularityRounder) {
-            // If we have a granularity specified and if there is a bucket that comes before the new
-            // bucket being added, then the new bucket's min boundary is updated to be the
-            // previous bucket's max boundary. This makes it so that bucket boundaries follow the
-            // granularity, have inclusive minimums, and have exclusive maximums.
-
-            double prevMax = previous._max.coerceToDouble();
-            if (prevMax == 0.0) {
-                // Handle the special case where the largest value in the first bucket is zero. In
-                // this case, we take the minimum boundary of the second bucket and round it down.
-                // We then set the maximum boundary of the first bucket to be the rounded down
-                // value. This maintains that the maximum boundary of the first bucket is exclusive
-                // and the minimum boundary of the second bucket is inclusive.
-                previous._max = _granularityRounder->roundDown(newBucket._min);
-            }
-
-            newBucket._min = previous._max;
-        } else {
-            // If there is a bucket that comes before the new bucket being added, then the previous
-            // bucket's max boundary is updated to the new bucket's min. This makes it so that
-            // buckets' min boundaries are inclusive and max boundaries are exclusive (except for
-            // the last bucket, which has an inclusive max).
-            previous._max = newBucket._min;
+void DocumentSourceBucketAuto::updateBoundaries(Bucket& previous, Bucket& newBucket) {
+    if (_granularityRounder) {
+        // If we have a granularity specified and if there is a bucket that comes before the new
+        // bucket being added, then the new bucket's min boundary is updated to be the
+        // previous bucket's max boundary. This makes it so that bucket boundaries follow the
+        // granularity, have inclusive minimums, and have exclusive maximums.
+
+        double prevMax = previous._max.coerceToDouble();
+        if (prevMax == 0.0) {
+            // Handle the special case where the largest value in the first bucket is zero. In
+            // this case, we take the minimum boundary of the second bucket and round it down.
+            // We then set the maximum boundary of the first bucket to be the rounded down
+            // value. This maintains that the maximum boundary of the first bucket is exclusive
+            // and the minimum boundary of the second bucket is inclusive.
+            previous._max = _granularityRounder->roundDown(newBucket._min);
         }
+
+        newBucket._min = previous._max;
+    } else {
+        // If there is a bucket that comes before the new bucket being added, then the previous
+        // bucket's max boundary is updated to the new bucket's min. This makes it so that
+        // buckets' min boundaries are inclusive and max boundaries are exclusive (except for
+        // the last bucket, which has an inclusive max).
+        previous._max = newBucket._min;
     }
-    _buckets.push_back(newBucket);
 }
 
 Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
@@ -329,7 +331,8 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::dispose() {
     _sortedInput.reset();
-    _bucketsIterator = _buckets.end();
+    _pendingBucket = boost::none;
+    _firstEntryInNextBucket = boost::none;
     pSource->dispose();
 }
 
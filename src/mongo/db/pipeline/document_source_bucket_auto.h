@@ -116,9 +116,22 @@ private:
     Value extractKey(const Document& doc);
 
     /**
-     * Calculates the bucket boundaries for the input documents and places them into buckets.
+     * Finishes sorting the input documents and calculates the approximate number of documents to
+     * place in each bucket.
      */
-    void populateBuckets();
+    void initializeBucketIteration();
+
+    /**
+     * Places the next run of sorted input documents into a bucket and returns it, or returns
+     * boost::none if there are no more buckets. The boundaries of the returned bucket are not
+     * final until they have been updated by updateBoundaries() against the bucket after it.
+     */
+    boost::optional<Bucket> populateNextBucket();
+
+    /**
+     * Returns the next sorted input document along with its 'groupBy' value, or boost::none.
+     */
+    boost::optional<std::pair<Value, Document>> nextSortedEntry();
 
     /**
      * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
@@ -126,9 +139,9 @@ private:
     void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
 
     /**
-     * Adds 'newBucket' to _buckets and updates any boundaries if necessary.
+     * Updates the boundaries of 'previous' and 'newBucket', which follows it, if necessary.
      */
-    void addBucket(Bucket& newBucket);
+    void updateBoundaries(Bucket& previous, Bucket& newBucket);
 
     /**
      * Makes a document using the information from bucket. This is what is returned when getNext()
@@ -150,8 +163,14 @@ private:
     int _nBuckets;
     uint64_t _maxMemoryUsageBytes;
     bool _populated = false;
-    std::vector<Bucket> _buckets;
-    std::vector<Bucket>::iterator _bucketsIterator;
+    long long _approxBucketSize = 0;
+    int _nBucketsPopulated = 0;
+
+    // The first document of the bucket after the last one populated, if it has been read already.
+    boost::optional<std::pair<Value, Document>> _firstEntryInNextBucket;
+
+    // The last bucket populated, which is returned once the bucket after it has been populated.
+    boost::optional<Bucket> _pendingBucket;
     std::unique_ptr<Variables> _variables;
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
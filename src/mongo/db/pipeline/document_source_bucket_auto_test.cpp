@@ -386,6 +386,45 @@ TEST_F(BucketAutoTests, ShouldBeAbleToCorrectlySpillToDisk) {
     ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
 }
 
+TEST_F(BucketAutoTests, ShouldStreamManyBucketsOfSpilledInput) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceBucketAutoTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->extSortAllowed = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$a", vps);
+
+    const int numBuckets = 50;
+    auto bucketAutoStage = DocumentSourceBucketAuto::create(expCtx,
+                                                            groupByExpression,
+                                                            idGen.getIdCount(),
+                                                            numBuckets,
+                                                            {},
+                                                            nullptr,
+                                                            maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 99; i >= 0; --i) {
+        inputs.push_back(Document{{"a", i}, {"largeStr", largeStr}});
+    }
+    auto mock = DocumentSourceMock::create(std::move(inputs));
+    bucketAutoStage->setSource(mock.get());
+
+    for (int i = 0; i < numBuckets; ++i) {
+        auto next = bucketAutoStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        int max = (i == numBuckets - 1) ? 99 : 2 * i + 2;
+        Document expected{{"_id", Document{{"min", 2 * i}, {"max", max}}}, {"count", 2}};
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    }
+
+    ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
+}
+
 TEST_F(BucketAutoTests, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto expCtx = getExpCtx();
 
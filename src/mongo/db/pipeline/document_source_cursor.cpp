@@ -30,6 +30,9 @@
 
 #include "mongo/db/pipeline/document_source_cursor.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -65,6 +68,24 @@ DocumentSource::GetNextResult DocumentSourceCursor::getNext() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceCursor::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    pExpCtx->checkForInterrupt();
+
+    if (_currentBatch.empty()) {
+        loadBatch();
+
+        if (_currentBatch.empty())
+            return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    const size_t numDocs = std::min(maxDocs, _currentBatch.size());
+    auto end = _currentBatch.begin() + numDocs;
+    std::move(_currentBatch.begin(), end, std::back_inserter(*batch));
+    _currentBatch.erase(_currentBatch.begin(), end);
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSourceCursor::dispose() {
     _exec.reset();
     _currentBatch.clear();
@@ -83,6 +104,7 @@ void DocumentSourceCursor::loadBatch() {
     _exec->restoreState();
 
     int memUsageBytes = 0;
+    const bool lazyDocuments = internalDocumentSourceCursorLazyDocuments.load();
     BSONObj obj;
     PlanExecutor::ExecState state;
     {
@@ -93,6 +115,8 @@ void DocumentSourceCursor::loadBatch() {
                 _currentBatch.push_back(Document());
             } else if (_dependencies) {
                 _currentBatch.push_back(_dependencies->extractFields(obj));
+            } else if (lazyDocuments) {
+                _currentBatch.push_back(Document::fromBsonWithMetaDataLazily(obj));
             } else {
                 _currentBatch.push_back(Document::fromBsonWithMetaData(obj));
             }
@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
+#include <exception>
 #include <memory>
 #include <vector>
 
@@ -37,6 +39,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/client.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -44,8 +47,14 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/chrono.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -113,6 +122,28 @@ vector<pair<string, vector<BSONObj>>> extractRawPipelines(const BSONElement& ele
     }
     return rawFacetPipelines;
 }
+
+/**
+ * Returns the pool which runs the sub-pipelines of every $facet stage with parallelism enabled.
+ * Sharing it bounds the number of threads however many such stages are running, and gives each of
+ * them a Client of its own.
+ */
+ThreadPool* getFacetWorkerPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "FacetWorkers";
+        options.threadNamePrefix = "facet-worker-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(std::max(1, internalQueryFacetWorkerThreads));
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+        };
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
 }  // namespace
 
 std::unique_ptr<DocumentSourceFacet::LiteParsed> DocumentSourceFacet::LiteParsed::parse(
@@ -157,7 +188,13 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     }
 
     vector<vector<Value>> results(_facets.size());
+    const size_t parallelism = std::min(
+        _facets.size(), static_cast<size_t>(std::max(1, internalQueryFacetMaxParallelism.load())));
     bool allPipelinesEOF = false;
+    if (parallelism > 1) {
+        allPipelinesEOF = runFacetsConcurrently(parallelism, &results);
+    }
+
     while (!allPipelinesEOF) {
         allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
         for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
@@ -179,6 +216,117 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     return resultDoc.freeze();
 }
 
+bool DocumentSourceFacet::runFacetsConcurrently(size_t nThreads, vector<vector<Value>>* results) {
+    // Facets which use the operation's context run on this thread, the others on the worker pool.
+    vector<size_t> operationThreadFacets;
+    vector<size_t> workerFacets;
+    for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+        const auto& sources = _facets[facetId].pipeline->getSources();
+        const bool usesOperationContext =
+            std::any_of(sources.begin(), sources.end(), [](const intrusive_ptr<DocumentSource>& s) {
+                return s->usesOperationContext();
+            });
+        (usesOperationContext ? operationThreadFacets : workerFacets).push_back(facetId);
+    }
+    if (workerFacets.empty()) {
+        return false;
+    }
+
+    // This thread counts towards 'nThreads' when it has facets of its own to run.
+    const size_t nTasks =
+        std::min(workerFacets.size(),
+                 std::max<size_t>(1, nThreads - (operationThreadFacets.empty() ? 0 : 1)));
+
+    vector<char> facetEOF(_facets.size(), false);
+    AtomicWord<ErrorCodes::Error> killCode(ErrorCodes::OK);
+
+    while (std::find(facetEOF.begin(), facetEOF.end(), false) != facetEOF.end()) {
+        // Once the input is exhausted the buffer stays empty, and the facets which were paused
+        // receive EOF in the next round.
+        _teeBuffer->loadNextBatchForConcurrentConsumers();
+
+        AtomicWord<size_t> nextWorkerFacet(0);
+        stdx::mutex mutex;
+        stdx::condition_variable taskDone;
+        size_t nTasksRunning = nTasks;
+        std::exception_ptr firstException;
+
+        auto runFacet = [&](size_t facetId) {
+            auto& lastStage = _facets[facetId].pipeline->getSources().back();
+            auto next = lastStage->getNext();
+            for (; next.isAdvanced(); next = lastStage->getNext()) {
+                (*results)[facetId].emplace_back(next.releaseDocument());
+            }
+            facetEOF[facetId] = next.isEOF();
+        };
+
+        auto recordException = [&] {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (!firstException) {
+                firstException = std::current_exception();
+            }
+            // Stop the other facets as well.
+            killCode.compareAndSwap(ErrorCodes::OK, ErrorCodes::Interrupted);
+        };
+
+        auto runWorkerFacets = [&] {
+            try {
+                ExpressionContext::WorkerThreadInterruptScope interruptScope(&killCode);
+                for (size_t i = nextWorkerFacet.fetchAndAdd(1); i < workerFacets.size();
+                     i = nextWorkerFacet.fetchAndAdd(1)) {
+                    if (!facetEOF[workerFacets[i]]) {
+                        runFacet(workerFacets[i]);
+                    }
+                }
+            } catch (...) {
+                recordException();
+            }
+
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --nTasksRunning;
+            taskDone.notify_one();
+        };
+
+        for (size_t i = 0; i < nTasks; ++i) {
+            if (!getFacetWorkerPool()->schedule(runWorkerFacets).isOK()) {
+                // The pool is shutting down, so do the work here instead.
+                runWorkerFacets();
+            }
+        }
+
+        try {
+            for (auto&& facetId : operationThreadFacets) {
+                if (!facetEOF[facetId] && killCode.load() == ErrorCodes::OK) {
+                    runFacet(facetId);
+                }
+            }
+        } catch (...) {
+            recordException();
+        }
+
+        // The tasks refer to this frame, so wait for all of them even if this thread has failed.
+        {
+            stdx::unique_lock<stdx::mutex> lk(mutex);
+            while (nTasksRunning > 0) {
+                taskDone.wait_for(lk, stdx::chrono::milliseconds(10));
+                if (pExpCtx->opCtx) {
+                    auto interruptStatus = pExpCtx->opCtx->checkForInterruptNoAssert();
+                    if (!interruptStatus.isOK()) {
+                        killCode.compareAndSwap(ErrorCodes::OK, interruptStatus.code());
+                    }
+                }
+            }
+        }
+
+        if (firstException) {
+            std::rethrow_exception(firstException);
+        }
+        // The operation may have been interrupted after the last task finished.
+        pExpCtx->checkForInterrupt();
+    }
+    return true;
+}
+
 Value DocumentSourceFacet::serialize(bool explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -137,6 +137,18 @@ private:
 
     Value serialize(bool explain = false) const final;
 
+    /**
+     * Runs all sub-pipelines to completion on up to 'nThreads' threads, appending the output of
+     * each to the corresponding entry of 'results'. Sub-pipelines with a stage which uses the
+     * operation's context run on this thread, the others on a shared pool of worker threads. Each
+     * round, all of them consume the current batch of '_teeBuffer', which is then refilled on this
+     * thread once they have all paused. Interrupts of the operation are forwarded to the workers,
+     * and the first exception thrown by a sub-pipeline is rethrown here.
+     *
+     * Returns false without running anything if every sub-pipeline has to run on this thread.
+     */
+    bool runFacetsConcurrently(size_t nThreads, std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
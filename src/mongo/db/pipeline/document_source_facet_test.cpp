@@ -31,6 +31,7 @@
 #include "mongo/db/pipeline/document_source_facet.h"
 
 #include <deque>
+#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -43,8 +44,11 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -282,6 +286,126 @@ TEST_F(DocumentSourceFacetTest,
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ShouldProduceTheSameResultsWhenRunningFacetsConcurrently) {
+    auto ctx = getExpCtx();
+
+    const auto originalParallelism = internalQueryFacetMaxParallelism.load();
+    const auto originalBufferSize = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetMaxParallelism.store(originalParallelism);
+        internalQueryFacetBufferSizeBytes.store(originalBufferSize);
+    });
+    internalQueryFacetMaxParallelism.store(4);
+    // Buffer one document at a time, so that the facets go through several rounds.
+    internalQueryFacetBufferSizeBytes.store(1);
+
+    auto passthroughPipe =
+        uassertStatusOK(Pipeline::create({DocumentSourcePassthrough::create()}, ctx));
+    auto limitedPipe =
+        uassertStatusOK(Pipeline::create({DocumentSourceLimit::create(ctx, 1)}, ctx));
+    auto skippedPipe =
+        uassertStatusOK(Pipeline::create({DocumentSourceSkip::create(ctx, 2)}, ctx));
+
+    auto facetStage = DocumentSourceFacet::create(
+        {{"all", passthroughPipe}, {"first", limitedPipe}, {"rest", skippedPipe}}, ctx);
+
+    deque<DocumentSource::GetNextResult> inputs = {
+        Document{{"_id", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}}, Document{{"_id", 3}}};
+    auto mock = DocumentSourceMock::create(inputs);
+    facetStage->setSource(mock.get());
+
+    vector<Value> expectedPassthroughOutput;
+    for (auto&& input : inputs) {
+        expectedPassthroughOutput.emplace_back(input.getDocument());
+    }
+    auto output = facetStage->getNext();
+
+    ASSERT(output.isAdvanced());
+    ASSERT_EQ(output.getDocument().size(), 3UL);
+    ASSERT_VALUE_EQ(output.getDocument()["all"], Value(expectedPassthroughOutput));
+    ASSERT_VALUE_EQ(output.getDocument()["first"],
+                    Value(vector<Value>{Value(expectedPassthroughOutput.front())}));
+    ASSERT_VALUE_EQ(output.getDocument()["rest"],
+                    Value(vector<Value>(expectedPassthroughOutput.begin() + 2,
+                                        expectedPassthroughOutput.end())));
+
+    // Should be exhausted now.
+    ASSERT(facetStage->getNext().isEOF());
+    ASSERT(facetStage->getNext().isEOF());
+}
+
+/**
+ * A passthrough stage which claims to use the OperationContext, and records the thread it was
+ * pulled from.
+ */
+class DocumentSourceUsesOpCtx : public DocumentSourceMock {
+public:
+    DocumentSourceUsesOpCtx() : DocumentSourceMock({}) {}
+
+    bool isValidInitialSource() const final {
+        return false;
+    }
+
+    bool usesOperationContext() const final {
+        return true;
+    }
+
+    DocumentSource::GetNextResult getNext() final {
+        threadsSeen.insert(stdx::this_thread::get_id());
+        return pSource->getNext();
+    }
+
+    static boost::intrusive_ptr<DocumentSourceUsesOpCtx> create() {
+        return new DocumentSourceUsesOpCtx();
+    }
+
+    std::set<stdx::thread::id> threadsSeen;
+};
+
+TEST_F(DocumentSourceFacetTest, ShouldRunFacetsUsingTheOperationContextOnTheOperationThread) {
+    auto ctx = getExpCtx();
+
+    const auto originalParallelism = internalQueryFacetMaxParallelism.load();
+    const auto originalBufferSize = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetMaxParallelism.store(originalParallelism);
+        internalQueryFacetBufferSizeBytes.store(originalBufferSize);
+    });
+    internalQueryFacetMaxParallelism.store(4);
+    internalQueryFacetBufferSizeBytes.store(1);
+
+    auto usesOpCtx = DocumentSourceUsesOpCtx::create();
+    auto opCtxPipe = uassertStatusOK(Pipeline::create({usesOpCtx}, ctx));
+    auto firstPassthroughPipe =
+        uassertStatusOK(Pipeline::create({DocumentSourcePassthrough::create()}, ctx));
+    auto secondPassthroughPipe =
+        uassertStatusOK(Pipeline::create({DocumentSourcePassthrough::create()}, ctx));
+
+    auto facetStage = DocumentSourceFacet::create(
+        {{"opCtx", opCtxPipe}, {"first", firstPassthroughPipe}, {"second", secondPassthroughPipe}},
+        ctx);
+
+    deque<DocumentSource::GetNextResult> inputs = {
+        Document{{"_id", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}}};
+    auto mock = DocumentSourceMock::create(inputs);
+    facetStage->setSource(mock.get());
+
+    vector<Value> expectedOutput;
+    for (auto&& input : inputs) {
+        expectedOutput.emplace_back(input.getDocument());
+    }
+
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT_VALUE_EQ(output.getDocument()["opCtx"], Value(expectedOutput));
+    ASSERT_VALUE_EQ(output.getDocument()["first"], Value(expectedOutput));
+    ASSERT_VALUE_EQ(output.getDocument()["second"], Value(expectedOutput));
+    ASSERT(facetStage->getNext().isEOF());
+
+    ASSERT_EQ(usesOpCtx->threadsSeen.size(), 1UL);
+    ASSERT(*usesOpCtx->threadsSeen.begin() == stdx::this_thread::get_id());
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSubPipeline) {
     auto ctx = getExpCtx();
 
@@ -40,6 +40,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/stdx/memory.h"
 
@@ -385,7 +386,11 @@ BSONObjSet DocumentSourceGraphLookUp::getOutputSorts() {
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
     // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
     uassert(40099,
-            "$graphLookup reached maximum memory consumption",
+            str::stream() << "$graphLookup reached maximum memory consumption of "
+                          << _maxMemoryUsageBytes
+                          << " bytes, see internalDocumentSourceGraphLookupMaxMemoryBytes; "
+                          << "consider restricting the search with maxDepth or "
+                          << "restrictSearchWithMatch",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
@@ -458,6 +463,7 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
       _cache(pExpCtx->getValueComparator()),
@@ -178,7 +178,9 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    // Set from internalDocumentSourceGraphLookupMaxMemoryBytes on construction. Memory used by
+    // '_cache' does not count against this limit, since the cache is shrunk as needed instead.
+    const size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -37,9 +37,11 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/stub_mongod_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -244,6 +246,40 @@ TEST_F(DocumentSourceGraphLookUpTest,
     }
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldErrorWhenExceedingMaxMemoryUsage) {
+    const int oldMaxMemoryBytes = internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([oldMaxMemoryBytes] {
+        internalDocumentSourceGraphLookupMaxMemoryBytes.store(oldMaxMemoryBytes);
+    });
+    internalDocumentSourceGraphLookupMaxMemoryBytes.store(1);
+
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::create(std::move(inputs));
+
+    std::deque<DocumentSource::GetNextResult> fromContents{Document{{"_id", 1}, {"to", 0}}};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx, "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+    graphLookupStage->injectMongodInterface(
+        std::make_shared<MockMongodImplementation>(std::move(fromContents)));
+
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), UserException, 40099);
+}
+
 TEST_F(DocumentSourceGraphLookUpTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
 
@@ -28,6 +28,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -70,10 +72,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
         accum->reset();  // Prep accumulators for a new group.
     }
 
-    if (_spilled) {
-        return getNextSpilled();
-    } else if (_streaming) {
+    if (_streaming) {
         return getNextStreaming();
+    } else if (_spilled) {
+        return getNextSpilled();
     } else {
         return getNextStandard();
     }
@@ -127,46 +129,93 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
-    // Streaming optimization is active.
-    if (!_firstDocOfNextGroup) {
-        auto nextInput = pSource->getNext();
-        if (!nextInput.isAdvanced()) {
-            return nextInput;
+    // Streaming optimization is active. A group can only be output once the input has moved past
+    // its run, so read until at least one run has been closed.
+    while (_streamingOutput.empty() && !_streamingInputEOF) {
+        auto input = pSource->getNext();
+        if (input.isEOF()) {
+            // Output what remains of the last run, followed by any groups keyed on arrays. Those
+            // were collected like the groups of a blocking $group, so they are output the same way.
+            closeCurrentRun();
+            prepareGroupsForOutput();
+            _streamingInputEOF = true;
+            break;
         }
-        _firstDocOfNextGroup = nextInput.releaseDocument();
-    }
 
-    Value id;
-    do {
-        // Add to the current accumulator(s).
-        for (size_t i = 0; i < _currentAccumulators.size(); i++) {
-            _currentAccumulators[i]->process(vpExpression[i]->evaluate(_variables.get()),
-                                             _doingMerge);
+        if (!input.isAdvanced()) {
+            return input;
         }
 
-        // Release our references to the previous input document before asking for the next. This
-        // makes operations like $unwind more efficient.
-        _variables->clearRoot();
+        _variables->setRoot(input.releaseDocument());
+        const Value id = computeId(_variables.get());
 
-        // Retrieve the next document.
-        auto nextInput = pSource->getNext();
-        if (!nextInput.isAdvanced()) {
-            return nextInput;
+        if (auto runKey = computeRunKey(_variables->getRoot())) {
+            if (!_currentRun->empty() &&
+                !pExpCtx->getValueComparator().evaluate(_currentRunKey == *runKey)) {
+                closeCurrentRun();
+            }
+            _currentRunKey = std::move(*runKey);
+
+            // The groups of a run are all output when it ends, so they cannot be spilled.
+            accumulateIntoGroup(&*_currentRun, id, &_currentRunMemoryUsageBytes);
+            uassert(40422,
+                    str::stream() << "Exceeded memory limit of " << _maxMemoryUsageBytes
+                                  << " bytes for $group while accumulating the groups of a run of "
+                                     "its sorted input",
+                    _currentRunMemoryUsageBytes <= _maxMemoryUsageBytes);
+        } else {
+            if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                uassert(40423,
+                        "Exceeded memory limit for $group, but didn't allow external sort."
+                        " Pass allowDiskUse:true to opt in.",
+                        _extSortAllowed);
+                _sortedFiles.push_back(spill());
+                _memoryUsageBytes = 0;
+            }
+            accumulateIntoGroup(&*_groups, id, &_memoryUsageBytes);
         }
 
-        _firstDocOfNextGroup = nextInput.releaseDocument();
+        // Release our references to the input document before asking for the next. This makes
+        // operations like $unwind more efficient.
+        _variables->clearRoot();
+    }
 
-        _variables->setRoot(*_firstDocOfNextGroup);
+    if (_streamingOutput.empty()) {
+        return _spilled ? getNextSpilled() : getNextStandard();
+    }
 
-        // Compute the id. If it does not match _currentId, we will exit the loop, leaving
-        // _firstDocOfNextGroup set for the next time getNext() is called.
-        id = computeId(_variables.get());
-    } while (pExpCtx->getValueComparator().evaluate(_currentId == id));
+    Document out = std::move(_streamingOutput.front());
+    _streamingOutput.pop_front();
+    return std::move(out);
+}
 
-    Document out = makeDocument(_currentId, _currentAccumulators, pExpCtx->inShard);
-    _currentId = std::move(id);
+boost::optional<Value> DocumentSourceGroup::computeRunKey(const Document& doc) const {
+    vector<Value> runKey;
+    runKey.reserve(_inputSortPaths.size());
+    for (auto&& path : _inputSortPaths) {
+        Value val = doc.getField(path.getFieldName(0));
+        for (size_t i = 1; i < path.getPathLength() && !val.missing(); i++) {
+            if (val.getType() == Array) {
+                return boost::none;
+            }
+            val = val.getType() == Object ? val.getDocument().getField(path.getFieldName(i))
+                                          : Value();
+        }
 
-    return std::move(out);
+        if (val.getType() == Array) {
+            return boost::none;
+        }
+        runKey.push_back(val.missing() ? Value(BSONNULL) : std::move(val));
+    }
+    return Value(std::move(runKey));
+}
+
+void DocumentSourceGroup::closeCurrentRun() {
+    for (auto&& group : *_currentRun) {
+        _streamingOutput.push_back(makeDocument(group.first, group.second, pExpCtx->inShard));
+    }
+    _currentRun->clear();
+    _currentRunMemoryUsageBytes = 0;
 }
 
 void DocumentSourceGroup::dispose() {
@@ -177,7 +226,9 @@ void DocumentSourceGroup::dispose() {
     // Make us look done.
     groupsIterator = _groups->end();
 
-    _firstDocOfNextGroup = boost::none;
+    _currentRun = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _currentRunMemoryUsageBytes = 0;
+    _streamingOutput.clear();
 
     // Free our source's resources.
     pSource->dispose();
@@ -276,7 +327,8 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _initialized(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
-      _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter) {}
+      _extSortAllowed(pExpCtx->extSortAllowed && !pExpCtx->inRouter),
+      _currentRun(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()) {}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
     vFieldName.push_back(accumulationStatement.fieldName);
@@ -469,27 +521,13 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
     boost::optional<BSONObj> inputSort = findRelevantInputSort();
     if (inputSort) {
-        // We can convert to streaming.
+        // We can convert to streaming. Groups are accumulated as the input is read, so there is
+        // nothing more to prepare.
         _streaming = true;
         _inputSort = *inputSort;
-
-        // Set up accumulators.
-        _currentAccumulators.reserve(numAccumulators);
-        for (size_t i = 0; i < numAccumulators; i++) {
-            _currentAccumulators.push_back(vpAccumulatorFactory[i](pExpCtx));
-        }
-
-        // We only need to load the first document.
-        auto firstInput = pSource->getNext();
-        if (!firstInput.isAdvanced()) {
-            // Leave '_firstDocOfNextGroup' uninitialized and return.
-            return firstInput;
+        for (auto&& sortField : _inputSort) {
+            _inputSortPaths.emplace_back(sortField.fieldName());
         }
-        _firstDocOfNextGroup = firstInput.releaseDocument();
-        _variables->setRoot(*_firstDocOfNextGroup);
-
-        // Compute the _id value.
-        _currentId = computeId(_variables.get());
         _initialized = true;
         return DocumentSource::GetNextResult::makeEOF();
     }
@@ -510,36 +548,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
         _variables->setRoot(input.releaseDocument());
 
-        Value id = computeId(_variables.get());
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (size_t i = 0; i < numAccumulators; i++) {
-                group.push_back(vpAccumulatorFactory[i](pExpCtx));
-            }
-        } else {
-            for (size_t i = 0; i < numAccumulators; i++) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= group[i]->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted =
+            accumulateIntoGroup(&*_groups, computeId(_variables.get()), &_memoryUsageBytes);
 
         // We are done with the ROOT document so release it.
         _variables->clearRoot();
@@ -565,30 +575,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
-
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators.push_back(vpAccumulatorFactory[i](pExpCtx));
-                }
-
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
-            }
+            prepareGroupsForOutput();
 
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
@@ -599,6 +586,72 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+void DocumentSourceGroup::prepareGroupsForOutput() {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
+        }
+
+        // We won't be using groups again so free its memory.
+        _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+
+        _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
+            _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
+
+        // prepare current to accumulate data
+        _currentAccumulators.reserve(numAccumulators);
+        for (size_t i = 0; i < numAccumulators; i++) {
+            _currentAccumulators.push_back(vpAccumulatorFactory[i](pExpCtx));
+        }
+
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    } else {
+        // start the group iterator
+        groupsIterator = _groups->begin();
+    }
+}
+
+bool DocumentSourceGroup::accumulateIntoGroup(GroupsMap* groups,
+                                              const Value& id,
+                                              size_t* memoryUsageBytes) {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in 'groups' multiple times.
+    const size_t oldSize = groups->size();
+    Accumulators& group = (*groups)[id];
+    const bool inserted = groups->size() != oldSize;
+
+    if (inserted) {
+        *memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (size_t i = 0; i < numAccumulators; i++) {
+            group.push_back(vpAccumulatorFactory[i](pExpCtx));
+        }
+    } else {
+        for (size_t i = 0; i < numAccumulators; i++) {
+            // subtract old mem usage. New usage added back after processing.
+            *memoryUsageBytes -= group[i]->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
+        *memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
@@ -639,13 +692,21 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
 }
 
-boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
-    if (true) {
-        // Until streaming $group correctly handles nullish values, the streaming behavior is
-        // disabled. See SERVER-23318.
-        return boost::none;
+bool DocumentSourceGroup::groupsByFieldPaths(const std::set<std::string>& fieldPaths) const {
+    DepsTracker deps(DepsTracker::MetadataAvailable::kNoMetadata);
+    for (auto&& exp : _idExpressions) {
+        // Only plain field paths keep the value of the field itself in the group key; any other
+        // expression could map different values of a field to the same group.
+        if (dynamic_cast<ExpressionFieldPath*>(exp.get())) {
+            exp->addDependencies(&deps);
+        }
     }
 
+    return std::includes(
+        deps.fields.begin(), deps.fields.end(), fieldPaths.begin(), fieldPaths.end());
+}
+
+boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
     if (!pSource) {
         // Sometimes when performing an explain, or using $group as the merge point, 'pSource' will
         // not be set.
@@ -719,7 +780,7 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
     BSONObjBuilder sortOrder;
 
     if (_idFieldNames.empty()) {
-        if (_spilled) {
+        if (!_streaming) {
             sortOrder.append("_id", 1);
         } else {
             // We have an expression like {_id: "$a"}. Check if this is a FieldPath, and if it is,
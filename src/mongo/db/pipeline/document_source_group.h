@@ -28,19 +28,30 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
+#include <deque>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
 
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
 class DocumentSourceGroup final : public DocumentSource, public SplittableDocumentSource {
 public:
-    using Accumulators = std::vector<boost::intrusive_ptr<Accumulator>>;
+    // Most $group stages have only a handful of accumulators, so the pointers for each group are
+    // stored inline in the group's hash table node rather than in a separately allocated buffer.
+    // This saves a heap allocation and a pointer indirection per group, which matters when there
+    // are many distinct groups.
+    static const size_t kNumInlineAccumulators = 4;
+    using Accumulators =
+        boost::container::small_vector<boost::intrusive_ptr<Accumulator>, kNumInlineAccumulators>;
     using GroupsMap = ValueUnorderedMap<Accumulators>;
 
     static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
@@ -92,6 +103,13 @@ public:
         return _streaming;
     }
 
+    /**
+     * Returns true if each of 'fieldPaths' is itself part of the group key, either as the whole
+     * _id or as one of its top-level fields. All documents of a group then have equal values for
+     * those fields.
+     */
+    bool groupsByFieldPaths(const std::set<std::string>& fieldPaths) const;
+
     // Virtuals for SplittableDocumentSource.
     boost::intrusive_ptr<DocumentSource> getShardSource() final;
     boost::intrusive_ptr<DocumentSource> getMergeSource() final;
@@ -116,10 +134,9 @@ private:
     boost::optional<BSONObj> findRelevantInputSort() const;
 
     /**
-     * Before returning anything, this source must prepare itself. In a streaming $group,
-     * initialize() requests the first document from the previous source, and uses it to prepare the
-     * accumulators. In an unsorted $group, initialize() exhausts the previous source before
-     * returning. The '_initialized' boolean indicates that initialize() has finished.
+     * Before returning anything, this source must prepare itself. A streaming $group only records
+     * the input sort it relies on. In an unsorted $group, initialize() exhausts the previous
+     * source before returning. The '_initialized' boolean indicates that initialize() has finished.
      *
      * This method may not be able to finish initialization in a single call if 'pSource' returns a
      * DocumentSource::GetNextResult::kPauseExecution, so it returns the last GetNextResult
@@ -127,6 +144,32 @@ private:
      */
     GetNextResult initialize();
 
+    /**
+     * Called once the input to a blocking $group is exhausted: either merges the spilled files or
+     * positions 'groupsIterator' at the first in-memory group.
+     */
+    void prepareGroupsForOutput();
+
+    /**
+     * Feeds the document bound to ROOT into the group 'id' of 'groups', creating the group if it
+     * does not exist yet, and keeps '*memoryUsageBytes' up to date. Returns true if a new group
+     * was created.
+     */
+    bool accumulateIntoGroup(GroupsMap* groups, const Value& id, size_t* memoryUsageBytes);
+
+    /**
+     * Returns the values of the '_inputSort' fields of 'doc', with missing values reported as
+     * null since the input orders the two together. Documents with equal run keys are adjacent in
+     * the input. Returns boost::none if one of the fields is reached through or holds an array, as
+     * the input order says nothing about where the group of such a document appears.
+     */
+    boost::optional<Value> computeRunKey(const Document& doc) const;
+
+    /**
+     * Moves every group of the current run to '_streamingOutput'.
+     */
+    void closeCurrentRun();
+
     /**
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
@@ -165,6 +208,7 @@ private:
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
     BSONObj _inputSort;
+    std::vector<FieldPath> _inputSortPaths;
     bool _streaming;
     bool _initialized;
 
@@ -187,8 +231,16 @@ private:
     const bool _extSortAllowed;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
-    // Only used when '_sorted' is true.
-    boost::optional<Document> _firstDocOfNextGroup;
+
+    // Only used when '_streaming' is true. The input is consumed in runs of documents with equal
+    // run keys. Every group of the run being read lives in '_currentRun'; different group keys can
+    // share a run when they differ only in null versus missing values. Groups whose key holds an
+    // array go to '_groups' instead and are output after the input is exhausted.
+    Value _currentRunKey;
+    boost::optional<GroupsMap> _currentRun;
+    size_t _currentRunMemoryUsageBytes = 0;
+    std::deque<Document> _streamingOutput;
+    bool _streamingInputEOF = false;
 };
 
 }  // namespace mongo
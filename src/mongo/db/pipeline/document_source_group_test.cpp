@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
 #include <map>
@@ -192,6 +193,31 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldErrorIfARunOfStreamingInputIsTooLarge) {
+    auto expCtx = getExpCtx();
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement pushStatement{"spaceHog",
+                                        AccumulationStatement::getFactory("$push"),
+                                        ExpressionFieldPath::parse(expCtx, "$largeStr", vps)};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$a", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, idGen.getIdCount(), maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes / 2, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"a", 0}, {"largeStr", largeStr}},
+                                            Document{{"a", 0}, {"largeStr", largeStr}},
+                                            Document{{"a", 0}, {"largeStr", largeStr}}});
+    mock->sorts = {BSON("a" << 1)};
+    group->setSource(mock.get());
+
+    // Even with external sort allowed, the groups of one run cannot be spilled.
+    ASSERT_THROWS_CODE(group->getNext(), UserException, 40422);
+    ASSERT_TRUE(group->isStreaming());
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -1082,6 +1108,112 @@ public:
     }
 };
 
+/**
+ * An input sorted on 'a' orders null and missing values of 'a' together, in any interleaving.
+ */
+class StreamingGroupsNullAndMissingTogether : public Base {
+public:
+    void run() {
+        auto source = DocumentSourceMock::create(
+            {"{a: null, b: 1}", "{b: 2}", "{a: null, b: 4}", "{a: 1, b: 8}", "{a: 1, b: 16}"});
+        source->sorts = {BSON("a" << 1)};
+
+        createGroup(fromjson("{_id: '$a', total: {$sum: '$b'}}"));
+        group()->setSource(source.get());
+
+        auto res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_TRUE(group()->isStreaming());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: null, total: 7}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 1, total: 24}")));
+
+        assertEOF(group());
+    }
+};
+
+/**
+ * With an object _id, a null and a missing field are different groups, but they share a run of the
+ * sorted input and are both output once that run ends.
+ */
+class StreamingKeepsNullAndMissingApartInObjectId : public Base {
+public:
+    void run() {
+        auto source = DocumentSourceMock::create(
+            {"{a: null, b: 1}", "{b: 2}", "{a: null, b: 4}", "{a: 1, b: 8}", "{a: 2, b: 16}"});
+        source->sorts = {BSON("a" << 1)};
+
+        createGroup(fromjson("{_id: {x: '$a'}, total: {$sum: '$b'}}"));
+        group()->setSource(source.get());
+
+        std::vector<Document> nullish;
+        for (int i = 0; i < 2; i++) {
+            auto res = group()->getNext();
+            ASSERT_TRUE(res.isAdvanced());
+            nullish.push_back(res.releaseDocument());
+        }
+        ASSERT_TRUE(group()->isStreaming());
+        std::sort(nullish.begin(), nullish.end(), [](const Document& lhs, const Document& rhs) {
+            return lhs["total"].getInt() < rhs["total"].getInt();
+        });
+        ASSERT_DOCUMENT_EQ(nullish[0], Document(fromjson("{_id: {}, total: 2}")));
+        ASSERT_DOCUMENT_EQ(nullish[1], Document(fromjson("{_id: {x: null}, total: 5}")));
+
+        // Closing the nullish run only needed the first document of the next run.
+        auto res = source->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_VALUE_EQ(res.getDocument().getField("a"), Value(2));
+        assertEOF(source);
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: {x: 1}, total: 8}")));
+
+        assertEOF(group());
+    }
+};
+
+/**
+ * The order of an input sorted on a multikey path says nothing about where a document whose key
+ * holds an array appears, so such groups are collected until the input is exhausted.
+ */
+class StreamingOutputsArrayKeysLast : public Base {
+public:
+    void run() {
+        auto source = DocumentSourceMock::create({"{a: 1, b: 1}",
+                                                  "{a: [1, 2], b: 2}",
+                                                  "{a: 1, b: 4}",
+                                                  "{a: 2, b: 8}",
+                                                  "{a: [1, 2], b: 16}",
+                                                  "{a: 3, b: 32}"});
+        source->sorts = {BSON("a" << 1)};
+
+        createGroup(fromjson("{_id: '$a', total: {$sum: '$b'}}"));
+        group()->setSource(source.get());
+
+        auto res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_TRUE(group()->isStreaming());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 1, total: 5}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 2, total: 8}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: 3, total: 32}")));
+
+        res = group()->getNext();
+        ASSERT_TRUE(res.isAdvanced());
+        ASSERT_DOCUMENT_EQ(res.getDocument(), Document(fromjson("{_id: [1, 2], total: 18}")));
+
+        assertEOF(group());
+    }
+};
+
 /**
  * A string constant (not a field path) as an _id expression and passed to an accumulator.
  * SERVER-6766
@@ -1158,8 +1290,6 @@ public:
         add<Dependencies>();
         add<StringConstantIdAndAccumulatorExpressions>();
         add<ArrayConstantAccumulatorExpression>();
-#if 0
-        // Disabled tests until SERVER-23318 is implemented.
         add<StreamingOptimization>();
         add<StreamingWithMultipleIdFields>();
         add<NoOptimizationIfMissingDoubleSort>();
@@ -1171,7 +1301,9 @@ public:
         add<StreamingWithRootSubfield>();
         add<StreamingWithConstantAndFieldPath>();
         add<StreamingWithFieldRepeated>();
-#endif
+        add<StreamingGroupsNullAndMissingTogether>();
+        add<StreamingKeepsNullAndMissingApartInObjectId>();
+        add<StreamingOutputsArrayKeysLast>();
     }
 };
 
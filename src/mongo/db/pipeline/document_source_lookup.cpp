@@ -26,18 +26,26 @@
  *    it in the license file.
  */
 
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
+#include <cctype>
+
 #include "mongo/base/init.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
 
 namespace mongo {
 
@@ -143,6 +151,19 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     // '_handlingUnwind' would be set to true, and we would not have made it here.
     invariant(!_matchSrc);
 
+    if (_strategy == JoinStrategy::kUndecided) {
+        _strategy = (canUseHashJoin() && buildHashTable()) ? JoinStrategy::kHashJoin
+                                                          : JoinStrategy::kNestedLoop;
+    }
+
+    if (_strategy == JoinStrategy::kHashJoin) {
+        if (auto results = lookUpInHashTable(inputDoc)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(*results)));
+            return output.freeze();
+        }
+    }
+
     auto matchStage =
         makeMatchStageFromInput(inputDoc, _localField, _foreignFieldFieldName, BSONObj());
     // We've already allocated space for the trailing $match stage in '_fromPipeline'.
@@ -166,6 +187,138 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     return output.freeze();
 }
 
+const char* DocumentSourceLookUp::joinStrategyName(JoinStrategy strategy) {
+    switch (strategy) {
+        case JoinStrategy::kUndecided:
+            return "undecided";
+        case JoinStrategy::kNestedLoop:
+            return "nestedLoop";
+        case JoinStrategy::kHashJoin:
+            return "hashJoin";
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool DocumentSourceLookUp::canUseHashJoin() const {
+    if (internalDocumentSourceLookupHashJoinMaxBytes.load() <= 0 || _handlingUnwind || _matchSrc) {
+        return false;
+    }
+
+    // '_fromPipeline' holds nothing but the placeholder for our $match, unless '_fromNs' is a view.
+    if (_fromPipeline.size() != 1) {
+        return false;
+    }
+
+    // Positional path components, as in "a.0", are not handled when building the hash table.
+    for (size_t i = 0; i < _foreignField.getPathLength(); ++i) {
+        const StringData fieldName = _foreignField.getFieldName(i);
+        auto isDigit = [](char c) { return std::isdigit(c); };
+        if (std::all_of(fieldName.begin(), fieldName.end(), isDigit)) {
+            return false;
+        }
+    }
+
+    for (auto&& indexSpec : _mongod->getIndexSpecs(_fromExpCtx->ns)) {
+        if (indexSpec.getObjectField("key").firstElementFieldName() == _foreignFieldFieldName) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DocumentSourceLookUp::buildHashTable() {
+    const size_t maxSizeBytes = internalDocumentSourceLookupHashJoinMaxBytes.load();
+
+    _fromPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+
+    _hashTable.emplace(pExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>());
+    size_t sizeBytes = 0;
+    while (auto result = pipeline->getNext()) {
+        const size_t position = _foreignDocs.size();
+        sizeBytes += result->getApproximateSize();
+        document_path_support::visitAllValuesAtPath(
+            *result, _foreignField, [&](const Value& value) {
+                auto& positions = (*_hashTable)[value];
+                // List each document once per value, even if the value is repeated in an array.
+                if (positions.empty() || positions.back() != position) {
+                    positions.push_back(position);
+                    sizeBytes += value.getApproximateSize() + sizeof(size_t);
+                }
+            });
+        _foreignDocs.push_back(std::move(*result));
+
+        if (sizeBytes > maxSizeBytes) {
+            LOG(1) << "$lookup from " << _fromExpCtx->ns.ns()
+                   << " exceeded internalDocumentSourceLookupHashJoinMaxBytes, querying the "
+                   << "foreign collection for each input document instead";
+            _foreignDocs.clear();
+            _hashTable = boost::none;
+            return false;
+        }
+    }
+    return true;
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpInHashTable(
+    const Document& input) const {
+    invariant(_hashTable);
+
+    // A null or missing local value also matches foreign documents which lack 'foreignField',
+    // and an array value would have to match whole arrays as well as their elements. Regular
+    // expressions are left to the query system too.
+    auto canBeLookedUp = [](const Value& value) {
+        switch (value.getType()) {
+            case EOO:
+            case jstNULL:
+            case Undefined:
+            case Array:
+            case RegEx:
+                return false;
+            default:
+                return true;
+        }
+    };
+
+    // As with the queries in makeMatchStageFromInput(), an array value matches documents having
+    // any of its elements.
+    const Value localFieldVal = input.getNestedField(_localField);
+    std::vector<Value> localValues;
+    if (localFieldVal.isArray()) {
+        localValues = localFieldVal.getArray();
+    } else {
+        localValues.push_back(localFieldVal);
+    }
+
+    std::vector<size_t> positions;
+    for (auto&& value : localValues) {
+        if (!canBeLookedUp(value)) {
+            return boost::none;
+        }
+        auto it = _hashTable->find(value);
+        if (it != _hashTable->end()) {
+            positions.insert(positions.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Return each matching document once, in the order the foreign collection was scanned in.
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    std::vector<Value> results;
+    int objsize = 0;
+    for (auto position : positions) {
+        objsize += _foreignDocs[position].getApproximateSize();
+        uassert(40425,
+                str::stream() << "Total size of documents in " << _fromNs.coll() << " matching "
+                              << localFieldVal.toString()
+                              << " exceeds maximum document size",
+                objsize <= BSONObjMaxInternalSize);
+        results.emplace_back(_foreignDocs[position]);
+    }
+    return results;
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceLookUp::getModifiedPaths() const {
     std::set<std::string> modifiedPaths{_as.fullPath()};
     if (_unwindSrc) {
@@ -282,6 +435,8 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
 
 void DocumentSourceLookUp::dispose() {
     _pipeline.reset();
+    _foreignDocs.clear();
+    _hashTable = boost::none;
     pSource->dispose();
 }
 
@@ -430,6 +585,16 @@ void DocumentSourceLookUp::serializeToArray(std::vector<Value>& array, bool expl
                           << (indexPath ? Value(indexPath->fullPath()) : Value())));
         }
 
+        if (_strategy != JoinStrategy::kUndecided) {
+            output[getSourceName()]["strategy"] = Value(StringData(joinStrategyName(_strategy)));
+        } else if (_mongod) {
+            // Report the strategy we will attempt. A hash join still falls back to a nested loop
+            // if the foreign collection turns out to be too large.
+            const auto strategy =
+                canUseHashJoin() ? JoinStrategy::kHashJoin : JoinStrategy::kNestedLoop;
+            output[getSourceName()]["strategy"] = Value(StringData(joinStrategyName(strategy)));
+        }
+
         if (_matchSrc) {
             // Our output does not have to be parseable, so include a "matching" field with the
             // descended match expression.
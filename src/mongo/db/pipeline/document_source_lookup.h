@@ -127,6 +127,38 @@ private:
 
     GetNextResult unwindResult();
 
+    enum class JoinStrategy {
+        // No input has been processed yet.
+        kUndecided,
+        // Query the foreign collection once per input document.
+        kNestedLoop,
+        // Look up matches in '_hashTable', which holds the whole foreign collection.
+        kHashJoin,
+    };
+
+    static const char* joinStrategyName(JoinStrategy strategy);
+
+    /**
+     * Returns true if this stage may be executed as a hash join: it has not absorbed an $unwind
+     * or $match, the foreign namespace is not a view, and there is no index on 'foreignField'
+     * which would make the per-document queries cheap.
+     */
+    bool canUseHashJoin() const;
+
+    /**
+     * Loads the foreign collection into '_hashTable', keyed by every value at 'foreignField'.
+     * Returns false, leaving '_hashTable' empty, if the collection does not fit within
+     * internalDocumentSourceLookupHashJoinMaxBytes.
+     */
+    bool buildHashTable();
+
+    /**
+     * Returns the foreign documents joining with 'input', in natural order, or boost::none if
+     * the local value is one which the hash table cannot answer for, such as null or an array
+     * containing arrays. The caller should then fall back to querying the foreign collection.
+     */
+    boost::optional<std::vector<Value>> lookUpInHashTable(const Document& input) const;
+
     NamespaceString _fromNs;
     FieldPath _as;
     FieldPath _localField;
@@ -147,6 +179,14 @@ private:
     bool _handlingUnwind = false;
     bool _handlingMatch = false;
 
+    JoinStrategy _strategy = JoinStrategy::kUndecided;
+
+    // Only used for hash joins. The foreign documents in natural order, and the positions in
+    // '_foreignDocs' of the documents having each value at 'foreignField'. Values are compared
+    // using this stage's collation, as the queries against the foreign collection would.
+    std::vector<Document> _foreignDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashTable;
+
     // The following members are used to hold onto state across getNext() calls when
     // '_handlingUnwind' is true.
     long long _cursorIndex = 0;
@@ -30,6 +30,8 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
+#include <list>
+#include <utility>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
@@ -150,13 +152,18 @@ TEST(MakeMatchStageFromInput, ArrayValueWithRegexUsesOrQuery) {
  */
 class MockMongodInterface final : public StubMongodInterface {
 public:
-    MockMongodInterface(deque<DocumentSource::GetNextResult> mockResults)
-        : _mockResults(std::move(mockResults)) {}
+    MockMongodInterface(deque<DocumentSource::GetNextResult> mockResults,
+                        std::list<BSONObj> mockIndexSpecs = {})
+        : _mockResults(std::move(mockResults)), _mockIndexSpecs(std::move(mockIndexSpecs)) {}
 
     bool isSharded(const NamespaceString& ns) final {
         return false;
     }
 
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& ns) final {
+        return _mockIndexSpecs;
+    }
+
     StatusWith<boost::intrusive_ptr<Pipeline>> makePipeline(
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx) final {
@@ -173,8 +180,86 @@ public:
 
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
+    std::list<BSONObj> _mockIndexSpecs;
 };
 
+/**
+ * Runs a $lookup of 'localField' against 'foreignField' over 'localContents', and returns the
+ * joined "foreignDocs" arrays in order, along with the join strategy reported by explain.
+ */
+std::pair<vector<Value>, std::string> runLookup(
+    const intrusive_ptr<ExpressionContextForTest>& expCtx,
+    deque<DocumentSource::GetNextResult> localContents,
+    deque<DocumentSource::GetNextResult> foreignContents,
+    std::list<BSONObj> foreignIndexSpecs) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "x"_sd},
+                                         {"foreignField", "f"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::create(std::move(localContents));
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectMongodInterface(std::make_shared<MockMongodInterface>(
+        std::move(foreignContents), std::move(foreignIndexSpecs)));
+
+    vector<Value> joined;
+    for (auto next = lookup->getNext(); next.isAdvanced(); next = lookup->getNext()) {
+        joined.push_back(next.releaseDocument()["foreignDocs"]);
+    }
+
+    vector<Value> explained;
+    lookup->serializeToArray(explained, true);
+    return {joined, explained[0]["$lookup"]["strategy"].getString()};
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinShouldReturnSameResultsAsQueries) {
+    deque<DocumentSource::GetNextResult> localContents{Document{{"x", 1}},
+                                                       Document{{"x", vector<Value>{Value(1),
+                                                                                    Value(2)}}},
+                                                       Document{{"x", 3}},
+                                                       Document{{"x", vector<Value>{}}},
+                                                       Document{}};
+    deque<DocumentSource::GetNextResult> foreignContents{
+        Document{{"_id", 0}, {"f", 1}},
+        Document{{"_id", 1}, {"f", vector<Value>{Value(1), Value(1), Value(2)}}},
+        Document{{"_id", 2}, {"f", BSONNULL}},
+        Document{{"_id", 3}}};
+
+    auto result = runLookup(getExpCtx(), localContents, foreignContents, {});
+    ASSERT_EQ("hashJoin", result.second);
+
+    const vector<Value>& joined = result.first;
+    ASSERT_EQ(5U, joined.size());
+    ASSERT_VALUE_EQ(Value(vector<Value>{Value(Document{{"_id", 0}, {"f", 1}}),
+                                        Value(foreignContents[1].getDocument())}),
+                    joined[0]);
+    ASSERT_VALUE_EQ(joined[0], joined[1]);
+    ASSERT_VALUE_EQ(Value(vector<Value>{}), joined[2]);
+    ASSERT_VALUE_EQ(Value(vector<Value>{}), joined[3]);
+
+    // A missing local value is answered by a query, and matches null and missing foreign values.
+    ASSERT_VALUE_EQ(Value(vector<Value>{Value(foreignContents[2].getDocument()),
+                                        Value(foreignContents[3].getDocument())}),
+                    joined[4]);
+
+    // Querying for each input document produces the same results.
+    auto indexSpecs = std::list<BSONObj>{BSON("key" << BSON("f" << 1) << "name"
+                                                    << "f_1")};
+    auto queried = runLookup(getExpCtx(), localContents, foreignContents, indexSpecs);
+    ASSERT_EQ("nestedLoop", queried.second);
+    ASSERT_EQ(joined.size(), queried.first.size());
+    for (size_t i = 0; i < joined.size(); ++i) {
+        ASSERT_VALUE_EQ(joined[i], queried.first[i]);
+    }
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
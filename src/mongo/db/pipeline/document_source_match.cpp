@@ -73,13 +73,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
 
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
-        // only serialize the fields we need to do the match.
-        BSONObj toMatch = _dependencies.needWholeDocument
-            ? nextInput.getDocument().toBson()
-            : getObjectForMatch(nextInput.getDocument(), _dependencies.fields);
-
-        if (_expression->matchesBSON(toMatch)) {
+        if (matches(nextInput.getDocument())) {
             return nextInput;
         }
 
@@ -94,6 +88,44 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    pExpCtx->checkForInterrupt();
+
+    // The user facing error should have been generated earlier.
+    invariant(!_isTextQuery);
+
+    // Filter each batch from our child in place, until at least one of its documents matches.
+    const size_t initialSize = batch->size();
+    while (batch->size() == initialSize) {
+        auto status = pSource->getNextBatch(batch, maxDocs);
+        if (status != GetNextResult::ReturnStatus::kAdvanced) {
+            return status;
+        }
+
+        auto kept = batch->begin() + initialSize;
+        for (auto it = kept; it != batch->end(); ++it) {
+            if (matches(*it)) {
+                if (kept != it) {
+                    *kept = std::move(*it);
+                }
+                ++kept;
+            }
+        }
+        batch->erase(kept, batch->end());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
+bool DocumentSourceMatch::matches(const Document& doc) const {
+    // MatchExpression only takes BSON documents, so we have to make one. As an optimization, only
+    // serialize the fields we need to do the match.
+    BSONObj toMatch = _dependencies.needWholeDocument
+        ? doc.toBson()
+        : getObjectForMatch(doc, _dependencies.fields);
+    return _expression->matchesBSON(toMatch);
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
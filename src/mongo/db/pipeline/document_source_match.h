@@ -41,6 +41,7 @@ class DocumentSourceMatch final : public DocumentSource {
 public:
     // virtuals from DocumentSource
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) final;
     const char* getSourceName() const final;
     Value serialize(bool explain = false) const final;
     boost::intrusive_ptr<DocumentSource> optimize() final;
@@ -148,6 +149,11 @@ private:
 
     void addDependencies(DepsTracker* deps) const;
 
+    /**
+     * Returns whether 'doc' satisfies this stage's predicate.
+     */
+    bool matches(const Document& doc) const;
+
     std::unique_ptr<MatchExpression> _expression;
 
     // Cache the dependencies so that we know what fields we need to serialize to BSON for matching.
@@ -330,6 +330,45 @@ TEST_F(DocumentSourceMatchTest, ShouldPropagatePauses) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, ShouldFilterBatchesAndPropagatePauses) {
+    using ReturnStatus = DocumentSource::GetNextResult::ReturnStatus;
+
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock = DocumentSourceMock::create({DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 1}, {"b", 1}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 1}, {"b", 2}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 2}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 1}, {"b", 3}}});
+    match->setSource(mock.get());
+
+    std::vector<Document> batch;
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kPauseExecution);
+    ASSERT_TRUE(batch.empty());
+
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(2U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 1}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 1}, {"b", 2}}));
+    batch.clear();
+
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kPauseExecution);
+
+    // {a: 2} doesn't match, should go directly to the next pause.
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kPauseExecution);
+    ASSERT_TRUE(batch.empty());
+
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(1U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 3}}));
+
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+    ASSERT_EQUALS(1U, batch.size());
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldCorrectlyJoinWithSubsequentMatch) {
     const auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
     const auto secondMatch = DocumentSourceMatch::create(BSON("b" << 1), getExpCtx());
@@ -111,25 +111,29 @@ void DocumentSourceOut::initialize() {
                 ok);
     }
 
-    // copy indexes to _tempNs
-    for (std::list<BSONObj>::const_iterator it = _originalIndexes.begin();
-         it != _originalIndexes.end();
-         ++it) {
-        MutableDocument index((Document(*it)));
-        index.remove("_id");  // indexes shouldn't have _ids but some existing ones do
-        index["ns"] = Value(_tempNs.ns());
-
-        BSONObj indexBson = index.freeze().toBson();
-        conn->insert(_tempNs.getSystemIndexesCollection(), indexBson);
-        BSONObj err = conn->getLastErrorDetailed();
+    // Copy the indexes to the temporary collection while it is still empty, so that a unique
+    // index violation fails the insert which causes it. All indexes are created by a single
+    // command, which sets them up in one pass over the (empty) collection.
+    if (!_originalIndexes.empty()) {
+        BSONArrayBuilder indexes;
+        for (auto&& spec : _originalIndexes) {
+            MutableDocument index((Document(spec)));
+            index.remove("_id");  // indexes shouldn't have _ids but some existing ones do
+            index["ns"] = Value(_tempNs.ns());
+            indexes.append(index.freeze().toBson());
+        }
+
+        BSONObj cmd = BSON("createIndexes" << _tempNs.coll() << "indexes" << indexes.arr());
+        BSONObj info;
+        bool ok = conn->runCommand(_outputNs.db().toString(), cmd, info);
         uassert(16995,
-                str::stream() << "copying index for $out failed."
-                              << " index: "
-                              << indexBson
+                str::stream() << "copying indexes for $out failed. indexes: "
+                              << cmd["indexes"].Obj()
                               << " error: "
-                              << err,
-                DBClientWithCommands::getLastErrorString(err).empty());
+                              << info,
+                ok);
     }
+
     _initialized = true;
 }
 
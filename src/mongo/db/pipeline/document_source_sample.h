@@ -43,6 +43,11 @@ public:
         return SEE_NEXT;
     }
 
+    // Draws from the random number generator of the operation's Client.
+    bool usesOperationContext() const final {
+        return true;
+    }
+
     boost::intrusive_ptr<DocumentSource> getShardSource() final;
     boost::intrusive_ptr<DocumentSource> getMergeSource() final;
 
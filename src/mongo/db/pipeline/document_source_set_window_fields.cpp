@@ -0,0 +1,540 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document_source_add_fields.h"
+#include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::string;
+using std::vector;
+
+REGISTER_MULTI_STAGE_ALIAS(setWindowFields,
+                           LiteParsedDocumentSourceDefault::parse,
+                           DocumentSourceSetWindowFields::createFromBson);
+
+REGISTER_DOCUMENT_SOURCE(_internalSetWindowFields,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalSetWindowFields::createFromBson);
+
+constexpr StringData DocumentSourceSetWindowFields::kTempPartitionField;
+
+vector<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(40397,
+            str::stream() << "the $setWindowFields stage specification must be an object, but "
+                             "found type: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    BSONElement partitionBy;
+    BSONElement sortBy;
+    BSONObjBuilder internalSpecBuilder;
+    for (auto&& argument : elem.Obj()) {
+        const auto argName = argument.fieldNameStringData();
+        if ("partitionBy" == argName) {
+            partitionBy = argument;
+        } else if ("sortBy" == argName) {
+            uassert(40405,
+                    str::stream() << "the $setWindowFields 'sortBy' field must be an object, but "
+                                     "found type: "
+                                  << typeName(argument.type()),
+                    argument.type() == BSONType::Object);
+            sortBy = argument;
+        } else {
+            // The remaining options are validated by $_internalSetWindowFields.
+            internalSpecBuilder.append(argument);
+        }
+    }
+
+    vector<intrusive_ptr<DocumentSource>> stages;
+    BSONObjBuilder sortSpecBuilder;
+    bool usesTempPartitionField = false;
+    if (partitionBy) {
+        if (partitionBy.type() == BSONType::String &&
+            partitionBy.valueStringData().startsWith("$") &&
+            !partitionBy.valueStringData().startsWith("$$")) {
+            // The documents can be sorted by the field itself.
+            sortSpecBuilder.append(partitionBy.valueStringData().substr(1), 1);
+            internalSpecBuilder.append(partitionBy);
+        } else {
+            BSONObj addFieldsObj = BSON("$addFields" << BSON(kTempPartitionField << partitionBy));
+            stages.push_back(
+                DocumentSourceAddFields::createFromBson(addFieldsObj.firstElement(), pExpCtx));
+            sortSpecBuilder.append(kTempPartitionField, 1);
+            internalSpecBuilder.append("partitionBy", "$" + kTempPartitionField.toString());
+            usesTempPartitionField = true;
+        }
+    }
+    if (sortBy) {
+        sortSpecBuilder.appendElements(sortBy.Obj());
+    }
+
+    BSONObj sortSpec = sortSpecBuilder.obj();
+    if (!sortSpec.isEmpty()) {
+        BSONObj sortObj = BSON("$sort" << sortSpec);
+        stages.push_back(DocumentSourceSort::createFromBson(sortObj.firstElement(), pExpCtx));
+    }
+
+    BSONObj internalObj = BSON("$_internalSetWindowFields" << internalSpecBuilder.obj());
+    stages.push_back(
+        DocumentSourceInternalSetWindowFields::createFromBson(internalObj.firstElement(), pExpCtx));
+
+    if (usesTempPartitionField) {
+        BSONObj projectObj = BSON("$project" << BSON(kTempPartitionField << 0));
+        stages.push_back(DocumentSourceProject::createFromBson(projectObj.firstElement(), pExpCtx));
+    }
+    return stages;
+}
+
+namespace {
+
+const char kUnboundedName[] = "unbounded";
+const char kCurrentName[] = "current";
+
+boost::optional<long long> parseWindowBound(const BSONElement& bound) {
+    if (bound.type() == BSONType::String) {
+        if (bound.valueStringData() == kUnboundedName) {
+            return boost::none;
+        }
+        if (bound.valueStringData() == kCurrentName) {
+            return 0LL;
+        }
+    } else if (Value(bound).integral()) {
+        return Value(bound).coerceToLong();
+    }
+
+    uasserted(40403,
+              str::stream() << "$setWindowFields window bounds must be \"" << kUnboundedName
+                            << "\", \""
+                            << kCurrentName
+                            << "\", or a 32-bit integer, but found: "
+                            << bound.toString(false, false));
+}
+
+DocumentSourceInternalSetWindowFields::WindowBounds parseWindowBounds(const BSONElement& elem) {
+    BSONObj window = elem.type() == BSONType::Object ? elem.embeddedObject() : BSONObj();
+    BSONElement documents = window["documents"];
+    uassert(40402,
+            str::stream() << "$setWindowFields 'window' must be of the form "
+                             "{documents: [<lower>, <upper>]}, but found: "
+                          << elem.toString(false, false),
+            window.nFields() == 1 && documents.type() == BSONType::Array &&
+                documents.embeddedObject().nFields() == 2);
+
+    DocumentSourceInternalSetWindowFields::WindowBounds bounds;
+    bounds.lower = parseWindowBound(documents.embeddedObject()[0]);
+    bounds.upper = parseWindowBound(documents.embeddedObject()[1]);
+    uassert(40404,
+            str::stream() << "$setWindowFields window lower bound must not be greater than the "
+                             "upper bound, but found: "
+                          << elem.toString(false, false),
+            !bounds.lower || !bounds.upper || *bounds.lower <= *bounds.upper);
+    return bounds;
+}
+
+DocumentSourceInternalSetWindowFields::WindowFunctionStatement parseWindowFunctionStatement(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const BSONElement& elem,
+    const VariablesParseState& vps) {
+    auto fieldName = elem.fieldNameStringData();
+    uassert(40400,
+            str::stream() << "The $setWindowFields output field '" << fieldName
+                          << "' must be an object, and its name may not contain '.' or start with "
+                             "'$'",
+            elem.type() == BSONType::Object && fieldName.find('.') == string::npos &&
+                !fieldName.startsWith("$"));
+
+    DocumentSourceInternalSetWindowFields::WindowFunctionStatement statement;
+    statement.fieldName = fieldName.toString();
+    for (auto&& specElem : elem.embeddedObject()) {
+        const auto specName = specElem.fieldNameStringData();
+        if ("window" == specName) {
+            statement.bounds = parseWindowBounds(specElem);
+        } else {
+            uassert(40401,
+                    str::stream() << "The $setWindowFields output field '" << fieldName
+                                  << "' must specify exactly one accumulator, and optionally a "
+                                     "'window', but found: "
+                                  << specName,
+                    specName.startsWith("$") && !statement.factory);
+            uassert(40415,
+                    str::stream() << "The " << specName << " accumulator is a unary operator",
+                    specElem.type() != BSONType::Array);
+            statement.factory = AccumulationStatement::getFactory(specName);
+            statement.expression = Expression::parseOperand(expCtx, specElem, vps);
+        }
+    }
+    uassert(40417,
+            str::stream() << "The $setWindowFields output field '" << fieldName
+                          << "' must specify exactly one accumulator",
+            statement.factory);
+    return statement;
+}
+
+Value serializeWindowBound(const boost::optional<long long>& bound) {
+    return bound ? Value(*bound) : Value(StringData(kUnboundedName));
+}
+
+}  // namespace
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(40416,
+            str::stream() << "the $setWindowFields stage specification must be an object, but "
+                             "found type: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    VariablesIdGenerator idGenerator;
+    VariablesParseState vps(&idGenerator);
+    intrusive_ptr<Expression> partitionBy;
+    vector<WindowFunctionStatement> outputFields;
+
+    for (auto&& argument : elem.Obj()) {
+        const auto argName = argument.fieldNameStringData();
+        if ("partitionBy" == argName) {
+            partitionBy = Expression::parseOperand(pExpCtx, argument, vps);
+        } else if ("output" == argName) {
+            uassert(40399,
+                    str::stream() << "The $setWindowFields 'output' field must be an object, but "
+                                     "found type: "
+                                  << typeName(argument.type()),
+                    argument.type() == BSONType::Object);
+            for (auto&& outputField : argument.embeddedObject()) {
+                outputFields.push_back(parseWindowFunctionStatement(pExpCtx, outputField, vps));
+            }
+        } else {
+            uasserted(40398,
+                      str::stream() << "Unrecognized option to $setWindowFields: " << argName);
+        }
+    }
+
+    uassert(40418,
+            "$setWindowFields requires a non-empty 'output' object",
+            !outputFields.empty());
+
+    return create(pExpCtx, partitionBy, std::move(outputFields), idGenerator.getIdCount());
+}
+
+intrusive_ptr<DocumentSourceInternalSetWindowFields> DocumentSourceInternalSetWindowFields::create(
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    const intrusive_ptr<Expression>& partitionBy,
+    vector<WindowFunctionStatement> outputFields,
+    Variables::Id numVariables,
+    uint64_t maxMemoryUsageBytes) {
+    return new DocumentSourceInternalSetWindowFields(
+        pExpCtx, partitionBy, std::move(outputFields), numVariables, maxMemoryUsageBytes);
+}
+
+DocumentSourceInternalSetWindowFields::DocumentSourceInternalSetWindowFields(
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    const intrusive_ptr<Expression>& partitionBy,
+    vector<WindowFunctionStatement> outputFields,
+    Variables::Id numVariables,
+    uint64_t maxMemoryUsageBytes)
+    : DocumentSource(pExpCtx),
+      _partitionBy(partitionBy),
+      _outputFields(std::move(outputFields)),
+      _variables(stdx::make_unique<Variables>(numVariables)),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes) {
+    for (auto&& statement : _outputFields) {
+        WindowFunctionState state;
+        state.accumulator = statement.factory(pExpCtx);
+        _states.push_back(std::move(state));
+    }
+}
+
+const char* DocumentSourceInternalSetWindowFields::getSourceName() const {
+    return "$_internalSetWindowFields";
+}
+
+Value DocumentSourceInternalSetWindowFields::serialize(bool explain) const {
+    MutableDocument spec;
+    if (_partitionBy) {
+        spec["partitionBy"] = _partitionBy->serialize(explain);
+    }
+
+    MutableDocument output;
+    for (auto&& statement : _outputFields) {
+        intrusive_ptr<Accumulator> accum = statement.factory(pExpCtx);
+        vector<Value> bounds{serializeWindowBound(statement.bounds.lower),
+                             serializeWindowBound(statement.bounds.upper)};
+        output[statement.fieldName] =
+            Value{Document{{accum->getOpName(), statement.expression->serialize(explain)},
+                           {"window", Document{{"documents", Value(std::move(bounds))}}}}};
+    }
+    spec["output"] = output.freezeToValue();
+
+    return Value{Document{{getSourceName(), spec.freezeToValue()}}};
+}
+
+DocumentSource::GetDepsReturn DocumentSourceInternalSetWindowFields::getDependencies(
+    DepsTracker* deps) const {
+    if (_partitionBy) {
+        _partitionBy->addDependencies(deps);
+    }
+    for (auto&& statement : _outputFields) {
+        statement.expression->addDependencies(deps);
+    }
+
+    // The input documents are passed on with the output fields added.
+    return SEE_NEXT;
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    if (!_started) {
+        auto next = pSource->getNext();
+        if (!next.isAdvanced()) {
+            return next;
+        }
+        _started = true;
+        _nextPartitionFirstDoc = next.releaseDocument();
+        startNextPartition();
+    }
+
+    // Read as far into the partition as the windows of the next document to return reach.
+    long long partitionEnd;
+    while (true) {
+        long long readThroughPosition = _nextPosition;
+        for (auto&& statement : _outputFields) {
+            readThroughPosition = statement.bounds.upper
+                ? std::max(readThroughPosition, _nextPosition + *statement.bounds.upper)
+                : std::numeric_limits<long long>::max();
+        }
+
+        auto readResult = readThrough(readThroughPosition);
+        if (readResult.isPaused()) {
+            return readResult;
+        }
+
+        partitionEnd = _bufferStart + static_cast<long long>(_buffer.size());
+        if (_nextPosition < partitionEnd) {
+            break;
+        }
+
+        // Every document of this partition has been returned.
+        invariant(_partitionEnded);
+        if (!_nextPartitionFirstDoc) {
+            dispose();
+            return GetNextResult::makeEOF();
+        }
+        startNextPartition();
+    }
+
+    MutableDocument out(bufferedDocument(_nextPosition));
+    uint64_t accumulatorMemoryUsageBytes = 0;
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        const auto& statement = _outputFields[i];
+        const long long start =
+            statement.bounds.lower ? std::max(0LL, _nextPosition + *statement.bounds.lower) : 0;
+        const long long end = statement.bounds.upper
+            ? std::max(start, std::min(partitionEnd, _nextPosition + *statement.bounds.upper + 1))
+            : partitionEnd;
+        slideWindow(statement, &_states[i], start, end);
+
+        Value val = _states[i].accumulator->getValue(false);
+
+        // To be consistent with the $group stage, we consider "missing" to be equivalent to null
+        // when evaluating accumulators.
+        out.setField(statement.fieldName, val.missing() ? Value(BSONNULL) : std::move(val));
+        accumulatorMemoryUsageBytes += _states[i].accumulator->memUsageForSorter();
+    }
+    uassert(40419,
+            str::stream() << "$setWindowFields exceeded the memory limit of "
+                          << _maxMemoryUsageBytes
+                          << " bytes",
+            _memoryUsageBytes + accumulatorMemoryUsageBytes <= _maxMemoryUsageBytes);
+    _nextPosition++;
+
+    // Windows with a lower bound only move forward, and cumulative windows only need the documents
+    // they have not processed yet.
+    long long neededFrom = _nextPosition;
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        neededFrom = std::min(neededFrom,
+                              _outputFields[i].bounds.lower ? _states[i].windowStart
+                                                            : _states[i].windowEnd);
+    }
+    releaseBefore(neededFrom);
+
+    return out.freeze();
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::readThrough(
+    long long position) {
+    while (!_partitionEnded && _bufferStart + static_cast<long long>(_buffer.size()) <= position) {
+        auto next = pSource->getNext();
+        if (next.isPaused()) {
+            return next;
+        }
+        if (next.isEOF()) {
+            _partitionEnded = true;
+            break;
+        }
+
+        auto doc = next.releaseDocument();
+        if (!pExpCtx->getValueComparator().evaluate(computePartitionKey(doc) == _partitionKey)) {
+            _nextPartitionFirstDoc = std::move(doc);
+            _partitionEnded = true;
+            break;
+        }
+        bufferDocument(std::move(doc));
+    }
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceInternalSetWindowFields::startNextPartition() {
+    invariant(_nextPartitionFirstDoc);
+    Document firstDoc = std::move(*_nextPartitionFirstDoc);
+    _nextPartitionFirstDoc = boost::none;
+
+    _buffer.clear();
+    _bufferStart = 0;
+    _memoryUsageBytes = 0;
+    _nextPosition = 0;
+    _partitionEnded = false;
+    for (auto&& state : _states) {
+        state.accumulator->reset();
+        state.windowStart = 0;
+        state.windowEnd = 0;
+    }
+
+    _partitionKey = computePartitionKey(firstDoc);
+    bufferDocument(std::move(firstDoc));
+}
+
+void DocumentSourceInternalSetWindowFields::bufferDocument(Document doc) {
+    const size_t sizeBytes = doc.getApproximateSize();
+    _memoryUsageBytes += sizeBytes;
+    uassert(40396,
+            str::stream() << "$setWindowFields exceeded the memory limit of "
+                          << _maxMemoryUsageBytes
+                          << " bytes while buffering a partition",
+            _memoryUsageBytes <= _maxMemoryUsageBytes);
+    _buffer.emplace_back(std::move(doc), sizeBytes);
+}
+
+const Document& DocumentSourceInternalSetWindowFields::bufferedDocument(long long position) {
+    invariant(position >= _bufferStart);
+    invariant(position < _bufferStart + static_cast<long long>(_buffer.size()));
+    return _buffer[position - _bufferStart].first;
+}
+
+void DocumentSourceInternalSetWindowFields::releaseBefore(long long position) {
+    while (_bufferStart < position && !_buffer.empty()) {
+        _memoryUsageBytes -= _buffer.front().second;
+        _buffer.pop_front();
+        _bufferStart++;
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::slideWindow(const WindowFunctionStatement& statement,
+                                                         WindowFunctionState* state,
+                                                         long long start,
+                                                         long long end) {
+    invariant(start >= state->windowStart && end >= state->windowEnd);
+
+    if (start > state->windowStart) {
+        bool removed = true;
+        for (long long position = state->windowStart;
+             removed && position < std::min(start, state->windowEnd);
+             ++position) {
+            removed = state->accumulator->remove(evaluateInput(statement, position));
+        }
+
+        if (!removed) {
+            // This accumulator cannot undo its inputs, so process the whole window again.
+            state->accumulator->reset();
+            state->windowEnd = start;
+        }
+        state->windowStart = start;
+        state->windowEnd = std::max(state->windowEnd, start);
+    }
+
+    for (; state->windowEnd < end; ++state->windowEnd) {
+        state->accumulator->process(evaluateInput(statement, state->windowEnd), false);
+    }
+}
+
+Value DocumentSourceInternalSetWindowFields::evaluateInput(const WindowFunctionStatement& statement,
+                                                           long long position) {
+    _variables->setRoot(bufferedDocument(position));
+    return statement.expression->evaluate(_variables.get());
+}
+
+Value DocumentSourceInternalSetWindowFields::computePartitionKey(const Document& doc) {
+    if (!_partitionBy) {
+        return Value();
+    }
+
+    _variables->setRoot(doc);
+    Value key = _partitionBy->evaluate(_variables.get());
+
+    // The documents are sorted on the partition key before they reach this stage, and an array
+    // sorts by one of its elements rather than as a whole, so an array's partition would not be
+    // contiguous.
+    uassert(40420,
+            str::stream() << "$setWindowFields 'partitionBy' must not evaluate to an array, but "
+                             "found: "
+                          << key.toString(),
+            key.getType() != BSONType::Array);
+
+    // To be consistent with the $group stage, we consider "missing" to be equivalent to null when
+    // partitioning.
+    return key.missing() ? Value(BSONNULL) : std::move(key);
+}
+
+void DocumentSourceInternalSetWindowFields::dispose() {
+    _buffer.clear();
+    _memoryUsageBytes = 0;
+    _nextPartitionFirstDoc = boost::none;
+    _partitionEnded = true;
+    for (auto&& state : _states) {
+        state.accumulator->reset();
+    }
+    pSource->dispose();
+}
+
+}  // namespace mongo
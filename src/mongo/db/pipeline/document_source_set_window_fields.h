@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * The $setWindowFields stage is an alias for a $sort stage which orders the documents by partition
+ * and then by the 'sortBy' specification, followed by a $_internalSetWindowFields stage which
+ * computes the window functions over each partition as it streams past. If 'partitionBy' is not a
+ * field path, it is first computed into a temporary field by an $addFields stage, which a final
+ * $project stage removes.
+ */
+class DocumentSourceSetWindowFields final {
+public:
+    static constexpr StringData kTempPartitionField = "__internal_setWindowFields_partition"_sd;
+
+    static std::vector<boost::intrusive_ptr<DocumentSource>> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    // It is illegal to construct a DocumentSourceSetWindowFields directly, use createFromBson()
+    // instead.
+    DocumentSourceSetWindowFields() = default;
+};
+
+/**
+ * Adds to each document the values of accumulators over a window of the documents around it in
+ * its partition. The input must already be ordered so that each partition is contiguous.
+ *
+ * A window is given in documents, relative to the current one, as {documents: [lower, upper]}.
+ * Either bound may be "unbounded", and "current" stands for 0. Only the documents between the
+ * lowest lower bound and the highest upper bound are buffered, unless an upper bound is
+ * "unbounded", in which case the whole partition is. Accumulators which can undo an input slide
+ * along with the window; others are recomputed over the window for each document.
+ */
+class DocumentSourceInternalSetWindowFields final : public DocumentSource {
+public:
+    static const uint64_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
+
+    struct WindowBounds {
+        // boost::none means unbounded.
+        boost::optional<long long> lower;
+        boost::optional<long long> upper;
+    };
+
+    struct WindowFunctionStatement {
+        std::string fieldName;
+        Accumulator::Factory factory;
+        boost::intrusive_ptr<Expression> expression;
+        WindowBounds bounds;
+    };
+
+    GetNextResult getNext() final;
+    const char* getSourceName() const final;
+    Value serialize(bool explain = false) const final;
+    GetDepsReturn getDependencies(DepsTracker* deps) const final;
+    void dispose() final;
+
+    static boost::intrusive_ptr<DocumentSourceInternalSetWindowFields> create(
+        const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+        const boost::intrusive_ptr<Expression>& partitionBy,
+        std::vector<WindowFunctionStatement> outputFields,
+        Variables::Id numVariables,
+        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    // The state of one output field for the partition being returned.
+    struct WindowFunctionState {
+        boost::intrusive_ptr<Accumulator> accumulator;
+
+        // The positions in the partition of the documents processed by the accumulator.
+        long long windowStart = 0;
+        long long windowEnd = 0;
+    };
+
+    DocumentSourceInternalSetWindowFields(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+                                          const boost::intrusive_ptr<Expression>& partitionBy,
+                                          std::vector<WindowFunctionStatement> outputFields,
+                                          Variables::Id numVariables,
+                                          uint64_t maxMemoryUsageBytes);
+
+    /**
+     * Reads documents from the source until the document at 'position' of the current partition,
+     * or the end of the partition, has been read. Returns the last GetNextResult, which is kEOF
+     * unless the source paused.
+     */
+    GetNextResult readThrough(long long position);
+
+    /**
+     * Begins a new partition with '_nextPartitionFirstDoc', if there is one.
+     */
+    void startNextPartition();
+
+    void bufferDocument(Document doc);
+
+    const Document& bufferedDocument(long long position);
+
+    /**
+     * Moves the window of 'state' so that its accumulator has processed the values in positions
+     * [start, end) of the current partition.
+     */
+    void slideWindow(const WindowFunctionStatement& statement,
+                     WindowFunctionState* state,
+                     long long start,
+                     long long end);
+
+    Value evaluateInput(const WindowFunctionStatement& statement, long long position);
+
+    Value computePartitionKey(const Document& doc);
+
+    /**
+     * Drops the buffered documents before 'position', which no window will include again.
+     */
+    void releaseBefore(long long position);
+
+    boost::intrusive_ptr<Expression> _partitionBy;
+    std::vector<WindowFunctionStatement> _outputFields;
+    std::unique_ptr<Variables> _variables;
+    const uint64_t _maxMemoryUsageBytes;
+
+    std::vector<WindowFunctionState> _states;
+
+    // The documents of the current partition which may still be needed, starting with the one at
+    // position '_bufferStart', along with their sizes when they were buffered.
+    std::deque<std::pair<Document, size_t>> _buffer;
+    long long _bufferStart = 0;
+    uint64_t _memoryUsageBytes = 0;
+
+    // The position in the current partition of the next document to return.
+    long long _nextPosition = 0;
+
+    Value _partitionKey;
+    bool _partitionEnded = false;
+
+    // The first document after the current partition, once it has been read.
+    boost::optional<Document> _nextPartitionFirstDoc;
+    bool _started = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,292 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <boost/intrusive_ptr.hpp>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_add_fields.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+using boost::intrusive_ptr;
+using std::deque;
+using std::vector;
+
+class SetWindowFieldsTest : public AggregationContextFixture {
+public:
+    intrusive_ptr<DocumentSource> createStage(const char* spec) {
+        BSONObj specObj = BSON("$_internalSetWindowFields" << fromjson(spec));
+        return DocumentSourceInternalSetWindowFields::createFromBson(specObj.firstElement(),
+                                                                     getExpCtx());
+    }
+
+    /**
+     * Runs a $_internalSetWindowFields stage with the specification 'spec' over 'inputs', and
+     * returns the value of 'field' in each of the results.
+     */
+    vector<Value> runStage(const char* spec,
+                           deque<DocumentSource::GetNextResult> inputs,
+                           const char* field = "out") {
+        auto stage = createStage(spec);
+        auto mock = DocumentSourceMock::create(std::move(inputs));
+        stage->setSource(mock.get());
+
+        vector<Value> results;
+        for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+            if (next.isPaused()) {
+                continue;
+            }
+            results.push_back(next.getDocument()[field]);
+        }
+        ASSERT_TRUE(stage->getNext().isEOF());
+        return results;
+    }
+};
+
+deque<DocumentSource::GetNextResult> values(std::initializer_list<int> vals) {
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int val : vals) {
+        inputs.push_back(Document{{"x", val}});
+    }
+    return inputs;
+}
+
+TEST_F(SetWindowFieldsTest, ShouldComputeRunningTotal) {
+    auto results = runStage("{output: {out: {$sum: '$x', window: {documents: ['unbounded', 0]}}}}",
+                            values({1, 2, 3, 4}));
+    ASSERT_EQ(4U, results.size());
+    ASSERT_VALUE_EQ(results[0], Value(1));
+    ASSERT_VALUE_EQ(results[1], Value(3));
+    ASSERT_VALUE_EQ(results[2], Value(6));
+    ASSERT_VALUE_EQ(results[3], Value(10));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldComputeMovingAverageWithinEachPartition) {
+    deque<DocumentSource::GetNextResult> inputs{Document{{"p", 1}, {"x", 1}},
+                                                Document{{"p", 1}, {"x", 3}},
+                                                Document{{"p", 1}, {"x", 5}},
+                                                Document{{"p", 2}, {"x", 10}},
+                                                Document{{"p", 2}, {"x", 20}}};
+    auto results = runStage(
+        "{partitionBy: '$p', output: {out: {$avg: '$x', window: {documents: [-1, 1]}}}}", inputs);
+    ASSERT_EQ(5U, results.size());
+    ASSERT_VALUE_EQ(results[0], Value(2.0));
+    ASSERT_VALUE_EQ(results[1], Value(3.0));
+    ASSERT_VALUE_EQ(results[2], Value(4.0));
+    ASSERT_VALUE_EQ(results[3], Value(15.0));
+    ASSERT_VALUE_EQ(results[4], Value(15.0));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRecomputeWindowsOfAccumulatorsWhichCannotRemove) {
+    auto results = runStage("{output: {out: {$max: '$x', window: {documents: [-2, 'current']}}}}",
+                            values({5, 1, 2, 3, 0, 0}));
+    ASSERT_EQ(6U, results.size());
+    ASSERT_VALUE_EQ(results[0], Value(5));
+    ASSERT_VALUE_EQ(results[1], Value(5));
+    ASSERT_VALUE_EQ(results[2], Value(5));
+    ASSERT_VALUE_EQ(results[3], Value(3));
+    ASSERT_VALUE_EQ(results[4], Value(3));
+    ASSERT_VALUE_EQ(results[5], Value(3));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRecomputeSumAfterRemovingInfinity) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    deque<DocumentSource::GetNextResult> inputs{Document{{"x", 1.0}},
+                                                Document{{"x", infinity}},
+                                                Document{{"x", 2.0}},
+                                                Document{{"x", 3.0}}};
+    auto results =
+        runStage("{output: {out: {$sum: '$x', window: {documents: [-1, 'current']}}}}", inputs);
+    ASSERT_EQ(4U, results.size());
+    ASSERT_VALUE_EQ(results[2], Value(infinity));
+    ASSERT_VALUE_EQ(results[3], Value(5.0));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldUseWholePartitionByDefault) {
+    deque<DocumentSource::GetNextResult> inputs{Document{{"p", "a"_sd}, {"x", 1}},
+                                                Document{{"p", "a"_sd}, {"x", 2}},
+                                                Document{{"x", 4}},
+                                                Document{{"p", BSONNULL}, {"x", 8}}};
+    auto results = runStage("{partitionBy: '$p', output: {out: {$sum: '$x'}}}", inputs);
+    ASSERT_EQ(4U, results.size());
+    ASSERT_VALUE_EQ(results[0], Value(3));
+    ASSERT_VALUE_EQ(results[1], Value(3));
+    // A missing partition key is the same as null.
+    ASSERT_VALUE_EQ(results[2], Value(12));
+    ASSERT_VALUE_EQ(results[3], Value(12));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldHandleWindowsOutsideOfThePartition) {
+    auto results = runStage("{output: {out: {$push: '$x', window: {documents: [1, 2]}}}}",
+                            values({1, 2, 3}));
+    ASSERT_EQ(3U, results.size());
+    ASSERT_VALUE_EQ(results[0], Value(vector<Value>{Value(2), Value(3)}));
+    ASSERT_VALUE_EQ(results[1], Value(vector<Value>{Value(3)}));
+    ASSERT_VALUE_EQ(results[2], Value(vector<Value>{}));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldPropagatePauses) {
+    deque<DocumentSource::GetNextResult> inputs{Document{{"x", 1}},
+                                                DocumentSource::GetNextResult::makePauseExecution(),
+                                                Document{{"x", 2}},
+                                                DocumentSource::GetNextResult::makePauseExecution(),
+                                                Document{{"x", 3}}};
+    auto stage = createStage("{output: {out: {$sum: '$x', window: {documents: [0, 1]}}}}");
+    auto mock = DocumentSourceMock::create(std::move(inputs));
+    stage->setSource(mock.get());
+
+    ASSERT_TRUE(stage->getNext().isPaused());
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["out"], Value(3));
+    ASSERT_TRUE(stage->getNext().isPaused());
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["out"], Value(5));
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.getDocument()["out"], Value(3));
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+TEST_F(SetWindowFieldsTest, ShouldFailWhenPartitionExceedsMemoryLimit) {
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    DocumentSourceInternalSetWindowFields::WindowFunctionStatement statement;
+    statement.fieldName = "out";
+    statement.factory = AccumulationStatement::getFactory("$sum");
+    statement.expression = ExpressionFieldPath::parse(getExpCtx(), "$x", vps);
+
+    const uint64_t maxMemoryUsageBytes = 1000;
+    auto stage = DocumentSourceInternalSetWindowFields::create(
+        getExpCtx(), nullptr, {statement}, idGen.getIdCount(), maxMemoryUsageBytes);
+
+    std::string largeStr(maxMemoryUsageBytes / 2, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"x", 1}, {"largeStr", largeStr}},
+                                            Document{{"x", 2}, {"largeStr", largeStr}},
+                                            Document{{"x", 3}, {"largeStr", largeStr}}});
+    stage->setSource(mock.get());
+    ASSERT_THROWS_CODE(stage->getNext(), UserException, 40396);
+}
+
+TEST_F(SetWindowFieldsTest, ShouldSerializeToItsOwnSpecification) {
+    auto stage = createStage(
+        "{partitionBy: '$p', output: {a: {$sum: '$x', window: {documents: ['unbounded', 2]}}, "
+        "b: {$max: '$y'}}}");
+    vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1U, serialized.size());
+    ASSERT_VALUE_EQ(
+        serialized[0],
+        Value(fromjson("{$_internalSetWindowFields: {partitionBy: '$p', output: {"
+                       "a: {$sum: '$x', window: {documents: ['unbounded', 2]}}, "
+                       "b: {$max: '$y', window: {documents: ['unbounded', 'unbounded']}}}}}")));
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRejectInvalidSpecifications) {
+    ASSERT_THROWS_CODE(createStage("{}"), UserException, 40418);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1}}, foo: 1}"), UserException, 40398);
+    ASSERT_THROWS_CODE(createStage("{output: {'a.b': {$sum: 1}}}"), UserException, 40400);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {window: {documents: [0, 0]}}}}"),
+                       UserException,
+                       40417);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1, $max: 1}}}"), UserException, 40401);
+    ASSERT_THROWS_CODE(
+        createStage("{output: {out: {$sum: 1, window: {range: [0, 0]}}}}"), UserException, 40402);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1, window: {documents: [0]}}}}"),
+                       UserException,
+                       40402);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1, window: {documents: ['x', 0]}}}}"),
+                       UserException,
+                       40403);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1, window: {documents: [0, 1.5]}}}}"),
+                       UserException,
+                       40403);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: 1, window: {documents: [1, 0]}}}}"),
+                       UserException,
+                       40404);
+    ASSERT_THROWS_CODE(createStage("{output: {out: {$sum: [1, 2]}}}"), UserException, 40415);
+}
+
+TEST_F(SetWindowFieldsTest, ShouldRejectArrayValuedPartitions) {
+    auto stage = createStage("{partitionBy: '$p', output: {out: {$sum: '$x'}}}");
+    auto mock = DocumentSourceMock::create({Document{{"p", 1}, {"x", 1}},
+                                            Document{{"p", vector<Value>{Value(1), Value(2)}},
+                                                     {"x", 2}}});
+    stage->setSource(mock.get());
+    ASSERT_THROWS_CODE(stage->getNext(), UserException, 40420);
+}
+
+TEST_F(SetWindowFieldsTest, AliasShouldSortByPartitionFieldAndSortBy) {
+    BSONObj spec = fromjson(
+        "{$setWindowFields: {partitionBy: '$p', sortBy: {t: 1}, output: {out: {$sum: '$x'}}}}");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT_EQ(2U, stages.size());
+
+    auto sort = dynamic_cast<DocumentSourceSort*>(stages[0].get());
+    ASSERT(sort);
+    ASSERT_BSONOBJ_EQ(sort->serializeSortKey(false).toBson(), BSON("p" << 1 << "t" << 1));
+    ASSERT(dynamic_cast<DocumentSourceInternalSetWindowFields*>(stages[1].get()));
+}
+
+TEST_F(SetWindowFieldsTest, AliasShouldComputeExpressionPartitionsIntoATemporaryField) {
+    BSONObj spec = fromjson(
+        "{$setWindowFields: {partitionBy: {$mod: ['$p', 2]}, output: {out: {$sum: '$x'}}}}");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT_EQ(4U, stages.size());
+    ASSERT_EQ(std::string("$addFields"), stages[0]->getSourceName());
+    ASSERT(dynamic_cast<DocumentSourceSort*>(stages[1].get()));
+    ASSERT(dynamic_cast<DocumentSourceInternalSetWindowFields*>(stages[2].get()));
+    ASSERT_EQ(std::string("$project"), stages[3]->getSourceName());
+}
+
+TEST_F(SetWindowFieldsTest, AliasShouldNotSortWithoutPartitionOrSortBy) {
+    BSONObj spec = fromjson("{$setWindowFields: {output: {out: {$sum: '$x'}}}}");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT_EQ(1U, stages.size());
+    ASSERT(dynamic_cast<DocumentSourceInternalSetWindowFields*>(stages[0].get()));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -65,6 +65,23 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::getNex
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceSingleDocumentTransformation::getNextBatch(std::vector<Document>* batch,
+                                                         size_t maxDocs) {
+    pExpCtx->checkForInterrupt();
+
+    const size_t initialSize = batch->size();
+    auto status = pSource->getNextBatch(batch, maxDocs);
+    if (status != GetNextResult::ReturnStatus::kAdvanced) {
+        return status;
+    }
+
+    for (auto it = batch->begin() + initialSize; it != batch->end(); ++it) {
+        *it = _parsedTransform->applyTransformation(std::move(*it));
+    }
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     _parsedTransform->optimize();
     return this;
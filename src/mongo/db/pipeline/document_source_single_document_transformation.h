@@ -68,6 +68,7 @@ public:
     // virtuals from DocumentSource
     const char* getSourceName() const final;
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) final;
     boost::intrusive_ptr<DocumentSource> optimize() final;
     void dispose() final;
     Value serialize(bool explain) const final;
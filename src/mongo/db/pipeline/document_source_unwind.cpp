@@ -191,6 +191,14 @@ DocumentSource::GetNextResult DocumentSourceUnwind::getNext() {
 
     auto nextOut = _unwinder->getNext();
     while (nextOut.isEOF()) {
+        // Finish any input left over from getNextBatch() first.
+        if (_inputBatchPosition < _inputBatch.size()) {
+            Document input = std::move(_inputBatch[_inputBatchPosition++]);
+            _unwinder->resetDocument(input);
+            nextOut = _unwinder->getNext();
+            continue;
+        }
+
         // No more elements in array currently being unwound. This will loop if the input
         // document is missing the unwind field or has an empty array.
         auto nextInput = pSource->getNext();
@@ -206,6 +214,40 @@ DocumentSource::GetNextResult DocumentSourceUnwind::getNext() {
     return nextOut;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceUnwind::getNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    pExpCtx->checkForInterrupt();
+
+    const size_t initialSize = batch->size();
+    while (batch->size() - initialSize < maxDocs) {
+        auto nextOut = _unwinder->getNext();
+        if (nextOut.isAdvanced()) {
+            batch->push_back(nextOut.releaseDocument());
+            continue;
+        }
+
+        if (_inputBatchPosition == _inputBatch.size()) {
+            // Return what we have rather than hold it across a status that stops the batch.
+            if (batch->size() > initialSize) {
+                break;
+            }
+
+            _inputBatch.clear();
+            _inputBatchPosition = 0;
+            auto status = pSource->getNextBatch(&_inputBatch, maxDocs);
+            if (status != GetNextResult::ReturnStatus::kAdvanced) {
+                return status;
+            }
+        }
+
+        // Release our reference to the input as soon as the unwinder has it, so that the output
+        // documents do not have to copy it on write.
+        Document input = std::move(_inputBatch[_inputBatchPosition++]);
+        _unwinder->resetDocument(input);
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 BSONObjSet DocumentSourceUnwind::getOutputSorts() {
     BSONObjSet out = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     std::string unwoundPath = getUnwindPath();
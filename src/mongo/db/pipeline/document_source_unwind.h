@@ -37,6 +37,7 @@ class DocumentSourceUnwind final : public DocumentSource {
 public:
     // virtuals from DocumentSource
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) final;
     const char* getSourceName() const final;
     Value serialize(bool explain = false) const final;
     BSONObjSet getOutputSorts() final;
@@ -94,6 +95,10 @@ private:
     // Iteration state.
     class Unwinder;
     std::unique_ptr<Unwinder> _unwinder;
+
+    // Input documents pulled from our child by getNextBatch() but not yet unwound.
+    std::vector<Document> _inputBatch;
+    size_t _inputBatchPosition = 0;
 };
 
 }  // namespace mongo
@@ -719,6 +719,43 @@ TEST_F(UnwindStageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(unwind->getNext().isEOF());
 }
 
+TEST_F(UnwindStageTest, ShouldUnwindBatchesAndPropagatePauses) {
+    using ReturnStatus = DocumentSource::GetNextResult::ReturnStatus;
+
+    const bool includeNullIfEmptyOrMissing = false;
+    const boost::optional<std::string> includeArrayIndex = boost::none;
+    auto unwind = DocumentSourceUnwind::create(
+        getExpCtx(), "array", includeNullIfEmptyOrMissing, includeArrayIndex);
+    auto source = DocumentSourceMock::create(
+        {Document{{"array", vector<Value>{Value(1), Value(2), Value(3)}}},
+         Document{{"array", vector<Value>{Value(4)}}},
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document{{"array", vector<Value>{Value(5), Value(6)}}}});
+    unwind->setSource(source.get());
+
+    // A batch stops at 'maxDocs', even in the middle of an input document.
+    std::vector<Document> batch;
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(2U, batch.size());
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(4U, batch.size());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_DOCUMENT_EQ(batch[i], (Document{{"array", i + 1}}));
+    }
+    batch.clear();
+
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kPauseExecution);
+    ASSERT_TRUE(batch.empty());
+
+    ASSERT(unwind->getNextBatch(&batch, 10) == ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(2U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"array", 5}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"array", 6}}));
+
+    ASSERT(unwind->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+    ASSERT(unwind->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+}
+
 TEST_F(UnwindStageTest, UnwindOnlyModifiesUnwoundPathWhenNotIncludingIndex) {
     const bool includeNullIfEmptyOrMissing = false;
     const boost::optional<std::string> includeArrayIndex = boost::none;
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeDocument(std::int64_t fields) {
+    BSONObjBuilder builder;
+    for (std::int64_t i = 0; i < fields; ++i) {
+        const std::string name = "field" + std::to_string(i);
+        if (i % 3 == 0) {
+            builder.append(name, static_cast<int>(i));
+        } else if (i % 3 == 1) {
+            builder.append(name, "a string value");
+        } else {
+            builder.append(name, BSON("nested" << static_cast<long long>(i)));
+        }
+    }
+    return builder.obj();
+}
+
+void BM_documentFromBson(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.arg());
+    while (state.keepRunning()) {
+        Document doc(obj);
+        benchmark::doNotOptimize(doc.size());
+    }
+}
+MONGO_BENCHMARK(BM_documentFromBson)->arg(4)->arg(32)->arg(256);
+
+void BM_documentFromBsonLazily(benchmark::State& state) {
+    const BSONObj obj = makeDocument(state.arg());
+    while (state.keepRunning()) {
+        Document doc = Document::fromBsonWithMetaDataLazily(obj);
+        benchmark::doNotOptimize(doc["field1"]);
+    }
+}
+MONGO_BENCHMARK(BM_documentFromBsonLazily)->arg(4)->arg(32)->arg(256);
+
+void BM_documentToBson(benchmark::State& state) {
+    const Document doc(makeDocument(state.arg()));
+    while (state.keepRunning()) {
+        BSONObj obj = doc.toBson();
+        benchmark::doNotOptimize(obj.objdata());
+    }
+}
+MONGO_BENCHMARK(BM_documentToBson)->arg(4)->arg(32)->arg(256);
+
+void BM_documentGetField(benchmark::State& state) {
+    const Document doc(makeDocument(state.arg()));
+    const std::string last = "field" + std::to_string(state.arg() - 1);
+    while (state.keepRunning()) {
+        benchmark::doNotOptimize(doc[last]);
+    }
+}
+MONGO_BENCHMARK(BM_documentGetField)->arg(4)->arg(32)->arg(256);
+
+void BM_mutableDocumentAddField(benchmark::State& state) {
+    const Document doc(makeDocument(state.arg()));
+    while (state.keepRunning()) {
+        MutableDocument mutableDoc(doc);
+        mutableDoc.addField("added", Value(1));
+        Document result = mutableDoc.freeze();
+        benchmark::doNotOptimize(result.size());
+    }
+}
+MONGO_BENCHMARK(BM_mutableDocumentAddField)->arg(4)->arg(32)->arg(256);
+
+void BM_valueFromBsonElement(benchmark::State& state) {
+    const BSONObj obj = BSON("int" << 1 << "string"
+                                   << "a string value"
+                                   << "array"
+                                   << BSON_ARRAY(1 << 2 << 3 << 4));
+    while (state.keepRunning()) {
+        for (auto&& element : obj) {
+            Value value(element);
+            benchmark::doNotOptimize(value.getType());
+        }
+    }
+}
+MONGO_BENCHMARK(BM_valueFromBsonElement);
+
+}  // namespace
+}  // namespace mongo
@@ -112,6 +112,66 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone);
 }
 
+TEST(DocumentConstruction, LazilyFromBsonLooksUpFieldsInAnyOrder) {
+    BSONObj obj = BSON("a" << 1 << "b" << BSON("x" << 2) << "c"
+                           << "q"
+                           << "d"
+                           << 4);
+    Document document = Document::fromBsonWithMetaDataLazily(obj);
+    ASSERT_EQUALS(2, document["b"]["x"].getInt());
+    ASSERT_EQUALS(1, document["a"].getInt());
+    ASSERT_TRUE(document["e"].missing());
+    ASSERT_EQUALS(4, document["d"].getInt());
+    ASSERT_EQUALS("q", document["c"].getString());
+
+    ASSERT_EQUALS(4U, document.size());
+    ASSERT_EQUALS("c", getNthField(document, 2).first.toString());
+    ASSERT_DOCUMENT_EQ(document, fromBson(obj));
+    ASSERT_BSONOBJ_EQ(obj, toBson(document));
+}
+
+TEST(DocumentConstruction, LazilyFromBsonFindsFirstOfDuplicateFields) {
+    Document document = Document::fromBsonWithMetaDataLazily(BSON("a" << 1 << "a" << 2));
+    ASSERT_EQUALS(1, document["a"].getInt());
+    ASSERT_EQUALS(2U, document.size());
+}
+
+TEST(DocumentConstruction, LazilyFromBsonCanBeModified) {
+    Document document =
+        Document::fromBsonWithMetaDataLazily(BSON("a" << 1 << "b" << 2 << "c" << 3));
+    ASSERT_EQUALS(1, document["a"].getInt());
+
+    MutableDocument md(document);
+    md.addField("d", Value(4));
+    md["b"] = Value(5);
+    ASSERT_DOCUMENT_EQ(md.freeze(), (Document{{"a", 1}, {"b", 5}, {"c", 3}, {"d", 4}}));
+
+    // The original is unchanged.
+    ASSERT_DOCUMENT_EQ(document, (Document{{"a", 1}, {"b", 2}, {"c", 3}}));
+}
+
+TEST(DocumentConstruction, LazilyFromBsonClone) {
+    Document document =
+        Document::fromBsonWithMetaDataLazily(BSON("a" << 1 << "b" << 2 << "c" << 3));
+    ASSERT_EQUALS(2, document["b"].getInt());
+    Document documentClone = document.clone();
+    ASSERT_EQUALS(3, documentClone["c"].getInt());
+    ASSERT_DOCUMENT_EQ(document, documentClone);
+}
+
+TEST(DocumentConstruction, LazilyFromBsonDoesNotReferenceInput) {
+    Document document;
+    {
+        BSONObjBuilder bob;
+        bob.append("a", "hello");
+        bob.append("b", 2);
+        BSONObj unowned(bob.asTempObj());
+        document = Document::fromBsonWithMetaDataLazily(unowned);
+    }
+    ASSERT_EQUALS(2, document["b"].getInt());
+    ASSERT_EQUALS("hello", document["a"].getString());
+}
+
 /** Add Document fields. */
 class AddField {
 public:
@@ -535,6 +595,20 @@ TEST(MetaFields, ToAndFromBson) {
     ASSERT_EQ(20, fromBson.getRandMetaField());
 }
 
+TEST(MetaFields, FromBsonLazily) {
+    BSONObj obj = BSON("a" << 1 << Document::metaFieldTextScore << 10.0 << "b" << 2
+                           << Document::metaFieldRandVal
+                           << 20.0);
+    Document doc = Document::fromBsonWithMetaDataLazily(obj);
+    ASSERT_TRUE(doc.hasTextScore());
+    ASSERT_TRUE(doc.hasRandMetaField());
+    ASSERT_EQ(10.0, doc.getTextScore());
+    ASSERT_EQ(20, doc.getRandMetaField());
+    ASSERT_TRUE(doc[Document::metaFieldTextScore].missing());
+    ASSERT_DOCUMENT_EQ(doc, (Document{{"a", 1}, {"b", 2}}));
+    ASSERT_DOCUMENT_EQ(doc, Document::fromBsonWithMetaData(obj));
+}
+
 TEST(MetaFields, BadSerialization) {
     // Write an unrecognized option to the buffer.
     BufBuilder bb;
@@ -789,7 +789,10 @@ static const CmpLookup cmpLookup[7] = {
 Value ExpressionCompare::evaluateInternal(Variables* vars) const {
     Value pLeft(vpOperand[0]->evaluateInternal(vars));
     Value pRight(vpOperand[1]->evaluateInternal(vars));
+    return evaluateComparison(pLeft, pRight);
+}
 
+Value ExpressionCompare::evaluateComparison(const Value& pLeft, const Value& pRight) const {
     int cmp = getExpressionContext()->getValueComparator().compare(pLeft, pRight);
 
     // Make cmp one of 1, 0, or -1.
@@ -316,6 +316,10 @@ public:
     */
     virtual void addOperand(const boost::intrusive_ptr<Expression>& pExpression);
 
+    const std::vector<boost::intrusive_ptr<Expression>>& getOperandList() const {
+        return vpOperand;
+    }
+
     virtual bool isAssociative() const {
         return false;
     }
@@ -644,6 +648,11 @@ public:
     Value evaluateInternal(Variables* vars) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns the result of this comparison for operands which have already been evaluated.
+     */
+    Value evaluateComparison(const Value& lhs, const Value& rhs) const;
+
     static boost::intrusive_ptr<Expression> parse(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         BSONElement bsonExpr,
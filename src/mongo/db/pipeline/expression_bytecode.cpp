@@ -0,0 +1,223 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_bytecode.h"
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+/**
+ * Emits the instructions for an expression tree, one node at a time. Each node's code leaves the
+ * node's value in the register it was given, and may use the registers above that one as
+ * scratch space.
+ */
+class CompiledExpression::Compiler {
+public:
+    explicit Compiler(CompiledExpression* out) : _out(out) {}
+
+    /**
+     * Appends code computing 'expression' into register 'dst'. Returns false if that needs more
+     * than kMaxRegisters registers.
+     */
+    bool compile(const intrusive_ptr<Expression>& expression, size_t dst) {
+        if (dst >= kMaxRegisters) {
+            return false;
+        }
+
+        const Expression* expr = expression.get();
+        if (auto constant = dynamic_cast<const ExpressionConstant*>(expr)) {
+            _out->_constants.push_back(constant->getValue());
+            emit(OpCode::kLoadConstant, dst, 0, _out->_constants.size() - 1);
+            return true;
+        }
+        if (auto andExpr = dynamic_cast<const ExpressionAnd*>(expr)) {
+            return compileShortCircuit(andExpr->getOperandList(), dst, false);
+        }
+        if (auto orExpr = dynamic_cast<const ExpressionOr*>(expr)) {
+            return compileShortCircuit(orExpr->getOperandList(), dst, true);
+        }
+        if (auto notExpr = dynamic_cast<const ExpressionNot*>(expr)) {
+            if (!compile(notExpr->getOperandList()[0], dst)) {
+                return false;
+            }
+            emit(OpCode::kNot, dst);
+            return true;
+        }
+        if (auto cond = dynamic_cast<const ExpressionCond*>(expr)) {
+            const auto& operands = cond->getOperandList();
+            if (!compile(operands[0], dst)) {
+                return false;
+            }
+            const size_t toElse = emit(OpCode::kJumpIfFalse, dst);
+            if (!compile(operands[1], dst)) {
+                return false;
+            }
+            const size_t toEnd = emit(OpCode::kJump, dst);
+            patchJumpToHere(toElse);
+            if (!compile(operands[2], dst)) {
+                return false;
+            }
+            patchJumpToHere(toEnd);
+            return true;
+        }
+        if (auto ifNull = dynamic_cast<const ExpressionIfNull*>(expr)) {
+            const auto& operands = ifNull->getOperandList();
+            if (!compile(operands[0], dst)) {
+                return false;
+            }
+            const size_t toEnd = emit(OpCode::kJumpIfNotNullish, dst);
+            if (!compile(operands[1], dst)) {
+                return false;
+            }
+            patchJumpToHere(toEnd);
+            return true;
+        }
+        if (auto compare = dynamic_cast<ExpressionCompare*>(expression.get())) {
+            const auto& operands = compare->getOperandList();
+            if (!compile(operands[0], dst) || !compile(operands[1], dst + 1)) {
+                return false;
+            }
+            _out->_comparisons.push_back(compare);
+            emit(OpCode::kCompare, dst, dst + 1, _out->_comparisons.size() - 1);
+            return true;
+        }
+
+        _out->_expressions.push_back(expression);
+        emit(OpCode::kEvaluate, dst, 0, _out->_expressions.size() - 1);
+        return true;
+    }
+
+private:
+    /**
+     * $and stops at the first false operand and $or at the first true one. 'stopOn' says which
+     * applies, and is also the result in that case.
+     */
+    bool compileShortCircuit(const std::vector<intrusive_ptr<Expression>>& operands,
+                             size_t dst,
+                             bool stopOn) {
+        std::vector<size_t> toStopped;
+        for (auto&& operand : operands) {
+            if (!compile(operand, dst)) {
+                return false;
+            }
+            toStopped.push_back(emit(stopOn ? OpCode::kJumpIfTrue : OpCode::kJumpIfFalse, dst));
+        }
+        emit(OpCode::kLoadBool, dst, 0, !stopOn);
+        const size_t toEnd = emit(OpCode::kJump, dst);
+        for (auto jump : toStopped) {
+            patchJumpToHere(jump);
+        }
+        emit(OpCode::kLoadBool, dst, 0, stopOn);
+        patchJumpToHere(toEnd);
+        return true;
+    }
+
+    size_t emit(OpCode op, size_t dst, size_t src = 0, size_t arg = 0) {
+        _out->_code.push_back({op,
+                               static_cast<uint8_t>(dst),
+                               static_cast<uint8_t>(src),
+                               static_cast<uint32_t>(arg)});
+        return _out->_code.size() - 1;
+    }
+
+    void patchJumpToHere(size_t jump) {
+        _out->_code[jump].arg = _out->_code.size();
+    }
+
+    CompiledExpression* const _out;
+};
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(
+    const intrusive_ptr<Expression>& expression) {
+    std::unique_ptr<CompiledExpression> out(new CompiledExpression());
+    if (!Compiler(out.get()).compile(expression, 0)) {
+        return nullptr;
+    }
+
+    // A lone constant or a lone call back into the tree is no faster than the tree itself.
+    if (out->_code.size() == 1) {
+        return nullptr;
+    }
+    return out;
+}
+
+Value CompiledExpression::evaluate(Variables* vars) const {
+    Value regs[kMaxRegisters];
+
+    const Instruction* const code = _code.data();
+    const size_t codeSize = _code.size();
+    size_t pc = 0;
+    while (pc < codeSize) {
+        const Instruction& instr = code[pc++];
+        switch (instr.op) {
+            case OpCode::kLoadConstant:
+                regs[instr.dst] = _constants[instr.arg];
+                break;
+            case OpCode::kLoadBool:
+                regs[instr.dst] = Value(instr.arg != 0);
+                break;
+            case OpCode::kEvaluate:
+                regs[instr.dst] = _expressions[instr.arg]->evaluateInternal(vars);
+                break;
+            case OpCode::kCompare:
+                regs[instr.dst] =
+                    _comparisons[instr.arg]->evaluateComparison(regs[instr.dst], regs[instr.src]);
+                break;
+            case OpCode::kNot:
+                regs[instr.dst] = Value(!regs[instr.dst].coerceToBool());
+                break;
+            case OpCode::kJump:
+                pc = instr.arg;
+                break;
+            case OpCode::kJumpIfFalse:
+                if (!regs[instr.dst].coerceToBool())
+                    pc = instr.arg;
+                break;
+            case OpCode::kJumpIfTrue:
+                if (regs[instr.dst].coerceToBool())
+                    pc = instr.arg;
+                break;
+            case OpCode::kJumpIfNotNullish:
+                if (!regs[instr.dst].nullish())
+                    pc = instr.arg;
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+    return regs[0];
+}
+
+}  // namespace mongo
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/value.h"
+
+namespace mongo {
+
+/**
+ * A flattened form of an optimized Expression tree. A small register-based interpreter runs it,
+ * in place of recursive calls to Expression::evaluateInternal().
+ *
+ * Constants and the control flow and comparison operators are lowered into instructions. These
+ * are $and, $or, $not, $cond, $ifNull and the comparison operators such as $eq and $lt. Every
+ * other subexpression becomes a single instruction that evaluates it the usual way. So the
+ * result of an expression never changes when it is compiled; what changes is the number of
+ * virtual calls and temporary Values needed to compute it. Short-circuiting branches become
+ * jumps.
+ */
+class CompiledExpression {
+    MONGO_DISALLOW_COPYING(CompiledExpression);
+
+public:
+    /**
+     * Returns the compiled form of 'expression'. Returns nullptr if that form would only call
+     * back into 'expression' itself, or if it needs more registers than the interpreter has.
+     */
+    static std::unique_ptr<CompiledExpression> compile(
+        const boost::intrusive_ptr<Expression>& expression);
+
+    /**
+     * Returns the same Value as evaluating the original expression with the same 'vars'.
+     */
+    Value evaluate(Variables* vars) const;
+
+    size_t numInstructions() const {
+        return _code.size();
+    }
+
+private:
+    class Compiler;
+
+    enum class OpCode : uint8_t {
+        kLoadConstant,      // regs[dst] = _constants[arg]
+        kLoadBool,          // regs[dst] = Value(bool(arg))
+        kEvaluate,          // regs[dst] = _expressions[arg]->evaluateInternal(vars)
+        kCompare,           // regs[dst] = _comparisons[arg] applied to regs[dst] and regs[src]
+        kNot,               // regs[dst] = Value(!regs[dst].coerceToBool())
+        kJump,              // pc = arg
+        kJumpIfFalse,       // if (!regs[dst].coerceToBool()) pc = arg
+        kJumpIfTrue,        // if (regs[dst].coerceToBool()) pc = arg
+        kJumpIfNotNullish,  // if (!regs[dst].nullish()) pc = arg
+    };
+
+    struct Instruction {
+        OpCode op;
+        uint8_t dst;
+        uint8_t src;
+        uint32_t arg;
+    };
+
+    // Only nested comparisons need a register beyond the result register, one per level.
+    static const size_t kMaxRegisters = 16;
+
+    CompiledExpression() = default;
+
+    std::vector<Instruction> _code;
+    std::vector<Value> _constants;
+    std::vector<boost::intrusive_ptr<Expression>> _expressions;
+    std::vector<boost::intrusive_ptr<ExpressionCompare>> _comparisons;
+};
+
+}  // namespace mongo
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_bytecode.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using boost::intrusive_ptr;
+
+intrusive_ptr<Expression> parse(const char* json) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    VariablesIdGenerator idGenerator;
+    VariablesParseState vps(&idGenerator);
+    BSONObj obj = BSON("expr" << fromjson(json));
+    return Expression::parseOperand(expCtx, obj.firstElement(), vps);
+}
+
+Value evaluateCompiled(const CompiledExpression& compiled, const Document& root) {
+    Variables vars(0, root);
+    return compiled.evaluate(&vars);
+}
+
+/**
+ * Asserts that 'json' compiles, and that the compiled form gives the same result as the tree for
+ * each of 'inputs'.
+ */
+void assertCompiledMatchesTree(const char* json, const std::vector<Document>& inputs) {
+    auto expr = parse(json);
+    auto compiled = CompiledExpression::compile(expr);
+    ASSERT(compiled);
+    for (auto&& input : inputs) {
+        Value expected = expr->evaluate(input);
+        Value actual = evaluateCompiled(*compiled, input);
+        ASSERT_VALUE_EQ(expected, actual);
+        ASSERT_EQUALS(expected.getType(), actual.getType());
+    }
+}
+
+const std::vector<Document> kInputs = {Document(),
+                                       Document{{"a", 1}, {"b", 2}},
+                                       Document{{"a", 0}, {"b", BSONNULL}},
+                                       Document{{"a", "x"_sd}, {"b", 3}},
+                                       Document{{"a", 5}, {"b", 5}}};
+
+TEST(CompiledExpressionTest, LogicalOperatorsMatchTree) {
+    assertCompiledMatchesTree("{$and: ['$a', '$b']}", kInputs);
+    assertCompiledMatchesTree("{$or: ['$a', '$b', false]}", kInputs);
+    assertCompiledMatchesTree("{$not: [{$and: ['$a', {$or: ['$b']}]}]}", kInputs);
+    assertCompiledMatchesTree("{$and: []}", kInputs);
+    assertCompiledMatchesTree("{$or: []}", kInputs);
+}
+
+TEST(CompiledExpressionTest, ConditionalOperatorsMatchTree) {
+    assertCompiledMatchesTree("{$cond: ['$a', '$b', 'otherwise']}", kInputs);
+    assertCompiledMatchesTree("{$cond: {if: {$not: ['$a']}, then: 1, else: {$ifNull: ['$b', 2]}}}",
+                              kInputs);
+    assertCompiledMatchesTree("{$ifNull: ['$b', '$a']}", kInputs);
+}
+
+TEST(CompiledExpressionTest, ComparisonsMatchTree) {
+    assertCompiledMatchesTree("{$eq: ['$a', '$b']}", kInputs);
+    assertCompiledMatchesTree("{$cmp: ['$a', '$b']}", kInputs);
+    assertCompiledMatchesTree("{$and: [{$gte: ['$a', 1]}, {$lt: ['$b', {$add: ['$a', 1]}]}]}",
+                              kInputs);
+    assertCompiledMatchesTree("{$ne: [{$gt: ['$a', '$b']}, {$lte: ['$b', '$a']}]}", kInputs);
+}
+
+TEST(CompiledExpressionTest, ShortCircuitsLikeTree) {
+    auto compiled = CompiledExpression::compile(parse("{$and: ['$a', {$divide: [1, '$zero']}]}"));
+    ASSERT(compiled);
+    ASSERT_VALUE_EQ(Value(false), evaluateCompiled(*compiled, Document{{"a", false}, {"zero", 0}}));
+    ASSERT_THROWS(evaluateCompiled(*compiled, Document{{"a", true}, {"zero", 0}}),
+                  UserException);
+}
+
+TEST(CompiledExpressionTest, DoesNotCompileLeaves) {
+    ASSERT_FALSE(CompiledExpression::compile(parse("'$a'")));
+    ASSERT_FALSE(CompiledExpression::compile(parse("{$const: 1}")));
+    ASSERT_FALSE(CompiledExpression::compile(parse("{$add: ['$a', 1]}")));
+}
+
+TEST(CompiledExpressionTest, DoesNotCompileIfTooManyRegistersAreNeeded) {
+    // Each comparison nested in the right-hand operand needs one more register.
+    std::string json = "'$a'";
+    for (int i = 0; i < 20; ++i) {
+        json = "{$eq: ['$a', " + json + "]}";
+    }
+    ASSERT_FALSE(CompiledExpression::compile(parse(json.c_str())));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -30,11 +30,28 @@
 
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/util/concurrency/threadlocal.h"
 
 namespace mongo {
 
 using boost::intrusive_ptr;
 
+namespace {
+// Non-null while a WorkerThreadInterruptScope is active on this thread.
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL const AtomicWord<ErrorCodes::Error>* workerKillCode =
+    nullptr;
+}  // namespace
+
+ExpressionContext::WorkerThreadInterruptScope::WorkerThreadInterruptScope(
+    const AtomicWord<ErrorCodes::Error>* killCode) {
+    invariant(!workerKillCode);
+    workerKillCode = killCode;
+}
+
+ExpressionContext::WorkerThreadInterruptScope::~WorkerThreadInterruptScope() {
+    workerKillCode = nullptr;
+}
+
 ExpressionContext::ResolvedNamespace::ResolvedNamespace(NamespaceString ns,
                                                         std::vector<BSONObj> pipeline)
     : ns(std::move(ns)), pipeline(std::move(pipeline)) {}
@@ -56,6 +73,12 @@ ExpressionContext::ExpressionContext(OperationContext* opCtx,
       _resolvedNamespaces(std::move(resolvedNamespaces)) {}
 
 void ExpressionContext::checkForInterrupt() {
+    if (MONGO_unlikely(workerKillCode)) {
+        const auto killCode = workerKillCode->loadRelaxed();
+        uassert(killCode, "operation was interrupted", killCode == ErrorCodes::OK);
+        return;
+    }
+
     // This check could be expensive, at least in relative terms, so don't check every time.
     if (--_interruptCounter == 0) {
         opCtx->checkForInterrupt();
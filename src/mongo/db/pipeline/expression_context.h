@@ -33,6 +33,8 @@
 #include <string>
 #include <vector>
 
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/error_codes.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/pipeline/document_comparator.h"
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/string_map.h"
 
@@ -70,6 +73,20 @@ public:
      */
     void checkForInterrupt();
 
+    /**
+     * Threads that run part of a pipeline on behalf of another thread's operation must not use
+     * its OperationContext. While one of these is in scope on such a thread, checkForInterrupt()
+     * there throws once 'killCode' holds an error, and does nothing otherwise. The thread which
+     * owns the operation is responsible for setting 'killCode' when the operation is interrupted.
+     */
+    class WorkerThreadInterruptScope {
+        MONGO_DISALLOW_COPYING(WorkerThreadInterruptScope);
+
+    public:
+        explicit WorkerThreadInterruptScope(const AtomicWord<ErrorCodes::Error>* killCode);
+        ~WorkerThreadInterruptScope();
+    };
+
     const CollatorInterface* getCollator() const {
         return _collator.get();
     }
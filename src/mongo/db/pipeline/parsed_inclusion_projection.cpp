@@ -32,6 +32,8 @@
 
 #include <algorithm>
 
+#include "mongo/db/query/query_knobs.h"
+
 namespace mongo {
 
 namespace parsed_aggregation_projection {
@@ -46,8 +48,16 @@ using std::unique_ptr;
 InclusionNode::InclusionNode(std::string pathToNode) : _pathToNode(std::move(pathToNode)) {}
 
 void InclusionNode::optimize() {
+    const bool compile = internalQueryCompileAggregationExpressions.load();
+    _compiledExpressions.clear();
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
+        if (!compile) {
+            continue;
+        }
+        if (auto compiled = CompiledExpression::compile(expressionIt.second)) {
+            _compiledExpressions[expressionIt.first] = std::move(compiled);
+        }
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
@@ -147,6 +157,13 @@ void InclusionNode::addComputedFields(MutableDocument* outputDoc, Variables* var
             outputDoc->setField(field,
                                 childIt->second->addComputedFields(outputDoc->peek()[field], vars));
         } else {
+            if (!_compiledExpressions.empty()) {
+                auto compiledIt = _compiledExpressions.find(field);
+                if (compiledIt != _compiledExpressions.end()) {
+                    outputDoc->setField(field, compiledIt->second->evaluate(vars));
+                    continue;
+                }
+            }
             auto expressionIt = _expressions.find(field);
             invariant(expressionIt != _expressions.end());
             outputDoc->setField(field, expressionIt->second->evaluate(vars));
@@ -31,6 +31,7 @@
 #include <memory>
 
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_bytecode.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/parsed_aggregation_projection.h"
 #include "mongo/stdx/memory.h"
@@ -55,7 +56,8 @@ public:
     InclusionNode(std::string pathToNode = "");
 
     /**
-     * Optimize any computed expressions.
+     * Optimize any computed expressions, and compile them if
+     * internalQueryCompileAggregationExpressions is set.
      */
     void optimize();
 
@@ -163,6 +165,10 @@ private:
     std::vector<std::string> _orderToProcessAdditionsAndChildren;
 
     StringMap<boost::intrusive_ptr<Expression>> _expressions;
+
+    // Compiled forms of those '_expressions' which benefit from compiling, filled by optimize().
+    stdx::unordered_map<std::string, std::unique_ptr<CompiledExpression>> _compiledExpressions;
+
     stdx::unordered_set<std::string> _inclusions;
 
     // TODO use StringMap once SERVER-23700 is resolved.
@@ -40,7 +40,9 @@
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace parsed_aggregation_projection {
@@ -633,6 +635,27 @@ TEST(InclusionProjectionExecutionTest, ShouldAlwaysKeepMetadataFromOriginalDoc)
     ASSERT_DOCUMENT_EQ(result, expectedDoc.freeze());
 }
 
+TEST(InclusionProjectionExecutionTest, ShouldApplyCompiledComputedFields) {
+    const bool oldCompile = internalQueryCompileAggregationExpressions.load();
+    ON_BLOCK_EXIT([oldCompile] { internalQueryCompileAggregationExpressions.store(oldCompile); });
+    internalQueryCompileAggregationExpressions.store(true);
+
+    ParsedInclusionProjection inclusion;
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    inclusion.parse(expCtx,
+                    fromjson("{a: true, big: {$cond: [{$gt: ['$a', 2]}, 'yes', 'no']},"
+                             " 'sub.c': {$ifNull: ['$c', '$a']}}"));
+    inclusion.optimize();
+
+    auto result = inclusion.applyProjection(Document{{"a", 3}});
+    auto expectedResult = Document{{"a", 3}, {"big", "yes"_sd}, {"sub", Document{{"c", 3}}}};
+    ASSERT_DOCUMENT_EQ(result, expectedResult);
+
+    result = inclusion.applyProjection(Document{{"a", 1}, {"c", 7}});
+    expectedResult = Document{{"a", 1}, {"big", "no"_sd}, {"sub", Document{{"c", 7}}}};
+    ASSERT_DOCUMENT_EQ(result, expectedResult);
+}
+
 }  // namespace
 }  // namespace parsed_aggregation_projection
 }  // namespace mongo
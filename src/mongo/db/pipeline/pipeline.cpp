@@ -32,6 +32,8 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/pipeline_optimizations.h"
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -41,12 +43,14 @@
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_out.h"
 #include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -59,10 +63,19 @@ using std::vector;
 
 namespace dps = ::mongo::dotted_path_support;
 
-Pipeline::Pipeline(const intrusive_ptr<ExpressionContext>& pTheCtx) : pCtx(pTheCtx) {}
+MONGO_EXPORT_SERVER_PARAMETER(internalPipelineGetNextBatchSize, int, 128);
+
+namespace {
+size_t getNextBatchSize() {
+    return std::max(1, internalPipelineGetNextBatchSize.load());
+}
+}  // namespace
+
+Pipeline::Pipeline(const intrusive_ptr<ExpressionContext>& pTheCtx)
+    : pCtx(pTheCtx), _getNextBatchSize(getNextBatchSize()) {}
 
 Pipeline::Pipeline(SourceContainer stages, const intrusive_ptr<ExpressionContext>& expCtx)
-    : _sources(stages), pCtx(expCtx) {}
+    : _sources(stages), pCtx(expCtx), _getNextBatchSize(getNextBatchSize()) {}
 
 StatusWith<intrusive_ptr<Pipeline>> Pipeline::parse(
     const std::vector<BSONObj>& rawPipeline, const intrusive_ptr<ExpressionContext>& expCtx) {
@@ -165,7 +178,7 @@ void Pipeline::reattachToOperationContext(OperationContext* opCtx) {
     }
 }
 
-intrusive_ptr<Pipeline> Pipeline::splitForSharded() {
+intrusive_ptr<Pipeline> Pipeline::splitForSharded(const BSONObj& shardKeyPattern) {
     // Create and initialize the shard spec we'll return. We start with an empty pipeline on the
     // shards and all work being done in the merger. Optimizations can move operations between
     // the pipelines to be more efficient.
@@ -173,18 +186,27 @@ intrusive_ptr<Pipeline> Pipeline::splitForSharded() {
 
     // The order in which optimizations are applied can have significant impact on the
     // efficiency of the final pipeline. Be Careful!
-    Optimizations::Sharded::findSplitPoint(shardPipeline.get(), this);
+    Optimizations::Sharded::findSplitPoint(shardPipeline.get(), this, shardKeyPattern);
     Optimizations::Sharded::moveFinalUnwindFromShardsToMerger(shardPipeline.get(), this);
     Optimizations::Sharded::limitFieldsSentFromShardsToMerger(shardPipeline.get(), this);
 
     return shardPipeline;
 }
 
-void Pipeline::Optimizations::Sharded::findSplitPoint(Pipeline* shardPipe, Pipeline* mergePipe) {
+void Pipeline::Optimizations::Sharded::findSplitPoint(Pipeline* shardPipe,
+                                                      Pipeline* mergePipe,
+                                                      const BSONObj& shardKeyPattern) {
     while (!mergePipe->_sources.empty()) {
         intrusive_ptr<DocumentSource> current = mergePipe->_sources.front();
         mergePipe->_sources.pop_front();
 
+        // A $group on the shard key produces complete groups on every shard, so there is no need
+        // to ship partial groups to the merger. Keep looking for a split point after it.
+        if (isShardLocalGroup(current.get(), shardPipe, shardKeyPattern)) {
+            shardPipe->_sources.push_back(current);
+            continue;
+        }
+
         // Check if this source is splittable
         SplittableDocumentSource* splittable =
             dynamic_cast<SplittableDocumentSource*>(current.get());
@@ -206,6 +228,36 @@ void Pipeline::Optimizations::Sharded::findSplitPoint(Pipeline* shardPipe, Pipel
     }
 }
 
+bool Pipeline::Optimizations::Sharded::isShardLocalGroup(const DocumentSource* source,
+                                                         const Pipeline* shardPipe,
+                                                         const BSONObj& shardKeyPattern) {
+    auto group = dynamic_cast<const DocumentSourceGroup*>(source);
+    if (!group || shardKeyPattern.isEmpty()) {
+        return false;
+    }
+
+    // Documents are placed on shards by binary comparison of their shard key values. Under a
+    // non-simple collation, strings which are placed on different shards can be grouped together.
+    if (shardPipe->getContext()->getCollator()) {
+        return false;
+    }
+
+    // The group's field paths only refer to the shard key if the documents reach the $group as
+    // they are stored. A $match filters whole documents, so only those may come before it.
+    for (auto&& stage : shardPipe->_sources) {
+        if (!dynamic_cast<DocumentSourceMatch*>(stage.get())) {
+            return false;
+        }
+    }
+
+    std::set<std::string> shardKeyFields;
+    for (auto&& elem : shardKeyPattern) {
+        shardKeyFields.insert(elem.fieldName());
+    }
+
+    return group->groupsByFieldPaths(shardKeyFields);
+}
+
 void Pipeline::Optimizations::Sharded::moveFinalUnwindFromShardsToMerger(Pipeline* shardPipe,
                                                                          Pipeline* mergePipe) {
     while (!shardPipe->_sources.empty() &&
@@ -310,8 +362,29 @@ void Pipeline::stitch() {
     }
 }
 
+void Pipeline::disableBatchedGetNext() {
+    invariant(_batch.empty());
+    _getNextBatchSize = 1;
+}
+
 boost::optional<Document> Pipeline::getNext() {
     invariant(!_sources.empty());
+    if (_getNextBatchSize > 1) {
+        if (_batchPosition == _batch.size()) {
+            _batch.clear();
+            _batchPosition = 0;
+
+            auto status = _sources.back()->getNextBatch(&_batch, _getNextBatchSize);
+            while (status == DocumentSource::GetNextResult::ReturnStatus::kPauseExecution) {
+                status = _sources.back()->getNextBatch(&_batch, _getNextBatchSize);
+            }
+            if (status == DocumentSource::GetNextResult::ReturnStatus::kEOF) {
+                return boost::none;
+            }
+        }
+        return std::move(_batch[_batchPosition++]);
+    }
+
     auto nextResult = _sources.back()->getNext();
     while (nextResult.isPaused()) {
         nextResult = _sources.back()->getNext();
@@ -335,6 +408,13 @@ void Pipeline::addInitialSource(intrusive_ptr<DocumentSource> source) {
     _sources.push_front(source);
 }
 
+void Pipeline::addFinalSource(intrusive_ptr<DocumentSource> source) {
+    if (!_sources.empty()) {
+        source->setSource(_sources.back().get());
+    }
+    _sources.push_back(source);
+}
+
 DepsTracker Pipeline::getDependencies(DepsTracker::MetadataAvailable metadataAvailable) const {
     DepsTracker deps(metadataAvailable);
     bool knowAllFields = false;
@@ -35,11 +35,17 @@
 
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
+
+// The number of results getNext() pulls at once from the last stage of a pipeline, through
+// DocumentSource::getNextBatch(). 1 or less pulls them one at a time with getNext().
+extern AtomicInt32 internalPipelineGetNextBatchSize;
 class BSONObj;
 class BSONObjBuilder;
 class CollatorInterface;
@@ -108,10 +114,13 @@ public:
 
       This permanently alters this pipeline for the merging operation.
 
+      If 'shardKeyPattern' is given, stages whose results do not depend on documents from other
+      shards, such as a $group on the shard key, run in full on the shards.
+
       @returns the Spec for the pipeline command that should be sent
         to the shards
     */
-    boost::intrusive_ptr<Pipeline> splitForSharded();
+    boost::intrusive_ptr<Pipeline> splitForSharded(const BSONObj& shardKeyPattern = BSONObj());
 
     /** If the pipeline starts with a $match, return its BSON predicate.
      *  Returns empty BSON if the first stage isn't $match.
@@ -142,11 +151,25 @@ public:
     /// The initial source is special since it varies between mongos and mongod.
     void addInitialSource(boost::intrusive_ptr<DocumentSource> source);
 
+    /**
+     * Appends 'source' to the end of the pipeline, after it has been optimized and prepared.
+     */
+    void addFinalSource(boost::intrusive_ptr<DocumentSource> source);
+
     /**
      * Returns the next result from the pipeline, or boost::none if there are no more results.
+     * Results may be pulled from the stages ahead of time, in batches of
+     * internalPipelineGetNextBatchSize as of when this pipeline was created.
      */
     boost::optional<Document> getNext();
 
+    /**
+     * Makes getNext() pull results from the stages one at a time. Used for pipelines whose
+     * consumer may stop early, such as $lookup sub-pipelines, where reading ahead would do work
+     * whose results are never used. Must be called before the first call to getNext().
+     */
+    void disableBatchedGetNext();
+
     /**
      * Write the pipeline's operators to a std::vector<Value>, with the
      * explain flag true (for DocumentSource::serializeToArray()).
@@ -204,5 +227,11 @@ private:
     SourceContainer _sources;
 
     boost::intrusive_ptr<ExpressionContext> pCtx;
+
+    size_t _getNextBatchSize;
+
+    // Results already pulled from the last stage but not yet returned by getNext().
+    std::vector<Document> _batch;
+    size_t _batchPosition = 0;
 };
 }  // namespace mongo
@@ -60,11 +60,13 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/record_store.h"
@@ -132,6 +134,10 @@ public:
             .appendLatencyStats(nss.ns(), includeHistograms, builder);
     }
 
+    std::vector<BSONObj> getQueryStats(const NamespaceString& nss) const final {
+        return QueryStatsStore::get(_ctx->opCtx->getServiceContext()).getStats(nss.ns());
+    }
+
     Status appendStorageStats(const NamespaceString& nss,
                               const BSONObj& param,
                               BSONObjBuilder* builder) const final {
@@ -144,6 +150,10 @@ public:
         return infos.empty() ? BSONObj() : infos.front().getObjectField("options").getOwned();
     }
 
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) final {
+        return _client.getIndexSpecs(nss.ns());
+    }
+
     Status renameIfOptionsAndIndexesHaveNotChanged(
         const BSONObj& renameCommandObj,
         const NamespaceString& targetNs,
@@ -193,6 +203,10 @@ public:
 
         pipeline.getValue()->optimizePipeline();
 
+        // $lookup and $graphLookup may stop pulling from the sub-pipeline before it is exhausted,
+        // so it must not read ahead.
+        pipeline.getValue()->disableBatchedGetNext();
+
         AutoGetCollectionForRead autoColl(expCtx->opCtx, expCtx->ns);
 
         // makePipeline() is only called to perform secondary aggregation requests and expects the
@@ -224,8 +238,8 @@ StatusWith<unique_ptr<PlanExecutor>> createRandomCursorExecutor(Collection* coll
                                                                 OperationContext* txn,
                                                                 long long sampleSize,
                                                                 long long numRecords) {
-    double kMaxSampleRatioForRandCursor = 0.05;
-    if (sampleSize > numRecords * kMaxSampleRatioForRandCursor || numRecords <= 100) {
+    const double maxSampleRatio = internalQueryMaxSampleRatioForRandomCursor.load();
+    if (sampleSize > numRecords * maxSampleRatio || numRecords <= 100) {
         return {nullptr};
     }
 
@@ -47,11 +47,25 @@ public:
      * Moves everything before a splittable stage to the shards. If there
      * are no splittable stages, moves everything to the shards.
      *
+     * A $group which only sees whole documents of the collection, and which groups by every field
+     * of a non-empty 'shardKeyPattern', is moved to the shards without being split: each of its
+     * groups is held by a single shard, so the results need no merging.
+     *
      * It is not safe to call this optimization multiple times.
      *
      * NOTE: looks for SplittableDocumentSources and uses that API
      */
-    static void findSplitPoint(Pipeline* shardPipe, Pipeline* mergePipe);
+    static void findSplitPoint(Pipeline* shardPipe,
+                               Pipeline* mergePipe,
+                               const BSONObj& shardKeyPattern);
+
+    /**
+     * Returns true if 'source' is a $group which findSplitPoint() can run in full on the shards
+     * of a collection sharded by 'shardKeyPattern', given the stages already in 'shardPipe'.
+     */
+    static bool isShardLocalGroup(const DocumentSource* source,
+                                  const Pipeline* shardPipe,
+                                  const BSONObj& shardKeyPattern);
 
     /**
      * If the final stage on shards is to unwind an array, move that stage to the merger. This
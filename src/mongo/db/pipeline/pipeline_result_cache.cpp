@@ -0,0 +1,299 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/pipeline_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/collation/collation_spec.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+namespace {
+
+const auto getPipelineResultCache = ServiceContext::declareDecoration<PipelineResultCache>();
+
+// Stages whose output depends on something other than the contents of the collection.
+const StringData kUncacheableStages[] = {
+    "$collStats"_sd, "$indexStats"_sd, "$out"_sd, "$queryStats"_sd, "$sample"_sd,
+};
+
+size_t resultsSizeBytes(const PipelineResultCache::Results& results) {
+    size_t size = sizeof(results);
+    for (auto&& obj : results) {
+        size += sizeof(obj) + obj.objsize();
+    }
+    return size;
+}
+
+/**
+ * Produces the results cached for a pipeline in its place.
+ */
+class DocumentSourceCachedResults final : public DocumentSource {
+public:
+    DocumentSourceCachedResults(std::shared_ptr<const PipelineResultCache::Results> results,
+                                const intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSource(expCtx), _results(std::move(results)) {}
+
+    GetNextResult getNext() final {
+        pExpCtx->checkForInterrupt();
+
+        if (_position == _results->size()) {
+            return GetNextResult::makeEOF();
+        }
+        return Document::fromBsonWithMetaData((*_results)[_position++]);
+    }
+
+    const char* getSourceName() const final {
+        return "$cachedResults";
+    }
+
+    Value serialize(bool explain = false) const final {
+        return Value(DOC(getSourceName() << Document()));
+    }
+
+    bool isValidInitialSource() const final {
+        return true;
+    }
+
+private:
+    const std::shared_ptr<const PipelineResultCache::Results> _results;
+    size_t _position = 0;
+};
+
+/**
+ * Passes on the results of the stages before it, and caches them once they are exhausted.
+ */
+class DocumentSourceRecordResults final : public DocumentSource {
+public:
+    DocumentSourceRecordResults(PipelineResultCache* cache,
+                                PipelineResultCache::Key key,
+                                size_t budgetBytes,
+                                const intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSource(expCtx),
+          _cache(cache),
+          _key(std::move(key)),
+          _budgetBytes(budgetBytes),
+          _results(std::make_shared<PipelineResultCache::Results>()) {}
+
+    GetNextResult getNext() final {
+        auto next = pSource->getNext();
+        if (next.isAdvanced()) {
+            _record(next.getDocument());
+        } else if (next.isEOF() && _results) {
+            // The results are only those of the key's write generation if no write has been made
+            // since the pipeline's snapshot was opened.
+            if (_key.writeGeneration->load() == _key.writeGenerationValue) {
+                _cache->insert(std::move(_key.str), std::move(_results), _budgetBytes);
+            }
+            _results.reset();
+        }
+        return next;
+    }
+
+    const char* getSourceName() const final {
+        return "$recordResults";
+    }
+
+    // This stage is an implementation detail of the cache, so it is not explained.
+    Value serialize(bool explain = false) const final {
+        return Value();
+    }
+
+    void dispose() final {
+        _results.reset();
+        pSource->dispose();
+    }
+
+private:
+    void _record(const Document& doc) {
+        if (!_results) {
+            return;
+        }
+
+        auto obj = doc.toBsonWithMetaData();
+        _sizeBytes += sizeof(obj) + obj.objsize();
+        if (_sizeBytes > _budgetBytes / 4) {
+            _results.reset();
+            return;
+        }
+        _results->push_back(std::move(obj));
+    }
+
+    PipelineResultCache* const _cache;
+    PipelineResultCache::Key _key;
+    const size_t _budgetBytes;
+
+    // Reset once the results turn out to be too large to keep.
+    std::shared_ptr<PipelineResultCache::Results> _results;
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace
+
+PipelineResultCache& PipelineResultCache::get(ServiceContext* serviceContext) {
+    return getPipelineResultCache(serviceContext);
+}
+
+boost::optional<PipelineResultCache::Key> PipelineResultCache::makeKey(
+    OperationContext* txn, const Collection* collection, const Pipeline& pipeline) {
+    if (internalQueryPipelineResultCacheSizeBytes <= 0) {
+        return boost::none;
+    }
+
+    const auto& expCtx = pipeline.getContext();
+    if (expCtx->isExplain || expCtx->inShard || expCtx->inRouter) {
+        return boost::none;
+    }
+
+    // Other collections may change without changing the write generation of this one.
+    if (!pipeline.getInvolvedCollections().empty()) {
+        return boost::none;
+    }
+
+    // A majority committed snapshot may be older than the current write generation.
+    if (txn->recoveryUnit()->isReadingFromMajorityCommittedSnapshot()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    {
+        BSONArrayBuilder stagesBuilder(keyBuilder.subarrayStart("pipeline"));
+        for (auto&& stage : pipeline.serialize()) {
+            auto stageObj = stage.getDocument().toBson();
+            for (auto&& uncacheableStage : kUncacheableStages) {
+                if (uncacheableStage == stageObj.firstElementFieldName()) {
+                    return boost::none;
+                }
+            }
+            stagesBuilder.append(stageObj);
+        }
+    }
+    keyBuilder.append("collation",
+                      expCtx->getCollator() ? expCtx->getCollator()->getSpec().toBSON()
+                                            : CollationSpec::kSimpleSpec);
+
+    // Load the write generation before the pipeline opens its snapshot, so that it reads at least
+    // the data this value stands for.
+    Key key;
+    key.writeGeneration = collection->getWriteGeneration();
+    key.writeGenerationValue = key.writeGeneration->load();
+    txn->recoveryUnit()->abandonSnapshot();
+
+    keyBuilder.append("ns", collection->ns().ns());
+    keyBuilder.append("incarnation", static_cast<long long>(collection->getIncarnation()));
+    keyBuilder.append("writeGeneration", static_cast<long long>(key.writeGenerationValue));
+    auto keyObj = keyBuilder.done();
+    key.str.assign(keyObj.objdata(), keyObj.objsize());
+    return key;
+}
+
+intrusive_ptr<Pipeline> PipelineResultCache::makeCachedPipeline(
+    const Key& key, const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto results = lookup(key.str);
+    if (!results) {
+        return nullptr;
+    }
+    return uassertStatusOK(
+        Pipeline::create({new DocumentSourceCachedResults(std::move(results), expCtx)}, expCtx));
+}
+
+void PipelineResultCache::addResultRecorder(Pipeline* pipeline, Key key) {
+    auto budgetBytes = internalQueryPipelineResultCacheSizeBytes;
+    if (budgetBytes <= 0) {
+        return;
+    }
+    pipeline->addFinalSource(new DocumentSourceRecordResults(
+        this, std::move(key), static_cast<size_t>(budgetBytes), pipeline->getContext()));
+}
+
+void PipelineResultCache::insert(std::string key,
+                                 std::shared_ptr<const Results> results,
+                                 size_t budgetBytes) {
+    const size_t sizeBytes = key.size() + resultsSizeBytes(*results);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto existing = _index.find(key);
+    if (existing != _index.end()) {
+        _sizeBytes -= existing->second->sizeBytes;
+        _entries.erase(existing->second);
+        _index.erase(existing);
+    }
+
+    _entries.push_front({key, std::move(results), sizeBytes});
+    _index.emplace(std::move(key), _entries.begin());
+    _sizeBytes += sizeBytes;
+    _evictUntilWithin_inlock(budgetBytes);
+}
+
+std::shared_ptr<const PipelineResultCache::Results> PipelineResultCache::lookup(
+    const std::string& key) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        return nullptr;
+    }
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return it->second->results;
+}
+
+void PipelineResultCache::clear() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries.clear();
+    _index.clear();
+    _sizeBytes = 0;
+}
+
+size_t PipelineResultCache::sizeBytes() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _sizeBytes;
+}
+
+void PipelineResultCache::_evictUntilWithin_inlock(size_t budgetBytes) {
+    while (_sizeBytes > budgetBytes && !_entries.empty()) {
+        auto& entry = _entries.back();
+        _sizeBytes -= entry.sizeBytes;
+        _index.erase(entry.key);
+        _entries.pop_back();
+    }
+}
+
+}  // namespace mongo
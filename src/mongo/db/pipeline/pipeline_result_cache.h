@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class Collection;
+class ExpressionContext;
+class OperationContext;
+class Pipeline;
+class ServiceContext;
+
+/**
+ * Keeps the complete results of recent aggregations, so that an identical aggregation on the same
+ * collection can return them without running its pipeline again, as long as the collection has
+ * not been written to in between.
+ *
+ * Entries are keyed by the collection's namespace, incarnation and write generation, the
+ * collation, and the serialized optimized pipeline. A write changes the write generation, so the
+ * entries for earlier versions of a collection are never found again, and are evicted as the
+ * least recently used ones once the cache exceeds internalQueryPipelineResultCacheSizeBytes.
+ */
+class PipelineResultCache {
+    MONGO_DISALLOW_COPYING(PipelineResultCache);
+
+public:
+    using Results = std::vector<BSONObj>;
+
+    struct Key {
+        std::string str;
+
+        // The write generation of the collection when the key was made. Results are only cached if
+        // it has not changed by the time the pipeline is exhausted.
+        std::shared_ptr<const AtomicUInt64> writeGeneration;
+        uint64_t writeGenerationValue;
+    };
+
+    PipelineResultCache() = default;
+
+    static PipelineResultCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the key under which the results of the optimized 'pipeline', run on 'collection' by
+     * 'txn', are cached. Returns boost::none if they may not be cached: because the cache is
+     * disabled, the results depend on something other than the collection's contents, or the
+     * pipeline is part of a sharded or explained aggregation.
+     *
+     * Must be called before the pipeline is prepared for execution, with 'collection' locked.
+     * Abandons the storage snapshot of 'txn', so that the pipeline reads from one opened after the
+     * write generation was loaded.
+     */
+    static boost::optional<Key> makeKey(OperationContext* txn,
+                                        const Collection* collection,
+                                        const Pipeline& pipeline);
+
+    /**
+     * Returns a pipeline which replays the results cached for 'key', or nullptr if there are none.
+     */
+    boost::intrusive_ptr<Pipeline> makeCachedPipeline(
+        const Key& key, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    /**
+     * Appends a stage to the prepared 'pipeline' which gathers its results, and caches them under
+     * 'key' once the pipeline is exhausted. Results which would take more than a quarter of the
+     * cache are not kept.
+     */
+    void addResultRecorder(Pipeline* pipeline, Key key);
+
+    /**
+     * Caches 'results' under 'key', and evicts the least recently used entries until the cache
+     * fits within 'budgetBytes'.
+     */
+    void insert(std::string key, std::shared_ptr<const Results> results, size_t budgetBytes);
+
+    /**
+     * Returns the results cached under 'key' and marks them as most recently used, or nullptr.
+     */
+    std::shared_ptr<const Results> lookup(const std::string& key);
+
+    void clear();
+
+    size_t sizeBytes() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const Results> results;
+        size_t sizeBytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    void _evictUntilWithin_inlock(size_t budgetBytes);
+
+    mutable stdx::mutex _mutex;
+
+    // Ordered from most to least recently used.
+    EntryList _entries;
+    stdx::unordered_map<std::string, EntryList::iterator> _index;
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace mongo
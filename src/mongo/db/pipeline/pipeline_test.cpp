@@ -934,6 +934,11 @@ public:
     virtual string shardPipeJson() = 0;
     virtual string mergePipeJson() = 0;
 
+    // The shard key of the collection the pipeline runs against, if any.
+    virtual BSONObj shardKeyPattern() {
+        return BSONObj();
+    }
+
     BSONObj pipelineFromJsonArray(const string& array) {
         return fromjson("{pipeline: " + array + "}");
     }
@@ -960,7 +965,7 @@ public:
         mergePipe = uassertStatusOK(Pipeline::parse(request.getPipeline(), ctx));
         mergePipe->optimizePipeline();
 
-        shardPipe = mergePipe->splitForSharded();
+        shardPipe = mergePipe->splitForSharded(shardKeyPattern());
         ASSERT(shardPipe != nullptr);
 
         ASSERT_VALUE_EQ(Value(shardPipe->writeExplainOps()), Value(shardPipeExpected["pipeline"]));
@@ -1276,6 +1281,70 @@ class LookUp : public needsPrimaryShardMergerBase {
 };
 
 }  // namespace needsPrimaryShardMerger
+
+namespace groupOnShardKey {
+
+class GroupOnShardKeyRunsOnShards : public Base {
+    BSONObj shardKeyPattern() {
+        return BSON("sk" << 1);
+    }
+    string inputPipeJson() {
+        return "[{$match: {x: 1}}, {$group: {_id: '$sk', count: {$sum: 1}}}]";
+    }
+    string shardPipeJson() {
+        return "[{$match: {x: 1}}, {$group: {_id: '$sk', count: {$sum: {$const: 1}}}}]";
+    }
+    string mergePipeJson() {
+        return "[]";
+    }
+};
+
+class GroupOnCompoundShardKeyThenSort : public Base {
+    BSONObj shardKeyPattern() {
+        return BSON("a" << 1 << "b" << 1);
+    }
+    string inputPipeJson() {
+        return "[{$group: {_id: {x: '$a', y: '$b', z: '$c'}}}, {$sort: {'_id.z': 1}}]";
+    }
+    string shardPipeJson() {
+        return "[{$group: {_id: {x: '$a', y: '$b', z: '$c'}}}, {$sort: {sortKey: {'_id.z': 1}}}]";
+    }
+    string mergePipeJson() {
+        return "[{$sort: {sortKey: {'_id.z': 1}, mergePresorted: true}}]";
+    }
+};
+
+class GroupOnPartOfShardKeyIsSplit : public Base {
+    BSONObj shardKeyPattern() {
+        return BSON("a" << 1 << "b" << 1);
+    }
+    string inputPipeJson() {
+        return "[{$group: {_id: '$a'}}]";
+    }
+    string shardPipeJson() {
+        return "[{$group: {_id: '$a'}}]";
+    }
+    string mergePipeJson() {
+        return "[{$group: {_id: '$$ROOT._id', $doingMerge: true}}]";
+    }
+};
+
+class GroupOnShardKeyAfterUnwindIsSplit : public Base {
+    BSONObj shardKeyPattern() {
+        return BSON("sk" << 1);
+    }
+    string inputPipeJson() {
+        return "[{$unwind: '$arr'}, {$group: {_id: '$sk'}}]";
+    }
+    string shardPipeJson() {
+        return "[{$unwind: {path: '$arr'}}, {$group: {_id: '$sk'}}]";
+    }
+    string mergePipeJson() {
+        return "[{$group: {_id: '$$ROOT._id', $doingMerge: true}}]";
+    }
+};
+
+}  // namespace groupOnShardKey
 }  // namespace Sharded
 }  // namespace Optimizations
 
@@ -1301,6 +1370,18 @@ TEST(PipelineInitialSource, MatchInitialQuery) {
     ASSERT_BSONOBJ_EQ(pipe->getInitialQuery(), BSON("a" << 4));
 }
 
+TEST(PipelineGetNext, DisablingBatchedGetNextPullsOneResultAtATime) {
+    intrusive_ptr<ExpressionContextForTest> ctx = new ExpressionContextForTest();
+    auto mock = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
+    auto pipe = uassertStatusOK(Pipeline::create({mock}, ctx));
+    pipe->disableBatchedGetNext();
+
+    auto next = pipe->getNext();
+    ASSERT(next);
+    ASSERT_DOCUMENT_EQ(*next, (Document{{"a", 1}}));
+    ASSERT_EQ(mock->queue.size(), 2UL);
+}
+
 namespace Dependencies {
 
 using PipelineDependenciesTest = AggregationContextFixture;
@@ -1576,6 +1657,10 @@ public:
         add<Optimizations::Sharded::needsPrimaryShardMerger::Out>();
         add<Optimizations::Sharded::needsPrimaryShardMerger::Project>();
         add<Optimizations::Sharded::needsPrimaryShardMerger::LookUp>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupOnShardKeyRunsOnShards>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupOnCompoundShardKeyThenSort>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupOnPartOfShardKeyIsSplit>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupOnShardKeyAfterUnwindIsSplit>();
     }
 };
 
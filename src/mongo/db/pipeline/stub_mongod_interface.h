@@ -69,6 +69,10 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getQueryStats(const NamespaceString& nss) const override {
+        MONGO_UNREACHABLE;
+    }
+
     Status appendStorageStats(const NamespaceString& nss,
                               const BSONObj& param,
                               BSONObjBuilder* builder) const override {
@@ -79,6 +83,10 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) override {
+        MONGO_UNREACHABLE;
+    }
+
     Status renameIfOptionsAndIndexesHaveNotChanged(
         const BSONObj& renameCommandObj,
         const NamespaceString& targetNs,
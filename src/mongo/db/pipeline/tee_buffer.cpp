@@ -49,6 +49,15 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_concurrentConsumers) {
+        auto& consumer = _consumers[consumerId];
+        if (consumer.nLeftToReturn == 0) {
+            return _buffer.empty() ? DocumentSource::GetNextResult::makeEOF()
+                                   : DocumentSource::GetNextResult::makePauseExecution();
+        }
+        return _buffer[_buffer.size() - consumer.nLeftToReturn--];
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -75,6 +84,24 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+bool TeeBuffer::loadNextBatchForConcurrentConsumers() {
+    _concurrentConsumers = true;
+
+    if (noConsumersStillInUse()) {
+        _buffer.clear();
+        _source->dispose();
+        return false;
+    }
+
+    loadNextBatch();
+
+    // Looking up a field of a lazily converted document modifies it, so convert them all now.
+    for (auto&& result : _buffer) {
+        result.getDocument().loadAllLazyFields();
+    }
+    return !_buffer.empty();
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
@@ -65,14 +65,25 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
-        if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-                return info.stillInUse;
-            })) {
+
+        // Concurrent consumers may only touch their own state. The source is disposed of by the
+        // next loadNextBatchForConcurrentConsumers() instead.
+        if (!_concurrentConsumers && noConsumersStillInUse()) {
             _buffer.clear();
             _source->dispose();
         }
     }
 
+    /**
+     * Switches this buffer to consumers which each run on their own thread. Loads the next batch
+     * for them, and returns false if there was nothing left to load.
+     *
+     * Afterwards getNext() hands out the current batch without ever loading the next one, and
+     * reads and writes only the state of the given consumer. So consumers may then call getNext()
+     * and dispose() concurrently, until each has been paused; the caller then calls this again.
+     */
+    bool loadNextBatchForConcurrentConsumers();
+
     /**
      * Retrieves the next document meant to be consumed by the pipeline given by 'consumerId'.
      * Returns GetNextState::ResultState::kPauseExecution if this pipeline has consumed the whole
@@ -90,6 +101,12 @@ private:
      */
     void loadNextBatch();
 
+    bool noConsumersStillInUse() const {
+        return std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        });
+    }
+
     boost::intrusive_ptr<DocumentSource> _source;
 
     const size_t _bufferSizeBytes;
@@ -100,5 +117,8 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // Set by loadNextBatchForConcurrentConsumers().
+    bool _concurrentConsumers = false;
 };
 }  // namespace mongo
@@ -850,11 +850,13 @@ void Value::hash_combine(size_t& seed,
             break;
 
         case mongo::NumberDecimal: {
+            // Converting the double to a decimal is costly, so only do it once.
+            static const Decimal128 kMaxDoubleAsDecimal(std::numeric_limits<double>::max(),
+                                                        Decimal128::kRoundTo34Digits,
+                                                        Decimal128::kRoundTowardZero);
             const Decimal128 dcml = getDecimal();
-            if (dcml.toAbs().isGreater(Decimal128(std::numeric_limits<double>::max(),
-                                                  Decimal128::kRoundTo34Digits,
-                                                  Decimal128::kRoundTowardZero)) &&
-                !dcml.isInfinite() && !dcml.isNaN()) {
+            if (dcml.toAbs().isGreater(kMaxDoubleAsDecimal) && !dcml.isInfinite() &&
+                !dcml.isNaN()) {
                 // Normalize our decimal to force equivalent decimals
                 // in the same cohort to hash to the same value
                 Decimal128 dcmlNorm(dcml.normalize());
@@ -42,6 +42,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/mmap_v1/mmap.h"
 #include "mongo/util/log.h"
@@ -166,10 +167,13 @@ void prefetchPagesForReplicatedOp(OperationContext* txn, Database* db, const BSO
     BSONObj obj = op.getObjectField(opField);
     const char* ns = op.getStringField("ns");
 
-    // This will have to change for engines other than MMAP V1, because they might not have
-    // means for directly prefetching pages from the collection. For this purpose, acquire S
-    // lock on the database, instead of optimizing with IS.
-    Lock::CollectionLock collLock(txn->lockState(), ns, MODE_S);
+    // MMAP V1 only has collection level locking, so acquire an S lock on the collection to keep
+    // it from changing while its pages are faulted in. Engines with document level locking read
+    // from a consistent snapshot, so IS is sufficient and lets prefetching run alongside other
+    // readers of the collection.
+    const bool supportsDocLocking =
+        txn->getServiceContext()->getGlobalStorageEngine()->supportsDocLocking();
+    Lock::CollectionLock collLock(txn->lockState(), ns, supportsDocLocking ? MODE_IS : MODE_S);
 
     Collection* collection = db->getCollection(ns);
     if (!collection) {
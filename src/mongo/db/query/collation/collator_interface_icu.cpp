@@ -31,7 +31,6 @@
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
@@ -49,6 +48,12 @@ std::unique_ptr<CollatorInterface> CollatorInterfaceICU::clone() const {
 }
 
 int CollatorInterfaceICU::compare(StringData left, StringData right) const {
+    // Byte-wise identical strings are equal under every collation, so equality checks such as
+    // those made by $in and by hashing do not need to call into ICU when the values match.
+    if (left == right) {
+        return 0;
+    }
+
     UErrorCode status = U_ZERO_ERROR;
     auto compareResult = _collator->compareUTF8(icu::StringPiece(left.rawData(), left.size()),
                                                 icu::StringPiece(right.rawData(), right.size()),
@@ -76,19 +81,26 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const icu::UnicodeString unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Most sort keys are short, so we first try to produce the key into a buffer on the stack. This
+    // avoids the heap allocations made by an icu::CollationKey. Only keys which do not fit are
+    // generated a second time, directly into a buffer of the required size.
+    uint8_t stackBuffer[256];
+    int32_t keyLength = _collator->getSortKey(unicodeString, stackBuffer, sizeof(stackBuffer));
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
+
+    const uint8_t* keyBuffer = stackBuffer;
+    std::unique_ptr<uint8_t[]> heapBuffer;
+    if (static_cast<size_t>(keyLength) > sizeof(stackBuffer)) {
+        heapBuffer.reset(new uint8_t[keyLength]);
+        invariant(_collator->getSortKey(unicodeString, heapBuffer.get(), keyLength) == keyLength);
+        keyBuffer = heapBuffer.get();
+    }
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
@@ -128,6 +128,13 @@ TEST(CollatorInterfaceICUTest, ASCIIComparisonWorksForUSEnglishCollation) {
     ASSERT_EQ(icuCollator.compare("ab", "ab"), 0);
 }
 
+TEST(CollatorInterfaceICUTest, IdenticalStringsInSeparateBuffersCompareEqual) {
+    const std::string left("caf\xC3\xA9\0\xEF", 7);
+    const std::string right(left);
+    ASSERT_NE(static_cast<const void*>(left.data()), static_cast<const void*>(right.data()));
+    assertEqualEnUS(left, right);
+}
+
 TEST(CollatorInterfaceICUTest, ASCIIComparisonWorksUsingLocaleStringParsing) {
     CollationSpec collationSpec;
     collationSpec.localeID = "en_US";
@@ -291,6 +291,8 @@ void Explain::statsToBSON(const PlanStageStats& stats,
 
             bob->appendNumber("flaggedButPassed", spec->flaggedButPassed);
             bob->appendNumber("flaggedInProgress", spec->flaggedInProgress);
+            bob->appendNumber("bloomFilterRejects", spec->bloomFilterRejects);
+            bob->appendNumber("bloomFilterBytes", spec->bloomFilterBytes);
             for (size_t i = 0; i < spec->mapAfterChild.size(); ++i) {
                 bob->appendNumber(string(stream() << "mapAfterChild_" << i),
                                   spec->mapAfterChild[i]);
@@ -305,6 +307,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
                 bob->appendNumber(string(stream() << "failedAnd_" << i), spec->failedAnd[i]);
             }
         }
+    } else if (STAGE_CACHED_PLAN == stats.stageType) {
+        CachedPlanStats* spec = static_cast<CachedPlanStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainCommon::EXEC_STATS) {
+            bob->appendBool("evictedAfterTrial", spec->evictedAfterTrial);
+        }
     } else if (STAGE_COLLSCAN == stats.stageType) {
         CollectionScanStats* spec = static_cast<CollectionScanStats*>(stats.specific.get());
         bob->append("direction", spec->direction > 0 ? "forward" : "backward");
@@ -484,6 +492,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainCommon::EXEC_STATS) {
             bob->appendNumber("memUsage", spec->memUsage);
             bob->appendNumber("memLimit", spec->memLimit);
+            if (spec->usedDisk) {
+                bob->appendBool("usedDisk", true);
+            }
         }
 
         if (spec->limit > 0) {
@@ -36,7 +36,9 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
+#include "mongo/db/query/lru_key_value.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/mutex.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -45,6 +47,47 @@ namespace mongo {
 
 using std::set;
 
+namespace {
+
+/**
+ * Caches the S2 coverings of geo predicates, keyed by the predicate's BSON and the covering
+ * parameters. Working out a covering is expensive for polygons with many vertices, and workloads
+ * such as geofencing run the same few predicates over and over.
+ */
+class S2CoveringCache {
+public:
+    // Larger entries are not cached, so that the cache takes at most this many bytes per entry.
+    // Regions this large are rare, and their predicates are unlikely to repeat.
+    static const size_t kMaxEntryBytes = 16 * 1024;
+
+    explicit S2CoveringCache(size_t maxSize) : _cache(maxSize) {}
+
+    static bool isCachable(const std::string& key, const std::vector<S2CellId>& cover) {
+        return key.size() + cover.size() * sizeof(S2CellId) <= kMaxEntryBytes;
+    }
+
+    bool get(const std::string& key, std::vector<S2CellId>* coverOut) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        std::vector<S2CellId>* cached;
+        if (!_cache.get(key, &cached).isOK()) {
+            return false;
+        }
+        *coverOut = *cached;
+        return true;
+    }
+
+    void add(const std::string& key, const std::vector<S2CellId>& cover) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _cache.add(key, new std::vector<S2CellId>(cover));
+    }
+
+private:
+    stdx::mutex _mutex;
+    LRUKeyValue<std::string, std::vector<S2CellId>> _cache;
+};
+
+}  // namespace
+
 BSONObj ExpressionMapping::hash(const BSONElement& value) {
     BSONObjBuilder bob;
     bob.append("", BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
@@ -126,6 +169,39 @@ std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& reg
     return cover;
 }
 
+std::vector<S2CellId> ExpressionMapping::get2dsphereCovering(const S2Region& region,
+                                                             const BSONObj& regionObj) {
+    if (internalQueryS2GeoCoveringCacheSize <= 0) {
+        return get2dsphereCovering(region);
+    }
+
+    static S2CoveringCache* const coveringCache =
+        new S2CoveringCache(internalQueryS2GeoCoveringCacheSize);
+
+    // The covering also depends on the covering parameters, which may change at runtime.
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("minLevel", internalQueryS2GeoCoarsestLevel.load());
+    keyBuilder.append("maxLevel", internalQueryS2GeoFinestLevel.load());
+    keyBuilder.append("maxCells", internalQueryS2GeoMaxCells.load());
+    keyBuilder.append("region", regionObj);
+    const BSONObj keyObj = keyBuilder.done();
+    if (static_cast<size_t>(keyObj.objsize()) > S2CoveringCache::kMaxEntryBytes) {
+        return get2dsphereCovering(region);
+    }
+    const std::string key(keyObj.objdata(), keyObj.objsize());
+
+    std::vector<S2CellId> cover;
+    if (coveringCache->get(key, &cover)) {
+        return cover;
+    }
+
+    cover = get2dsphereCovering(region);
+    if (S2CoveringCache::isCachable(key, cover)) {
+        coveringCache->add(key, cover);
+    }
+    return cover;
+}
+
 void ExpressionMapping::cover2dsphere(const S2Region& region,
                                       const S2IndexingParams& indexingParams,
                                       OrderedIntervalList* oilOut) {
@@ -133,6 +209,14 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+void ExpressionMapping::cover2dsphere(const S2Region& region,
+                                      const BSONObj& regionObj,
+                                      const S2IndexingParams& indexingParams,
+                                      OrderedIntervalList* oilOut) {
+    std::vector<S2CellId> cover = get2dsphereCovering(region, regionObj);
+    S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -64,6 +64,14 @@ public:
 
     static std::vector<S2CellId> get2dsphereCovering(const S2Region& region);
 
+    /**
+     * Like get2dsphereCovering(region), but looks the covering up in a process-wide LRU cache
+     * first. 'regionObj' must be a BSON description that uniquely determines 'region', such as
+     * the raw object of the geo predicate the region was parsed from.
+     */
+    static std::vector<S2CellId> get2dsphereCovering(const S2Region& region,
+                                                     const BSONObj& regionObj);
+
     static void S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
                                      const S2IndexVersion indexVersion,
                                      OrderedIntervalList* oilOut);
@@ -77,6 +85,12 @@ public:
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    // Same as above, with the covering of 'region' cached by 'regionObj'.
+    static void cover2dsphere(const S2Region& region,
+                              const BSONObj& regionObj,
+                              const S2IndexingParams& indexParams,
+                              OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
@@ -59,4 +59,9 @@ extern AtomicInt32 internalQueryS2GeoCoarsestLevel;
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern AtomicInt32 internalQueryS2GeoMaxCells;
 
+// How many 2dsphere predicate coverings do we cache for later queries? 0 disables the cache.
+// Predicates whose BSON and covering take more than 16KB are not cached, so the cache holds at
+// most 16KB per entry.
+extern int internalQueryS2GeoCoveringCacheSize;
+
 }  // namespace mongo
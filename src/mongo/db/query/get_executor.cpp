@@ -39,6 +39,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
@@ -224,6 +225,65 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Returns a copy of 'obj' with every literal value replaced by "?", so that the shape of a query
+ * reveals none of the values it was run with. Arrays of literals, such as the operand of $in,
+ * collapse to a single "?" however long they are.
+ */
+BSONObj shapeWithoutLiterals(const BSONObj& obj) {
+    BSONObjBuilder builder;
+    for (auto&& elem : obj) {
+        if (elem.type() == BSONType::Object) {
+            builder.append(elem.fieldNameStringData(), shapeWithoutLiterals(elem.Obj()));
+        } else if (elem.type() == BSONType::Array) {
+            BSONArrayBuilder arrayBuilder(builder.subarrayStart(elem.fieldNameStringData()));
+            bool appendedLiteral = false;
+            for (auto&& arrayElem : elem.Obj()) {
+                if (arrayElem.type() == BSONType::Object) {
+                    arrayBuilder.append(shapeWithoutLiterals(arrayElem.Obj()));
+                } else if (!appendedLiteral) {
+                    arrayBuilder.append("?");
+                    appendedLiteral = true;
+                }
+            }
+        } else {
+            builder.append(elem.fieldNameStringData(), "?");
+        }
+    }
+    return builder.obj();
+}
+
+/**
+ * Notes the shape of 'canonicalQuery' on the current operation, so that the operation's execution
+ * statistics are aggregated under it in the QueryStatsStore once it completes. Only the first query
+ * an operation plans is noted.
+ */
+void noteQueryShape(OperationContext* opCtx,
+                    const Collection* collection,
+                    const CanonicalQuery& canonicalQuery) {
+    if (internalQueryStatsStoreSizeBytes.load() <= 0) {
+        return;
+    }
+
+    auto& debug = CurOp::get(opCtx)->debug();
+    if (!debug.queryShapeKey.empty()) {
+        return;
+    }
+
+    const auto& qr = canonicalQuery.getQueryRequest();
+    BSONObjBuilder shapeBuilder;
+    shapeBuilder.append("query", shapeWithoutLiterals(qr.getFilter()));
+    shapeBuilder.append("sort", qr.getSort());
+    shapeBuilder.append("projection", qr.getProj());
+    if (!qr.getCollation().isEmpty()) {
+        shapeBuilder.append("collation", qr.getCollation());
+    }
+
+    debug.queryShapeKey = collection->infoCache()->getPlanCache()->computeKey(canonicalQuery);
+    debug.queryShapeNs = canonicalQuery.ns();
+    debug.queryShape = shapeBuilder.obj();
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -268,6 +328,8 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         canonicalQuery->setCollator(collection->getDefaultCollator()->clone());
     }
 
+    noteQueryShape(opCtx, collection, *canonicalQuery);
+
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
 
     // If we have an _id index we can use an idhack plan.
@@ -30,6 +30,7 @@
 
 #include "mongo/db/query/index_bounds_builder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -579,7 +580,7 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphere(region, gme->getRawObj(), indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -673,46 +674,50 @@ void IndexBoundsBuilder::unionize(OrderedIntervalList* oilOut) {
         return;
     }
 
-    // Step 1: sort.
-    std::sort(iv.begin(), iv.end(), IntervalComparison);
+    // Step 1: sort. Intervals built from the equalities of a $in usually arrive in order
+    // already, in which case there is nothing to do.
+    if (!std::is_sorted(iv.begin(), iv.end(), IntervalComparison)) {
+        std::sort(iv.begin(), iv.end(), IntervalComparison);
+    }
 
-    // Step 2: Walk through and merge.
-    size_t i = 0;
-    while (i < iv.size() - 1) {
-        // Compare i with i + 1.
-        Interval::IntervalComparison cmp = iv[i].compare(iv[i + 1]);
+    // Step 2: Walk through and merge. The merged intervals are compacted towards the front of
+    // 'iv', with iv[last] being the interval currently being merged into, so that long lists
+    // are merged in linear time.
+    size_t last = 0;
+    for (size_t next = 1; next < iv.size(); ++next) {
+        // Compare last with next.
+        Interval::IntervalComparison cmp = iv[last].compare(iv[next]);
 
         // This means our sort didn't work.
         verify(Interval::INTERVAL_SUCCEEDS != cmp);
 
         // Intervals are correctly ordered.
         if (Interval::INTERVAL_PRECEDES == cmp) {
-            // We can move to the next pair.
-            ++i;
+            // Keep 'last' and start merging into 'next'.
+            ++last;
+            if (last != next) {
+                iv[last] = iv[next];
+            }
         } else if (Interval::INTERVAL_EQUALS == cmp || Interval::INTERVAL_WITHIN == cmp) {
-            // Interval 'i' is equal to i+1, or is contained within i+1.
-            // Remove interval i and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i);
+            // Interval 'last' is equal to 'next', or is contained within 'next'. Replace it.
+            iv[last] = iv[next];
         } else if (Interval::INTERVAL_CONTAINS == cmp) {
-            // Interval 'i' contains i+1, remove i+1 and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i + 1);
+            // Interval 'last' contains 'next', so drop 'next'.
         } else if (Interval::INTERVAL_OVERLAPS_BEFORE == cmp ||
                    Interval::INTERVAL_PRECEDES_COULD_UNION == cmp) {
-            // We want to merge intervals i and i+1.
-            // Interval 'i' starts before interval 'i+1'.
+            // We want to merge intervals 'last' and 'next'.
+            // Interval 'last' starts before interval 'next'.
             BSONObjBuilder bob;
-            bob.appendAs(iv[i].start, "");
-            bob.appendAs(iv[i + 1].end, "");
+            bob.appendAs(iv[last].start, "");
+            bob.appendAs(iv[next].end, "");
             BSONObj data = bob.obj();
-            bool startInclusive = iv[i].startInclusive;
-            bool endInclusive = iv[i + 1].endInclusive;
-            iv.erase(iv.begin() + i);
-            // iv[i] is now the former iv[i + 1]
-            iv[i] = makeRangeInterval(
+            bool startInclusive = iv[last].startInclusive;
+            bool endInclusive = iv[next].endInclusive;
+            iv[last] = makeRangeInterval(
                 data, IndexBounds::makeBoundInclusionFromBoundBools(startInclusive, endInclusive));
-            // Don't increment 'i'.
         }
     }
+    iv.erase(iv.begin() + last + 1, iv.end());
 }
 
 // static
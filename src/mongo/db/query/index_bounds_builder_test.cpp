@@ -777,6 +777,37 @@ TEST(IndexBoundsBuilderTest, UnionGtLt) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
 }
 
+TEST(IndexBoundsBuilderTest, UnionizeManyIntervals) {
+    OrderedIntervalList oil("a");
+    for (int i = 99; i >= 0; --i) {
+        oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(BSON("" << i)));
+        oil.intervals.push_back(IndexBoundsBuilder::makePointInterval(BSON("" << i)));
+    }
+    oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 10 << "" << 20), BoundInclusion::kIncludeBothStartAndEndKeys));
+    oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 50 << "" << 60), BoundInclusion::kIncludeStartKeyOnly));
+    oil.intervals.push_back(IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 59 << "" << 70), BoundInclusion::kIncludeEndKeyOnly));
+
+    IndexBoundsBuilder::unionize(&oil);
+
+    // Points 0-9, [10, 20], points 21-49, [50, 70] and points 71-99.
+    ASSERT_EQUALS(oil.intervals.size(), 70U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(fromjson("{'': 0, '': 0}"), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[9].compare(Interval(fromjson("{'': 9, '': 9}"), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[10].compare(Interval(fromjson("{'': 10, '': 20}"), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[11].compare(Interval(fromjson("{'': 21, '': 21}"), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[40].compare(Interval(fromjson("{'': 50, '': 70}"), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[69].compare(Interval(fromjson("{'': 99, '': 99}"), true, true)));
+}
+
 TEST(IndexBoundsBuilderTest, UnionTwoEmptyRanges) {
     IndexEntry testIndex = IndexEntry(BSONObj());
     vector<std::pair<BSONObj, bool>> constraints;
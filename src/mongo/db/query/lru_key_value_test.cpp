@@ -175,6 +175,32 @@ TEST(LRUKeyValueTest, ReplaceKeyTest) {
     assertInKVStore(cache, 4, 5);
 }
 
+/**
+ * Test that removeLeastRecentlyUsed() takes entries off the back of the list, taking
+ * promotions by get() into account.
+ */
+TEST(LRUKeyValueTest, RemoveLeastRecentlyUsedTest) {
+    LRUKeyValue<int, int> cache(10);
+    ASSERT(NULL == cache.removeLeastRecentlyUsed().get());
+
+    cache.add(1, new int(1));
+    cache.add(2, new int(2));
+    cache.add(3, new int(3));
+    assertInKVStore(cache, 1, 1);
+
+    std::unique_ptr<int> removed = cache.removeLeastRecentlyUsed();
+    ASSERT(NULL != removed.get());
+    ASSERT_EQUALS(*removed, 2);
+    ASSERT_EQUALS(cache.size(), 2U);
+    assertNotInKVStore(cache, 2);
+
+    removed = cache.removeLeastRecentlyUsed();
+    ASSERT(NULL != removed.get());
+    ASSERT_EQUALS(*removed, 3);
+    ASSERT_EQUALS(cache.size(), 1U);
+    assertInKVStore(cache, 1, 1);
+}
+
 /**
  * Test iteration over the kv-store.
  */
@@ -40,6 +40,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -246,6 +247,55 @@ void encodeGeoNearMatchExpression(const GeoNearMatchExpression* tree, StringBuil
     }
 }
 
+size_t estimateIndexTreeSize(const PlanCacheIndexTree* tree) {
+    if (!tree) {
+        return 0;
+    }
+    size_t size = sizeof(PlanCacheIndexTree);
+    if (tree->entry) {
+        size += sizeof(IndexEntry) + tree->entry->keyPattern.objsize() +
+            tree->entry->infoObj.objsize() + tree->entry->name.capacity();
+    }
+    for (const auto& orPushdown : tree->orPushdowns) {
+        size += sizeof(orPushdown) + orPushdown.indexName.capacity() +
+            orPushdown.route.size() * sizeof(size_t);
+    }
+    for (const PlanCacheIndexTree* child : tree->children) {
+        size += estimateIndexTreeSize(child);
+    }
+    return size;
+}
+
+size_t estimateStatsTreeSize(const PlanStageStats* stats) {
+    // The stage-specific stats are not accounted for, as their size depends on the stage type.
+    size_t size = sizeof(PlanStageStats);
+    for (const auto& child : stats->children) {
+        size += estimateStatsTreeSize(child.get());
+    }
+    return size;
+}
+
+/**
+ * Returns an approximation of the memory used by 'entry', not counting the feedback which is
+ * added to it later on.
+ */
+size_t estimateEntrySize(const PlanCacheKey& key, const PlanCacheEntry& entry) {
+    size_t size = sizeof(PlanCacheEntry) + key.capacity() + entry.query.objsize() +
+        entry.sort.objsize() + entry.projection.objsize() + entry.collation.objsize();
+    for (const SolutionCacheData* scd : entry.plannerData) {
+        size += sizeof(SolutionCacheData) + estimateIndexTreeSize(scd->tree.get());
+    }
+    if (entry.decision) {
+        size += sizeof(PlanRankingDecision);
+        for (const PlanStageStats* stats : entry.decision->stats.vector()) {
+            size += estimateStatsTreeSize(stats);
+        }
+        size += (entry.decision->scores.size() + entry.decision->candidateOrder.size()) *
+            sizeof(double);
+    }
+    return size;
+}
+
 }  // namespace
 
 //
@@ -375,6 +425,11 @@ PlanCacheEntry* PlanCacheEntry::clone() const {
     entry->projection = projection.getOwned();
     entry->collation = collation.getOwned();
 
+    // Copy usage stats.
+    entry->estimatedEntrySizeBytes = estimatedEntrySizeBytes;
+    entry->numHits = numHits;
+    entry->numReplans = numReplans;
+
     // Copy performance stats.
     for (size_t i = 0; i < feedback.size(); ++i) {
         PlanCacheEntryFeedback* fb = new PlanCacheEntryFeedback();
@@ -487,6 +542,10 @@ std::string SolutionCacheData::toString() const {
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
                                  << "tree=" << this->tree->toString() << ")";
+        case SKIP_IXSCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(skip index scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
     }
     MONGO_UNREACHABLE;
 }
@@ -495,9 +554,13 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : _cache(internalQueryCacheSize.load()) {}
+PlanCache::PlanCache() {
+    _initShards();
+}
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
+PlanCache::PlanCache(const std::string& ns) : _ns(ns) {
+    _initShards();
+}
 
 PlanCache::~PlanCache() {}
 
@@ -674,14 +737,32 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    const PlanCacheKey key = computeKey(query);
+    entry->estimatedEntrySizeBytes = estimateEntrySize(key, *entry);
+
+    Shard& shard = _getShard(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
+
+    // If this query shape is already cached, it is being planned again. Carry its usage stats
+    // over to the new entry, which replaces the old one.
+    PlanCacheEntry* oldEntry;
+    if (shard.cache.get(key, &oldEntry).isOK()) {
+        entry->numHits = oldEntry->numHits;
+        entry->numReplans = oldEntry->numReplans + 1;
+        shard.sizeBytes -= oldEntry->estimatedEntrySizeBytes;
+    }
+
+    std::unique_ptr<PlanCacheEntry> evictedEntry = shard.cache.add(key, entry);
+    shard.sizeBytes += entry->estimatedEntrySizeBytes;
 
     if (NULL != evictedEntry.get()) {
+        shard.sizeBytes -= evictedEntry->estimatedEntrySizeBytes;
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
                << "removed least recently used entry " << redact(evictedEntry->toString());
     }
 
+    _enforceSizeBudget(&shard);
+
     return Status::OK();
 }
 
@@ -689,14 +770,16 @@ Status PlanCache::get(const CanonicalQuery& query, CachedSolution** crOut) const
     PlanCacheKey key = computeKey(query);
     verify(crOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Shard& shard = _getShard(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = shard.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
     invariant(entry);
 
+    ++entry->numHits;
     *crOut = new CachedSolution(key, *entry);
 
     return Status::OK();
@@ -709,9 +792,10 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
     std::unique_ptr<PlanCacheEntryFeedback> autoFeedback(feedback);
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Shard& shard = _getShard(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = shard.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -726,13 +810,24 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const PlanCacheKey key = computeKey(canonicalQuery);
+    Shard& shard = _getShard(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
+    PlanCacheEntry* entry;
+    Status cacheStatus = shard.cache.get(key, &entry);
+    if (!cacheStatus.isOK()) {
+        return cacheStatus;
+    }
+    shard.sizeBytes -= entry->estimatedEntrySizeBytes;
+    return shard.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto& shard : _shards) {
+        stdx::lock_guard<stdx::mutex> cacheLock(shard->mutex);
+        shard->cache.clear();
+        shard->sizeBytes = 0;
+    }
     _writeOperations.store(0);
 }
 
@@ -748,9 +843,10 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
     PlanCacheKey key = computeKey(query);
     verify(entryOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Shard& shard = _getShard(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = shard.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -762,29 +858,68 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
 }
 
 std::vector<PlanCacheEntry*> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<PlanCacheEntry*> entries;
     typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
-    for (ConstIterator i = _cache.begin(); i != _cache.end(); i++) {
-        PlanCacheEntry* entry = i->second;
-        entries.push_back(entry->clone());
+    for (const auto& shard : _shards) {
+        stdx::lock_guard<stdx::mutex> cacheLock(shard->mutex);
+        for (ConstIterator i = shard->cache.begin(); i != shard->cache.end(); i++) {
+            PlanCacheEntry* entry = i->second;
+            entries.push_back(entry->clone());
+        }
     }
 
     return entries;
 }
 
 bool PlanCache::contains(const CanonicalQuery& cq) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.hasKey(computeKey(cq));
+    const PlanCacheKey key = computeKey(cq);
+    Shard& shard = _getShard(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(shard.mutex);
+    return shard.cache.hasKey(key);
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (const auto& shard : _shards) {
+        stdx::lock_guard<stdx::mutex> cacheLock(shard->mutex);
+        size += shard->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
     _indexabilityState.updateDiscriminators(indexEntries);
 }
 
+void PlanCache::_initShards() {
+    // Round up, so that the shards together hold at least internalQueryCacheSize entries.
+    const size_t maxEntries = internalQueryCacheSize.load();
+    const size_t maxEntriesPerShard =
+        std::max<size_t>(1, (maxEntries + kNumShards - 1) / kNumShards);
+    _shards.reserve(kNumShards);
+    for (size_t i = 0; i < kNumShards; ++i) {
+        _shards.push_back(stdx::make_unique<Shard>(maxEntriesPerShard));
+    }
+}
+
+PlanCache::Shard& PlanCache::_getShard(const PlanCacheKey& key) const {
+    return *_shards[std::hash<PlanCacheKey>()(key) % _shards.size()];
+}
+
+void PlanCache::_enforceSizeBudget(Shard* shard) {
+    const int maxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    if (maxSizeBytes <= 0) {
+        return;
+    }
+
+    const size_t maxSizeBytesPerShard = maxSizeBytes / kNumShards;
+    while (shard->sizeBytes > maxSizeBytesPerShard && shard->cache.size() > 1) {
+        std::unique_ptr<PlanCacheEntry> evictedEntry = shard->cache.removeLeastRecentlyUsed();
+        invariant(evictedEntry);
+        shard->sizeBytes -= evictedEntry->estimatedEntrySizeBytes;
+        LOG(1) << _ns << ": plan cache maximum size in bytes exceeded - "
+               << "removed least recently used entry " << redact(evictedEntry->toString());
+    }
+}
+
 }  // namespace mongo
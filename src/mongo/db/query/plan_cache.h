@@ -176,7 +176,11 @@ struct SolutionCacheData {
 
         // Build the solution by using 'tree'
         // to tag the match expression.
-        USE_INDEX_TAGS_SOLN
+        USE_INDEX_TAGS_SOLN,
+
+        // The cached plan skip scans the index
+        // stored in 'tree'.
+        SKIP_IXSCAN_SOLN
     } solnType;
 
     // The direction of the index scan used as
@@ -279,6 +283,20 @@ public:
     // Annotations from cached runs.  The CachedPlanStage provides these stats about its
     // runs when they complete.
     std::vector<PlanCacheEntryFeedback*> feedback;
+
+    //
+    // Usage stats, maintained by the PlanCache
+    //
+
+    // Approximate memory footprint of this entry, computed when the entry is created.
+    size_t estimatedEntrySizeBytes = 0;
+
+    // Number of times the cached plans were handed out by PlanCache::get().
+    long long numHits = 0;
+
+    // Number of times this query shape was planned again from scratch and the entry replaced,
+    // for instance because the cached plan performed poorly.
+    long long numReplans = 0;
 };
 
 /**
@@ -286,6 +304,11 @@ public:
  * mapping, the cache contains information on why that mapping was made and statistics on the
  * cache entry's actual performance on subsequent runs.
  *
+ * The cache is split into a fixed number of shards by hash of the PlanCacheKey, each one an
+ * independent LRU store with its own mutex, so that lookups of different query shapes do not
+ * contend with each other. The internalQueryCacheSize and internalQueryCacheMaxSizeBytes limits
+ * are divided evenly among the shards, so the least recently used entry is evicted from the
+ * shard being added to rather than from the whole cache.
  */
 class PlanCache {
 private:
@@ -415,10 +438,33 @@ private:
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    static const size_t kNumShards = 16;
+
+    struct Shard {
+        Shard(size_t maxEntries) : cache(maxEntries) {}
+
+        // Protects the members below.
+        mutable stdx::mutex mutex;
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry> cache;
+
+        // Sum of 'estimatedEntrySizeBytes' over the entries in 'cache'.
+        size_t sizeBytes = 0;
+    };
+
+    void _initShards();
+
+    Shard& _getShard(const PlanCacheKey& key) const;
+
+    /**
+     * Evicts least recently used entries from 'shard' until it is within its share of
+     * internalQueryCacheMaxSizeBytes. The most recently used entry is never evicted.
+     *
+     * The caller must hold the shard's mutex.
+     */
+    void _enforceSizeBudget(Shard* shard);
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    std::vector<std::unique_ptr<Shard>> _shards;
 
     // Counter for write notifications since initialization or last clear() invocation.  Starts
     // at 0.
@@ -48,6 +48,7 @@
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
 
 using namespace mongo;
@@ -422,6 +423,43 @@ TEST(PlanCacheTest, AddValidSolution) {
     ASSERT_EQUALS(planCache.size(), 1U);
 }
 
+TEST(PlanCacheTest, SizeBudgetEvictsLeastRecentlyUsedEntries) {
+    int oldMaxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    ON_BLOCK_EXIT([oldMaxSizeBytes] { internalQueryCacheMaxSizeBytes.store(oldMaxSizeBytes); });
+
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+
+    const size_t numShapes = 100;
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (size_t i = 0; i < numShapes; ++i) {
+        const std::string fieldName = str::stream() << "a" << i;
+        queries.push_back(canonicalize(BSON(fieldName << 1)));
+    }
+
+    // Without a size budget, every query shape is cached.
+    internalQueryCacheMaxSizeBytes.store(0);
+    PlanCache unlimitedCache;
+    for (const auto& cq : queries) {
+        ASSERT_OK(unlimitedCache.add(*cq, solns, createDecision(1U)));
+    }
+    ASSERT_EQUALS(unlimitedCache.size(), numShapes);
+
+    // A budget too small for a single entry still keeps the most recently added entry of each
+    // shard, but nothing more.
+    internalQueryCacheMaxSizeBytes.store(1);
+    PlanCache limitedCache;
+    for (const auto& cq : queries) {
+        ASSERT_OK(limitedCache.add(*cq, solns, createDecision(1U)));
+        ASSERT_TRUE(limitedCache.contains(*cq));
+    }
+    ASSERT_LESS_THAN(limitedCache.size(), numShapes);
+    ASSERT_GREATER_THAN(limitedCache.size(), 0U);
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -95,6 +95,13 @@ bool PlanYieldPolicy::yield(RecordFetcher* fetcher) {
             // if this operation has been interrupted. Throws if the interrupt flag is set.
             if (_policy == PlanExecutor::YIELD_AUTO) {
                 opCtx->checkForInterrupt();
+
+                // If the locks are held recursively, e.g. inside a DBDirectClient call, they cannot
+                // be released and the snapshot is kept, so saving and restoring the plan would
+                // only reposition its cursors for nothing.
+                if (!opCtx->lockState()->canSaveLockState()) {
+                    return true;
+                }
             }
 
             try {
@@ -33,6 +33,7 @@
 #include "mongo/db/query/planner_access.h"
 
 #include <algorithm>
+#include <map>
 #include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -1280,6 +1281,71 @@ QuerySolutionNode* QueryPlannerAccess::scanWholeIndex(const IndexEntry& index,
     return solnRoot;
 }
 
+// static
+QuerySolutionNode* QueryPlannerAccess::skipScanIndex(const IndexEntry& index,
+                                                     const CanonicalQuery& query,
+                                                     const QueryPlannerParams& params) {
+    if (index.keyPattern.nFields() < 2) {
+        return NULL;
+    }
+
+    // Collect the top-level equalities, which are the only predicates we build bounds from.
+    std::map<StringData, const MatchExpression*> equalities;
+    const MatchExpression* root = query.root();
+    if (MatchExpression::EQ == root->matchType()) {
+        equalities.insert(std::make_pair(root->path(), root));
+    } else if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            const MatchExpression* child = root->getChild(i);
+            if (MatchExpression::EQ == child->matchType()) {
+                equalities.insert(std::make_pair(child->path(), child));
+            }
+        }
+    } else {
+        return NULL;
+    }
+
+    unique_ptr<IndexScanNode> isn = make_unique<IndexScanNode>(index);
+    isn->maxScan = query.getQueryRequest().getMaxScan();
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+
+    bool isLeadingField = true;
+    bool hasTrailingEquality = false;
+    BSONObjIterator it(index.keyPattern);
+    while (it.more()) {
+        BSONElement elt = it.next();
+        auto equality = equalities.find(elt.fieldNameStringData());
+
+        OrderedIntervalList oil;
+        if (equalities.end() == equality) {
+            IndexBoundsBuilder::allValuesForField(elt, &oil);
+        } else if (isLeadingField) {
+            // The regular planner already produces tighter bounds for this index.
+            return NULL;
+        } else {
+            IndexBoundsBuilder::BoundsTightness tightness;
+            IndexBoundsBuilder::translate(equality->second, elt, index, &oil, &tightness);
+            hasTrailingEquality = true;
+        }
+        oil.name = elt.fieldName();
+        isn->bounds.fields.push_back(oil);
+        isLeadingField = false;
+    }
+
+    if (!hasTrailingEquality) {
+        return NULL;
+    }
+
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    // The bounds are rarely tight for the whole predicate, so always re-apply it after fetching.
+    unique_ptr<FetchNode> fetch = make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch.release();
+}
+
 // static
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
@@ -197,6 +197,17 @@ public:
                                              const QueryPlannerParams& params,
                                              int direction = 1);
 
+    /**
+     * Return a plan that scans 'index' with all-values bounds on its leading field and point
+     * bounds on every later field which has a top-level equality predicate in 'query', or NULL
+     * if the index is not compound, the leading field is constrained by an equality, or no later
+     * field has one. The index scan executor seeks between distinct values of the unconstrained
+     * fields, so this skips over the parts of the index which cannot match.
+     */
+    static QuerySolutionNode* skipScanIndex(const IndexEntry& index,
+                                            const CanonicalQuery& query,
+                                            const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
@@ -481,6 +481,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         return solnRoot;
     }
 
+    // A text search for a single term returns its results in descending order of text score,
+    // so a sort on the score alone is already provided.
+    if (STAGE_TEXT == solnRoot->getType() && sortObj.nFields() == 1 &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement()) &&
+        static_cast<const TextNode*>(solnRoot)->ftsQuery->hasSingleTermForBounds()) {
+        return solnRoot;
+    }
+
     // See if solnRoot gives us the sort.  If so, we're done.
     BSONObjSet sorts = solnRoot->getSort();
 
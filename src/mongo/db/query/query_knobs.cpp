@@ -40,14 +40,28 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxResults, int, 101);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSize, int, 5000);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheMaxSizeBytes, int, 0);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheFeedbacksStored, int, 20);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheEvictionRatio, double, 10.0);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheAdaptiveReplanning, bool, false);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerMaxIndexedSolutions, int, 64);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnumerationMaxOrSolutions, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryOrStageInterleaveChildren, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryAndHashUseBloomFilter, bool, true);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPersistIndexFilters, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerMaxCandidatesToRace, int, 0);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableIndexSkipScan, bool, false);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnumerationMaxIntersectPerAnd, int, 3);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryForceIntersectionPlans, bool, false);
@@ -66,12 +80,56 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxBlockingSortBytes, int, 32 * 1
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldIterations, int, 128);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldPeriodMS, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecCollectionScanBatchSize, int, 1);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetBufferSizeBytes, int, 100 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetMaxParallelism, int, 1);
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryFacetWorkerThreads, int, 8);
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryPipelineResultCacheSizeBytes, int, 0);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStatsStoreSizeBytes, int, 0);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxBatchSize,
                               int,
                               internalQueryExecYieldIterations.load() / 2);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorBatchSizeBytes, int, 4 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorLazyDocuments, bool, true);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCompileAggregationExpressions, bool, false);
+
+AtomicInt32 internalDocumentSourceGraphLookupMaxMemoryBytes{100 * 1024 * 1024};
+
+namespace {
+class ExportedGraphLookupMaxMemoryBytesParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedGraphLookupMaxMemoryBytesParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "internalDocumentSourceGraphLookupMaxMemoryBytes",
+              &internalDocumentSourceGraphLookupMaxMemoryBytes) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        // The limit is used as a size_t, so a negative value would disable it.
+        if (potentialNewValue < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceGraphLookupMaxMemoryBytes must be at least 0");
+        }
+
+        return Status::OK();
+    }
+} exportedGraphLookupMaxMemoryBytesParam;
+}  // namespace
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupHashJoinMaxBytes,
+                              int,
+                              16 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxSampleRatioForRandomCursor, double, 0.05);
+
 }  // namespace mongo
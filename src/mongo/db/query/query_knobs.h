@@ -64,6 +64,10 @@ extern AtomicBool internalQueryPlannerEnableHashIntersection;
 // How many entries in the cache?
 extern AtomicInt32 internalQueryCacheSize;
 
+// How many bytes may the cache entries of a single collection take up, as estimated by
+// PlanCacheEntry::estimatedEntrySizeBytes? Zero means that only the number of entries is limited.
+extern AtomicInt32 internalQueryCacheMaxSizeBytes;
+
 // How many feedback entries do we collect before possibly evicting from the cache based on bad
 // performance?
 extern AtomicInt32 internalQueryCacheFeedbacksStored;
@@ -72,6 +76,11 @@ extern AtomicInt32 internalQueryCacheFeedbacksStored;
 // and replanning?
 extern AtomicDouble internalQueryCacheEvictionRatio;
 
+// If true, a cached plan is replanned as soon as its works per result during the trial period
+// project past the eviction budget, and its cache entry is evicted if its works per result keep
+// degrading once the trial period is over.
+extern AtomicBool internalQueryCacheAdaptiveReplanning;
+
 //
 // Planning and enumeration.
 //
@@ -79,6 +88,26 @@ extern AtomicDouble internalQueryCacheEvictionRatio;
 // How many indexed solutions will QueryPlanner::plan output?
 extern AtomicInt32 internalQueryPlannerMaxIndexedSolutions;
 
+// How many of the indexed solutions, ranked by their index bounds, will QueryPlanner::plan keep
+// for the MultiPlanStage to race? 0 means all of them.
+extern AtomicInt32 internalQueryPlannerMaxCandidatesToRace;
+
+// Should QueryPlanner::plan consider skip scans over compound indexes whose leading field is
+// unconstrained, when the query has an equality on one of the later fields?
+extern AtomicBool internalQueryPlannerEnableIndexSkipScan;
+
+// If true, OR stages advance their children in turn rather than draining each child before
+// starting the next, so that an expensive branch does not hold back results from cheap ones.
+extern AtomicBool internalQueryOrStageInterleaveChildren;
+
+// Should AND_HASH stages check a Bloom filter of the hashed RecordIds before probing the hash
+// table?
+extern AtomicBool internalQueryAndHashUseBloomFilter;
+
+// Should the index filter commands record index filters in a replicated collection, from which
+// they are restored on startup and when a node becomes primary?
+extern AtomicBool internalQueryPersistIndexFilters;
+
 // How many solutions will the enumerator consider at each OR?
 extern AtomicInt32 internalQueryEnumerationMaxOrSolutions;
 
@@ -104,14 +133,57 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// How many records a collection scan may examine in a single call to work() while looking for
+// one which passes its filter. The plan ranker's trial period and the yield policy both count
+// calls to work(), so values above 1 (the default) let a scan do more work per trial and
+// between yields.
+extern AtomicInt32 internalQueryExecCollectionScanBatchSize;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
 // The number of bytes to buffer at once during a $facet stage.
 extern AtomicInt32 internalQueryFacetBufferSizeBytes;
 
+// The maximum number of threads a $facet stage may use to run its sub-pipelines. 1 runs them all
+// on the thread executing the operation.
+extern AtomicInt32 internalQueryFacetMaxParallelism;
+
+// The maximum number of threads in the pool shared by all $facet stages to run sub-pipelines off
+// the thread executing the operation.
+extern int internalQueryFacetWorkerThreads;
+
+// The number of bytes of aggregation results to keep, so that an aggregation identical to an
+// earlier one on an unchanged collection can return them without running again. 0 disables this.
+// Collections only track their writes while this is enabled, so it can only be set at startup.
+extern int internalQueryPipelineResultCacheSizeBytes;
+
+// The total number of bytes of execution statistics to keep across all query shapes, reported by
+// the $queryStats aggregation stage. 0 (the default) disables collecting them.
+extern AtomicInt32 internalQueryStatsStoreSizeBytes;
+
 extern AtomicInt32 internalInsertMaxBatchSize;
 
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
+// If true, documents read from a collection by an aggregation without known dependencies only
+// convert their top-level fields to Values when a later stage looks them up.
+extern AtomicBool internalDocumentSourceCursorLazyDocuments;
+
+// If true, optimized $project and $addFields expressions are compiled to a CompiledExpression.
+extern AtomicBool internalQueryCompileAggregationExpressions;
+
+// The number of bytes a $graphLookup may use to track the documents found and the values still to
+// be searched for while processing a single input document.
+extern AtomicInt32 internalDocumentSourceGraphLookupMaxMemoryBytes;
+
+// The largest foreign collection, in bytes, which a $lookup will load into a hash table rather
+// than querying once per input document. Zero disables hash joins.
+extern AtomicInt32 internalDocumentSourceLookupHashJoinMaxBytes;
+
+// The largest fraction of a collection which $sample will collect with a random cursor. Larger
+// samples sort the whole collection by a random key, as a random cursor would return too many
+// duplicates.
+extern AtomicDouble internalQueryMaxSampleRatioForRandomCursor;
+
 }  // namespace mongo
@@ -32,7 +32,9 @@
 
 #include "mongo/db/query/query_planner.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <set>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -50,6 +52,7 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/util/log.h"
@@ -73,6 +76,120 @@ static bool isIdIndex(const BSONObj& pattern) {
     return i.next().eoo();
 }
 
+namespace {
+
+/**
+ * A rough, statistics-free estimate of how selective a candidate plan is, derived from the bounds
+ * of its index scans. Used to prune the candidates before they are raced.
+ */
+struct CandidateShape {
+    // Fewest leading point-only fields over all of the plan's index scans.
+    size_t equalityPrefix = 0;
+
+    // Fewest fields with anything tighter than [MinKey, MaxKey] over all of the index scans.
+    size_t boundedFields = 0;
+
+    bool hasBlockingStage = false;
+
+    bool isBetterThan(const CandidateShape& other) const {
+        if (equalityPrefix != other.equalityPrefix) {
+            return equalityPrefix > other.equalityPrefix;
+        }
+        if (boundedFields != other.boundedFields) {
+            return boundedFields > other.boundedFields;
+        }
+        return !hasBlockingStage && other.hasBlockingStage;
+    }
+};
+
+bool isAllValues(const OrderedIntervalList& oil) {
+    if (oil.intervals.size() != 1U) {
+        return false;
+    }
+    const Interval& interval = oil.intervals.front();
+    return (interval.start.type() == MinKey && interval.end.type() == MaxKey) ||
+        (interval.start.type() == MaxKey && interval.end.type() == MinKey);
+}
+
+bool isAllPoints(const OrderedIntervalList& oil) {
+    return !oil.intervals.empty() &&
+        std::all_of(oil.intervals.begin(), oil.intervals.end(), [](const Interval& interval) {
+            return interval.isPoint();
+        });
+}
+
+void collectIndexScans(const QuerySolutionNode* node, std::vector<const IndexScanNode*>* out) {
+    if (STAGE_IXSCAN == node->getType()) {
+        out->push_back(static_cast<const IndexScanNode*>(node));
+    }
+    for (const QuerySolutionNode* child : node->children) {
+        collectIndexScans(child, out);
+    }
+}
+
+CandidateShape shapeOf(const QuerySolution& soln) {
+    CandidateShape shape;
+    shape.hasBlockingStage = soln.hasBlockingStage;
+
+    std::vector<const IndexScanNode*> scans;
+    collectIndexScans(soln.root.get(), &scans);
+
+    bool first = true;
+    for (const IndexScanNode* scan : scans) {
+        const std::vector<OrderedIntervalList>& fields = scan->bounds.fields;
+
+        size_t equalityPrefix = 0;
+        while (equalityPrefix < fields.size() && isAllPoints(fields[equalityPrefix])) {
+            ++equalityPrefix;
+        }
+        size_t boundedFields = std::count_if(
+            fields.begin(), fields.end(), [](const OrderedIntervalList& oil) {
+                return !isAllValues(oil);
+            });
+
+        shape.equalityPrefix =
+            first ? equalityPrefix : std::min(shape.equalityPrefix, equalityPrefix);
+        shape.boundedFields = first ? boundedFields : std::min(shape.boundedFields, boundedFields);
+        first = false;
+    }
+    return shape;
+}
+
+/**
+ * Keeps only the 'maxCandidates' best-looking solutions in 'solutions', deleting the rest. The
+ * relative order of the solutions which are kept is preserved.
+ */
+void pruneCandidates(size_t maxCandidates, std::vector<QuerySolution*>* solutions) {
+    if (solutions->size() <= maxCandidates) {
+        return;
+    }
+
+    std::vector<std::pair<CandidateShape, QuerySolution*>> ranked;
+    for (QuerySolution* soln : *solutions) {
+        ranked.emplace_back(shapeOf(*soln), soln);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.isBetterThan(rhs.first);
+    });
+
+    std::set<QuerySolution*> kept;
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        if (i < maxCandidates) {
+            kept.insert(ranked[i].second);
+        } else {
+            LOG(5) << "Planner: pruning candidate solution:" << endl
+                   << redact(ranked[i].second->toString());
+            delete ranked[i].second;
+        }
+    }
+    solutions->erase(std::remove_if(solutions->begin(),
+                                    solutions->end(),
+                                    [&kept](QuerySolution* soln) { return !kept.count(soln); }),
+                     solutions->end());
+}
+
+}  // namespace
+
 static bool is2DIndex(const BSONObj& pattern) {
     BSONObjIterator it(pattern);
     while (it.more()) {
@@ -253,6 +370,16 @@ QuerySolution* buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, solnRoot);
 }
 
+QuerySolution* buildSkipScanSoln(const IndexEntry& index,
+                                 const CanonicalQuery& query,
+                                 const QueryPlannerParams& params) {
+    QuerySolutionNode* solnRoot = QueryPlannerAccess::skipScanIndex(index, query, params);
+    if (NULL == solnRoot) {
+        return NULL;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, solnRoot);
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -443,6 +570,14 @@ Status QueryPlanner::planFromCache(const CanonicalQuery& query,
             *out = soln;
             return Status::OK();
         }
+    } else if (SolutionCacheData::SKIP_IXSCAN_SOLN == winnerCacheData.solnType) {
+        QuerySolution* soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (soln == NULL) {
+            return Status(ErrorCodes::BadValue, "plan cache error: skip index scan soln");
+        } else {
+            *out = soln;
+            return Status::OK();
+        }
     }
 
     // SolutionCacheData::USE_TAGS_SOLN == cacheData->solnType
@@ -997,6 +1132,48 @@ Status QueryPlanner::plan(const CanonicalQuery& query,
         }
     }
 
+    // If nothing else could use an index, a compound index whose leading field is unconstrained
+    // may still be worth scanning when a later field has an equality: the index scan seeks from
+    // one distinct leading value to the next instead of reading every key. Whether that beats a
+    // collscan depends on how many distinct leading values there are, which we do not know, so
+    // the collscan is added below and the two are raced.
+    bool onlySkipScans = false;
+    if (internalQueryPlannerEnableIndexSkipScan.load() && out->empty() && hintIndex.isEmpty() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (size_t i = 0; i < params.indices.size(); ++i) {
+            const IndexEntry& index = params.indices[i];
+            // Non-indexed documents would be missed by a sparse or partial index.
+            if (index.type != INDEX_BTREE || index.sparse || index.filterExpr) {
+                continue;
+            }
+            if (!CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+                continue;
+            }
+
+            QuerySolution* soln = buildSkipScanSoln(index, query, params);
+            if (NULL != soln) {
+                LOG(5) << "Planner: outputting skip scan soln over index " << index.name;
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_IXSCAN_SOLN;
+
+                soln->cacheData.reset(scd);
+                out->push_back(soln);
+                onlySkipScans = true;
+            }
+        }
+    }
+
+    // Racing every indexed candidate is expensive, so only keep the most promising ones if
+    // asked to.
+    const int maxCandidatesToRace = internalQueryPlannerMaxCandidatesToRace.load();
+    if (maxCandidatesToRace > 0) {
+        pruneCandidates(static_cast<size_t>(maxCandidatesToRace), out);
+    }
+
     // geoNear and text queries *require* an index.
     // Also, if a hint is specified it indicates that we MUST use it.
     bool possibleToCollscan =
@@ -1007,7 +1184,7 @@ Status QueryPlanner::plan(const CanonicalQuery& query,
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collscanNeeded = (0 == out->size() && canTableScan);
+    bool collscanNeeded = ((0 == out->size() || onlySkipScans) && canTableScan);
 
     if (possibleToCollscan && (collscanRequested || collscanNeeded)) {
         QuerySolution* collscan = buildCollscanSoln(query, isTailable, params);
@@ -3385,6 +3385,79 @@ TEST_F(QueryPlannerTest, IntersectCanBeVeryBig) {
     assertNumSolutions(internalQueryEnumerationMaxOrSolutions.load());
 }
 
+// Ensure that only the most selective-looking candidates are kept when the number of candidates
+// to race is limited.
+TEST_F(QueryPlannerTest, MaxCandidatesToRacePrefersTighterBounds) {
+    int oldMaxCandidatesToRace = internalQueryPlannerMaxCandidatesToRace.load();
+    internalQueryPlannerMaxCandidatesToRace.store(1);
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1 << "c" << 1));
+    addIndex(BSON("c" << 1));
+
+    runQuery(fromjson("{a: {$gt: 1}, b: 1, c: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {a: {$gt: 1}}, node: {ixscan: "
+        "{pattern: {b: 1, c: 1}, bounds: {b: [[1,1,true,true]], c: [[1,1,true,true]]}}}}}");
+
+    internalQueryPlannerMaxCandidatesToRace.store(oldMaxCandidatesToRace);
+}
+
+TEST_F(QueryPlannerTest, SkipScanUnconstrainedLeadingField) {
+    bool oldEnableIndexSkipScan = internalQueryPlannerEnableIndexSkipScan.load();
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    runQuery(fromjson("{b: 5, d: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5, d: 1}, node: {ixscan: {pattern: {a: 1, b: 1, c: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]], "
+        "c: [['MinKey','MaxKey',true,true]]}}}}}");
+
+    internalQueryPlannerEnableIndexSkipScan.store(oldEnableIndexSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsRacedAgainstCollscan) {
+    bool oldEnableIndexSkipScan = internalQueryPlannerEnableIndexSkipScan.load();
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+
+    addIndex(BSON("a" << 1 << "b" << 1));
+    addIndex(BSON("c" << 1));
+
+    // The index on 'c' gives an ordinary indexed plan, so no skip scan is generated.
+    runQuery(fromjson("{b: 5, c: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists("{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {c: 1}}}}}");
+
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+
+    internalQueryPlannerEnableIndexSkipScan.store(oldEnableIndexSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanDisabledByDefault) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(0U);
+}
+
 // Ensure that disabling AND_HASH intersection works properly.
 TEST_F(QueryPlannerTest, IntersectDisableAndHash) {
     bool oldEnableHashIntersection = internalQueryPlannerEnableHashIntersection.load();
@@ -33,6 +33,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_event_profile.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/time_support.h"
@@ -68,6 +69,9 @@ void QueryYield::yieldAllLocks(OperationContext* txn,
         return;
     }
 
+    // Charged for the whole time the locks are released, including reacquiring them.
+    ScopedWaitEvent yieldWait(WaitEvent::kYield);
+
     // Top-level locks are freed, release any potential low-level (storage engine-specific
     // locks). If we are yielding, we are at a safe place to do so.
     txn->recoveryUnit()->abandonSnapshot();
@@ -71,6 +71,9 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionCountAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 // The number of attempts for the find command, which gets the data.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
+// The total size of fetched documents waiting to be inserted, above which the next batch is not
+// requested until the bulk loader has taken the buffered documents.
+MONGO_EXPORT_SERVER_PARAMETER(collectionClonerMaxBufferedBytes, int, 64 * 1024 * 1024);
 }  // namespace
 
 CollectionCloner::CollectionCloner(executor::TaskExecutor* executor,
@@ -232,6 +235,10 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
         _findFetcher->shutdown();
     }
     _dbWorkTaskRunner.cancel();
+
+    // Wake up a fetcher callback waiting for the buffered documents to be inserted.
+    _workCanceled = true;
+    _condition.notify_all();
 }
 
 CollectionCloner::Stats CollectionCloner::getStats() const {
@@ -420,6 +427,9 @@ void CollectionCloner::_findCallback(const StatusWith<Fetcher::QueryResponse>& f
     if (batchData.documents.size() > 0) {
         LockGuard lk(_mutex);
         _documents.insert(_documents.end(), batchData.documents.begin(), batchData.documents.end());
+        for (const auto& doc : batchData.documents) {
+            _documentsBytes += doc.objsize();
+        }
     } else if (!batchData.first) {
         warning() << "No documents returned in batch; ns: " << _sourceNss
                   << ", cursorId:" << batchData.cursorId << ", isLastBatch:" << lastBatch;
@@ -444,6 +454,16 @@ void CollectionCloner::_findCallback(const StatusWith<Fetcher::QueryResponse>& f
     }
 
     if (!lastBatch) {
+        // Hold back the getMore while too many fetched documents wait for the bulk loader, so that
+        // a loader slower than the network does not let _documents grow without bound. The insert
+        // scheduled above takes all of the buffered documents once the previous insert is done.
+        UniqueLock lk(_mutex);
+        _condition.wait(lk, [this]() {
+            return _workCanceled ||
+                _documentsBytes <= static_cast<long long>(collectionClonerMaxBufferedBytes.load());
+        });
+        lk.unlock();
+
         invariant(getMoreBob);
         getMoreBob->append("getMore", batchData.cursorId);
         getMoreBob->append("collection", batchData.nss.coll());
@@ -536,11 +556,20 @@ void CollectionCloner::_insertDocumentsCallback(
     }
 
     _documents.swap(docs);
+    _documentsBytes = 0;
+    _condition.notify_all();
     _stats.documentsCopied += docs.size();
     ++_stats.fetchBatches;
     _progressMeter.hit(int(docs.size()));
     invariant(_collLoader);
+
+    // Insert without holding the mutex, which _findCallback needs to queue the next batch. This
+    // lets the fetcher keep receiving batches from the network while the bulk loader inserts the
+    // documents and generates their index keys. Inserts are serialized by _dbWorkTaskRunner, and
+    // the loader outlives this callback because it holds onto the completion guard.
+    lk.unlock();
     const auto status = _collLoader->insertDocuments(docs.cbegin(), docs.cend());
+    lk.lock();
 
     if (!status.isOK()) {
         onCompletionGuard->setResultAndCancelRemainingWork_inlock(lk, status);
@@ -644,6 +673,11 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
             auto elapsed = end - start;
             long long elapsedMillis = duration_cast<Milliseconds>(elapsed).count();
             builder->appendNumber("elapsedMillis", elapsedMillis);
+            if (elapsedMillis > 0) {
+                builder->appendNumber("documentsCopiedPerSecond",
+                                      static_cast<long long>(documentsCopied) * 1000 /
+                                          elapsedMillis);
+            }
         }
     }
 }
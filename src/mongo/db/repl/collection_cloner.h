@@ -234,6 +234,8 @@ private:
     std::vector<BSONObj> _indexSpecs;             // (M)
     BSONObj _idIndexSpec;                         // (M)
     std::vector<BSONObj> _documents;              // (M) Documents read from fetcher to insert.
+    long long _documentsBytes = 0;                // (M) Total size of _documents.
+    bool _workCanceled = false;                   // (M) Set once remaining work is canceled.
     TaskRunner _dbWorkTaskRunner;                 // (R)
     ScheduleDbWorkFn
         _scheduleDbWorkFn;         // (RT) Function for scheduling database work using the executor.
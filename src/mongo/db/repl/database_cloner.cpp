@@ -62,6 +62,10 @@ const char* kOptionsFieldName = "options";
 // The number of attempts for the listCollections commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListCollectionsAttempts, int, 3);
 
+// The number of collections of a database that are cloned at the same time. Read whenever a
+// collection cloner finishes, so changing it takes effect while a database is being cloned.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncCollectionClonerConcurrency, int, 1);
+
 /**
  * Default listCollections predicate.
  */
@@ -373,17 +377,37 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
-    _currentCollectionClonerIter = _collectionCloners.begin();
+    // Start the first collection cloners.
+    _nextCollectionClonerIter = _collectionCloners.begin();
+    _startCollectionCloners_inlock();
+    if (_activeCollectionCloners == 0) {
+        _finishCallback_inlock(lk, _collectionClonerStartStatus);
+        return;
+    }
+}
 
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
+void DatabaseCloner::_startCollectionCloners_inlock() {
+    const size_t concurrency = std::max(1, initialSyncCollectionClonerConcurrency.load());
+    while (_activeCollectionCloners < concurrency &&
+           _nextCollectionClonerIter != _collectionCloners.end()) {
+        auto&& collectionCloner = *_nextCollectionClonerIter++;
+        LOG(1) << "    cloning collection " << collectionCloner.getSourceNamespace();
 
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
-        _finishCallback_inlock(lk, startStatus);
-        return;
+        Status startStatus = _startCollectionCloner(collectionCloner);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on "
+                   << collectionCloner.getSourceNamespace() << ": " << redact(startStatus);
+            _collectionClonerStartStatus = startStatus;
+
+            // Start no further collection cloners, and do not wait for the running ones to copy
+            // everything, as the database cloner fails either way.
+            _nextCollectionClonerIter = _collectionCloners.end();
+            for (auto&& cloner : _collectionCloners) {
+                cloner.shutdown();
+            }
+            return;
+        }
+        ++_activeCollectionCloners;
     }
 }
 
@@ -407,17 +431,16 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     lk.unlock();
     _collectionWork(newStatus, nss);
     lk.lock();
-    _currentCollectionClonerIter++;
+    invariant(_activeCollectionCloners > 0);
+    --_activeCollectionCloners;
 
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
-        }
+    _startCollectionCloners_inlock();
+    if (_activeCollectionCloners > 0) {
+        return;
+    }
+
+    if (!_collectionClonerStartStatus.isOK()) {
+        _finishCallback_inlock(lk, _collectionClonerStartStatus);
         return;
     }
 
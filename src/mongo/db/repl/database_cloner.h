@@ -192,6 +192,13 @@ private:
      */
     void _collectionClonerCallback(const Status& status, const NamespaceString& nss);
 
+    /**
+     * Starts collection cloners in listCollections order until
+     * 'initialSyncCollectionClonerConcurrency' of them are running. On failure to start one,
+     * records the error in _collectionClonerStartStatus and shuts down the running ones.
+     */
+    void _startCollectionCloners_inlock();
+
     /**
      * Reports completion status.
      * Sets cloner to inactive.
@@ -237,7 +244,9 @@ private:
     std::vector<BSONObj> _collectionInfos;                               // (M)
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
-    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    std::list<CollectionCloner>::iterator _nextCollectionClonerIter;     // (M) First not started.
+    size_t _activeCollectionCloners = 0;                                 // (M)
+    Status _collectionClonerStartStatus = Status::OK();                  // (M)
     std::vector<std::pair<Status, NamespaceString>> _failedNamespaces;   // (M)
     CollectionCloner::ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
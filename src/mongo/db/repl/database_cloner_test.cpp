@@ -37,9 +37,11 @@
 #include "mongo/db/repl/base_cloner_test_fixture.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -751,6 +753,53 @@ TEST_F(DatabaseClonerTest, ShutdownCancelsCollectionCloning) {
     ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, getStatus());
 }
 
+TEST_F(DatabaseClonerTest, CollectionClonersRunConcurrentlyUpToConfiguredLimit) {
+    auto concurrency = ServerParameterSet::getGlobal()->getMap().find(
+        "initialSyncCollectionClonerConcurrency");
+    ASSERT(concurrency != ServerParameterSet::getGlobal()->getMap().end());
+    ASSERT_OK(concurrency->second->setFromString("2"));
+    ON_BLOCK_EXIT([concurrency] { invariantOK(concurrency->second->setFromString("1")); });
+
+    ASSERT_OK(_databaseCloner->startup());
+
+    auto net = getNet();
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+
+        processNetworkResponse(createListCollectionsResponse(0,
+                                                             BSON_ARRAY(BSON("name"
+                                                                             << "a"
+                                                                             << "options"
+                                                                             << BSONObj())
+                                                                        << BSON("name"
+                                                                                << "b"
+                                                                                << "options"
+                                                                                << BSONObj())
+                                                                        << BSON("name"
+                                                                                << "c"
+                                                                                << "options"
+                                                                                << BSONObj()))));
+
+        // The first two collection cloners send their count requests right away, the third one
+        // waits for one of them to finish.
+        for (auto&& collectionName : {"a", "b"}) {
+            auto noi = net->getNextReadyRequest();
+            assertRemoteCommandNameEquals("count", noi->getRequest());
+            ASSERT_EQUALS(collectionName, noi->getRequest().cmdObj.firstElement().String());
+            net->blackHole(noi);
+        }
+        ASSERT_FALSE(net->hasReadyRequests());
+    }
+
+    _databaseCloner->shutdown();
+    executor::NetworkInterfaceMock::InNetworkGuard(net)->runReadyNetworkOperations();
+
+    _databaseCloner->join();
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_EQUALS(DatabaseCloner::State::kComplete, _databaseCloner->getState_forTest());
+    ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, getStatus());
+}
+
 TEST_F(DatabaseClonerTest, FirstCollectionListIndexesFailed) {
     ASSERT_EQUALS(DatabaseCloner::State::kPreStart, _databaseCloner->getState_forTest());
 
@@ -0,0 +1,76 @@
+/**
+ *    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/is_master_await_args.h"
+
+#include <algorithm>
+
+#include "mongo/base/status.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace repl {
+
+const char IsMasterAwaitArgs::kTopologyVersionFieldName[] = "topologyVersion";
+const char IsMasterAwaitArgs::kMaxAwaitTimeMSFieldName[] = "maxAwaitTimeMS";
+
+const Milliseconds IsMasterAwaitArgs::kMaxAwaitTime = Minutes(5);
+
+Status IsMasterAwaitArgs::initialize(const BSONObj& cmdObj) {
+    BSONElement maxAwaitTimeElement = cmdObj[kMaxAwaitTimeMSFieldName];
+    if (maxAwaitTimeElement.eoo()) {
+        _isAwaitable = false;
+        return Status::OK();
+    }
+
+    BSONElement topologyVersionElement = cmdObj[kTopologyVersionFieldName];
+    if (topologyVersionElement.type() != Object) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << kMaxAwaitTimeMSFieldName << " requires the "
+                                    << kTopologyVersionFieldName
+                                    << " of an earlier reply");
+    }
+
+    // safeNumberLong() maps NaN to 0 and saturates out of range doubles.
+    if (!maxAwaitTimeElement.isNumber() || maxAwaitTimeElement.safeNumberLong() < 0) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << kMaxAwaitTimeMSFieldName
+                                    << " must be a non-negative number, but found: "
+                                    << maxAwaitTimeElement.toString(false));
+    }
+
+    _isAwaitable = true;
+    _topologyVersion = topologyVersionElement.Obj().getOwned();
+    _maxAwaitTime = std::min(Milliseconds(maxAwaitTimeElement.safeNumberLong()), kMaxAwaitTime);
+    return Status::OK();
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/jsobj.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class Status;
+
+namespace repl {
+
+/**
+ * The arguments with which isMaster waits for the topology of a replica set member to change:
+ * { topologyVersion : <from an earlier reply>, maxAwaitTimeMS : <ms> }.
+ */
+class IsMasterAwaitArgs {
+public:
+    static const char kTopologyVersionFieldName[];
+    static const char kMaxAwaitTimeMSFieldName[];
+
+    // Longer waits are shortened to this, so that a request is never held indefinitely.
+    static const Milliseconds kMaxAwaitTime;
+
+    /**
+     * Initializes this IsMasterAwaitArgs from the isMaster command object 'cmdObj'. Fails if
+     * maxAwaitTimeMS is not a non-negative number, or if it is given without a topologyVersion.
+     */
+    Status initialize(const BSONObj& cmdObj);
+
+    /**
+     * Returns true if the command asked to wait for a topology change.
+     */
+    bool isAwaitable() const {
+        return _isAwaitable;
+    }
+
+    const BSONObj& getTopologyVersion() const {
+        return _topologyVersion;
+    }
+
+    /**
+     * Gets the time to wait for, at most kMaxAwaitTime.
+     */
+    Milliseconds getMaxAwaitTime() const {
+        return _maxAwaitTime;
+    }
+
+private:
+    bool _isAwaitable = false;
+    BSONObj _topologyVersion;
+    Milliseconds _maxAwaitTime{0};
+};
+
+}  // namespace repl
+}  // namespace mongo
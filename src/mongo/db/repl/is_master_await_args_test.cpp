@@ -0,0 +1,112 @@
+/**
+ *    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/is_master_await_args.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const BSONObj kTopologyVersion = BSON("processId" << OID::gen() << "counter" << 3LL);
+
+TEST(IsMasterAwaitArgs, NotAwaitableWithoutMaxAwaitTime) {
+    IsMasterAwaitArgs args;
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1)));
+    ASSERT_FALSE(args.isAwaitable());
+
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion)));
+    ASSERT_FALSE(args.isAwaitable());
+}
+
+TEST(IsMasterAwaitArgs, ParsesTopologyVersionAndMaxAwaitTime) {
+    IsMasterAwaitArgs args;
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << 10000)));
+    ASSERT_TRUE(args.isAwaitable());
+    ASSERT_BSONOBJ_EQ(kTopologyVersion, args.getTopologyVersion());
+    ASSERT_EQ(Milliseconds(10000), args.getMaxAwaitTime());
+
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << 0)));
+    ASSERT_TRUE(args.isAwaitable());
+    ASSERT_EQ(Milliseconds(0), args.getMaxAwaitTime());
+}
+
+TEST(IsMasterAwaitArgs, ClampsMaxAwaitTime) {
+    IsMasterAwaitArgs args;
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << std::numeric_limits<long long>::max())));
+    ASSERT_EQ(IsMasterAwaitArgs::kMaxAwaitTime, args.getMaxAwaitTime());
+
+    ASSERT_OK(args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << 1e300)));
+    ASSERT_EQ(IsMasterAwaitArgs::kMaxAwaitTime, args.getMaxAwaitTime());
+}
+
+TEST(IsMasterAwaitArgs, RejectsNegativeMaxAwaitTime) {
+    IsMasterAwaitArgs args;
+    ASSERT_EQ(ErrorCodes::BadValue,
+              args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << -1)));
+    ASSERT_EQ(ErrorCodes::BadValue,
+              args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << -1e300)));
+}
+
+TEST(IsMasterAwaitArgs, RejectsNonNumericMaxAwaitTime) {
+    IsMasterAwaitArgs args;
+    ASSERT_EQ(ErrorCodes::BadValue,
+              args.initialize(BSON("isMaster" << 1 << "topologyVersion" << kTopologyVersion
+                                              << "maxAwaitTimeMS"
+                                              << "10")));
+}
+
+TEST(IsMasterAwaitArgs, RejectsMaxAwaitTimeWithoutTopologyVersion) {
+    IsMasterAwaitArgs args;
+    ASSERT_EQ(ErrorCodes::BadValue,
+              args.initialize(BSON("isMaster" << 1 << "maxAwaitTimeMS" << 10)));
+    ASSERT_EQ(ErrorCodes::BadValue,
+              args.initialize(BSON("isMaster" << 1 << "topologyVersion" << 1 << "maxAwaitTimeMS"
+                                              << 10)));
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
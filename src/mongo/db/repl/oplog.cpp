@@ -577,6 +577,13 @@ std::map<std::string, ApplyOpMetadata> opsMap = {
     {"create",
      {[](OperationContext* txn, const char* ns, BSONObj& cmd) -> Status {
           const NamespaceString nss(parseNs(ns, cmd));
+          if (txn->writesAreReplicated() && cmd["materialized"].trueValue()) {
+              // Only the create command populates a new materialized view. When replicated, its
+              // contents follow as inserts.
+              return {ErrorCodes::InvalidOptions,
+                      str::stream() << "Materialized view " << nss.ns()
+                                    << " can only be created with the create command"};
+          }
           if (auto idIndexElem = cmd["idIndex"]) {
               // Remove "idIndex" field from command.
               auto cmdWithoutIdIndex = cmd.removeField("idIndex");
@@ -1139,12 +1146,19 @@ void signalOplogWaiters() {
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(replSnapshotThreadThrottleMicros, int, 1000);
 
+// The SnapshotThread stops creating snapshots once this many are waiting for the commit point to
+// reach them, and resumes when half of them have been committed. Every named snapshot is tracked by
+// the storage engine until it is dropped, so a lower limit trades snapshot granularity for less
+// bookkeeping while the commit point lags.
+MONGO_EXPORT_SERVER_PARAMETER(replMaxUncommittedSnapshots, int, 1000);
+
 SnapshotThread::SnapshotThread(SnapshotManager* manager)
     : _manager(manager), _thread([this] { run(); }) {}
 
 bool SnapshotThread::shouldSleepMore(int numSleepsDone, size_t numUncommittedSnapshots) {
     const double kThrottleRatio = 1 / 20.0;
-    const size_t kUncommittedSnapshotLimit = 1000;
+    const size_t kUncommittedSnapshotLimit =
+        static_cast<size_t>(std::max(1, replMaxUncommittedSnapshots.load()));
     const size_t kUncommittedSnapshotRestartPoint = kUncommittedSnapshotLimit / 2;
 
     if (_inShutdown.load())
@@ -1177,6 +1191,8 @@ void SnapshotThread::run() {
     auto replCoord = ReplicationCoordinator::get(service);
 
     Timestamp lastTimestamp = {};
+    OpTime lastSnapshotOpTime;
+    SnapshotName lastSnapshotName(0);
     while (true) {
         // This block logically belongs at the end of the loop, but having it at the top
         // simplifies handling of the "continue" cases. It is harmless to do these before the
@@ -1188,6 +1204,7 @@ void SnapshotThread::run() {
             _manager->cleanupUnneededSnapshots();
         }
 
+        bool forced = false;
         {
             stdx::unique_lock<stdx::mutex> lock(newOpMutex);
             while (true) {
@@ -1196,6 +1213,7 @@ void SnapshotThread::run() {
 
                 auto clusterTime = LogicalClock::get(service)->getClusterTime().getTime();
                 if (_forcedSnapshotPending.load() || lastTimestamp != clusterTime.asTimestamp()) {
+                    forced = _forcedSnapshotPending.load();
                     _forcedSnapshotPending.store(false);
                     lastTimestamp = clusterTime.asTimestamp();
                     break;
@@ -1259,7 +1277,21 @@ void SnapshotThread::run() {
                 invariant(!opTimeOfSnapshot.isNull());
             }
 
+            // The cluster time also advances when it is gossiped to us without anything being
+            // written to our oplog. A second snapshot at the same optime is then only needed if
+            // someone reserved a snapshot name in the meantime (a catalog change, for instance),
+            // or if the previous snapshot might have been dropped.
+            if (!forced && opTimeOfSnapshot == lastSnapshotOpTime &&
+                name.asU64() == lastSnapshotName.asU64() + 1 &&
+                (replCoord->getNumUncommittedSnapshots() > 0 ||
+                 replCoord->getCurrentCommittedSnapshotOpTime() == opTimeOfSnapshot)) {
+                lastSnapshotName = name;
+                continue;
+            }
+
             replCoord->createSnapshot(txn.get(), opTimeOfSnapshot, name);
+            lastSnapshotOpTime = opTimeOfSnapshot;
+            lastSnapshotName = name;
         } catch (const WriteConflictException& wce) {
             log() << "skipping storage snapshot pass due to write conflict";
             continue;
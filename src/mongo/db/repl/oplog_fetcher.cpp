@@ -36,6 +36,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -59,6 +60,12 @@ namespace {
 Seconds kOplogInitialFindMaxTime{60};
 Seconds kOplogQueryNetworkTimeout{65};  // 5 seconds past the find command's 1 minute maxTimeMs
 
+// The batchSize sent with the find and getMore commands which tail the sync source's oplog. The
+// default is larger than the number of oplog entries which can fit in a single reply, so batches
+// are bounded only by the reply size limit rather than by the find command's default of 101
+// documents in the first batch. A value of 0 or less leaves the batch size up to the sync source.
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherBatchSize, int, BSONObjMaxUserSize);
+
 Counter64 readersCreatedStats;
 ServerStatusMetricField<Counter64> displayReadersCreated("repl.network.readersCreated",
                                                          &readersCreatedStats);
@@ -100,6 +107,10 @@ BSONObj makeFindCommandObject(DataReplicatorExternalState* dataReplicatorExterna
     cmdBob.append("oplogReplay", true);
     cmdBob.append("awaitData", true);
     cmdBob.append("maxTimeMS", durationCount<Milliseconds>(kOplogInitialFindMaxTime));
+    const int batchSize = oplogFetcherBatchSize.load();
+    if (batchSize > 0) {
+        cmdBob.append("batchSize", batchSize);
+    }
     auto opTimeWithTerm = dataReplicatorExternalState->getCurrentTermAndLastCommittedOpTime();
     if (opTimeWithTerm.value != OpTime::kUninitializedTerm) {
         cmdBob.append("term", opTimeWithTerm.value);
@@ -118,6 +129,10 @@ BSONObj makeGetMoreCommandObject(DataReplicatorExternalState* dataReplicatorExte
     cmdBob.append("getMore", cursorId);
     cmdBob.append("collection", nss.coll());
     cmdBob.append("maxTimeMS", durationCount<Milliseconds>(fetcherMaxTimeMS));
+    const int batchSize = oplogFetcherBatchSize.load();
+    if (batchSize > 0) {
+        cmdBob.append("batchSize", batchSize);
+    }
     auto opTimeWithTerm = dataReplicatorExternalState->getCurrentTermAndLastCommittedOpTime();
     if (opTimeWithTerm.value != OpTime::kUninitializedTerm) {
         cmdBob.append("term", opTimeWithTerm.value);
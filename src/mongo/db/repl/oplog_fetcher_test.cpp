@@ -347,6 +347,7 @@ void _checkDefaultCommandObjectFields(BSONObj cmdObj) {
     ASSERT_TRUE(cmdObj.getBoolField("oplogReplay"));
     ASSERT_TRUE(cmdObj.getBoolField("awaitData"));
     ASSERT_EQUALS(60000, cmdObj.getIntField("maxTimeMS"));
+    ASSERT_EQUALS(BSONObjMaxUserSize, cmdObj.getIntField("batchSize"));
 }
 
 TEST_F(
@@ -876,6 +877,7 @@ RemoteCommandRequest OplogFetcherTest::testTwoBatchHandling(bool isV1ElectionPro
     ASSERT_EQUALS(nss.coll(), request.cmdObj["collection"].String());
     ASSERT_EQUALS(int(durationCount<Milliseconds>(oplogFetcher.getAwaitDataTimeout_forTest())),
                   request.cmdObj.getIntField("maxTimeMS"));
+    ASSERT_EQUALS(BSONObjMaxUserSize, request.cmdObj.getIntField("batchSize"));
 
     ASSERT_EQUALS(2U, lastEnqueuedDocuments.size());
     ASSERT_BSONOBJ_EQ(thirdEntry, lastEnqueuedDocuments[0]);
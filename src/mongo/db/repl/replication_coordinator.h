@@ -512,6 +512,24 @@ public:
      */
     virtual void fillIsMasterForReplSet(IsMasterResponse* result) = 0;
 
+    /**
+     * Returns the version of the topology described by fillIsMasterForReplSet, in the form
+     * {processId: <OID>, counter: <long>}. The counter is incremented whenever this node's state,
+     * the replica set config or the primary it knows of changes, and the processId tells apart
+     * versions reported by different runs of this node.
+     */
+    virtual BSONObj getTopologyVersion() const = 0;
+
+    /**
+     * Blocks until the topology version differs from "knownVersion", "deadline" passes or "txn"
+     * is interrupted. Returns at once if "knownVersion" is not the current version, for example
+     * because it was reported by an earlier run of this node. Returns a non-OK status only if
+     * "txn" was interrupted.
+     */
+    virtual Status waitForTopologyChange(OperationContext* txn,
+                                         const BSONObj& knownVersion,
+                                         Date_t deadline) = 0;
+
     /**
      * Adds to "result" a description of the slaveInfo data structure used to map RIDs to their
      * last known optimes.
@@ -243,15 +243,14 @@ void ReplicationCoordinatorImpl::WaiterList::add_inlock(WaiterType waiter) {
 
 void ReplicationCoordinatorImpl::WaiterList::signalAndRemoveIf_inlock(
     stdx::function<bool(WaiterType)> func) {
-    std::vector<WaiterType>::iterator it = _list.end();
-    while (true) {
-        it = std::find_if(_list.begin(), _list.end(), func);
-        if (it == _list.end()) {
-            break;
-        }
-        (*it)->notify();
-        std::swap(*it, _list.back());
-        _list.pop_back();
+    // Evaluates 'func' exactly once per waiter, and removes the signaled waiters before notifying
+    // them.
+    auto signaledBegin = std::partition(
+        _list.begin(), _list.end(), [&func](WaiterType waiter) { return !func(waiter); });
+    std::vector<WaiterType> signaled(signaledBegin, _list.end());
+    _list.erase(signaledBegin, _list.end());
+    for (auto&& waiter : signaled) {
+        waiter->notify();
     }
 }
 
@@ -725,6 +724,7 @@ void ReplicationCoordinatorImpl::shutdown(OperationContext* txn) {
         stdx::unique_lock<stdx::mutex> lk(_mutex);
         fassert(28533, !_inShutdown);
         _inShutdown = true;
+        _topologyChange.notify_all();
         if (_rsConfigState == kConfigPreStart) {
             warning() << "ReplicationCoordinatorImpl::shutdown() called before "
                          "startup() finished.  Shutting down without cleaning up the "
@@ -957,6 +957,8 @@ void ReplicationCoordinatorImpl::signalDrainComplete(OperationContext* txn,
     invariant(_getMemberState_inlock().primary());
     invariant(!_canAcceptNonLocalWrites);
     _canAcceptNonLocalWrites = true;
+    // Primaries report themselves as secondaries to isMaster callers until they finish draining.
+    _topologyChanged_inlock();
 
     lk.unlock();
     _setFirstOpTimeOfMyTerm(_externalState->onTransitionToPrimary(txn, isV1ElectionProtocol()));
@@ -2077,6 +2079,34 @@ void ReplicationCoordinatorImpl::fillIsMasterForReplSet(IsMasterResponse* respon
     }
 }
 
+BSONObj ReplicationCoordinatorImpl::getTopologyVersion() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return BSON("processId" << _topologyProcessId << "counter" << _topologyVersionCounter);
+}
+
+Status ReplicationCoordinatorImpl::waitForTopologyChange(OperationContext* txn,
+                                                         const BSONObj& knownVersion,
+                                                         Date_t deadline) {
+    const BSONElement processId = knownVersion["processId"];
+    const BSONElement counter = knownVersion["counter"];
+    if (processId.type() != jstOID || processId.OID() != _topologyProcessId ||
+        !counter.isNumber()) {
+        return Status::OK();
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (counter.numberLong() == _topologyVersionCounter && !_inShutdown) {
+        auto swWait = txn->waitForConditionOrInterruptNoAssertUntil(_topologyChange, lk, deadline);
+        if (!swWait.isOK()) {
+            return swWait.getStatus();
+        }
+        if (swWait.getValue() == stdx::cv_status::timeout) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
 void ReplicationCoordinatorImpl::appendSlaveInfoData(BSONObjBuilder* result) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _appendSlaveInfoData_inlock(result);
@@ -2648,6 +2678,7 @@ ReplicationCoordinatorImpl::_updateMemberStateFromTopologyCoordinator_inlock() {
     // Notifies waiters blocked in waitForMemberState().
     // For testing only.
     _memberStateChange.notify_all();
+    _topologyChanged_inlock();
 
     return result;
 }
@@ -2852,6 +2883,7 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig_inlock(const ReplicaSetConfig& n
         _startHeartbeats_inlock();
     }
     _updateLastCommittedOpTime_inlock();
+    _topologyChanged_inlock();
 
     // Set election id if we're primary.
     if (oldConfig.isInitialized() && _memberState.primary()) {
@@ -2875,10 +2907,51 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig_inlock(const ReplicaSetConfig& n
     return action;
 }
 
+void ReplicationCoordinatorImpl::_topologyChanged_inlock() {
+    ++_topologyVersionCounter;
+    _topologyChange.notify_all();
+}
+
 void ReplicationCoordinatorImpl::_wakeReadyWaiters_inlock() {
-    _replicationWaiterList.signalAndRemoveIf_inlock([this](WaiterInfo* waiter) {
-        return _doneWaitingForReplication_inlock(
-            waiter->opTime, SnapshotName::min(), *waiter->writeConcern);
+    // Whether a write concern is satisfied is monotonic in the optime waited for. So within one
+    // pass, the answers for earlier waiters with the same write concern decide most of the later
+    // ones by an optime comparison alone, and the full check only runs for the few optimes that
+    // fall between the highest one known to be satisfied and the lowest one known not to be.
+    struct Bounds {
+        const WriteConcernOptions* writeConcern;
+        boost::optional<OpTime> satisfied;
+        boost::optional<OpTime> unsatisfied;
+    };
+    std::vector<Bounds> boundsByWriteConcern;
+
+    _replicationWaiterList.signalAndRemoveIf_inlock([&](WaiterInfo* waiter) {
+        const WriteConcernOptions& writeConcern = *waiter->writeConcern;
+        auto bounds = std::find_if(
+            boundsByWriteConcern.begin(), boundsByWriteConcern.end(), [&](const Bounds& b) {
+                return b.writeConcern->wNumNodes == writeConcern.wNumNodes &&
+                    b.writeConcern->wMode == writeConcern.wMode &&
+                    b.writeConcern->syncMode == writeConcern.syncMode;
+            });
+        if (bounds == boundsByWriteConcern.end()) {
+            bounds = boundsByWriteConcern.insert(boundsByWriteConcern.end(),
+                                                 Bounds{&writeConcern, boost::none, boost::none});
+        }
+
+        if (bounds->satisfied && waiter->opTime <= *bounds->satisfied) {
+            return true;
+        }
+        if (bounds->unsatisfied && waiter->opTime >= *bounds->unsatisfied) {
+            return false;
+        }
+
+        const bool done =
+            _doneWaitingForReplication_inlock(waiter->opTime, SnapshotName::min(), writeConcern);
+        if (done) {
+            bounds->satisfied = waiter->opTime;
+        } else {
+            bounds->unsatisfied = waiter->opTime;
+        }
+        return done;
     });
 }
 
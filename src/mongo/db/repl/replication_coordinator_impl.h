@@ -193,6 +193,12 @@ public:
 
     virtual void fillIsMasterForReplSet(IsMasterResponse* result) override;
 
+    virtual BSONObj getTopologyVersion() const override;
+
+    virtual Status waitForTopologyChange(OperationContext* txn,
+                                         const BSONObj& knownVersion,
+                                         Date_t deadline) override;
+
     virtual void appendSlaveInfoData(BSONObjBuilder* result) override;
 
     virtual ReplicaSetConfig getConfig() const override;
@@ -486,7 +492,8 @@ private:
         void add_inlock(WaiterType waiter);
         // Returns whether waiter is found and removed.
         bool remove_inlock(WaiterType waiter);
-        // Signals and removes all waiters that satisfy the condition.
+        // Signals and removes all waiters that satisfy the condition, in a single pass over the
+        // list.
         void signalAndRemoveIf_inlock(stdx::function<bool(WaiterType)> fun);
         // Signals and removes all waiters from the list.
         void signalAndRemoveAll_inlock();
@@ -605,6 +612,11 @@ private:
      */
     void _wakeReadyWaiters_inlock();
 
+    /**
+     * Advances the topology version and wakes up the isMaster callers waiting for it to change.
+     */
+    void _topologyChanged_inlock();
+
     /**
      * Scheduled to cause the ReplicationCoordinator to reconsider any state that might
      * need to change as a result of time passing - for instance becoming PRIMARY when a single
@@ -1250,6 +1262,13 @@ private:
     // Used to signal threads waiting for changes to _memberState.
     stdx::condition_variable _memberStateChange;  // (M)
 
+    // Identifies this run of the node in the topology versions handed out to isMaster callers.
+    const OID _topologyProcessId = OID::gen();  // (S)
+
+    // Incremented, and _topologyChange signaled, whenever an isMaster reply may have changed.
+    long long _topologyVersionCounter = 0;  // (M)
+    stdx::condition_variable _topologyChange;  // (M)
+
     // Current ReplicaSet state.
     MemberState _memberState;  // (MX)
 
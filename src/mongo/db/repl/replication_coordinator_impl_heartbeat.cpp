@@ -210,8 +210,14 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
         hbStatusResponse = StatusWith<ReplSetHeartbeatResponse>(responseStatus);
     }
 
+    const int oldPrimaryIndex = _topCoord->getCurrentPrimaryIndex();
     HeartbeatResponseAction action = _topCoord->processHeartbeatResponse(
         now, networkTime, target, hbStatusResponse, lastApplied);
+    if (_topCoord->getCurrentPrimaryIndex() != oldPrimaryIndex) {
+        // The primary named in our isMaster replies changed.
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _topologyChanged_inlock();
+    }
 
     if (action.getAction() == HeartbeatResponseAction::NoAction && hbStatusResponse.isOK() &&
         targetIndex >= 0 && hbStatusResponse.getValue().hasState() &&
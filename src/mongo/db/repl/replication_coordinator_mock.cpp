@@ -265,6 +265,16 @@ void ReplicationCoordinatorMock::fillIsMasterForReplSet(IsMasterResponse* result
     result->setElectionId(OID::gen());
 }
 
+BSONObj ReplicationCoordinatorMock::getTopologyVersion() const {
+    return BSON("processId" << OID() << "counter" << 0LL);
+}
+
+Status ReplicationCoordinatorMock::waitForTopologyChange(OperationContext* txn,
+                                                         const BSONObj& knownVersion,
+                                                         Date_t deadline) {
+    return Status::OK();
+}
+
 void ReplicationCoordinatorMock::appendSlaveInfoData(BSONObjBuilder* result) {}
 
 void ReplicationCoordinatorMock::appendConnectionStats(executor::ConnectionPoolStats* stats) const {
@@ -145,6 +145,12 @@ public:
 
     virtual void fillIsMasterForReplSet(IsMasterResponse* result);
 
+    virtual BSONObj getTopologyVersion() const override;
+
+    virtual Status waitForTopologyChange(OperationContext* txn,
+                                         const BSONObj& knownVersion,
+                                         Date_t deadline) override;
+
     virtual void appendSlaveInfoData(BSONObjBuilder* result);
 
     void appendConnectionStats(executor::ConnectionPoolStats* stats) const override;
@@ -42,6 +42,7 @@
 #include "mongo/db/lasterror.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/repl/is_master_await_args.h"
 #include "mongo/db/repl/is_master_response.h"
 #include "mongo/db/repl/master_slave.h"
 #include "mongo/db/repl/oplog.h"
@@ -216,7 +217,11 @@ public:
     virtual void help(stringstream& help) const {
         help << "Check if this server is primary for a replica pair/set; also if it is --master or "
                 "--slave in simple master/slave setups.\n";
-        help << "{ isMaster : 1 }";
+        help << "{ isMaster : 1 }\n";
+        help << "Replica set members also accept { isMaster : 1, topologyVersion : <from an "
+                "earlier reply>, maxAwaitTimeMS : <ms> }, which replies as soon as the topology "
+                "differs from the one described by topologyVersion, or after maxAwaitTimeMS (at "
+                "most 5 minutes).";
     }
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
         return false;
@@ -277,8 +282,40 @@ public:
                 txn->getClient(), std::move(swParseClientMetadata.getValue()));
         }
 
+        ReplicationCoordinator* replCoord = getGlobalReplicationCoordinator();
+        const bool usingReplSets = replCoord->getSettings().usingReplSets();
+
+        IsMasterAwaitArgs awaitArgs;
+        Status awaitArgsStatus = awaitArgs.initialize(cmdObj);
+        if (!awaitArgsStatus.isOK()) {
+            return Command::appendCommandStatus(result, awaitArgsStatus);
+        }
+
+        // Nodes that are not replica set members do not report a topologyVersion, so the callers
+        // have nothing to wait for.
+        if (awaitArgs.isAwaitable() && usingReplSets) {
+            auto waitStatus =
+                replCoord->waitForTopologyChange(txn,
+                                                 awaitArgs.getTopologyVersion(),
+                                                 Date_t::now() + awaitArgs.getMaxAwaitTime());
+            if (!waitStatus.isOK()) {
+                return Command::appendCommandStatus(result, waitStatus);
+            }
+        }
+
+        // Read the version before the topology it describes, so that a change racing with this
+        // reply can only make the version look older than it is.
+        BSONObj topologyVersion;
+        if (usingReplSets) {
+            topologyVersion = replCoord->getTopologyVersion();
+        }
+
         appendReplicationInfo(txn, result, 0);
 
+        if (usingReplSets) {
+            result.append("topologyVersion", topologyVersion);
+        }
+
         if (serverGlobalParams.clusterRole == ClusterRole::ConfigServer) {
             // If we have feature compatibility version 3.4, use a config server mode that 3.2
             // mongos won't understand. This should prevent a 3.2 mongos from joining the cluster or
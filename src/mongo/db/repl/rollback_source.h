@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/jsobj.h"
@@ -73,6 +75,23 @@ public:
      */
     virtual BSONObj findOne(const NamespaceString& nss, const BSONObj& filter) const = 0;
 
+    /**
+     * Fetches the documents with the given _id values from the sync source. Documents that no
+     * longer exist there are left out of the result, which is in no particular order.
+     * The default implementation issues one findOne per _id.
+     */
+    virtual std::vector<BSONObj> findByIds(const NamespaceString& nss,
+                                           const std::vector<BSONElement>& ids) const {
+        std::vector<BSONObj> docs;
+        for (auto&& id : ids) {
+            BSONObj doc = findOne(nss, id.wrap());
+            if (!doc.isEmpty()) {
+                docs.push_back(doc);
+            }
+        }
+        return docs;
+    }
+
     /**
      * Clones a single collection from the sync source.
      */
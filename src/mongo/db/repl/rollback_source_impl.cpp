@@ -68,6 +68,31 @@ BSONObj RollbackSourceImpl::findOne(const NamespaceString& nss, const BSONObj& f
     return _getConnection()->findOne(nss.toString(), filter, NULL, QueryOption_SlaveOk).getOwned();
 }
 
+std::vector<BSONObj> RollbackSourceImpl::findByIds(const NamespaceString& nss,
+                                                   const std::vector<BSONElement>& ids) const {
+    BSONObjBuilder filter;
+    {
+        BSONObjBuilder idBuilder(filter.subobjStart("_id"));
+        BSONArrayBuilder in(idBuilder.subarrayStart("$in"));
+        for (auto&& id : ids) {
+            in.append(id);
+        }
+    }
+
+    std::vector<BSONObj> docs;
+    docs.reserve(ids.size());
+    auto cursor =
+        _getConnection()->query(nss.toString(), filter.obj(), 0, 0, NULL, QueryOption_SlaveOk);
+    uassert(40413,
+            str::stream() << "rollback failed to query " << nss.ns() << " on sync source "
+                          << _source.toString(),
+            cursor);
+    while (cursor->more()) {
+        docs.push_back(cursor->nextSafe().getOwned());
+    }
+    return docs;
+}
+
 void RollbackSourceImpl::copyCollectionFromRemote(OperationContext* txn,
                                                   const NamespaceString& nss) const {
     std::string errmsg;
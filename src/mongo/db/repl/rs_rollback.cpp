@@ -45,6 +45,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/repl/rollback_source.h"
 #include "mongo/db/repl/rslog.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -126,6 +128,23 @@ MONGO_FP_DECLARE(rollbackHangThenFailAfterWritingMinValid);
 
 using namespace rollback_internal;
 
+namespace {
+
+// The most _id values rollback asks the sync source for in a single query when refetching the
+// documents it has to roll back. Batches are also cut short once their _id values add up to
+// kRefetchBatchMaxBytes, so that the query stays well below the maximum BSON object size.
+MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchBatchSize, int, 1000);
+const int kRefetchBatchMaxBytes = 4 * 1024 * 1024;
+
+Counter64 refetchedDocsStats;
+ServerStatusMetricField<Counter64> displayRefetchedDocs("repl.rollback.refetch.docs",
+                                                        &refetchedDocsStats);
+Counter64 refetchBatchesStats;
+ServerStatusMetricField<Counter64> displayRefetchBatches("repl.rollback.refetch.batches",
+                                                         &refetchBatchesStats);
+
+}  // namespace
+
 bool DocID::operator<(const DocID& other) const {
     int comp = strcmp(ns, other.ns);
     if (comp < 0)
@@ -384,22 +403,45 @@ void syncFixUp(OperationContext* txn,
     // namespace -> doc id -> doc
     map<string, map<DocID, BSONObj>> goodVersions;
 
-    // fetch all the goodVersions of each document from current primary
+    // fetch all the goodVersions of each document from current primary, in batches of _id values
+    // that share a collection. docsToRefetch is ordered by namespace first.
+    const int batchSize = std::max(1, rollbackRefetchBatchSize.load());
     unsigned long long numFetched = 0;
-    for (auto&& doc : fixUpInfo.docsToRefetch) {
-        invariant(!doc._id.eoo());  // This is checked when we insert to the set.
+    auto docIt = fixUpInfo.docsToRefetch.begin();
+    while (docIt != fixUpInfo.docsToRefetch.end()) {
+        const char* ns = docIt->ns;
+        map<DocID, BSONObj> batch;
+        std::vector<BSONElement> ids;
+        int idBytes = 0;
+        for (; docIt != fixUpInfo.docsToRefetch.end() && strcmp(docIt->ns, ns) == 0 &&
+             static_cast<int>(ids.size()) < batchSize && idBytes < kRefetchBatchMaxBytes;
+             ++docIt) {
+            invariant(!docIt->_id.eoo());  // This is checked when we insert to the set.
+            ids.push_back(docIt->_id);
+            idBytes += docIt->_id.size();
+            // An empty document means it no longer exists on the sync source, so we should delete
+            // it, unless it is found below.
+            batch[*docIt] = BSONObj();
+        }
 
         try {
-            // TODO : slow.  lots of round trips.
-            numFetched++;
-            BSONObj good = rollbackSource.findOne(NamespaceString(doc.ns), doc._id.wrap());
-            totalSize += good.objsize();
-            if (totalSize >= 300 * 1024 * 1024) {
-                throw RSFatalException("replSet too much data to roll back");
+            std::vector<BSONObj> docs = rollbackSource.findByIds(NamespaceString(ns), ids);
+            numFetched += ids.size();
+            refetchedDocsStats.increment(ids.size());
+            refetchBatchesStats.increment();
+            for (auto&& good : docs) {
+                // Documents whose _id only matches one of ours under the collection's collation
+                // are not found here and are ignored.
+                auto found = batch.find(DocID{good, ns, good["_id"]});
+                if (found == batch.end()) {
+                    continue;
+                }
+                totalSize += good.objsize();
+                if (totalSize >= 300 * 1024 * 1024) {
+                    throw RSFatalException("replSet too much data to roll back");
+                }
+                found->second = good;
             }
-
-            // Note good might be empty, indicating we should delete it.
-            goodVersions[doc.ns][doc] = good;
         } catch (const DBException& ex) {
             // If the collection turned into a view, we might get an error trying to
             // refetch documents, but these errors should be ignored, as we'll be creating
@@ -407,11 +449,15 @@ void syncFixUp(OperationContext* txn,
             if (ex.getCode() == ErrorCodes::CommandNotSupportedOnView)
                 continue;
 
-            log() << "rollback couldn't re-get from ns: " << doc.ns << " _id: " << redact(doc._id)
+            log() << "rollback couldn't re-get " << ids.size() << " documents from ns: " << ns
                   << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
                   << redact(ex);
             throw;
         }
+
+        goodVersions[ns].insert(batch.begin(), batch.end());
+        log() << "rollback refetched " << numFetched << '/' << fixUpInfo.docsToRefetch.size()
+              << " documents";
     }
 
     log() << "rollback 3.5";
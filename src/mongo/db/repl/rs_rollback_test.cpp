@@ -371,6 +371,57 @@ TEST_F(RSRollbackTest, RollbackDeleteRestoreDocument) {
     ASSERT_EQUALS(1, _testRollbackDelete(_txn.get(), _coordinator, doc));
 }
 
+TEST_F(RSRollbackTest, RollbackRefetchesDocumentsOfACollectionInOneBatch) {
+    createOplog(_txn.get());
+    _createCollection(_txn.get(), "test.t", CollectionOptions());
+    auto commonOperation =
+        std::make_pair(BSON("ts" << Timestamp(Seconds(1), 0) << "h" << 1LL), RecordId(1));
+    auto makeDeleteOperation = [](int id) {
+        return std::make_pair(BSON("ts" << Timestamp(Seconds(2 + id), 0) << "h" << 1LL << "op"
+                                        << "d"
+                                        << "ns"
+                                        << "test.t"
+                                        << "o"
+                                        << BSON("_id" << id)),
+                              RecordId(2 + id));
+    };
+    class RollbackSourceLocal : public RollbackSourceMock {
+    public:
+        using RollbackSourceMock::RollbackSourceMock;
+        BSONObj findOne(const NamespaceString& nss, const BSONObj& filter) const override {
+            FAIL("documents should be refetched in batches");
+            return BSONObj();
+        }
+        std::vector<BSONObj> findByIds(const NamespaceString& nss,
+                                       const std::vector<BSONElement>& ids) const override {
+            batchSizes.push_back(ids.size());
+            // Only the document with _id 1 still exists on the sync source.
+            return {BSON("_id" << 1 << "a" << 1)};
+        }
+        mutable std::vector<size_t> batchSizes;
+    };
+    RollbackSourceLocal rollbackSource(std::unique_ptr<OplogInterface>(new OplogInterfaceMock({
+        commonOperation,
+    })));
+    ASSERT_OK(syncRollback(_txn.get(),
+                           OplogInterfaceMock({makeDeleteOperation(2),
+                                               makeDeleteOperation(1),
+                                               makeDeleteOperation(0),
+                                               commonOperation}),
+                           rollbackSource,
+                           {},
+                           _coordinator));
+    ASSERT_EQUALS(1U, rollbackSource.batchSizes.size());
+    ASSERT_EQUALS(3U, rollbackSource.batchSizes.front());
+
+    AutoGetCollectionForRead acr(_txn.get(), NamespaceString("test.t"));
+    ASSERT_TRUE(acr.getCollection());
+    ASSERT_EQUALS(1LL, acr.getCollection()->numRecords(_txn.get()));
+    BSONObj result;
+    ASSERT(Helpers::findOne(_txn.get(), acr.getCollection(), BSON("_id" << 1), result));
+    ASSERT_EQUALS(1, result["a"].numberInt()) << result;
+}
+
 TEST_F(RSRollbackTest, RollbackInsertDocumentWithNoId) {
     createOplog(_txn.get());
     auto commonOperation =
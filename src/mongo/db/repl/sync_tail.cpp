@@ -35,6 +35,7 @@
 
 #include "third_party/murmurhash3/MurmurHash3.h"
 #include <boost/functional/hash.hpp>
+#include <deque>
 #include <memory>
 
 #include "mongo/base/counter.h"
@@ -68,6 +69,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -133,6 +135,42 @@ public:
     }
 } exportedBatchLimitOperationsParam;
 
+// Upper bound on the memory used by the batches which the OpQueueBatcher has parsed and made ready
+// for the applier. Allowing more than one ready batch lets fetching and parsing of the next batches
+// overlap with applying the current one. A single batch is always allowed, whatever its size, so
+// 0 keeps at most one ready batch.
+AtomicInt32 replBatchPipelineLimitBytes{200 * 1024 * 1024};
+
+class ExportedBatchPipelineLimitBytesParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedBatchPipelineLimitBytesParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "replBatchPipelineLimitBytes",
+              &replBatchPipelineLimitBytes) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < 0) {
+            return Status(ErrorCodes::BadValue, "replBatchPipelineLimitBytes must be at least 0");
+        }
+
+        return Status::OK();
+    }
+} exportedBatchPipelineLimitBytesParam;
+
+// Whether to prefetch the index entries and documents a batch touches before applying it when the
+// storage engine supports document-level locking. MMAPv1 always prefetches. For other engines the
+// prefetch pass only pays off when the data usually has to be read from disk, since it warms the
+// engine's cache from all the worker threads before the writers need it.
+MONGO_EXPORT_SERVER_PARAMETER(replPrefetchWithDocLocking, bool, false);
+
+// Limits on how many consecutive inserts into the same collection a writer thread groups into a
+// single insertDocuments call, and on the combined size of their documents. The grouped op is
+// itself a BSON object, so its size is also capped below the maximum user object size.
+MONGO_EXPORT_SERVER_PARAMETER(replInsertGroupLimitOperations, int, 64);
+MONGO_EXPORT_SERVER_PARAMETER(replInsertGroupLimitBytes, int, insertVectorMaxBytes);
+
 // The oplog entries applied
 Counter64 opsAppliedStats;
 ServerStatusMetricField<Counter64> displayOpsApplied("repl.apply.ops", &opsAppliedStats);
@@ -290,10 +328,12 @@ Status SyncTail::syncApply(OperationContext* txn,
     // Count each log op application as a separate operation, for reporting purposes
     CurOp individualOp(txn);
 
-    const char* ns = op.getStringField("ns");
-    verify(ns);
-
-    const char* opType = op["op"].valuestrsafe();
+    // Look up both fields in a single pass over the op, as this runs for every op applied.
+    const char* names[] = {"ns", "op"};
+    BSONElement fields[2];
+    op.getFields(2, names, fields);
+    const char* ns = fields[0].type() == String ? fields[0].valuestr() : "";
+    const char* opType = fields[1].valuestrsafe();
 
     bool isCommand(opType[0] == 'c');
     bool isNoOp(opType[0] == 'n');
@@ -481,6 +521,7 @@ void scheduleWritesToOplog(OperationContext* txn,
             const auto txnHolder = cc().makeOperationContext();
             const auto txn = txnHolder.get();
             txn->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+            txn->lockState()->setShouldAcquireTicket(false);
             txn->setReplicatedWrites(false);
 
             std::vector<BSONObj> docs;
@@ -571,6 +612,29 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Returns the index of the writer which has been given the fewest operations so far.
+ */
+uint32_t leastLoadedWriter(const std::vector<MultiApplier::OperationPtrs>& writerVectors) {
+    uint32_t leastLoaded = 0;
+    for (uint32_t i = 1; i < writerVectors.size(); ++i) {
+        if (writerVectors[i].size() < writerVectors[leastLoaded].size()) {
+            leastLoaded = i;
+        }
+    }
+    return leastLoaded;
+}
+
+// Distributes the ops of a batch over the writers. Ops which may conflict with each other share a
+// conflict key: the namespace, plus the _id of the document for CRUD ops when documents of the
+// collection can be written independently. All ops with the same conflict key go to the same
+// writer, in batch order, and every new conflict key is given to the writer with the fewest ops so
+// far. This keeps the whole pool busy when a batch is dominated by a single collection, instead of
+// relying on the hash of unrelated keys to spread evenly.
+//
+// Conflicts through unique secondary indexes do not need to be tracked, since index constraints are
+// relaxed while applying oplog entries on secondaries.
+//
 // This only modifies the isForCappedCollection field on each op. It does not alter the ops vector
 // in any other way.
 void fillWriterVectors(OperationContext* txn,
@@ -578,9 +642,9 @@ void fillWriterVectors(OperationContext* txn,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors) {
     const bool supportsDocLocking =
         getGlobalServiceContext()->getGlobalStorageEngine()->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
+    stdx::unordered_map<uint32_t, uint32_t> writerForConflictKey;
 
     for (auto&& op : *ops) {
         StringMapTraits::HashedKey hashedNs(op.ns);
@@ -609,7 +673,12 @@ void fillWriterVectors(OperationContext* txn,
             }
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
+        auto it = writerForConflictKey.find(hash);
+        if (it == writerForConflictKey.end()) {
+            it = writerForConflictKey.emplace(hash, leastLoadedWriter(*writerVectors)).first;
+        }
+
+        auto& writer = (*writerVectors)[it->second];
         if (writer.empty())
             writer.reserve(8);  // skip a few growth rounds.
         writer.push_back(&op);
@@ -681,20 +750,33 @@ public:
 
     OpQueue getNextBatch(Seconds maxWaitTime) {
         stdx::unique_lock<stdx::mutex> lk(_mutex);
-        if (_ops.empty() && !_ops.mustShutdown()) {
+        if (_readyBatches.empty()) {
             // We intentionally don't care about whether this returns due to signaling or timeout
-            // since we do the same thing either way: return whatever is in _ops.
+            // since we do the same thing either way: return the first ready batch, if any.
             (void)_cv.wait_for(lk, maxWaitTime.toSystemDuration());
         }
 
-        OpQueue ops = std::move(_ops);
-        _ops = {};
+        if (_readyBatches.empty()) {
+            return {};
+        }
+
+        OpQueue ops = std::move(_readyBatches.front());
+        _readyBatches.pop_front();
+        _readyBytes -= memoryUsage(ops);
         _cv.notify_all();
 
         return ops;
     }
 
 private:
+    /**
+     * Approximates the memory held by a parsed batch: the raw BSON of its entries plus the parsed
+     * OplogEntry objects.
+     */
+    static size_t memoryUsage(const OpQueue& ops) {
+        return ops.getBytes() + ops.getCount() * sizeof(OplogEntry);
+    }
+
     void run() {
         Client::initThread("ReplBatcher");
         const ServiceContext::UniqueOperationContext txnPtr = cc().makeOperationContext();
@@ -727,12 +809,19 @@ private:
                 continue;  // Don't emit empty batches.
             }
 
+            const size_t batchBytes = memoryUsage(ops);
+            const bool mustShutdown = ops.mustShutdown();
+
             stdx::unique_lock<stdx::mutex> lk(_mutex);
-            // Block until the previous batch has been taken.
-            _cv.wait(lk, [&] { return _ops.empty(); });
-            _ops = std::move(ops);
+            // Block until the ready batches leave room for this one.
+            _cv.wait(lk, [&] {
+                return _readyBatches.empty() ||
+                    _readyBytes + batchBytes <= size_t(replBatchPipelineLimitBytes.load());
+            });
+            _readyBatches.push_back(std::move(ops));
+            _readyBytes += batchBytes;
             _cv.notify_all();
-            if (_ops.mustShutdown()) {
+            if (mustShutdown) {
                 _isDead = true;
                 return;
             }
@@ -741,9 +830,12 @@ private:
 
     SyncTail* const _syncTail;
 
-    stdx::mutex _mutex;  // Guards _ops.
+    stdx::mutex _mutex;  // Guards _readyBatches and _readyBytes.
     stdx::condition_variable _cv;
-    OpQueue _ops;
+
+    // Batches which are ready to be applied, in oplog order, and their total memory usage.
+    std::deque<OpQueue> _readyBatches;
+    size_t _readyBytes = 0;
 
     // This only exists so the destructor invariants rather than deadlocking.
     // TODO remove once we trust noexcept enough to mark oplogApplication() as noexcept.
@@ -1068,6 +1160,10 @@ Status multiSyncApply_noAbort(OperationContext* txn,
     // allow us to get through the magic barrier
     txn->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
+    // Oplog application must not queue behind throttled user reads and writes, since those may
+    // themselves be waiting on replication to make progress.
+    txn->lockState()->setShouldAcquireTicket(false);
+
     if (oplogEntryPointers->size() > 1) {
         std::stable_sort(oplogEntryPointers->begin(),
                          oplogEntryPointers->end(),
@@ -1088,8 +1184,10 @@ Status multiSyncApply_noAbort(OperationContext* txn,
         if (entry->opType[0] == 'i' && !entry->isForCappedCollection &&
             oplogEntriesIterator > doNotGroupBeforePoint) {
             // Attempt to group inserts if possible.
-            std::vector<BSONObj> toInsert;
-            int batchSize = 0;
+            const int maxBatchSize =
+                std::min(replInsertGroupLimitBytes.load(), BSONObjMaxUserSize / 2);
+            const int maxBatchCount = replInsertGroupLimitOperations.load();
+            int batchSize = entry->o.Obj().objsize();
             int batchCount = 0;
             auto endOfGroupableOpsIterator = std::find_if(
                 oplogEntriesIterator + 1,
@@ -1098,8 +1196,8 @@ Status multiSyncApply_noAbort(OperationContext* txn,
                     return nextEntry->opType[0] != 'i' ||  // Must be an insert.
                         nextEntry->ns != entry->ns ||      // Must be the same namespace.
                         // Must not create too large an object.
-                        (batchSize += nextEntry->o.Obj().objsize()) > insertVectorMaxBytes ||
-                        ++batchCount >= 64;  // Or have too many entries.
+                        (batchSize += nextEntry->o.Obj().objsize()) > maxBatchSize ||
+                        ++batchCount >= maxBatchCount;  // Or have too many entries.
                 });
 
             if (endOfGroupableOpsIterator != oplogEntriesIterator + 1) {
@@ -1188,6 +1286,10 @@ Status multiInitialSyncApply_noAbort(OperationContext* txn,
     // allow us to get through the magic barrier
     txn->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
+    // Oplog application must not queue behind throttled user reads and writes, since those may
+    // themselves be waiting on replication to make progress.
+    txn->lockState()->setShouldAcquireTicket(false);
+
     // This function is only called in initial sync, as its name suggests.
     const bool inSteadyStateReplication = false;
 
@@ -1254,7 +1356,8 @@ StatusWith<OpTime> multiApply(OperationContext* txn,
         return {ErrorCodes::BadValue, "invalid apply operation function"};
     }
 
-    if (getGlobalServiceContext()->getGlobalStorageEngine()->isMmapV1()) {
+    if (getGlobalServiceContext()->getGlobalStorageEngine()->isMmapV1() ||
+        replPrefetchWithDocLocking.load()) {
         // Use a ThreadPool to prefetch all the operations in a batch.
         prefetchOps(ops, workerPool);
     }
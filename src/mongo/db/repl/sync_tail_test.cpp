@@ -54,11 +54,13 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/repl/sync_tail.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/old_thread_pool.h"
 #include "mongo/util/md5.hpp"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/string_map.h"
 
 namespace {
@@ -603,6 +605,47 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_BSONOBJ_EQ(op2.raw, operationsWrittenToOplog[1]);
 }
 
+TEST_F(SyncTailTest, MultiApplyBalancesIndependentOperationsAcrossWriterThreads) {
+    // Four namespaces and four writers: as long as ops for different namespaces do not conflict,
+    // every writer thread should be given the ops of exactly one namespace, regardless of how the
+    // namespaces hash.
+    const size_t numWriters = 4;
+    OldThreadPool writerPool(numWriters);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn = [&mutex, &operationsApplied](
+        MultiApplier::OperationPtrs* operationsForWriterThreadToApply) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    MultiApplier::Operations ops;
+    for (int i = 0; i < 8; ++i) {
+        NamespaceString nss(str::stream() << "test.t" << (i % numWriters));
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(i + 1), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    auto lastOpTime =
+        unittest::assertGet(multiApply(_txn.get(), &writerPool, ops, applyOperationFn));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    ASSERT_EQUALS(numWriters, operationsApplied.size());
+    for (auto&& operationsAppliedByThread : operationsApplied) {
+        // Ops which conflict stay together, in their original order.
+        ASSERT_EQUALS(2U, operationsAppliedByThread.size());
+        ASSERT_EQUALS(operationsAppliedByThread[0].ns, operationsAppliedByThread[1].ns);
+        ASSERT_LESS_THAN(operationsAppliedByThread[0].getOpTime(),
+                         operationsAppliedByThread[1].getOpTime());
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -783,6 +826,49 @@ TEST_F(SyncTailTest, MultiSyncApplyUsesLimitWhenGroupingInsertOperation) {
     ASSERT_EQUALS(insertOps.back(), operationsApplied[2]);
 }
 
+TEST_F(SyncTailTest, MultiSyncApplyUsesConfiguredLimitWhenGroupingInsertOperations) {
+    auto setGroupLimit = [](const std::string& limit) {
+        auto parameter =
+            ServerParameterSet::getGlobal()->getMap().find("replInsertGroupLimitOperations");
+        invariant(parameter != ServerParameterSet::getGlobal()->getMap().end());
+        return parameter->second->setFromString(limit);
+    };
+    ASSERT_OK(setGroupLimit("3"));
+    ON_BLOCK_EXIT([&] { invariantOK(setGroupLimit("64")); });
+
+    int seconds = 0;
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName() + "_1");
+    auto createOp = makeCreateCollectionOplogEntry({Timestamp(Seconds(seconds++), 0), 1LL}, nss);
+
+    // {create}, {insert_1}, .. {insert_7}
+    MultiApplier::Operations operationsToApply;
+    operationsToApply.push_back(createOp);
+    for (int i = 0; i < 7; ++i) {
+        operationsToApply.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(seconds), 0), 1LL}, nss, BSON("_id" << seconds++)));
+    }
+    MultiApplier::Operations operationsApplied;
+    auto syncApply = [&operationsApplied](OperationContext*, const BSONObj& op, bool) {
+        operationsApplied.push_back(OplogEntry(op));
+        return Status::OK();
+    };
+
+    MultiApplier::OperationPtrs ops;
+    for (auto&& op : operationsToApply) {
+        ops.push_back(&op);
+    }
+    ASSERT_OK(multiSyncApply_noAbort(_txn.get(), &ops, syncApply));
+
+    // {create}, {insert_1, insert_2, insert_3}, {insert_4, insert_5, insert_6}, {insert_7}
+    ASSERT_EQUALS(4U, operationsApplied.size());
+    ASSERT_EQUALS(createOp, operationsApplied[0]);
+    ASSERT_EQUALS(BSONType::Array, operationsApplied[1].o.type());
+    ASSERT_EQUALS(3U, operationsApplied[1].o.Array().size());
+    ASSERT_EQUALS(BSONType::Array, operationsApplied[2].o.type());
+    ASSERT_EQUALS(3U, operationsApplied[2].o.Array().size());
+    ASSERT_EQUALS(operationsToApply.back(), operationsApplied[3]);
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyFallsBackOnApplyingInsertsIndividuallyWhenGroupedInsertFails) {
     int seconds = 0;
     auto makeOp = [&seconds](const NamespaceString& nss) {
@@ -482,6 +482,11 @@ public:
      */
     virtual void setPrimaryIndex(long long primaryIndex) = 0;
 
+    /**
+     * Returns the index in the config of the member this node believes to be primary, or -1.
+     */
+    virtual int getCurrentPrimaryIndex() const = 0;
+
     /**
      * Transitions to the candidate role if the node is electable.
      */
@@ -67,6 +67,12 @@ const Seconds TopologyCoordinatorImpl::VoteLease::leaseTime = Seconds(30);
 // must be before it will call for a priority takeover election.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(priorityTakeoverFreshnessWindowSeconds, int, 2);
 
+// Sync source candidates whose ping times are within this many milliseconds of each other are
+// considered equally close, and the one that fewer members already sync from is chosen. This keeps
+// secondaries that see similar ping times from all piling onto the same source. 0 always picks the
+// candidate with the lowest ping time.
+MONGO_EXPORT_SERVER_PARAMETER(syncSourcePingToleranceMillis, int, 0);
+
 // If this fail point is enabled, TopologyCoordinatorImpl::shouldChangeSyncSource() will ignore
 // the option TopologyCoordinatorImpl::Options::maxSyncSourceLagSecs. The sync source will not be
 // re-evaluated if it lags behind another node by more than 'maxSyncSourceLagSecs' seconds.
@@ -321,11 +327,13 @@ HostAndPort TopologyCoordinatorImpl::chooseNewSyncSource(Date_t now,
                        << it->getAppliedOpTime().toBSON();
                 continue;
             }
-            // Candidate cannot be more latent than anything we've already considered.
+            // Candidate cannot be more latent, or similarly latent but more heavily loaded, than
+            // anything we've already considered.
             if ((closestIndex != -1) &&
-                (_getPing(itMemberConfig.getHostAndPort()) >
-                 _getPing(_rsConfig.getMemberAt(closestIndex).getHostAndPort()))) {
-                LOG(2) << "Cannot select sync source with higher latency than the best candidate: "
+                !_isPreferableSyncSource(itMemberConfig.getHostAndPort(),
+                                         _rsConfig.getMemberAt(closestIndex).getHostAndPort())) {
+                LOG(2) << "Cannot select sync source with higher latency or load than the best "
+                          "candidate: "
                        << itMemberConfig.getHostAndPort();
 
                 continue;
@@ -2181,6 +2189,34 @@ Milliseconds TopologyCoordinatorImpl::_getPing(const HostAndPort& host) {
     return _pings[host].getMillis();
 }
 
+int TopologyCoordinatorImpl::_getNumMembersSyncingFrom(const HostAndPort& host) const {
+    int numMembers = 0;
+    for (std::vector<MemberHeartbeatData>::const_iterator it = _hbdata.begin(); it != _hbdata.end();
+         ++it) {
+        if (indexOfIterator(_hbdata, it) != _selfIndex && it->up() &&
+            it->getSyncSource() == host) {
+            ++numMembers;
+        }
+    }
+    return numMembers;
+}
+
+bool TopologyCoordinatorImpl::_isPreferableSyncSource(const HostAndPort& candidate,
+                                                      const HostAndPort& best) {
+    const Milliseconds candidatePing = _getPing(candidate);
+    const Milliseconds bestPing = _getPing(best);
+    const Milliseconds tolerance(syncSourcePingToleranceMillis.load());
+    if (tolerance > Milliseconds(0) && candidatePing <= bestPing + tolerance &&
+        bestPing <= candidatePing + tolerance) {
+        const int candidateLoad = _getNumMembersSyncingFrom(candidate);
+        const int bestLoad = _getNumMembersSyncingFrom(best);
+        if (candidateLoad != bestLoad) {
+            return candidateLoad < bestLoad;
+        }
+    }
+    return candidatePing <= bestPing;
+}
+
 void TopologyCoordinatorImpl::_setElectionTime(const Timestamp& newElectionTime) {
     _electionTime = newElectionTime;
 }
@@ -237,6 +237,7 @@ public:
     virtual void voteForMyselfV1();
     virtual void prepareForStepDown();
     virtual void setPrimaryIndex(long long primaryIndex);
+    virtual int getCurrentPrimaryIndex() const;
     virtual HeartbeatResponseAction setMemberAsDown(Date_t now,
                                                     const int memberIndex,
                                                     const OpTime& myLastOpApplied);
@@ -269,9 +270,6 @@ public:
     // Returns _electionId.  Only used in unittests.
     OID getElectionId() const;
 
-    // Returns _currentPrimaryIndex.  Only used in unittests.
-    int getCurrentPrimaryIndex() const;
-
 private:
     enum UnelectableReason {
         None = 0,
@@ -295,6 +293,15 @@ private:
     // Returns the current "ping" value for the given member by their address
     Milliseconds _getPing(const HostAndPort& host);
 
+    // Returns the number of other members that reported "host" as their sync source in their
+    // latest heartbeat response.
+    int _getNumMembersSyncingFrom(const HostAndPort& host) const;
+
+    // Returns true if "candidate" should replace "best" as the sync source chosen so far, based on
+    // ping times and, for candidates whose ping times are within syncSourcePingToleranceMillis of
+    // each other, on how many members already sync from them.
+    bool _isPreferableSyncSource(const HostAndPort& candidate, const HostAndPort& best);
+
     // Determines if we will veto the member specified by "args.id", given that the last op
     // we have applied locally is "lastOpApplied".
     // If we veto, the errmsg will be filled in with a reason
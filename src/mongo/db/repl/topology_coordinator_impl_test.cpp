@@ -39,6 +39,7 @@
 #include "mongo/db/repl/topology_coordinator.h"
 #include "mongo/db/repl/topology_coordinator_impl.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/logger/logger.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
@@ -204,7 +205,8 @@ protected:
                                                 const std::string& setName,
                                                 MemberState memberState,
                                                 const OpTime& lastOpTimeSender,
-                                                Milliseconds roundTripTime = Milliseconds(1)) {
+                                                Milliseconds roundTripTime = Milliseconds(1),
+                                                const HostAndPort& syncingTo = HostAndPort()) {
         return _receiveHeartbeatHelper(Status::OK(),
                                        member,
                                        setName,
@@ -212,7 +214,8 @@ protected:
                                        Timestamp(),
                                        lastOpTimeSender,
                                        OpTime(),
-                                       roundTripTime);
+                                       roundTripTime,
+                                       syncingTo);
     }
 
 private:
@@ -223,10 +226,14 @@ private:
                                                     Timestamp electionTime,
                                                     const OpTime& lastOpTimeSender,
                                                     const OpTime& lastOpTimeReceiver,
-                                                    Milliseconds roundTripTime) {
+                                                    Milliseconds roundTripTime,
+                                                    const HostAndPort& syncingTo = HostAndPort()) {
         ReplSetHeartbeatResponse hb;
         hb.setConfigVersion(1);
         hb.setState(memberState);
+        if (!syncingTo.empty()) {
+            hb.setSyncingTo(syncingTo);
+        }
         hb.setDurableOpTime(lastOpTimeSender);
         hb.setAppliedOpTime(lastOpTimeSender);
         hb.setElectionTime(electionTime);
@@ -503,6 +510,64 @@ TEST_F(TopoCoordTest, NodeReturnsClosestValidSyncSourceAsSyncSource) {
 }
 
 
+TEST_F(TopoCoordTest, ChooseLessLoadedSyncSourceWithinPingTolerance) {
+    updateConfig(BSON("_id"
+                      << "rs0"
+                      << "version"
+                      << 1
+                      << "members"
+                      << BSON_ARRAY(BSON("_id" << 10 << "host"
+                                               << "hself")
+                                    << BSON("_id" << 20 << "host"
+                                                  << "h2")
+                                    << BSON("_id" << 30 << "host"
+                                                  << "h3")
+                                    << BSON("_id" << 40 << "host"
+                                                  << "h4"))),
+                 0);
+    setSelfMemberState(MemberState::RS_SECONDARY);
+
+    // h2 is slightly closer than h3, but h4 already syncs from h2.
+    const OpTime lastOpTime(Timestamp(10, 0), 0);
+    for (int round = 0; round < 2; ++round) {
+        heartbeatFromMember(
+            HostAndPort("h2"), "rs0", MemberState::RS_SECONDARY, lastOpTime, Milliseconds(5));
+        heartbeatFromMember(
+            HostAndPort("h3"), "rs0", MemberState::RS_SECONDARY, lastOpTime, Milliseconds(8));
+        heartbeatFromMember(HostAndPort("h4"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            lastOpTime,
+                            Milliseconds(100),
+                            HostAndPort("h2"));
+    }
+
+    auto setPingTolerance = [](const std::string& millis) {
+        auto parameter =
+            ServerParameterSet::getGlobal()->getMap().find("syncSourcePingToleranceMillis");
+        invariant(parameter != ServerParameterSet::getGlobal()->getMap().end());
+        return parameter->second->setFromString(millis);
+    };
+    ON_BLOCK_EXIT([&] { invariantOK(setPingTolerance("0")); });
+
+    // By default the closest candidate wins.
+    getTopoCoord().chooseNewSyncSource(
+        now()++, OpTime(), TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("h2"), getTopoCoord().getSyncSourceAddress());
+
+    // Within the tolerance, the candidate that nobody syncs from yet is preferred.
+    ASSERT_OK(setPingTolerance("10"));
+    getTopoCoord().chooseNewSyncSource(
+        now()++, OpTime(), TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("h3"), getTopoCoord().getSyncSourceAddress());
+
+    // Outside of it, latency still decides.
+    ASSERT_OK(setPingTolerance("1"));
+    getTopoCoord().chooseNewSyncSource(
+        now()++, OpTime(), TopologyCoordinator::ChainingPreference::kUseConfiguration);
+    ASSERT_EQUALS(HostAndPort("h2"), getTopoCoord().getSyncSourceAddress());
+}
+
 TEST_F(TopoCoordTest, ChooseOnlyPrimaryAsSyncSourceWhenChainingIsDisallowed) {
     updateConfig(BSON("_id"
                       << "rs0"
@@ -260,6 +260,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
 
     MigrateInfoVector candidateChunks;
 
+    // Shards which are already part of a migration selected in this round. A shard can only donate
+    // or receive one chunk at a time, so excluding them when going through the next collections
+    // makes those pick other shards, rather than migrations which would fail as conflicting.
+    std::set<ShardId> usedShards;
+
     for (const auto& coll : collections) {
         if (coll.getDropped()) {
             continue;
@@ -272,8 +277,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(txn, nss, shardStats, aggressiveBalanceHint);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            txn, nss, shardStats, aggressiveBalanceHint, &usedShards);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -419,7 +424,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* txn,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    bool aggressiveBalanceHint) {
+    bool aggressiveBalanceHint,
+    std::set<ShardId>* usedShards) {
     auto scopedCMStatus = ScopedChunkManager::refreshAndGet(txn, nss);
     if (!scopedCMStatus.isOK()) {
         return scopedCMStatus.getStatus();
@@ -478,7 +484,7 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint);
+    return BalancerPolicy::balance(shardStats, distribution, aggressiveBalanceHint, usedShards);
 }
 
 }  // namespace mongo
@@ -293,11 +293,19 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             bool shouldAggressivelyBalance) {
+    set<ShardId> usedShards;
+    return balance(shardStats, distribution, shouldAggressivelyBalance, &usedShards);
+}
+
+vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            bool shouldAggressivelyBalance,
+                                            set<ShardId>* usedShardsPtr) {
     vector<MigrateInfo> migrations;
 
     // Set of shards, which have already been used for migrations. Used so we don't return multiple
     // migrations for the same shard.
-    set<ShardId> usedShards;
+    set<ShardId>& usedShards = *usedShardsPtr;
 
     // 1) Check for shards, which are in draining mode or are above the size limit and must have
     // chunks moved off of them
@@ -179,6 +179,19 @@ public:
      *
      * The shouldAggressivelyBalance parameter causes the threshold for chunk could disparity
      * between shards to be lowered.
+     *
+     * A shard can only take part in one migration at a time. Shards in 'usedShards' are not
+     * considered and every shard used by a returned migration is added to it, so that the same set
+     * can be passed in for each collection during a balancer round in order to select migrations,
+     * which can all run concurrently.
+     */
+    static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            bool shouldAggressivelyBalance,
+                                            std::set<ShardId>* usedShards);
+
+    /**
+     * Same as above, for a collection balanced on its own.
      */
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
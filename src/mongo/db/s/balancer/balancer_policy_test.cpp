@@ -125,6 +125,26 @@ TEST(BalancerPolicy, Basic) {
     ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
 }
 
+TEST(BalancerPolicy, UsedShardsAreSharedAcrossCollections) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId3, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    std::set<ShardId> usedShards;
+
+    const auto migrations1(BalancerPolicy::balance(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), false, &usedShards));
+    ASSERT_EQ(2U, migrations1.size());
+    ASSERT_EQ(4U, usedShards.size());
+
+    // Another collection with the same distribution cannot use any of the shards anymore
+    const auto migrations2(BalancerPolicy::balance(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), false, &usedShards));
+    ASSERT(migrations2.empty());
+}
+
 TEST(BalancerPolicy, SmallClusterShouldBePerfectlyBalanced) {
     auto cluster = generateCluster(
         {{ShardStatistics(kShardId0, kNoMaxSize, 1, false, emptyTagSet, emptyShardVersion), 1},
@@ -48,11 +48,13 @@
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -68,17 +70,48 @@ const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::SyncMode::UNSET,
                                                 Seconds(60));
 
+// Upper bound on the number of documents removed between two waits for majority replication.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterMaxBatchSize, int, 1024);
+
+// How long the deleter aims to wait for each batch to replicate. Batches which take longer than
+// this to become majority committed shrink the next batch, batches which replicate in under half
+// of it grow the next batch.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterTargetReplicationWaitMillis, int, 100);
+
+int initialBatchSize() {
+    return std::max(std::min(int(internalQueryExecYieldIterations.load()),
+                             rangeDeleterMaxBatchSize.load()),
+                    1);
+}
+
 }  // unnamed namespace
 
-CollectionRangeDeleter::CollectionRangeDeleter(NamespaceString nss) : _nss(std::move(nss)) {}
+CollectionRangeDeleter::CollectionRangeDeleter(NamespaceString nss)
+    : _nss(std::move(nss)), _batchSize(initialBatchSize()) {}
+
+int CollectionRangeDeleter::nextBatchSize(int currentBatchSize, Milliseconds replicationWait) {
+    const int maxBatchSize = std::max(rangeDeleterMaxBatchSize.load(), 1);
+    const Milliseconds target(std::max(rangeDeleterTargetReplicationWaitMillis.load(), 0));
+
+    int next = currentBatchSize;
+    if (replicationWait > target) {
+        next = currentBatchSize / 2;
+    } else if (replicationWait * 2 <= target) {
+        next = currentBatchSize * 2;
+    }
+
+    return std::max(std::min(next, maxBatchSize), 1);
+}
 
 void CollectionRangeDeleter::run() {
     Client::initThread(getThreadName().c_str());
     ON_BLOCK_EXIT([&] { Client::destroy(); });
     auto txn = cc().makeOperationContext().get();
 
-    const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
-    bool hasNextRangeToClean = cleanupNextRange(txn, maxToDelete);
+    bool hasNextRangeToClean = cleanupNextRange(txn, _batchSize);
+    if (_lastReplicationWait) {
+        _batchSize = nextBatchSize(_batchSize, *_lastReplicationWait);
+    }
 
     // If there are more ranges to run, we add <this> back onto the task executor to run again.
     if (hasNextRangeToClean) {
@@ -90,6 +123,7 @@ void CollectionRangeDeleter::run() {
 }
 
 bool CollectionRangeDeleter::cleanupNextRange(OperationContext* txn, int maxToDelete) {
+    _lastReplicationWait = boost::none;
 
     {
         AutoGetCollection autoColl(txn, _nss, MODE_IX);
@@ -128,10 +162,15 @@ bool CollectionRangeDeleter::cleanupNextRange(OperationContext* txn, int maxToDe
     // wait for replication
     WriteConcernResult wcResult;
     auto currentClientOpTime = repl::ReplClientInfo::forClient(txn->getClient()).getLastOp();
+    Timer replicationTimer;
     Status status = waitForWriteConcern(txn, currentClientOpTime, kMajorityWriteConcern, &wcResult);
     if (!status.isOK()) {
         warning() << "Error when waiting for write concern after removing chunks in " << _nss
                   << " : " << status.reason();
+        // Treat a failed or timed out wait as severe lag, so that the next batch is smaller
+        _lastReplicationWait = Milliseconds(kMajorityWriteConcern.wTimeout);
+    } else {
+        _lastReplicationWait = Milliseconds(replicationTimer.millis());
     }
 
     return true;
@@ -172,17 +211,21 @@ int CollectionRangeDeleter::_doDeletion(OperationContext* txn,
         return -1;
     }
 
+    // A single scan serves the whole batch. The collection lock is held throughout and the plan
+    // never yields, so the only changes it has to survive are our own deletes, around which its
+    // state is saved and restored.
+    auto exec = InternalPlanner::indexScan(txn,
+                                           collection,
+                                           desc,
+                                           min,
+                                           max,
+                                           BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanExecutor::YIELD_MANUAL,
+                                           InternalPlanner::FORWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
+
     int numDeleted = 0;
     do {
-        auto exec = InternalPlanner::indexScan(txn,
-                                               collection,
-                                               desc,
-                                               min,
-                                               max,
-                                               BoundInclusion::kIncludeStartKeyOnly,
-                                               PlanExecutor::YIELD_MANUAL,
-                                               InternalPlanner::FORWARD,
-                                               InternalPlanner::IXSCAN_FETCH);
         RecordId rloc;
         BSONObj obj;
         PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
@@ -198,15 +241,23 @@ int CollectionRangeDeleter::_doDeletion(OperationContext* txn,
         }
 
         invariant(PlanExecutor::ADVANCED == state);
-        WriteUnitOfWork wuow(txn);
-        if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(_nss)) {
-            warning() << "stepped down from primary while deleting chunk; orphaning data in "
-                      << _nss << " in range [" << min << ", " << max << ")";
+        exec->saveState();
+        {
+            WriteUnitOfWork wuow(txn);
+            if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(_nss)) {
+                warning() << "stepped down from primary while deleting chunk; orphaning data in "
+                          << _nss << " in range [" << min << ", " << max << ")";
+                break;
+            }
+            OpDebug* const nullOpDebug = nullptr;
+            collection->deleteDocument(txn, rloc, nullOpDebug, true);
+            wuow.commit();
+        }
+        if (!exec->restoreState()) {
+            // The deletion counts, but the rest of the range has to wait for the next batch
+            ++numDeleted;
             break;
         }
-        OpDebug* const nullOpDebug = nullptr;
-        collection->deleteDocument(txn, rloc, nullOpDebug, true);
-        wuow.commit();
     } while (++numDeleted < maxToDelete);
     return numDeleted;
 }
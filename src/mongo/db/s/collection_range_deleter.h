@@ -30,6 +30,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/s/catalog/type_chunk.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -58,6 +59,14 @@ public:
      */
     bool cleanupNextRange(OperationContext* txn, int maxToDelete);
 
+    /**
+     * Returns the number of documents to delete in the batch following one of 'currentBatchSize'
+     * documents, which took 'replicationWait' to become majority committed. Batches shrink while
+     * secondaries lag behind the rangeDeleterTargetReplicationWaitMillis target and grow, up to
+     * rangeDeleterMaxBatchSize, while they keep up comfortably.
+     */
+    static int nextBatchSize(int currentBatchSize, Milliseconds replicationWait);
+
 private:
     /**
      * Performs the deletion of up to maxToDelete entries within the range in progress.
@@ -75,6 +84,13 @@ private:
     // Holds a range for which deletion has begun. If empty, then a new range
     // must be requested from rangesToClean
     boost::optional<ChunkRange> _rangeInProgress;
+
+    // Number of documents run() passes to the next cleanupNextRange call
+    int _batchSize;
+
+    // How long the last call to cleanupNextRange waited for its deletes to replicate, if it
+    // deleted anything
+    boost::optional<Milliseconds> _lastReplicationWait;
 };
 
 }  // namespace mongo
@@ -281,6 +281,28 @@ TEST_F(CollectionRangeDeleterTest, CalltoCleanupNextRangeWithChunkReceive) {
                   _dbDirectClient->count(kNamespaceString.toString(), BSON(kPattern << LT << 10)));
 }
 
+// Tests that the batch size follows the time taken by each batch to replicate, with the default
+// rangeDeleterTargetReplicationWaitMillis of 100ms and rangeDeleterMaxBatchSize of 1024.
+TEST(CollectionRangeDeleterBatchSize, AdaptsToReplicationWait) {
+    // Secondaries keep up comfortably, so the batch doubles
+    ASSERT_EQ(256, CollectionRangeDeleter::nextBatchSize(128, Milliseconds(10)));
+    ASSERT_EQ(256, CollectionRangeDeleter::nextBatchSize(128, Milliseconds(50)));
+
+    // Close enough to the target, so the batch is kept
+    ASSERT_EQ(128, CollectionRangeDeleter::nextBatchSize(128, Milliseconds(51)));
+    ASSERT_EQ(128, CollectionRangeDeleter::nextBatchSize(128, Milliseconds(100)));
+
+    // Secondaries are lagging, so the batch halves
+    ASSERT_EQ(64, CollectionRangeDeleter::nextBatchSize(128, Milliseconds(101)));
+    ASSERT_EQ(64, CollectionRangeDeleter::nextBatchSize(128, Seconds(60)));
+}
+
+TEST(CollectionRangeDeleterBatchSize, StaysWithinBounds) {
+    ASSERT_EQ(1, CollectionRangeDeleter::nextBatchSize(1, Seconds(60)));
+    ASSERT_EQ(1024, CollectionRangeDeleter::nextBatchSize(1024, Milliseconds(0)));
+    ASSERT_EQ(1024, CollectionRangeDeleter::nextBatchSize(900, Milliseconds(0)));
+}
+
 }  // unnamed namespace
 
 }  // namespace mongo
@@ -72,6 +72,10 @@ public:
         // True if the document being deleted belongs to a chunk which is currently being migrated
         // out of this shard.
         bool isMigrating = false;
+
+        // An owned copy of the whole document, kept only if materialized views are defined on the
+        // collection, since applying the delete to a $group needs more than the _id.
+        BSONObj fullDoc;
     };
 
     /**
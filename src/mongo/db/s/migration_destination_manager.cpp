@@ -33,6 +33,7 @@
 #include "mongo/db/s/migration_destination_manager.h"
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "mongo/client/connpool.h"
@@ -59,12 +60,16 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/mmap_v1/dur.h"
 #include "mongo/logger/ramlog.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/stdx/chrono.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/queue.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -628,11 +633,54 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* txn,
 
         const BSONObj migrateCloneRequest = createMigrateCloneRequest(_nss, *_sessionId);
 
+        // Gets the next array of objects to copy, in disk order. Returns false if the command
+        // failed, in which case 'res' describes the error.
+        auto fetchBatch = [&](BSONObj* res) {
+            try {
+                return conn->runCommand("admin", migrateCloneRequest, *res);
+            } catch (const DBException& ex) {
+                *res = BSON("ok" << 0 << "errmsg" << ex.toString());
+                return false;
+            }
+        };
+
+        // A single fetcher thread requests the batches from the donor and hands them over through
+        // 'batches', so that the round trips and the donor's work overlap with our writes. It is
+        // the only user of the connection until it is stopped, and holds at most one fetched
+        // batch which has not been taken yet. Each entry is whether the fetch succeeded and its
+        // response. The fetcher stops after a failed fetch or an empty batch.
+        BlockingQueue<std::pair<bool, BSONObj>> batches(1);
+        AtomicBool stopFetching(false);
+        stdx::thread fetcher([&] {
+            Client::initThread("migrateCloneFetcher");
+            ON_BLOCK_EXIT([&] { Client::destroy(); });
+            while (!stopFetching.load()) {
+                BSONObj res;
+                const bool fetched = fetchBatch(&res);
+                batches.push(std::make_pair(fetched, res));
+
+                const BSONElement objects = res["objects"];
+                if (!fetched || !objects.isABSONObj() || objects.Obj().isEmpty()) {
+                    return;
+                }
+            }
+        });
+
+        // Wakes up the fetcher if it waits to hand over a batch, and waits for it to exit once
+        // its outstanding request, if any, has completed.
+        auto stopFetcher = [&] {
+            stopFetching.store(true);
+            batches.clear();
+            if (fetcher.joinable())
+                fetcher.join();
+        };
+        ON_BLOCK_EXIT(stopFetcher);
+
         while (true) {
-            BSONObj res;
-            if (!conn->runCommand("admin",
-                                  migrateCloneRequest,
-                                  res)) {  // gets array of objects to copy, in disk order
+            const auto batch = batches.blockingPop();
+            const BSONObj& res = batch.second;
+            if (!batch.first) {
+                stopFetcher();
                 setState(FAIL);
                 _errmsg = "_migrateClone failed: ";
                 _errmsg += redact(res.toString());
@@ -642,7 +690,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* txn,
             }
 
             BSONObj arr = res["objects"].Obj();
-            int thisTime = 0;
+            if (arr.isEmpty())
+                break;
 
             BSONObjIterator i(arr);
             while (i.more()) {
@@ -679,33 +728,34 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* txn,
 
                     Helpers::upsert(txn, _nss.ns(), docToClone, true);
                 }
-                thisTime++;
 
                 {
                     stdx::lock_guard<stdx::mutex> statsLock(_mutex);
                     _numCloned++;
                     _clonedBytes += docToClone.objsize();
                 }
+            }
 
-                if (writeConcern.shouldWaitForOtherNodes()) {
-                    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-                        repl::getGlobalReplicationCoordinator()->awaitReplication(
-                            txn,
-                            repl::ReplClientInfo::forClient(txn->getClient()).getLastOp(),
-                            writeConcern);
-                    if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
-                        warning() << "secondaryThrottle on, but doc insert timed out; "
-                                     "continuing";
-                    } else {
-                        massertStatusOK(replStatus.status);
-                    }
+            // Throttle on the secondaries once per batch rather than once per document. All the
+            // writes of the batch are covered by the last optime.
+            if (writeConcern.shouldWaitForOtherNodes()) {
+                repl::ReplicationCoordinator::StatusAndDuration replStatus =
+                    repl::getGlobalReplicationCoordinator()->awaitReplication(
+                        txn,
+                        repl::ReplClientInfo::forClient(txn->getClient()).getLastOp(),
+                        writeConcern);
+                if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
+                    warning() << "secondaryThrottle on, but doc insert timed out; "
+                                 "continuing";
+                } else {
+                    massertStatusOK(replStatus.status);
                 }
             }
 
-            if (thisTime == 0)
-                break;
         }
 
+        stopFetcher();
+
         timing.done(3);
         MONGO_FAIL_POINT_PAUSE_WHILE_SET(migrateThreadHangAtStep3);
     }
@@ -52,8 +52,8 @@
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_initialization_mongod.h"
 #include "mongo/db/s/type_shard_identity.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/network_interface_factory.h"
-#include "mongo/executor/network_interface_thread_pool.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/rpc/metadata/config_server_metadata.h"
 #include "mongo/rpc/metadata/metadata_hook.h"
@@ -65,9 +65,11 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/local_sharding_info.h"
 #include "mongo/s/sharding_initialization.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -93,6 +95,9 @@ const int kMaxConfigServerRefreshThreads = 1;
 // Maximum number of times to try to refresh the collection metadata if conflicts are occurring
 const int kMaxNumMetadataRefreshAttempts = 3;
 
+// Number of collections whose orphaned ranges may be cleaned up at the same time
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(rangeDeleterMaxThreads, int, 4);
+
 /**
  * Updates the config server field of the shardIdentity document with the given connection string
  * if setName is equal to the config server replica set name.
@@ -662,11 +667,15 @@ Status ShardingState::updateShardIdentityConfigString(OperationContext* txn,
 
 void ShardingState::_initializeRangeDeleterTaskExecutor() {
     invariant(!_rangeDeleterTaskExecutor);
-    auto net =
-        executor::makeNetworkInterface("NetworkInterfaceCollectionRangeDeleter-TaskExecutor");
-    auto netPtr = net.get();
+    // Each CollectionRangeDeleter blocks its thread while waiting for majority replication, so
+    // the tasks run on a pool of their own instead of the network interface's thread, which lets
+    // several collections make progress at once.
+    ThreadPool::Options threadPoolOptions;
+    threadPoolOptions.poolName = "CollectionRangeDeleter";
+    threadPoolOptions.maxThreads = std::max(rangeDeleterMaxThreads, 1);
     _rangeDeleterTaskExecutor = stdx::make_unique<executor::ThreadPoolTaskExecutor>(
-        stdx::make_unique<executor::NetworkInterfaceThreadPool>(netPtr), std::move(net));
+        stdx::make_unique<ThreadPool>(threadPoolOptions),
+        executor::makeNetworkInterface("NetworkInterfaceCollectionRangeDeleter-TaskExecutor"));
 }
 
 executor::ThreadPoolTaskExecutor* ShardingState::getRangeDeleterTaskExecutor() {
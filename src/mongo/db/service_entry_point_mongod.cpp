@@ -42,6 +42,7 @@
 #include "mongo/transport/session.h"
 #include "mongo/transport/ticket.h"
 #include "mongo/transport/transport_layer.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
@@ -93,6 +94,18 @@ using transport::TransportLayer;
 ServiceEntryPointMongod::ServiceEntryPointMongod(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongod::startSession(transport::SessionHandle session) {
+    if (transport::isTransportLayerASIOEnabled()) {
+        launchAsyncServiceEntrySession(
+            std::move(session),
+            [this](const transport::SessionHandle& session, Message* request, bool* inExhaust) {
+                _nWorkers.fetchAndAdd(1);
+                auto guard = MakeGuard([&] { _nWorkers.fetchAndSubtract(1); });
+
+                return _handleRequest(session, request, inExhaust);
+            });
+        return;
+    }
+
     // Pass ownership of the transport::SessionHandle into our worker thread. When this
     // thread exits, the session will end.
     launchWrappedServiceEntryWorkerThread(
@@ -128,33 +141,12 @@ void ServiceEntryPointMongod::_sessionLoop(const transport::SessionHandle& sessi
             uassertStatusOK(status);
         }
 
-        // 2. Pass sourced Message up to mongod
-        DbResponse dbresponse;
-        {
-            auto opCtx = cc().makeOperationContext();
-            assembleResponse(opCtx.get(), inMessage, dbresponse, session->remote());
-
-            // opCtx must go out of scope here so that the operation cannot show
-            // up in currentOp results after the response reaches the client
-        }
+        // 2. Pass sourced Message up to mongod and format our response, if we have one
+        Message toSink = _handleRequest(session, &inMessage, &inExhaust);
 
-        // 3. Format our response, if we have one
-        Message& toSink = dbresponse.response;
+        // 3. Sink our response to the client
         if (!toSink.empty()) {
-            toSink.header().setId(nextMessageId());
-            toSink.header().setResponseToMsgId(inMessage.header().getId());
-
-            // If this is an exhaust cursor, don't source more Messages
-            if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&inMessage, dbresponse)) {
-                inExhaust = true;
-            } else {
-                inExhaust = false;
-            }
-
-            // 4. Sink our response to the client
             uassertStatusOK(session->sinkMessage(toSink).wait());
-        } else {
-            inExhaust = false;
         }
 
         if ((counter++ & 0xf) == 0) {
@@ -163,4 +155,31 @@ void ServiceEntryPointMongod::_sessionLoop(const transport::SessionHandle& sessi
     }
 }
 
+Message ServiceEntryPointMongod::_handleRequest(const transport::SessionHandle& session,
+                                                Message* inMessage,
+                                                bool* inExhaust) {
+    DbResponse dbresponse;
+    {
+        auto opCtx = cc().makeOperationContext();
+        assembleResponse(opCtx.get(), *inMessage, dbresponse, session->remote());
+
+        // opCtx must go out of scope here so that the operation cannot show
+        // up in currentOp results after the response reaches the client
+    }
+
+    Message& toSink = dbresponse.response;
+    if (!toSink.empty()) {
+        toSink.header().setId(nextMessageId());
+        toSink.header().setResponseToMsgId(inMessage->header().getId());
+
+        // If this is an exhaust cursor, don't source more Messages
+        *inExhaust =
+            dbresponse.exhaustNS.size() > 0 && setExhaustMessage(inMessage, dbresponse);
+    } else {
+        *inExhaust = false;
+    }
+
+    return std::move(toSink);
+}
+
 }  // namespace mongo
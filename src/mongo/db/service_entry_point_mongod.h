@@ -33,6 +33,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/util/net/message.h"
 
 namespace mongo {
 
@@ -43,7 +44,8 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongod. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the
+ * asio TransportLayer is in use, in which case sessions are run on its worker threads.
  */
 class ServiceEntryPointMongod final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongod);
@@ -62,6 +64,14 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs a single request and returns the response to send back, if any. Sets '*inExhaust'
+     * and replaces 'inMessage' with the next request if this is an exhaust cursor.
+     */
+    Message _handleRequest(const transport::SessionHandle& session,
+                           Message* inMessage,
+                           bool* inExhaust);
+
     transport::TransportLayer* _tl;
     AtomicWord<std::size_t> _nWorkers;
 };
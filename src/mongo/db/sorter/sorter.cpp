@@ -47,7 +47,9 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <exception>
 #include <snappy.h>
 #include <vector>
 
@@ -59,6 +61,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -102,6 +105,80 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * Calls 'task(i)' for each i in [0, numTasks), each on its own thread except for the first, which
+ * runs on the calling thread. Rethrows the first exception thrown by any task once all of them
+ * have finished.
+ */
+template <typename Task>
+void runInParallel(size_t numTasks, const Task& task) {
+    std::vector<std::exception_ptr> errors(numTasks);
+    auto runTask = [&](size_t i) {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    threads.reserve(numTasks);
+    try {
+        for (size_t i = 1; i < numTasks; i++) {
+            threads.emplace_back(runTask, i);
+        }
+    } catch (...) {
+        // Run whatever could not be given a thread on this one instead.
+        for (size_t i = threads.size() + 1; i < numTasks; i++) {
+            runTask(i);
+        }
+    }
+    runTask(0);
+
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * Stable-sorts [begin, end) by splitting it into 'numRuns' contiguous runs, sorting each run on its
+ * own thread, and then repeatedly merging neighbouring pairs of runs, also in parallel, until a
+ * single run remains.
+ */
+template <typename Iterator, typename Less>
+void parallelStableSort(Iterator begin, Iterator end, size_t numRuns, const Less& less) {
+    const size_t numElements = end - begin;
+    std::vector<Iterator> bounds;  // run i is [bounds[i], bounds[i + 1])
+    for (size_t i = 0; i <= numRuns; i++) {
+        bounds.push_back(begin + numElements * i / numRuns);
+    }
+
+    runInParallel(numRuns,
+                  [&](size_t i) { std::stable_sort(bounds[i], bounds[i + 1], less); });
+
+    while (bounds.size() > 2) {
+        const size_t numMerges = (bounds.size() - 1) / 2;
+        runInParallel(numMerges, [&](size_t i) {
+            std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], less);
+        });
+
+        // Keep the bounds between the merged runs, plus the end of any run left unpaired.
+        std::vector<Iterator> mergedBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            mergedBounds.push_back(bounds[i]);
+        }
+        if ((bounds.size() - 1) % 2) {
+            mergedBounds.push_back(bounds.back());
+        }
+        bounds.swap(mergedBounds);
+    }
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -204,48 +281,65 @@ private:
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
 
-        _buffer.reset(new char[blockSize]);
-        read(_buffer.get(), blockSize);
+        // Blocks are read into buffers which are kept for the life of this iterator, so that
+        // merging many spill files does not allocate and free two buffers for every block.
+        char* block = reserve(&_buffer, &_bufferSize, blockSize);
+        read(block, blockSize);
         massert(16816, "file too short?", !_done);
 
         auto hooks = WiredTigerCustomizationHooks::get(getGlobalServiceContext());
         if (hooks->enabled()) {
-            std::unique_ptr<char[]> out(new char[blockSize]);
+            char* out = reserve(&_scratch, &_scratchSize, blockSize);
             size_t outLen;
-            Status status = hooks->unprotectTmpData(reinterpret_cast<uint8_t*>(_buffer.get()),
+            Status status = hooks->unprotectTmpData(reinterpret_cast<uint8_t*>(block),
                                                     blockSize,
-                                                    reinterpret_cast<uint8_t*>(out.get()),
+                                                    reinterpret_cast<uint8_t*>(out),
                                                     blockSize,
                                                     &outLen);
             massert(28841,
                     str::stream() << "Failed to unprotect data: " << status.toString(),
                     status.isOK());
             blockSize = outLen;
-            _buffer.swap(out);
+            _buffer.swap(_scratch);
+            std::swap(_bufferSize, _scratchSize);
+            block = _buffer.get();
         }
 
         if (!compressed) {
-            _reader.reset(new BufReader(_buffer.get(), blockSize));
+            _reader.reset(new BufReader(block, blockSize));
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
+        dassert(snappy::IsValidCompressedBuffer(block, blockSize));
 
         size_t uncompressedSize;
         massert(17061,
                 "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
+                snappy::GetUncompressedLength(block, blockSize, &uncompressedSize));
 
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
+        char* decompressed = reserve(&_scratch, &_scratchSize, uncompressedSize);
         massert(17062,
                 "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+                snappy::RawUncompress(block, blockSize, decompressed));
 
-        // hold on to decompressed data and throw out compressed data at block exit
-        _buffer.swap(decompressionBuffer);
+        // hold on to decompressed data and keep the compressed buffer around for the next block
+        _buffer.swap(_scratch);
+        std::swap(_bufferSize, _scratchSize);
         _reader.reset(new BufReader(_buffer.get(), uncompressedSize));
     }
 
+    /**
+     * Returns a pointer to '*buffer' after growing it, if necessary, to hold at least 'size'
+     * bytes. The previous contents are not preserved when the buffer grows.
+     */
+    static char* reserve(std::unique_ptr<char[]>* buffer, size_t* capacity, size_t size) {
+        if (*capacity < size) {
+            buffer->reset(new char[size]);
+            *capacity = size;
+        }
+        return buffer->get();
+    }
+
     // sets _done to true on EOF - asserts on any other error
     void read(void* out, size_t size) {
         _file.read(reinterpret_cast<char*>(out), size);
@@ -264,7 +358,10 @@ private:
 
     const Settings _settings;
     bool _done;
-    std::unique_ptr<char[]> _buffer;
+    std::unique_ptr<char[]> _buffer;  // holds the block '_reader' is reading from
+    size_t _bufferSize = 0;
+    std::unique_ptr<char[]> _scratch;  // holds compressed or protected data while unpacking it
+    size_t _scratchSize = 0;
     std::unique_ptr<BufReader> _reader;
     std::string _fileName;
     std::shared_ptr<FileDeleter> _fileDeleter;  // Must outlive _file
@@ -454,6 +551,16 @@ private:
 
     void sort() {
         STLComparator less(_comp);
+
+        // Only split the sort across threads when each of them has enough work to make up for
+        // starting it.
+        const size_t kMinDataPerThread = 16 * 1024;
+        const size_t numThreads = std::min(_opts.maxSortThreads, _data.size() / kMinDataPerThread);
+        if (numThreads > 1) {
+            parallelStableSort(_data.begin(), _data.end(), numThreads, less);
+            return;
+        }
+
         std::stable_sort(_data.begin(), _data.end(), less);
 
         // Does 2x more compares than stable_sort
@@ -855,14 +962,14 @@ void SortedFileWriter<Key, Value>::spill() {
     if (size == 0)
         return;
 
-    std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
+    // Reusing '_compressed' keeps its capacity from one block to the next.
+    snappy::Compress(outBuffer, size, &_compressed);
+    verify(_compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = _compressed.size() < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
-        size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        size = _compressed.size();
+        outBuffer = const_cast<char*>(_compressed.data());
     }
 
     std::unique_ptr<char[]> out;
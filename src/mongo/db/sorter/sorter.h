@@ -98,8 +98,14 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
+    size_t maxSortThreads;       /// Threads that may sort a batch of data. Only honored for
+                                 /// sorts without a limit. The Comparator must be thread-safe.
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          maxSortThreads(1) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +128,11 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& MaxSortThreads(size_t newMaxSortThreads) {
+        maxSortThreads = newMaxSortThreads;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -204,6 +215,7 @@ private:
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
     BufBuilder _buffer;
+    std::string _compressed;
 };
 }
 
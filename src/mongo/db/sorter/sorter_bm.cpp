@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <random>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+class KeyComparator {
+public:
+    int operator()(const std::pair<BSONObj, BSONObj>& lhs,
+                   const std::pair<BSONObj, BSONObj>& rhs) const {
+        return lhs.first.woCompare(rhs.first, BSONObj(), false);
+    }
+};
+
+using BSONSorter = Sorter<BSONObj, BSONObj>;
+
+std::vector<std::pair<BSONObj, BSONObj>> makeData(std::int64_t count) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist;
+    std::vector<std::pair<BSONObj, BSONObj>> data;
+    for (std::int64_t i = 0; i < count; ++i) {
+        data.emplace_back(BSON("" << dist(gen) << "" << static_cast<long long>(i)),
+                          BSON("_id" << static_cast<long long>(i) << "payload"
+                                     << "a small document"));
+    }
+    return data;
+}
+
+/**
+ * Sorts 'count' pairs in memory, and reads them back in order.
+ */
+void sortInMemory(benchmark::State& state, const SortOptions& options) {
+    const auto data = makeData(state.arg());
+    while (state.keepRunning()) {
+        std::unique_ptr<BSONSorter> sorter(BSONSorter::make(options, KeyComparator()));
+        for (auto&& pair : data) {
+            sorter->add(pair.first, pair.second);
+        }
+        std::unique_ptr<BSONSorter::Iterator> it(sorter->done());
+        while (it->more()) {
+            benchmark::doNotOptimize(it->next());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * state.arg());
+}
+
+void BM_sorterNoLimit(benchmark::State& state) {
+    sortInMemory(state, SortOptions().MaxMemoryUsageBytes(1024 * 1024 * 1024));
+}
+MONGO_BENCHMARK(BM_sorterNoLimit)->arg(1000)->arg(100000);
+
+void BM_sorterTopK(benchmark::State& state) {
+    sortInMemory(state, SortOptions().Limit(100).MaxMemoryUsageBytes(1024 * 1024 * 1024));
+}
+MONGO_BENCHMARK(BM_sorterTopK)->arg(1000)->arg(100000);
+
+void BM_sorterLimitOne(benchmark::State& state) {
+    sortInMemory(state, SortOptions().Limit(1));
+}
+MONGO_BENCHMARK(BM_sorterLimitOne)->arg(1000)->arg(100000);
+
+}  // namespace
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+MONGO_CREATE_SORTER(mongo::BSONObj, mongo::BSONObj, mongo::KeyComparator);
@@ -541,6 +541,14 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <size_t MemLimit>
+class LotsOfDataMultipleSortThreads : public LotsOfDataLittleMemory</*random=*/true> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // An odd number of threads leaves a run unpaired in the first round of merging.
+        return opts.MaxMemoryUsageBytes(MemLimit).ExtSortAllowed().MaxSortThreads(5);
+    }
+};
 }
 
 class SorterSuite : public mongo::unittest::Suite {
@@ -562,6 +570,8 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::LotsOfDataMultipleSortThreads<64 * 1024 * 1024>>();  // fits in mem
+        add<SorterTests::LotsOfDataMultipleSortThreads<2 * 1024 * 1024>>();   // spills
     }
 };
 
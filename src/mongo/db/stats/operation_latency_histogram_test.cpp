@@ -89,4 +89,26 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
         ASSERT_EQUALS(bucket["count"].Long(), (i < kMaxBuckets - 1) ? 3 : 2);
     }
 }
+TEST(OperationLatencyHistogram, AddCombinesBucketsAndTotals) {
+    OperationLatencyHistogram first, second;
+    first.increment(1, Command::ReadWriteType::kRead);
+    first.increment(kLowerBounds[20], Command::ReadWriteType::kWrite);
+    second.increment(1, Command::ReadWriteType::kRead);
+    second.increment(kLowerBounds[30], Command::ReadWriteType::kCommand);
+
+    first.add(second);
+
+    BSONObjBuilder outBuilder;
+    first.append(true, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array().size(), 1U);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array()[0]["count"].Long(), 2);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(static_cast<uint64_t>(out["writes"]["latency"].Long()), kLowerBounds[20]);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 1);
+    ASSERT_EQUALS(static_cast<uint64_t>(out["commands"]["latency"].Long()), kLowerBounds[30]);
+}
+
 }  // namespace mongo
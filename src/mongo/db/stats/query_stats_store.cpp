@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include <functional>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+std::string makeKey(StringData ns, StringData shapeKey) {
+    std::string key;
+    key.reserve(ns.size() + 1 + shapeKey.size());
+    key.append(ns.rawData(), ns.size());
+    key.push_back('\0');
+    key.append(shapeKey.rawData(), shapeKey.size());
+    return key;
+}
+
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* serviceContext) {
+    return getQueryStatsStore(serviceContext);
+}
+
+void QueryStatsStore::record(StringData ns,
+                             StringData shapeKey,
+                             const BSONObj& shape,
+                             const Execution& execution,
+                             size_t budgetBytes) {
+    auto key = makeKey(ns, shapeKey);
+    auto& partition = _partitions[std::hash<std::string>()(key) % kNumPartitions];
+    const auto now = jsTime();
+
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    auto it = partition.index.find(key);
+    if (it == partition.index.end()) {
+        partition.entries.emplace_front();
+        auto& entry = partition.entries.front();
+        entry.key = key;
+        entry.ns = ns.toString();
+        entry.shapeKey = shapeKey.toString();
+        entry.shape = shape.getOwned();
+        entry.firstSeen = now;
+        // The key is held by the entry and the index, and split into the namespace and shape key.
+        entry.sizeBytes = sizeof(Entry) + 3 * key.size() + entry.shape.objsize();
+        partition.sizeBytes += entry.sizeBytes;
+        it = partition.index.emplace(std::move(key), partition.entries.begin()).first;
+    } else {
+        partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+    }
+
+    auto& entry = *it->second;
+    entry.lastSeen = now;
+    ++entry.count;
+    entry.docsExamined += execution.docsExamined;
+    entry.keysExamined += execution.keysExamined;
+    entry.nreturned += execution.nreturned;
+    entry.latency.increment(execution.micros, execution.readWriteType);
+
+    _evictUntilWithin_inlock(&partition, budgetBytes / kNumPartitions);
+}
+
+std::vector<BSONObj> QueryStatsStore::getStats(StringData ns) const {
+    std::vector<BSONObj> stats;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        for (auto&& entry : partition.entries) {
+            if (entry.ns != ns) {
+                continue;
+            }
+
+            BSONObjBuilder builder;
+            builder.append("ns", entry.ns);
+            builder.append("queryShape", entry.shape);
+            builder.append("planCacheKey", entry.shapeKey);
+            builder.appendNumber("count", entry.count);
+            builder.appendNumber("docsExamined", entry.docsExamined);
+            builder.appendNumber("keysExamined", entry.keysExamined);
+            builder.appendNumber("nreturned", entry.nreturned);
+            {
+                BSONObjBuilder latencyBuilder(builder.subobjStart("latencyStats"));
+                entry.latency.append(true, &latencyBuilder);
+            }
+            builder.appendDate("firstSeen", entry.firstSeen);
+            builder.appendDate("lastSeen", entry.lastSeen);
+            stats.push_back(builder.obj());
+        }
+    }
+    return stats;
+}
+
+void QueryStatsStore::collectionDropped(StringData ns) {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        for (auto it = partition.entries.begin(); it != partition.entries.end();) {
+            if (it->ns != ns) {
+                ++it;
+                continue;
+            }
+            partition.sizeBytes -= it->sizeBytes;
+            partition.index.erase(it->key);
+            it = partition.entries.erase(it);
+        }
+    }
+}
+
+void QueryStatsStore::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        partition.entries.clear();
+        partition.index.clear();
+        partition.sizeBytes = 0;
+    }
+}
+
+size_t QueryStatsStore::sizeBytes() const {
+    size_t sizeBytes = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        sizeBytes += partition.sizeBytes;
+    }
+    return sizeBytes;
+}
+
+void QueryStatsStore::_evictUntilWithin_inlock(Partition* partition, size_t budgetBytes) {
+    while (partition->sizeBytes > budgetBytes && !partition->entries.empty()) {
+        auto& entry = partition->entries.back();
+        partition->sizeBytes -= entry.sizeBytes;
+        partition->index.erase(entry.key);
+        partition->entries.pop_back();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Aggregates the execution statistics of operations by the collection they ran on and the shape
+ * of their query, as computed by PlanCache::computeKey. This makes it cheap to find the query
+ * shapes which consume the most resources, without profiling individual operations.
+ *
+ * Shapes are spread over several partitions by the hash of their key, each with its own lock.
+ * Each partition keeps at most its share of the byte budget passed to record(), evicting the
+ * least recently executed shapes first.
+ */
+class QueryStatsStore {
+    MONGO_DISALLOW_COPYING(QueryStatsStore);
+
+public:
+    /**
+     * What one operation contributes to the statistics of its query shape.
+     */
+    struct Execution {
+        uint64_t micros = 0;
+        Command::ReadWriteType readWriteType = Command::ReadWriteType::kRead;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+    };
+
+    QueryStatsStore() = default;
+
+    static QueryStatsStore& get(ServiceContext* serviceContext);
+
+    /**
+     * Adds 'execution' to the statistics of the shape 'shapeKey' on 'ns'. If the shape is new, a
+     * copy of 'shape' is kept to describe it. Evicts the least recently executed shapes of the
+     * partition until the store fits within 'budgetBytes'.
+     */
+    void record(StringData ns,
+                StringData shapeKey,
+                const BSONObj& shape,
+                const Execution& execution,
+                size_t budgetBytes);
+
+    /**
+     * Returns a document describing each shape recorded on 'ns'.
+     */
+    std::vector<BSONObj> getStats(StringData ns) const;
+
+    /**
+     * Forgets the shapes recorded on 'ns'.
+     */
+    void collectionDropped(StringData ns);
+
+    void clear();
+
+    size_t sizeBytes() const;
+
+private:
+    static const int kNumPartitions = 16;
+
+    struct Entry {
+        std::string key;
+        std::string ns;
+        std::string shapeKey;
+        BSONObj shape;
+        Date_t firstSeen;
+        Date_t lastSeen;
+        long long count = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        OperationLatencyHistogram latency;
+        size_t sizeBytes = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    struct Partition {
+        mutable stdx::mutex mutex;
+
+        // Ordered from most to least recently executed.
+        EntryList entries;
+        stdx::unordered_map<std::string, EntryList::iterator> index;
+        size_t sizeBytes = 0;
+
+        // Keeps the mutexes of neighbouring partitions off the same cache line.
+        char padding[64];
+    };
+
+    static void _evictUntilWithin_inlock(Partition* partition, size_t budgetBytes);
+
+    Partition _partitions[kNumPartitions];
+};
+
+}  // namespace mongo
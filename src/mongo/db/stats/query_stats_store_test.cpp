@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/stats/query_stats_store.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const size_t kLargeBudget = 64 * 1024 * 1024;
+
+QueryStatsStore::Execution makeExecution(uint64_t micros, long long docsExamined) {
+    QueryStatsStore::Execution execution;
+    execution.micros = micros;
+    execution.docsExamined = docsExamined;
+    execution.keysExamined = 2 * docsExamined;
+    execution.nreturned = 1;
+    return execution;
+}
+
+TEST(QueryStatsStoreTest, AggregatesExecutionsOfTheSameShape) {
+    QueryStatsStore store;
+    store.record(
+        "test.coll", "eqa", BSON("query" << BSON("a" << 1)), makeExecution(10, 5), kLargeBudget);
+    store.record(
+        "test.coll", "eqa", BSON("query" << BSON("a" << 2)), makeExecution(30, 7), kLargeBudget);
+
+    auto stats = store.getStats("test.coll");
+    ASSERT_EQUALS(stats.size(), 1U);
+    const auto& entry = stats.front();
+    ASSERT_BSONOBJ_EQ(entry["queryShape"].Obj(), BSON("query" << BSON("a" << 1)));
+    ASSERT_EQUALS(entry["planCacheKey"].String(), "eqa");
+    ASSERT_EQUALS(entry["count"].numberLong(), 2);
+    ASSERT_EQUALS(entry["docsExamined"].numberLong(), 12);
+    ASSERT_EQUALS(entry["keysExamined"].numberLong(), 24);
+    ASSERT_EQUALS(entry["nreturned"].numberLong(), 2);
+    ASSERT_EQUALS(entry["latencyStats"]["reads"]["ops"].numberLong(), 2);
+    ASSERT_EQUALS(entry["latencyStats"]["reads"]["latency"].numberLong(), 40);
+    ASSERT_EQUALS(entry["latencyStats"]["reads"]["histogram"].Array().size(), 2U);
+}
+
+TEST(QueryStatsStoreTest, KeepsShapesOfDifferentCollectionsApart) {
+    QueryStatsStore store;
+    store.record("test.a", "eqa", BSONObj(), makeExecution(10, 1), kLargeBudget);
+    store.record("test.b", "eqa", BSONObj(), makeExecution(10, 1), kLargeBudget);
+    store.record("test.b", "eqb", BSONObj(), makeExecution(10, 1), kLargeBudget);
+
+    ASSERT_EQUALS(store.getStats("test.a").size(), 1U);
+    ASSERT_EQUALS(store.getStats("test.b").size(), 2U);
+    ASSERT_EQUALS(store.getStats("test.c").size(), 0U);
+}
+
+TEST(QueryStatsStoreTest, ForgetsShapesOfDroppedCollections) {
+    QueryStatsStore store;
+    store.record("test.a", "eqa", BSONObj(), makeExecution(10, 1), kLargeBudget);
+    store.record("test.b", "eqa", BSONObj(), makeExecution(10, 1), kLargeBudget);
+    const size_t sizeBytes = store.sizeBytes();
+
+    store.collectionDropped("test.a");
+    ASSERT_EQUALS(store.getStats("test.a").size(), 0U);
+    ASSERT_EQUALS(store.getStats("test.b").size(), 1U);
+    ASSERT_LESS_THAN(store.sizeBytes(), sizeBytes);
+}
+
+TEST(QueryStatsStoreTest, StaysWithinBudget) {
+    QueryStatsStore store;
+    const size_t budgetBytes = 256 * 1024;
+    for (int i = 0; i < 10000; ++i) {
+        store.record("test.coll",
+                     std::string(str::stream() << "shape" << i),
+                     BSON("query" << BSON("a" << i)),
+                     makeExecution(1, 1),
+                     budgetBytes);
+        ASSERT_LESS_THAN_OR_EQUALS(store.sizeBytes(), budgetBytes);
+    }
+
+    auto stats = store.getStats("test.coll");
+    ASSERT_GREATER_THAN(stats.size(), 0U);
+    ASSERT_LESS_THAN(stats.size(), 10000U);
+
+    store.clear();
+    ASSERT_EQUALS(store.sizeBytes(), 0U);
+    ASSERT_EQUALS(store.getStats("test.coll").size(), 0U);
+}
+
+TEST(QueryStatsStoreTest, EvictsLeastRecentlyExecutedShapes) {
+    QueryStatsStore store;
+    store.record("test.coll", "hot", BSONObj(), makeExecution(1, 1), kLargeBudget);
+    for (int i = 0; i < 1000; ++i) {
+        store.record("test.coll",
+                     std::string(str::stream() << "cold" << i),
+                     BSONObj(),
+                     makeExecution(1, 1),
+                     kLargeBudget);
+        store.record("test.coll", "hot", BSONObj(), makeExecution(1, 1), 64 * 1024);
+    }
+
+    bool foundHot = false;
+    for (auto&& entry : store.getStats("test.coll")) {
+        if (entry["planCacheKey"].String() == "hot") {
+            foundHot = true;
+            ASSERT_EQUALS(entry["count"].numberLong(), 1001);
+        }
+    }
+    ASSERT_TRUE(foundHot);
+}
+
+}  // namespace
+}  // namespace mongo
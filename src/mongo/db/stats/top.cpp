@@ -35,6 +35,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -67,6 +68,19 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       remove(older.remove, newer.remove),
       commands(older.commands, newer.commands) {}
 
+void Top::CollectionData::add(const CollectionData& other) {
+    total.add(other.total);
+    readLock.add(other.readLock);
+    writeLock.add(other.writeLock);
+    queries.add(other.queries);
+    getmore.add(other.getmore);
+    insert.add(other.insert);
+    update.add(other.update);
+    remove.add(other.remove);
+    commands.add(other.commands);
+    opLatencyHistogram.add(other.opLatencyHistogram);
+}
+
 // static
 Top& Top::get(ServiceContext* service) {
     return getTop(service);
@@ -83,14 +97,15 @@ void Top::record(OperationContext* txn,
         return;
 
     auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    Partition& partition = _getHomePartition();
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
 
-    if ((command || logicalOp == LogicalOp::opQuery) && ns == _lastDropped) {
-        _lastDropped = "";
+    if ((command || logicalOp == LogicalOp::opQuery) && ns == partition.lastDropped) {
+        partition.lastDropped = "";
         return;
     }
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = partition.usage[hashedNs];
     _record(txn, coll, logicalOp, lockType, micros, readWriteType);
 }
 
@@ -140,23 +155,46 @@ void Top::_record(OperationContext* txn,
 }
 
 void Top::collectionDropped(StringData ns, bool databaseDropped) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(ns);
+    auto hashedNs = UsageMap::HashedKey(ns);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        partition.usage.erase(hashedNs);
+    }
+
     if (!databaseDropped) {
         // If a collection drop occurred, there will be a subsequent call to record for this
-        // collection namespace which must be ignored. This does not apply to a database drop.
-        _lastDropped = ns.toString();
+        // collection namespace which must be ignored. This does not apply to a database drop. That
+        // call is made by the thread performing the drop, so it lands in this thread's partition.
+        Partition& partition = _getHomePartition();
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        partition.lastDropped = ns.toString();
     }
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out = _mergeUsage();
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    _appendToUsageMap(b, _mergeUsage());
+}
+
+Top::Partition& Top::_getHomePartition() {
+    const size_t threadHash = std::hash<stdx::thread::id>()(stdx::this_thread::get_id());
+    return _partitions[threadHash % kNumPartitions];
+}
+
+Top::UsageMap Top::_mergeUsage() const {
+    // Each partition is locked on its own, so the result may include an operation recorded in one
+    // partition but not one recorded concurrently in another.
+    UsageMap merged;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        for (auto&& entry : partition.usage) {
+            merged[entry.first].add(entry.second);
+        }
+    }
+    return merged;
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -199,9 +237,17 @@ void Top::_appendStatsEntry(BSONObjBuilder& b, const char* statsName, const Usag
 
 void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    OperationLatencyHistogram histogram;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        auto it = partition.usage.find(hashedNs);
+        if (it != partition.usage.end()) {
+            histogram.add(it->second.opLatencyHistogram);
+        }
+    }
+
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, &latencyStatsBuilder);
+    histogram.append(includeHistograms, &latencyStatsBuilder);
     builder->append("ns", ns);
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -209,13 +255,18 @@ void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuild
 void Top::incrementGlobalLatencyStats(OperationContext* txn,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(txn, latency, &_globalHistogramStats, readWriteType);
+    Partition& partition = _getHomePartition();
+    stdx::lock_guard<SimpleMutex> guard(partition.lock);
+    _incrementHistogram(txn, latency, &partition.globalHistogramStats, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, builder);
+    OperationLatencyHistogram histogram;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> guard(partition.lock);
+        histogram.add(partition.globalHistogramStats);
+    }
+    histogram.append(includeHistograms, builder);
 }
 
 void Top::_incrementHistogram(OperationContext* txn,
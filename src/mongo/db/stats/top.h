@@ -61,6 +61,11 @@ public:
             count++;
             time += micros;
         }
+
+        void add(const UsageData& other) {
+            count += other.count;
+            time += other.time;
+        }
     };
 
     struct CollectionData {
@@ -82,6 +87,11 @@ public:
         UsageData remove;
         UsageData commands;
         OperationLatencyHistogram opLatencyHistogram;
+
+        /**
+         * Adds the usage recorded in 'other' to this one.
+         */
+        void add(const CollectionData& other);
     };
 
     typedef StringMap<CollectionData> UsageMap;
@@ -119,6 +129,26 @@ public:
     void appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
 
 private:
+    // Usage is recorded into one of several partitions, each with its own lock, so that operations
+    // running on different threads rarely contend on the same mutex. A thread always records into
+    // the partition its id hashes to, and readers combine the partitions when they are asked for
+    // statistics.
+    struct Partition {
+        SimpleMutex lock;
+        OperationLatencyHistogram globalHistogramStats;
+        UsageMap usage;
+        std::string lastDropped;
+    };
+
+    static const size_t kNumPartitions = 16;
+
+    Partition& _getHomePartition();
+
+    /**
+     * Returns the usage of every namespace summed over all partitions.
+     */
+    UsageMap _mergeUsage() const;
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -135,10 +165,7 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
-    std::string _lastDropped;
+    mutable Partition _partitions[kNumPartitions];
 };
 
 }  // namespace mongo
@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/jsobj.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/unittest/unittest.h"
 
@@ -39,4 +40,42 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped("coll");
 }
 
+TEST(TopTest, CollectionDataAddSumsUsage) {
+    Top::CollectionData first, second;
+    first.total.inc(10);
+    first.writeLock.inc(10);
+    first.insert.inc(10);
+    second.total.inc(5);
+    second.readLock.inc(5);
+    second.queries.inc(5);
+    second.opLatencyHistogram.increment(5, Command::ReadWriteType::kRead);
+
+    first.add(second);
+
+    ASSERT_EQUALS(first.total.count, 2);
+    ASSERT_EQUALS(first.total.time, 15);
+    ASSERT_EQUALS(first.writeLock.count, 1);
+    ASSERT_EQUALS(first.readLock.count, 1);
+    ASSERT_EQUALS(first.insert.time, 10);
+    ASSERT_EQUALS(first.queries.time, 5);
+
+    BSONObjBuilder latencyBuilder;
+    first.opLatencyHistogram.append(false, &latencyBuilder);
+    ASSERT_EQUALS(latencyBuilder.obj()["reads"]["ops"].Long(), 1);
+}
+
+TEST(TopTest, GlobalLatencyStatsStartEmpty) {
+    Top top;
+    Top::UsageMap usage;
+    top.cloneMap(usage);
+    ASSERT_TRUE(usage.empty());
+
+    BSONObjBuilder latencyBuilder;
+    top.appendGlobalLatencyStats(false, &latencyBuilder);
+    BSONObj latency = latencyBuilder.obj();
+    ASSERT_EQUALS(latency["reads"]["ops"].Long(), 0);
+    ASSERT_EQUALS(latency["writes"]["ops"].Long(), 0);
+    ASSERT_EQUALS(latency["commands"]["ops"].Long(), 0);
+}
+
 }  // namespace
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_event_profile.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/threadlocal.h"
+
+namespace mongo {
+
+namespace {
+
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL WaitEventProfile* currentThreadProfile = nullptr;
+
+}  // namespace
+
+StringData waitEventName(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicket:
+            return "ticket"_sd;
+        case WaitEvent::kLock:
+            return "lock"_sd;
+        case WaitEvent::kYield:
+            return "yield"_sd;
+        case WaitEvent::kWriteConflict:
+            return "writeConflict"_sd;
+        case WaitEvent::kJournal:
+            return "journal"_sd;
+        case WaitEvent::kReplication:
+            return "replication"_sd;
+        case WaitEvent::kNumWaitEvents:
+            break;
+    }
+    MONGO_UNREACHABLE;
+}
+
+WaitEventProfile* WaitEventProfile::getForCurrentThread() {
+    return currentThreadProfile;
+}
+
+void WaitEventProfile::append(BSONObjBuilder* builder) const {
+    for (int i = 0; i < static_cast<int>(WaitEvent::kNumWaitEvents); i++) {
+        const auto count = _events[i].count.load();
+        if (count == 0) {
+            continue;
+        }
+
+        BSONObjBuilder eventBuilder(builder->subobjStart(waitEventName(static_cast<WaitEvent>(i))));
+        eventBuilder.append("count", static_cast<long long>(count));
+        eventBuilder.append("micros", static_cast<long long>(_events[i].micros.load()));
+    }
+}
+
+ScopedWaitEventProfile::ScopedWaitEventProfile(WaitEventProfile* profile)
+    : _previous(currentThreadProfile) {
+    currentThreadProfile = profile;
+}
+
+ScopedWaitEventProfile::~ScopedWaitEventProfile() {
+    currentThreadProfile = _previous;
+}
+
+}  // namespace mongo
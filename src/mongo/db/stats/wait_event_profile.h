@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The kinds of waits whose duration is broken out in a WaitEventProfile.
+ */
+enum class WaitEvent {
+    kTicket,             // Waiting for a read or write ticket before taking the global lock.
+    kLock,               // Waiting for a lock manager lock to be granted.
+    kYield,              // Releasing and reacquiring locks during a query yield.
+    kWriteConflict,      // Backing off before retrying after a write conflict.
+    kJournal,            // Waiting for writes to become durable for a write concern.
+    kReplication,        // Waiting for writes to replicate for a write concern.
+    kNumWaitEvents
+};
+
+/**
+ * Returns the name a wait event is reported under.
+ */
+StringData waitEventName(WaitEvent event);
+
+/**
+ * How often and for how long a sampled operation waited on each WaitEvent. Only the thread running
+ * the operation records into a profile, but currentOp may read it concurrently, so the counters
+ * are atomic.
+ *
+ * A profile collects waits once it is installed on the running thread with a
+ * ScopedWaitEventProfile. Code that may block marks the wait with a ScopedWaitEvent, which costs a
+ * single thread-local read when the operation was not sampled.
+ */
+class WaitEventProfile {
+    MONGO_DISALLOW_COPYING(WaitEventProfile);
+
+public:
+    WaitEventProfile() = default;
+
+    /**
+     * Returns the profile installed on the calling thread, or nullptr if there is none.
+     */
+    static WaitEventProfile* getForCurrentThread();
+
+    void record(WaitEvent event, uint64_t micros) {
+        auto& counters = _events[static_cast<int>(event)];
+        counters.count.fetchAndAdd(1);
+        counters.micros.fetchAndAdd(micros);
+    }
+
+    /**
+     * Appends a {count, micros} subdocument for each event that was waited on at least once.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+private:
+    friend class ScopedWaitEventProfile;
+
+    struct Counters {
+        AtomicUInt64 count;
+        AtomicUInt64 micros;
+    };
+
+    Counters _events[static_cast<int>(WaitEvent::kNumWaitEvents)];
+};
+
+/**
+ * Charges the waits of the calling thread to 'profile' for the lifetime of this object. Passing
+ * nullptr stops collection. The previously installed profile is restored on destruction.
+ */
+class ScopedWaitEventProfile {
+    MONGO_DISALLOW_COPYING(ScopedWaitEventProfile);
+
+public:
+    explicit ScopedWaitEventProfile(WaitEventProfile* profile);
+    ~ScopedWaitEventProfile();
+
+private:
+    WaitEventProfile* const _previous;
+};
+
+/**
+ * Charges the time between construction and destruction to 'event' in the profile installed on
+ * the calling thread, if any.
+ */
+class ScopedWaitEvent {
+    MONGO_DISALLOW_COPYING(ScopedWaitEvent);
+
+public:
+    explicit ScopedWaitEvent(WaitEvent event)
+        : _profile(WaitEventProfile::getForCurrentThread()), _event(event) {
+        if (_profile) {
+            _startMicros = curTimeMicros64();
+        }
+    }
+
+    ~ScopedWaitEvent() {
+        if (_profile) {
+            _profile->record(_event, curTimeMicros64() - _startMicros);
+        }
+    }
+
+private:
+    WaitEventProfile* const _profile;
+    const WaitEvent _event;
+    uint64_t _startMicros = 0;
+};
+
+}  // namespace mongo
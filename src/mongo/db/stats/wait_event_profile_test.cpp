@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_event_profile.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(WaitEventProfile, NothingRecordedWithoutInstalledProfile) {
+    ASSERT_FALSE(WaitEventProfile::getForCurrentThread());
+    { ScopedWaitEvent wait(WaitEvent::kLock); }
+    ASSERT_FALSE(WaitEventProfile::getForCurrentThread());
+}
+
+TEST(WaitEventProfile, ScopedWaitEventRecordsIntoInstalledProfile) {
+    WaitEventProfile profile;
+    {
+        ScopedWaitEventProfile scopedProfile(&profile);
+        ASSERT_EQUALS(WaitEventProfile::getForCurrentThread(), &profile);
+        { ScopedWaitEvent wait(WaitEvent::kTicket); }
+        { ScopedWaitEvent wait(WaitEvent::kTicket); }
+        { ScopedWaitEvent wait(WaitEvent::kJournal); }
+    }
+    ASSERT_FALSE(WaitEventProfile::getForCurrentThread());
+
+    BSONObjBuilder builder;
+    profile.append(&builder);
+    BSONObj waits = builder.obj();
+    ASSERT_EQUALS(waits.nFields(), 2);
+    ASSERT_EQUALS(waits["ticket"]["count"].numberLong(), 2);
+    ASSERT_GREATER_THAN_OR_EQUALS(waits["ticket"]["micros"].numberLong(), 0);
+    ASSERT_EQUALS(waits["journal"]["count"].numberLong(), 1);
+}
+
+TEST(WaitEventProfile, NestedScopesRestoreThePreviousProfile) {
+    WaitEventProfile outer;
+    ScopedWaitEventProfile scopedOuter(&outer);
+    {
+        // Collection is paused while no profile is installed.
+        ScopedWaitEventProfile scopedNone(nullptr);
+        ScopedWaitEvent wait(WaitEvent::kYield);
+    }
+    ASSERT_EQUALS(WaitEventProfile::getForCurrentThread(), &outer);
+
+    outer.record(WaitEvent::kReplication, 25);
+
+    BSONObjBuilder builder;
+    outer.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("replication" << BSON("count" << 1LL << "micros" << 25LL)));
+}
+
+}  // namespace
+}  // namespace mongo
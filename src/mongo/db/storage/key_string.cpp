@@ -233,6 +233,18 @@ void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+
+    // Descending keys and negative numbers flip every byte they append, so do as much of the work
+    // as possible a word at a time. memcpy() avoids any alignment requirements on either buffer.
+    while (static_cast<size_t>(end - input) >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, input, sizeof(word));
+        word = ~word;
+        memcpy(output, &word, sizeof(word));
+        input += sizeof(word);
+        output += sizeof(word);
+    }
+
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/unittest/benchmark.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+/**
+ * Returns an index key of the kind chosen by 'kind': 0 for an int, 1 for a short string, 2 for a
+ * compound key of an int, a double and a string.
+ */
+BSONObj makeKey(std::int64_t kind) {
+    switch (kind) {
+        case 0:
+            return BSON("" << 123456);
+        case 1:
+            return BSON(""
+                        << "user@example.com");
+        default:
+            return BSON("" << 42 << "" << 3.25 << ""
+                           << "status");
+    }
+}
+
+void BM_keyStringEncode(benchmark::State& state) {
+    const BSONObj key = makeKey(state.arg());
+    const RecordId recordId(987654321);
+    KeyString keyString(KeyString::Version::V1);
+    while (state.keepRunning()) {
+        keyString.resetToKey(key, kAllAscending, recordId);
+        benchmark::doNotOptimize(keyString.getBuffer());
+    }
+}
+MONGO_BENCHMARK(BM_keyStringEncode)->arg(0)->arg(1)->arg(2);
+
+void BM_keyStringDecode(benchmark::State& state) {
+    const KeyString keyString(KeyString::Version::V1, makeKey(state.arg()), kAllAscending);
+    while (state.keepRunning()) {
+        BSONObj key = KeyString::toBson(keyString.getBuffer(),
+                                        keyString.getSize(),
+                                        kAllAscending,
+                                        keyString.getTypeBits());
+        benchmark::doNotOptimize(key.objdata());
+    }
+}
+MONGO_BENCHMARK(BM_keyStringDecode)->arg(0)->arg(1)->arg(2);
+
+void BM_keyStringCompare(benchmark::State& state) {
+    const KeyString lhs(KeyString::Version::V1, makeKey(state.arg()), kAllAscending);
+    const KeyString rhs(KeyString::Version::V1, makeKey(state.arg()), kAllAscending, RecordId(1));
+    while (state.keepRunning()) {
+        benchmark::doNotOptimize(lhs.compare(rhs));
+    }
+}
+MONGO_BENCHMARK(BM_keyStringCompare)->arg(0)->arg(1)->arg(2);
+
+}  // namespace
+}  // namespace mongo
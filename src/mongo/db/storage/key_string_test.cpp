@@ -196,6 +196,23 @@ TEST_F(KeyStringTest, AllTypesSimple) {
     ROUNDTRIP(version, BSON("" << 1235123123123LL));
 }
 
+TEST_F(KeyStringTest, StringsOfEveryLengthAroundWordSize) {
+    // Descending keys invert their bytes a word at a time, with a byte-wise tail. Cover strings
+    // whose lengths exercise every possible tail, with and without embedded NULs.
+    std::string str;
+    BSONObj prev;
+    for (int len = 0; len < 40; ++len) {
+        const BSONObj obj = BSON("" << str);
+        ROUNDTRIP(version, obj);
+        ROUNDTRIP(version, BSON("" << BSONBinData(str.data(), str.size(), BinDataGeneral)));
+        if (!prev.isEmpty()) {
+            COMPARES_SAME(version, prev, obj);
+        }
+        prev = obj;
+        str.push_back(len % 7 == 3 ? '\0' : static_cast<char>('a' + len % 26));
+    }
+}
+
 TEST_F(KeyStringTest, Array1) {
     BSONObj emptyArray = BSON("" << BSONArray());
 
@@ -399,13 +399,19 @@ Status KVCatalog::newCollection(OperationContext* opCtx,
 
     const string ident = _newUniqueIdent(ns, "collection");
 
-    stdx::lock_guard<stdx::mutex> lk(_identsLock);
-    Entry& old = _idents[ns.toString()];
-    if (!old.ident.empty()) {
-        return Status(ErrorCodes::NamespaceExists, "collection already exists");
-    }
+    // Reserve the entry, but do not hold '_identsLock' while writing the catalog record, so that
+    // lookups for other collections are not stuck behind this write. The exclusive database lock
+    // keeps anyone else from using 'ns' until the entry is complete.
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        Entry& old = _idents[ns.toString()];
+        if (!old.ident.empty()) {
+            return Status(ErrorCodes::NamespaceExists, "collection already exists");
+        }
 
-    opCtx->recoveryUnit()->registerChange(new AddIdentChange(this, ns));
+        opCtx->recoveryUnit()->registerChange(new AddIdentChange(this, ns));
+        old = Entry(ident, RecordId());
+    }
 
     BSONObj obj;
     {
@@ -423,7 +429,10 @@ Status KVCatalog::newCollection(OperationContext* opCtx,
     if (!res.isOK())
         return res.getStatus();
 
-    old = Entry(ident, res.getValue());
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        _idents[ns.toString()].storedLoc = res.getValue();
+    }
     LOG(1) << "stored meta data for " << ns << " @ " << res.getValue();
     return Status::OK();
 }
@@ -580,17 +589,22 @@ Status KVCatalog::dropCollection(OperationContext* opCtx, StringData ns) {
         rLk.reset(new Lock::ResourceLock(opCtx->lockState(), resourceIdCatalogMetadata, MODE_X));
     }
 
-    stdx::lock_guard<stdx::mutex> lk(_identsLock);
-    const NSToIdentMap::iterator it = _idents.find(ns.toString());
-    if (it == _idents.end()) {
-        return Status(ErrorCodes::NamespaceNotFound, "collection not found");
-    }
+    RecordId loc;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        const NSToIdentMap::iterator it = _idents.find(ns.toString());
+        if (it == _idents.end()) {
+            return Status(ErrorCodes::NamespaceNotFound, "collection not found");
+        }
 
-    opCtx->recoveryUnit()->registerChange(new RemoveIdentChange(this, ns, it->second));
+        opCtx->recoveryUnit()->registerChange(new RemoveIdentChange(this, ns, it->second));
+        loc = it->second.storedLoc;
+        _idents.erase(it);
+    }
 
-    LOG(1) << "deleting metadata for " << ns << " @ " << it->second.storedLoc;
-    _rs->deleteRecord(opCtx, it->second.storedLoc);
-    _idents.erase(it);
+    // As in newCollection(), the catalog record is written without holding '_identsLock'.
+    LOG(1) << "deleting metadata for " << ns << " @ " << loc;
+    _rs->deleteRecord(opCtx, loc);
 
     return Status::OK();
 }
@@ -110,6 +110,21 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * See StorageEngine::beginNonBlockingBackup for details
+     */
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* txn) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "The current storage engine doesn't support non-blocking backups");
+    }
+
+    /**
+     * See StorageEngine::endNonBlockingBackup for details
+     */
+    virtual void endNonBlockingBackup(OperationContext* txn) {
+        MONGO_UNREACHABLE;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -126,6 +126,19 @@ public:
         wuow.commit();
     }
 
+    void updateWithDamagesAndCommit(RecordId id, const char* damageSource, size_t offset) {
+        auto op = makeOperation();
+        WriteUnitOfWork wuow(op);
+        mutablebson::DamageVector damages;
+        damages.push_back(mutablebson::DamageEvent());
+        damages.back().sourceOffset = 0;
+        damages.back().targetOffset = offset;
+        damages.back().size = strlen(damageSource);
+        ASSERT_OK(
+            rs->updateWithDamages(op, id, rs->dataFor(op, id), damageSource, damages).getStatus());
+        wuow.commit();
+    }
+
     void deleteRecordAndCommit(RecordId id) {
         auto op = makeOperation();
         WriteUnitOfWork wuow(op);
@@ -335,8 +348,11 @@ TEST_F(SnapshotManagerTests, UpdateAndDelete) {
     updateRecordAndCommit(id, "Cat");
     auto snapCat = prepareAndCreateSnapshot();
 
-    // Untested since no engine currently supports both updateWithDamanges and snapshots.
-    ASSERT(!rs->updateWithDamagesSupported());
+    boost::optional<SnapshotName> snapCow;
+    if (rs->updateWithDamagesSupported()) {
+        updateWithDamagesAndCommit(id, "ow", 1);
+        snapCow = prepareAndCreateSnapshot();
+    }
 
     deleteRecordAndCommit(id);
     auto snapAfterDelete = prepareAndCreateSnapshot();
@@ -353,6 +369,12 @@ TEST_F(SnapshotManagerTests, UpdateAndDelete) {
     ASSERT_EQ(itCountCommitted(), 1);
     ASSERT_EQ(readStringCommitted(id), "Cat");
 
+    if (snapCow) {
+        snapshotManager->setCommittedSnapshot(*snapCow);
+        ASSERT_EQ(itCountCommitted(), 1);
+        ASSERT_EQ(readStringCommitted(id), "Cow");
+    }
+
     snapshotManager->setCommittedSnapshot(snapAfterDelete);
     ASSERT_EQ(itCountCommitted(), 0);
     ASSERT(!readRecordCommitted(id));
@@ -256,6 +256,7 @@ int KVStorageEngine::flushAllFiles(OperationContext* txn, bool sync) {
 }
 
 Status KVStorageEngine::beginBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
     // We should not proceed if we are already in backup mode
     if (_inBackupMode)
         return Status(ErrorCodes::BadValue, "Already in Backup Mode");
@@ -266,12 +267,32 @@ Status KVStorageEngine::beginBackup(OperationContext* txn) {
 }
 
 void KVStorageEngine::endBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
     // We should never reach here if we aren't already in backup mode
     invariant(_inBackupMode);
     _engine->endBackup(txn);
     _inBackupMode = false;
 }
 
+StatusWith<std::vector<std::string>> KVStorageEngine::beginNonBlockingBackup(
+    OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
+    // Both kinds of backup hold the same storage engine resources, so only one may be active.
+    if (_inBackupMode)
+        return Status(ErrorCodes::BadValue, "Already in Backup Mode");
+    auto files = _engine->beginNonBlockingBackup(txn);
+    if (files.isOK())
+        _inBackupMode = true;
+    return files;
+}
+
+void KVStorageEngine::endNonBlockingBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
+    invariant(_inBackupMode);
+    _engine->endNonBlockingBackup(txn);
+    _inBackupMode = false;
+}
+
 bool KVStorageEngine::isDurable() const {
     return _engine->isDurable();
 }
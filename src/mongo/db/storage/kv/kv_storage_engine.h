@@ -99,6 +99,10 @@ public:
 
     virtual void endBackup(OperationContext* txn);
 
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* txn);
+
+    virtual void endNonBlockingBackup(OperationContext* txn);
+
     virtual bool isDurable() const;
 
     virtual bool isEphemeral() const;
@@ -146,6 +150,10 @@ private:
     DBMap _dbs;
     mutable stdx::mutex _dbsLock;
 
+    // Protects _inBackupMode. A non-blocking backup is not serialized by the global lock the way
+    // fsyncLock is, so concurrent callers may race to start one.
+    stdx::mutex _backupMutex;
+
     // Flag variable that states if the storage engine is in backup mode.
     bool _inBackupMode = false;
 };
@@ -138,9 +138,9 @@ enum {
     NumCommitsBeforeRemap = 10,
 
     // How many outstanding journal flushes should be allowed before applying writer back
-    // pressure. Size of 1 allows two journal blocks to be in the process of being written -
-    // one on the journal writer's buffer and one blocked waiting to be picked up.
-    NumAsyncJournalWrites = 1,
+    // pressure. Size of 2 lets one commit group be applied to the shared view while the next
+    // one is being compressed and written to the journal.
+    NumAsyncJournalWrites = 2,
 };
 
 // Remap loop state
@@ -73,6 +73,34 @@ void WRITETODATAFILES(OperationContext* txn,
     LOG(4) << "journal WRITETODATAFILES " << m / 1000.0 << "ms";
 }
 
+/**
+ * Runs the body of one of the journal threads. The journal cannot recover from a failure in
+ * either of them, so any exception shuts the process down.
+ */
+void runJournalThread(const char* threadName, stdx::function<void()> body) {
+    try {
+        body();
+    } catch (const DBException& e) {
+        severe() << "dbexception in " << threadName << " causing immediate shutdown: " << redact(e);
+        invariant(false);
+    } catch (const std::ios_base::failure& e) {
+        severe() << "ios_base exception in " << threadName
+                 << " causing immediate shutdown: " << e.what();
+        invariant(false);
+    } catch (const std::bad_alloc& e) {
+        severe() << "bad_alloc exception in " << threadName
+                 << " causing immediate shutdown: " << e.what();
+        invariant(false);
+    } catch (const std::exception& e) {
+        severe() << "exception in " << threadName
+                 << " causing immediate shutdown: " << redact(e.what());
+        invariant(false);
+    } catch (...) {
+        severe() << "unhandled exception in " << threadName << " causing immediate shutdown";
+        invariant(false);
+    }
+}
+
 }  // namespace
 
 
@@ -119,13 +147,16 @@ JournalWriter::JournalWriter(CommitNotifier* commitNotify,
       _shutdownRequested(false),
       _journalQueue(numBuffers),
       _lastCommitNumber(0),
+      _applyQueue(numBuffers),
       _readyQueue(numBuffers) {
     invariant(_journalQueue.maxSize() == _readyQueue.maxSize());
+    invariant(_applyQueue.maxSize() == _readyQueue.maxSize());
 }
 
 JournalWriter::~JournalWriter() {
     // Never close the journal writer with outstanding or unaccounted writes
     invariant(_journalQueue.empty());
+    invariant(_applyQueue.empty());
     invariant(_readyQueue.empty());
 }
 
@@ -138,9 +169,12 @@ void JournalWriter::start() {
         _readyQueue.push(new Buffer(InitialBufferSizeBytes));
     }
 
-    // Start the thread
-    stdx::thread t(stdx::bind(&JournalWriter::_journalWriterThread, this));
-    _journalWriterThreadHandle.swap(t);
+    // Start the threads
+    stdx::thread applyThread(stdx::bind(&JournalWriter::_journalApplyThread, this));
+    _journalApplyThreadHandle.swap(applyThread);
+
+    stdx::thread writerThread(stdx::bind(&JournalWriter::_journalWriterThread, this));
+    _journalWriterThreadHandle.swap(writerThread);
 }
 
 void JournalWriter::shutdown() {
@@ -154,12 +188,13 @@ void JournalWriter::shutdown() {
     Buffer* const shutdownBuffer = newBuffer();
     shutdownBuffer->_setShutdown();
 
-    // This will terminate the journal thread. No need to specify commit number, since we are
+    // This will terminate the journal threads. No need to specify commit number, since we are
     // shutting down and nothing will be notified anyways.
     writeBuffer(shutdownBuffer, 0);
 
-    // Ensure the journal thread has stopped and everything accounted for.
+    // Ensure the journal threads have stopped and everything accounted for.
     _journalWriterThreadHandle.join();
+    _journalApplyThreadHandle.join();
     assertIdle();
 
     // Delete the buffers (this deallocates the journal buffer memory)
@@ -172,6 +207,7 @@ void JournalWriter::shutdown() {
 void JournalWriter::assertIdle() {
     // All buffers are in the ready queue means there is nothing pending.
     invariant(_journalQueue.empty());
+    invariant(_applyQueue.empty());
     invariant(_readyQueue.count() == _readyQueue.maxSize());
 }
 
@@ -211,15 +247,16 @@ void JournalWriter::_journalWriterThread() {
 
     log() << "Journal writer thread started";
 
-    try {
+    runJournalThread("journalWriterThread", [this] {
         while (true) {
             Buffer* const buffer = _journalQueue.blockingPop();
-            BufferGuard bufferGuard(buffer, &_readyQueue);
 
             if (buffer->_isShutdown) {
                 invariant(buffer->_builder.len() == 0);
 
-                // The journal writer thread is terminating. Nothing to notify or write.
+                // The journal writer thread is terminating. Nothing to notify or write, but the
+                // journal apply thread needs to terminate too.
+                _applyQueue.push(buffer);
                 break;
             }
 
@@ -228,7 +265,7 @@ void JournalWriter::_journalWriterThread() {
 
                 // There's nothing to be writen, but we still need to notify this commit number
                 _commitNotify->notifyAll(buffer->_commitNumber);
-                _applyToDataFilesNotify->notifyAll(buffer->_commitNumber);
+                _applyQueue.push(buffer);
                 continue;
             }
 
@@ -244,35 +281,39 @@ void JournalWriter::_journalWriterThread() {
             dur::getJournalListener()->onDurable(buffer->journalListenerToken);
             _commitNotify->notifyAll(buffer->_commitNumber);
 
-            // Apply the journal entries on top of the shared view so that when flush is
-            // requested it would write the latest.
-            WRITETODATAFILES(cc().makeOperationContext().get(), buffer->_header, buffer->_builder);
+            // This never blocks, because the apply queue can hold all the buffers.
+            _applyQueue.push(buffer);
+        }
+    });
+
+    log() << "Journal writer thread stopped";
+}
+
+void JournalWriter::_journalApplyThread() {
+    Client::initThread("journal apply");
+
+    runJournalThread("journalApplyThread", [this] {
+        while (true) {
+            Buffer* const buffer = _applyQueue.blockingPop();
+            BufferGuard bufferGuard(buffer, &_readyQueue);
+
+            if (buffer->_isShutdown) {
+                // The journal apply thread is terminating. Nothing to notify or apply.
+                break;
+            }
+
+            if (!buffer->_isNoop) {
+                // Apply the journal entries on top of the shared view so that when flush is
+                // requested it would write the latest.
+                WRITETODATAFILES(
+                    cc().makeOperationContext().get(), buffer->_header, buffer->_builder);
+            }
 
             // Data is now persisted on the shared view, so notify any potential journal file
             // cleanup waiters.
             _applyToDataFilesNotify->notifyAll(buffer->_commitNumber);
         }
-    } catch (const DBException& e) {
-        severe() << "dbexception in journalWriterThread causing immediate shutdown: " << redact(e);
-        invariant(false);
-    } catch (const std::ios_base::failure& e) {
-        severe() << "ios_base exception in journalWriterThread causing immediate shutdown: "
-                 << e.what();
-        invariant(false);
-    } catch (const std::bad_alloc& e) {
-        severe() << "bad_alloc exception in journalWriterThread causing immediate shutdown: "
-                 << e.what();
-        invariant(false);
-    } catch (const std::exception& e) {
-        severe() << "exception in journalWriterThread causing immediate shutdown: "
-                 << redact(e.what());
-        invariant(false);
-    } catch (...) {
-        severe() << "unhandled exception in journalWriterThread causing immediate shutdown";
-        invariant(false);
-    }
-
-    log() << "Journal writer thread stopped";
+    });
 }
 
 
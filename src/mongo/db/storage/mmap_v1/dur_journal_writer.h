@@ -40,9 +40,13 @@ namespace mongo {
 namespace dur {
 
 /**
- * Manages the thread and queues used for writing the journal to disk and notify parties with
+ * Manages the threads and queues used for writing the journal to disk and notify parties with
  * are waiting on the write concern.
  *
+ * Buffers go through two threads in order: the journal writer thread compresses and writes them
+ * to the journal, and the journal apply thread then applies them to the shared view. With more
+ * than one buffer, applying a commit group overlaps with journaling the next one.
+ *
  * NOTE: Not thread-safe and must not be used from more than one thread.
  */
 class JournalWriter {
@@ -173,6 +177,7 @@ private:
 
 
     void _journalWriterThread();
+    void _journalApplyThread();
 
 
     // This gets notified as journal buffers are written. It is not owned and needs to outlive
@@ -182,8 +187,9 @@ private:
     // This gets notified as journal buffers are done being applied to the shared view
     CommitNotifier* const _applyToDataFilesNotify;
 
-    // Wraps and controls the journal writer thread
+    // Wrap and control the journal writer and journal apply threads
     stdx::thread _journalWriterThreadHandle;
+    stdx::thread _journalApplyThreadHandle;
 
     // Indicates that shutdown has been requested. Used for idempotency of the shutdown call.
     bool _shutdownRequested;
@@ -192,7 +198,11 @@ private:
     BufferQueue _journalQueue;
     CommitNotifier::When _lastCommitNumber;
 
-    // Queue of buffers, whose write has been completed by the journal writer thread.
+    // Queue of buffers, which have been written to the journal and need to be applied to the
+    // shared view by the journal apply thread.
+    BufferQueue _applyQueue;
+
+    // Queue of buffers, whose write and apply have been completed.
     BufferQueue _readyQueue;
 };
 
@@ -123,6 +123,82 @@ TEST(SortedDataInterface, ExhaustCursor) {
     }
 }
 
+// Exhaust a forward cursor while requesting less than the full key and RecordId of each entry,
+// and verify that the requested parts are still returned correctly.
+void testExhaustCursorWithPartialRequests(bool unique) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(unique));
+
+    int nToInsert = 10;
+    for (int i = 0; i < nToInsert; i++) {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            BSONObj key = BSON("" << i);
+            RecordId loc(42, i * 2);
+            ASSERT_OK(sorted->insert(opCtx.get(), key, loc, true));
+            uow.commit();
+        }
+    }
+
+    const auto kJustExistance = SortedDataInterface::Cursor::kJustExistance;
+    const auto kWantKey = SortedDataInterface::Cursor::kWantKey;
+    const auto kWantLoc = SortedDataInterface::Cursor::kWantLoc;
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+        int count = 0;
+        for (auto entry = cursor->seek(kMinBSONKey, true, kJustExistance); entry;
+             entry = cursor->next(kJustExistance)) {
+            ++count;
+        }
+        ASSERT_EQ(nToInsert, count);
+    }
+
+    // Alternate between the different requests, so that each entry is decoded after one which
+    // was only partially decoded.
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+        for (int i = 0; i < nToInsert; i++) {
+            switch (i % 3) {
+                case 0: {
+                    auto entry = i == 0 ? cursor->seek(kMinBSONKey, true, kWantLoc)
+                                        : cursor->next(kWantLoc);
+                    ASSERT(entry);
+                    ASSERT_EQ(RecordId(42, i * 2), entry->loc);
+                    break;
+                }
+                case 1: {
+                    auto entry = cursor->next(kWantKey);
+                    ASSERT(entry);
+                    ASSERT_BSONOBJ_EQ(BSON("" << i), entry->key);
+                    break;
+                }
+                case 2: {
+                    ASSERT(cursor->next(kJustExistance));
+
+                    // Restoring from a position which was not decoded must not lose our place.
+                    cursor->save();
+                    cursor->restore();
+                    break;
+                }
+            }
+        }
+        ASSERT(!cursor->next(kJustExistance));
+    }
+}
+
+TEST(SortedDataInterface, ExhaustCursorWithPartialRequests) {
+    testExhaustCursorWithPartialRequests(false);
+}
+
+TEST(SortedDataInterface, ExhaustCursorWithPartialRequestsUnique) {
+    testExhaustCursorWithPartialRequests(true);
+}
+
 // Call advance() on a reverse cursor until it is exhausted.
 // When a cursor positioned at EOF is advanced, it stays at EOF.
 TEST(SortedDataInterface, ExhaustCursorReversed) {
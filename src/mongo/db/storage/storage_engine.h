@@ -244,6 +244,27 @@ public:
         return;
     }
 
+    /**
+     * Like beginBackup(), but writes may continue while the backup is taken. Returns the paths,
+     * relative to the dbpath, of the files forming a consistent copy of the data as of this call.
+     * Those files must be copied in full, and must stay intact until endNonBlockingBackup() is
+     * called, even as the storage engine keeps writing.
+     *
+     * Storage engines that do not support this feature should use the default implementation.
+     */
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* txn) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "The current storage engine doesn't support non-blocking backups");
+    }
+
+    /**
+     * Ends a backup started by beginNonBlockingBackup(), after which the storage engine may change
+     * or remove the files it returned.
+     */
+    virtual void endNonBlockingBackup(OperationContext* txn) {
+        return;
+    }
+
     /**
      * Recover as much data as possible from a potentially corrupt RecordStore.
      * This only recovers the record data, not indexes or anything else.
@@ -38,9 +38,11 @@
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/json.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/storage_options.h"
@@ -138,6 +140,33 @@ StatusWith<std::string> WiredTigerIndex::parseIndexOptions(const BSONObj& option
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == "prefixCompression") {
+            if (!elem.isBoolean()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "'prefixCompression' must be a boolean, not "
+                                      << typeName(elem.type())};
+            }
+            ss << "prefix_compression=" << (elem.boolean() ? "true" : "false") << ',';
+        } else if (elem.fieldNameStringData() == "prefixCompressionMin") {
+            if (!elem.isNumber() || elem.numberLong() < 0) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "'prefixCompressionMin' must be a non-negative number: "
+                                      << elem};
+            }
+            ss << "prefix_compression_min=" << elem.numberLong() << ',';
+        } else if (elem.fieldNameStringData() == "blockCompressor") {
+            if (elem.type() != String) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "'blockCompressor' must be a string, not "
+                                      << typeName(elem.type())};
+            }
+            const StringData compressor = elem.valueStringData();
+            if (compressor != "none" && compressor != "snappy" && compressor != "zlib") {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "'blockCompressor' must be none, snappy or zlib: "
+                                      << compressor};
+            }
+            ss << "block_compressor=" << compressor << ',';
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -280,7 +309,9 @@ void WiredTigerIndex::unindex(OperationContext* txn,
 void WiredTigerIndex::fullValidate(OperationContext* txn,
                                    long long* numKeysOut,
                                    ValidateResults* fullResults) const {
-    if (fullResults && !WiredTigerRecoveryUnit::get(txn)->getSessionCache()->isEphemeral()) {
+    // Verifying needs exclusive access to the table, which a background validate doesn't have.
+    if (fullResults && !WiredTigerRecoveryUnit::get(txn)->getSessionCache()->isEphemeral() &&
+        txn->lockState()->isCollectionLockedForMode(_collectionNamespace, MODE_X)) {
         int err = WiredTigerUtil::verifyTable(txn, _uri, &(fullResults->errors));
         if (err == EBUSY) {
             const char* msg = "verify() returned EBUSY. Not treating as invalid.";
@@ -460,6 +491,9 @@ Status WiredTigerIndex::compact(OperationContext* txn) {
         UniqueWiredTigerSession session = cache->getSession();
         WT_SESSION* s = session->getSession();
         int ret = s->compact(s, uri().c_str(), "timeout=0");
+        if (ret == EBUSY) {
+            return wtRCToStatus(ret, "WiredTigerIndex::compact");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -670,7 +704,7 @@ public:
 
         if (!_lastMoveWasRestore)
             advanceWTCursor();
-        updatePosition(true);
+        updatePosition(parts, true);
         return curr(parts);
     }
 
@@ -701,7 +735,7 @@ public:
         // unique vs non-unique key formats since both start with the key.
         _query.resetToKey(finalKey, _idx.ordering(), discriminator);
         seekWTCursor(_query);
-        updatePosition();
+        updatePosition(parts);
         return curr(parts);
     }
 
@@ -715,7 +749,7 @@ public:
             _forward ? KeyString::kExclusiveBefore : KeyString::kExclusiveAfter;
         _query.resetToKey(key, _idx.ordering(), discriminator);
         seekWTCursor(_query);
-        updatePosition();
+        updatePosition(parts);
         return curr(parts);
     }
 
@@ -770,15 +804,16 @@ public:
     }
 
 protected:
-    // Called after _key has been filled in. Must not throw WriteConflictException.
-    virtual void updateIdAndTypeBits() = 0;
+    // Called after _key has been filled in. Only needs to decode the parts of the current entry
+    // which were requested; the others may be left unset. Must not throw WriteConflictException.
+    virtual void updateIdAndTypeBits(RequestedInfo parts) = 0;
 
     boost::optional<IndexKeyEntry> curr(RequestedInfo parts) const {
         if (_eof)
             return {};
 
         dassert(!atOrPastEndPointAfterSeeking());
-        dassert(!_id.isNull());
+        dassert(!(parts & kWantLoc) || !_id.isNull());
 
         BSONObj bson;
         if (TRACING_ENABLED || (parts & kWantKey)) {
@@ -859,8 +894,12 @@ protected:
      * This must be called after moving the cursor to update our cached position. It should not
      * be called after a restore that did not restore to original state since that does not
      * logically move the cursor until the following call to next().
+     *
+     * Only the parts of the new position in 'parts' are decoded, so that callers such as count
+     * scans, which only need to know whether an entry exists, skip decoding the RecordId and the
+     * TypeBits. The key itself is always kept because restore() needs it.
      */
-    void updatePosition(bool inNext = false) {
+    void updatePosition(RequestedInfo parts, bool inNext = false) {
         _lastMoveWasRestore = false;
         if (_cursorAtEof) {
             _eof = true;
@@ -907,7 +946,7 @@ protected:
             return;
         }
 
-        updateIdAndTypeBits();
+        updateIdAndTypeBits(TRACING_ENABLED ? kKeyAndLoc : parts);
     }
 
     OperationContext* _txn;
@@ -940,8 +979,13 @@ public:
     WiredTigerIndexStandardCursor(const WiredTigerIndex& idx, OperationContext* txn, bool forward)
         : WiredTigerIndexCursorBase(idx, txn, forward) {}
 
-    void updateIdAndTypeBits() override {
-        _id = KeyString::decodeRecordIdAtEnd(_key.getBuffer(), _key.getSize());
+    void updateIdAndTypeBits(RequestedInfo parts) override {
+        _id = (parts & kWantLoc) ? KeyString::decodeRecordIdAtEnd(_key.getBuffer(), _key.getSize())
+                                 : RecordId();
+
+        // The TypeBits are only needed to turn the KeyString back into a BSONObj.
+        if (!(parts & kWantKey))
+            return;
 
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
@@ -956,7 +1000,14 @@ public:
     WiredTigerIndexUniqueCursor(const WiredTigerIndex& idx, OperationContext* txn, bool forward)
         : WiredTigerIndexCursorBase(idx, txn, forward) {}
 
-    void updateIdAndTypeBits() override {
+    void updateIdAndTypeBits(RequestedInfo parts) override {
+        // Both the RecordId and the TypeBits are stored in the value, so there is nothing to skip
+        // unless neither of them is needed.
+        if (parts == kJustExistance) {
+            _id = RecordId();
+            return;
+        }
+
         // We assume that cursors can only ever see unique indexes in their "pristine" state,
         // where no duplicates are possible. The cases where dups are allowed should hold
         // sufficient locks to ensure that no cursor ever sees them.
@@ -987,7 +1038,7 @@ public:
         if (ret != WT_NOTFOUND)
             invariantWTOK(ret);
         _cursorAtEof = ret == WT_NOTFOUND;
-        updatePosition();
+        updatePosition(parts);
         dassert(_eof || _key.compare(_query) == 0);
         return curr(parts);
     }
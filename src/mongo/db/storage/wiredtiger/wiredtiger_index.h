@@ -48,6 +48,10 @@ public:
      * Parses index options for wired tiger configuration string suitable for table creation.
      * The document 'options' is typically obtained from the 'storageEngine.wiredTiger' field
      * of an IndexDescriptor's info object.
+     *
+     * Besides a raw 'configString', the prefix compression and block compression of the index
+     * can be chosen through the 'prefixCompression', 'prefixCompressionMin' and
+     * 'blockCompressor' fields. These override the server-wide index defaults.
      */
     static StatusWith<std::string> parseIndexOptions(const BSONObj& options);
 
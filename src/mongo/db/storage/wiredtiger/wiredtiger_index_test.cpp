@@ -150,5 +150,24 @@ TEST(WiredTigerIndexTest, GenerateCreateStringValidConfigStringOption) {
     ASSERT_EQ(WiredTigerIndex::parseIndexOptions(spec), std::string("prefix_compression=true,"));
 }
 
+TEST(WiredTigerIndexTest, GenerateCreateStringCompressionOptions) {
+    BSONObj spec = fromjson(
+        "{prefixCompression: false, prefixCompressionMin: 2, blockCompressor: 'zlib'}");
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(spec),
+              std::string("prefix_compression=false,prefix_compression_min=2,"
+                          "block_compressor=zlib,"));
+}
+
+TEST(WiredTigerIndexTest, GenerateCreateStringInvalidCompressionOptions) {
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{prefixCompression: 1}")),
+              ErrorCodes::TypeMismatch);
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{prefixCompressionMin: -1}")),
+              ErrorCodes::BadValue);
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{blockCompressor: 1}")),
+              ErrorCodes::TypeMismatch);
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{blockCompressor: 'lz4'}")),
+              ErrorCodes::BadValue);
+}
+
 }  // namespace
 }  // namespace mongo
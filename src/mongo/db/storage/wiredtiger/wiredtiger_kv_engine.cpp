@@ -37,6 +37,7 @@
 #define NVALGRIND
 #endif
 
+#include <limits>
 #include <memory>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -67,6 +68,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
@@ -87,6 +89,110 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+namespace {
+// Data handles for tables that have not been used for this many seconds are closed by the
+// WiredTiger sweep server, which releases the memory and file descriptors held for collections
+// and indexes that are opened at startup but never touched afterwards. Sweeping only starts once
+// more than 'wiredTigerFileHandleCloseMinimum' handles are open.
+int wiredTigerFileHandleCloseIdleTimeSecs = 100000;
+int wiredTigerFileHandleCloseMinimum = 250;
+int wiredTigerFileHandleCloseScanIntervalSecs = 10;
+
+class ExportedFileHandleCloseParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupOnly> {
+public:
+    ExportedFileHandleCloseParameter(StringData name, int* value, int minValue, int maxValue)
+        : ExportedServerParameter<int, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(), name.toString(), value),
+          _minValue(minValue),
+          _maxValue(maxValue) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        if (potentialNewValue < _minValue || potentialNewValue > _maxValue) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << name() << " must be between " << _minValue << " and "
+                                        << _maxValue
+                                        << ", inclusive");
+        }
+
+        return Status::OK();
+    }
+
+private:
+    const int _minValue;
+    const int _maxValue;
+};
+
+// The ranges WiredTiger accepts for the file_manager settings. A close_idle_time of 0 means that
+// handles are never closed, but the sweep server must scan at least once every 100000 seconds.
+ExportedFileHandleCloseParameter exportedFileHandleCloseIdleTimeSecsParam(
+    "wiredTigerFileHandleCloseIdleTimeSecs", &wiredTigerFileHandleCloseIdleTimeSecs, 0, 100000);
+ExportedFileHandleCloseParameter exportedFileHandleCloseMinimumParam(
+    "wiredTigerFileHandleCloseMinimum",
+    &wiredTigerFileHandleCloseMinimum,
+    0,
+    std::numeric_limits<int>::max());
+ExportedFileHandleCloseParameter exportedFileHandleCloseScanIntervalSecsParam(
+    "wiredTigerFileHandleCloseScanIntervalSecs",
+    &wiredTigerFileHandleCloseScanIntervalSecs,
+    1,
+    100000);
+
+// Percentages of the cache that may be dirty before eviction threads, and then application
+// threads, start writing dirty pages out. Lowering them spreads writes across the checkpoint
+// interval, leaving less for each checkpoint to flush at once. The defaults match WiredTiger's.
+// The target must also be below the trigger, which is checked when the engine starts since the
+// two may be set in either order.
+int wiredTigerEvictionDirtyTargetPercent = 5;
+int wiredTigerEvictionDirtyTriggerPercent = 20;
+
+// Amount of journal written since the last checkpoint that triggers an early checkpoint.
+int wiredTigerCheckpointLogSizeMB = 2048;
+
+class ExportedEvictionDirtyPercentParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupOnly> {
+public:
+    ExportedEvictionDirtyPercentParameter(StringData name, int* value)
+        : ExportedServerParameter<int, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(), name.toString(), value) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        // The range WiredTiger accepts for eviction_dirty_target and eviction_dirty_trigger.
+        if (potentialNewValue < 1 || potentialNewValue > 99) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << name() << " must be between 1 and 99, inclusive");
+        }
+
+        return Status::OK();
+    }
+};
+
+ExportedEvictionDirtyPercentParameter exportedEvictionDirtyTargetPercentParam(
+    "wiredTigerEvictionDirtyTargetPercent", &wiredTigerEvictionDirtyTargetPercent);
+ExportedEvictionDirtyPercentParameter exportedEvictionDirtyTriggerPercentParam(
+    "wiredTigerEvictionDirtyTriggerPercent", &wiredTigerEvictionDirtyTriggerPercent);
+
+class ExportedCheckpointLogSizeMBParameter
+    : public ExportedServerParameter<int, ServerParameterType::kStartupOnly> {
+public:
+    ExportedCheckpointLogSizeMBParameter()
+        : ExportedServerParameter<int, ServerParameterType::kStartupOnly>(
+              ServerParameterSet::getGlobal(),
+              "wiredTigerCheckpointLogSizeMB",
+              &wiredTigerCheckpointLogSizeMB) {}
+
+    virtual Status validate(const int& potentialNewValue) {
+        // WiredTiger accepts a checkpoint log_size of 2MB to 2TB.
+        if (potentialNewValue < 2 || potentialNewValue > 2 * 1024 * 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerCheckpointLogSizeMB must be between 2 and 2097152, inclusive");
+        }
+
+        return Status::OK();
+    }
+} exportedCheckpointLogSizeMBParam;
+}  // namespace
+
 class WiredTigerKVEngine::WiredTigerJournalFlusher : public BackgroundJob {
 public:
     explicit WiredTigerJournalFlusher(WiredTigerSessionCache* sessionCache)
@@ -128,6 +234,58 @@ private:
     AtomicBool _shuttingDown{false};
 };
 
+/**
+ * Periodically writes the record stores' sizes to the sizeStorer table, so that operations never
+ * have to do it themselves.
+ */
+class WiredTigerKVEngine::WiredTigerSizeStorerFlusher : public BackgroundJob {
+public:
+    explicit WiredTigerSizeStorerFlusher(WiredTigerKVEngine* engine)
+        : BackgroundJob(false /* deleteSelf */), _engine(engine) {}
+
+    virtual string name() const {
+        return "WTSizeStorerFlusher";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (!_shuttingDown) {
+            _shutdownCV.wait_for(
+                lk, Seconds(1).toSystemDuration(), [this] { return _shuttingDown; });
+            if (_shuttingDown)
+                break;
+
+            if (_engine->_sizeStorerSyncTracker.intervalHasElapsed()) {
+                _engine->_sizeStorerSyncTracker.resetLastTime();
+                lk.unlock();
+                _engine->syncSizeInfo(false);
+                lk.lock();
+            }
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _shuttingDown = true;
+        }
+        _shutdownCV.notify_one();
+        wait();
+    }
+
+private:
+    WiredTigerKVEngine* const _engine;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _shutdownCV;
+    bool _shuttingDown = false;
+};
+
 namespace {
 
 class TicketServerParameter : public ServerParameter {
@@ -211,11 +369,21 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _previousCheckedDropsQueued = Date_t::now();
 
+    uassert(40426,
+            str::stream() << "wiredTigerEvictionDirtyTargetPercent ("
+                          << wiredTigerEvictionDirtyTargetPercent
+                          << ") must be less than wiredTigerEvictionDirtyTriggerPercent ("
+                          << wiredTigerEvictionDirtyTriggerPercent
+                          << ")",
+            wiredTigerEvictionDirtyTargetPercent < wiredTigerEvictionDirtyTriggerPercent);
+
     std::stringstream ss;
     ss << "create,";
     ss << "cache_size=" << cacheSizeMB << "M,";
     ss << "session_max=20000,";
     ss << "eviction=(threads_min=4,threads_max=4),";
+    ss << "eviction_dirty_target=" << wiredTigerEvictionDirtyTargetPercent << ",";
+    ss << "eviction_dirty_trigger=" << wiredTigerEvictionDirtyTriggerPercent << ",";
     ss << "config_base=false,";
     ss << "statistics=(fast),";
     // The setting may have a later setting override it if not using the journal.  We make it
@@ -225,9 +393,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
         // If we're readOnly skip all WAL-related settings.
         ss << "log=(enabled=true,archive=true,path=journal,compressor=";
         ss << wiredTigerGlobalOptions.journalCompressor << "),";
-        ss << "file_manager=(close_idle_time=100000),";  //~28 hours, will put better fix in 3.1.x
+        ss << "file_manager=(close_idle_time=" << wiredTigerFileHandleCloseIdleTimeSecs
+           << ",close_handle_minimum=" << wiredTigerFileHandleCloseMinimum
+           << ",close_scan_interval=" << wiredTigerFileHandleCloseScanIntervalSecs << "),";
         ss << "checkpoint=(wait=" << wiredTigerGlobalOptions.checkpointDelaySecs;
-        ss << ",log_size=2GB),";
+        ss << ",log_size=" << wiredTigerCheckpointLogSizeMB << "MB),";
         ss << "statistics_log=(wait=" << wiredTigerGlobalOptions.statisticsLogDelaySecs << "),";
         ss << "verbose=(recovery_progress),";
     }
@@ -287,6 +457,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer.reset(new WiredTigerSizeStorer(_conn, _sizeStorerUri));
     _sizeStorer->fillCache();
 
+    if (!_readOnly) {
+        _sizeStorerFlusher = stdx::make_unique<WiredTigerSizeStorerFlusher>(this);
+        _sizeStorerFlusher->go();
+    }
+
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 }
 
@@ -320,6 +495,10 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
 
 void WiredTigerKVEngine::cleanShutdown() {
     log() << "WiredTigerKVEngine shutting down";
+    if (_sizeStorerFlusher) {
+        _sizeStorerFlusher->shutdown();
+        _sizeStorerFlusher.reset();
+    }
     if (!_readOnly)
         syncSizeInfo(true);
     if (_conn) {
@@ -413,6 +592,7 @@ int WiredTigerKVEngine::flushAllFiles(OperationContext* txn, bool sync) {
 }
 
 Status WiredTigerKVEngine::beginBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
     invariant(!_backupSession);
 
     // This cursor will be freed by the backupSession being closed as the session is uncached
@@ -428,6 +608,44 @@ Status WiredTigerKVEngine::beginBackup(OperationContext* txn) {
 }
 
 void WiredTigerKVEngine::endBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
+    _backupSession.reset();
+}
+
+StatusWith<std::vector<std::string>> WiredTigerKVEngine::beginNonBlockingBackup(
+    OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
+    if (_backupSession) {
+        return Status(ErrorCodes::BadValue, "Already in Backup Mode");
+    }
+
+    // WiredTiger keeps the checkpoint the backup cursor was opened on, and the log files needed
+    // to recover it, intact for as long as the cursor is open. The cursor is freed along with the
+    // uncached session, in endNonBlockingBackup().
+    auto session = stdx::make_unique<WiredTigerSession>(_conn);
+    WT_CURSOR* c = NULL;
+    WT_SESSION* s = session->getSession();
+    int ret = WT_OP_CHECK(s->open_cursor(s, "backup:", NULL, NULL, &c));
+    if (ret != 0) {
+        return wtRCToStatus(ret);
+    }
+
+    std::vector<std::string> files;
+    while ((ret = c->next(c)) == 0) {
+        const char* filename;
+        invariantWTOK(c->get_key(c, &filename));
+        files.emplace_back(filename);
+    }
+    if (ret != WT_NOTFOUND) {
+        return wtRCToStatus(ret);
+    }
+
+    _backupSession = std::move(session);
+    return std::move(files);
+}
+
+void WiredTigerKVEngine::endNonBlockingBackup(OperationContext* txn) {
+    stdx::lock_guard<stdx::mutex> lk(_backupMutex);
     _backupSession.reset();
 }
 
@@ -588,11 +806,6 @@ bool WiredTigerKVEngine::haveDropsQueued() const {
     Date_t now = Date_t::now();
     Milliseconds delta = now - _previousCheckedDropsQueued;
 
-    if (!_readOnly && _sizeStorerSyncTracker.intervalHasElapsed()) {
-        _sizeStorerSyncTracker.resetLastTime();
-        syncSizeInfo(false);
-    }
-
     // We only want to check the queue max once per second or we'll thrash
     // This is done in haveDropsQueued, not dropSomeQueuedIdents so we skip the mutex
     if (delta < Milliseconds(1000))
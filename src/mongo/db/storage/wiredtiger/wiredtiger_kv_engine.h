@@ -114,6 +114,10 @@ public:
 
     virtual void endBackup(OperationContext* txn);
 
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* txn);
+
+    virtual void endNonBlockingBackup(OperationContext* txn);
+
     virtual int64_t getIdentSize(OperationContext* opCtx, StringData ident);
 
     virtual Status repairIdent(OperationContext* opCtx, StringData ident);
@@ -162,6 +166,7 @@ public:
 
 private:
     class WiredTigerJournalFlusher;
+    class WiredTigerSizeStorerFlusher;
 
     Status _salvageIfNeeded(const char* uri);
     void _checkIdentPath(StringData ident);
@@ -179,12 +184,13 @@ private:
 
     std::unique_ptr<WiredTigerSizeStorer> _sizeStorer;
     std::string _sizeStorerUri;
-    mutable ElapsedTracker _sizeStorerSyncTracker;
+    ElapsedTracker _sizeStorerSyncTracker;  // Only used by _sizeStorerFlusher
 
     bool _durable;
     bool _ephemeral;
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
+    std::unique_ptr<WiredTigerSizeStorerFlusher> _sizeStorerFlusher;  // Depends on _sizeStorer
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -195,6 +201,8 @@ private:
 
     mutable Date_t _previousCheckedDropsQueued;
 
+    // Protects _backupSession, which a non-blocking backup sets without holding the global lock.
+    stdx::mutex _backupMutex;
     std::unique_ptr<WiredTigerSession> _backupSession;
 };
 }
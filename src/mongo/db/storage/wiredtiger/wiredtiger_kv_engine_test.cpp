@@ -33,11 +33,15 @@
 
 #include "mongo/db/storage/kv/kv_engine_test_harness.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
+#include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
 namespace mongo {
@@ -80,5 +84,52 @@ MONGO_INITIALIZER(RegisterKVHarnessFactory)(InitializerContext*) {
     return Status::OK();
 }
 
+TEST(WiredTigerKVEngineTest, NonBlockingBackupListsDataFiles) {
+    WiredTigerKVHarnessHelper helper;
+    KVEngine* engine = helper.getEngine();
+
+    std::unique_ptr<RecordStore> rs;
+    {
+        OperationContextNoop txn(engine->newRecoveryUnit());
+        ASSERT_OK(engine->createRecordStore(&txn, "a.b", "collection-backup", CollectionOptions()));
+        rs = engine->getRecordStore(&txn, "a.b", "collection-backup", CollectionOptions());
+        ASSERT(rs);
+    }
+
+    {
+        OperationContextNoop txn(engine->newRecoveryUnit());
+        auto files = engine->beginNonBlockingBackup(&txn);
+        ASSERT_OK(files.getStatus());
+        auto&& names = files.getValue();
+        ASSERT(std::find(names.begin(), names.end(), "WiredTiger") != names.end());
+        ASSERT(std::find(names.begin(), names.end(), "collection-backup.wt") != names.end());
+
+        // Writes continue while the backup is open.
+        WriteUnitOfWork wuow(&txn);
+        ASSERT_OK(rs->insertRecord(&txn, "abc", 4, false).getStatus());
+        wuow.commit();
+
+        engine->endNonBlockingBackup(&txn);
+    }
+
+    // A new backup can start once the previous one has ended.
+    OperationContextNoop txn(engine->newRecoveryUnit());
+    ASSERT_OK(engine->beginNonBlockingBackup(&txn).getStatus());
+    engine->endNonBlockingBackup(&txn);
+}
+
+TEST(WiredTigerKVEngineTest, OnlyOneNonBlockingBackupAtATime) {
+    WiredTigerKVHarnessHelper helper;
+    KVEngine* engine = helper.getEngine();
+
+    OperationContextNoop txn(engine->newRecoveryUnit());
+    ASSERT_OK(engine->beginNonBlockingBackup(&txn).getStatus());
+    ASSERT_EQUALS(ErrorCodes::BadValue, engine->beginNonBlockingBackup(&txn).getStatus());
+    engine->endNonBlockingBackup(&txn);
+
+    ASSERT_OK(engine->beginNonBlockingBackup(&txn).getStatus());
+    engine->endNonBlockingBackup(&txn);
+}
+
 }  // namespace
 }  // namespace mongo
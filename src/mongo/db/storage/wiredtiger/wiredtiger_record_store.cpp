@@ -44,6 +44,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
@@ -87,6 +88,11 @@ bool shouldUseOplogHack(OperationContext* opCtx, const std::string& uri) {
     return (appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
 
+// The minimum number of seconds of history to keep in the oplog. The oldest oplog stone is not
+// truncated until its newest entry is at least this old, even if that means the oplog grows past
+// its configured maximum size. A value of 0 or less means the oplog is truncated by size alone.
+MONGO_EXPORT_SERVER_PARAMETER(oplogMinRetentionSeconds, int, 0);
+
 }  // namespace
 
 MONGO_FP_DECLARE(WTWriteConflictException);
@@ -135,6 +141,7 @@ public:
 
         stdx::lock_guard<stdx::mutex> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_persistStones_inlock();
     }
 
     void rollback() final {}
@@ -160,6 +167,7 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* txn, WiredTige
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(txn);
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -177,10 +185,18 @@ void WiredTigerRecordStore::OplogStones::kill() {
 }
 
 void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
-    // Wait until kill() is called or there are too many oplog stones.
+    // Wait until kill() is called or there are too many oplog stones and the oldest one may be
+    // truncated. Nothing notifies us when a stone held back by 'oplogMinRetentionSeconds' ages
+    // out of the retention window, so poll for that case instead.
     stdx::unique_lock<stdx::mutex> lock(_oplogReclaimMutex);
-    while (!_isDead && !hasExcessStones()) {
-        _oplogReclaimCv.wait(lock);
+    while (!_isDead) {
+        if (!hasExcessStones()) {
+            _oplogReclaimCv.wait(lock);
+        } else if (peekOldestStoneIfNeeded()) {
+            return;
+        } else {
+            _oplogReclaimCv.wait_for(lock, Seconds(1).toSystemDuration());
+        }
     }
 }
 
@@ -188,7 +204,7 @@ boost::optional<WiredTigerRecordStore::OplogStones::Stone>
 WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
-    if (!hasExcessStones()) {
+    if (!hasExcessStones() || !_isOutsideRetentionWindow(_stones.front())) {
         return {};
     }
 
@@ -198,6 +214,7 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _stones.pop_front();
+    _persistStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -222,6 +239,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
 
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
+    _persistStones_inlock();
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -258,6 +276,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _persistStones_inlock();
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -305,6 +324,12 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* txn)
         return;
     }
 
+    // Reuse the stones persisted by the last run if they are still consistent with the oplog,
+    // rather than sampling it again.
+    if (_loadPersistedStones(txn, numRecords, dataSize)) {
+        return;
+    }
+
     // Use the oplog's average record size to estimate the number of records in each stone, and thus
     // estimate the combined size of the records.
     double avgRecordSize = double(dataSize) / double(numRecords);
@@ -314,6 +339,92 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* txn)
     _calculateStonesBySampling(txn, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* txn,
+                                                              long long numRecords,
+                                                              long long dataSize) {
+    if (!_rs->_sizeStorer) {
+        return false;
+    }
+
+    BSONObj persisted = _rs->_sizeStorer->loadOplogStonesFromCache(_rs->getURI());
+    if (persisted.isEmpty()) {
+        return false;
+    }
+
+    if (persisted["minBytesPerStone"].safeNumberLong() != _minBytesPerStone ||
+        persisted["stones"].type() != Array) {
+        log() << "Not using the persisted oplog markers because the oplog's size has changed";
+        return false;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    for (auto&& elem : persisted["stones"].Obj()) {
+        if (elem.type() != Object) {
+            return false;
+        }
+        BSONObj obj = elem.Obj();
+        OplogStones::Stone stone = {obj["records"].safeNumberLong(),
+                                    obj["bytes"].safeNumberLong(),
+                                    RecordId(obj["lastRecord"].safeNumberLong())};
+        if (!stone.lastRecord.isNormal() ||
+            (!stones.empty() && stone.lastRecord <= stones.back().lastRecord)) {
+            return false;
+        }
+        stones.push_back(stone);
+    }
+
+    // Check that the persisted stones still describe the oplog: drop those which end before its
+    // first record, because they were truncated after the stones were last persisted, and require
+    // that the newest one ends at a record which still exists.
+    auto cursor = _rs->getCursor(txn, true);
+    auto firstRecord = cursor->next();
+    if (!firstRecord) {
+        return false;
+    }
+    while (!stones.empty() && stones.front().lastRecord < firstRecord->id) {
+        stones.pop_front();
+    }
+    if (stones.empty() || !cursor->seekExact(stones.back().lastRecord)) {
+        log() << "Not using the persisted oplog markers because they are inconsistent with the "
+                 "oplog";
+        return false;
+    }
+
+    int64_t recordsInStones = 0;
+    int64_t bytesInStones = 0;
+    for (const auto& stone : stones) {
+        recordsInStones += stone.records;
+        bytesInStones += stone.bytes;
+    }
+
+    // Everything after the newest stone belongs to the stone currently being filled.
+    _stones = std::move(stones);
+    _currentRecords.store(std::max(int64_t(numRecords) - recordsInStones, int64_t(0)));
+    _currentBytes.store(std::max(int64_t(dataSize) - bytesInStones, int64_t(0)));
+
+    log() << "Loaded " << _stones.size() << " persisted oplog markers for truncation";
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_persistStones_inlock() {
+    if (!_rs->_sizeStorer) {
+        return;
+    }
+
+    BSONObjBuilder builder;
+    builder.append("minBytesPerStone", static_cast<long long>(_minBytesPerStone));
+    {
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (const auto& stone : _stones) {
+            stonesBuilder.append(BSON("records" << static_cast<long long>(stone.records) << "bytes"
+                                                << static_cast<long long>(stone.bytes)
+                                                << "lastRecord"
+                                                << stone.lastRecord.repr()));
+        }
+    }
+    _rs->_sizeStorer->storeOplogStonesToCache(_rs->getURI(), builder.obj());
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationContext* txn) {
     log() << "Scanning the oplog to determine where to place markers for truncation";
 
@@ -422,6 +533,18 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(txn) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_isOutsideRetentionWindow(const Stone& stone) const {
+    const int minRetentionSecs = oplogMinRetentionSeconds.load();
+    if (minRetentionSecs <= 0) {
+        return true;
+    }
+
+    // The RecordId of an oplog entry is its timestamp.
+    const Timestamp lastTimestamp(static_cast<unsigned long long>(stone.lastRecord.repr()));
+    const long long nowSecs = durationCount<Seconds>(Date_t::now().toDurationSinceEpoch());
+    return nowSecs - lastTimestamp.getSecs() >= minRetentionSecs;
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     if (hasExcessStones()) {
         _oplogReclaimCv.notify_one();
@@ -781,7 +904,6 @@ WiredTigerRecordStore::WiredTigerRecordStore(OperationContext* ctx,
       _cappedDeleteCheckCount(0),
       _useOplogHack(shouldUseOplogHack(ctx, _uri)),
       _sizeStorer(sizeStorer),
-      _sizeStorerCounter(0),
       _shuttingDown(false) {
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
                                ctx, uri, kMinimumRecordStoreVersion, kMaximumRecordStoreVersion)
@@ -1270,23 +1392,33 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* txn,
 
     RecordId highestId = RecordId();
     dassert(nRecords != 0);
-    for (size_t i = 0; i < nRecords; i++) {
-        auto& record = records[i];
-        if (_useOplogHack) {
+    if (_useOplogHack) {
+        for (size_t i = 0; i < nRecords; i++) {
+            auto& record = records[i];
             StatusWith<RecordId> status =
                 oploghack::extractKey(record.data.data(), record.data.size());
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
-        } else if (_isCapped) {
-            stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-            record.id = _nextId();
-            _addUncommittedRecordId_inlock(txn, record.id);
-        } else {
-            record.id = _nextId();
+            dassert(record.id > highestId);
+            highestId = record.id;
+        }
+    } else if (_isCapped) {
+        // The RecordIds are reserved under the lock so that they are recorded as uncommitted in
+        // the order they were handed out.
+        stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
+        const RecordId firstId = _reserveIds(nRecords);
+        for (size_t i = 0; i < nRecords; i++) {
+            records[i].id = RecordId(firstId.repr() + i);
+            _addUncommittedRecordId_inlock(txn, records[i].id);
+        }
+        highestId = records[nRecords - 1].id;
+    } else {
+        const RecordId firstId = _reserveIds(nRecords);
+        for (size_t i = 0; i < nRecords; i++) {
+            records[i].id = RecordId(firstId.repr() + i);
         }
-        dassert(record.id > highestId);
-        highestId = record.id;
+        highestId = records[nRecords - 1].id;
     }
 
     if (_useOplogHack && (highestId > _oplog_highestSeen)) {
@@ -1345,21 +1477,26 @@ void WiredTigerRecordStore::_dealtWithCappedId(SortedRecordIds::iterator it, boo
         }
     } else {
         _uncommittedRecordIds.erase(it);
+        _updateLowestHiddenRecord_inlock();
         _opsBecameVisibleCV.notify_all();
     }
 }
 
 bool WiredTigerRecordStore::isCappedHidden(const RecordId& id) const {
-    stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-    if (_uncommittedRecordIds.empty()) {
+    const RecordId lowestHidden(_lowestHiddenRecord.load());
+    if (lowestHidden.isNull()) {
         return false;
     }
-    return _uncommittedRecordIds.front() <= id;
+    return lowestHidden <= id;
 }
 
 RecordId WiredTigerRecordStore::lowestCappedHiddenRecord() const {
-    stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
-    return _uncommittedRecordIds.empty() ? RecordId() : _uncommittedRecordIds.front();
+    return RecordId(_lowestHiddenRecord.load());
+}
+
+void WiredTigerRecordStore::_updateLowestHiddenRecord_inlock() {
+    _lowestHiddenRecord.store(
+        _uncommittedRecordIds.empty() ? RecordId().repr() : _uncommittedRecordIds.front().repr());
 }
 
 Status WiredTigerRecordStore::insertRecordsWithDocWriter(OperationContext* txn,
@@ -1440,7 +1577,7 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* txn,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return false;
+    return true;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1449,7 +1586,23 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
-    MONGO_UNREACHABLE;
+    // WiredTiger has no way to change part of a value, so the damages are applied to a copy of the
+    // old record which then replaces it. This still spares the caller from serializing the whole
+    // updated document.
+    const int len = oldRec.size();
+    SharedBuffer buffer = SharedBuffer::allocate(len);
+    char* root = buffer.get();
+    std::memcpy(root, oldRec.data(), len);
+
+    for (auto&& damage : damages) {
+        std::memcpy(root + damage.targetOffset, damageSource + damage.sourceOffset, damage.size);
+    }
+
+    Status status = updateRecord(txn, id, root, len, false, nullptr);
+    if (!status.isOK()) {
+        return status;
+    }
+    return RecordData(buffer, len);
 }
 
 void WiredTigerRecordStore::_oplogSetStartHack(WiredTigerRecoveryUnit* wru) const {
@@ -1524,7 +1677,12 @@ Status WiredTigerRecordStore::compact(OperationContext* txn,
     if (!cache->isEphemeral()) {
         UniqueWiredTigerSession session = cache->getSession();
         WT_SESSION* s = session->getSession();
+        // The collection stays in use while it is compacted, so WiredTiger giving up on the
+        // table is reported to the caller rather than treated as fatal.
         int ret = s->compact(s, getURI().c_str(), "timeout=0");
+        if (ret == EBUSY) {
+            return wtRCToStatus(ret, "WiredTigerRecordStore::compact");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -1535,7 +1693,12 @@ Status WiredTigerRecordStore::validate(OperationContext* txn,
                                        ValidateAdaptor* adaptor,
                                        ValidateResults* results,
                                        BSONObjBuilder* output) {
-    if (!_isEphemeral) {
+    // A background validate only holds an intent lock and relies on its snapshot for a
+    // consistent view. WT_SESSION::verify needs exclusive access to the table, and the size
+    // counters keep changing under concurrent writes, so both are left alone in that case.
+    const bool exclusive = txn->lockState()->isCollectionLockedForMode(ns(), MODE_X);
+
+    if (!_isEphemeral && exclusive) {
         int err = WiredTigerUtil::verifyTable(txn, _uri, &results->errors);
         if (err == EBUSY) {
             const char* msg = "verify() returned EBUSY. Not treating as invalid.";
@@ -1585,7 +1748,7 @@ Status WiredTigerRecordStore::validate(OperationContext* txn,
         }
     }
 
-    if (_sizeStorer && results->valid) {
+    if (_sizeStorer && results->valid && exclusive) {
         if (nrecords != _numRecords.load() || dataSizeTotal != _dataSize.load()) {
             warning() << _uri << ": Existing record and data size counters (" << _numRecords.load()
                       << " records " << _dataSize.load() << " bytes) "
@@ -1720,6 +1883,7 @@ void WiredTigerRecordStore::_oplogJournalThreadLoop(WiredTigerSessionCache* sess
         for (auto&& op : opsAboutToBeJournaled) {
             _uncommittedRecordIds.erase(op);
         }
+        _updateLowestHiddenRecord_inlock();
 
         _opsBecameVisibleCV.notify_all();
         lk.unlock();
@@ -1750,6 +1914,9 @@ void WiredTigerRecordStore::_addUncommittedRecordId_inlock(OperationContext* txn
     dassert(_uncommittedRecordIds.empty() || _uncommittedRecordIds.back() < id);
     SortedRecordIds::iterator it = _uncommittedRecordIds.insert(_uncommittedRecordIds.end(), id);
     invariant(it->isNormal());
+    if (it == _uncommittedRecordIds.begin()) {
+        _updateLowestHiddenRecord_inlock();
+    }
     txn->recoveryUnit()->registerChange(new CappedInsertChange(this, it));
     _oplog_highestSeen = id;
 }
@@ -1793,10 +1960,12 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* txn,
     }
 }
 
-RecordId WiredTigerRecordStore::_nextId() {
+RecordId WiredTigerRecordStore::_reserveIds(size_t count) {
     invariant(!_useOplogHack);
-    RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
+    invariant(count > 0);
+    RecordId out = RecordId(_nextIdNum.fetchAndAdd(count));
     invariant(out.isNormal());
+    invariant(RecordId(out.repr() + count - 1).isNormal());
     return out;
 }
 
@@ -1842,10 +2011,6 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* txn, int64_t amo
 
     if (_dataSize.fetchAndAdd(amount) < 0)
         _dataSize.store(std::max(amount, int64_t(0)));
-
-    if (_sizeStorer && _sizeStorerCounter++ % 1000 == 0) {
-        _sizeStorer->storeToCache(_uri, _numRecords.load(), _dataSize.load());
-    }
 }
 
 int64_t WiredTigerRecordStore::_makeKey(const RecordId& id) {
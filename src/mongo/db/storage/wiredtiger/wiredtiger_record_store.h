@@ -264,10 +264,15 @@ private:
 
     void _dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit);
     void _addUncommittedRecordId_inlock(OperationContext* txn, RecordId id);
+    void _updateLowestHiddenRecord_inlock();
 
     Status _insertRecords(OperationContext* txn, Record* records, size_t nRecords);
 
-    RecordId _nextId();
+    /**
+     * Reserves 'count' consecutive RecordIds with a single atomic increment and returns the first
+     * of them.
+     */
+    RecordId _reserveIds(size_t count);
     void _setId(RecordId id);
     bool cappedAndNeedDelete() const;
     void _changeNumRecords(OperationContext* txn, int64_t diff);
@@ -306,12 +311,16 @@ private:
     RecordId _oplog_highestSeen;
     mutable stdx::mutex _uncommittedRecordIdsMutex;
 
+    // The repr of the front of _uncommittedRecordIds, or 0 if it is empty. Written under
+    // _uncommittedRecordIdsMutex, but read without it so that cursors over capped collections
+    // don't contend with inserts for the mutex on every record they return.
+    AtomicInt64 _lowestHiddenRecord;
+
     AtomicInt64 _nextIdNum;
     AtomicInt64 _dataSize;
     AtomicInt64 _numRecords;
 
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
-    int _sizeStorerCounter;
 
     bool _shuttingDown;
 
@@ -112,10 +112,22 @@ private:
 
     void _calculateStones(OperationContext* txn);
     void _calculateStonesByScanning(OperationContext* txn);
+
+    // Restores the stones which _persistStones_inlock() stored in the size storer, if they are
+    // consistent with the current contents of the oplog. Returns false if they cannot be used.
+    bool _loadPersistedStones(OperationContext* txn, long long numRecords, long long dataSize);
+
+    // Stores the current stones in the size storer, which writes them out along with the oplog's
+    // size, so that the next startup need not sample or scan the oplog to recreate them.
+    void _persistStones_inlock();
     void _calculateStonesBySampling(OperationContext* txn,
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Returns false if 'stone' contains entries newer than the 'oplogMinRetentionSeconds' server
+    // parameter allows to be truncated, and true otherwise.
+    bool _isOutsideRetentionWindow(const Stone& stone) const;
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
@@ -31,6 +31,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -39,6 +40,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context_noop.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/record_store_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
@@ -676,6 +678,44 @@ TEST(WiredTigerRecordStoreTest, OplogHackOnNonOplog) {
     ASSERT_EQ(rs->oplogStartHack(opCtx.get(), RecordId(0, 1)), boost::none);
 }
 
+void checkBatchInsertAssignsConsecutiveIds(RecordStore* rs, OperationContext* opCtx) {
+    const std::vector<std::string> data = {"a", "bb", "ccc", "dddd"};
+
+    std::vector<Record> records;
+    {
+        WriteUnitOfWork uow(opCtx);
+        for (const auto& str : data) {
+            records.push_back({RecordId(), RecordData(str.c_str(), str.size() + 1)});
+        }
+        ASSERT_OK(rs->insertRecords(opCtx, &records, false));
+        uow.commit();
+    }
+
+    auto cursor = rs->getCursor(opCtx);
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(RecordId(records[0].id.repr() + i), records[i].id);
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(records[i].id, record->id);
+        ASSERT_EQ(data[i], record->data.data());
+    }
+    ASSERT(!cursor->next());
+}
+
+TEST(WiredTigerRecordStoreTest, BatchInsertAssignsConsecutiveIds) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    checkBatchInsertAssignsConsecutiveIds(rs.get(), opCtx.get());
+}
+
+TEST(WiredTigerRecordStoreTest, CappedBatchInsertAssignsConsecutiveIds) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 100000, 10000));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    checkBatchInsertAssignsConsecutiveIds(rs.get(), opCtx.get());
+}
+
 TEST(WiredTigerRecordStoreTest, CappedOrder) {
     unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 100000, 10000));
@@ -1470,6 +1510,152 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
     }
 }
 
+// Verify that oplog stones whose entries are newer than 'oplogMinRetentionSeconds' are not
+// reclaimed, even when the number of stones to keep is exceeded.
+TEST(WiredTigerRecordStoreTest, OplogStones_MinRetention) {
+    WiredTigerHarnessHelper harnessHelper;
+
+    ServerParameter* minRetentionParam =
+        ServerParameterSet::getGlobal()->getMap().find("oplogMinRetentionSeconds")->second;
+    ASSERT_OK(minRetentionParam->setFromString("3600"));
+    ON_BLOCK_EXIT([&] { minRetentionParam->setFromString("0"); });
+
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper.newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    oplogStones->setMinBytesPerStone(100);
+    oplogStones->setNumStonesToKeep(1U);
+
+    const unsigned oldSecs = 1;
+    const unsigned newSecs = durationCount<Seconds>(Date_t::now().toDurationSinceEpoch());
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(oldSecs, 1), 100),
+                  RecordId(oldSecs, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(newSecs, 1), 110),
+                  RecordId(newSecs, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(newSecs, 2), 120),
+                  RecordId(newSecs, 2));
+
+        ASSERT_EQ(3, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(3U, oplogStones->numStones());
+    }
+
+    // Only the stone which is older than the retention window is truncated.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get());
+
+        ASSERT_EQ(2, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(230, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(2U, oplogStones->numStones());
+        ASSERT_TRUE(oplogStones->hasExcessStones());
+        ASSERT_FALSE(oplogStones->peekOldestStoneIfNeeded());
+    }
+
+    // Once the retention window no longer applies, the remaining excess stone is truncated.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        ASSERT_OK(minRetentionParam->setFromString("0"));
+
+        wtrs->reclaimOplog(opCtx.get());
+
+        ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(120, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(1U, oplogStones->numStones());
+    }
+}
+
+// Verify that the oplog stones are restored from the size storer rather than recalculated when the
+// oplog is reopened.
+TEST(WiredTigerRecordStoreTest, OplogStones_LoadPersistedStones) {
+    WiredTigerHarnessHelper harnessHelper;
+
+    const std::string ns = "local.oplog.stones";
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(harnessHelper.newCappedRecordStore(ns, cappedMaxSize, -1));
+    const std::string uri = checked_cast<WiredTigerRecordStore*>(rs.get())->getURI();
+    rs.reset(NULL);
+
+    const std::string sizeStorerUri = "table:sizeStorer";
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        WiredTigerRecoveryUnit* ru = checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
+        WriteUnitOfWork uow(opCtx.get());
+        WT_SESSION* s = ru->getSession(opCtx.get())->getSession();
+        invariantWTOK(s->create(s, sizeStorerUri.c_str(), ""));
+        uow.commit();
+    }
+
+    WiredTigerSizeStorer ss(harnessHelper.conn(), sizeStorerUri);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        rs.reset(new WiredTigerRecordStore(opCtx.get(),
+                                           ns,
+                                           uri,
+                                           kWiredTigerEngineName,
+                                           true,
+                                           false,
+                                           cappedMaxSize,
+                                           -1,
+                                           NULL,
+                                           &ss));
+    }
+
+    // Insert enough records that reopening the oplog would otherwise sample it. The records vary in
+    // size so that stones estimated from the average record size would differ from the real ones.
+    const int kNumRecords = 2100;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        for (int i = 1; i <= kNumRecords; ++i) {
+            const int size = (i % 2) ? 100 : 200;
+            ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, i), size),
+                      RecordId(1, i));
+        }
+    }
+
+    WiredTigerRecordStore::OplogStones* oplogStones =
+        checked_cast<WiredTigerRecordStore*>(rs.get())->oplogStones();
+    const size_t numStones = oplogStones->numStones();
+    const int64_t currentRecords = oplogStones->currentRecords();
+    const int64_t currentBytes = oplogStones->currentBytes();
+    ASSERT_GT(numStones, 0U);
+
+    rs.reset(NULL);
+    ss.syncCache(true);
+
+    WiredTigerSizeStorer ss2(harnessHelper.conn(), sizeStorerUri);
+    ss2.fillCache();
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        rs.reset(new WiredTigerRecordStore(opCtx.get(),
+                                           ns,
+                                           uri,
+                                           kWiredTigerEngineName,
+                                           true,
+                                           false,
+                                           cappedMaxSize,
+                                           -1,
+                                           NULL,
+                                           &ss2));
+    }
+
+    // Sampling would only have estimated the stones, so matching counts show that they were loaded.
+    oplogStones = checked_cast<WiredTigerRecordStore*>(rs.get())->oplogStones();
+    ASSERT_EQ(numStones, oplogStones->numStones());
+    ASSERT_EQ(currentRecords, oplogStones->currentRecords());
+    ASSERT_EQ(currentBytes, oplogStones->currentBytes());
+
+    rs.reset(NULL);  // this has to be deleted before ss2
+}
+
 // Verify that oplog stones are not reclaimed even if the size of the record store exceeds
 // 'cappedMaxSize'.
 TEST(WiredTigerRecordStoreTest, OplogStones_ExceedCappedMaxSize) {
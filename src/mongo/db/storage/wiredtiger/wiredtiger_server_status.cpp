@@ -75,6 +75,8 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* txn,
     }
 
     WiredTigerKVEngine::appendGlobalStats(bob);
+    WiredTigerSession::appendCursorCacheStats(&bob);
+    WiredTigerSessionCache::appendGroupCommitStats(&bob);
 
     return bob.obj();
 }
@@ -35,7 +35,12 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <functional>
+#include <iterator>
+
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -43,9 +48,29 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+namespace {
+// The maximum number of cursors each session keeps cached after they are released, in addition to
+// the age-based eviction in releaseCursor. A value of 0 or less means there is no fixed limit.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerMaxCachedCursorsPerSession, int, 0);
+
+// How long, in microseconds, the thread that is about to flush the journal in waitUntilDurable
+// waits first, so that writers arriving in the meantime are made durable by the same flush. The
+// default of 0 flushes right away; concurrent waiters are still batched behind a running flush.
+MONGO_EXPORT_SERVER_PARAMETER(journalCommitDelayMicros, int, 0);
+
+AtomicInt64 cursorCacheHits;
+AtomicInt64 cursorCacheMisses;
+
+// The number of waitUntilDurable calls, and of the journal flushes or checkpoints that served them.
+// Their ratio is the average group commit batch size.
+AtomicInt64 durableWaits;
+AtomicInt64 durableFlushes;
+}  // namespace
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
       _cursorEpoch(cursorEpoch),
@@ -77,17 +102,20 @@ WiredTigerSession::~WiredTigerSession() {
 }
 
 WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, bool forRecordStore) {
-    // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        if (i->_id == id) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            _cursorsCached--;
-            return c;
-        }
+    // Any cached cursor for this table will do
+    CursorIndex::iterator cached = _cursorIndex.find(id);
+    if (cached != _cursorIndex.end()) {
+        WT_CURSOR* c = cached->second->_cursor;
+        _cursors.erase(cached->second);
+        _cursorIndex.erase(cached);
+        _cursorsOut++;
+        _cursorsCached--;
+        cursorCacheHits.fetchAndAdd(1);
+        return c;
     }
 
+    cursorCacheMisses.fetchAndAdd(1);
+
     WT_CURSOR* c = NULL;
     int ret = _session->open_cursor(
         _session, uri.c_str(), NULL, forRecordStore ? "" : "overwrite=false", &c);
@@ -107,6 +135,7 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
 
     // Cursors are pushed to the front of the list and removed from the back
     _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
+    _cursorIndex.emplace(id, _cursors.begin());
     _cursorsCached++;
 
     // "Old" is defined as not used in the last N**2 operations, if we have N cursors cached.
@@ -115,13 +144,34 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     // would like to cache N cursors in that case, so any given cursor could go N**2 operations
     // in between use.
     while (_cursorGen - _cursors.back()._gen > 10000) {
-        cursor = _cursors.back()._cursor;
-        _cursors.pop_back();
-        _cursorsCached--;
-        invariantWTOK(cursor->close(cursor));
+        _evictOldestCursor();
+    }
+
+    // Regardless of age, never cache more cursors than the configured limit.
+    const int maxCursorsCached = wiredTigerMaxCachedCursorsPerSession.load();
+    while (maxCursorsCached > 0 && _cursorsCached > maxCursorsCached) {
+        _evictOldestCursor();
     }
 }
 
+void WiredTigerSession::_evictOldestCursor() {
+    invariant(!_cursors.empty());
+    CursorCache::iterator oldest = std::prev(_cursors.end());
+
+    auto range = _cursorIndex.equal_range(oldest->_id);
+    for (CursorIndex::iterator i = range.first; i != range.second; ++i) {
+        if (i->second == oldest) {
+            _cursorIndex.erase(i);
+            break;
+        }
+    }
+
+    WT_CURSOR* cursor = oldest->_cursor;
+    _cursors.erase(oldest);
+    _cursorsCached--;
+    invariantWTOK(cursor->close(cursor));
+}
+
 void WiredTigerSession::closeAllCursors() {
     invariant(_session);
     for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
@@ -131,6 +181,8 @@ void WiredTigerSession::closeAllCursors() {
         }
     }
     _cursors.clear();
+    _cursorIndex.clear();
+    _cursorsCached = 0;
     _cursorEpoch = _cache->getCursorEpoch();
 }
 
@@ -142,8 +194,24 @@ uint64_t WiredTigerSession::genTableId() {
     return nextTableId.fetchAndAdd(1);
 }
 
+// static
+void WiredTigerSession::appendCursorCacheStats(BSONObjBuilder* builder) {
+    BSONObjBuilder bob(builder->subobjStart("cursorCache"));
+    bob.append("hits", cursorCacheHits.load());
+    bob.append("misses", cursorCacheMisses.load());
+    bob.done();
+}
+
 // -----------------------
 
+void WiredTigerSessionCache::appendGroupCommitStats(BSONObjBuilder* builder) {
+    BSONObjBuilder bob(builder->subobjStart("groupCommit"));
+    bob.append("waits", durableWaits.load());
+    bob.append("flushes", durableFlushes.load());
+    bob.append("delayMicros", journalCommitDelayMicros.load());
+    bob.done();
+}
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine), _conn(engine->getConnection()), _snapshotManager(_conn), _shuttingDown(0) {}
 
@@ -204,6 +272,7 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint) {
         return;
     }
 
+    durableWaits.addAndFetch(1);
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -213,7 +282,16 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint) {
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // Give other writers a chance to join this flush. Anyone who reads _lastSyncTime while we
+    // wait queues up behind the mutex and returns once we have bumped it below, since their
+    // writes precede the flush.
+    const int delayMicros = journalCommitDelayMicros.load();
+    if (delayMicros > 0 && _engine && _engine->isDurable()) {
+        sleepmicros(delayMicros);
+    }
     _lastSyncTime.store(current + 1);
+    durableFlushes.addAndFetch(1);
 
     // Nobody has synched yet, so we have to sync ourselves.
     auto session = getSession();
@@ -239,20 +317,26 @@ void WiredTigerSessionCache::closeAllCursors() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors();
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (SessionCache::iterator i = partition.sessions.begin(); i != partition.sessions.end();
+             i++) {
+            (*i)->closeAllCursors();
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. releaseSession
+    // checks the epoch under the partition lock, so any session it cached with an older epoch is
+    // in its partition by the time we take that partition's lock below.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -269,13 +353,19 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in this thread's own partition first, and only then take a session from another one.
+    // Sessions from before the most recent closeAll are left for it to free.
+    const uint64_t currentEpoch = _epoch.load();
+    const size_t home = &_getHomePartition() - _partitions;
+    for (size_t i = 0; i < kNumCachePartitions; i++) {
+        CachePartition& partition = _partitions[(home + i) % kNumCachePartitions];
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        if (!partition.sessions.empty() &&
+            partition.sessions.back()->_getEpoch() == currentEpoch) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -324,10 +414,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     uint64_t currentEpoch = _epoch.load();
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        CachePartition& partition = _getHomePartition();
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -339,6 +430,10 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         _engine->dropSomeQueuedIdents();
 }
 
+WiredTigerSessionCache::CachePartition& WiredTigerSessionCache::_getHomePartition() {
+    const size_t threadHash = std::hash<stdx::thread::id>()(stdx::this_thread::get_id());
+    return _partitions[threadHash % kNumCachePartitions];
+}
 
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<stdx::mutex> lk(_journalListenerMutex);
@@ -33,6 +33,8 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 #include <wiredtiger.h>
@@ -45,6 +47,7 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -105,6 +108,12 @@ public:
 
     static uint64_t genTableId();
 
+    /**
+     * Appends the number of getCursor calls, across all sessions, which were satisfied from the
+     * cursor cache and which had to open a new cursor.
+     */
+    static void appendCursorCacheStats(BSONObjBuilder* builder);
+
     /**
      * For "metadata:" cursors. Guaranteed never to collide with genTableId() ids.
      */
@@ -116,6 +125,13 @@ private:
     // The cursor cache is a list of pairs that contain an ID and cursor
     typedef std::list<WiredTigerCachedCursor> CursorCache;
 
+    // Indexes the cursor cache by ID, so that finding a cached cursor does not have to walk the
+    // list. There may be several cached cursors for the same ID.
+    typedef std::unordered_multimap<uint64_t, CursorCache::iterator> CursorIndex;
+
+    // Closes the least recently released cursor in the cache.
+    void _evictOldestCursor();
+
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
         return _epoch;
@@ -131,6 +147,7 @@ private:
     WiredTigerSessionCache* _cache;  // not owned
     WT_SESSION* _session;            // owned
     CursorCache _cursors;            // owned
+    CursorIndex _cursorIndex;
     uint64_t _cursorGen;
     int _cursorsCached, _cursorsOut;
 };
@@ -187,6 +204,12 @@ public:
      */
     void waitUntilDurable(bool forceCheckpoint);
 
+    /**
+     * Appends how many waitUntilDurable calls there were and how many journal flushes or
+     * checkpoints it took to satisfy them, along with the configured journalCommitDelayMicros.
+     */
+    static void appendGroupCommitStats(BSONObjBuilder* builder);
+
     WT_CONNECTION* conn() const {
         return _conn;
     }
@@ -215,9 +238,18 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Cached sessions are spread over several partitions, each with its own lock, so that
+    // operations running on different threads rarely contend on the same mutex. A thread prefers
+    // the partition its id hashes to, and only takes a session from another partition when its
+    // own is empty.
+    struct CachePartition {
+        stdx::mutex lock;
+        SessionCache sessions;
+    };
+    static const size_t kNumCachePartitions = 16;
+    CachePartition _partitions[kNumCachePartitions];
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -239,6 +271,11 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the partition which the calling thread caches its released sessions in.
+     */
+    CachePartition& _getHomePartition();
 };
 
 /**
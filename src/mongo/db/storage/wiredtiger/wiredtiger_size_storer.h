@@ -36,6 +36,7 @@
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/stdx/mutex.h"
 
@@ -56,6 +57,17 @@ public:
 
     void loadFromCache(StringData uri, long long* numRecords, long long* dataSize) const;
 
+    /**
+     * Stores a description of the oplog stones of the record store at 'uri', which is written to
+     * the underlying table along with its sizes.
+     */
+    void storeOplogStonesToCache(StringData uri, const BSONObj& oplogStones);
+
+    /**
+     * Returns the oplog stones last stored for 'uri', or an empty object if there are none.
+     */
+    BSONObj loadOplogStonesFromCache(StringData uri) const;
+
     /**
      * Loads from the underlying table.
      */
@@ -73,6 +85,7 @@ private:
         Entry() : numRecords(0), dataSize(0), dirty(false), rs(NULL) {}
         long long numRecords;
         long long dataSize;
+        BSONObj oplogStones;
         bool dirty;
         WiredTigerRecordStore* rs;  // not owned
     };
@@ -458,6 +458,10 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
     ON_BLOCK_EXIT(c->close, c);
 
     std::map<string, BSONObjBuilder*> subs;
+    // Statistics of the same category are returned next to each other, so remember the last
+    // sub-builder used to save a map lookup and a string allocation on most statistics.
+    std::string lastPrefix;
+    BSONObjBuilder* lastSub = nullptr;
     const char* desc;
     uint64_t value;
     while (c->next(c) == 0 && c->get_value(c, &desc, NULL, &value) == 0) {
@@ -487,10 +491,18 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
         if (prefix.size() == 0) {
             bob->appendNumber(desc, v);
         } else {
-            BSONObjBuilder*& sub = subs[prefix.toString()];
-            if (!sub)
-                sub = new BSONObjBuilder();
-            sub->appendNumber(mongoutils::str::ltrim(suffix.toString()), v);
+            if (!lastSub || prefix != lastPrefix) {
+                BSONObjBuilder*& sub = subs[prefix.toString()];
+                if (!sub)
+                    sub = new BSONObjBuilder();
+                lastSub = sub;
+                lastPrefix.assign(prefix.rawData(), prefix.size());
+            }
+
+            while (!suffix.empty() && suffix[0] == ' ') {
+                suffix = suffix.substr(1);
+            }
+            lastSub->appendNumber(suffix, v);
         }
     }
 
@@ -49,9 +49,22 @@ TimeProofService::Key TimeProofService::generateRandomKey() {
 }
 
 TimeProofService::TimeProof TimeProofService::getProof(const LogicalTime& time) const {
-    auto unsignedTimeArray = time.toUnsignedArray();
-    return SHA1Block::computeHmac(
+    const LogicalTime timeCeil(Timestamp(time.asTimestamp().asULL() | kRangeMask));
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+        if (_cache && _cache->time == timeCeil) {
+            return _cache->proof;
+        }
+    }
+
+    auto unsignedTimeArray = timeCeil.toUnsignedArray();
+    auto proof = SHA1Block::computeHmac(
         _key.data(), _key.size(), unsignedTimeArray.data(), unsignedTimeArray.size());
+
+    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+    _cache.emplace(proof, timeCeil);
+    return proof;
 }
 
 Status TimeProofService::checkProof(const LogicalTime& time, const TimeProof& proof) const {
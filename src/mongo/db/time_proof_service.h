@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/status.h"
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/db/logical_time.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
@@ -55,6 +58,10 @@ public:
 
     /**
      * Returns the proof matching the time argument.
+     *
+     * The proof is computed over the time with its low kRangeMask bits set, so one proof covers
+     * a whole range of consecutive times. The proof for the most recent range is cached, which
+     * makes signing and checking the same or nearby times cheap.
      */
     TimeProof getProof(const LogicalTime& time) const;
 
@@ -64,7 +71,23 @@ public:
     Status checkProof(const LogicalTime& time, const TimeProof& proof) const;
 
 private:
+    // Bits of the time that a single proof covers.
+    static const uint64_t kRangeMask = 0xFFFF;
+
+    struct CacheEntry {
+        CacheEntry(TimeProof proof, LogicalTime time) : proof(std::move(proof)), time(time) {}
+
+        TimeProof proof;
+        LogicalTime time;
+    };
+
     Key _key;
+
+    // Protects _cache.
+    mutable stdx::mutex _cacheMutex;
+
+    // The last computed proof and the range ceiling it was computed over.
+    mutable boost::optional<CacheEntry> _cache;
 };
 
 }  // namespace mongo
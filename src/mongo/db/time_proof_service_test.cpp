@@ -62,5 +62,22 @@ TEST(TimeProofService, LogicalTimeWithMismatchingProofShouldFail) {
     ASSERT_EQUALS(ErrorCodes::TimeProofMismatch, timeProofService.checkProof(time, invalidProof));
 }
 
+// Times in the same range share a proof; times in different ranges do not.
+TEST(TimeProofService, ProofCoversRangeOfTimes) {
+    std::array<std::uint8_t, 20> tempKey = {};
+    TimeProofService::Key key(std::move(tempKey));
+    TimeProofService timeProofService(std::move(key));
+
+    LogicalTime time(Timestamp(1, 1));
+    TimeProof proof = timeProofService.getProof(time);
+
+    ASSERT_OK(timeProofService.checkProof(LogicalTime(Timestamp(1, 2)), proof));
+    ASSERT_EQUALS(ErrorCodes::TimeProofMismatch,
+                  timeProofService.checkProof(LogicalTime(Timestamp(2, 1)), proof));
+
+    // Computing a different range replaces the cached proof without affecting the answer.
+    ASSERT_OK(timeProofService.checkProof(time, proof));
+}
+
 }  // unnamed namespace
 }  // namespace mongo
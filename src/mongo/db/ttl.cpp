@@ -47,6 +47,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/delete.h"
+#include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
@@ -55,7 +56,9 @@
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/ttl_collection_cache.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/old_thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 
@@ -71,6 +74,15 @@ ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocume
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorEnabled, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60);  // used for testing
 
+// Number of threads a TTL pass uses to delete from different collections concurrently. The
+// indexes of a single collection are always processed one after another.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ttlMonitorWorkerThreads, int, 1);
+
+// Maximum number of documents deleted through a single TTL index in one pass, or 0 for no limit.
+// Bounding the work done per pass keeps one collection with a large backlog from delaying the
+// others; the remaining expired documents are deleted during the following passes.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxDeletesPerIndex, int, 0);
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -86,6 +98,10 @@ public:
         Client::initThread(name().c_str());
         AuthorizationSession::get(cc())->grantInternalAuthorization();
 
+        if (ttlMonitorWorkerThreads > 1) {
+            _workers = stdx::make_unique<OldThreadPool>(ttlMonitorWorkerThreads, "TTLWorker");
+        }
+
         while (!globalInShutdownDeprecated()) {
             sleepsecs(ttlMonitorSleepSecs.load());
 
@@ -124,7 +140,7 @@ private:
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::string> ttlCollections = ttlCollectionCache.getCollections();
-        std::vector<BSONObj> ttlIndexes;
+        std::vector<std::vector<BSONObj>> ttlIndexesByCollection;
 
         ttlPasses.increment();
 
@@ -142,17 +158,52 @@ private:
             CollectionCatalogEntry* collEntry = coll->getCatalogEntry();
             std::vector<std::string> indexNames;
             collEntry->getAllIndexes(&txn, &indexNames);
+            std::vector<BSONObj> ttlIndexes;
             for (const std::string& name : indexNames) {
                 BSONObj spec = collEntry->getIndexSpec(&txn, name);
                 if (spec.hasField(secondsExpireField)) {
                     ttlIndexes.push_back(spec.getOwned());
                 }
             }
+            if (!ttlIndexes.empty()) {
+                ttlIndexesByCollection.push_back(std::move(ttlIndexes));
+            }
+        }
+
+        if (!_workers) {
+            for (const auto& ttlIndexes : ttlIndexesByCollection) {
+                doTTLForCollection(&txn, ttlIndexes);
+            }
+            return;
         }
 
+        // Collections are independent of each other, so spread them over the workers. Each of
+        // them needs its own Client and OperationContext.
+        for (const auto& ttlIndexes : ttlIndexesByCollection) {
+            _workers->schedule([this, &ttlIndexes] {
+                if (!Client::getCurrent()) {
+                    Client::initThreadIfNotAlready();
+                    AuthorizationSession::get(cc())->grantInternalAuthorization();
+                }
+                const ServiceContext::UniqueOperationContext workerTxn =
+                    cc().makeOperationContext();
+                try {
+                    doTTLForCollection(workerTxn.get(), ttlIndexes);
+                } catch (const WriteConflictException& e) {
+                    LOG(1) << "got WriteConflictException";
+                }
+            });
+        }
+        _workers->join();
+    }
+
+    /**
+     * Runs the TTL deletions for each of the TTL indexes of a single collection in turn.
+     */
+    void doTTLForCollection(OperationContext* txn, const std::vector<BSONObj>& ttlIndexes) {
         for (const BSONObj& idx : ttlIndexes) {
             try {
-                doTTLForIndex(&txn, idx);
+                doTTLForIndex(txn, idx);
             } catch (const DBException& dbex) {
                 error() << "Error processing ttl index: " << idx << " -- " << dbex.toString();
                 // Continue on to the next index.
@@ -240,8 +291,13 @@ private:
             txn, std::move(qr), ExtensionsCallbackDisallowExtensions());
         invariantOK(canonicalQuery.getStatus());
 
+        // When the number of deletes is bounded, have the delete stage return each document it
+        // deletes so that we can stop after the limit.
+        const long long maxDeletes = ttlMonitorMaxDeletesPerIndex.load();
+
         DeleteStageParams params;
         params.isMulti = true;
+        params.returnDeleted = maxDeletes > 0;
         params.canonicalQuery = canonicalQuery.getValue().get();
 
         std::unique_ptr<PlanExecutor> exec =
@@ -255,17 +311,36 @@ private:
                                                  PlanExecutor::YIELD_AUTO,
                                                  direction);
 
-        Status result = exec->executePlan();
-        if (!result.isOK()) {
-            error() << "ttl query execution for index " << idx
-                    << " failed with status: " << redact(result);
-            return;
+        if (maxDeletes > 0) {
+            BSONObj obj;
+            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+            for (long long n = 0; n < maxDeletes; ++n) {
+                state = exec->getNext(&obj, nullptr);
+                if (state != PlanExecutor::ADVANCED) {
+                    break;
+                }
+            }
+            if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
+                error() << "ttl query execution for index " << idx
+                        << " failed with status: " << redact(WorkingSetCommon::toStatusString(obj));
+                return;
+            }
+        } else {
+            Status result = exec->executePlan();
+            if (!result.isOK()) {
+                error() << "ttl query execution for index " << idx
+                        << " failed with status: " << redact(result);
+                return;
+            }
         }
 
         const long long numDeleted = DeleteStage::getNumDeleted(*exec);
         ttlDeletedDocuments.increment(numDeleted);
         LOG(1) << "deleted: " << numDeleted;
     }
+
+    // Only used when ttlMonitorWorkerThreads is greater than one.
+    std::unique_ptr<OldThreadPool> _workers;
 };
 
 namespace {
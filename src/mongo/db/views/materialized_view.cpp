@@ -0,0 +1,637 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view.h"
+
+#include <deque>
+#include <limits>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/op_observer.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/repl/replication_coordinator_global.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/views/view_catalog.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace materialized_view {
+namespace {
+
+using boost::intrusive_ptr;
+
+// The number of source documents fed through the pipeline at once while populating a new view.
+const size_t kPopulateBatchSize = 1000;
+
+/**
+ * Feeds the documents touched by one write to the pipeline of a materialized view.
+ */
+class DocumentSourceWriteDelta final : public DocumentSource {
+public:
+    DocumentSourceWriteDelta(std::deque<Document> docs,
+                             const intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSource(expCtx), _docs(std::move(docs)) {}
+
+    GetNextResult getNext() final {
+        pExpCtx->checkForInterrupt();
+
+        if (_docs.empty()) {
+            return GetNextResult::makeEOF();
+        }
+        Document next = std::move(_docs.front());
+        _docs.pop_front();
+        return std::move(next);
+    }
+
+    const char* getSourceName() const final {
+        return "$materializedViewDelta";
+    }
+
+    bool isValidInitialSource() const final {
+        return true;
+    }
+
+private:
+    Value serialize(bool explain = false) const final {
+        return Value();
+    }
+
+    std::deque<Document> _docs;
+};
+
+bool isCountAccumulator(const BSONElement& accumulator) {
+    if (accumulator.type() != BSONType::Object || accumulator.Obj().nFields() != 1) {
+        return false;
+    }
+    BSONElement sum = accumulator.Obj().firstElement();
+    return sum.fieldNameStringData() == "$sum" && sum.isNumber() && sum.numberDouble() == 1;
+}
+
+/**
+ * Returns the name of the field in which the final $group of the validated 'pipeline' counts its
+ * documents, or an empty StringData if there is no $group.
+ */
+StringData groupCountField(const BSONObj& pipeline) {
+    BSONObj lastStage;
+    for (auto&& stage : pipeline) {
+        lastStage = stage.Obj();
+    }
+    if (lastStage.isEmpty() || lastStage.firstElementFieldName() != StringData("$group")) {
+        return StringData();
+    }
+
+    for (auto&& field : lastStage.firstElement().Obj()) {
+        if (field.fieldNameStringData() != "_id" && isCountAccumulator(field)) {
+            return field.fieldNameStringData();
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+Status checkDoesNotModifyId(StringData stageName, const BSONElement& spec) {
+    if (spec.type() != BSONType::Object) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << stageName << " specification must be an object, found "
+                              << typeName(spec.type())};
+    }
+
+    for (auto&& field : spec.Obj()) {
+        auto fieldName = field.fieldNameStringData();
+        if (fieldName != "_id" && !fieldName.startsWith("_id.")) {
+            continue;
+        }
+
+        // Including _id as a whole keeps it as it is.
+        const bool isIdInclusion = stageName == "$project" && fieldName == "_id" &&
+            (field.isBoolean() || field.isNumber()) && field.trueValue();
+        if (!isIdInclusion) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "The " << stageName
+                                  << " stages of a materialized view may not modify _id: "
+                                  << spec};
+        }
+    }
+    return Status::OK();
+}
+
+Status checkGroupIsMaintainable(const BSONElement& spec) {
+    if (spec.type() != BSONType::Object) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "$group specification must be an object, found "
+                              << typeName(spec.type())};
+    }
+
+    bool hasCount = false;
+    for (auto&& field : spec.Obj()) {
+        if (field.fieldNameStringData() == "_id") {
+            continue;
+        }
+        if (field.type() != BSONType::Object || field.Obj().nFields() != 1 ||
+            field.Obj().firstElementFieldName() != StringData("$sum")) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "The $group of a materialized view may only use $sum, found "
+                                  << field};
+        }
+        hasCount = hasCount || isCountAccumulator(field);
+    }
+
+    if (!hasCount) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "The $group of a materialized view must count its documents "
+                                 "with {$sum: 1}: "
+                              << spec};
+    }
+    return Status::OK();
+}
+
+/**
+ * Returns the negation of the numeric 'value', widening it if it cannot be represented. Other
+ * values are returned unchanged, since $sum ignores them.
+ */
+Value negate(const Value& value) {
+    switch (value.getType()) {
+        case NumberInt:
+            if (value.getInt() == std::numeric_limits<int>::min()) {
+                return Value(-static_cast<long long>(value.getInt()));
+            }
+            return Value(-value.getInt());
+        case NumberLong:
+            if (value.getLong() == std::numeric_limits<long long>::min()) {
+                return Value(-static_cast<double>(value.getLong()));
+            }
+            return Value(-value.getLong());
+        case NumberDouble:
+            return Value(-value.getDouble());
+        case NumberDecimal:
+            return Value(value.getDecimal().negate());
+        default:
+            return value;
+    }
+}
+
+/**
+ * Returns a pipeline which runs the pipeline of 'view' over 'docs', as an aggregation on 'viewOn'
+ * would.
+ */
+intrusive_ptr<Pipeline> makeDeltaPipeline(OperationContext* txn,
+                                          const Database::MaterializedView& view,
+                                          Collection* viewOn,
+                                          std::deque<Document> docs) {
+    std::vector<BSONObj> rawPipeline;
+    for (auto&& stage : view.pipeline) {
+        rawPipeline.push_back(stage.Obj());
+    }
+
+    auto collator =
+        viewOn->getDefaultCollator() ? viewOn->getDefaultCollator()->clone() : nullptr;
+    intrusive_ptr<ExpressionContext> expCtx =
+        new ExpressionContext(txn,
+                              AggregationRequest(viewOn->ns(), rawPipeline),
+                              std::move(collator),
+                              StringMap<ExpressionContext::ResolvedNamespace>());
+
+    auto pipeline = uassertStatusOK(Pipeline::parse(rawPipeline, expCtx));
+    pipeline->addInitialSource(new DocumentSourceWriteDelta(std::move(docs), expCtx));
+    return pipeline;
+}
+
+void insertViewDocument(OperationContext* txn, Collection* viewColl, const BSONObj& doc) {
+    const bool enforceQuota = true;
+    uassertStatusOK(viewColl->insertDocument(txn, doc, &CurOp::get(txn)->debug(), enforceQuota));
+}
+
+void replaceViewDocument(OperationContext* txn,
+                         Collection* viewColl,
+                         const RecordId& id,
+                         const Snapshotted<BSONObj>& oldDoc,
+                         const BSONObj& newDoc) {
+    OplogUpdateEntryArgs args;
+    args.ns = viewColl->ns().ns();
+    args.update = newDoc;
+    args.criteria = newDoc["_id"].wrap();
+    args.preImageDoc = oldDoc.value().getOwned();
+    args.fromMigrate = false;
+
+    const bool enforceQuota = true;
+    const bool assumeIndexesAreAffected = true;
+    uassertStatusOK(viewColl->updateDocument(txn,
+                                             id,
+                                             oldDoc,
+                                             newDoc,
+                                             enforceQuota,
+                                             assumeIndexesAreAffected,
+                                             &CurOp::get(txn)->debug(),
+                                             &args));
+}
+
+void upsertViewDocument(OperationContext* txn, Collection* viewColl, const BSONObj& doc) {
+    const bool requireIndex = false;
+    RecordId id = Helpers::findOne(txn, viewColl, doc["_id"].wrap(), requireIndex);
+
+    Snapshotted<BSONObj> oldDoc;
+    if (!id.isNormal() || !viewColl->findDoc(txn, id, &oldDoc)) {
+        insertViewDocument(txn, viewColl, doc);
+    } else {
+        replaceViewDocument(txn, viewColl, id, oldDoc, doc);
+    }
+}
+
+void removeViewDocument(OperationContext* txn, Collection* viewColl, const BSONObj& idDoc) {
+    const bool requireIndex = false;
+    RecordId id = Helpers::findOne(txn, viewColl, idDoc, requireIndex);
+    if (id.isNormal()) {
+        viewColl->deleteDocument(txn, id, &CurOp::get(txn)->debug());
+    }
+}
+
+/**
+ * Adds the contribution of the documents 'docs' of the view's source to the view if 'sign' is
+ * positive, or subtracts it if 'sign' is negative.
+ */
+void applyDeltas(OperationContext* txn,
+                 const Database::MaterializedView& view,
+                 Collection* viewOn,
+                 Collection* viewColl,
+                 const std::vector<BSONObj>& docs,
+                 int sign) {
+    std::deque<Document> input;
+    for (auto&& doc : docs) {
+        input.emplace_back(doc);
+    }
+    auto pipeline = makeDeltaPipeline(txn, view, viewOn, std::move(input));
+
+    const StringData countField = groupCountField(view.pipeline);
+    if (countField.empty()) {
+        // Each result is the view document for the source document with the same _id.
+        invariant(sign > 0);
+        while (auto result = pipeline->getNext()) {
+            insertViewDocument(txn, viewColl, result->toBson());
+        }
+        return;
+    }
+
+    // Each result holds the sums over 'docs' for one group, which are added to the sums stored
+    // for that group in the view.
+    while (auto delta = pipeline->getNext()) {
+        const BSONObj idDoc = Document{{"_id", (*delta)["_id"]}}.toBson();
+
+        const bool requireIndex = false;
+        RecordId id = Helpers::findOne(txn, viewColl, idDoc, requireIndex);
+        Snapshotted<BSONObj> current;
+        if (!id.isNormal() || !viewColl->findDoc(txn, id, &current)) {
+            if (sign < 0) {
+                warning() << "Materialized view " << view.nss
+                          << " has no group for a removed document: " << redact(idDoc)
+                          << "; it may have been modified directly";
+                continue;
+            }
+            insertViewDocument(txn, viewColl, delta->toBson());
+            continue;
+        }
+
+        MutableDocument updated{Document(current.value())};
+        FieldIterator fields(*delta);
+        while (fields.more()) {
+            auto field = fields.next();
+            if (field.first == "_id") {
+                continue;
+            }
+            auto sum = AccumulatorSum::create(pipeline->getContext());
+            sum->process(updated.peek()[field.first], false);
+            sum->process(sign < 0 ? negate(field.second) : field.second, false);
+            updated[field.first] = sum->getValue(false);
+        }
+
+        if (updated.peek()[countField].coerceToLong() <= 0) {
+            viewColl->deleteDocument(txn, id, &CurOp::get(txn)->debug());
+        } else {
+            replaceViewDocument(txn, viewColl, id, current, updated.freeze().toBson());
+        }
+    }
+}
+
+/**
+ * Adds the results of the pipeline of 'view' over every document of 'viewOn' to 'viewColl', in
+ * batches. Calls 'commitBatch' after each batch but the last; it may commit the work done so far,
+ * but must leave 'viewOn' unchanged.
+ */
+template <typename CommitBatch>
+void addAllDocuments(OperationContext* txn,
+                     const Database::MaterializedView& view,
+                     Collection* viewOn,
+                     Collection* viewColl,
+                     CommitBatch&& commitBatch) {
+    std::vector<BSONObj> batch;
+    auto cursor = viewOn->getCursor(txn);
+    while (auto record = cursor->next()) {
+        batch.push_back(record->data.releaseToBson().getOwned());
+        if (batch.size() == kPopulateBatchSize) {
+            applyDeltas(txn, view, viewOn, viewColl, batch, 1);
+            batch.clear();
+
+            cursor->save();
+            commitBatch();
+            txn->checkForInterrupt();
+            invariant(cursor->restore());
+        }
+    }
+    if (!batch.empty()) {
+        applyDeltas(txn, view, viewOn, viewColl, batch, 1);
+    }
+}
+
+/**
+ * Replaces the contents of 'viewColl' with the results of its pipeline over the whole of 'viewOn',
+ * for writes whose delta cannot be computed.
+ */
+void recompute(OperationContext* txn,
+               const Database::MaterializedView& view,
+               Collection* viewOn,
+               Collection* viewColl) {
+    LOG(1) << "Recomputing materialized view " << view.nss << " from " << viewOn->ns();
+
+    std::vector<RecordId> ids;
+    auto cursor = viewColl->getCursor(txn);
+    while (auto record = cursor->next()) {
+        ids.push_back(record->id);
+    }
+    cursor.reset();
+    for (auto&& id : ids) {
+        viewColl->deleteDocument(txn, id, &CurOp::get(txn)->debug());
+    }
+
+    // Everything stays in the caller's WriteUnitOfWork.
+    addAllDocuments(txn, view, viewOn, viewColl, [] {});
+}
+
+/**
+ * Returns the database of 'nss' if it may have materialized views which writes to 'nss' need to
+ * maintain, or nullptr. Maintenance only happens where writes are replicated, since the writes to
+ * the views are replicated themselves.
+ */
+Database* getDbToMaintain(OperationContext* txn, const NamespaceString& nss) {
+    if (!txn->writesAreReplicated()) {
+        return nullptr;
+    }
+
+    Database* db = dbHolder().get(txn, nss.db());
+    if (!db || !db->mayHaveMaterializedViews()) {
+        return nullptr;
+    }
+    return db;
+}
+
+/**
+ * Calls 'callback' with each materialized view defined on 'nss', the source collection and the
+ * collection of the view.
+ */
+template <typename Callback>
+void forEachView(OperationContext* txn, const NamespaceString& nss, Callback&& callback) {
+    Database* db = getDbToMaintain(txn, nss);
+    if (!db) {
+        return;
+    }
+    auto views = db->getMaterializedViewsOn(txn, nss);
+    if (views.empty()) {
+        return;
+    }
+
+    Collection* viewOn = db->getCollection(nss);
+    invariant(viewOn);
+    for (auto&& view : views) {
+        Lock::CollectionLock viewLock(txn->lockState(), view.nss.ns(), MODE_IX);
+        Collection* viewColl = db->getCollection(view.nss);
+        invariant(viewColl);
+        callback(view, viewOn, viewColl);
+    }
+}
+
+}  // namespace
+
+Status validatePipeline(const BSONObj& pipeline) {
+    const int nStages = pipeline.nFields();
+    int stageIndex = 0;
+    for (auto&& stage : pipeline) {
+        ++stageIndex;
+        if (stage.type() != BSONType::Object || stage.Obj().nFields() != 1) {
+            return {ErrorCodes::TypeMismatch,
+                    "Each element of the 'pipeline' array must be an object with a single field"};
+        }
+
+        BSONElement spec = stage.Obj().firstElement();
+        StringData stageName = spec.fieldNameStringData();
+        Status status = Status::OK();
+        if (stageName == "$match") {
+            continue;
+        } else if (stageName == "$project" || stageName == "$addFields") {
+            status = checkDoesNotModifyId(stageName, spec);
+        } else if (stageName == "$group" && stageIndex == nStages) {
+            status = checkGroupIsMaintainable(spec);
+        } else {
+            status = {ErrorCodes::InvalidOptions,
+                      str::stream() << "The " << stageName << " stage is not supported here; "
+                                    << "a materialized view may only use $match, $project and "
+                                    << "$addFields stages, optionally followed by a final $group"};
+        }
+
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+void onCreate(OperationContext* txn, const NamespaceString& nss, const CollectionOptions& options) {
+    invariant(options.isMaterializedView());
+    if (!txn->writesAreReplicated()) {
+        // The initial contents of the view are replicated as inserts.
+        return;
+    }
+    uassertStatusOK(validatePipeline(options.pipeline));
+
+    Database* db = dbHolder().get(txn, nss.db());
+    invariant(db);
+
+    // Views on views would require resolving them on every write, and cycles of materialized views
+    // would apply each write to the same view again and again.
+    const NamespaceString viewOnNss(nss.db(), options.viewOn);
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "Cannot create materialized view " << nss.ns() << " on the view "
+                          << viewOnNss.ns(),
+            !db->getViewCatalog()->lookup(txn, viewOnNss.ns()));
+    for (NamespaceString source = viewOnNss;;) {
+        uassert(ErrorCodes::GraphContainsCycle,
+                str::stream() << "Materialized view " << nss.ns() << " would depend on itself",
+                source != nss);
+        Collection* sourceColl = db->getCollection(source);
+        if (!sourceColl) {
+            break;
+        }
+        CollectionOptions sourceOptions = sourceColl->getCatalogEntry()->getCollectionOptions(txn);
+        if (!sourceOptions.isMaterializedView()) {
+            break;
+        }
+        source = NamespaceString(nss.db(), sourceOptions.viewOn);
+    }
+
+    // Writes to the source which commit before populate() locks it are picked up by its scan.
+    db->setMaterializedViewPopulating(nss, true);
+    txn->recoveryUnit()->onRollback([db, nss] { db->setMaterializedViewPopulating(nss, false); });
+}
+
+void populate(OperationContext* txn, const NamespaceString& nss) {
+    if (!txn->writesAreReplicated()) {
+        // The initial contents of the view are replicated as inserts.
+        return;
+    }
+
+    ScopedTransaction transaction(txn, MODE_IX);
+    AutoGetDb autoDb(txn, nss.db(), MODE_IX);
+    Database* db = autoDb.getDb();
+    if (!db) {
+        return;
+    }
+    ON_BLOCK_EXIT([db, nss] { db->setMaterializedViewPopulating(nss, false); });
+
+    // The catalog cannot change while the database is locked, even in intent mode.
+    Collection* viewColl = db->getCollection(nss);
+    if (!viewColl) {
+        return;
+    }
+    CollectionOptions options = viewColl->getCatalogEntry()->getCollectionOptions(txn);
+    if (!options.isMaterializedView()) {
+        // Dropped and created again as something else since.
+        return;
+    }
+    const NamespaceString viewOnNss(nss.db(), options.viewOn);
+
+    // Writers to the source lock it before the view, so it must be locked first here too.
+    Lock::CollectionLock viewOnLock(txn->lockState(), viewOnNss.ns(), MODE_S);
+    Lock::CollectionLock viewLock(txn->lockState(), nss.ns(), MODE_X);
+    Collection* viewOn = db->getCollection(viewOnNss);
+    if (!viewOn) {
+        // The view is filled as documents get inserted into its source.
+        return;
+    }
+    uassert(ErrorCodes::NotMaster,
+            str::stream() << "Not primary while populating materialized view " << nss.ns(),
+            repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(nss));
+
+    const Database::MaterializedView view{nss, options.pipeline};
+    auto wuow = stdx::make_unique<WriteUnitOfWork>(txn);
+    addAllDocuments(txn, view, viewOn, viewColl, [&] {
+        wuow->commit();
+        wuow = stdx::make_unique<WriteUnitOfWork>(txn);
+    });
+    wuow->commit();
+}
+
+bool hasViewsOn(OperationContext* txn, const NamespaceString& nss) {
+    Database* db = getDbToMaintain(txn, nss);
+    return db && !db->getMaterializedViewsOn(txn, nss).empty();
+}
+
+void onInserts(OperationContext* txn,
+               const NamespaceString& nss,
+               std::vector<BSONObj>::const_iterator begin,
+               std::vector<BSONObj>::const_iterator end) {
+    forEachView(txn, nss, [&](const Database::MaterializedView& view,
+                              Collection* viewOn,
+                              Collection* viewColl) {
+        applyDeltas(txn, view, viewOn, viewColl, std::vector<BSONObj>(begin, end), 1);
+    });
+}
+
+void onUpdate(OperationContext* txn,
+              const NamespaceString& nss,
+              const BSONObj& preImage,
+              const BSONObj& postImage) {
+    forEachView(txn, nss, [&](const Database::MaterializedView& view,
+                              Collection* viewOn,
+                              Collection* viewColl) {
+        if (!groupCountField(view.pipeline).empty()) {
+            if (preImage.isEmpty()) {
+                // There is no telling which group the document used to count towards.
+                recompute(txn, view, viewOn, viewColl);
+                return;
+            }
+            applyDeltas(txn, view, viewOn, viewColl, {preImage}, -1);
+            applyDeltas(txn, view, viewOn, viewColl, {postImage}, 1);
+            return;
+        }
+
+        auto pipeline = makeDeltaPipeline(txn, view, viewOn, {Document(postImage)});
+        if (auto result = pipeline->getNext()) {
+            upsertViewDocument(txn, viewColl, result->toBson());
+        } else {
+            // The document no longer passes the view's $match stages.
+            removeViewDocument(txn, viewColl, postImage["_id"].wrap());
+        }
+    });
+}
+
+void onDelete(OperationContext* txn, const NamespaceString& nss, const BSONObj& doc) {
+    forEachView(txn, nss, [&](const Database::MaterializedView& view,
+                              Collection* viewOn,
+                              Collection* viewColl) {
+        if (!groupCountField(view.pipeline).empty()) {
+            applyDeltas(txn, view, viewOn, viewColl, {doc}, -1);
+        } else {
+            removeViewDocument(txn, viewColl, doc["_id"].wrap());
+        }
+    });
+}
+
+}  // namespace materialized_view
+}  // namespace mongo
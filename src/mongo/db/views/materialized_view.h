@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class Collection;
+class CollectionOptions;
+class NamespaceString;
+class OperationContext;
+
+/**
+ * Maintenance of materialized views: collections created with {viewOn: <source>, pipeline: [...],
+ * materialized: true}, which hold the results of running the pipeline on the source collection.
+ * Rather than rerunning the pipeline, every write to the source is turned into a delta which is
+ * applied to the view, inside the same WriteUnitOfWork.
+ *
+ * Only pipelines whose results can be maintained from a single document's delta are supported:
+ * any number of $match, $project and $addFields stages, which may not modify _id, optionally
+ * followed by one final $group whose accumulators are all $sum. A $group must also count its
+ * documents with {$sum: 1}, so that a group can be removed once its last document goes away.
+ *
+ * The maintenance happens only where writes are replicated. The writes to the view are replicated
+ * as well, so secondaries apply them rather than maintaining their own views.
+ *
+ * A new view is populated after the collection holding it has been created, in batches of
+ * documents which each commit on their own. Writes to the source wait for the population to
+ * finish, but the rest of the database remains available.
+ */
+namespace materialized_view {
+
+/**
+ * Returns an error if the results of 'pipeline' cannot be maintained incrementally.
+ */
+Status validatePipeline(const BSONObj& pipeline);
+
+/**
+ * Validates the newly created materialized view 'nss', and leaves it out of the maintenance of
+ * its source until populate() has filled it. Must be called in the WriteUnitOfWork which creates
+ * the view. Throws on failure.
+ */
+void onCreate(OperationContext* txn, const NamespaceString& nss, const CollectionOptions& options);
+
+/**
+ * Fills the materialized view 'nss', created by a WriteUnitOfWork which has committed since, with
+ * the results of its pipeline over the current contents of its source. Takes its own locks, which
+ * must not include an exclusive lock on the database if the rest of it is to remain available.
+ * Throws on failure, in which case the view is left partially filled and should be dropped.
+ */
+void populate(OperationContext* txn, const NamespaceString& nss);
+
+/**
+ * Returns true if there are materialized views to maintain on the collection 'nss'.
+ */
+bool hasViewsOn(OperationContext* txn, const NamespaceString& nss);
+
+/**
+ * Apply the deltas for a write to the collection 'nss' to the materialized views defined on it.
+ * 'preImage' is the document as it was before the update. If it is empty, the views with a $group
+ * have to be recomputed from the whole of 'nss'.
+ */
+void onInserts(OperationContext* txn,
+               const NamespaceString& nss,
+               std::vector<BSONObj>::const_iterator begin,
+               std::vector<BSONObj>::const_iterator end);
+void onUpdate(OperationContext* txn,
+              const NamespaceString& nss,
+              const BSONObj& preImage,
+              const BSONObj& postImage);
+void onDelete(OperationContext* txn, const NamespaceString& nss, const BSONObj& doc);
+
+}  // namespace materialized_view
+}  // namespace mongo
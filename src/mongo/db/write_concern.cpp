@@ -42,6 +42,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/db/stats/wait_event_profile.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/rpc/protocol.h"
@@ -202,11 +203,13 @@ Status waitForWriteConcern(OperationContext* txn,
                 result->fsyncFiles = storageEngine->flushAllFiles(txn, true);
             } else {
                 // We only need to commit the journal if we're durable
+                ScopedWaitEvent journalWait(WaitEvent::kJournal);
                 txn->recoveryUnit()->waitUntilDurable();
             }
             break;
         }
-        case WriteConcernOptions::SyncMode::JOURNAL:
+        case WriteConcernOptions::SyncMode::JOURNAL: {
+            ScopedWaitEvent journalWait(WaitEvent::kJournal);
             if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::Mode::modeNone) {
                 // Wait for ops to become durable then update replication system's
                 // knowledge of this.
@@ -217,6 +220,7 @@ Status waitForWriteConcern(OperationContext* txn,
                 txn->recoveryUnit()->waitUntilDurable();
             }
             break;
+        }
     }
 
     result->syncMillis = syncTimer.millis();
@@ -236,8 +240,10 @@ Status waitForWriteConcern(OperationContext* txn,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
-    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-        replCoord->awaitReplication(txn, replOpTime, writeConcernWithPopulatedSyncMode);
+    repl::ReplicationCoordinator::StatusAndDuration replStatus = [&] {
+        ScopedWaitEvent replicationWait(WaitEvent::kReplication);
+        return replCoord->awaitReplication(txn, replOpTime, writeConcernWithPopulatedSyncMode);
+    }();
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         result->err = "timeout";
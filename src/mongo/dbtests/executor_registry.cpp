@@ -217,6 +217,30 @@ public:
     }
 };
 
+// Test that dropping the collection kills every registered runner, however many are registered.
+class ExecutorRegistryDropCollectionKillsAllExecutors : public ExecutorRegistryBase {
+public:
+    void run() {
+        std::vector<unique_ptr<PlanExecutor>> runs;
+        BSONObj obj;
+        for (int i = 0; i < 32; ++i) {
+            runs.emplace_back(getCollscan());
+            ASSERT_EQUALS(PlanExecutor::ADVANCED, runs.back()->getNext(&obj, NULL));
+            runs.back()->saveState();
+            registerExecutor(runs.back().get());
+        }
+
+        // Drop our collection.
+        _client.dropCollection(nss.ns());
+
+        for (auto&& run : runs) {
+            deregisterExecutor(run.get());
+            run->restoreState();
+            ASSERT_EQUALS(PlanExecutor::DEAD, run->getNext(&obj, NULL));
+        }
+    }
+};
+
 // Test that registered runners are killed when all indices are dropped on the collection.
 class ExecutorRegistryDropAllIndices : public ExecutorRegistryBase {
 public:
@@ -337,6 +361,7 @@ public:
     void setupTests() {
         add<ExecutorRegistryDiskLocInvalid>();
         add<ExecutorRegistryDropCollection>();
+        add<ExecutorRegistryDropCollectionKillsAllExecutors>();
         add<ExecutorRegistryDropAllIndices>();
         add<ExecutorRegistryDropOneIndex>();
         add<ExecutorRegistryDropDatabase>();
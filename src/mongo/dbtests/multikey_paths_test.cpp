@@ -33,7 +33,9 @@
 
 #include "mongo/db/catalog/index_create.h"
 #include "mongo/db/client.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/namespace_string.h"
@@ -81,6 +83,59 @@ public:
         return dbtests::createIndexFromSpec(_opCtx.get(), collection->ns().ns(), indexSpec);
     }
 
+    /**
+     * Creates the indexes {a: 1} and {b: 1}, inserts {_id: 0, a: 5, b: 5}, then replaces it with
+     * 'newDoc', passing 'updatedFields' to Collection::updateDocument(). Returns the statistics of
+     * the update.
+     */
+    OpDebug updateWithSingleFieldIndexes(Collection* collection,
+                                         BSONObj newDoc,
+                                         const FieldRefSet* updatedFields) {
+        for (auto&& field : {"a", "b"}) {
+            ASSERT_OK(createIndex(collection,
+                                  BSON("name" << std::string(field) + "_1"
+                                              << "ns"
+                                              << _nss.ns()
+                                              << "key"
+                                              << BSON(field << 1)
+                                              << "v"
+                                              << static_cast<int>(kIndexVersion))));
+        }
+
+        {
+            WriteUnitOfWork wuow(_opCtx.get());
+            OpDebug* const nullOpDebug = nullptr;
+            const bool enforceQuota = true;
+            ASSERT_OK(collection->insertDocument(
+                _opCtx.get(), BSON("_id" << 0 << "a" << 5 << "b" << 5), nullOpDebug, enforceQuota));
+            wuow.commit();
+        }
+
+        auto cursor = collection->getCursor(_opCtx.get());
+        auto record = cursor->next();
+        invariant(record);
+        auto oldDoc = collection->docFor(_opCtx.get(), record->id);
+
+        OpDebug opDebug;
+        WriteUnitOfWork wuow(_opCtx.get());
+        const bool enforceQuota = true;
+        const bool indexesAffected = true;
+        OplogUpdateEntryArgs args;
+        ASSERT_OK(collection
+                      ->updateDocument(_opCtx.get(),
+                                       record->id,
+                                       oldDoc,
+                                       newDoc,
+                                       enforceQuota,
+                                       indexesAffected,
+                                       &opDebug,
+                                       &args,
+                                       updatedFields)
+                      .getStatus());
+        wuow.commit();
+        return opDebug;
+    }
+
     void assertMultikeyPaths(Collection* collection,
                              BSONObj keyPattern,
                              const MultikeyPaths& expectedMultikeyPaths) {
@@ -391,5 +446,37 @@ TEST_F(MultikeyPathsTest, PathsUpdatedForMultipleIndexesOnDocumentInsert) {
     assertMultikeyPaths(collection, keyPatternAC, {{0U}, std::set<size_t>{}});
 }
 
+TEST_F(MultikeyPathsTest, AllIndexesUpdatedWithoutUpdatedFields) {
+    AutoGetCollection autoColl(_opCtx.get(), _nss, MODE_X);
+    Collection* collection = autoColl.getCollection();
+    invariant(collection);
+
+    const FieldRefSet* const allFieldsUpdated = nullptr;
+    auto opDebug = updateWithSingleFieldIndexes(
+        collection, BSON("_id" << 0 << "a" << 6 << "b" << BSON_ARRAY(1 << 2)), allFieldsUpdated);
+
+    ASSERT_EQ(opDebug.keysInserted, 3);
+    ASSERT_EQ(opDebug.keysDeleted, 2);
+    assertMultikeyPaths(collection, BSON("b" << 1), {{0U}});
+}
+
+TEST_F(MultikeyPathsTest, IndexesOnFieldsNotUpdatedAreSkipped) {
+    AutoGetCollection autoColl(_opCtx.get(), _nss, MODE_X);
+    Collection* collection = autoColl.getCollection();
+    invariant(collection);
+
+    // The new document changes 'b' too, but as only 'a' is reported as updated, no UpdateTicket
+    // is made for the index on 'b' and its keys and multikey state are left alone.
+    FieldRef updatedField("a");
+    FieldRefSet updatedFields;
+    updatedFields.insert(&updatedField);
+    auto opDebug = updateWithSingleFieldIndexes(
+        collection, BSON("_id" << 0 << "a" << 6 << "b" << BSON_ARRAY(1 << 2)), &updatedFields);
+
+    ASSERT_EQ(opDebug.keysInserted, 1);
+    ASSERT_EQ(opDebug.keysDeleted, 1);
+    assertMultikeyPaths(collection, BSON("b" << 1), {std::set<size_t>{}});
+}
+
 }  // namespace
 }  // namespace mongo
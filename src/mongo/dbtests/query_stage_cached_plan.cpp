@@ -41,6 +41,7 @@
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/explain.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_yield_policy.h"
@@ -48,6 +49,7 @@
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCachedPlan {
 
@@ -250,6 +252,156 @@ public:
     }
 };
 
+/**
+ * Test that with adaptive replanning, a cached plan which is making no progress is replanned
+ * before it uses up the whole trial period budget.
+ */
+class QueryStageCachedPlanAdaptiveReplan : public QueryStageCachedPlanBase {
+public:
+    void run() {
+        bool oldAdaptiveReplanning = internalQueryCacheAdaptiveReplanning.load();
+        internalQueryCacheAdaptiveReplanning.store(true);
+        ON_BLOCK_EXIT([&] { internalQueryCacheAdaptiveReplanning.store(oldAdaptiveReplanning); });
+
+        AutoGetCollectionForRead ctx(&_txn, nss);
+        Collection* collection = ctx.getCollection();
+        ASSERT(collection);
+
+        // Query can be answered by either index on "a" or index on "b".
+        auto qr = stdx::make_unique<QueryRequest>(nss);
+        qr->setFilter(fromjson("{a: {$gte: 8}, b: 1}"));
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            txn(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+        ASSERT_OK(statusWithCQ.getStatus());
+        const std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+        // Get planner params.
+        QueryPlannerParams plannerParams;
+        fillOutPlannerParams(&_txn, collection, cq.get(), &plannerParams);
+
+        // The mock plan hits EOF with no results well within the eviction budget, so only a
+        // works-per-result projection can make this stage replan.
+        const size_t decisionWorks = 10;
+        const size_t mockWorks = 3 * decisionWorks;
+        ASSERT_LT(mockWorks, static_cast<size_t>(internalQueryCacheEvictionRatio * decisionWorks));
+        auto mockChild = stdx::make_unique<QueuedDataStage>(&_txn, &_ws);
+        for (size_t i = 0; i < mockWorks; i++) {
+            mockChild->pushBack(PlanStage::NEED_TIME);
+        }
+
+        CachedPlanStage cachedPlanStage(
+            &_txn, collection, &_ws, cq.get(), plannerParams, decisionWorks, mockChild.release());
+
+        PlanYieldPolicy yieldPolicy(PlanExecutor::YIELD_MANUAL,
+                                    _txn.getServiceContext()->getFastClockSource());
+        ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+
+        const CachedPlanStats* stats =
+            static_cast<const CachedPlanStats*>(cachedPlanStage.getSpecificStats());
+        ASSERT(stats->replanned);
+
+        // Make sure that we get 2 legit results back from the new plan.
+        size_t numResults = 0;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (state != PlanStage::IS_EOF) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            state = cachedPlanStage.work(&id);
+
+            ASSERT_NE(state, PlanStage::FAILURE);
+            ASSERT_NE(state, PlanStage::DEAD);
+
+            if (state == PlanStage::ADVANCED) {
+                WorkingSetMember* member = _ws.get(id);
+                ASSERT(cq->root()->matchesBSON(member->obj.value()));
+                numResults++;
+            }
+        }
+
+        ASSERT_EQ(numResults, 2U);
+    }
+};
+
+/**
+ * Test that with adaptive replanning, a cached plan which passes its trial period but then needs
+ * far more works per result is recorded as evicted, and that this shows up in explain.
+ */
+class QueryStageCachedPlanEvictAfterTrial : public QueryStageCachedPlanBase {
+public:
+    void run() {
+        bool oldAdaptiveReplanning = internalQueryCacheAdaptiveReplanning.load();
+        internalQueryCacheAdaptiveReplanning.store(true);
+        ON_BLOCK_EXIT([&] { internalQueryCacheAdaptiveReplanning.store(oldAdaptiveReplanning); });
+
+        AutoGetCollectionForRead ctx(&_txn, nss);
+        Collection* collection = ctx.getCollection();
+        ASSERT(collection);
+
+        // The limit ends the trial period as soon as the cached plan returns a result.
+        auto qr = stdx::make_unique<QueryRequest>(nss);
+        qr->setFilter(fromjson("{a: {$gte: 8}, b: 1}"));
+        qr->setLimit(1);
+        auto statusWithCQ = CanonicalQuery::canonicalize(
+            txn(), std::move(qr), ExtensionsCallbackDisallowExtensions());
+        ASSERT_OK(statusWithCQ.getStatus());
+        const std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+        // Get planner params.
+        QueryPlannerParams plannerParams;
+        fillOutPlannerParams(&_txn, collection, cq.get(), &plannerParams);
+
+        // The mock plan returns a result on its first work, and then spends the whole trial
+        // period budget without producing another one.
+        const size_t decisionWorks = 10;
+        const size_t mockWorks =
+            static_cast<size_t>(internalQueryCacheEvictionRatio * decisionWorks);
+        auto mockChild = stdx::make_unique<QueuedDataStage>(&_txn, &_ws);
+        {
+            WorkingSetID id = _ws.allocate();
+            WorkingSetMember* member = _ws.get(id);
+            member->obj = Snapshotted<BSONObj>(SnapshotId(), fromjson("{_id: 8, a: 8, b: 1}"));
+            member->transitionToOwnedObj();
+            mockChild->pushBack(id);
+        }
+        for (size_t i = 0; i < mockWorks; i++) {
+            mockChild->pushBack(PlanStage::NEED_TIME);
+        }
+
+        CachedPlanStage cachedPlanStage(
+            &_txn, collection, &_ws, cq.get(), plannerParams, decisionWorks, mockChild.release());
+
+        PlanYieldPolicy yieldPolicy(PlanExecutor::YIELD_MANUAL,
+                                    _txn.getServiceContext()->getFastClockSource());
+        ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+
+        const CachedPlanStats* stats =
+            static_cast<const CachedPlanStats*>(cachedPlanStage.getSpecificStats());
+        ASSERT_FALSE(stats->replanned);
+        ASSERT_FALSE(stats->evictedAfterTrial);
+
+        size_t numResults = 0;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (state != PlanStage::IS_EOF) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            state = cachedPlanStage.work(&id);
+
+            ASSERT_NE(state, PlanStage::FAILURE);
+            ASSERT_NE(state, PlanStage::DEAD);
+
+            if (state == PlanStage::ADVANCED) {
+                numResults++;
+            }
+        }
+
+        ASSERT_EQ(numResults, 1U);
+        ASSERT(stats->evictedAfterTrial);
+
+        // The eviction is reported in the stage's execution stats.
+        BSONObjBuilder bob;
+        Explain::statsToBSON(*cachedPlanStage.getStats(), &bob);
+        ASSERT(bob.obj()["evictedAfterTrial"].trueValue());
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_cached_plan") {}
@@ -257,6 +409,8 @@ public:
     void setupTests() {
         add<QueryStageCachedPlanFailure>();
         add<QueryStageCachedPlanHitMaxWorks>();
+        add<QueryStageCachedPlanAdaptiveReplan>();
+        add<QueryStageCachedPlanEvictAfterTrial>();
     }
 };
 
@@ -45,10 +45,12 @@
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCollectionScan {
 
@@ -199,6 +201,67 @@ public:
     }
 };
 
+//
+// Records which do not pass the filter are skipped in batches within a single call to work(),
+// but are still accounted for as one work cycle each.
+//
+
+class QueryStageCollscanSkipsFilteredRecordsInBatches : public QueryStageCollectionScanBase {
+public:
+    void run() {
+        const int oldBatchSize = internalQueryExecCollectionScanBatchSize.load();
+        ON_BLOCK_EXIT([oldBatchSize] {
+            internalQueryExecCollectionScanBatchSize.store(oldBatchSize);
+        });
+
+        // A batch size of 1 scans one record per call to work().
+        internalQueryExecCollectionScanBatchSize.store(1);
+        size_t numCalls = 0;
+        unique_ptr<PlanStageStats> stats = scanWithFilter(&numCalls);
+        ASSERT_EQUALS(numCalls, stats->common.works);
+
+        internalQueryExecCollectionScanBatchSize.store(32);
+        stats = scanWithFilter(&numCalls);
+        ASSERT_LESS_THAN(numCalls, stats->common.works);
+
+        const CollectionScanStats* specificStats =
+            static_cast<const CollectionScanStats*>(stats->specific.get());
+        ASSERT_EQUALS(static_cast<size_t>(numObj()), specificStats->docsTested);
+        ASSERT_EQUALS(5U, stats->common.advanced);
+    }
+
+private:
+    /**
+     * Runs a forward scan matching the last five documents and counts the calls to work().
+     */
+    unique_ptr<PlanStageStats> scanWithFilter(size_t* numCalls) {
+        AutoGetCollectionForRead ctx(&_txn, nss);
+
+        CollectionScanParams params;
+        params.collection = ctx.getCollection();
+        params.direction = CollectionScanParams::FORWARD;
+        params.tailable = false;
+
+        const CollatorInterface* collator = nullptr;
+        StatusWithMatchExpression statusWithMatcher =
+            MatchExpressionParser::parse(BSON("foo" << BSON("$gte" << numObj() - 5)),
+                                         ExtensionsCallbackDisallowExtensions(),
+                                         collator);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+        WorkingSet ws;
+        CollectionScan scan(&_txn, params, &ws, filterExpr.get());
+        *numCalls = 0;
+        while (!scan.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            scan.work(&id);
+            ++*numCalls;
+        }
+        return scan.getStats();
+    }
+};
+
 //
 // Get objects in the order we inserted them.
 //
@@ -409,6 +472,7 @@ public:
         add<QueryStageCollscanBasicBackward>();
         add<QueryStageCollscanBasicForwardWithMatch>();
         add<QueryStageCollscanBasicBackwardWithMatch>();
+        add<QueryStageCollscanSkipsFilteredRecordsInBatches>();
         add<QueryStageCollscanObjectsInOrderForward>();
         add<QueryStageCollscanObjectsInOrderBackward>();
         add<QueryStageCollscanInvalidateUpcomingObject>();
@@ -41,8 +41,10 @@
 #include "mongo/db/exec/sort.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/scopeguard.h"
 
 /**
  * This file tests db/exec/sort.cpp
@@ -156,6 +158,7 @@ public:
         params.collection = coll;
         params.pattern = BSON("foo" << direction);
         params.limit = limit();
+        params.allowDiskUse = allowDiskUse();
 
         auto keyGenStage = make_unique<SortKeyGeneratorStage>(
             &_txn, queuedDataStage.release(), ws.get(), params.pattern, BSONObj(), nullptr);
@@ -215,6 +218,11 @@ public:
         return 0;
     };
 
+    // Whether the sort stage may spill to disk.
+    virtual bool allowDiskUse() const {
+        return false;
+    }
+
 
     static const char* ns() {
         return "unittests.QueryStageSort";
@@ -302,6 +310,27 @@ public:
     }
 };
 
+// Sort a big bunch of objects with a small memory limit, spilling them to disk.
+template <int LIMIT>
+class QueryStageSortSpill : public QueryStageSortExt {
+public:
+    int limit() const override {
+        return LIMIT;
+    }
+
+    bool allowDiskUse() const override {
+        return true;
+    }
+
+    void run() {
+        const int oldMaxBytes = internalQueryExecMaxBlockingSortBytes.load();
+        internalQueryExecMaxBlockingSortBytes.store(64 * 1024);
+        ON_BLOCK_EXIT([oldMaxBytes] { internalQueryExecMaxBlockingSortBytes.store(oldMaxBytes); });
+
+        QueryStageSortExt::run();
+    }
+};
+
 // Mutation invalidation of docs fed to sort.
 class QueryStageSortMutationInvalidation : public QueryStageSortTestBase {
 public:
@@ -586,6 +615,9 @@ public:
         // and a special case for limit == 1
         add<QueryStageSortDecWithLimit<1>>();
         add<QueryStageSortExt>();
+        add<QueryStageSortSpill<0>>();
+        // A limit too large to fit in memory spills as well
+        add<QueryStageSortSpill<5000>>();
         add<QueryStageSortMutationInvalidation>();
         add<QueryStageSortDeletionInvalidation>();
         add<QueryStageSortDeletionInvalidationWithLimit<10>>();
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2013-2014 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+/**
+ * This file tests db/exec/text_or.cpp.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/text_or.h"
+#include "mongo/db/exec/working_set_computed_data.h"
+#include "mongo/db/fts/fts_spec.h"
+#include "mongo/dbtests/dbtests.h"
+#include "mongo/stdx/memory.h"
+
+namespace QueryStageTextOr {
+
+using stdx::make_unique;
+
+class QueryStageTextOrBase {
+public:
+    QueryStageTextOrBase() : _client(&_txn) {}
+
+    virtual ~QueryStageTextOrBase() {
+        _client.dropCollection(ns());
+    }
+
+    static const char* ns() {
+        return "unittests.QueryStageTextOr";
+    }
+
+protected:
+    const ServiceContext::UniqueOperationContext _txnPtr = cc().makeOperationContext();
+    OperationContext& _txn = *_txnPtr;
+    DBDirectClient _client;
+};
+
+//
+// Test that with a single term, a document is returned once even if the index scan produces its
+// RecordId twice.
+//
+class TextOrSingleTermReturnsEachRecordIdOnce : public QueryStageTextOrBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        _client.insert(ns(), BSON("_id" << 1 << "t"
+                                        << "hello"));
+        ASSERT_OK(dbtests::createIndex(&_txn,
+                                       ns(),
+                                       BSON("t"
+                                            << "text")));
+
+        Collection* coll = ctx.db()->getCollection(ns());
+        ASSERT(coll);
+        IndexDescriptor* index = coll->getIndexCatalog()->findIndexByName(&_txn, "t_text");
+        ASSERT(index);
+        fts::FTSSpec ftsSpec(index->infoObj());
+
+        auto cursor = coll->getCursor(&_txn);
+        auto record = cursor->next();
+        ASSERT(record);
+
+        // The child returns the same text index key for the document twice.
+        WorkingSet ws;
+        auto child = make_unique<QueuedDataStage>(&_txn, &ws);
+        for (int i = 0; i < 2; ++i) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* member = ws.get(id);
+            member->recordId = record->id;
+            member->keyData.push_back(IndexKeyDatum(index->keyPattern(),
+                                                    BSON(""
+                                                         << "hello"
+                                                         << ""
+                                                         << 1.5),
+                                                    nullptr));
+            ws.transitionToRecordIdAndIdx(id);
+            child->pushBack(id);
+        }
+
+        const MatchExpression* filter = nullptr;
+        TextOrStage textOr(&_txn, ftsSpec, &ws, filter, index);
+        textOr.addChild(std::move(child));
+
+        int numResults = 0;
+        while (!textOr.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = textOr.work(&id);
+            ASSERT_NOT_EQUALS(PlanStage::FAILURE, state);
+            if (PlanStage::ADVANCED != state) {
+                continue;
+            }
+
+            ++numResults;
+            WorkingSetMember* member = ws.get(id);
+            ASSERT(member->hasObj());
+            ASSERT_EQUALS(member->recordId, record->id);
+            auto score = static_cast<const TextScoreComputedData*>(
+                member->getComputed(WSM_COMPUTED_TEXT_SCORE));
+            ASSERT_EQUALS(score->getScore(), 1.5);
+        }
+        ASSERT_EQUALS(numResults, 1);
+    }
+};
+
+class All : public Suite {
+public:
+    All() : Suite("query_stage_text_or") {}
+
+    void setupTests() {
+        add<TextOrSingleTermReturnsEachRecordIdOnce>();
+    }
+};
+
+SuiteInstance<All> queryStageTextOrAll;
+
+}  // namespace QueryStageTextOr
@@ -44,8 +44,11 @@ namespace mongo {
 namespace executor {
 
 AsyncSecureStream::AsyncSecureStream(asio::io_service::strand* strand,
-                                     asio::ssl::context* sslContext)
-    : _strand(strand), _stream(_strand->get_io_service(), *sslContext) {}
+                                     asio::ssl::context* sslContext,
+                                     const HostAndPort& target)
+    : _strand(strand),
+      _stream(_strand->get_io_service(), *sslContext),
+      _target(target.toString()) {}
 
 AsyncSecureStream::~AsyncSecureStream() {
     destroyStream(&_stream.lowest_layer(), _connected);
@@ -88,9 +91,12 @@ void AsyncSecureStream::read(asio::mutable_buffer buffer, StreamHandler&& stream
 }
 
 void AsyncSecureStream::_handleConnect(asio::ip::tcp::resolver::iterator iter) {
+    getSSLClientSessionCache().prepareResumption(_stream.native_handle(), _target);
     _stream.async_handshake(decltype(_stream)::client,
                             _strand->wrap([this, iter](std::error_code ec) {
                                 if (ec) {
+                                    getSSLClientSessionCache().forgetSession(
+                                        _stream.native_handle(), _target);
                                     return _userHandler(ec);
                                 }
                                 return _handleHandshake(ec, iter->host_name());
@@ -103,6 +109,8 @@ void AsyncSecureStream::_handleHandshake(std::error_code ec, const std::string&
     if (!certStatus.isOK()) {
         warning() << "Failed to validate peer certificate during SSL handshake: "
                   << certStatus.getStatus();
+    } else {
+        getSSLClientSessionCache().recordSession(_stream.native_handle(), _target);
     }
     _userHandler(make_error_code(certStatus.getStatus().code()));
 }
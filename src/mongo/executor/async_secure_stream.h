@@ -36,13 +36,16 @@
 #include <asio/ssl.hpp>
 
 #include "mongo/executor/async_stream_interface.h"
+#include "mongo/util/net/hostandport.h"
 
 namespace mongo {
 namespace executor {
 
 class AsyncSecureStream final : public AsyncStreamInterface {
 public:
-    AsyncSecureStream(asio::io_service::strand* strand, asio::ssl::context* sslContext);
+    AsyncSecureStream(asio::io_service::strand* strand,
+                      asio::ssl::context* sslContext,
+                      const HostAndPort& target);
 
     ~AsyncSecureStream();
 
@@ -64,6 +67,8 @@ private:
 
     asio::io_service::strand* const _strand;
     asio::ssl::stream<asio::ip::tcp::socket> _stream;
+    // The host this stream connects to, under which its TLS session is kept for resumption.
+    const std::string _target;
     ConnectHandler _userHandler;
     bool _connected = false;
 };
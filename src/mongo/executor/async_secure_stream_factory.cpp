@@ -55,10 +55,10 @@ AsyncSecureStreamFactory::AsyncSecureStreamFactory(SSLManagerInterface* sslManag
 }
 
 std::unique_ptr<AsyncStreamInterface> AsyncSecureStreamFactory::makeStream(
-    asio::io_service::strand* strand, const HostAndPort&) {
+    asio::io_service::strand* strand, const HostAndPort& target) {
     int sslModeVal = getSSLGlobalParams().sslMode.load();
     if (sslModeVal == SSLParams::SSLMode_preferSSL || sslModeVal == SSLParams::SSLMode_requireSSL) {
-        return stdx::make_unique<AsyncSecureStream>(strand, &_sslContext);
+        return stdx::make_unique<AsyncSecureStream>(strand, &_sslContext, target);
     }
     return stdx::make_unique<AsyncStream>(strand);
 }
@@ -104,13 +104,23 @@ public:
      */
     size_t createdConnections(const stdx::unique_lock<stdx::mutex>& lk);
 
+    /**
+     * Returns how long requests which were handed a connection had to wait for it.
+     */
+    const ConnectionWaitTimeHistogram& acquisitionWaitTimes(
+        const stdx::unique_lock<stdx::mutex>& lk);
+
 private:
     using OwnedConnection = std::unique_ptr<ConnectionInterface>;
     using OwnershipPool = stdx::unordered_map<ConnectionInterface*, OwnedConnection>;
-    using Request = std::pair<Date_t, GetConnectionCallback>;
+    struct Request {
+        Date_t expiration;
+        Date_t enqueued;
+        GetConnectionCallback cb;
+    };
     struct RequestComparator {
         bool operator()(const Request& a, const Request& b) {
-            return a.first > b.first;
+            return a.expiration > b.expiration;
         }
     };
 
@@ -147,6 +157,12 @@ private:
 
     size_t _created;
 
+    // Whether the pool has reached minConnections since it was created or last dropped its
+    // connections. Requests are not served until it has.
+    bool _warm;
+
+    ConnectionWaitTimeHistogram _acquisitionWaitTimes;
+
     /**
      * The current state of the pool
      *
@@ -176,6 +192,7 @@ private:
 constexpr Milliseconds ConnectionPool::kDefaultHostTimeout;
 size_t const ConnectionPool::kDefaultMaxConns = std::numeric_limits<size_t>::max();
 size_t const ConnectionPool::kDefaultMinConns = 1;
+size_t const ConnectionPool::kDefaultMaxConnecting = std::numeric_limits<size_t>::max();
 constexpr Milliseconds ConnectionPool::kDefaultRefreshRequirement;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshTimeout;
 
@@ -234,6 +251,7 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->availableConnections(lk),
                                      pool->createdConnections(lk),
                                      pool->refreshingConnections(lk)};
+        hostStats.acquisitionWaitTimes = pool->acquisitionWaitTimes(lk);
         stats->updateStatsForHost(_name, host, hostStats);
     }
 }
@@ -256,6 +274,7 @@ ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAnd
       _inFulfillRequests(false),
       _inSpawnConnections(false),
       _created(0),
+      _warm(false),
       _state(State::kRunning) {}
 
 ConnectionPool::SpecificPool::~SpecificPool() {
@@ -280,6 +299,11 @@ size_t ConnectionPool::SpecificPool::createdConnections(const stdx::unique_lock<
     return _created;
 }
 
+const ConnectionWaitTimeHistogram& ConnectionPool::SpecificPool::acquisitionWaitTimes(
+    const stdx::unique_lock<stdx::mutex>& lk) {
+    return _acquisitionWaitTimes;
+}
+
 void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
                                                  Milliseconds timeout,
                                                  stdx::unique_lock<stdx::mutex> lk,
@@ -288,9 +312,9 @@ void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
         timeout = _parent->_options.refreshTimeout;
     }
 
-    const auto expiration = _parent->_factory->now() + timeout;
+    const auto now = _parent->_factory->now();
 
-    _requests.push(make_pair(expiration, std::move(cb)));
+    _requests.push(Request{now + timeout, now, std::move(cb)});
 
     updateStateInLock();
 
@@ -354,6 +378,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
                              // pool
                              if (status.isOK()) {
                                  addToReady(lk, std::move(conn));
+                                 spawnConnections(lk);
                                  return;
                              }
 
@@ -424,6 +449,9 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     // Drop ready connections
     _readyPool.clear();
 
+    // Whatever replaces them has to warm up again
+    _warm = false;
+
     // Migrate processing connections to the dropped pool
     for (auto&& x : _processingPool) {
         _droppedProcessingPool[x.first] = std::move(x.second);
@@ -446,7 +474,7 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     lk.unlock();
 
     while (requestsToFail.size()) {
-        requestsToFail.top().second(status);
+        requestsToFail.top().cb(status);
         requestsToFail.pop();
     }
 }
@@ -461,6 +489,14 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
     _inFulfillRequests = true;
     auto guard = MakeGuard([&] { _inFulfillRequests = false; });
 
+    // Hold requests back until minConnections are ready, so that a host which has just come up
+    // is not handed out while most of its connections are still being set up.
+    if (!_warm) {
+        if (_readyPool.size() < _parent->_options.minConnections)
+            return;
+        _warm = true;
+    }
+
     while (_requests.size()) {
         auto iter = _readyPool.begin();
 
@@ -488,7 +524,8 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         }
 
         // Grab the request and callback
-        auto cb = std::move(_requests.top().second);
+        auto cb = std::move(_requests.top().cb);
+        _acquisitionWaitTimes.increment(_parent->_factory->now() - _requests.top().enqueued);
         _requests.pop();
 
         auto connPtr = conn.get();
@@ -524,8 +561,10 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
             std::min(_requests.size() + _checkedOutPool.size(), _parent->_options.maxConnections));
     };
 
-    // While all of our inflight connections are less than our target
-    while (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() < target()) {
+    // While all of our inflight connections are less than our target, and we aren't already
+    // setting up as many connections as we are allowed to at once
+    while (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() < target() &&
+           _processingPool.size() < _parent->_options.maxConnecting) {
         std::unique_ptr<ConnectionPool::ConnectionInterface> handle;
         try {
             // make a new connection and put it in processing
@@ -555,6 +594,9 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
                     // connection lapse
                 } else if (status.isOK()) {
                     addToReady(lk, std::move(conn));
+                    // Now that a connection attempt has finished, start any that were held
+                    // back by maxConnecting
+                    spawnConnections(lk);
                 } else if (status.code() == ErrorCodes::NetworkInterfaceExceededTimeLimit) {
                     // If we've exceeded the time limit, restart the connect, rather than
                     // failing all operations.  We do this because the various callers
@@ -637,16 +679,16 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
 
         // If we were already running and the timer is the same as it was
         // before, nothing to do
-        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().first)
+        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().expiration)
             return;
 
         _state = State::kRunning;
 
         _requestTimer->cancelTimeout();
 
-        _requestTimerExpiration = _requests.top().first;
+        _requestTimerExpiration = _requests.top().expiration;
 
-        auto timeout = _requests.top().first - _parent->_factory->now();
+        auto timeout = _requests.top().expiration - _parent->_factory->now();
 
         // We set a timer for the most recent request, then invoke each timed
         // out request we couldn't service
@@ -658,8 +700,8 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
             while (_requests.size()) {
                 auto& x = _requests.top();
 
-                if (x.first <= now) {
-                    auto cb = std::move(x.second);
+                if (x.expiration <= now) {
+                    auto cb = std::move(x.cb);
                     _requests.pop();
 
                     lk.unlock();
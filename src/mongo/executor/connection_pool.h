@@ -71,6 +71,7 @@ public:
     static constexpr Milliseconds kDefaultHostTimeout = Milliseconds(300000);  // 5mins
     static const size_t kDefaultMaxConns;
     static const size_t kDefaultMinConns;
+    static const size_t kDefaultMaxConnecting;
     static constexpr Milliseconds kDefaultRefreshRequirement = Milliseconds(60000);  // 1min
     static constexpr Milliseconds kDefaultRefreshTimeout = Milliseconds(20000);      // 20secs
 
@@ -81,7 +82,8 @@ public:
 
         /**
          * The minimum number of connections to keep alive while the pool is in
-         * operation
+         * operation. A pool for a newly contacted host, or for one whose connections were
+         * just dropped, does not hand out connections until this many are established.
          */
         size_t minConnections = kDefaultMinConns;
 
@@ -92,6 +94,14 @@ public:
          */
         size_t maxConnections = kDefaultMaxConns;
 
+        /**
+         * The maximum number of connections to a host which may be in setup or refresh at the
+         * same time. Requests beyond what can be served by ready connections queue up until a
+         * connection attempt finishes, which keeps a recovering host from being hit by a
+         * storm of simultaneous connects and authentications.
+         */
+        size_t maxConnecting = kDefaultMaxConnecting;
+
         /**
          * Amount of time to wait before timing out a refresh attempt
          */
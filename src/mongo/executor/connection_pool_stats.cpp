@@ -30,12 +30,57 @@
 
 #include "mongo/executor/connection_pool_stats.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/util/map_util.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 namespace executor {
 
+const std::array<Milliseconds, ConnectionWaitTimeHistogram::kNumBuckets - 1>
+    ConnectionWaitTimeHistogram::kBucketUpperBounds{Milliseconds(1),
+                                                    Milliseconds(5),
+                                                    Milliseconds(10),
+                                                    Milliseconds(50),
+                                                    Milliseconds(100),
+                                                    Milliseconds(500),
+                                                    Milliseconds(1000),
+                                                    Milliseconds(5000)};
+
+void ConnectionWaitTimeHistogram::increment(Milliseconds waitTime) {
+    auto bucket = std::upper_bound(kBucketUpperBounds.begin(), kBucketUpperBounds.end(), waitTime);
+    ++buckets[bucket - kBucketUpperBounds.begin()];
+    ++totalCount;
+}
+
+ConnectionWaitTimeHistogram& ConnectionWaitTimeHistogram::operator+=(
+    const ConnectionWaitTimeHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    totalCount += other.totalCount;
+    return *this;
+}
+
+void ConnectionWaitTimeHistogram::appendToBSON(BSONObjBuilder* builder) const {
+    BSONObjBuilder histogram(builder->subobjStart("acquisitionWaitTimes"));
+    Milliseconds lowerBound(0);
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        str::stream key;
+        key << "[" << durationCount<Milliseconds>(lowerBound) << ", ";
+        if (i < kBucketUpperBounds.size()) {
+            key << durationCount<Milliseconds>(kBucketUpperBounds[i]) << ")ms";
+            lowerBound = kBucketUpperBounds[i];
+        } else {
+            key << "inf)ms";
+        }
+        histogram.appendNumber(std::string(key), buckets[i]);
+    }
+    histogram.appendNumber("totalCount", totalCount);
+}
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -49,6 +94,7 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    acquisitionWaitTimes += other.acquisitionWaitTimes;
 
     return *this;
 }
@@ -83,6 +129,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             poolInfo.appendNumber("poolAvailable", poolStats.available);
             poolInfo.appendNumber("poolCreated", poolStats.created);
             poolInfo.appendNumber("poolRefreshing", poolStats.refreshing);
+            poolStats.acquisitionWaitTimes.appendToBSON(&poolInfo);
             for (auto&& host : statsByPoolHost[pool.first]) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
                 auto hostStats = host.second;
@@ -90,6 +137,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
                 hostInfo.appendNumber("available", hostStats.available);
                 hostInfo.appendNumber("created", hostStats.created);
                 hostInfo.appendNumber("refreshing", hostStats.refreshing);
+                hostStats.acquisitionWaitTimes.appendToBSON(&hostInfo);
             }
         }
     }
@@ -102,6 +150,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+            hostStats.acquisitionWaitTimes.appendToBSON(&hostInfo);
         }
     }
 }
@@ -28,12 +28,38 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
+
+class BSONObjBuilder;
+
 namespace executor {
 
+/**
+ * Histogram of the time requests spent waiting for a connection to be handed to them, including
+ * any time spent establishing new connections on their behalf.
+ */
+struct ConnectionWaitTimeHistogram {
+    static const size_t kNumBuckets = 9;
+
+    // Exclusive upper bounds of all but the last bucket, which has no upper bound.
+    static const std::array<Milliseconds, kNumBuckets - 1> kBucketUpperBounds;
+
+    void increment(Milliseconds waitTime);
+
+    ConnectionWaitTimeHistogram& operator+=(const ConnectionWaitTimeHistogram& other);
+
+    void appendToBSON(BSONObjBuilder* builder) const;
+
+    std::array<size_t, kNumBuckets> buckets{};
+    size_t totalCount = 0u;
+};
+
 /**
  * Holds connection information for a specific pool or remote host. These objects are maintained by
  * a parent ConnectionPoolStats object and should not need to be created directly.
@@ -49,6 +75,7 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    ConnectionWaitTimeHistogram acquisitionWaitTimes;
 };
 
 /**
@@ -30,6 +30,7 @@
 #include "mongo/executor/connection_pool_test_fixture.h"
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
@@ -925,6 +926,169 @@ TEST_F(ConnectionPoolTest, RefreshTimeoutsDontTimeoutRequests) {
     ASSERT(!conn2);
 }
 
+/**
+ * Verify that no more than maxConnecting connections are set up at once, and that requests
+ * queue up behind them
+ */
+TEST_F(ConnectionPoolTest, maxConnectingRespected) {
+    ConnectionPool::Options options;
+    options.maxConnecting = 2;
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    auto settingUp = [&] {
+        ConnectionPoolStats stats;
+        pool.appendConnectionStats(&stats);
+        return stats.totalRefreshing;
+    };
+
+    std::vector<ConnectionPool::ConnectionHandle> conns;
+    for (int i = 0; i < 5; ++i) {
+        pool.get(HostAndPort(),
+                 Milliseconds(5000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+                     conns.push_back(std::move(swConn.getValue()));
+                 });
+    }
+
+    // Only two setups are started for the five requests
+    ASSERT_EQ(2u, settingUp());
+    ASSERT_EQ(0u, conns.size());
+
+    // Each finished setup serves a request and lets the next setup start
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(1u, conns.size());
+    ASSERT_EQ(2u, settingUp());
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(3u, conns.size());
+    ASSERT_EQ(2u, settingUp());
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(5u, conns.size());
+    ASSERT_EQ(0u, settingUp());
+
+    for (auto& conn : conns) {
+        doneWith(conn);
+    }
+}
+
+/**
+ * Verify that a new pool waits for minConnections to be ready before handing out connections
+ */
+TEST_F(ConnectionPoolTest, warmUpToMinConnections) {
+    ConnectionPool::Options options;
+    options.minConnections = 3;
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    ConnectionPool::ConnectionHandle conn;
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn = std::move(swConn.getValue());
+             });
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(!conn);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(conn);
+    doneWith(conn);
+    conn.reset();
+
+    // Once warm, dropping a connection doesn't hold requests back
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn = std::move(swConn.getValue());
+             });
+    ASSERT(conn);
+    conn->indicateFailure(Status(ErrorCodes::HostUnreachable, "short read"));
+    conn.reset();
+
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn = std::move(swConn.getValue());
+             });
+    ASSERT(conn);
+    doneWith(conn);
+    conn.reset();
+
+    // But after dropConnections() the pool has to warm up again
+    pool.dropConnections(HostAndPort());
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn = std::move(swConn.getValue());
+             });
+
+    // The first setup to finish is the one started to replace the failed connection, which
+    // belongs to the dropped generation
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(!conn);
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(conn);
+    doneWith(conn);
+}
+
+/**
+ * Verify that the time requests wait for a connection is recorded in the stats
+ */
+TEST_F(ConnectionPoolTest, acquisitionWaitTimesRecorded) {
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool");
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    // Served without waiting
+    ConnectionImpl::pushSetup(Status::OK());
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 doneWith(swConn.getValue());
+             });
+
+    // Served after the only connection is returned 20ms later
+    ConnectionPool::ConnectionHandle conn1;
+    ConnectionPool::ConnectionHandle conn2;
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn1 = std::move(swConn.getValue());
+             });
+    ASSERT(conn1);
+    pool.get(HostAndPort(),
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conn2 = std::move(swConn.getValue());
+             });
+    PoolImpl::setNow(now + Milliseconds(20));
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT(conn2);
+    doneWith(conn1);
+    doneWith(conn2);
+
+    ConnectionPoolStats stats;
+    pool.appendConnectionStats(&stats);
+    const auto& waitTimes = stats.statsByPool["test pool"].acquisitionWaitTimes;
+    ASSERT_EQ(3u, waitTimes.totalCount);
+    ASSERT_EQ(2u, waitTimes.buckets[0]);  // [0, 1)ms
+    ASSERT_EQ(1u, waitTimes.buckets[3]);  // [10, 50)ms
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
@@ -112,13 +112,29 @@ void ConnectionImpl::clear() {
     _pushRefreshQueue.clear();
 }
 
+// Both queues are popped before the callback runs, since the pool may start another setup or
+// refresh from within it.
+void ConnectionImpl::answerSetup() {
+    auto connPtr = _setupQueue.front();
+    auto status = _pushSetupQueue.front();
+    _setupQueue.pop_front();
+    _pushSetupQueue.pop_front();
+    connPtr->_setupCallback(connPtr, status());
+}
+
+void ConnectionImpl::answerRefresh() {
+    auto connPtr = _refreshQueue.front();
+    auto status = _pushRefreshQueue.front();
+    _refreshQueue.pop_front();
+    _pushRefreshQueue.pop_front();
+    connPtr->_refreshCallback(connPtr, status());
+}
+
 void ConnectionImpl::pushSetup(PushSetupCallback status) {
     _pushSetupQueue.push_back(status);
 
     if (_setupQueue.size()) {
-        _setupQueue.front()->_setupCallback(_setupQueue.front(), _pushSetupQueue.front()());
-        _setupQueue.pop_front();
-        _pushSetupQueue.pop_front();
+        answerSetup();
     }
 }
 
@@ -130,9 +146,7 @@ void ConnectionImpl::pushRefresh(PushRefreshCallback status) {
     _pushRefreshQueue.push_back(status);
 
     if (_refreshQueue.size()) {
-        _refreshQueue.front()->_refreshCallback(_refreshQueue.front(), _pushRefreshQueue.front()());
-        _refreshQueue.pop_front();
-        _pushRefreshQueue.pop_front();
+        answerRefresh();
     }
 }
 
@@ -166,9 +180,7 @@ void ConnectionImpl::setup(Milliseconds timeout, SetupCallback cb) {
     _setupQueue.push_back(this);
 
     if (_pushSetupQueue.size()) {
-        _setupQueue.front()->_setupCallback(_setupQueue.front(), _pushSetupQueue.front()());
-        _setupQueue.pop_front();
-        _pushSetupQueue.pop_front();
+        answerSetup();
     }
 }
 
@@ -182,9 +194,7 @@ void ConnectionImpl::refresh(Milliseconds timeout, RefreshCallback cb) {
     _refreshQueue.push_back(this);
 
     if (_pushRefreshQueue.size()) {
-        _refreshQueue.front()->_refreshCallback(_refreshQueue.front(), _pushRefreshQueue.front()());
-        _refreshQueue.pop_front();
-        _pushRefreshQueue.pop_front();
+        answerRefresh();
     }
 }
 
@@ -117,6 +117,10 @@ private:
 
     size_t getGeneration() const override;
 
+    // Pair the oldest waiting setup or refresh with the oldest pushed answer
+    static void answerSetup();
+    static void answerRefresh();
+
     HostAndPort _hostAndPort;
     Date_t _lastUsed;
     Status _status = Status::OK();
@@ -47,6 +47,7 @@
 #include "mongo/stdx/chrono.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/threadlocal.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/sock.h"
 #include "mongo/util/net/ssl_manager.h"
@@ -57,7 +58,8 @@ namespace mongo {
 namespace executor {
 
 namespace {
-const std::size_t kIOServiceWorkers = 1;
+// The interface whose io_service the current thread runs, if any.
+MONGO_TRIVIALLY_CONSTRUCTIBLE_THREAD_LOCAL const NetworkInterfaceASIO* currentNetworkInterface;
 }  // namespace
 
 NetworkInterfaceASIO::Options::Options() = default;
@@ -76,6 +78,7 @@ NetworkInterfaceASIO::NetworkInterfaceASIO(Options options)
       _isExecutorRunnable(false),
       _strand(_io_service) {
     invariant(_timerFactory);
+    invariant(_options.numIOServiceWorkers > 0);
 }
 
 std::string NetworkInterfaceASIO::getDiagnosticString() {
@@ -148,10 +151,14 @@ std::string NetworkInterfaceASIO::getHostName() {
 }
 
 void NetworkInterfaceASIO::startup() {
-    _serviceRunners.resize(kIOServiceWorkers);
-    for (std::size_t i = 0; i < kIOServiceWorkers; ++i) {
+    // All of the workers run the same io_service. Everything done on behalf of a single operation
+    // or connection is serialized by that operation's strand, and pool bookkeeping by _strand, so
+    // independent operations are free to be handled on different threads.
+    _serviceRunners.resize(_options.numIOServiceWorkers);
+    for (std::size_t i = 0; i < _options.numIOServiceWorkers; ++i) {
         _serviceRunners[i] = stdx::thread([this, i]() {
             setThreadName(_options.instanceName + "-" + std::to_string(i));
+            currentNetworkInterface = this;
             try {
                 LOG(2) << "The NetworkInterfaceASIO worker thread is spinning up";
                 asio::io_service::work work(_io_service);
@@ -493,10 +500,9 @@ bool NetworkInterfaceASIO::inShutdown() const {
 }
 
 bool NetworkInterfaceASIO::onNetworkThread() {
-    auto id = stdx::this_thread::get_id();
-    return std::any_of(_serviceRunners.begin(),
-                       _serviceRunners.end(),
-                       [id](const stdx::thread& thread) { return id == thread.get_id(); });
+    // Checked through a thread local rather than _serviceRunners, which is still being filled in
+    // by startup() when the first workers begin running tasks.
+    return currentNetworkInterface == this;
 }
 
 void NetworkInterfaceASIO::_failWithInfo(const char* file,
@@ -103,6 +103,10 @@ public:
         Options();
 
         std::string instanceName = "NetworkInterfaceASIO";
+
+        // Number of threads running the io_service. All of them share one connection pool.
+        size_t numIOServiceWorkers = 1;
+
         ConnectionPool::Options connectionPoolOptions;
         std::unique_ptr<AsyncTimerFactoryInterface> timerFactory;
         std::unique_ptr<NetworkConnectionHook> networkConnectionHook;
@@ -397,7 +397,10 @@ void NetworkInterfaceASIO::_asyncRunCommand(AsyncOp* op, NetworkOpHandler handle
         // The operation could have been canceled after starting the command, but before
         // receiving the header
         _validateAndRun(op, ec, [this, op, recvMessageCallback, ec, bytes, cmd, handler] {
-            // validate response id
+            // validate response id. A connection carries a single outstanding request at a time:
+            // the server executes the requests on a connection one after another, so pipelining
+            // several operations onto one connection would only queue each behind the slower ones
+            // sent earlier, and any reply for another request means the stream is out of sync.
             uint32_t expectedId = cmd->toSend().header().getId();
             uint32_t actualId = cmd->header().constView().getResponseToMsgId();
             if (actualId != expectedId) {
@@ -54,9 +54,11 @@ std::unique_ptr<NetworkInterface> makeNetworkInterface(
     std::string instanceName,
     std::unique_ptr<NetworkConnectionHook> hook,
     std::unique_ptr<rpc::EgressMetadataHook> metadataHook,
-    ConnectionPool::Options connPoolOptions) {
+    ConnectionPool::Options connPoolOptions,
+    size_t numIOServiceWorkers) {
     NetworkInterfaceASIO::Options options{};
     options.instanceName = std::move(instanceName);
+    options.numIOServiceWorkers = numIOServiceWorkers;
     options.networkConnectionHook = std::move(hook);
     options.metadataHook = std::move(metadataHook);
     options.timerFactory = stdx::make_unique<AsyncTimerFactoryASIO>();
@@ -50,13 +50,15 @@ class NetworkConnectionHook;
 std::unique_ptr<NetworkInterface> makeNetworkInterface(std::string instanceName);
 
 /**
- * Returns a new NetworkInterface with the given connection hook set.
+ * Returns a new NetworkInterface with the given connection hook set, whose network I/O is handled
+ * by "numIOServiceWorkers" threads sharing a single connection pool.
  */
 std::unique_ptr<NetworkInterface> makeNetworkInterface(
     std::string instanceName,
     std::unique_ptr<NetworkConnectionHook> hook,
     std::unique_ptr<rpc::EgressMetadataHook> metadataHook,
-    ConnectionPool::Options options = ConnectionPool::Options());
+    ConnectionPool::Options options = ConnectionPool::Options(),
+    size_t numIOServiceWorkers = 1);
 
 }  // namespace executor
 }  // namespace mongo
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <sstream>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
@@ -55,11 +56,17 @@ public:
         : _encoder(encoder), _writer(writer) {}
 
     virtual Status append(const Event& event) {
+        // Format the event before taking the writer's lock, so that threads logging at the same
+        // time only serialize on the write itself.
+        std::ostringstream formatted;
+        _encoder->encode(event, formatted);
+        const std::string line = formatted.str();
+
         RotatableFileWriter::Use useWriter(_writer);
         Status status = useWriter.status();
         if (!status.isOK())
             return status;
-        _encoder->encode(event, useWriter.stream()).flush();
+        useWriter.stream().write(line.data(), line.size()).flush();
         return useWriter.status();
     }
 
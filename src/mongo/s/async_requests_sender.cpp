@@ -33,6 +33,7 @@
 #include "mongo/s/async_requests_sender.h"
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -49,6 +50,26 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// Number of times the targeter is asked for a host other than the one already running a request,
+// before giving up on hedging it. Host selection picks randomly among the eligible hosts which
+// are within the latency threshold of the nearest one, so a few attempts find another such host
+// if there is one.
+const int kMaxNumHedgeHostSelectionAttempts = 5;
+
+// If positive, requests which allow secondaries and do not get a response within this many
+// milliseconds are also sent to a second host of the same shard.
+MONGO_EXPORT_SERVER_PARAMETER(asyncRequestsSenderHedgeDelayMillis, int, 0);
+
+/**
+ * Returns true if 'cmdObj' is a command which opens a cursor on the host that runs it. Such
+ * commands are not hedged, since the cursor opened by the losing request would be leaked.
+ */
+bool establishesCursor(const BSONObj& cmdObj) {
+    const StringData cmdName = cmdObj.firstElementFieldName();
+    return cmdName == "find" || cmdName == "aggregate" || cmdName == "listCollections" ||
+        cmdName == "listIndexes" || cmdName == "parallelCollectionScan";
+}
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* txn,
@@ -72,6 +93,10 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* txn,
     uassertStatusOK(metadata.writeToMetadata(&metadataBuilder));
     _metadataObj = metadataBuilder.obj();
 
+    if (_readPreference.pref != ReadPreference::PrimaryOnly) {
+        _hedgeDelay = Milliseconds(std::max(asyncRequestsSenderHedgeDelayMillis.load(), 0));
+    }
+
     // Schedule the requests immediately.
     _scheduleRequestsIfNeeded(txn);
 }
@@ -116,10 +141,8 @@ void AsyncRequestsSender::kill() {
     _stopRetrying = true;
 
     // Cancel all outstanding requests so they return immediately.
-    for (auto& remote : _remotes) {
-        if (remote.cbHandle.isValid()) {
-            _executor->cancel(remote.cbHandle);
-        }
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        _cancelRemote_inlock(i);
     }
 }
 
@@ -130,13 +153,27 @@ bool AsyncRequestsSender::_done() {
 
 bool AsyncRequestsSender::_done_inlock() {
     for (const auto& remote : _remotes) {
-        if (!remote.swResponse) {
+        if (!remote.swResponse || remote.isOutstanding()) {
             return false;
         }
     }
     return true;
 }
 
+void AsyncRequestsSender::_cancelRemote_inlock(size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    if (remote.cbHandle.isValid()) {
+        _executor->cancel(remote.cbHandle);
+    }
+    if (remote.hedgeCbHandle.isValid()) {
+        _executor->cancel(remote.hedgeCbHandle);
+    }
+    if (remote.hedgeTimerHandle.isValid()) {
+        _executor->cancel(remote.hedgeTimerHandle);
+    }
+}
+
 /*
  * Note: If _scheduleRequestsIfNeeded() does retries, only the remotes with retriable errors will be
  * rescheduled because:
@@ -167,7 +204,7 @@ void AsyncRequestsSender::_scheduleRequestsIfNeeded(OperationContext* txn) {
 
         // If we have not yet received a response or error for this remote, and we do not have an
         // outstanding request for this remote, schedule remote work to send the command.
-        if (!remote.swResponse && !remote.cbHandle.isValid()) {
+        if (!remote.swResponse && !remote.isOutstanding()) {
             auto scheduleStatus = _scheduleRequest_inlock(txn, i);
             if (!scheduleStatus.isOK()) {
                 // Being unable to schedule a request to a remote is a non-retriable error.
@@ -200,40 +237,136 @@ Status AsyncRequestsSender::_scheduleRequest_inlock(OperationContext* txn, size_
 
     auto callbackStatus = _executor->scheduleRemoteCommand(
         request,
-        stdx::bind(
-            &AsyncRequestsSender::_handleResponse, this, stdx::placeholders::_1, txn, remoteIndex));
+        stdx::bind(&AsyncRequestsSender::_handleResponse,
+                   this,
+                   stdx::placeholders::_1,
+                   txn,
+                   remoteIndex,
+                   false));
     if (!callbackStatus.isOK()) {
         return callbackStatus.getStatus();
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.hedgeHostAndPort = boost::none;
+
+    if (_hedgeDelay > Milliseconds(0) && !establishesCursor(remote.cmdObj)) {
+        auto timerStatus = _executor->scheduleWorkAt(
+            _executor->now() + _hedgeDelay,
+            stdx::bind(&AsyncRequestsSender::_handleHedgeTimer,
+                       this,
+                       stdx::placeholders::_1,
+                       txn,
+                       remoteIndex));
+        // Failing to arm the timer only means that this request is not hedged.
+        if (timerStatus.isOK()) {
+            remote.hedgeTimerHandle = timerStatus.getValue();
+        }
+    }
+
     return Status::OK();
 }
 
+void AsyncRequestsSender::_handleHedgeTimer(const executor::TaskExecutor::CallbackArgs& cbData,
+                                            OperationContext* txn,
+                                            size_t remoteIndex) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto& remote = _remotes[remoteIndex];
+    remote.hedgeTimerHandle = executor::TaskExecutor::CallbackHandle();
+
+    ON_BLOCK_EXIT([&] {
+        // A retry for this remote may have been waiting for the timer callback to go away.
+        if (!remote.swResponse && !remote.isOutstanding()) {
+            _signalCurrentNotification_inlock();
+        } else {
+            _signalCurrentNotificationIfDone_inlock();
+        }
+    });
+
+    // Nothing to do if the timer was canceled or the request has already been answered.
+    if (!cbData.status.isOK() || _stopRetrying || remote.swResponse ||
+        !remote.cbHandle.isValid()) {
+        return;
+    }
+
+    auto shard = remote.getShard();
+    if (!shard) {
+        return;
+    }
+
+    boost::optional<HostAndPort> hedgeHost;
+    for (int attempt = 0; attempt < kMaxNumHedgeHostSelectionAttempts && !hedgeHost; ++attempt) {
+        auto swHost = shard->getTargeter()->findHostNoWait(_readPreference);
+        if (!swHost.isOK()) {
+            return;
+        }
+        if (swHost.getValue() != remote.getTargetHost()) {
+            hedgeHost = std::move(swHost.getValue());
+        }
+    }
+    if (!hedgeHost) {
+        return;
+    }
+
+    LOG(1) << "Command to remote " << remote.shardId << " at host " << remote.getTargetHost()
+           << " has not responded within " << _hedgeDelay << ", also sending it to " << *hedgeHost;
+
+    executor::RemoteCommandRequest request(*hedgeHost, _db, remote.cmdObj, _metadataObj, txn);
+
+    auto callbackStatus = _executor->scheduleRemoteCommand(
+        request,
+        stdx::bind(&AsyncRequestsSender::_handleResponse,
+                   this,
+                   stdx::placeholders::_1,
+                   txn,
+                   remoteIndex,
+                   true));
+    if (callbackStatus.isOK()) {
+        remote.hedgeCbHandle = callbackStatus.getValue();
+        remote.hedgeHostAndPort = std::move(hedgeHost);
+    }
+}
+
 void AsyncRequestsSender::_handleResponse(
     const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
     OperationContext* txn,
-    size_t remoteIndex) {
+    size_t remoteIndex,
+    bool isHedge) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     auto& remote = _remotes[remoteIndex];
-    invariant(!remote.swResponse);
 
-    // Clear the callback handle. This indicates that we are no longer waiting on a response from
-    // 'remote'.
-    remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+    // Clear the callback handle. This indicates that we are no longer waiting on a response for
+    // this request to 'remote'.
+    if (isHedge) {
+        remote.hedgeCbHandle = executor::TaskExecutor::CallbackHandle();
+    } else {
+        remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+    }
 
     // On early return from this point on, signal anyone waiting on the current notification if
     // _done() is true, since this might be the last outstanding request.
     ScopeGuard signaller =
         MakeGuard(&AsyncRequestsSender::_signalCurrentNotificationIfDone_inlock, this);
 
+    // The other of a hedged pair of requests has already provided the response.
+    if (remote.swResponse) {
+        return;
+    }
+
+    const HostAndPort host = isHedge ? *remote.hedgeHostAndPort : remote.getTargetHost();
+    const bool otherRequestOutstanding =
+        isHedge ? remote.cbHandle.isValid() : remote.hedgeCbHandle.isValid();
+
     // We check both the response status and command status for a retriable error.
     Status status = cbData.response.status;
     if (status.isOK()) {
         status = getStatusFromCommandResult(cbData.response.data);
         if (status.isOK()) {
             remote.swResponse = std::move(cbData.response);
+            remote.shardHostAndPort = host;
+            _cancelRemote_inlock(remoteIndex);
             return;
         }
     }
@@ -245,14 +378,25 @@ void AsyncRequestsSender::_handleResponse(
         remote.swResponse =
             Status(ErrorCodes::ShardNotFound,
                    str::stream() << "Could not find shard " << remote.shardId << " containing host "
-                                 << remote.getTargetHost().toString());
+                                 << host.toString());
+        _cancelRemote_inlock(remoteIndex);
         return;
     }
-    shard->updateReplSetMonitor(remote.getTargetHost(), status);
+    shard->updateReplSetMonitor(host, status);
+
+    // If the other of a hedged pair of requests is still outstanding, let its outcome decide.
+    if (otherRequestOutstanding) {
+        return;
+    }
+
+    // A hedge timer which has not fired yet has nothing left to hedge.
+    if (remote.hedgeTimerHandle.isValid()) {
+        _executor->cancel(remote.hedgeTimerHandle);
+    }
 
     if (shard->isRetriableError(status.code(), Shard::RetryPolicy::kIdempotent) && !_stopRetrying &&
         remote.retryCount < kMaxNumFailedHostRetryAttempts) {
-        LOG(1) << "Command to remote " << remote.shardId << " at host " << *remote.shardHostAndPort
+        LOG(1) << "Command to remote " << remote.shardId << " at host " << host
                << " failed with retriable error and will be retried" << causedBy(redact(status));
         ++remote.retryCount;
 
@@ -328,6 +472,10 @@ Status AsyncRequestsSender::RemoteData::resolveShardIdToHostAndPort(
     return Status::OK();
 }
 
+bool AsyncRequestsSender::RemoteData::isOutstanding() const {
+    return cbHandle.isValid() || hedgeCbHandle.isValid() || hedgeTimerHandle.isValid();
+}
+
 std::shared_ptr<Shard> AsyncRequestsSender::RemoteData::getShard() {
     // TODO: Pass down an OperationContext* to use here.
     return grid.shardRegistry()->getShardNoReload(shardId);
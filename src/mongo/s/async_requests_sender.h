@@ -62,6 +62,13 @@ namespace mongo {
  * outstanding requests but stop scheduling retries) or kill() (if you want to cancel outstanding
  * requests) the ARS from another thread.
  *
+ * If the read preference allows secondaries and the asyncRequestsSenderHedgeDelayMillis server
+ * parameter is positive, a request which has not been answered within that delay is hedged: the
+ * same command is also sent to another eligible host of the shard. Whichever of the two answers
+ * successfully first provides the shard's response and the other request is canceled.
+ * Commands which establish cursors, such as find and aggregate, are never hedged, because the
+ * cursor opened by the losing request could not be cleaned up.
+ *
  * Does not throw exceptions.
  */
 class AsyncRequestsSender {
@@ -141,8 +148,9 @@ public:
 
 private:
     /**
-     * Returns true if each remote has received a response or error. (If kill() has been called,
-     * the error is the error assigned by the TaskExecutor when a callback is canceled).
+     * Returns true if each remote has received a response or error and no callbacks are left
+     * outstanding. (If kill() has been called, the error is the error assigned by the TaskExecutor
+     * when a callback is canceled).
      */
     bool _done();
 
@@ -184,7 +192,21 @@ private:
      */
     void _handleResponse(const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData,
                          OperationContext* txn,
-                         size_t remoteIndex);
+                         size_t remoteIndex,
+                         bool isHedge);
+
+    /**
+     * The callback for the hedge timer of the remote at 'remoteIndex'. If the request to that
+     * remote is still outstanding, sends the command to a second host of the same shard.
+     */
+    void _handleHedgeTimer(const executor::TaskExecutor::CallbackArgs& cbData,
+                           OperationContext* txn,
+                           size_t remoteIndex);
+
+    /**
+     * Cancels the outstanding requests and hedge timer of the remote at 'remoteIndex', if any.
+     */
+    void _cancelRemote_inlock(size_t remoteIndex);
 
     /**
      * If the existing notification has not yet been signaled, signals it and marks it as signaled.
@@ -221,6 +243,11 @@ private:
          */
         std::shared_ptr<Shard> getShard();
 
+        /**
+         * Returns true if there is an outstanding request or hedge timer for this remote.
+         */
+        bool isOutstanding() const;
+
         // ShardId of the shard to which the command will be sent.
         const ShardId shardId;
 
@@ -240,6 +267,14 @@ private:
 
         // The callback handle to an outstanding request for this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
+
+        // The callback handle to the timer which hedges the outstanding request, if any.
+        executor::TaskExecutor::CallbackHandle hedgeTimerHandle;
+
+        // The callback handle to an outstanding hedged request for this remote, and the host to
+        // which it was sent.
+        executor::TaskExecutor::CallbackHandle hedgeCbHandle;
+        boost::optional<HostAndPort> hedgeHostAndPort;
     };
 
     /**
@@ -268,6 +303,9 @@ private:
     // their retries.
     bool _allowPartialResults = false;
 
+    // How long to wait for a response before hedging a request. Zero if requests are not hedged.
+    Milliseconds _hedgeDelay{0};
+
     // Must be acquired before accessing any data members.
     // Must also be held when calling any of the '_inlock()' helper functions.
     stdx::mutex _mutex;
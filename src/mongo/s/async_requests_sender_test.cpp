@@ -0,0 +1,233 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/async_requests_sender.h"
+
+#include "mongo/client/remote_command_targeter_factory_mock.h"
+#include "mongo/client/remote_command_targeter_mock.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/executor/network_interface_mock.h"
+#include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/sharding_test_fixture.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+using executor::NetworkInterfaceMock;
+using executor::RemoteCommandRequest;
+using executor::RemoteCommandResponse;
+
+const HostAndPort kTestConfigShardHost = HostAndPort("FakeConfigHost", 12345);
+const ShardId kTestShardId = ShardId("FakeShard1");
+const HostAndPort kTestShardHost = HostAndPort("FakeShard1Host", 12345);
+const HostAndPort kTestShardOtherHost = HostAndPort("FakeShard1OtherHost", 12345);
+const Milliseconds kHedgeDelay(100);
+
+class AsyncRequestsSenderTest : public ShardingTestFixture {
+public:
+    void setUp() override {
+        ShardingTestFixture::setUp();
+        setRemote(HostAndPort("ClientHost", 12345));
+
+        configTargeter()->setFindHostReturnValue(kTestConfigShardHost);
+
+        ShardType shardType;
+        shardType.setName(kTestShardId.toString());
+        shardType.setHost(kTestShardHost.toString());
+
+        auto targeter = stdx::make_unique<RemoteCommandTargeterMock>();
+        targeter->setConnectionStringReturnValue(ConnectionString(kTestShardHost));
+        targeter->setFindHostReturnValue(kTestShardHost);
+        targeterFactory()->addTargeterToReturn(ConnectionString(kTestShardHost),
+                                               std::move(targeter));
+
+        setupShards({shardType});
+
+        _hedgeDelayParam =
+            ServerParameterSet::getGlobal()->getMap().find("asyncRequestsSenderHedgeDelayMillis");
+        ASSERT(_hedgeDelayParam != ServerParameterSet::getGlobal()->getMap().end());
+        ASSERT_OK(_hedgeDelayParam->second->setFromString(
+            std::to_string(durationCount<Milliseconds>(kHedgeDelay))));
+    }
+
+    void tearDown() override {
+        invariantOK(_hedgeDelayParam->second->setFromString("0"));
+        ShardingTestFixture::tearDown();
+    }
+
+protected:
+    /**
+     * Sends 'cmdObj' to the test shard with 'readPref' through an AsyncRequestsSender on another
+     * thread, and returns a handle to the single response.
+     */
+    auto sendRequest(ReadPreferenceSetting readPref, BSONObj cmdObj = BSON("ping" << 1)) {
+        return launchAsync([this, readPref, cmdObj] {
+            std::vector<AsyncRequestsSender::Request> requests{{kTestShardId, cmdObj}};
+            AsyncRequestsSender ars(operationContext(), executor(), "admin", requests, readPref);
+            auto responses = ars.waitForResponses(operationContext());
+            ASSERT_EQ(1U, responses.size());
+            return responses.front();
+        });
+    }
+
+    /**
+     * Returns the targeter of the test shard, so that its host selection can be changed.
+     */
+    RemoteCommandTargeterMock* shardTargeter() {
+        auto shard = shardRegistry()->getShardNoReload(kTestShardId);
+        ASSERT(shard);
+        return RemoteCommandTargeterMock::get(shard->getTargeter()).get();
+    }
+
+    /**
+     * Takes the next request off the network without answering it.
+     */
+    NetworkInterfaceMock::NetworkOperationIterator takeNextRequest() {
+        NetworkInterfaceMock::InNetworkGuard guard(network());
+        return network()->getNextReadyRequest();
+    }
+
+    /**
+     * Takes the next request off the network and never answers it, returning its target.
+     */
+    HostAndPort blackHoleNextRequest() {
+        auto noi = takeNextRequest();
+        auto target = noi->getRequest().target;
+        NetworkInterfaceMock::InNetworkGuard guard(network());
+        network()->blackHole(noi);
+        return target;
+    }
+
+    /**
+     * Checks that no request besides the one at 'noi' was sent, then answers that one.
+     */
+    void respondAfterCheckingNoOtherRequest(NetworkInterfaceMock::NetworkOperationIterator noi) {
+        NetworkInterfaceMock::InNetworkGuard guard(network());
+        ASSERT_FALSE(network()->hasReadyRequests());
+        network()->scheduleSuccessfulResponse(
+            noi, RemoteCommandResponse(BSON("ok" << 1), BSONObj(), Milliseconds(0)));
+        network()->runReadyNetworkOperations();
+    }
+
+    /**
+     * Moves the mock clock past the hedge delay, firing any hedge timers.
+     */
+    void advancePastHedgeDelay() {
+        NetworkInterfaceMock::InNetworkGuard guard(network());
+        network()->runUntil(network()->now() + kHedgeDelay);
+    }
+
+    /**
+     * Delivers the responses, such as those for canceled requests, which are already scheduled.
+     */
+    void runReadyNetworkOperations() {
+        NetworkInterfaceMock::InNetworkGuard guard(network());
+        network()->runReadyNetworkOperations();
+    }
+
+private:
+    ServerParameter::Map::const_iterator _hedgeDelayParam;
+};
+
+TEST_F(AsyncRequestsSenderTest, HedgesSlowRequestToAnotherHost) {
+    auto future = sendRequest(ReadPreferenceSetting(ReadPreference::SecondaryPreferred));
+
+    ASSERT_EQ(kTestShardHost, blackHoleNextRequest());
+
+    shardTargeter()->setFindHostReturnValue(kTestShardOtherHost);
+    advancePastHedgeDelay();
+
+    onCommand([](const RemoteCommandRequest& request) {
+        ASSERT_EQ(kTestShardOtherHost, request.target);
+        return BSON("ok" << 1);
+    });
+
+    // The original request is canceled once the hedge has answered.
+    runReadyNetworkOperations();
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT(response.shardHostAndPort);
+    ASSERT_EQ(kTestShardOtherHost, *response.shardHostAndPort);
+}
+
+TEST_F(AsyncRequestsSenderTest, DoesNotHedgeWhenNoOtherHostIsEligible) {
+    auto future = sendRequest(ReadPreferenceSetting(ReadPreference::SecondaryPreferred));
+
+    auto noi = takeNextRequest();
+    ASSERT_EQ(kTestShardHost, noi->getRequest().target);
+
+    // The targeter keeps returning the host which is already running the request.
+    advancePastHedgeDelay();
+    respondAfterCheckingNoOtherRequest(noi);
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+}
+
+TEST_F(AsyncRequestsSenderTest, DoesNotHedgePrimaryOnlyRequests) {
+    auto future = sendRequest(ReadPreferenceSetting(ReadPreference::PrimaryOnly));
+
+    auto noi = takeNextRequest();
+    ASSERT_EQ(kTestShardHost, noi->getRequest().target);
+
+    shardTargeter()->setFindHostReturnValue(kTestShardOtherHost);
+    advancePastHedgeDelay();
+    respondAfterCheckingNoOtherRequest(noi);
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+}
+
+TEST_F(AsyncRequestsSenderTest, DoesNotHedgeCursorEstablishingCommands) {
+    auto future = sendRequest(ReadPreferenceSetting(ReadPreference::SecondaryPreferred),
+                              BSON("find"
+                                   << "coll"));
+
+    auto noi = takeNextRequest();
+    ASSERT_EQ(kTestShardHost, noi->getRequest().target);
+
+    shardTargeter()->setFindHostReturnValue(kTestShardOtherHost);
+    advancePastHedgeDelay();
+    respondAfterCheckingNoOtherRequest(noi);
+
+    auto response = future.timed_get(kFutureTimeout);
+    ASSERT_OK(response.swResponse.getStatus());
+    ASSERT_EQ(kTestShardHost, *response.shardHostAndPort);
+}
+
+}  // namespace
+}  // namespace mongo
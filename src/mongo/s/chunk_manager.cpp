@@ -42,6 +42,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/chunk_diff.h"
 #include "mongo/s/client/shard_registry.h"
@@ -63,6 +64,15 @@ namespace {
 // Used to generate sequence numbers to assign to each newly created ChunkManager
 AtomicUInt32 nextCMSequenceNumber(0);
 
+// The routing table compares shard keys in the order of the simple BSONObj comparator, which is the
+// order of KeyStrings built with an all-ascending Ordering.
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+std::string toRoutingKey(const BSONObj& key) {
+    const KeyString ks(KeyString::Version::V1, key, kAllAscending);
+    return std::string(ks.getBuffer(), ks.getSize());
+}
+
 /**
  * This is an adapter so we can use config diffs - mongos and mongod do them slightly differently.
  *
@@ -193,6 +203,7 @@ void ChunkManager::loadExistingRanges(OperationContext* txn, const ChunkManager*
                 _chunkMap = std::move(chunkMap);
                 _shardVersions = std::move(shardVersions);
                 _chunkRangeMap = _constructRanges(_chunkMap);
+                _chunkRoutingTable = _constructRoutingTable(_chunkMap);
 
                 log() << "ChunkManager load took " << t.millis() << " ms and found version "
                       << _version;
@@ -230,13 +241,12 @@ bool ChunkManager::_load(OperationContext* txn,
         // Load a copy of the old versions
         *shardVersions = oldManager->_shardVersions;
 
-        // Load a copy of the chunk map, replacing the chunk manager with our own
+        // Start from the old chunk map. The chunks themselves are shared with the old manager
+        // rather than copied, because the diff below only ever replaces the entries of chunks
+        // which changed with newly created ones. This makes copying the map the only cost which
+        // is linear in the total number of chunks.
         const ChunkMap& oldChunkMap = oldManager->getChunkMap();
-
-        for (const auto& oldChunkMapEntry : oldChunkMap) {
-            const auto& oldC = oldChunkMapEntry.second;
-            chunkMap.emplace(oldC->getMax(), std::make_shared<Chunk>(*oldC));
-        }
+        chunkMap = oldChunkMap;
 
         LOG(2) << "loading chunk manager for collection " << _nss
                << " using old chunk manager w/ version " << _version.toString() << " and "
@@ -334,10 +344,17 @@ std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardK
         }
     }
 
-    const auto it = _chunkMap.upper_bound(shardKey);
+    const std::string routingKey = toRoutingKey(shardKey);
+    const auto it =
+        std::upper_bound(_chunkRoutingTable.begin(),
+                         _chunkRoutingTable.end(),
+                         routingKey,
+                         [](const std::string& key, const ChunkRoutingTable::value_type& entry) {
+                             return key < entry.first;
+                         });
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey,
-            it != _chunkMap.end() && it->second->containsKey(shardKey));
+            it != _chunkRoutingTable.end() && it->second->containsKey(shardKey));
 
     return it->second;
 }
@@ -623,6 +640,19 @@ ChunkManager::ChunkRangeMap ChunkManager::_constructRanges(const ChunkMap& chunk
     return chunkRangeMap;
 }
 
+ChunkManager::ChunkRoutingTable ChunkManager::_constructRoutingTable(const ChunkMap& chunkMap) {
+    ChunkRoutingTable routingTable;
+    routingTable.reserve(chunkMap.size());
+
+    for (const auto& entry : chunkMap) {
+        routingTable.emplace_back(toRoutingKey(entry.first), entry.second);
+        dassert(routingTable.size() == 1 ||
+                routingTable[routingTable.size() - 2].first < routingTable.back().first);
+    }
+
+    return routingTable;
+}
+
 repl::OpTime ChunkManager::getConfigOpTime() const {
     return _configOpTime;
 }
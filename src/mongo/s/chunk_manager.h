@@ -31,6 +31,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/namespace_string.h"
@@ -213,6 +214,9 @@ private:
 
     using ChunkRangeMap = BSONObjIndexedMap<ShardAndChunkRange>;
 
+    // Pairs of the KeyString encoding of a chunk's max and the chunk, ordered by the former.
+    using ChunkRoutingTable = std::vector<std::pair<std::string, std::shared_ptr<Chunk>>>;
+
     /**
      * If load was successful, returns true and it is guaranteed that the _chunkMap and
      * _chunkRangeMap are consistent with each other. If false is returned, it is not safe to use
@@ -229,6 +233,12 @@ private:
      */
     static ChunkRangeMap _constructRanges(const ChunkMap& chunkMap);
 
+    /**
+     * Flattens the chunk map into a table, which can be binary searched with memcmp instead of
+     * BSONObj comparisons.
+     */
+    static ChunkRoutingTable _constructRoutingTable(const ChunkMap& chunkMap);
+
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
     // ChunkManagers.
     const unsigned long long _sequenceNumber;
@@ -254,6 +264,10 @@ private:
     // constructed map must cover the complete space from [MinKey, MaxKey).
     ChunkRangeMap _chunkRangeMap;
 
+    // Copy of the chunk map used by findIntersectingChunk to target single shard keys, which is
+    // the hot path for routing batched writes.
+    ChunkRoutingTable _chunkRoutingTable;
+
     // Max known version per shard
     ShardVersionMap _shardVersions;
 
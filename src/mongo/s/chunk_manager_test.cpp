@@ -166,6 +166,83 @@ TEST_F(ChunkManagerLoadTest, IncrementalLoadAfterSplit) {
     future.timed_get(kFutureTimeout);
 }
 
+TEST_F(ChunkManagerLoadTest, IncrementalLoadSharesUnchangedChunks) {
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto initialManager(makeChunkManager(
+        shardKeyPattern, nullptr, true, {BSON("_id" << 0), BSON("_id" << 10)}));
+
+    ChunkVersion version = initialManager->getVersion();
+
+    ChunkManager manager(kNss, version.epoch(), shardKeyPattern, nullptr, true);
+
+    auto future =
+        launchAsync([&] { manager.loadExistingRanges(operationContext(), initialManager.get()); });
+
+    // Split the last chunk, which is the one with the highest version
+    expectFindOnConfigSendBSONObjVector([&]() {
+        version.incMinor();
+
+        ChunkType chunk1;
+        chunk1.setNS(kNss.ns());
+        chunk1.setMin(BSON("_id" << 10));
+        chunk1.setMax(BSON("_id" << 20));
+        chunk1.setShard({"2"});
+        chunk1.setVersion(version);
+
+        version.incMinor();
+
+        ChunkType chunk2;
+        chunk2.setNS(kNss.ns());
+        chunk2.setMin(BSON("_id" << 20));
+        chunk2.setMax(shardKeyPattern.getKeyPattern().globalMax());
+        chunk2.setShard({"2"});
+        chunk2.setVersion(version);
+
+        return std::vector<BSONObj>{chunk1.toConfigBSON(), chunk2.toConfigBSON()};
+    }());
+
+    future.timed_get(kFutureTimeout);
+
+    ASSERT_EQ(4, manager.numChunks());
+    ASSERT_EQ(version, manager.getVersion());
+
+    // The chunks which were not part of the diff are shared with the old manager
+    const ChunkMap& oldChunkMap = initialManager->getChunkMap();
+    const ChunkMap& newChunkMap = manager.getChunkMap();
+    for (const auto& max : {BSON("_id" << 0), BSON("_id" << 10)}) {
+        ASSERT(newChunkMap.find(max) != newChunkMap.end());
+        ASSERT_EQ(oldChunkMap.find(max)->second.get(), newChunkMap.find(max)->second.get());
+    }
+}
+
+TEST_F(ChunkManagerLoadTest, FindIntersectingChunk) {
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+
+    auto manager(makeChunkManager(
+        shardKeyPattern, nullptr, false, {BSON("a" << 0), BSON("a" << 10), BSON("a" << "x")}));
+
+    auto shardIdFor = [&](const BSONObj& shardKey) {
+        return manager->findIntersectingChunkWithSimpleCollation(shardKey)->getShardId();
+    };
+
+    ASSERT_EQ(ShardId("0"), shardIdFor(BSON("a" << MINKEY)));
+    ASSERT_EQ(ShardId("0"), shardIdFor(BSON("a" << -1.5)));
+    ASSERT_EQ(ShardId("1"), shardIdFor(BSON("a" << 0)));
+    ASSERT_EQ(ShardId("1"), shardIdFor(BSON("a" << 0.0)));
+    ASSERT_EQ(ShardId("1"), shardIdFor(BSON("a" << 9.99)));
+    ASSERT_EQ(ShardId("2"), shardIdFor(BSON("a" << 10LL)));
+    ASSERT_EQ(ShardId("2"), shardIdFor(BSON("a" << 1e100)));
+    ASSERT_EQ(ShardId("2"), shardIdFor(BSON("a"
+                                            << "w")));
+    ASSERT_EQ(ShardId("3"), shardIdFor(BSON("a"
+                                            << "x")));
+    ASSERT_EQ(ShardId("3"), shardIdFor(BSON("a" << BSON("b" << 1))));
+
+    ASSERT_THROWS_CODE(
+        shardIdFor(BSON("a" << MAXKEY)), UserException, ErrorCodes::ShardKeyNotFound);
+}
+
 /**
  * Fixture to be used as a shortcut for tests which exercise the getShardIdsForQuery routing logic
  */
@@ -147,9 +147,12 @@ Status ClusterAggregate::runAggregate(OperationContext* txn,
     const bool needSplit = !singleShard || needPrimaryShardMerger;
 
     // Split the pipeline into pieces for mongod(s) and this mongos. If needSplit is true,
-    // 'pipeline' will become the merger side.
-    boost::intrusive_ptr<Pipeline> shardPipeline(needSplit ? pipeline.getValue()->splitForSharded()
-                                                           : pipeline.getValue());
+    // 'pipeline' will become the merger side. Knowing the shard key lets stages which cannot see
+    // documents from other shards, such as a $group on the shard key, run entirely on the shards.
+    boost::intrusive_ptr<Pipeline> shardPipeline(
+        needSplit
+            ? pipeline.getValue()->splitForSharded(chunkMgr->getShardKeyPattern().toBSON())
+            : pipeline.getValue());
 
     // Create the command for the shards. The 'fromRouter' field means produce output to be
     // merged.
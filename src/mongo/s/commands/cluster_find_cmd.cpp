@@ -35,6 +35,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/find_common.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -61,6 +62,10 @@ public:
     ClusterFindCmd() : Command("find") {}
 
 
+    std::size_t reserveBytesForReply() const override {
+        return FindCommon::kInitReplyBufferSize;
+    }
+
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
         return false;
     }
@@ -1203,28 +1203,27 @@ public:
             collator = std::move(statusWithCollator.getValue());
         }
 
-        set<ShardId> shardIds;
-        cm->getShardIdsForQuery(txn, query, queryCollation.getValue(), &shardIds);
-
         BSONObjComparator bsonCmp(BSONObj(),
                                   BSONObjComparator::FieldNamesMode::kConsider,
                                   !queryCollation.getValue().isEmpty() ? collator.get()
                                                                        : cm->getDefaultCollator());
         BSONObjSet all = bsonCmp.makeBSONObjSet();
 
-        for (const ShardId& shardId : shardIds) {
-            const auto shardStatus = Grid::get(txn)->shardRegistry()->getShard(txn, shardId);
-            if (!shardStatus.isOK()) {
-                invariant(shardStatus.getStatus() == ErrorCodes::ShardNotFound);
-                continue;
-            }
-
-            ShardConnection conn(shardStatus.getValue()->getConnString(), nss.ns());
-            BSONObj res;
-            bool ok = conn->runCommand(conf->name(), cmdObj, res, options);
-            conn.done();
+        // Send the command to all targeted shards at once rather than waiting on each shard in
+        // turn.
+        vector<Strategy::CommandResult> shardResults;
+        Strategy::commandOp(txn,
+                            conf->name(),
+                            cmdObj,
+                            options,
+                            nss.ns(),
+                            query,
+                            queryCollation.getValue(),
+                            &shardResults);
 
-            if (!ok) {
+        for (const auto& shardResult : shardResults) {
+            const BSONObj& res = shardResult.result;
+            if (!res["ok"].trueValue()) {
                 result.appendElements(res);
                 return false;
             }
@@ -1242,6 +1241,7 @@ public:
         int n = 0;
         for (auto&& obj : all) {
             b.appendAs(obj.firstElement(), b.numStr(n++));
+            uassert(40414, "distinct too big, 16mb cap", b.len() < BSONObjMaxUserSize - 4096);
         }
 
         result.appendArray("values", b.obj());
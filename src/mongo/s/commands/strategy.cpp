@@ -104,6 +104,14 @@ void runAgainstRegistered(OperationContext* txn,
         return;
     }
 
+    // Size the reply buffer up front for commands which are known to produce large replies, as
+    // mongod does, rather than growing it by repeated reallocation while the reply is built.
+    if (const auto bytesToReserve = c->reserveBytesForReply()) {
+        BufBuilder& replyBuf = anObjBuilder.bb();
+        replyBuf.reserveBytes(bytesToReserve);
+        replyBuf.claimReservedBytes(bytesToReserve);
+    }
+
     execCommandClient(txn, c, queryOptions, ns, jsobj, anObjBuilder);
 }
 
@@ -122,11 +130,13 @@ void execCommandHandler(OperationContext* txn,
         rpc::downconvertRequestMetadata(request.getCommandArgs(), request.getMetadata()));
 
     std::string db = request.getDatabase().rawData();
-    BSONObjBuilder result;
+    // Build the reply directly into the outgoing message rather than copying it in afterwards.
+    BSONObjBuilder result(replyBuilder->getInPlaceReplyBuilder(command->reserveBytesForReply()));
 
     execCommandClient(txn, command, queryFlags, request.getDatabase().rawData(), cmdObj, result);
 
-    replyBuilder->setCommandReply(result.done()).setMetadata(rpc::makeEmptyMetadata());
+    result.doneFast();
+    replyBuilder->setMetadata(rpc::makeEmptyMetadata());
 }
 
 MONGO_INITIALIZER(InitializeCommandExecCommandHandler)(InitializerContext* const) {
@@ -134,6 +134,33 @@ std::shared_ptr<ChunkManager> DBConfig::getChunkManager(OperationContext* txn,
         }
     }
 
+    std::unique_ptr<ChunkManager> tempChunkManager;
+
+    // Only one thread at a time may refresh a collection from the config server. This also
+    // collapses the burst of refreshes which follows a migration, when every operation that was in
+    // flight against the collection comes back stale at about the same time.
+    const auto refreshMutex = [&] {
+        stdx::lock_guard<stdx::mutex> lk(_lock);
+        auto& mutex = _chunkRefreshMutexes[ns];
+        if (!mutex) {
+            mutex = std::make_shared<stdx::mutex>();
+        }
+        return mutex;
+    }();
+    stdx::lock_guard<stdx::mutex> lll(*refreshMutex);
+
+    if (!forceReload) {
+        // If another thread installed a newer chunk manager while this one was waiting for the
+        // lock, use it instead of going back to the config server. Should it still be too old for
+        // the caller, the caller's next stale version error will refresh from it.
+        stdx::lock_guard<stdx::mutex> lk(_lock);
+
+        auto it = _collections.find(ns);
+        if (it != _collections.end() && it->second.cm != oldManager) {
+            return it->second.cm;
+        }
+    }
+
     // TODO: We need to keep this first one-chunk check in until we have a more efficient way of
     // creating/reusing a chunk manager, as doing so requires copying the full set of chunks
     // currently
@@ -168,57 +195,51 @@ std::shared_ptr<ChunkManager> DBConfig::getChunkManager(OperationContext* txn,
                   << " chunk manager; collection '" << ns << "' initially detected as sharded";
     }
 
-    std::unique_ptr<ChunkManager> tempChunkManager;
-
-    {
-        stdx::lock_guard<stdx::mutex> lll(_hitConfigServerLock);
-
-        if (!newestChunk.empty() && !forceReload) {
-            // If we have a target we're going for see if we've hit already
-            stdx::lock_guard<stdx::mutex> lk(_lock);
+    if (!newestChunk.empty() && !forceReload) {
+        // If we have a target we're going for see if we've hit already
+        stdx::lock_guard<stdx::mutex> lk(_lock);
 
-            auto it = _collections.find(ns);
+        auto it = _collections.find(ns);
 
-            if (it != _collections.end()) {
-                const auto& ci = it->second;
+        if (it != _collections.end()) {
+            const auto& ci = it->second;
 
-                ChunkVersion currentVersion = newestChunk[0].getVersion();
+            ChunkVersion currentVersion = newestChunk[0].getVersion();
 
-                // Only reload if the version we found is newer than our own in the same epoch
-                if (currentVersion <= ci.cm->getVersion() &&
-                    ci.cm->getVersion().hasEqualEpoch(currentVersion)) {
-                    return ci.cm;
-                }
+            // Only reload if the version we found is newer than our own in the same epoch
+            if (currentVersion <= ci.cm->getVersion() &&
+                ci.cm->getVersion().hasEqualEpoch(currentVersion)) {
+                return ci.cm;
             }
         }
+    }
 
-        // Reload the chunk manager outside of the DBConfig's mutex so as to not block operations
-        // for different collections on the same database
-        tempChunkManager.reset(new ChunkManager(
-            NamespaceString(oldManager->getns()),
-            oldManager->getVersion().epoch(),
-            oldManager->getShardKeyPattern(),
-            oldManager->getDefaultCollator() ? oldManager->getDefaultCollator()->clone() : nullptr,
-            oldManager->isUnique()));
-        tempChunkManager->loadExistingRanges(txn, oldManager.get());
-
-        if (!tempChunkManager->numChunks()) {
-            // Maybe we're not sharded any more, so do a full reload
-            const auto currentReloadIteration = _reloadCount.load();
-
-            const bool successful = [&]() {
-                stdx::lock_guard<stdx::mutex> lk(_lock);
-                return _loadIfNeeded(txn, currentReloadIteration);
-            }();
-
-            // If we aren't successful loading the database entry, we don't want to keep the stale
-            // object around which has invalid data.
-            if (!successful) {
-                Grid::get(txn)->catalogCache()->invalidate(_name);
-            }
+    // Reload the chunk manager outside of the DBConfig's mutex so as to not block operations
+    // for different collections on the same database
+    tempChunkManager.reset(new ChunkManager(
+        NamespaceString(oldManager->getns()),
+        oldManager->getVersion().epoch(),
+        oldManager->getShardKeyPattern(),
+        oldManager->getDefaultCollator() ? oldManager->getDefaultCollator()->clone() : nullptr,
+        oldManager->isUnique()));
+    tempChunkManager->loadExistingRanges(txn, oldManager.get());
+
+    if (!tempChunkManager->numChunks()) {
+        // Maybe we're not sharded any more, so do a full reload
+        const auto currentReloadIteration = _reloadCount.load();
+
+        const bool successful = [&]() {
+            stdx::lock_guard<stdx::mutex> lk(_lock);
+            return _loadIfNeeded(txn, currentReloadIteration);
+        }();
 
-            return getChunkManager(txn, ns);
+        // If we aren't successful loading the database entry, we don't want to keep the stale
+        // object around which has invalid data.
+        if (!successful) {
+            Grid::get(txn)->catalogCache()->invalidate(_name);
         }
+
+        return getChunkManager(txn, ns);
     }
 
     stdx::lock_guard<stdx::mutex> lk(_lock);
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <string>
 
 #include "mongo/db/repl/optime.h"
@@ -114,7 +116,7 @@ protected:
     // (S) Self synchronizing, no explicit locking needed.
     //
     // Mutex lock order:
-    // _hitConfigServerLock -> _lock
+    // one of _chunkRefreshMutexes -> _lock
     //
 
     // Name of the database which this entry caches
@@ -133,9 +135,11 @@ protected:
     // OpTime of config server when the database definition was loaded.
     repl::OpTime _configOpTime;  // (L)
 
-    // Ensures that only one thread at a time loads collection configuration data from
-    // the config server
-    stdx::mutex _hitConfigServerLock;
+    // Per-namespace mutexes which ensure that only one thread at a time loads the chunks of a
+    // given collection from the config server, while refreshes of different collections proceed
+    // in parallel. Entries are never removed, so there is at most one per collection which was
+    // ever sharded in this database.
+    std::map<std::string, std::shared_ptr<stdx::mutex>> _chunkRefreshMutexes;  // (L)
 
     // Increments every time this performs a full reload. Since a full reload can take a very
     // long time for very large clusters, this can be used to minimize duplicate work when multiple
@@ -36,6 +36,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/rpc/metadata/server_selection_metadata.h"
@@ -51,6 +52,15 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// Percentage of a remote's last batch which must have been consumed before prefetchNextBatches()
+// asks that remote for its next batch. Zero or less (the default) disables prefetching.
+MONGO_EXPORT_SERVER_PARAMETER(asyncResultsMergerPrefetchThresholdPercent, int, 0);
+
+// Prefetching stops while the results buffered by a merger, plus those it expects from its
+// outstanding prefetches, would exceed this many bytes. Every open cursor can buffer this much on
+// mongos, so it is kept well below the size of a full batch.
+MONGO_EXPORT_SERVER_PARAMETER(asyncResultsMergerPrefetchMaxBufferedBytes, int, 1024 * 1024);
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(executor::TaskExecutor* executor,
@@ -177,6 +187,61 @@ bool AsyncResultsMerger::readyUnsorted_inlock() {
     return allExhausted;
 }
 
+void AsyncResultsMerger::prefetchNextBatches() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    const int thresholdPercent = std::min(asyncResultsMergerPrefetchThresholdPercent.load(), 100);
+    if (_lifecycleState != kAlive || thresholdPercent <= 0 || _params->isTailable) {
+        return;
+    }
+
+    // Bytes already buffered, plus an estimate of those on their way for outstanding requests.
+    long long expectedBytes = 0;
+    for (const auto& remote : _remotes) {
+        expectedBytes += remote.bufferedBytes;
+        if (remote.cbHandle.isValid()) {
+            expectedBytes += remote.lastBatchBytes;
+        }
+    }
+
+    const long long maxBufferedBytes = asyncResultsMergerPrefetchMaxBufferedBytes.load();
+
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        auto& remote = _remotes[i];
+
+        // Remotes with nothing buffered get their next batch from nextEvent().
+        if (!remote.status.isOK() || !remote.cursorId || remote.exhausted() ||
+            remote.cbHandle.isValid() || !remote.hasNext()) {
+            continue;
+        }
+
+        const long long numBuffered = static_cast<long long>(remote.docBuffer.size());
+        if (numBuffered * 100 > remote.lastBatchSize * (100 - thresholdPercent)) {
+            continue;
+        }
+
+        // If there is a limit and this remote has buffered as many results as could still be
+        // returned, it has nothing more to contribute.
+        if (_params->limit) {
+            const long long maxResults = *_params->limit + _params->skip.value_or(0);
+            if (maxResults - _numReturned - numBuffered <= 0) {
+                continue;
+            }
+        }
+
+        if (expectedBytes + remote.lastBatchBytes > maxBufferedBytes) {
+            continue;
+        }
+
+        // The response can arrive after the operation which triggered the prefetch has finished,
+        // so neither the request nor its callback may refer to that operation's context. A
+        // failure is picked up by the next call to nextEvent(), which carries its own.
+        if (askForNextBatch_inlock(nullptr, i).isOK()) {
+            expectedBytes += remote.lastBatchBytes;
+        }
+    }
+}
+
 StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     dassert(ready_inlock());
@@ -194,7 +259,11 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     }
 
     const bool hasSort = !_params->sort.isEmpty();
-    return hasSort ? nextReadySorted() : nextReadyUnsorted();
+    auto result = hasSort ? nextReadySorted() : nextReadyUnsorted();
+    if (!result.isEOF()) {
+        ++_numReturned;
+    }
+    return result;
 }
 
 ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
@@ -213,6 +282,7 @@ ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].bufferedBytes -= front.getResult()->objsize();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -232,6 +302,7 @@ ClusterQueryResult AsyncResultsMerger::nextReadyUnsorted() {
         if (_remotes[_gettingFromRemote].hasNext()) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
             _remotes[_gettingFromRemote].docBuffer.pop();
+            _remotes[_gettingFromRemote].bufferedBytes -= front.getResult()->objsize();
 
             if (_params->isTailable && !_remotes[_gettingFromRemote].hasNext()) {
                 // The cursor is tailable and we're about to return the last buffered result. This
@@ -271,6 +342,18 @@ Status AsyncResultsMerger::askForNextBatch_inlock(OperationContext* txn, size_t
             adjustedBatchSize = *_params->batchSize - remote.fetchedCount;
         }
 
+        // If there is a limit, this remote cannot contribute more than the results still left to
+        // return, less those already buffered from it. For a sorted top-k query across many
+        // shards, this keeps each shard from sending results that the merge would discard.
+        if (_params->limit && !_params->isTailable) {
+            const long long maxResults = *_params->limit + _params->skip.value_or(0);
+            const long long stillNeeded = std::max(
+                1LL, maxResults - _numReturned - static_cast<long long>(remote.docBuffer.size()));
+            if (!adjustedBatchSize || *adjustedBatchSize > stillNeeded) {
+                adjustedBatchSize = stillNeeded;
+            }
+        }
+
         cmdObj = GetMoreRequest(_params->nsString,
                                 *remote.cursorId,
                                 adjustedBatchSize,
@@ -525,6 +608,7 @@ void AsyncResultsMerger::handleBatchResponse(
             // Clear the results buffer and cursor id.
             std::queue<ClusterQueryResult> emptyBuffer;
             std::swap(remote.docBuffer, emptyBuffer);
+            remote.bufferedBytes = 0;
             remote.cursorId = 0;
         }
 
@@ -536,6 +620,13 @@ void AsyncResultsMerger::handleBatchResponse(
     remote.cursorId = cursorResponse.getCursorId();
     remote.initialCmdObj = boost::none;
 
+    // A prefetched batch can arrive while earlier results from this remote are still buffered, in
+    // which case the remote is already on the merge queue.
+    const bool bufferWasEmpty = !remote.hasNext();
+
+    remote.lastBatchSize = static_cast<long long>(cursorResponse.getBatch().size());
+    remote.lastBatchBytes = 0;
+
     for (const auto& obj : cursorResponse.getBatch()) {
         // If there's a sort, we're expecting the remote node to give us back a sort key.
         if (!_params->sort.isEmpty() &&
@@ -550,12 +641,14 @@ void AsyncResultsMerger::handleBatchResponse(
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
+        remote.lastBatchBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the
     // merge queue.
-    if (!_params->sort.isEmpty() && !cursorResponse.getBatch().empty()) {
+    if (!_params->sort.isEmpty() && bufferWasEmpty && !cursorResponse.getBatch().empty()) {
         _mergeQueue.push(remoteIndex);
     }
 
@@ -65,6 +65,10 @@ class CursorResponse;
  * This requires waiting until we have a response from every remote before returning results.
  * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
  *
+ * While buffered results are being consumed, prefetchNextBatches() can be used to request the next
+ * batch from a remote before its buffer runs dry, so that the round trip to the remote overlaps
+ * with the processing of the results which are already here.
+ *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
  * Does not throw exceptions.
@@ -114,6 +118,20 @@ public:
      */
     bool ready();
 
+    /**
+     * Schedules a getMore for each remote which has consumed at least
+     * asyncResultsMergerPrefetchThresholdPercent of its last batch and has no request outstanding,
+     * as long as the results buffered and expected from all remotes stay within
+     * asyncResultsMergerPrefetchMaxBufferedBytes. Does nothing for tailable cursors.
+     *
+     * Failing to schedule a prefetch is not an error: the getMore is then issued by nextEvent()
+     * once the remote's buffer is empty, and any error is reported from there.
+     *
+     * Prefetches are not tied to any OperationContext, since they can outlive the operation which
+     * is consuming the results. Disabled unless asyncResultsMergerPrefetchThresholdPercent is set.
+     */
+    void prefetchNextBatches();
+
     /**
      * If there is a result available that has already been retrieved from a remote node and
      * buffered, then return it along with an ok status.
@@ -248,6 +266,15 @@ private:
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
 
+        // Total size of the documents in 'docBuffer'.
+        long long bufferedBytes = 0;
+
+        // Number of documents and total size of the last batch received from this remote. Used to
+        // decide when to prefetch the next batch, and to estimate how much it will add to the
+        // buffer.
+        long long lastBatchSize = 0;
+        long long lastBatchBytes = 0;
+
     private:
         // For a cursor, which has shard id associated contains the exact host on which the remote
         // cursor resides.
@@ -377,6 +404,11 @@ private:
     // boost::none.
     bool _eofNext = false;
 
+    // The number of results handed out by nextReady() so far. Used to shrink the batchSize of
+    // getMores when the query has a limit, so that remotes are never asked for more results than
+    // could still be returned.
+    long long _numReturned = 0;
+
     boost::optional<Milliseconds> _awaitDataTimeout;
 
     //
@@ -36,6 +36,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/network_interface_mock.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
@@ -45,6 +46,7 @@
 #include "mongo/s/sharding_test_fixture.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -401,6 +403,86 @@ TEST_F(AsyncResultsMergerTest, ClusterFindSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, PrefetchNextBatchSorted) {
+    auto threshold = ServerParameterSet::getGlobal()->getMap().find(
+        "asyncResultsMergerPrefetchThresholdPercent");
+    ASSERT(threshold != ServerParameterSet::getGlobal()->getMap().end());
+    ASSERT_OK(threshold->second->setFromString("50"));
+    ON_BLOCK_EXIT([threshold] { invariantOK(threshold->second->setFromString("0")); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}, batchSize: 4}");
+    makeCursorFromFindCmd(findCmd, {kTestShardIds[0], kTestShardIds[1]});
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent(nullptr));
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1, $sortKey: {'': 1}}"),
+                                   fromjson("{_id: 3, $sortKey: {'': 3}}"),
+                                   fromjson("{_id: 5, $sortKey: {'': 5}}"),
+                                   fromjson("{_id: 7, $sortKey: {'': 7}}")};
+    responses.emplace_back(_nss, CursorId(10), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 2, $sortKey: {'': 2}}"),
+                                   fromjson("{_id: 4, $sortKey: {'': 4}}"),
+                                   fromjson("{_id: 6, $sortKey: {'': 6}}"),
+                                   fromjson("{_id: 8, $sortKey: {'': 8}}")};
+    responses.emplace_back(_nss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses), CursorResponse::ResponseType::InitialResponse);
+    executor()->waitForEvent(readyEvent);
+
+    auto hasPendingRequest = [this] {
+        network()->enterNetwork();
+        const bool hasReadyRequests = network()->hasReadyRequests();
+        network()->exitNetwork();
+        return hasReadyRequests;
+    };
+
+    // The first shard has only consumed a quarter of its batch, so nothing is prefetched yet.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, $sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    arm->prefetchNextBatches();
+    ASSERT_FALSE(hasPendingRequest());
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, $sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 3, $sortKey: {'': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // Half of the first shard's batch is consumed, so its next batch is requested while its
+    // remaining results are still buffered. The second shard is exhausted.
+    arm->prefetchNextBatches();
+    ASSERT_TRUE(hasPendingRequest());
+    auto request = getFirstPendingRequest();
+    ASSERT_EQ(kTestShardHosts[0], request.target);
+    ASSERT_EQ(10, request.cmdObj["getMore"].numberLong());
+
+    responses.clear();
+    std::vector<BSONObj> batch3 = {fromjson("{_id: 9, $sortKey: {'': 9}}"),
+                                   fromjson("{_id: 10, $sortKey: {'': 10}}")};
+    responses.emplace_back(_nss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses),
+                             CursorResponse::ResponseType::SubsequentResponse);
+
+    // The prefetched batch may or may not have been processed yet, but either way the results
+    // come back in order without any further request.
+    for (int id = 4; id <= 10; ++id) {
+        if (!arm->ready()) {
+            readyEvent = unittest::assertGet(arm->nextEvent(nullptr));
+            executor()->waitForEvent(readyEvent);
+        }
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << id << "$sortKey" << BSON("" << id)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_FALSE(hasPendingRequest());
+    ASSERT_TRUE(arm->remotesExhausted());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, ClusterFindAndGetMoreSorted) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}, batchSize: 2}");
     makeCursorFromFindCmd(findCmd, kTestShardIds);
@@ -1187,6 +1269,63 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, GetMoreBatchSizeIsCappedByRemainingLimit) {
+    // The ARM must produce limit + skip = 5 results in total.
+    BSONObj findCmd =
+        fromjson("{find: 'testcoll', sort: {_id: 1}, limit: 4, skip: 1, batchSize: 2}");
+    const long long getMoreBatchSize = 10LL;
+    makeCursorFromFindCmd(findCmd, {kTestShardIds[0], kTestShardIds[1]}, getMoreBatchSize);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent(nullptr));
+    ASSERT_FALSE(arm->ready());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1, $sortKey: {'': 1}}"),
+                                   fromjson("{_id: 2, $sortKey: {'': 2}}")};
+    responses.emplace_back(_nss, CursorId(10), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 3, $sortKey: {'': 3}}"),
+                                   fromjson("{_id: 6, $sortKey: {'': 6}}")};
+    responses.emplace_back(_nss, CursorId(11), batch2);
+    scheduleNetworkResponses(std::move(responses), CursorResponse::ResponseType::InitialResponse);
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, $sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, $sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // Two of the five results have been returned and none are buffered from the first shard, so
+    // it is asked for at most three more rather than the full getMore batchSize.
+    readyEvent = unittest::assertGet(arm->nextEvent(nullptr));
+    BSONObj scheduledCmd = getFirstPendingRequest().cmdObj;
+    auto request = GetMoreRequest::parseFromBSON("anydbname", scheduledCmd);
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(request.getValue().cursorid, 10LL);
+    ASSERT_EQ(*request.getValue().batchSize, 3LL);
+
+    responses.clear();
+    std::vector<BSONObj> batch3 = {fromjson("{_id: 4, $sortKey: {'': 4}}"),
+                                   fromjson("{_id: 5, $sortKey: {'': 5}}")};
+    responses.emplace_back(_nss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses),
+                             CursorResponse::ResponseType::SubsequentResponse);
+    executor()->waitForEvent(readyEvent);
+
+    for (int i = 3; i <= 5; ++i) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << i << "$sortKey" << BSON("" << i)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    // The second shard's cursor is still open.
+    auto killEvent = arm->kill(nullptr);
+    executor()->waitForEvent(killEvent);
+}
+
 TEST_F(AsyncResultsMergerTest, SendsSecondaryOkAsMetadata) {
     BSONObj findCmd = fromjson("{find: 'testcoll', batchSize: 2}");
     makeCursorFromFindCmd(
@@ -53,6 +53,11 @@ ExportedServerParameter<long long, ServerParameterType::kStartupAndRuntime>
 // Frequency with which ClusterCursorCleanupJob is run.
 MONGO_EXPORT_SERVER_PARAMETER(clientCursorMonitorFrequencySecs, long long, 4);
 
+// Maximum number of idle mortal cursors to keep open. Each of them holds on to the results it has
+// buffered from the shards, so when clients abandon many cursors the oldest ones are killed before
+// 'cursorTimeoutMillis' elapses. Zero means no limit.
+MONGO_EXPORT_SERVER_PARAMETER(maxIdleClusterCursors, long long, 0);
+
 }  // namespace
 
 ClusterCursorCleanupJob clusterCursorCleanupJob;
@@ -69,6 +74,10 @@ void ClusterCursorCleanupJob::run() {
     while (!globalInShutdownDeprecated()) {
         manager->killMortalCursorsInactiveSince(Date_t::now() -
                                                 Milliseconds(cursorTimeoutMillis.load()));
+        const auto maxIdleCursors = maxIdleClusterCursors.load();
+        if (maxIdleCursors > 0) {
+            manager->killOldestIdleMortalCursorsOverLimit(maxIdleCursors);
+        }
         manager->incrementCursorsTimedOut(manager->reapZombieCursors());
         sleepsecs(clientCursorMonitorFrequencySecs.load());
     }
@@ -32,7 +32,9 @@
 
 #include "mongo/s/query/cluster_cursor_manager.h"
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
@@ -343,6 +345,44 @@ void ClusterCursorManager::killMortalCursorsInactiveSince(Date_t cutoff) {
     }
 }
 
+void ClusterCursorManager::killOldestIdleMortalCursorsOverLimit(std::size_t maxIdleCursors) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    std::vector<std::pair<CursorId, CursorEntry*>> idleCursors;
+    for (auto& nsContainerPair : _namespaceToContainerMap) {
+        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+            CursorEntry& entry = cursorIdEntryPair.second;
+            if (entry.getLifetimeType() == CursorLifetime::Mortal && entry.isCursorOwned() &&
+                !entry.getKillPending()) {
+                idleCursors.emplace_back(cursorIdEntryPair.first, &entry);
+            }
+        }
+    }
+
+    if (idleCursors.size() <= maxIdleCursors) {
+        return;
+    }
+
+    // Move the cursors which were active least recently to the front.
+    const auto numToKill = idleCursors.size() - maxIdleCursors;
+    std::nth_element(idleCursors.begin(),
+                     idleCursors.begin() + (numToKill - 1),
+                     idleCursors.end(),
+                     [](const std::pair<CursorId, CursorEntry*>& lhs,
+                        const std::pair<CursorId, CursorEntry*>& rhs) {
+                         return lhs.second->getLastActive() < rhs.second->getLastActive();
+                     });
+
+    for (std::size_t i = 0; i < numToKill; ++i) {
+        CursorEntry* entry = idleCursors[i].second;
+        entry->setInactive();
+        log() << "Marking cursor id " << idleCursors[i].first
+              << " for deletion, since there are more than " << maxIdleCursors
+              << " idle cursors; idle since " << entry->getLastActive().toString();
+        entry->setKillPending();
+    }
+}
+
 void ClusterCursorManager::killAllCursors() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
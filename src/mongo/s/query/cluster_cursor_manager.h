@@ -303,6 +303,16 @@ public:
      */
     void killMortalCursorsInactiveSince(Date_t cutoff);
 
+    /**
+     * Informs the manager that, if more than 'maxIdleCursors' mortal cursors are currently idle
+     * (i.e. not pinned), the ones that have been inactive for the longest time should be killed so
+     * that only 'maxIdleCursors' of them remain. Cursors already marked as 'kill pending' do not
+     * count towards the limit.
+     *
+     * Does not block.
+     */
+    void killOldestIdleMortalCursorsOverLimit(std::size_t maxIdleCursors);
+
     /**
      * Informs the manager that all currently-registered cursors should be killed (regardless of
      * pinned status or lifetime type).
@@ -267,6 +267,44 @@ TEST_F(ClusterCursorManagerTest, CheckOutCursorUpdateActiveTime) {
     ASSERT(!isMockCursorKilled(0));
 }
 
+// Test that only the least recently active idle mortal cursors over the limit are killed, and that
+// pinned and immortal cursors are left alone.
+TEST_F(ClusterCursorManagerTest, KillOldestIdleMortalCursorsOverLimit) {
+    const size_t numCursors = 5;
+    std::vector<CursorId> cursorIds;
+    for (size_t i = 0; i < numCursors; ++i) {
+        cursorIds.push_back(assertGet(
+            getManager()->registerCursor(nullptr,
+                                         allocateMockCursor(),
+                                         nss,
+                                         ClusterCursorManager::CursorType::NamespaceNotSharded,
+                                         ClusterCursorManager::CursorLifetime::Mortal)));
+        getClockSource()->advance(Milliseconds(1));
+    }
+    ASSERT_OK(getManager()
+                  ->registerCursor(nullptr,
+                                   allocateMockCursor(),
+                                   nss,
+                                   ClusterCursorManager::CursorType::NamespaceNotSharded,
+                                   ClusterCursorManager::CursorLifetime::Immortal)
+                  .getStatus());
+
+    // The oldest cursor is pinned, so it is neither killed nor counted against the limit.
+    auto pinnedCursor = getManager()->checkOutCursor(nss, cursorIds[0], nullptr);
+    ASSERT_OK(pinnedCursor.getStatus());
+
+    getManager()->killOldestIdleMortalCursorsOverLimit(2);
+    getManager()->reapZombieCursors();
+    ASSERT(!isMockCursorKilled(0));
+    ASSERT(isMockCursorKilled(1));
+    ASSERT(isMockCursorKilled(2));
+    ASSERT(!isMockCursorKilled(3));
+    ASSERT(!isMockCursorKilled(4));
+    ASSERT(!isMockCursorKilled(5));
+
+    pinnedCursor.getValue().returnCursor(ClusterCursorManager::CursorState::NotExhausted);
+}
+
 // Test that killing a pinned cursor by id successfully kills the cursor.
 TEST_F(ClusterCursorManagerTest, KillCursorBasic) {
     auto cursorId = assertGet(
@@ -52,7 +52,12 @@ StatusWith<ClusterQueryResult> RouterStageMerge::next(OperationContext* txn) {
         _executor->waitForEvent(event);
     }
 
-    return _arm.nextReady();
+    auto result = _arm.nextReady();
+    if (result.isOK()) {
+        // Get the next batches on their way while the buffered results are being consumed.
+        _arm.prefetchNextBatches();
+    }
+    return result;
 }
 
 void RouterStageMerge::kill(OperationContext* txn) {
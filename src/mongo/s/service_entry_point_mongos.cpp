@@ -43,6 +43,7 @@
 #include "mongo/transport/service_entry_point_utils.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
 #include "mongo/util/net/thread_idle_callback.h"
@@ -69,6 +70,20 @@ BSONObj buildErrReply(const DBException& ex) {
 ServiceEntryPointMongos::ServiceEntryPointMongos(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongos::startSession(transport::SessionHandle session) {
+    if (transport::isTransportLayerASIOEnabled()) {
+        launchAsyncServiceEntrySession(
+            std::move(session),
+            [this](const transport::SessionHandle& session, Message* request, bool* inExhaust) {
+                // Release any cached egress connections for client back to pool before the
+                // Client is detached from this thread
+                auto guard = MakeGuard(ShardConnection::releaseMyConnections);
+
+                _handleRequest(session, *request);
+                return Message();
+            });
+        return;
+    }
+
     launchWrappedServiceEntryWorkerThread(
         std::move(session),
         [this](const transport::SessionHandle& session) { _sessionLoop(session); });
@@ -100,84 +115,89 @@ void ServiceEntryPointMongos::_sessionLoop(const transport::SessionHandle& sessi
             uassertStatusOK(status);
         }
 
-        auto txn = cc().makeOperationContext();
+        _handleRequest(session, message);
 
-        const int32_t msgId = message.header().getId();
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
+        }
+    }
+}
 
-        const NetworkOp op = message.operation();
+void ServiceEntryPointMongos::_handleRequest(const transport::SessionHandle& session,
+                                             const Message& message) {
+    auto txn = cc().makeOperationContext();
 
-        // This exception will not be returned to the caller, but will be logged and will close the
-        // connection
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "Message type " << op << " is not supported.",
-                op > dbMsg);
+    const int32_t msgId = message.header().getId();
 
-        // Start a new LastError session. Any exceptions thrown from here onwards will be returned
-        // to the caller (if the type of the message permits it).
-        ClusterLastErrorInfo::get(txn->getClient()).newRequest();
-        LastError::get(txn->getClient()).startRequest();
+    const NetworkOp op = message.operation();
 
-        DbMessage dbm(message);
+    // This exception will not be returned to the caller, but will be logged and will close the
+    // connection
+    uassert(ErrorCodes::IllegalOperation,
+            str::stream() << "Message type " << op << " is not supported.",
+            op > dbMsg);
 
-        NamespaceString nss;
+    // Start a new LastError session. Any exceptions thrown from here onwards will be returned
+    // to the caller (if the type of the message permits it).
+    ClusterLastErrorInfo::get(txn->getClient()).newRequest();
+    LastError::get(txn->getClient()).startRequest();
 
-        try {
+    DbMessage dbm(message);
 
-            if (dbm.messageShouldHaveNs()) {
-                nss = NamespaceString(StringData(dbm.getns()));
+    NamespaceString nss;
 
-                uassert(ErrorCodes::InvalidNamespace,
-                        str::stream() << "Invalid ns [" << nss.ns() << "]",
-                        nss.isValid());
+    try {
 
-                uassert(ErrorCodes::IllegalOperation,
-                        "Can't use 'local' database through mongos",
-                        nss.db() != NamespaceString::kLocalDb);
-            }
+        if (dbm.messageShouldHaveNs()) {
+            nss = NamespaceString(StringData(dbm.getns()));
 
-            AuthorizationSession::get(txn->getClient())->startRequest(txn.get());
-
-            LOG(3) << "Request::process begin ns: " << nss << " msg id: " << msgId
-                   << " op: " << networkOpToString(op);
-
-            switch (op) {
-                case dbQuery:
-                    if (nss.isCommand() || nss.isSpecialCommand()) {
-                        Strategy::clientCommandOp(txn.get(), nss, &dbm);
-                    } else {
-                        Strategy::queryOp(txn.get(), nss, &dbm);
-                    }
-                    break;
-                case dbGetMore:
-                    Strategy::getMore(txn.get(), nss, &dbm);
-                    break;
-                case dbKillCursors:
-                    Strategy::killCursors(txn.get(), &dbm);
-                    break;
-                default:
-                    Strategy::writeOp(txn.get(), &dbm);
-                    break;
-            }
+            uassert(ErrorCodes::InvalidNamespace,
+                    str::stream() << "Invalid ns [" << nss.ns() << "]",
+                    nss.isValid());
 
-            LOG(3) << "Request::process end ns: " << nss << " msg id: " << msgId
-                   << " op: " << networkOpToString(op);
+            uassert(ErrorCodes::IllegalOperation,
+                    "Can't use 'local' database through mongos",
+                    nss.db() != NamespaceString::kLocalDb);
+        }
 
-        } catch (const DBException& ex) {
-            LOG(1) << "Exception thrown"
-                   << " while processing " << networkOpToString(op) << " op"
-                   << " for " << nss.ns() << causedBy(ex);
+        AuthorizationSession::get(txn->getClient())->startRequest(txn.get());
 
-            if (op == dbQuery || op == dbGetMore) {
-                replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
-            }
+        LOG(3) << "Request::process begin ns: " << nss << " msg id: " << msgId
+               << " op: " << networkOpToString(op);
 
-            // We *always* populate the last error for now
-            LastError::get(txn->getClient()).setLastError(ex.getCode(), ex.what());
+        switch (op) {
+            case dbQuery:
+                if (nss.isCommand() || nss.isSpecialCommand()) {
+                    Strategy::clientCommandOp(txn.get(), nss, &dbm);
+                } else {
+                    Strategy::queryOp(txn.get(), nss, &dbm);
+                }
+                break;
+            case dbGetMore:
+                Strategy::getMore(txn.get(), nss, &dbm);
+                break;
+            case dbKillCursors:
+                Strategy::killCursors(txn.get(), &dbm);
+                break;
+            default:
+                Strategy::writeOp(txn.get(), &dbm);
+                break;
         }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
+        LOG(3) << "Request::process end ns: " << nss << " msg id: " << msgId
+               << " op: " << networkOpToString(op);
+
+    } catch (const DBException& ex) {
+        LOG(1) << "Exception thrown"
+               << " while processing " << networkOpToString(op) << " op"
+               << " for " << nss.ns() << causedBy(ex);
+
+        if (op == dbQuery || op == dbGetMore) {
+            replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
         }
+
+        // We *always* populate the last error for now
+        LastError::get(txn->getClient()).setLastError(ex.getCode(), ex.what());
     }
 }
 
@@ -32,6 +32,7 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/util/net/message.h"
 
 namespace mongo {
 
@@ -42,7 +43,8 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongos. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the
+ * asio TransportLayer is in use, in which case sessions are run on its worker threads.
  */
 class ServiceEntryPointMongos final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongos);
@@ -57,6 +59,11 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs a single request. Replies are sent to the client from within the request handling.
+     */
+    void _handleRequest(const transport::SessionHandle& session, const Message& message);
+
     transport::TransportLayer* _tl;
 };
 
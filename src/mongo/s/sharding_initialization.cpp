@@ -76,6 +76,11 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxSize, int, -1);
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMinSize,
                                       int,
                                       static_cast<int>(ConnectionPool::kDefaultMinConns));
+// Limits how many connections each pool may be establishing to a host at once, -1 for no limit.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxConnecting, int, 2);
+// Number of network threads in each executor of the TaskExecutorPool. Raising it lets fewer
+// executors, and so fewer connection pools, use as many cores (see taskExecutorPoolSize).
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorNetworkThreads, int, 1);
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolRefreshRequirementMS,
                                       int,
                                       ConnectionPool::kDefaultRefreshRequirement.count());
@@ -123,7 +128,8 @@ std::unique_ptr<TaskExecutorPool> makeTaskExecutorPool(
             "NetworkInterfaceASIO-TaskExecutorPool-" + std::to_string(i),
             stdx::make_unique<ShardingNetworkConnectionHook>(),
             metadataHookBuilder(),
-            connPoolOptions);
+            connPoolOptions,
+            ShardingTaskExecutorNetworkThreads);
         auto netPtr = net.get();
         auto exec = stdx::make_unique<ThreadPoolTaskExecutor>(
             stdx::make_unique<NetworkInterfaceThreadPool>(netPtr), std::move(net));
@@ -165,6 +171,15 @@ Status initializeGlobalShardingState(OperationContext* txn,
         return {ErrorCodes::BadValue, "Unrecognized connection string."};
     }
 
+    if (ShardingTaskExecutorPoolMaxConnecting < 1 && ShardingTaskExecutorPoolMaxConnecting != -1) {
+        return {ErrorCodes::BadValue,
+                "ShardingTaskExecutorPoolMaxConnecting must be positive, or -1 for no limit"};
+    }
+
+    if (ShardingTaskExecutorNetworkThreads < 1) {
+        return {ErrorCodes::BadValue, "ShardingTaskExecutorNetworkThreads must be positive"};
+    }
+
     // We don't set the ConnectionPool's static const variables to be the default value in
     // MONGO_EXPORT_STARTUP_SERVER_PARAMETER because it's not guaranteed to be initialized.
     // The following code is a workaround.
@@ -174,6 +189,9 @@ Status initializeGlobalShardingState(OperationContext* txn,
         ? ShardingTaskExecutorPoolMaxSize
         : ConnectionPool::kDefaultMaxConns;
     connPoolOptions.minConnections = ShardingTaskExecutorPoolMinSize;
+    connPoolOptions.maxConnecting = (ShardingTaskExecutorPoolMaxConnecting != -1)
+        ? ShardingTaskExecutorPoolMaxConnecting
+        : ConnectionPool::kDefaultMaxConnecting;
     connPoolOptions.refreshRequirement = Milliseconds(ShardingTaskExecutorPoolRefreshRequirementMS);
     connPoolOptions.refreshTimeout = Milliseconds(ShardingTaskExecutorPoolRefreshTimeoutMS);
 
@@ -31,6 +31,7 @@
 #include "mongo/s/write_ops/batch_write_op.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/db/server_parameters.h"
 
 namespace mongo {
 
@@ -40,6 +41,8 @@ using std::set;
 using std::stringstream;
 using std::vector;
 
+MONGO_EXPORT_SERVER_PARAMETER(internalOrderedInsertsParallelDispatch, bool, false);
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -269,8 +272,15 @@ Status BatchWriteOp::targetBatch(OperationContext* txn,
     //  [{ skey : [c,x] }],
     //  [{ skey : y }, { skey : z }]
     //
+    // If internalOrderedInsertsParallelDispatch is set, ordered inserts are split by shard like
+    // unordered ones. Each shard still applies its own subsequence in order and stops at its
+    // first error, but writes on other shards which come after that error may also be applied.
+    //
 
     const bool ordered = _clientRequest->getOrdered();
+    const bool splitAtShardBoundaries = ordered &&
+        !(_clientRequest->getBatchType() == BatchedCommandRequest::BatchType_Insert &&
+          internalOrderedInsertsParallelDispatch.load());
 
     TargetedBatchMap batchMap;
     TargetedBatchSizeMap batchSizes;
@@ -331,7 +341,7 @@ Status BatchWriteOp::targetBatch(OperationContext* txn,
         // targeted writes to any other endpoints.
         //
 
-        if (ordered && !batchMap.empty()) {
+        if (splitAtShardBoundaries && !batchMap.empty()) {
             dassert(batchMap.size() == 1u);
             if (isNewBatchRequired(writes, batchMap)) {
                 writeOp.cancelWrites(NULL);
@@ -383,7 +393,7 @@ Status BatchWriteOp::targetBatch(OperationContext* txn,
         // enforced as ordered across multiple shard endpoints.
         //
 
-        if (ordered && batchMap.size() > 1u)
+        if (splitAtShardBoundaries && batchMap.size() > 1u)
             break;
     }
 
@@ -695,12 +705,24 @@ bool BatchWriteOp::isFinished() {
         if (writeOp.getWriteState() < WriteOpState_Completed)
             return false;
         else if (orderedOps && writeOp.getWriteState() == WriteOpState_Error)
-            return true;
+            return !_hasPendingWriteOpsAfter(i);
     }
 
     return true;
 }
 
+bool BatchWriteOp::_hasPendingWriteOpsAfter(size_t index) const {
+    // Only possible when internalOrderedInsertsParallelDispatch sent the later writes to other
+    // shards in the same round. Their batches have to be waited for, so that the writes they
+    // applied are reported.
+    size_t numWriteOps = _clientRequest->sizeWriteOps();
+    for (size_t i = index + 1; i < numWriteOps; ++i) {
+        if (_writeOps[i].getWriteState() == WriteOpState_Pending)
+            return true;
+    }
+    return false;
+}
+
 //
 // Aggregation functions for building the final response errors
 //
@@ -34,6 +34,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/unordered_map.h"
 #include "mongo/rpc/write_concern_error_detail.h"
 #include "mongo/s/ns_targeter.h"
@@ -51,6 +52,12 @@ struct ShardWCError;
 class TrackedErrors;
 struct BatchWriteStats;
 
+/**
+ * If set, ordered insert batches are dispatched to all of their target shards at once rather
+ * than one shard at a time. Writes after the first failed write may then have been applied.
+ */
+extern AtomicBool internalOrderedInsertsParallelDispatch;
+
 /**
  * The BatchWriteOp class manages the lifecycle of a batched write received by mongos.  Each
  * item in a batch is tracked via a WriteOp, and the function of the BatchWriteOp is to
@@ -162,6 +169,11 @@ public:
     int numWriteOpsIn(WriteOpState state) const;
 
 private:
+    /**
+     * Returns whether any write after the one at 'index' is still waiting for a shard response.
+     */
+    bool _hasPendingWriteOpsAfter(size_t index) const;
+
     // Incoming client request, not owned here
     const BatchedCommandRequest* _clientRequest;
 
@@ -36,6 +36,7 @@
 #include "mongo/s/write_ops/mock_ns_targeter.h"
 #include "mongo/s/write_ops/write_error_detail.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -523,6 +524,68 @@ TEST(WriteOpTests, MultiOpTwoShardsOrdered) {
     ASSERT_EQUALS(clientResponse.getN(), 2);
 }
 
+TEST(WriteOpTests, MultiOpTwoShardsOrderedParallelInserts) {
+    //
+    // Multi-op, multi-endpoint ordered inserts with internalOrderedInsertsParallelDispatch set
+    // There should be one batch per shard, and an error on one shard should only stop the writes
+    // after it on that shard
+    //
+
+    internalOrderedInsertsParallelDispatch.store(true);
+    ON_BLOCK_EXIT([] { internalOrderedInsertsParallelDispatch.store(false); });
+
+    OperationContextNoop txn;
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+    MockNSTargeter targeter;
+    initTargeterSplitRange(nss, endpointA, endpointB, &targeter);
+
+    BatchedCommandRequest request(BatchedCommandRequest::BatchType_Insert);
+    request.setNS(nss);
+    request.setOrdered(true);
+    request.getInsertRequest()->addToDocuments(BSON("x" << -1));
+    request.getInsertRequest()->addToDocuments(BSON("x" << 1));
+    request.getInsertRequest()->addToDocuments(BSON("x" << -2));
+    request.getInsertRequest()->addToDocuments(BSON("x" << 2));
+
+    BatchWriteOp batchOp;
+    batchOp.initClientRequest(&request);
+    ASSERT(!batchOp.isFinished());
+
+    OwnedPointerVector<TargetedWriteBatch> targetedOwned;
+    vector<TargetedWriteBatch*>& targeted = targetedOwned.mutableVector();
+    Status status = batchOp.targetBatch(&txn, targeter, false, &targeted);
+
+    ASSERT(status.isOK());
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 2u);
+    sortByEndpoint(&targeted);
+    assertEndpointsEqual(targeted.front()->getEndpoint(), endpointA);
+    assertEndpointsEqual(targeted.back()->getEndpoint(), endpointB);
+    ASSERT_EQUALS(targeted.front()->getWrites().size(), 2u);
+    ASSERT_EQUALS(targeted.back()->getWrites().size(), 2u);
+
+    // Error on the first write on the first shard
+    BatchedCommandResponse response;
+    buildResponse(0, &response);
+    addError(ErrorCodes::UnknownError, "mock error", 0, &response);
+    batchOp.noteBatchResponse(*targeted.front(), response, NULL);
+    ASSERT(!batchOp.isFinished());
+
+    buildResponse(2, &response);
+    batchOp.noteBatchResponse(*targeted.back(), response, NULL);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 2);
+    ASSERT(clientResponse.isErrDetailsSet());
+    ASSERT_EQUALS(clientResponse.sizeErrDetails(), 1u);
+    ASSERT_EQUALS(clientResponse.getErrDetailsAt(0)->getIndex(), 0);
+}
+
 TEST(WriteOpTests, MultiOpTwoShardsUnordered) {
     //
     // Multi-op, multi-endpoint targeting test (unordered)
@@ -28,6 +28,8 @@
 
 #include "mongo/scripting/bson_template_evaluator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 
@@ -39,10 +41,60 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+const double kDefaultZipfianTheta = 0.99;
+
+bool parseZipfianTheta(const BSONElement& elem, double* theta) {
+    if (elem.eoo()) {
+        *theta = kDefaultZipfianTheta;
+        return true;
+    }
+    if (!elem.isNumber())
+        return false;
+    *theta = elem.numberDouble();
+    return *theta > 0 && *theta < 1;
+}
+}  // namespace
+
+BsonTemplateEvaluator::ZipfianGenerator::ZipfianGenerator(double theta)
+    : _theta(theta), _alpha(1.0 / (1.0 - theta)), _zeta2(1.0 + std::pow(0.5, theta)) {}
+
+void BsonTemplateEvaluator::ZipfianGenerator::_resize(long long n) {
+    if (n < _n) {
+        _n = 0;
+        _zetan = 0;
+    }
+    for (long long i = _n + 1; i <= n; ++i) {
+        _zetan += 1.0 / std::pow(static_cast<double>(i), _theta);
+    }
+    _n = n;
+    if (_n > 2) {
+        _eta = (1.0 - std::pow(2.0 / _n, 1.0 - _theta)) / (1.0 - _zeta2 / _zetan);
+    }
+}
+
+long long BsonTemplateEvaluator::ZipfianGenerator::next(PseudoRandom* rng, long long n) {
+    if (n != _n)
+        _resize(n);
+    if (_n == 1)
+        return 0;
+
+    const double u = rng->nextCanonicalDouble();
+    const double uz = u * _zetan;
+    if (uz < 1.0)
+        return 0;
+    if (_n == 2 || uz < _zeta2)
+        return 1;
+    const long long rank = static_cast<long long>(_n * std::pow(_eta * u - _eta + 1.0, _alpha));
+    return std::min(rank, _n - 1);
+}
+
 void BsonTemplateEvaluator::initializeEvaluator() {
     addOperator("RAND_INT", &BsonTemplateEvaluator::evalRandInt);
     addOperator("RAND_INT_PLUS_THREAD", &BsonTemplateEvaluator::evalRandPlusThread);
     addOperator("SEQ_INT", &BsonTemplateEvaluator::evalSeqInt);
+    addOperator("ZIPFIAN_INT", &BsonTemplateEvaluator::evalZipfianInt);
+    addOperator("LATEST_INT", &BsonTemplateEvaluator::evalLatestInt);
     addOperator("RAND_STRING", &BsonTemplateEvaluator::evalRandString);
     addOperator("CONCAT", &BsonTemplateEvaluator::evalConcat);
     addOperator("OID", &BsonTemplateEvaluator::evalObjId);
@@ -228,10 +280,11 @@ BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalSeqInt(BsonTemplateEval
         curr_seqval += (workerid << ((sizeof(long long) - 1) * 8));
     }
 
-    if (btl->_seqIdMap.end() != btl->_seqIdMap.find(seq_id)) {
+    const int step = spec["step"].numberInt();
+    auto seqState = btl->_seqIdMap.find(seq_id);
+    if (btl->_seqIdMap.end() != seqState) {
         // We already have a sequence value. Add 'step' to get the next value.
-        int step = spec["step"].numberInt();
-        curr_seqval = btl->_seqIdMap[seq_id] + step;
+        curr_seqval = seqState->second.value + step;
     }
 
     // Handle the optional "mod" argument. This should be done after
@@ -246,12 +299,71 @@ BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalSeqInt(BsonTemplateEval
     }
 
     // Store the sequence value.
-    btl->_seqIdMap[seq_id] = curr_seqval;
+    auto& state = btl->_seqIdMap[seq_id];
+    state.value = curr_seqval;
+    state.step = step;
+    ++state.count;
 
     out.append(fieldName, curr_seqval);
     return StatusSuccess;
 }
 
+BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalZipfianInt(BsonTemplateEvaluator* btl,
+                                                                    const char* fieldName,
+                                                                    const BSONObj& in,
+                                                                    BSONObjBuilder& out) {
+    // in = { #ZIPFIAN_INT: [0, 1000, 0.99] }
+    BSONObj range = in.firstElement().embeddedObject();
+    if (!range["0"].isNumber() || !range["1"].isNumber())
+        return StatusOpEvaluationError;
+    const int min = range["0"].numberInt();
+    const int max = range["1"].numberInt();
+    if (max <= min)
+        return StatusOpEvaluationError;
+    double theta;
+    if (range.nFields() > 3 || !parseZipfianTheta(range["2"], &theta))
+        return StatusOpEvaluationError;
+
+    const long long n = static_cast<long long>(max) - min;
+    auto it = btl->_zipfianByRange.find(std::make_pair(n, theta));
+    if (it == btl->_zipfianByRange.end()) {
+        it = btl->_zipfianByRange.emplace(std::make_pair(n, theta), ZipfianGenerator(theta)).first;
+    }
+    out.append(fieldName, static_cast<int>(min + it->second.next(&btl->rng, n)));
+    return StatusSuccess;
+}
+
+BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalLatestInt(BsonTemplateEvaluator* btl,
+                                                                   const char* fieldName,
+                                                                   const BSONObj& in,
+                                                                   BSONObjBuilder& out) {
+    // in = { #LATEST_INT: { seq_id: 0, range: 1000, theta: 0.99 } }
+    BSONObj spec = in.firstElement().embeddedObject();
+    if (!spec["seq_id"].isNumber() || !spec["range"].isNumber())
+        return StatusOpEvaluationError;
+    const long long range = spec["range"].numberLong();
+    if (range <= 0)
+        return StatusOpEvaluationError;
+    double theta;
+    if (!parseZipfianTheta(spec["theta"], &theta))
+        return StatusOpEvaluationError;
+
+    const int seq_id = spec["seq_id"].numberInt();
+    auto seqState = btl->_seqIdMap.find(seq_id);
+    if (seqState == btl->_seqIdMap.end())
+        return StatusOpEvaluationError;
+    const SeqIntState& state = seqState->second;
+
+    auto it = btl->_zipfianBySeqId.find(seq_id);
+    if (it == btl->_zipfianBySeqId.end() || it->second.theta() != theta) {
+        btl->_zipfianBySeqId.erase(seq_id);
+        it = btl->_zipfianBySeqId.emplace(seq_id, ZipfianGenerator(theta)).first;
+    }
+    const long long rank = it->second.next(&btl->rng, std::min(range, state.count));
+    out.append(fieldName, state.value - rank * state.step);
+    return StatusSuccess;
+}
+
 BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalRandString(BsonTemplateEvaluator* btl,
                                                                     const char* fieldName,
                                                                     const BSONObj& in,
@@ -29,7 +29,8 @@
 /*
  * This library supports a templating language that helps in generating BSON documents from a
  * template. The language supports the following templates:
- * #RAND_INT, #SEQ_INT, #RAND_STRING, #CONCAT, #CUR_DATE, $VARIABLE and #OID.
+ * #RAND_INT, #SEQ_INT, #ZIPFIAN_INT, #LATEST_INT, #RAND_STRING, #CONCAT, #CUR_DATE, $VARIABLE
+ * and #OID.
  *
  * The language will help in quickly expressing richer documents  for use in benchRun.
  * Ex. : { key : { #RAND_INT: [10, 20] } } or  { key : { #CONCAT: ["hello", " ", "world"] } }
@@ -45,6 +46,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/random.h"
@@ -155,9 +157,48 @@ private:
     // similar sequences of values without colliding with one another.
     unsigned char _id;
 
+    /*
+     * Draws integers in [0, n) from a Zipfian distribution with exponent 'theta' in (0, 1), using
+     * the method of Gray et al., "Quickly Generating Billion-Record Synthetic Databases". Rank 0
+     * is the most popular value. The normalization constant is extended incrementally, so
+     * growing 'n' by k between calls costs O(k) rather than O(n).
+     */
+    class ZipfianGenerator {
+    public:
+        explicit ZipfianGenerator(double theta);
+
+        double theta() const {
+            return _theta;
+        }
+
+        long long next(PseudoRandom* rng, long long n);
+
+    private:
+        void _resize(long long n);
+
+        double _theta;
+        double _alpha;
+        double _zeta2;
+        double _zetan = 0;
+        double _eta = 0;
+        long long _n = 0;
+    };
+
+    // State of a single SEQ_INT expansion.
+    struct SeqIntState {
+        long long value;
+        long long step;
+        long long count;
+    };
+
     // Keeps state for each SEQ_INT expansion being evaluated by this bson template evaluator
-    // instance. Maps from the seq_id of the sequence to its current value.
-    std::map<int, long long> _seqIdMap;
+    // instance. Maps from the seq_id of the sequence to its current state.
+    std::map<int, SeqIntState> _seqIdMap;
+
+    // Generators for #ZIPFIAN_INT keyed by (range size, theta), and for #LATEST_INT keyed by the
+    // seq_id of the sequence they follow.
+    std::map<std::pair<long long, double>, ZipfianGenerator> _zipfianByRange;
+    std::map<int, ZipfianGenerator> _zipfianBySeqId;
 
     /*
      * Operator method to support #RAND_INT :  { key : { #RAND_INT: [10, 20] } }
@@ -215,6 +256,33 @@ private:
                              const char* fieldName,
                              const BSONObj& in,
                              BSONObjBuilder& out);
+    /*
+     * Operator method to support #ZIPFIAN_INT : { key : { #ZIPFIAN_INT: [0, 1000, 0.99] } }
+     * Chooses a number in [min, max) where smaller numbers are exponentially more likely, as in
+     * a skewed key access pattern. The optional third argument is the Zipfian constant 'theta'
+     * in (0, 1), which defaults to 0.99; larger values concentrate more of the accesses on the
+     * lowest keys.
+     */
+    static Status evalZipfianInt(BsonTemplateEvaluator* btl,
+                                 const char* fieldName,
+                                 const BSONObj& in,
+                                 BSONObjBuilder& out);
+
+    /*
+     * Operator method to support #LATEST_INT :
+     *    { key : { #LATEST_INT: { seq_id: 0, range: 1000, theta: 0.99 } } }
+     *
+     * Chooses one of the values most recently produced by the #SEQ_INT expansion 'seq_id',
+     * favouring the newest ones with a Zipfian distribution over the last 'range' values. This
+     * models workloads which mostly read what was just written. 'theta' is optional and
+     * defaults to 0.99. It is an error to evaluate #LATEST_INT before the sequence has produced
+     * any value.
+     */
+    static Status evalLatestInt(BsonTemplateEvaluator* btl,
+                                const char* fieldName,
+                                const BSONObj& in,
+                                BSONObjBuilder& out);
+
     /*
      * Operator method to support #RAND_STRING : { key : { #RAND_STRING: [12] } }
      * The array argument to RAND_STRING is the length of the std::string that is desired.
@@ -397,6 +397,95 @@ TEST(BSONTemplateEvaluatorTest, SEQ_INT) {
     ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError, t->setId(128));
 }
 
+TEST(BSONTemplateEvaluatorTest, ZIPFIAN_INT) {
+    BsonTemplateEvaluator t(2718281);
+
+    common_rand_tests("#ZIPFIAN_INT", &t);
+
+    // Error if theta is outside of (0, 1).
+    for (double theta : {0.0, 1.0, 1.5}) {
+        BSONObjBuilder builder;
+        BSONObj zipfObj = BSON("#ZIPFIAN_INT" << BSON_ARRAY(0 << 10 << theta));
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                      t.evaluate(BSON("zipfField" << zipfObj), builder));
+    }
+
+    // Values stay in [min, max) and the smallest ones are by far the most popular.
+    std::vector<int> counts(100);
+    BSONObj zipfObj = BSON("#ZIPFIAN_INT" << BSON_ARRAY(100 << 200));
+    for (int i = 0; i < 10000; ++i) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                      t.evaluate(BSON("zipfField" << zipfObj), builder));
+        int value = builder.obj()["zipfField"].numberInt();
+        ASSERT_GREATER_THAN_OR_EQUALS(value, 100);
+        ASSERT_LESS_THAN(value, 200);
+        ++counts[value - 100];
+    }
+    ASSERT_GREATER_THAN(counts[0], counts[1]);
+    ASSERT_GREATER_THAN(counts[1], counts[10]);
+    ASSERT_GREATER_THAN(counts[0], 10 * counts[50]);
+
+    // A range of a single value always yields that value.
+    BSONObjBuilder builder;
+    zipfObj = BSON("#ZIPFIAN_INT" << BSON_ARRAY(7 << 8 << 0.5));
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                  t.evaluate(BSON("zipfField" << zipfObj), builder));
+    ASSERT_EQUALS(builder.obj()["zipfField"].numberInt(), 7);
+}
+
+TEST(BSONTemplateEvaluatorTest, LATEST_INT) {
+    BsonTemplateEvaluator t(3141592);
+    BSONObj latestObj = BSON("#LATEST_INT" << BSON("seq_id" << 0 << "range" << 10));
+
+    // Error if the sequence has not produced a value yet.
+    BSONObjBuilder builder1;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                  t.evaluate(BSON("latestField" << latestObj), builder1));
+
+    // Error if 'range' is missing or not positive.
+    BSONObjBuilder builder2;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                  t.evaluate(BSON("latestField" << BSON("#LATEST_INT" << BSON("seq_id" << 0))),
+                             builder2));
+    BSONObjBuilder builder3;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                  t.evaluate(BSON("latestField"
+                                  << BSON("#LATEST_INT" << BSON("seq_id" << 0 << "range" << 0))),
+                             builder3));
+
+    // With a single value produced, that value is always the latest.
+    BSONObj seqObj = BSON("#SEQ_INT" << BSON("seq_id" << 0 << "start" << 0 << "step" << 3));
+    BSONObjBuilder builder4;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                  t.evaluate(BSON("seqField" << seqObj), builder4));
+    BSONObjBuilder builder5;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                  t.evaluate(BSON("latestField" << latestObj), builder5));
+    ASSERT_EQUALS(builder5.obj()["latestField"].numberLong(), 0);
+
+    // Generate 0, 3, ..., 297 and check that only the last 10 values are chosen, with the newest
+    // being the most popular.
+    for (int i = 1; i < 100; ++i) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                      t.evaluate(BSON("seqField" << seqObj), builder));
+    }
+    std::map<long long, int> counts;
+    for (int i = 0; i < 1000; ++i) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                      t.evaluate(BSON("latestField" << latestObj), builder));
+        long long value = builder.obj()["latestField"].numberLong();
+        ASSERT_GREATER_THAN_OR_EQUALS(value, 270);
+        ASSERT_LESS_THAN_OR_EQUALS(value, 297);
+        ASSERT_EQUALS(value % 3, 0);
+        ++counts[value];
+    }
+    ASSERT_GREATER_THAN(counts[297], counts[294]);
+    ASSERT_GREATER_THAN(counts[294], counts[270]);
+}
+
 TEST(BSONTemplateEvaluatorTest, RAND_STRING) {
     BsonTemplateEvaluator t(4567890);
 
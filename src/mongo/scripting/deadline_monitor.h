@@ -28,14 +28,15 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
-#include "mongo/platform/atomic_word.h"
+#include "mongo/db/deadline_scheduler.h"
+#include "mongo/db/service_context.h"
 #include "mongo/platform/unordered_map.h"
-#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
-#include "mongo/stdx/thread.h"
-#include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -50,20 +51,16 @@ int getScriptingEngineInterruptInterval();
  * a deadline is started on a _Task*, either the deadline must be stopped,
  * or _Task::kill() will be called when the deadline arrives.
  *
- * Each instance of a DeadlineMonitor spawns a thread which waits for one of the
- * following conditions:
- *    - a task is added to the monitor
- *    - a task is removed from the monitor
- *    - the nearest deadline has arrived
+ * The deadlines are timers of a DeadlineScheduler, by default the one of the global
+ * ServiceContext, so that monitoring them takes no thread of its own. Processes without a global
+ * ServiceContext, like the shell, get a scheduler of their own. If the
+ * scriptingEngineInterruptIntervalMS parameter is set, _Task::interrupt() is also called every
+ * interval on the tasks whose deadlines have not arrived.
  *
  * Ownership:
  * The _Task* must not be freed until the deadline has elapsed or stopDeadline()
  * has been called.
  *
- * NOTE: Each instance of this class spawns a new thread.  It is intended to be a stop-gap
- *       solution for simple deadline monitoring until a more robust solution can be
- *       implemented.
- *
  * NOTE: timing is based on wallclock time, which may not be precise.
  */
 template <typename _Task>
@@ -71,22 +68,29 @@ class DeadlineMonitor {
     MONGO_DISALLOW_COPYING(DeadlineMonitor);
 
 public:
-    DeadlineMonitor() {
-        // NOTE(schwerin): Because _monitorThread takes a pointer to "this", all of the fields
-        // of this instance must be initialized before the thread is created.  As a result, we
-        // should not create the thread in the initializer list.  Creating it there leaves us
-        // vulnerable to errors introduced by rearranging the order of fields in the class.
-        _monitorThread = stdx::thread(&mongo::DeadlineMonitor<_Task>::deadlineMonitorThread, this);
-    }
+    DeadlineMonitor()
+        : _ownScheduler(hasGlobalServiceContext() ? nullptr
+                                                  : stdx::make_unique<DeadlineScheduler>()),
+          _scheduler(_ownScheduler ? _ownScheduler.get()
+                                   : DeadlineScheduler::get(getGlobalServiceContext())) {}
+
+    explicit DeadlineMonitor(DeadlineScheduler* scheduler) : _scheduler(scheduler) {}
 
     ~DeadlineMonitor() {
+        std::vector<DeadlineScheduler::TimerId> timers;
         {
-            // ensure the monitor thread has been stopped before destruction
             stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
             _inShutdown = true;
-            _newDeadlineAvailable.notify_one();
+            for (const auto& task : _tasks) {
+                timers.push_back(task.second.timer);
+            }
+            timers.push_back(_interruptTimer);
+        }
+
+        // Callbacks may be running, and take _deadlineMutex, so it must not be held here.
+        for (auto timer : timers) {
+            _scheduler->disarm(timer);
         }
-        _monitorThread.join();
     }
 
     /**
@@ -105,14 +109,17 @@ public:
         }
         stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
 
-        if (_tasks.find(task) == _tasks.end()) {
-            _tasks.emplace(task, deadline);
+        if (_tasks.find(task) != _tasks.end()) {
+            return;
         }
 
-        if (deadline < _nearestDeadlineWallclock) {
-            _nearestDeadlineWallclock = deadline;
-            _newDeadlineAvailable.notify_one();
+        auto timer = DeadlineScheduler::kNoTimer;
+        if (deadline != Date_t::max()) {
+            timer = _scheduler->arm(deadline, [this, task] { deadlineArrived(task); });
         }
+        _tasks.emplace(task, TaskDeadline{deadline, timer});
+
+        armInterruptTimer_inlock();
     }
 
     /**
@@ -121,73 +128,79 @@ public:
      * @return true  if the task was found and erased
      */
     bool stopDeadline(_Task* const task) {
-        stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
-        return _tasks.erase(task);
+        auto timer = DeadlineScheduler::kNoTimer;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
+            auto it = _tasks.find(task);
+            if (it == _tasks.end()) {
+                return false;
+            }
+            timer = it->second.timer;
+            _tasks.erase(it);
+        }
+
+        // A callback which has already started will find the task gone. Disarming must be done
+        // without _deadlineMutex held, since the callback takes it.
+        _scheduler->disarm(timer);
+        return true;
     }
 
 private:
+    struct TaskDeadline {
+        Date_t deadline;
+        DeadlineScheduler::TimerId timer;
+    };
+
     /**
-     * Main deadline monitor loop.  Waits on a condition variable until a task
-     * is started, stopped, or the nearest deadline arrives.  If a deadline arrives,
-     * _Task::kill() is invoked.
+     * Kills 'task' if its deadline is still being monitored.
      */
-    void deadlineMonitorThread() {
-        stdx::unique_lock<stdx::mutex> lk(_deadlineMutex);
-        Date_t lastInterruptCycle = Date_t::now();
-        while (!_inShutdown) {
-            // get the next interval to wait
-            const Date_t now = Date_t::now();
-            const auto interruptInterval = Milliseconds{getScriptingEngineInterruptInterval()};
-
-            if ((interruptInterval.count() > 0) && (now - lastInterruptCycle > interruptInterval)) {
-                for (const auto& task : _tasks) {
-                    if (task.second > now)
-                        task.first->interrupt();
-                }
-                lastInterruptCycle = now;
-            }
+    void deadlineArrived(_Task* const task) {
+        stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
+        auto it = _tasks.find(task);
+        if (it == _tasks.end()) {
+            return;
+        }
+        _tasks.erase(it);
+        task->kill();
+    }
 
-            // wait for a task to be added or a deadline to expire
-            if (_nearestDeadlineWallclock > now) {
-                if (_nearestDeadlineWallclock == Date_t::max()) {
-                    if ((interruptInterval.count() > 0) &&
-                        (_nearestDeadlineWallclock - now > interruptInterval)) {
-                        _newDeadlineAvailable.wait_for(lk, interruptInterval.toSystemDuration());
-                    } else {
-                        _newDeadlineAvailable.wait(lk);
-                    }
-                } else {
-                    _newDeadlineAvailable.wait_until(lk,
-                                                     _nearestDeadlineWallclock.toSystemTimePoint());
-                }
-                continue;
-            }
+    /**
+     * Interrupts the tasks whose deadlines have not arrived, and arms the next interval's timer.
+     */
+    void interruptIntervalArrived() {
+        stdx::lock_guard<stdx::mutex> lk(_deadlineMutex);
+        _interruptTimer = DeadlineScheduler::kNoTimer;
 
-            // set the next interval to wait for deadline completion
-            _nearestDeadlineWallclock = Date_t::max();
-            auto i = _tasks.begin();
-            while (i != _tasks.end()) {
-                if (i->second < now) {
-                    // deadline expired
-                    i->first->kill();
-                    _tasks.erase(i++);
-                } else {
-                    if (i->second < _nearestDeadlineWallclock) {
-                        // nearest deadline seen so far
-                        _nearestDeadlineWallclock = i->second;
-                    }
-                    ++i;
-                }
-            }
+        const Date_t now = Date_t::now();
+        for (const auto& task : _tasks) {
+            if (task.second.deadline > now)
+                task.first->interrupt();
         }
+
+        armInterruptTimer_inlock();
+    }
+
+    void armInterruptTimer_inlock() {
+        const auto interruptInterval = Milliseconds{getScriptingEngineInterruptInterval()};
+        if (_inShutdown || _tasks.empty() || interruptInterval <= Milliseconds(0) ||
+            _interruptTimer != DeadlineScheduler::kNoTimer) {
+            return;
+        }
+        _interruptTimer = _scheduler->arm(Date_t::now() + interruptInterval,
+                                          [this] { interruptIntervalArrived(); });
     }
 
-    using TaskDeadlineMap = stdx::unordered_map<_Task*, Date_t>;
+    using TaskDeadlineMap = stdx::unordered_map<_Task*, TaskDeadline>;
+
+    const std::unique_ptr<DeadlineScheduler> _ownScheduler;
+    DeadlineScheduler* const _scheduler;
+
+    stdx::mutex _deadlineMutex;  // protects all non-const members
     TaskDeadlineMap _tasks;      // map of running tasks with deadlines
-    stdx::mutex _deadlineMutex;  // protects all non-const members, except _monitorThread
-    stdx::condition_variable _newDeadlineAvailable;    // Signaled for timeout, start and stop
-    stdx::thread _monitorThread;                       // the deadline monitor thread
-    Date_t _nearestDeadlineWallclock = Date_t::max();  // absolute time of the nearest deadline
+
+    // Timer for the next scriptingEngineInterruptIntervalMS interval, if one is armed.
+    DeadlineScheduler::TimerId _interruptTimer = DeadlineScheduler::kNoTimer;
+
     bool _inShutdown = false;
 };
 
@@ -97,6 +97,15 @@ TEST(DeadlineMonitor, RemoveBeforeExpire) {
     ASSERT(!task._killed);
 }
 
+// a task started without a timeout is never killed, and stopping it does not block
+TEST(DeadlineMonitor, RemoveWithoutTimeout) {
+    DeadlineMonitor<Task> dm;
+    Task task;
+    dm.startDeadline(&task, -1);
+    ASSERT(dm.stopDeadline(&task));
+    ASSERT(!task._killed);
+}
+
 // multiple tasks complete before deadline expires (with 10ms window)
 TEST(DeadlineMonitor, MultipleTasksCompleteBeforeExpire) {
     DeadlineMonitor<Task> dm;
@@ -39,6 +39,7 @@
 #include "mongo/client/dbclientcursor.h"
 #include "mongo/client/dbclientinterface.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/scripting/dbdirectclient_factory.h"
@@ -316,6 +317,16 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+
+// How many idle scopes are kept for reuse, across all pools. A pooled scope keeps the functions
+// compiled in it, so a larger pool helps workloads that run the same $where or mapReduce code
+// from many connections at once.
+MONGO_EXPORT_SERVER_PARAMETER(internalJavaScriptScopePoolSize, int, 10);
+
+// How many times a scope is reused before it is thrown away, which bounds the garbage that can
+// build up in a scope's globals.
+MONGO_EXPORT_SERVER_PARAMETER(internalJavaScriptMaxScopeReuse, int, 10);
+
 class ScopeCache {
 public:
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
@@ -328,13 +339,17 @@ public:
             return;
         }
 
-        if (scope->getTimesUsed() > kMaxScopeReuse)
+        if (scope->getTimesUsed() > internalJavaScriptMaxScopeReuse.load())
             return;  // used too many times to save
 
         if (!scope->getError().empty())
             return;  // not saving errored scopes
 
-        if (_pools.size() >= kMaxPoolSize) {
+        const int maxPoolSize = internalJavaScriptScopePoolSize.load();
+        if (maxPoolSize <= 0)
+            return;  // pooling is disabled
+
+        while (_pools.size() >= static_cast<size_t>(maxPoolSize)) {
             // prefer to keep recently-used scopes
             _pools.pop_back();
         }
@@ -373,10 +388,8 @@ private:
         string poolName;
     };
 
-    // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
-    static const int kMaxScopeReuse = 10;
-
+    // Note: _pools is searched linearly, so reconsider its datastructure before making
+    // internalJavaScriptScopePoolSize much larger by default.
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
     stdx::mutex _mutex;
@@ -139,7 +139,8 @@ void BSONInfo::enumerate(JSContext* cx,
 
         // TODO: when we get heterogenous set lookup, switch to StringData
         // rather than involving the temporary string
-        if (holder->_removed.find(e.fieldName()) != holder->_removed.end())
+        if (!holder->_removed.empty() &&
+            holder->_removed.find(e.fieldName()) != holder->_removed.end())
             continue;
 
         ValueReader(cx, &val).fromStringData(e.fieldNameStringData());
@@ -212,15 +213,18 @@ void BSONInfo::resolve(JSContext* cx, JS::HandleObject obj, JS::HandleId id, boo
 
     auto sname = idw.toStringData(&jsstr);
 
-    if (!holder->_readOnly && holder->_removed.find(sname.toString()) != holder->_removed.end()) {
+    if (!holder->_readOnly && !holder->_removed.empty() &&
+        holder->_removed.find(sname.toString()) != holder->_removed.end()) {
         return;
     }
 
     ObjectWrapper o(cx, obj);
 
-    if (holder->_obj.hasField(sname)) {
-        auto elem = holder->_obj[sname];
+    // Look the field up with a single scan of the object, since resolving every field of a wide
+    // document is already quadratic in its number of fields.
+    auto elem = holder->_obj.getField(sname);
 
+    if (!elem.eoo()) {
         JS::RootedValue vp(cx);
 
         ValueReader(cx, &vp).fromBSONElement(elem, holder->getOwner(), holder->_readOnly);
@@ -34,6 +34,8 @@
 
 #include "mongo/shell/bench.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <pcrecpp.h>
 
@@ -42,6 +44,8 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
+#include "mongo/platform/bits.h"
+#include "mongo/platform/random.h"
 #include "mongo/scripting/bson_template_evaluator.h"
 #include "mongo/scripting/engine.h"
 #include "mongo/stdx/thread.h"
@@ -91,6 +95,71 @@ const std::map<OpType, std::string> opTypeName{{OpType::NONE, "none"},
                                                {OpType::DROPINDEX, "dropIndex"},
                                                {OpType::LET, "let"}};
 
+BenchRunLatencyHistogram::BenchRunLatencyHistogram() {
+    reset();
+}
+
+void BenchRunLatencyHistogram::reset() {
+    _buckets.fill(0);
+    _count = 0;
+    _max = 0;
+}
+
+void BenchRunLatencyHistogram::updateFrom(const BenchRunLatencyHistogram& other) {
+    for (int i = 0; i < kNumBuckets; ++i)
+        _buckets[i] += other._buckets[i];
+    _count += other._count;
+    _max = std::max(_max, other._max);
+}
+
+void BenchRunLatencyHistogram::record(long long micros) {
+    micros = std::max(micros, 0LL);
+    ++_buckets[_bucketFor(micros)];
+    ++_count;
+    _max = std::max(_max, micros);
+}
+
+int BenchRunLatencyHistogram::_bucketFor(long long micros) {
+    if (micros < kSubBuckets)
+        return micros;
+    const int magnitude =
+        std::min(63 - countLeadingZeros64(micros), static_cast<int>(kMaxMagnitude) - 1);
+    const int shift = magnitude - kSubBucketBits;
+    const int subBucket = std::min(micros >> shift, 2LL * kSubBuckets - 1) - kSubBuckets;
+    return kSubBuckets + shift * kSubBuckets + subBucket;
+}
+
+long long BenchRunLatencyHistogram::_bucketUpperBound(int bucket) {
+    if (bucket < kSubBuckets)
+        return bucket;
+    const int shift = (bucket - kSubBuckets) / kSubBuckets;
+    const long long subBucket = (bucket - kSubBuckets) % kSubBuckets;
+    return ((kSubBuckets + subBucket + 1) << shift) - 1;
+}
+
+long long BenchRunLatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (_count == 0)
+        return 0;
+    const auto target = std::max(
+        1ULL, static_cast<unsigned long long>(std::ceil(percentile / 100.0 * _count)));
+    unsigned long long seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        seen += _buckets[i];
+        if (seen >= target)
+            return std::min(_bucketUpperBound(i), _max);
+    }
+    return _max;
+}
+
+void BenchRunLatencyHistogram::appendPercentiles(BSONObjBuilder* builder) const {
+    builder->append("p50", getValueAtPercentile(50));
+    builder->append("p90", getValueAtPercentile(90));
+    builder->append("p95", getValueAtPercentile(95));
+    builder->append("p99", getValueAtPercentile(99));
+    builder->append("p999", getValueAtPercentile(99.9));
+    builder->append("max", _max);
+}
+
 BenchRunEventCounter::BenchRunEventCounter() {
     reset();
 }
@@ -100,11 +169,13 @@ BenchRunEventCounter::~BenchRunEventCounter() {}
 void BenchRunEventCounter::reset() {
     _numEvents = 0;
     _totalTimeMicros = 0;
+    _latencies.reset();
 }
 
 void BenchRunEventCounter::updateFrom(const BenchRunEventCounter& other) {
     _numEvents += other._numEvents;
     _totalTimeMicros += other._totalTimeMicros;
+    _latencies.updateFrom(other._latencies);
 }
 
 BenchRunStats::BenchRunStats() {
@@ -165,6 +236,10 @@ void BenchRunConfig::initializeToDefaults() {
     watchPattern.reset();
     noWatchPattern.reset();
 
+    cumulativeOpWeights.clear();
+    opsPerSecond = 0;
+    poissonArrivals = false;
+
     throwGLE = false;
     breakOnTrap = true;
     randomSeed = 1314159265358979323;
@@ -379,6 +454,11 @@ BenchRunOp opFromBson(const BSONObj& op) {
             BSONObjBuilder valBuilder;
             valBuilder.append(arg);
             myOp.value = valBuilder.obj();
+        } else if (name == "weight") {
+            uassert(40409,
+                    str::stream() << "Field 'weight' should be a non-negative number: " << arg,
+                    arg.isNumber() && arg.numberDouble() >= 0);
+            myOp.weight = arg.numberDouble();
         } else {
             uassert(34394, str::stream() << "Benchrun op has unsupported field: " << name, false);
         }
@@ -436,6 +516,15 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
                                   << typeName(arg.type()),
                     arg.isNumber());
             seconds = arg.number();
+        } else if (name == "opsPerSecond") {
+            uassert(40410,
+                    str::stream() << "Field '" << name
+                                  << "' should be a non-negative number. Type is "
+                                  << typeName(arg.type()),
+                    arg.isNumber() && arg.numberDouble() >= 0);
+            opsPerSecond = arg.numberDouble();
+        } else if (name == "poissonArrivals") {
+            poissonArrivals = arg.trueValue();
         } else if (name == "hideResults") {
             hideResults = arg.trueValue();
         } else if (name == "handleErrors") {
@@ -479,6 +568,16 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
             uassert(34376, "benchRun passed an unsupported configuration field", false);
         }
     }
+
+    auto hasWeight = [](const BenchRunOp& op) { return op.myBsonOp.hasField("weight"); };
+    if (std::any_of(ops.begin(), ops.end(), hasWeight)) {
+        double total = 0;
+        for (const auto& op : ops) {
+            total += op.weight;
+            cumulativeOpWeights.push_back(total);
+        }
+        uassert(40411, "benchRun op weights must not all be zero", total > 0);
+    }
 }
 
 DBClientBase* BenchRunConfig::createConnection() const {
@@ -683,10 +782,47 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
     unique_ptr<Scope> scope{getGlobalScriptEngine()->newScopeForCurrentThread()};
     verify(scope.get());
 
+    // With op weights, each op is picked at random instead of in sequence.
+    const auto& cumulativeWeights = _config->cumulativeOpWeights;
+    PseudoRandom opRandom(_randomSeed ^ 0x5bd1e995);
+    auto opAt = [&](size_t sequenceIndex) -> const BenchRunOp& {
+        if (cumulativeWeights.empty())
+            return _config->ops[sequenceIndex];
+        const double pick = opRandom.nextCanonicalDouble() * cumulativeWeights.back();
+        auto it = std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), pick);
+        const size_t index = it - cumulativeWeights.begin();
+        return _config->ops[std::min(index, _config->ops.size() - 1)];
+    };
+
+    // In open loop mode each thread issues its share of the requested rate on a fixed schedule,
+    // independent of how long earlier operations took.
+    const double intervalMicros =
+        _config->opsPerSecond > 0 ? 1000000.0 * _config->parallel / _config->opsPerSecond : 0;
+    const Timer scheduleTimer;
+    double nextArrivalMicros = 0;
+
     while (!shouldStop()) {
-        for (const auto& op : _config->ops) {
+        for (size_t i = 0; i < _config->ops.size(); ++i) {
             if (shouldStop())
                 break;
+            const auto& op = opAt(i);
+
+            // 'let' ops only update client side variables, so they do not take an arrival slot.
+            long long startDelayMicros = 0;
+            if (intervalMicros > 0 && op.op != OpType::LET) {
+                const auto scheduledMicros = static_cast<long long>(nextArrivalMicros);
+                long long nowMicros;
+                while ((nowMicros = scheduleTimer.micros()) < scheduledMicros && !shouldStop()) {
+                    sleepmicros(std::min(scheduledMicros - nowMicros, 100 * 1000LL));
+                }
+                if (shouldStop())
+                    break;
+                startDelayMicros = nowMicros - scheduledMicros;
+                nextArrivalMicros += _config->poissonArrivals
+                    ? -std::log(1.0 - opRandom.nextCanonicalDouble()) * intervalMicros
+                    : intervalMicros;
+            }
+
             auto& stats = shouldCollectStats() ? _stats : _statsBlackHole;
 
             ScriptingFunction scopeFunc = 0;
@@ -720,10 +856,10 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                             qr->setWantMore(false);
                             invariantOK(qr->validate());
 
-                            BenchRunEventTrace _bret(&stats.findOneCounter);
+                            BenchRunEventTrace _bret(&stats.findOneCounter, startDelayMicros);
                             runQueryWithReadCommands(conn, std::move(qr), &result);
                         } else {
-                            BenchRunEventTrace _bret(&stats.findOneCounter);
+                            BenchRunEventTrace _bret(&stats.findOneCounter, startDelayMicros);
                             result = conn->findOne(op.ns, fixedQuery);
                         }
 
@@ -746,7 +882,7 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                         bool ok;
                         BSONObj result;
                         {
-                            BenchRunEventTrace _bret(&stats.commandCounter);
+                            BenchRunEventTrace _bret(&stats.commandCounter, startDelayMicros);
                             ok = conn->runCommand(op.ns,
                                                   fixQuery(op.command, bsonTemplateEvaluator),
                                                   result,
@@ -828,17 +964,17 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                             }
                             invariantOK(qr->validate());
 
-                            BenchRunEventTrace _bret(&stats.queryCounter);
+                            BenchRunEventTrace _bret(&stats.queryCounter, startDelayMicros);
                             count = runQueryWithReadCommands(conn, std::move(qr));
                         } else {
                             // Use special query function for exhaust query option.
                             if (op.options & QueryOption_Exhaust) {
-                                BenchRunEventTrace _bret(&stats.queryCounter);
+                                BenchRunEventTrace _bret(&stats.queryCounter, startDelayMicros);
                                 stdx::function<void(const BSONObj&)> castedDoNothing(doNothing);
                                 count = conn->query(
                                     castedDoNothing, op.ns, fixedQuery, &op.projection, op.options);
                             } else {
-                                BenchRunEventTrace _bret(&stats.queryCounter);
+                                BenchRunEventTrace _bret(&stats.queryCounter, startDelayMicros);
                                 unique_ptr<DBClientCursor> cursor;
                                 cursor = conn->query(op.ns,
                                                      fixedQuery,
@@ -876,7 +1012,7 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                     case OpType::UPDATE: {
                         BSONObj result;
                         {
-                            BenchRunEventTrace _bret(&stats.updateCounter);
+                            BenchRunEventTrace _bret(&stats.updateCounter, startDelayMicros);
                             BSONObj query = fixQuery(op.query, bsonTemplateEvaluator);
                             BSONObj update = fixQuery(op.update, bsonTemplateEvaluator);
 
@@ -927,7 +1063,7 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                         BSONObj result;
 
                         {
-                            BenchRunEventTrace _bret(&stats.insertCounter);
+                            BenchRunEventTrace _bret(&stats.insertCounter, startDelayMicros);
 
                             BSONObj insertDoc;
                             if (op.useWriteCmd) {
@@ -992,7 +1128,7 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                     case OpType::REMOVE: {
                         BSONObj result;
                         {
-                            BenchRunEventTrace _bret(&stats.deleteCounter);
+                            BenchRunEventTrace _bret(&stats.deleteCounter, startDelayMicros);
                             BSONObj predicate = fixQuery(op.query, bsonTemplateEvaluator);
                             if (op.useWriteCmd) {
                                 // TODO: Replace after SERVER-11774.
@@ -1244,6 +1380,15 @@ static void appendAverageMicrosIfAvailable(BSONObjBuilder& buf,
                    static_cast<double>(counter.getTotalTimeMicros()) / counter.getNumEvents());
 }
 
+static void appendPercentileMicrosIfAvailable(BSONObjBuilder& buf,
+                                              StringData name,
+                                              const BenchRunEventCounter& counter) {
+    if (counter.getNumEvents() > 0) {
+        BSONObjBuilder percentiles(buf.subobjStart(name));
+        counter.getLatencies().appendPercentiles(&percentiles);
+    }
+}
+
 BSONObj BenchRunner::finish(BenchRunner* runner) {
     runner->stop();
 
@@ -1267,6 +1412,14 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     appendAverageMicrosIfAvailable(buf, "queryLatencyAverageMicros", stats.queryCounter);
     appendAverageMicrosIfAvailable(buf, "commandsLatencyAverageMicros", stats.commandCounter);
 
+    appendPercentileMicrosIfAvailable(buf, "findOneLatencyPercentilesMicros", stats.findOneCounter);
+    appendPercentileMicrosIfAvailable(buf, "insertLatencyPercentilesMicros", stats.insertCounter);
+    appendPercentileMicrosIfAvailable(buf, "deleteLatencyPercentilesMicros", stats.deleteCounter);
+    appendPercentileMicrosIfAvailable(buf, "updateLatencyPercentilesMicros", stats.updateCounter);
+    appendPercentileMicrosIfAvailable(buf, "queryLatencyPercentilesMicros", stats.queryCounter);
+    appendPercentileMicrosIfAvailable(
+        buf, "commandsLatencyPercentilesMicros", stats.commandCounter);
+
     buf.append("totalOps", static_cast<long long>(stats.opCount));
 
     auto appendPerSec = [&buf, runner](StringData name, double total) {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include "mongo/client/dbclientinterface.h"
@@ -92,6 +93,7 @@ public:
     bool useWriteCmd = false;
     BSONObj writeConcern;
     BSONObj value;
+    double weight = 1.0;
 
     // This is an owned copy of the raw operation. All unowned members point into this.
     BSONObj myBsonOp;
@@ -176,6 +178,28 @@ public:
      */
     std::vector<BenchRunOp> ops;
 
+    /**
+     * Running sums of the 'weight' of each op, filled in when any op sets a weight. When set,
+     * each thread picks its next op at random in proportion to these weights instead of
+     * cycling through "ops" in order, which allows modeling mixed read/write ratios.
+     */
+    std::vector<double> cumulativeOpWeights;
+
+    /**
+     * Target rate of operations across all threads. When zero, each thread issues its next
+     * operation as soon as the previous one completes (closed loop). Otherwise operations are
+     * scheduled at this rate regardless of how long they take (open loop), and latencies are
+     * measured from the scheduled start so that a slow server is not hidden by a throttled
+     * client.
+     */
+    double opsPerSecond;
+
+    /**
+     * With opsPerSecond set, draw the time between operations from an exponential distribution
+     * (Poisson arrivals) rather than using a fixed interval.
+     */
+    bool poissonArrivals;
+
     bool throwGLE;
     bool breakOnTrap;
 
@@ -184,6 +208,53 @@ private:
     void initializeToDefaults();
 };
 
+/**
+ * A latency histogram in the style of HdrHistogram. Each power of two is split into
+ * kSubBuckets linear buckets, so any recorded value is reported to within 1/kSubBuckets of its
+ * true value over the whole range, without the caller having to pick bucket boundaries.
+ *
+ * Not thread safe.
+ */
+class BenchRunLatencyHistogram {
+public:
+    static const int kSubBucketBits = 4;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    // Values of 2^kMaxMagnitude microseconds (about 12 days) and above share the last bucket.
+    static const int kMaxMagnitude = 40;
+    static const int kNumBuckets = kSubBuckets + (kMaxMagnitude - kSubBucketBits) * kSubBuckets;
+
+    BenchRunLatencyHistogram();
+
+    void reset();
+
+    void updateFrom(const BenchRunLatencyHistogram& other);
+
+    void record(long long micros);
+
+    unsigned long long getCount() const {
+        return _count;
+    }
+
+    /**
+     * Returns the smallest recorded value such that "percentile" percent of all values are less
+     * than or equal to it, rounded up to the end of its bucket.
+     */
+    long long getValueAtPercentile(double percentile) const;
+
+    /**
+     * Appends the standard set of percentiles (p50, p90, p95, p99 and p999) and the max.
+     */
+    void appendPercentiles(BSONObjBuilder* builder) const;
+
+private:
+    static int _bucketFor(long long micros);
+    static long long _bucketUpperBound(int bucket);
+
+    std::array<unsigned long long, kNumBuckets> _buckets;
+    unsigned long long _count;
+    long long _max;
+};
+
 /**
  * An event counter for events that have an associated duration.
  *
@@ -213,6 +284,7 @@ public:
     void countOne(long long timeMicros) {
         ++_numEvents;
         _totalTimeMicros += timeMicros;
+        _latencies.record(timeMicros);
     }
 
     /**
@@ -229,9 +301,17 @@ public:
         return _numEvents;
     }
 
+    /**
+     * Get the distribution of the observed event durations.
+     */
+    const BenchRunLatencyHistogram& getLatencies() const {
+        return _latencies;
+    }
+
 private:
     unsigned long long _numEvents;
     long long _totalTimeMicros;
+    BenchRunLatencyHistogram _latencies;
 };
 
 /**
@@ -245,13 +325,18 @@ private:
  * the end of a successful event. If an exception is thrown, the fail counter will receive the
  * event, and otherwise, the succes counter will.
  *
+ * A trace may also be given the number of microseconds by which the event started late with
+ * respect to its schedule. That delay is added to the recorded duration, so that open loop
+ * runs report the latency a client arriving on time would have seen.
+ *
  * In all cases, the counter objects must outlive the trace object.
  */
 class BenchRunEventTrace {
     MONGO_DISALLOW_COPYING(BenchRunEventTrace);
 
 public:
-    explicit BenchRunEventTrace(BenchRunEventCounter* eventCounter) {
+    explicit BenchRunEventTrace(BenchRunEventCounter* eventCounter, long long startDelayMicros = 0)
+        : _startDelayMicros(startDelayMicros) {
         initialize(eventCounter, eventCounter, false);
     }
 
@@ -262,7 +347,8 @@ public:
     }
 
     ~BenchRunEventTrace() {
-        (_succeeded ? _successCounter : _failCounter)->countOne(_timer.micros());
+        auto counter = _succeeded ? _successCounter : _failCounter;
+        counter->countOne(_startDelayMicros + _timer.micros());
     }
 
     void succeed() {
@@ -282,6 +368,7 @@ private:
     }
 
     Timer _timer;
+    long long _startDelayMicros = 0;
     BenchRunEventCounter* _successCounter;
     BenchRunEventCounter* _failCounter;
     bool _succeeded;
@@ -795,9 +795,13 @@ var DB;
         });
     };
 
-    DB.prototype._getCollectionInfosCommand = function(filter) {
+    DB.prototype._getCollectionInfosCommand = function(filter, nameOnly) {
         filter = filter || {};
-        var res = this.runCommand({listCollections: 1, filter: filter});
+        var cmd = {listCollections: 1, filter: filter};
+        if (nameOnly) {
+            cmd.nameOnly = true;
+        }
+        var res = this.runCommand(cmd);
         if (res.code == 59) {
             // command doesn't exist, old mongod
             return null;
@@ -817,10 +821,11 @@ var DB;
     /**
      * Returns a list that contains the names and options of this database's collections, sorted by
      * collection name. An optional filter can be specified to match only collections with certain
-     * metadata.
+     * metadata. If 'nameOnly' is true, servers that support it return only the name and type of
+     * each collection.
      */
-    DB.prototype.getCollectionInfos = function(filter) {
-        var res = this._getCollectionInfosCommand(filter);
+    DB.prototype.getCollectionInfos = function(filter, nameOnly) {
+        var res = this._getCollectionInfosCommand(filter, nameOnly);
         if (res) {
             return res;
         }
@@ -831,7 +836,7 @@ var DB;
      * Returns this database's list of collection names in sorted order.
      */
     DB.prototype.getCollectionNames = function() {
-        return this.getCollectionInfos().map(function(infoObj) {
+        return this.getCollectionInfos({}, true).map(function(infoObj) {
             return infoObj.name;
         });
     };
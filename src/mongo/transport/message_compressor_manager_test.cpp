@@ -33,9 +33,11 @@
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/net/message.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -182,5 +184,30 @@ TEST(SnappyMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<NoopMessageCompressor>());
 }
 
+TEST(ZlibMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
+}
+
+TEST(ZlibMessageCompressor, DecompressReportsBytesWritten) {
+    ZlibMessageCompressor compressor;
+    const auto data = std::string{"Hello, world!"};
+
+    std::vector<char> compressed(compressor.getMaxCompressedSize(data.size()));
+    auto swCompressed = compressor.compressData(ConstDataRange(data.data(), data.size()),
+                                                DataRange(compressed.data(), compressed.size()));
+    ASSERT_OK(swCompressed.getStatus());
+
+    // The output buffer is larger than the decompressed data, which must not be counted.
+    std::vector<char> output(data.size() * 2);
+    auto swDecompressed =
+        compressor.decompressData(ConstDataRange(compressed.data(), swCompressed.getValue()),
+                                  DataRange(output.data(), output.size()));
+    ASSERT_OK(swDecompressed.getStatus());
+    ASSERT_EQ(data.size(), swDecompressed.getValue());
+    ASSERT_EQ(static_cast<int64_t>(data.size()), compressor.getDecompressedBytesOut());
+    ASSERT_EQ(0, memcmp(output.data(), data.data(), data.size()));
+}
+
 }  // namespace mongo
 }  // namespace
@@ -34,14 +34,21 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/session.h"
+#include "mongo/transport/ticket.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_exception.h"
+#include "mongo/util/net/thread_idle_callback.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/scopeguard.h"
 
 #ifdef __linux__  // TODO: consider making this ifndef _WIN32
 #include <sys/resource.h>
@@ -67,6 +74,14 @@ struct Context {
     stdx::function<void(const transport::SessionHandle&)> task;
 };
 
+void logEndConnection(transport::TransportLayer* tl, const transport::SessionHandle& session) {
+    if (!serverGlobalParams.quiet.load()) {
+        auto conns = tl->sessionStats().numOpenSessions;
+        const char* word = (conns == 1 ? " connection" : " connections");
+        log() << "end connection " << session->remote() << " (" << conns << word << " now open)";
+    }
+}
+
 void* runFunc(void* ptr) {
     std::unique_ptr<Context> ctx(static_cast<Context*>(ptr));
 
@@ -89,18 +104,156 @@ void* runFunc(void* ptr) {
     }
 
     tl->end(ctx->session);
-
-    if (!serverGlobalParams.quiet.load()) {
-        auto conns = tl->sessionStats().numOpenSessions;
-        const char* word = (conns == 1 ? " connection" : " connections");
-        log() << "end connection " << ctx->session->remote() << " (" << conns << word
-              << " now open)";
-    }
+    logEndConnection(tl, ctx->session);
 
     Client::destroy();
 
     return nullptr;
 }
+
+/**
+ * Runs the requests of sessions driven by launchAsyncServiceEntrySession(). Handling a request may
+ * block for a long time, on locks, awaitData getMores or other operations, so it must not happen on
+ * the transport layer's fixed set of network threads. This pool grows by one thread whenever a
+ * request arrives while all of its threads are busy, up to one thread per allowed connection, which
+ * is never more than thread-per-connection would use. Idle threads are reaped.
+ */
+ThreadPool* getRequestExecutorPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "ServiceEntryRequests";
+        options.threadNamePrefix = "conn-worker-";
+        options.minThreads = 0;
+        options.maxThreads = std::max(1, serverGlobalParams.maxConns);
+        // Intentionally leaked, since requests may still be running at process exit.
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+/**
+ * The state of a Session run by launchAsyncServiceEntrySession(). Each step of the
+ * source-handle-sink loop holds a reference to it, and the Session ends when it is destroyed.
+ */
+class AsyncSessionState : public std::enable_shared_from_this<AsyncSessionState> {
+    MONGO_DISALLOW_COPYING(AsyncSessionState);
+
+public:
+    AsyncSessionState(transport::SessionHandle session, ServiceEntryRequestHandler handler)
+        : _session(std::move(session)),
+          _handler(std::move(handler)),
+          _client(getGlobalServiceContext()->makeClient(
+              str::stream() << "conn" << _session->id(), _session)) {}
+
+    ~AsyncSessionState() {
+        auto tl = _session->getTransportLayer();
+        tl->end(_session);
+        logEndConnection(tl, _session);
+    }
+
+    /**
+     * Sources the next Message, or handles the current one again if we are exhausting a cursor.
+     */
+    void sourceNext() {
+        if (_inExhaust) {
+            return scheduleRequest();
+        }
+
+        _request.reset();
+        auto self = shared_from_this();
+        _session->sourceMessage(&_request).asyncWait([self](Status status) {
+            if (ErrorCodes::isInterruption(status.code()) ||
+                ErrorCodes::isNetworkError(status.code()) ||
+                status == transport::TransportLayer::TicketSessionClosedStatus) {
+                return;
+            }
+
+            if (!status.isOK()) {
+                log() << "Error receiving request from client, closing client connection: "
+                      << status;
+                return;
+            }
+
+            self->scheduleRequest();
+        });
+    }
+
+private:
+    /**
+     * Hands the current request to the request executor pool, leaving the network thread which
+     * received it free to serve other sessions.
+     */
+    void scheduleRequest() {
+        auto self = shared_from_this();
+        Status status = getRequestExecutorPool()->schedule([self] { self->handleRequest(); });
+        if (!status.isOK()) {
+            log() << "Unable to schedule request, closing client connection: " << status;
+        }
+    }
+
+    void handleRequest() {
+        const std::string workerName = getThreadName();
+        Client::setCurrent(std::move(_client));
+        ON_BLOCK_EXIT([&] {
+            _client = Client::releaseCurrent();
+            setThreadName(workerName);
+        });
+
+        try {
+            _response = _handler(_session, &_request, &_inExhaust);
+        } catch (const AssertionException& e) {
+            log() << "AssertionException handling request, closing client connection: " << e;
+            return;
+        } catch (const SocketException& e) {
+            log() << "SocketException handling request, closing client connection: " << e;
+            return;
+        } catch (const DBException& e) {
+            // must be right above std::exception to avoid catching subclasses
+            log() << "DBException handling request, closing client connection: " << e;
+            return;
+        } catch (const std::exception& e) {
+            error() << "Uncaught std::exception: " << e.what() << ", terminating";
+            quickExit(EXIT_UNCAUGHT);
+        }
+
+        if ((_counter++ & 0xf) == 0) {
+            markThreadIdle();
+        }
+
+        if (_response.empty()) {
+            return sourceNext();
+        }
+
+        auto self = shared_from_this();
+        _session->sinkMessage(_response).asyncWait([self](Status status) {
+            self->_response.reset();
+            if (!status.isOK()) {
+                if (!ErrorCodes::isNetworkError(status.code()) &&
+                    status != transport::TransportLayer::TicketSessionClosedStatus) {
+                    log() << "Error sending response to client, closing client connection: "
+                          << status;
+                }
+                return;
+            }
+
+            self->sourceNext();
+        });
+    }
+
+    const transport::SessionHandle _session;
+    const ServiceEntryRequestHandler _handler;
+
+    // The Client for this session, which is only attached to a thread while handling a request.
+    ServiceContext::UniqueClient _client;
+
+    Message _request;
+    Message _response;
+    bool _inExhaust = false;
+    int64_t _counter = 0;
+};
+
 }  // namespace
 
 void launchWrappedServiceEntryWorkerThread(
@@ -155,4 +308,10 @@ void launchWrappedServiceEntryWorkerThread(
     }
 }
 
+void launchAsyncServiceEntrySession(transport::SessionHandle session,
+                                    ServiceEntryRequestHandler handler) {
+    auto state = std::make_shared<AsyncSessionState>(std::move(session), std::move(handler));
+    state->sourceNext();
+}
+
 }  // namespace mongo
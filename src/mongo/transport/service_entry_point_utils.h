@@ -30,10 +30,31 @@
 
 #include "mongo/stdx/functional.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/net/message.h"
 
 namespace mongo {
 
 void launchWrappedServiceEntryWorkerThread(
     transport::SessionHandle session, stdx::function<void(const transport::SessionHandle&)> task);
 
+/**
+ * Handles a single request sourced from a Session, on a thread which has the Session's Client
+ * attached, and returns the reply to sink to the client (which may be empty).
+ *
+ * If the handler sets '*inExhaust' to true, it has replaced 'request' with the next request to
+ * handle (for exhaust cursors) and no new Message is sourced before calling it again.
+ */
+using ServiceEntryRequestHandler = stdx::function<Message(
+    const transport::SessionHandle& session, Message* request, bool* inExhaust)>;
+
+/**
+ * Runs 'session' without dedicating a thread to it. Sourcing and sinking Messages is done through
+ * TransportLayer::asyncWait(). 'handler' may block, so it is not run on the thread completing the
+ * source but on a pool that grows with the number of requests in progress, with the Session's
+ * Client attached to that thread for the duration of the call. Requires a TransportLayer which
+ * implements asyncWait(). This method returns immediately.
+ */
+void launchAsyncServiceEntrySession(transport::SessionHandle session,
+                                    ServiceEntryRequestHandler handler);
+
 }  // namespace mongo
@@ -0,0 +1,596 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/base/init.h"
+#include "mongo/config.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/abstract_message_port.h"
+#include "mongo/util/net/ssl_options.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+const char kTransportLayerASIO[] = "asio";
+const char kTransportLayerLegacy[] = "legacy";
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayer, std::string, kTransportLayerLegacy);
+
+// Number of threads servicing the sessions of the asio transport layer. The default of 0 sizes
+// the pool to the number of cores on the machine.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOWorkerThreads, int, 0);
+
+MONGO_INITIALIZER(transportLayer)(InitializerContext*) {
+    if ((transportLayer != kTransportLayerASIO) && (transportLayer != kTransportLayerLegacy)) {
+        return Status(ErrorCodes::BadValue, "unsupported transport layer option: " + transportLayer);
+    }
+    if (transportLayerASIOWorkerThreads < 0) {
+        return Status(ErrorCodes::BadValue,
+                      "transportLayerASIOWorkerThreads must be greater than or equal to 0");
+    }
+    return Status::OK();
+}
+
+const size_t kHeaderSize = sizeof(MSGHEADER::Value);
+
+Status asioErrorToStatus(const asio::error_code& ec) {
+    if (ec == asio::error::operation_aborted) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+    if (ec == asio::error::misc_errors::eof) {
+        return {ErrorCodes::HostUnreachable, "Connection closed by peer"};
+    }
+    return {ErrorCodes::HostUnreachable, ec.message()};
+}
+
+}  // namespace
+
+bool isTransportLayerASIOEnabled() {
+    return transportLayer == kTransportLayerASIO;
+}
+
+/**
+ * A TicketImpl implementation for this TransportLayer. A ticket can be filled either
+ * synchronously, by the thread calling wait(), or asynchronously on the session's strand.
+ */
+class TransportLayerASIO::ASIOTicket : public TicketImpl {
+    MONGO_DISALLOW_COPYING(ASIOTicket);
+
+public:
+    ASIOTicket(const ASIOSessionHandle& session, Date_t expiration)
+        : _session(session), _sessionId(session->id()), _expiration(expiration) {}
+
+    SessionId sessionId() const override {
+        return _sessionId;
+    }
+
+    Date_t expiration() const override {
+        return _expiration;
+    }
+
+    /**
+     * If this ticket's session is still alive, return a shared_ptr. Otherwise, return nullptr.
+     */
+    ASIOSessionHandle getSession() const {
+        return _session.lock();
+    }
+
+    /**
+     * Performs this ticket's work with blocking socket operations.
+     */
+    virtual Status fill(ASIOSession* session) = 0;
+
+    /**
+     * Starts this ticket's work on the session's strand and returns immediately. 'callback' will
+     * be invoked on the session's strand once the work is done. The ticket must be kept alive
+     * until then.
+     */
+    virtual void fillAsync(const ASIOSessionHandle& session, TicketCallback callback) = 0;
+
+private:
+    std::weak_ptr<ASIOSession> _session;
+
+    SessionId _sessionId;
+    Date_t _expiration;
+};
+
+class TransportLayerASIO::ASIOSourceTicket final : public TransportLayerASIO::ASIOTicket {
+public:
+    ASIOSourceTicket(const ASIOSessionHandle& session, Date_t expiration, Message* target)
+        : ASIOTicket(session, expiration),
+          _target(target),
+          _compressorMgr(MessageCompressorManager::forSession(session)) {}
+
+    Status fill(ASIOSession* session) override {
+        asio::error_code ec;
+        _buffer = session->recvBuffer().get(kHeaderSize);
+        asio::read(session->socket(), asio::buffer(_buffer.get(), kHeaderSize), ec);
+        if (ec) {
+            return asioErrorToStatus(ec);
+        }
+
+        auto swBodySize = _validateHeader(session);
+        if (!swBodySize.isOK()) {
+            return swBodySize.getStatus();
+        }
+
+        asio::read(session->socket(),
+                   asio::buffer(_buffer.get() + kHeaderSize, swBodySize.getValue()),
+                   ec);
+        if (ec) {
+            return asioErrorToStatus(ec);
+        }
+
+        return _finish();
+    }
+
+    void fillAsync(const ASIOSessionHandle& session, TicketCallback callback) override {
+        _buffer = session->recvBuffer().get(kHeaderSize);
+        asio::async_read(
+            session->socket(),
+            asio::buffer(_buffer.get(), kHeaderSize),
+            session->strand().wrap(
+                [this, session, callback](const asio::error_code& ec, size_t) {
+                    if (ec) {
+                        return callback(asioErrorToStatus(ec));
+                    }
+
+                    auto swBodySize = _validateHeader(session.get());
+                    if (!swBodySize.isOK()) {
+                        return callback(swBodySize.getStatus());
+                    }
+
+                    asio::async_read(
+                        session->socket(),
+                        asio::buffer(_buffer.get() + kHeaderSize, swBodySize.getValue()),
+                        session->strand().wrap(
+                            [this, callback](const asio::error_code& ec, size_t) {
+                                if (ec) {
+                                    return callback(asioErrorToStatus(ec));
+                                }
+                                callback(_finish());
+                            }));
+                }));
+    }
+
+private:
+    /**
+     * Checks the length in the received header and grows the buffer to fit the whole message.
+     * Returns the number of bytes remaining to be read.
+     */
+    StatusWith<size_t> _validateHeader(ASIOSession* session) {
+        const int msgLen = MsgData::ConstView(_buffer.get()).getLen();
+        if (static_cast<size_t>(msgLen) < kHeaderSize ||
+            static_cast<size_t>(msgLen) > MaxMessageSizeBytes) {
+            return Status(ErrorCodes::ProtocolError,
+                          str::stream() << "recv(): message len " << msgLen << " is invalid. "
+                                        << "Min: " << kHeaderSize
+                                        << ", Max: " << MaxMessageSizeBytes);
+        }
+
+        // Let go of the buffer holding the header first, so that the session's buffer can be
+        // handed out again if it is large enough for the whole message.
+        char header[kHeaderSize];
+        memcpy(header, _buffer.get(), kHeaderSize);
+        _buffer = SharedBuffer();
+        _buffer = session->recvBuffer().get(msgLen);
+        memcpy(_buffer.get(), header, kHeaderSize);
+        return msgLen - kHeaderSize;
+    }
+
+    Status _finish() {
+        _target->setData(std::move(_buffer));
+        networkCounter.hitPhysical(_target->size(), 0);
+        if (_target->operation() == dbCompressed) {
+            auto swm = _compressorMgr.decompressMessage(*_target);
+            if (!swm.isOK()) {
+                return swm.getStatus();
+            }
+            *_target = std::move(swm.getValue());
+        }
+        networkCounter.hitLogical(_target->size(), 0);
+        return Status::OK();
+    }
+
+    Message* const _target;
+    MessageCompressorManager& _compressorMgr;
+    SharedBuffer _buffer;
+};
+
+class TransportLayerASIO::ASIOSinkTicket final : public TransportLayerASIO::ASIOTicket {
+public:
+    ASIOSinkTicket(const ASIOSessionHandle& session, Date_t expiration, const Message& msg)
+        : ASIOTicket(session, expiration),
+          _msg(msg),
+          _compressorMgr(MessageCompressorManager::forSession(session)) {}
+
+    Status fill(ASIOSession* session) override {
+        auto status = _prepare();
+        if (!status.isOK()) {
+            return status;
+        }
+
+        asio::error_code ec;
+        asio::write(session->socket(), asio::buffer(_toSend.buf(), _toSend.size()), ec);
+        if (ec) {
+            return asioErrorToStatus(ec);
+        }
+
+        networkCounter.hitPhysical(0, _toSend.size());
+        return Status::OK();
+    }
+
+    void fillAsync(const ASIOSessionHandle& session, TicketCallback callback) override {
+        auto status = _prepare();
+        if (!status.isOK()) {
+            return callback(status);
+        }
+
+        asio::async_write(session->socket(),
+                          asio::buffer(_toSend.buf(), _toSend.size()),
+                          session->strand().wrap([this, callback](const asio::error_code& ec,
+                                                                  size_t) {
+                              if (ec) {
+                                  return callback(asioErrorToStatus(ec));
+                              }
+                              networkCounter.hitPhysical(0, _toSend.size());
+                              callback(Status::OK());
+                          }));
+    }
+
+private:
+    Status _prepare() {
+        networkCounter.hitLogical(0, _msg.size());
+        auto swm = _compressorMgr.compressMessage(_msg);
+        if (!swm.isOK()) {
+            return swm.getStatus();
+        }
+        _toSend = std::move(swm.getValue());
+        return Status::OK();
+    }
+
+    const Message& _msg;
+    MessageCompressorManager& _compressorMgr;
+    Message _toSend;
+};
+
+TransportLayerASIO::ListenerASIO::ListenerASIO(const Options& opts, TransportLayerASIO* tl)
+    : Listener("", opts.ipList, opts.port, getGlobalServiceContext(), true), _tl(tl) {}
+
+void TransportLayerASIO::ListenerASIO::accepted(std::unique_ptr<AbstractMessagingPort> mp) {
+    // Connections are taken over in _accepted(), before they get wrapped in a messaging port.
+    MONGO_UNREACHABLE;
+}
+
+void TransportLayerASIO::ListenerASIO::_accepted(const std::shared_ptr<Socket>& psocket,
+                                                 long long connectionId) {
+    const auto remote = psocket->remoteAddr();
+    const auto local = psocket->localAddr();
+    _tl->_handleNewConnection(psocket->stealSD(), remote, local, connectionId);
+}
+
+TransportLayerASIO::ASIOSession::ASIOSession(TransportLayerASIO* tl,
+                                             int fd,
+                                             const SockAddr& remote,
+                                             const SockAddr& local,
+                                             long long connectionId)
+    : _tl(tl),
+      _remote(remote.getAddr(), remote.getPort()),
+      _local(local.toString(true)),
+      _connectionId(connectionId),
+      _socket(tl->_ioService,
+              asio::generic::stream_protocol(remote.getType(),
+                                             remote.getType() == AF_UNIX ? 0 : IPPROTO_TCP),
+              fd),
+      _strand(tl->_ioService) {}
+
+TransportLayerASIO::ASIOSession::~ASIOSession() {
+    _tl->_destroy(*this);
+}
+
+void TransportLayerASIO::ASIOSession::closeSocket() {
+    if (!_socket.is_open()) {
+        return;
+    }
+
+    asio::error_code ec;
+    _socket.shutdown(asio::generic::stream_protocol::socket::shutdown_both, ec);
+    _socket.close(ec);
+}
+
+void TransportLayerASIO::ASIOSession::end() {
+    if (_closed.swap(true)) {
+        return;
+    }
+
+    _tl->_releaseConnection(*this);
+
+    // Closing the socket on the strand cancels any pending asynchronous operation without racing
+    // with it.
+    auto self = shared_from_this();
+    _strand.post([self, this] { closeSocket(); });
+}
+
+TransportLayerASIO::TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep)
+    : _sep(sep),
+      _options(opts),
+      _listener(stdx::make_unique<ListenerASIO>(opts, this)) {}
+
+TransportLayerASIO::~TransportLayerASIO() = default;
+
+Status TransportLayerASIO::setup() {
+#ifdef MONGO_CONFIG_SSL
+    if (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled) {
+        return {ErrorCodes::BadValue,
+                "The asio transport layer does not support SSL, use transportLayer=legacy"};
+    }
+#endif
+
+    if (!_listener->setupSockets()) {
+        error() << "Failed to set up sockets during startup.";
+        return {ErrorCodes::InternalError, "Failed to set up sockets"};
+    }
+
+    return Status::OK();
+}
+
+Status TransportLayerASIO::start() {
+    if (_running.swap(true)) {
+        return {ErrorCodes::InternalError, "TransportLayer is already running"};
+    }
+
+    size_t numWorkers = _options.numWorkerThreads;
+    if (numWorkers == 0) {
+        numWorkers = transportLayerASIOWorkerThreads;
+    }
+    if (numWorkers == 0) {
+        numWorkers = ProcessInfo().getNumCores();
+    }
+
+    _ioServiceWork = stdx::make_unique<asio::io_service::work>(_ioService);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this, i] {
+            setThreadName(str::stream() << "transportWorker" << i);
+            while (true) {
+                try {
+                    _ioService.run();
+                    return;
+                } catch (...) {
+                    // Errors are translated into Statuses for the callbacks, so anything escaping
+                    // here is a bug in a callback. Keep the worker alive rather than shrinking
+                    // the pool.
+                    error() << "Uncaught exception in transport layer worker: "
+                            << exceptionToStatus();
+                }
+            }
+        });
+    }
+
+    log() << "Started " << numWorkers << " transport layer worker threads";
+
+    _listenerThread = stdx::thread([this]() { _listener->initAndListen(); });
+
+    return Status::OK();
+}
+
+Ticket TransportLayerASIO::sourceMessage(const SessionHandle& session,
+                                         Message* message,
+                                         Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this, stdx::make_unique<ASIOSourceTicket>(asioSession, expiration, message));
+}
+
+Ticket TransportLayerASIO::sinkMessage(const SessionHandle& session,
+                                       const Message& message,
+                                       Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this, stdx::make_unique<ASIOSinkTicket>(asioSession, expiration, message));
+}
+
+StatusWith<TransportLayerASIO::ASIOSessionHandle> TransportLayerASIO::_prepareTicket(
+    ASIOTicket* ticket) {
+    if (!_running.load()) {
+        return TransportLayer::ShutdownStatus;
+    }
+
+    if (ticket->expiration() < Date_t::now()) {
+        return Ticket::ExpiredStatus;
+    }
+
+    auto session = ticket->getSession();
+    if (!session || session->isClosed()) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+
+    return std::move(session);
+}
+
+Status TransportLayerASIO::wait(Ticket&& ticket) {
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+    auto swSession = _prepareTicket(asioTicket);
+    if (!swSession.isOK()) {
+        return swSession.getStatus();
+    }
+
+    try {
+        return asioTicket->fill(swSession.getValue().get());
+    } catch (...) {
+        return exceptionToStatus();
+    }
+}
+
+void TransportLayerASIO::asyncWait(Ticket&& ticket, TicketCallback callback) {
+    // The ticket has to outlive the asynchronous operation, so it is owned by the callback.
+    auto ownedTicket = std::make_shared<Ticket>(std::move(ticket));
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(*ownedTicket));
+
+    auto swSession = _prepareTicket(asioTicket);
+    if (!swSession.isOK()) {
+        // Never invoke the callback on the caller's stack.
+        auto status = swSession.getStatus();
+        _ioService.post([callback, status] { callback(status); });
+        return;
+    }
+
+    auto session = std::move(swSession.getValue());
+    session->strand().dispatch([ownedTicket, asioTicket, session, callback] {
+        asioTicket->fillAsync(session,
+                              [ownedTicket, callback](Status status) { callback(status); });
+    });
+}
+
+TransportLayer::Stats TransportLayerASIO::sessionStats() {
+    Stats stats;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        stats.numOpenSessions = _sessions.size();
+    }
+
+    stats.numAvailableSessions = Listener::globalTicketHolder.available();
+    stats.numCreatedSessions = Listener::globalConnectionNumber.load();
+
+    return stats;
+}
+
+void TransportLayerASIO::end(const SessionHandle& session) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    asioSession->end();
+}
+
+// Capture all of the weak pointers behind the lock, to delay their expiry until we leave the
+// locking context.
+auto TransportLayerASIO::_lockAllSessions() const -> std::vector<ASIOSessionHandle> {
+    std::vector<ASIOSessionHandle> result;
+    stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+    for (auto&& weakSession : _sessions) {
+        if (auto session = weakSession.lock()) {
+            result.push_back(std::move(session));
+        }
+    }
+    return result;
+}
+
+void TransportLayerASIO::endAllSessions(Session::TagMask tags) {
+    log() << "asio transport layer closing all connections";
+
+    // The sessions are ended outside of the lock, since dropping the last reference to one
+    // takes the lock again to remove it from the list.
+    for (auto&& session : _lockAllSessions()) {
+        if (session->getTags() & tags) {
+            log() << "Skip closing connection for connection # " << session->connectionId();
+        } else {
+            session->end();
+        }
+    }
+}
+
+void TransportLayerASIO::shutdown() {
+    _running.store(false);
+    _listener->shutdown();
+    _listenerThread.join();
+    endAllSessions(Session::kEmptyTagMask);
+
+    // Let the workers finish the callbacks for the sessions which were just ended, then stop.
+    _ioServiceWork.reset();
+    _ioService.stop();
+    for (auto&& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void TransportLayerASIO::_releaseConnection(ASIOSession& session) {
+    Listener::globalTicketHolder.release();
+}
+
+void TransportLayerASIO::_destroy(ASIOSession& session) {
+    if (!session.isClosed()) {
+        // No other operation can still be running on the socket of a destroyed session.
+        _releaseConnection(session);
+        session.closeSocket();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+    _sessions.erase(session.getIter());
+}
+
+void TransportLayerASIO::_handleNewConnection(int fd,
+                                              const SockAddr& remote,
+                                              const SockAddr& local,
+                                              long long connectionId) {
+    if (!Listener::globalTicketHolder.tryAcquire()) {
+        log() << "connection refused because too many open connections: "
+              << Listener::globalTicketHolder.used();
+        closesocket(fd);
+        return;
+    }
+
+    std::shared_ptr<ASIOSession> session;
+    try {
+        session = std::make_shared<ASIOSession>(this, fd, remote, local, connectionId);
+    } catch (const asio::system_error& e) {
+        log() << "failed to take over accepted connection from " << remote.toString()
+              << ": " << e.what();
+        Listener::globalTicketHolder.release();
+        closesocket(fd);
+        return;
+    }
+
+    stdx::list<std::weak_ptr<ASIOSession>> list;
+    auto it = list.emplace(list.begin(), session);
+
+    {
+        // Add the new session to our list
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        session->setIter(it);
+        _sessions.splice(_sessions.begin(), list, it);
+    }
+
+    invariant(_sep);
+    _sep->startSession(std::move(session));
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,263 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <asio.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/list.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/ticket_impl.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/net/listen.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/net/sock.h"
+
+namespace mongo {
+
+class ServiceEntryPoint;
+
+namespace transport {
+
+/**
+ * Returns true if the server was started with --setParameter transportLayer=asio, in which case
+ * the ServiceEntryPoints should drive their sessions through asyncWait() rather than dedicating a
+ * thread to each one.
+ */
+bool isTransportLayerASIOEnabled();
+
+/**
+ * A TransportLayer implementation which multiplexes all of its sessions onto a fixed-size pool of
+ * worker threads running an asio::io_service.
+ *
+ * New connections are accepted by a Listener, exactly as for the TransportLayerLegacy. Accepted
+ * sockets are then handed over to asio, and all further reads and writes on them happen either
+ * synchronously from the caller of wait(), or asynchronously from the worker pool for
+ * asyncWait(). A session which is waiting in asyncWait() for its next Message does not occupy a
+ * thread. All operations on a given session's socket are serialized through a per-session strand,
+ * so callbacks for one session never run concurrently with each other.
+ *
+ * This TransportLayer does not yet support SSL; setup() fails if SSL is enabled.
+ */
+class TransportLayerASIO final : public TransportLayer {
+    MONGO_DISALLOW_COPYING(TransportLayerASIO);
+
+public:
+    struct Options {
+        int port = 0;        // port to bind to
+        std::string ipList;  // addresses to bind to
+
+        // Size of the worker pool. 0 means the transportLayerASIOWorkerThreads server parameter,
+        // or one thread per core if that is not set either.
+        size_t numWorkerThreads = 0;
+    };
+
+    TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
+
+    ~TransportLayerASIO();
+
+    Status setup();
+    Status start() override;
+
+    Ticket sourceMessage(const SessionHandle& session,
+                         Message* message,
+                         Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Ticket sinkMessage(const SessionHandle& session,
+                       const Message& message,
+                       Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Status wait(Ticket&& ticket) override;
+    void asyncWait(Ticket&& ticket, TicketCallback callback) override;
+
+    Stats sessionStats() override;
+
+    void end(const SessionHandle& session) override;
+    void endAllSessions(transport::Session::TagMask tags) override;
+
+    void shutdown() override;
+
+private:
+    class ASIOSession;
+    class ASIOTicket;
+    class ASIOSourceTicket;
+    class ASIOSinkTicket;
+
+    using ASIOSessionHandle = std::shared_ptr<ASIOSession>;
+    using SessionEntry = stdx::list<std::weak_ptr<ASIOSession>>::iterator;
+
+    /**
+     * This Listener accepts connections the same way the legacy one does, but takes the raw
+     * socket away from the accepted Socket rather than wrapping it in an AbstractMessagingPort.
+     */
+    class ListenerASIO : public Listener {
+    public:
+        ListenerASIO(const Options& opts, TransportLayerASIO* tl);
+
+        void accepted(std::unique_ptr<AbstractMessagingPort> mp) override;
+
+    private:
+        void _accepted(const std::shared_ptr<Socket>& psocket, long long connectionId) override;
+
+        bool useUnixSockets() const override {
+            return true;
+        }
+
+        TransportLayerASIO* const _tl;
+    };
+
+    /**
+     * An implementation of the Session interface for this TransportLayer.
+     */
+    class ASIOSession : public Session {
+        MONGO_DISALLOW_COPYING(ASIOSession);
+
+    public:
+        ASIOSession(TransportLayerASIO* tl,
+                    int fd,
+                    const SockAddr& remote,
+                    const SockAddr& local,
+                    long long connectionId);
+
+        ~ASIOSession();
+
+        TransportLayer* getTransportLayer() const override {
+            return _tl;
+        }
+
+        const HostAndPort& remote() const override {
+            return _remote;
+        }
+
+        const HostAndPort& local() const override {
+            return _local;
+        }
+
+        long long connectionId() const {
+            return _connectionId;
+        }
+
+        asio::generic::stream_protocol::socket& socket() {
+            return _socket;
+        }
+
+        asio::io_service::strand& strand() {
+            return _strand;
+        }
+
+        /**
+         * The buffers incoming messages are read into. A session only has one source ticket
+         * being filled at a time.
+         */
+        MessageRecvBuffer& recvBuffer() {
+            return _recvBuffer;
+        }
+
+        bool isClosed() const {
+            return _closed.load();
+        }
+
+        /**
+         * Shuts down and closes the socket. Must be run on this session's strand, or when no
+         * other operation can be in progress on the socket. Idempotent.
+         */
+        void closeSocket();
+
+        /**
+         * Marks the session closed and schedules the socket to be closed on this session's
+         * strand, which cancels any outstanding asynchronous operation. Idempotent.
+         */
+        void end();
+
+        void setIter(SessionEntry it) {
+            _entry = std::move(it);
+        }
+
+        SessionEntry getIter() const {
+            return _entry;
+        }
+
+    private:
+        TransportLayerASIO* const _tl;
+
+        HostAndPort _remote;
+        HostAndPort _local;
+
+        const long long _connectionId;
+
+        asio::generic::stream_protocol::socket _socket;
+        asio::io_service::strand _strand;
+
+        MessageRecvBuffer _recvBuffer;
+
+        AtomicBool _closed{false};
+
+        // A handle to this session's entry in the TL's session list
+        SessionEntry _entry;
+    };
+
+    void _handleNewConnection(int fd,
+                              const SockAddr& remote,
+                              const SockAddr& local,
+                              long long connectionId);
+
+    void _releaseConnection(ASIOSession& session);
+
+    void _destroy(ASIOSession& session);
+
+    /**
+     * Validates 'ticket' against the state of this TransportLayer and its session, returning the
+     * session to run it against on success.
+     */
+    StatusWith<ASIOSessionHandle> _prepareTicket(ASIOTicket* ticket);
+
+    std::vector<ASIOSessionHandle> _lockAllSessions() const;
+
+    ServiceEntryPoint* const _sep;
+    const Options _options;
+
+    asio::io_service _ioService;
+    std::unique_ptr<asio::io_service::work> _ioServiceWork;
+    std::vector<stdx::thread> _workers;
+
+    std::unique_ptr<ListenerASIO> _listener;
+    stdx::thread _listenerThread;
+
+    // TransportLayerASIO holds non-owning pointers to all of its sessions.
+    mutable stdx::mutex _sessionsMutex;
+    stdx::list<std::weak_ptr<ASIOSession>> _sessions;
+
+    AtomicWord<bool> _running{false};
+};
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,284 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/barrier.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace benchmark {
+
+namespace {
+
+// No repetition runs more iterations than this, however fast the benchmark is.
+const std::int64_t kMaxIterations = 1000000000;
+
+std::vector<std::unique_ptr<Benchmark>>& registeredBenchmarks() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+/**
+ * The measurements of one run of a benchmark, over all threads.
+ */
+struct Run {
+    double nanosPerIteration;
+    double itemsPerSecond;
+};
+
+/**
+ * A benchmark with one of its arguments and thread counts.
+ */
+struct Instance {
+    const Benchmark* benchmark;
+    std::string name;
+    std::int64_t arg;
+    int threads;
+};
+
+std::vector<Instance> instances(const RunOptions& options) {
+    std::vector<Instance> result;
+    for (auto&& benchmark : registeredBenchmarks()) {
+        auto args = benchmark->args();
+        if (args.empty()) {
+            args.push_back(0);
+        }
+        auto threadCounts = benchmark->threadCounts();
+        if (threadCounts.empty()) {
+            threadCounts.push_back(1);
+        }
+
+        for (auto arg : args) {
+            for (auto threads : threadCounts) {
+                std::string name = benchmark->name();
+                if (!benchmark->args().empty()) {
+                    name += "/" + std::to_string(arg);
+                }
+                if (!benchmark->threadCounts().empty()) {
+                    name += "/threads:" + std::to_string(threads);
+                }
+                if (name.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                result.push_back({benchmark.get(), std::move(name), arg, threads});
+            }
+        }
+    }
+    return result;
+}
+
+Run runOnce(const Instance& instance, std::int64_t iterations) {
+    std::vector<std::unique_ptr<State>> states;
+    for (int i = 0; i < instance.threads; ++i) {
+        states.push_back(stdx::make_unique<State>(iterations, instance.arg, i, instance.threads));
+    }
+
+    if (instance.threads == 1) {
+        instance.benchmark->function()(*states[0]);
+    } else {
+        // Start the threads together, so that they contend for the whole run.
+        unittest::Barrier barrier(instance.threads);
+        std::vector<stdx::thread> threads;
+        for (auto&& state : states) {
+            threads.emplace_back([&instance, &barrier, &state] {
+                barrier.countDownAndWait();
+                instance.benchmark->function()(*state);
+            });
+        }
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    }
+
+    double totalNanos = 0;
+    double itemsPerSecond = 0;
+    for (auto&& state : states) {
+        const double nanos = std::max<double>(1, state->elapsed().count());
+        totalNanos += nanos;
+        itemsPerSecond += state->itemsProcessed() * 1e9 / nanos;
+    }
+
+    return {totalNanos / instance.threads / iterations, itemsPerSecond};
+}
+
+/**
+ * Runs the benchmark with more iterations each time until a run takes at least 'minTime', and
+ * returns that number of iterations.
+ */
+std::int64_t warmup(const Instance& instance, stdx::chrono::milliseconds minTime) {
+    const double minNanos = stdx::chrono::duration_cast<stdx::chrono::nanoseconds>(minTime).count();
+    std::int64_t iterations = 1;
+    while (true) {
+        const double nanos = runOnce(instance, iterations).nanosPerIteration * iterations;
+        if (nanos >= minNanos || iterations >= kMaxIterations) {
+            return iterations;
+        }
+
+        // Aim past the minimum time, but grow by no more than 100 times at once, since short runs
+        // are not timed precisely.
+        const double multiplier = std::min(100.0, std::max(2.0, 1.4 * minNanos / nanos));
+        iterations = std::min<std::int64_t>(kMaxIterations, iterations * multiplier);
+    }
+}
+
+struct Statistics {
+    double mean;
+    double median;
+    double stddev;
+    double min;
+    double max;
+};
+
+Statistics statistics(std::vector<double> values) {
+    invariant(!values.empty());
+    std::sort(values.begin(), values.end());
+
+    Statistics stats;
+    stats.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    const auto middle = values.size() / 2;
+    stats.median =
+        values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    double squares = 0;
+    for (auto value : values) {
+        squares += (value - stats.mean) * (value - stats.mean);
+    }
+    stats.stddev = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0;
+    stats.min = values.front();
+    stats.max = values.back();
+    return stats;
+}
+
+void appendStatistics(BSONObjBuilder* builder, StringData name, const Statistics& stats) {
+    BSONObjBuilder subBuilder(builder->subobjStart(name));
+    subBuilder.append("mean", stats.mean);
+    subBuilder.append("median", stats.median);
+    subBuilder.append("stddev", stats.stddev);
+    subBuilder.append("min", stats.min);
+    subBuilder.append("max", stats.max);
+    subBuilder.doneFast();
+}
+
+}  // namespace
+
+void escape(const void* pointer) {
+    static const void* volatile sink;
+    sink = pointer;
+}
+
+Benchmark* registerBenchmark(const char* name, Benchmark::Function function) {
+    registeredBenchmarks().push_back(stdx::make_unique<Benchmark>(name, function));
+    return registeredBenchmarks().back().get();
+}
+
+int runBenchmarks(const RunOptions& options) {
+    const auto toRun = instances(options);
+    if (options.listOnly) {
+        for (auto&& instance : toRun) {
+            std::cout << instance.name << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(12)
+              << "Iterations" << std::setw(14) << "Median ns" << std::setw(14) << "Mean ns"
+              << std::setw(10) << "Stddev %" << std::setw(16) << "Items/s" << std::endl;
+
+    BSONArrayBuilder resultsBuilder;
+    for (auto&& instance : toRun) {
+        const auto iterations = warmup(instance, options.minTime);
+
+        std::vector<double> nanos;
+        std::vector<double> rates;
+        for (int i = 0; i < options.repetitions; ++i) {
+            auto run = runOnce(instance, iterations);
+            nanos.push_back(run.nanosPerIteration);
+            rates.push_back(run.itemsPerSecond);
+        }
+
+        const auto nanosStats = statistics(nanos);
+        const auto rateStats = statistics(rates);
+
+        std::cout << std::left << std::setw(48) << instance.name << std::right << std::setw(12)
+                  << iterations << std::fixed << std::setprecision(1) << std::setw(14)
+                  << nanosStats.median << std::setw(14) << nanosStats.mean << std::setw(10)
+                  << (nanosStats.mean > 0 ? 100 * nanosStats.stddev / nanosStats.mean : 0)
+                  << std::setprecision(0) << std::setw(16) << rateStats.median << std::endl;
+
+        BSONObjBuilder resultBuilder(resultsBuilder.subobjStart());
+        resultBuilder.append("name", instance.name);
+        resultBuilder.append("arg", static_cast<long long>(instance.arg));
+        resultBuilder.append("threads", instance.threads);
+        resultBuilder.append("iterations", static_cast<long long>(iterations));
+        resultBuilder.append("repetitions", options.repetitions);
+        appendStatistics(&resultBuilder, "nanosPerIteration", nanosStats);
+        appendStatistics(&resultBuilder, "itemsPerSecond", rateStats);
+        resultBuilder.doneFast();
+    }
+
+    if (!options.jsonFile.empty()) {
+        BSONObjBuilder builder;
+        {
+            BSONObjBuilder contextBuilder(builder.subobjStart("context"));
+            contextBuilder.append("date", dateToISOStringUTC(Date_t::now()));
+            contextBuilder.append("numCores",
+                                  static_cast<int>(stdx::thread::hardware_concurrency()));
+            contextBuilder.append("minTimeMillis",
+                                  static_cast<long long>(options.minTime.count()));
+            contextBuilder.doneFast();
+        }
+        builder.append("benchmarks", resultsBuilder.arr());
+
+        std::ofstream out(options.jsonFile);
+        out << builder.obj().jsonString(Strict, true) << std::endl;
+        if (!out) {
+            std::cerr << "Failed to write " << options.jsonFile << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+}  // namespace benchmark
+}  // namespace mongo
@@ -0,0 +1,279 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/*
+ * A harness for microbenchmarks of the server's hot primitives.
+ *
+ * A benchmark is a function which runs the code being measured in a loop for as many iterations
+ * as the harness asks for:
+ *
+ *     void BM_appendInt(benchmark::State& state) {
+ *         for (BSONObjBuilder bob; state.keepRunning();) {
+ *             bob.append("a", 1);
+ *         }
+ *     }
+ *     MONGO_BENCHMARK(BM_appendInt);
+ *
+ * The harness runs each benchmark until it has taken long enough to time reliably (warmup), then
+ * times it over several repetitions of that many iterations, and reports the mean, median,
+ * standard deviation and extremes of the time per iteration, on the console and optionally as
+ * JSON for regression tracking.
+ *
+ * Benchmarks can take an argument, and can be run by several threads at once:
+ *
+ *     MONGO_BENCHMARK(BM_lockUnlock)->arg(1)->arg(64)->threads(1)->threads(8);
+ *
+ * Benchmarks are built with env.Benchmark() in SConscript files, and run by the "benchmarks"
+ * alias's programs, which accept --filter, --repetitions, --minTimeMillis and --json.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/compiler.h"
+#include "mongo/stdx/chrono.h"
+
+namespace mongo {
+namespace benchmark {
+
+/**
+ * The state of one thread's run of a benchmark.
+ */
+class State {
+    MONGO_DISALLOW_COPYING(State);
+
+public:
+    State(std::int64_t iterations, std::int64_t arg, int threadIndex, int threads)
+        : _iterations(iterations),
+          _remaining(iterations),
+          _arg(arg),
+          _threadIndex(threadIndex),
+          _threads(threads) {}
+
+    /**
+     * Returns true until the benchmark has run the number of iterations asked for. Timing starts
+     * at the first call, so that the benchmark's setup before the loop is not timed.
+     */
+    bool keepRunning() {
+        if (MONGO_unlikely(_remaining == _iterations)) {
+            _resume();
+        }
+        if (MONGO_likely(_remaining > 0)) {
+            --_remaining;
+            return true;
+        }
+        _pause();
+        return false;
+    }
+
+    /**
+     * Excludes the time until resumeTiming() from the measurement, for per-iteration setup.
+     */
+    void pauseTiming() {
+        _pause();
+    }
+
+    void resumeTiming() {
+        _resume();
+    }
+
+    /**
+     * The argument given by Benchmark::arg(), or 0.
+     */
+    std::int64_t arg() const {
+        return _arg;
+    }
+
+    int threadIndex() const {
+        return _threadIndex;
+    }
+
+    int threads() const {
+        return _threads;
+    }
+
+    std::int64_t iterations() const {
+        return _iterations;
+    }
+
+    /**
+     * The number of items the benchmark processed, for reporting a rate. Defaults to one per
+     * iteration.
+     */
+    void setItemsProcessed(std::int64_t items) {
+        _itemsProcessed = items;
+    }
+
+    std::int64_t itemsProcessed() const {
+        return _itemsProcessed >= 0 ? _itemsProcessed : _iterations;
+    }
+
+    stdx::chrono::nanoseconds elapsed() const {
+        return _elapsed;
+    }
+
+private:
+    using Clock = stdx::chrono::steady_clock;
+
+    void _pause() {
+        if (_running) {
+            _elapsed += Clock::now() - _start;
+            _running = false;
+        }
+    }
+
+    void _resume() {
+        if (!_running) {
+            _start = Clock::now();
+            _running = true;
+        }
+    }
+
+    const std::int64_t _iterations;
+    std::int64_t _remaining;
+    const std::int64_t _arg;
+    const int _threadIndex;
+    const int _threads;
+
+    std::int64_t _itemsProcessed = -1;
+
+    bool _running = false;
+    Clock::time_point _start;
+    stdx::chrono::nanoseconds _elapsed{0};
+};
+
+/**
+ * Makes the compiler assume that 'pointer' is read and written by something it cannot see.
+ */
+void escape(const void* pointer);
+
+/**
+ * Keeps the compiler from optimizing away the computation of 'value'.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    escape(&value);
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * A registered benchmark and the arguments and thread counts to run it with.
+ */
+class Benchmark {
+    MONGO_DISALLOW_COPYING(Benchmark);
+
+public:
+    using Function = void (*)(State&);
+
+    Benchmark(std::string name, Function function)
+        : _name(std::move(name)), _function(function) {}
+
+    /**
+     * Adds an argument to run the benchmark with. Each argument is run separately.
+     */
+    Benchmark* arg(std::int64_t arg) {
+        _args.push_back(arg);
+        return this;
+    }
+
+    /**
+     * Adds a number of threads to run the benchmark with. Each thread count is run separately.
+     */
+    Benchmark* threads(int threads) {
+        _threads.push_back(threads);
+        return this;
+    }
+
+    const std::string& name() const {
+        return _name;
+    }
+
+    Function function() const {
+        return _function;
+    }
+
+    const std::vector<std::int64_t>& args() const {
+        return _args;
+    }
+
+    const std::vector<int>& threadCounts() const {
+        return _threads;
+    }
+
+private:
+    const std::string _name;
+    const Function _function;
+    std::vector<std::int64_t> _args;
+    std::vector<int> _threads;
+};
+
+/**
+ * Registers a benchmark. Called by MONGO_BENCHMARK at static initialization.
+ */
+Benchmark* registerBenchmark(const char* name, Benchmark::Function function);
+
+struct RunOptions {
+    // Only run the benchmarks whose full names contain this.
+    std::string filter;
+
+    // How many times to time each benchmark after warming it up.
+    int repetitions = 5;
+
+    // How long each repetition should take at least.
+    stdx::chrono::milliseconds minTime{500};
+
+    // Write the results as JSON to this file, if not empty.
+    std::string jsonFile;
+
+    // Only list the benchmarks.
+    bool listOnly = false;
+};
+
+/**
+ * Runs the registered benchmarks. Returns the process exit code.
+ */
+int runBenchmarks(const RunOptions& options);
+
+}  // namespace benchmark
+}  // namespace mongo
+
+#define MONGO_BENCHMARK_CONCAT_(a, b) a##b
+#define MONGO_BENCHMARK_CONCAT(a, b) MONGO_BENCHMARK_CONCAT_(a, b)
+
+#define MONGO_BENCHMARK(FUNCTION)                                                 \
+    static ::mongo::benchmark::Benchmark* MONGO_BENCHMARK_CONCAT(_mongoBenchmark_, \
+                                                                 __LINE__) =       \
+        ::mongo::benchmark::registerBenchmark(#FUNCTION, FUNCTION)
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "mongo/base/initializer.h"
+#include "mongo/base/string_data.h"
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/signal_handlers_synchronous.h"
+
+namespace {
+
+void usage(const char* program) {
+    std::cerr << "usage: " << program << " [--list] [--filter=<substring>] [--repetitions=<n>]"
+              << " [--minTimeMillis=<n>] [--json=<file>]" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv, char** envp) {
+    ::mongo::clearSignalMask();
+    ::mongo::setupSynchronousSignalHandlers();
+    ::mongo::runGlobalInitializersOrDie(argc, argv, envp);
+
+    ::mongo::benchmark::RunOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const ::mongo::StringData arg(argv[i]);
+        const auto value = [&](::mongo::StringData flag) {
+            return arg.substr(flag.size()).toString();
+        };
+
+        if (arg == "--list") {
+            options.listOnly = true;
+        } else if (arg.startsWith("--filter=")) {
+            options.filter = value("--filter=");
+        } else if (arg.startsWith("--repetitions=")) {
+            options.repetitions = std::max(1, std::atoi(value("--repetitions=").c_str()));
+        } else if (arg.startsWith("--minTimeMillis=")) {
+            options.minTime = ::mongo::stdx::chrono::milliseconds(
+                std::max(1, std::atoi(value("--minTimeMillis=").c_str())));
+        } else if (arg.startsWith("--json=")) {
+            options.jsonFile = value("--json=");
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return ::mongo::benchmark::runBenchmarks(options);
+}
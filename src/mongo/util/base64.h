@@ -74,7 +74,7 @@ public:
 extern Alphabet alphabet;
 
 
-void encode(std::stringstream& ss, const char* data, int size);
+void encode(std::ostream& ss, const char* data, int size);
 std::string encode(const char* data, int size);
 std::string encode(const std::string& s);
 
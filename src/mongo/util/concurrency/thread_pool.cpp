@@ -172,7 +172,7 @@ void ThreadPool::_join_inlock(stdx::unique_lock<stdx::mutex>* lk) {
 }
 
 Status ThreadPool::schedule(Task task) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
     switch (_state) {
         case joinRequired:
         case joining:
@@ -196,6 +196,14 @@ Status ThreadPool::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
+    if (_numIdleThreads == 0) {
+        // Every thread is busy running a task and will look at _pendingTasks again before it
+        // waits, so there is nobody to wake up.
+        return Status::OK();
+    }
+
+    // Wake a worker only after releasing the mutex, so that it does not immediately block on it.
+    lk.unlock();
     _workAvailable.notify_one();
     return Status::OK();
 }
@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <string>
+
+#include "mongo/unittest/benchmark.h"
+#include "mongo/util/decorable.h"
+
+namespace mongo {
+namespace {
+
+class MyDecorable : public Decorable<MyDecorable> {};
+
+// Declared at static initialization, as the server's decorations are, so that the offsets are
+// fixed before any MyDecorable is constructed.
+const auto firstDecoration = MyDecorable::declareDecoration<int>();
+const auto secondDecoration = MyDecorable::declareDecoration<std::string>();
+const auto thirdDecoration = MyDecorable::declareDecoration<long long>();
+
+void BM_decorationAccess(benchmark::State& state) {
+    MyDecorable decorable;
+    while (state.keepRunning()) {
+        ++thirdDecoration(decorable);
+        benchmark::doNotOptimize(thirdDecoration(decorable));
+    }
+}
+MONGO_BENCHMARK(BM_decorationAccess);
+
+// For comparison, the string-keyed lookup that a decoration replaces.
+void BM_stringKeyedAccess(benchmark::State& state) {
+    std::map<std::string, long long> slots{{"first", 0}, {"second", 0}, {"third", 0}};
+    const std::string key = "third";
+    while (state.keepRunning()) {
+        ++slots[key];
+        benchmark::doNotOptimize(slots[key]);
+    }
+}
+MONGO_BENCHMARK(BM_stringKeyedAccess);
+
+// Constructing and destroying a decorable runs the constructor and destructor of every
+// decoration, as each new OperationContext does.
+void BM_decorableConstruction(benchmark::State& state) {
+    while (state.keepRunning()) {
+        MyDecorable decorable;
+        benchmark::doNotOptimize(firstDecoration(decorable));
+    }
+}
+MONGO_BENCHMARK(BM_decorableConstruction);
+
+}  // namespace
+}  // namespace mongo
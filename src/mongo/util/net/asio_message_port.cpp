@@ -233,18 +233,24 @@ asio::error_code ASIOMessagingPort::_read(char* buf, std::size_t size) {
 
 asio::error_code ASIOMessagingPort::_write(const char* buf, std::size_t size) {
     invariant(buf);
+    return _write(asio::buffer(buf, size));
+}
 
+template <typename ConstBufferSequence>
+asio::error_code ASIOMessagingPort::_write(const ConstBufferSequence& buffers) {
     stdx::lock_guard<stdx::mutex> opInProgressGuard(_opInProgress);
 
+    const std::size_t size = asio::buffer_size(buffers);
+
     // Try to do optimistic writes.
     asio::error_code ec;
     std::size_t bytesWritten;
     if (!_isEncrypted) {
-        bytesWritten = asio::write(_getSocket(), asio::buffer(buf, size), ec);
+        bytesWritten = asio::write(_getSocket(), buffers, ec);
     }
 #ifdef MONGO_CONFIG_SSL
     else {
-        bytesWritten = asio::write(_sslSock, asio::buffer(buf, size), ec);
+        bytesWritten = asio::write(_sslSock, buffers, ec);
     }
 #endif
     if (!ec && bytesWritten == size) {
@@ -254,7 +260,21 @@ asio::error_code ASIOMessagingPort::_write(const char* buf, std::size_t size) {
         return ec;
     }
 
-    // Fall back to async with timer if the operation would block.
+    // Fall back to async with timer if the operation would block, skipping over whatever the
+    // optimistic write already sent.
+    std::vector<asio::const_buffer> remaining;
+    std::size_t toSkip = bytesWritten;
+    for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+        asio::const_buffer buffer(*it);
+        const std::size_t bufferSize = asio::buffer_size(buffer);
+        if (toSkip >= bufferSize) {
+            toSkip -= bufferSize;
+            continue;
+        }
+        remaining.push_back(buffer + toSkip);
+        toSkip = 0;
+    }
+
     if (_timeout) {
         _timer.expires_from_now(decltype(_timer)::duration(
             durationCount<Duration<decltype(_timer)::duration::period>>(*_timeout)));
@@ -263,7 +283,7 @@ asio::error_code ASIOMessagingPort::_write(const char* buf, std::size_t size) {
     if (!_isEncrypted) {
         asio::async_write(
             _getSocket(),
-            asio::buffer(buf + bytesWritten, size - bytesWritten),
+            remaining,
             [&ec, size, bytesWritten](const asio::error_code& err, std::size_t size_written) {
                 invariant(err || (size - bytesWritten) == size_written);
                 ec = err;
@@ -273,7 +293,7 @@ asio::error_code ASIOMessagingPort::_write(const char* buf, std::size_t size) {
     else {
         asio::async_write(
             _sslSock,
-            asio::buffer(buf + bytesWritten, size - bytesWritten),
+            remaining,
             [&ec, size, bytesWritten](const asio::error_code& err, std::size_t size_written) {
                 invariant(err || (size - bytesWritten) == size_written);
                 ec = err;
@@ -338,7 +358,7 @@ bool ASIOMessagingPort::recv(Message& m) {
         if (getGlobalFailPointRegistry()->getFailPoint("throwSockExcep")->shouldFail()) {
             throw SocketException(SocketException::RECV_ERROR, "fail point set");
         }
-        SharedBuffer buf = SharedBuffer::allocate(kInitialMessageSize);
+        SharedBuffer buf = _recvBuffer.get(kInitialMessageSize);
         MsgData::View md = buf.get();
 
         asio::error_code ec = _read(md.view2ptr(), kHeaderLen);
@@ -415,7 +435,13 @@ bool ASIOMessagingPort::recv(Message& m) {
         }
 
         if (msgLen > kInitialMessageSize) {
-            buf.realloc(msgLen);
+            // Let go of the buffer holding the header first, so that _recvBuffer can hand it out
+            // again if it is large enough for the whole message.
+            char header[kHeaderLen];
+            memcpy(header, md.view2ptr(), kHeaderLen);
+            buf = SharedBuffer();
+            buf = _recvBuffer.get(msgLen);
+            memcpy(buf.get(), header, kHeaderLen);
             md = buf.get();
         }
 
@@ -518,8 +544,20 @@ void ASIOMessagingPort::send(const char* data, int len, const char*) {
 }
 
 void ASIOMessagingPort::send(const std::vector<std::pair<char*, int>>& data, const char*) {
+    if (getGlobalFailPointRegistry()->getFailPoint("throwSockExcep")->shouldFail()) {
+        throw SocketException(SocketException::SEND_ERROR, "fail point set");
+    }
+
+    // Gather all the pieces into a single write, rather than making a system call for each.
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(data.size());
     for (auto&& pair : data) {
-        send(pair.first, pair.second, nullptr);
+        buffers.push_back(asio::buffer(pair.first, pair.second));
+    }
+
+    asio::error_code ec = _write(buffers);
+    if (ec) {
+        throw SocketException(SocketException::SEND_ERROR, asio::system_error(ec).what());
     }
 }
 
@@ -586,8 +624,11 @@ bool ASIOMessagingPort::connect(SockAddr& farEnd) {
 
 bool ASIOMessagingPort::secure(SSLManagerInterface* ssl, const std::string& remoteHost) {
 #ifdef MONGO_CONFIG_SSL
+    const std::string remote = _remote.toString();
+    getSSLClientSessionCache().prepareResumption(_sslSock.native_handle(), remote);
     auto ec = _handshake(false);
     if (ec) {
+        getSSLClientSessionCache().forgetSession(_sslSock.native_handle(), remote);
         return false;
     }
 
@@ -597,6 +638,7 @@ bool ASIOMessagingPort::secure(SSLManagerInterface* ssl, const std::string& remo
         throw SocketException(SocketException::CONNECT_ERROR, swPeerInfo.getStatus().reason());
     }
     setX509PeerInfo(swPeerInfo.getValue().get_value_or(SSLPeerInfo()));
+    getSSLClientSessionCache().recordSession(_sslSock.native_handle(), remote);
 
     _isEncrypted = true;
     return true;
@@ -123,6 +123,8 @@ private:
     void _setTimerCallback();
     asio::error_code _read(char* buf, std::size_t size);
     asio::error_code _write(const char* buf, std::size_t size);
+    template <typename ConstBufferSequence>
+    asio::error_code _write(const ConstBufferSequence& buffers);
     asio::error_code _handshake(bool isServer, const char* buf = nullptr, std::size_t size = 0);
     const asio::generic::stream_protocol::socket& _getSocket() const;
     asio::generic::stream_protocol::socket& _getSocket();
@@ -150,6 +152,8 @@ private:
     long long _connectionId;
     AbstractMessagingPort::Tag _tag;
 
+    MessageRecvBuffer _recvBuffer;
+
 #ifdef MONGO_CONFIG_SSL
     boost::optional<ASIOSSLContext> _context;
     asio::ssl::stream<asio::generic::stream_protocol::socket> _sslSock;
@@ -457,6 +457,42 @@ private:
     SharedBuffer _buf;
 };
 
+/**
+ * Provides the buffers that a connection receives its messages into.
+ *
+ * Once the Message from the previous receive has let go of its buffer, the same buffer is handed
+ * out again instead of allocating a new one. Buffers are sized in powers of two so that a
+ * connection settles on one buffer for messages of similar sizes. Buffers for messages larger
+ * than kMaxRetainedSize are never kept, so idle connections don't hold on to large buffers.
+ */
+class MessageRecvBuffer {
+public:
+    static constexpr size_t kMinSize = 1024;
+    static constexpr size_t kMaxRetainedSize = 64 * 1024;
+
+    /**
+     * Returns a buffer of at least "size" bytes, with unspecified contents.
+     */
+    SharedBuffer get(size_t size) {
+        if (size > kMaxRetainedSize) {
+            return SharedBuffer::allocate(size);
+        }
+
+        if (!_buffer || _buffer.isShared() || _capacity < size) {
+            _capacity = kMinSize;
+            while (_capacity < size) {
+                _capacity *= 2;
+            }
+            _buffer = SharedBuffer::allocate(_capacity);
+        }
+        return _buffer;
+    }
+
+private:
+    SharedBuffer _buffer;
+    size_t _capacity = 0;
+};
+
 /**
  * Returns an always incrementing value to be used to assign to the next received network message.
  */
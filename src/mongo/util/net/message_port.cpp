@@ -148,7 +148,7 @@ bool MessagingPort::recv(Message& m) {
 
         _psock->setHandshakeReceived();
 
-        auto buf = SharedBuffer::allocate(len);
+        auto buf = _recvBuffer.get(len);
         MsgData::View md = buf.get();
         memcpy(md.view2ptr(), &header, sizeof(header));
 
@@ -143,6 +143,7 @@ private:
     long long _connectionId;
     AbstractMessagingPort::Tag _tag;
     std::shared_ptr<Socket> _psock;
+    MessageRecvBuffer _recvBuffer;
 };
 
 }  // namespace mongo
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/net/message.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// Compares buffers by address, and keeps the assertions from printing their contents.
+const void* data(const SharedBuffer& buffer) {
+    return buffer.get();
+}
+
+TEST(MessageRecvBufferTest, ReusesReleasedBuffer) {
+    MessageRecvBuffer recvBuffer;
+    const void* first = data(recvBuffer.get(100));
+    ASSERT_EQ(first, data(recvBuffer.get(100)));
+    // Still fits in the same size class.
+    ASSERT_EQ(first, data(recvBuffer.get(MessageRecvBuffer::kMinSize)));
+}
+
+TEST(MessageRecvBufferTest, DoesNotReuseBufferStillInUse) {
+    MessageRecvBuffer recvBuffer;
+    Message inUse;
+    inUse.setData(recvBuffer.get(100));
+    SharedBuffer next = recvBuffer.get(100);
+    ASSERT_NE(static_cast<const void*>(inUse.buf()), data(next));
+
+    // Once the message goes away, the newer buffer is the one handed out again.
+    inUse.reset();
+    const void* nextData = data(next);
+    next = SharedBuffer();
+    ASSERT_EQ(nextData, data(recvBuffer.get(100)));
+}
+
+TEST(MessageRecvBufferTest, GrowsForLargerMessages) {
+    MessageRecvBuffer recvBuffer;
+    recvBuffer.get(100);
+    SharedBuffer larger = recvBuffer.get(5000);
+    const void* largerData = data(larger);
+    larger = SharedBuffer();
+
+    // 5000 bytes are rounded up to 8KB, which is then reused for anything up to that size.
+    ASSERT_EQ(largerData, data(recvBuffer.get(8 * 1024)));
+    ASSERT_EQ(largerData, data(recvBuffer.get(100)));
+}
+
+TEST(MessageRecvBufferTest, DoesNotRetainHugeBuffers) {
+    MessageRecvBuffer recvBuffer;
+    const void* retained = data(recvBuffer.get(100));
+    SharedBuffer huge = recvBuffer.get(MessageRecvBuffer::kMaxRetainedSize + 1);
+    ASSERT_NE(retained, data(huge));
+    ASSERT_FALSE(huge.isShared());
+    ASSERT_EQ(retained, data(recvBuffer.get(100)));
+}
+
+}  // namespace
+}  // namespace mongo
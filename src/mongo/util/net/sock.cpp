@@ -335,6 +335,7 @@ bool Socket::secure(SSLManagerInterface* mgr, const std::string& remoteHost) {
     _sslManager = mgr;
     _sslConnection.reset(_sslManager->connect(this));
     mgr->parseAndValidatePeerCertificateDeprecated(_sslConnection.get(), remoteHost);
+    getSSLClientSessionCache().recordSession(_sslConnection->ssl, remoteAddr().toString());
     return true;
 }
 
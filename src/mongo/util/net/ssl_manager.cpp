@@ -43,6 +43,7 @@
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/config.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/session.h"
@@ -425,6 +426,70 @@ SSLManagerInterface* getSSLManager() {
     return NULL;
 }
 
+// Whether outgoing connections try to resume the last TLS session established with their host.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(sslClientSessionResumption, bool, true);
+
+namespace {
+// Bounds what is held on behalf of processes that connect to a great many different hosts.
+const size_t kMaxCachedClientSessions = 1024;
+}  // namespace
+
+void SSLClientSessionCache::prepareResumption(SSL* ssl, const std::string& remote) {
+    if (!sslClientSessionResumption) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sessions.find(Key(::SSL_get_SSL_CTX(ssl), remote));
+    if (it != _sessions.end()) {
+        // Takes its own reference to the session.
+        ::SSL_set_session(ssl, it->second);
+    }
+}
+
+void SSLClientSessionCache::recordSession(SSL* ssl, const std::string& remote) {
+    if (!sslClientSessionResumption) {
+        return;
+    }
+
+    SSL_SESSION* session = ::SSL_get1_session(ssl);
+    if (!session) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Key key(::SSL_get_SSL_CTX(ssl), remote);
+    auto it = _sessions.find(key);
+    if (it != _sessions.end()) {
+        ::SSL_SESSION_free(it->second);
+        it->second = session;
+        return;
+    }
+
+    if (_sessions.size() >= kMaxCachedClientSessions) {
+        for (auto&& entry : _sessions) {
+            ::SSL_SESSION_free(entry.second);
+        }
+        _sessions.clear();
+    }
+    _sessions.emplace(std::move(key), session);
+}
+
+void SSLClientSessionCache::forgetSession(SSL* ssl, const std::string& remote) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sessions.find(Key(::SSL_get_SSL_CTX(ssl), remote));
+    if (it != _sessions.end()) {
+        ::SSL_SESSION_free(it->second);
+        _sessions.erase(it);
+    }
+}
+
+SSLClientSessionCache& getSSLClientSessionCache() {
+    // Never destroyed, as connections may still be made while the process exits.
+    static SSLClientSessionCache* const cache = new SSLClientSessionCache();
+    return *cache;
+}
+
 std::string getCertificateSubjectName(X509* cert) {
     std::string result;
 
@@ -1137,12 +1202,17 @@ SSLConnection* SSLManager::connect(Socket* socket) {
     if (ret != 1)
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
 
+    const std::string remote = socket->remoteAddr().toString();
+    getSSLClientSessionCache().prepareResumption(sslConn->ssl, remote);
+
     do {
         ret = ::SSL_connect(sslConn->ssl);
     } while (!_doneWithSSLOp(sslConn.get(), ret));
 
-    if (ret != 1)
+    if (ret != 1) {
+        getSSLClientSessionCache().forgetSession(sslConn->ssl, remote);
         _handleSSLError(SSL_get_error(sslConn.get(), ret), ret);
+    }
 
     return sslConn.release();
 }
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -38,6 +39,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/decorable.h"
 #include "mongo/util/net/sock.h"
 #include "mongo/util/net/ssl_types.h"
@@ -191,6 +193,44 @@ public:
 // Access SSL functions through this instance.
 SSLManagerInterface* getSSLManager();
 
+/**
+ * Remembers the TLS session this process most recently established as a client with each remote
+ * host, so that later connections to the same host can resume it. A resumed session skips the
+ * key exchange and certificate verification of a full handshake. Sessions are kept apart per
+ * SSL_CTX, since they carry the client certificate that context presented.
+ */
+class SSLClientSessionCache {
+    MONGO_DISALLOW_COPYING(SSLClientSessionCache);
+
+public:
+    SSLClientSessionCache() = default;
+
+    /**
+     * Offers the session last established with "remote" to be resumed by "ssl", which must not
+     * have started its handshake yet.
+     */
+    void prepareResumption(SSL* ssl, const std::string& remote);
+
+    /**
+     * Remembers the session negotiated by "ssl", which has completed its handshake with "remote"
+     * and validated the peer's certificate.
+     */
+    void recordSession(SSL* ssl, const std::string& remote);
+
+    /**
+     * Forgets the session for "remote", after a handshake offering it failed.
+     */
+    void forgetSession(SSL* ssl, const std::string& remote);
+
+private:
+    using Key = std::pair<const SSL_CTX*, std::string>;
+
+    stdx::mutex _mutex;
+    std::map<Key, SSL_SESSION*> _sessions;
+};
+
+SSLClientSessionCache& getSSLClientSessionCache();
+
 extern bool isSSLServer;
 
 /**
@@ -0,0 +1,288 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kFTDC
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/perf_event_collect.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+struct EventDescription {
+    StringData name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+// PERF_COUNT_HW_CACHE_MISSES counts misses in the last level cache on the common processors.
+const EventDescription kEvents[] = {
+    {"cycles"_sd, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions"_sd, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"llcMisses"_sd, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"contextSwitches"_sd, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+const char kTaskDirectory[] = "/proc/self/task";
+
+int perfEventOpen(perf_event_attr* attr, pid_t tid) {
+    return syscall(__NR_perf_event_open, attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+/**
+ * Open a counter of 'event' in thread 'tid'. Counts events in the kernel too unless
+ * /proc/sys/kernel/perf_event_paranoid forbids it. Returns -1 and sets errno on failure.
+ */
+int openEvent(const EventDescription& event, pid_t tid) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.exclude_hv = 1;
+
+    int fd = perfEventOpen(&attr, tid);
+    if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+        attr.exclude_kernel = 1;
+        fd = perfEventOpen(&attr, tid);
+    }
+    return fd;
+}
+
+std::string readThreadName(const boost::filesystem::path& taskPath) {
+    std::ifstream comm((taskPath / "comm").string());
+    std::string name;
+    std::getline(comm, name);
+    return name;
+}
+
+}  // namespace
+
+constexpr std::size_t PerfEventCollector::kNumEvents;
+
+PerfEventCollector::PerfEventCollector(std::size_t maxThreads,
+                                       std::array<bool, kNumEvents> supported)
+    : _maxThreads(maxThreads), _supported(supported) {}
+
+PerfEventCollector::~PerfEventCollector() {
+    for (auto&& thread : _threads) {
+        closeThread(&thread.second);
+    }
+}
+
+StatusWith<std::unique_ptr<PerfEventCollector>> PerfEventCollector::create(
+    std::size_t maxThreads) {
+    static_assert(sizeof(kEvents) / sizeof(kEvents[0]) == kNumEvents,
+                  "kEvents must describe every event");
+
+    // Check which events can be counted by counting them in this thread.
+    const pid_t tid = syscall(SYS_gettid);
+    std::array<bool, kNumEvents> supported{};
+    bool anySupported = false;
+    int firstError = 0;
+    for (std::size_t i = 0; i < kNumEvents; ++i) {
+        int fd = openEvent(kEvents[i], tid);
+        if (fd < 0) {
+            if (!firstError) {
+                firstError = errno;
+            }
+            continue;
+        }
+        close(fd);
+        supported[i] = true;
+        anySupported = true;
+    }
+
+    if (!anySupported) {
+        return {ErrorCodes::InternalError,
+                str::stream() << "perf_event_open failed: " << errnoWithDescription(firstError)};
+    }
+
+    return std::unique_ptr<PerfEventCollector>(new PerfEventCollector(maxThreads, supported));
+}
+
+PerfEventCollector::ThreadCounters PerfEventCollector::openThread(pid_t tid,
+                                                                  std::string category) const {
+    ThreadCounters thread{std::move(category), {}, {}};
+    for (std::size_t i = 0; i < kNumEvents; ++i) {
+        thread.fds[i] = _supported[i] ? openEvent(kEvents[i], tid) : -1;
+    }
+    return thread;
+}
+
+void PerfEventCollector::readThread(const ThreadCounters& thread, Counts* counts) const {
+    // The values are not scaled for the time a counter was not scheduled on the PMU, which only
+    // happens when other users of the PMU need more counters than it provides, so that the counts
+    // remain monotonic.
+    for (std::size_t i = 0; i < kNumEvents; ++i) {
+        std::uint64_t value;
+        if (thread.fds[i] >= 0 && read(thread.fds[i], &value, sizeof(value)) == sizeof(value)) {
+            (*counts)[i] += value - thread.baseline[i];
+        }
+    }
+}
+
+void PerfEventCollector::updateCategory(ThreadCounters* thread, std::string category) {
+    if (category == thread->category) {
+        return;
+    }
+
+    Counts sinceBaseline{};
+    readThread(*thread, &sinceBaseline);
+    auto& oldCategoryCounts = _exitedCounts[thread->category];
+    for (std::size_t i = 0; i < kNumEvents; ++i) {
+        oldCategoryCounts[i] += sinceBaseline[i];
+        thread->baseline[i] += sinceBaseline[i];
+    }
+    thread->category = std::move(category);
+}
+
+void PerfEventCollector::closeThread(ThreadCounters* thread) {
+    for (auto&& fd : thread->fds) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+std::string PerfEventCollector::threadCategory(StringData threadName) {
+    std::string category = threadName.toString();
+    while (!category.empty() && (isdigit(category.back()) || category.back() == ' ' ||
+                                 category.back() == '-' || category.back() == '_')) {
+        category.pop_back();
+    }
+
+    // Shortened thread names contain a '.', which is not valid in a field name.
+    for (auto&& c : category) {
+        if (c == '.') {
+            c = '_';
+        }
+    }
+
+    return category.empty() ? "unknown" : category;
+}
+
+Status PerfEventCollector::collect(BSONObjBuilder* builder) {
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator di(kTaskDirectory, ec);
+    if (ec) {
+        return {ErrorCodes::FileOpenFailed,
+                str::stream() << "Error reading '" << kTaskDirectory << "': " << ec.message()};
+    }
+
+    std::map<pid_t, boost::filesystem::path> liveThreads;
+    for (; di != boost::filesystem::directory_iterator(); di.increment(ec)) {
+        if (ec) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Error reading '" << kTaskDirectory << "': " << ec.message()};
+        }
+        auto path = di->path();
+        liveThreads.emplace(std::atoi(path.filename().c_str()), path);
+    }
+
+    // A thread's counters remain readable after it exits, so take its final counts before closing
+    // them.
+    for (auto it = _threads.begin(); it != _threads.end();) {
+        if (liveThreads.count(it->first)) {
+            ++it;
+            continue;
+        }
+        readThread(it->second, &_exitedCounts[it->second.category]);
+        closeThread(&it->second);
+        it = _threads.erase(it);
+    }
+
+    long long untrackedThreads = 0;
+    for (auto&& live : liveThreads) {
+        // Threads are often named after they start, and some are renamed when they take on new
+        // work, so the name is read again at every sample.
+        auto tracked = _threads.find(live.first);
+        if (tracked != _threads.end()) {
+            updateCategory(&tracked->second, threadCategory(readThreadName(live.second)));
+            continue;
+        }
+        if (_threads.size() >= _maxThreads) {
+            ++untrackedThreads;
+            continue;
+        }
+
+        auto thread = openThread(live.first, threadCategory(readThreadName(live.second)));
+
+        // The thread may have exited since the directory was read.
+        if (std::all_of(thread.fds.begin(), thread.fds.end(), [](int fd) { return fd < 0; })) {
+            continue;
+        }
+        _threads.emplace(live.first, std::move(thread));
+    }
+
+    std::map<std::string, CategoryCounts> categories;
+    for (auto&& exited : _exitedCounts) {
+        categories[exited.first].counts = exited.second;
+    }
+    for (auto&& thread : _threads) {
+        auto& category = categories[thread.second.category];
+        ++category.threads;
+        readThread(thread.second, &category.counts);
+    }
+
+    for (auto&& category : categories) {
+        BSONObjBuilder subObjBuilder(builder->subobjStart(category.first));
+        subObjBuilder.append("threads", static_cast<long long>(category.second.threads));
+        for (std::size_t i = 0; i < kNumEvents; ++i) {
+            if (_supported[i]) {
+                subObjBuilder.append(kEvents[i].name,
+                                     static_cast<long long>(category.second.counts[i]));
+            }
+        }
+        subObjBuilder.doneFast();
+    }
+    builder->append("untrackedThreads", untrackedThreads);
+
+    return Status::OK();
+}
+
+}  // namespace mongo
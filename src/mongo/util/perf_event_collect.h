@@ -0,0 +1,162 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * PerfEventCollector counts CPU cycles, retired instructions, last level cache misses and context
+ * switches in every thread of this process with the Linux perf_event_open(2) interface, and
+ * outputs the totals grouped by thread category, so that a change in throughput can be told apart
+ * as a change in the amount of work done or in how fast the CPU did it.
+ *
+ * A thread's category is its name without any trailing number, so that all "conn" threads share
+ * one category. A thread which is renamed counts towards its new category from then on. Counts are
+ * cumulative, and include the threads which have since exited or been renamed.
+ *
+ * Output document:
+ * {
+ *   "conn" : {
+ *       "threads" : 12,
+ *       "cycles" : NumberLong(9355270368),
+ *       "instructions" : NumberLong(8121691544),
+ *       "llcMisses" : NumberLong(12086868),
+ *       "contextSwitches" : NumberLong(830934),
+ *   },
+ *   ...
+ *   "untrackedThreads" : 0
+ * }
+ *
+ * Counters which the hardware or the kernel does not support, for instance in virtual machines
+ * without a virtual PMU, are omitted.
+ */
+class PerfEventCollector {
+    MONGO_DISALLOW_COPYING(PerfEventCollector);
+
+public:
+    ~PerfEventCollector();
+
+    /**
+     * Create a PerfEventCollector which counts events in up to 'maxThreads' threads at a time.
+     * Each thread uses one file descriptor per event.
+     *
+     * Errors if none of the events can be counted, for instance because
+     * /proc/sys/kernel/perf_event_paranoid forbids it.
+     */
+    static StatusWith<std::unique_ptr<PerfEventCollector>> create(std::size_t maxThreads);
+
+    /**
+     * Start counting in the threads which have started since the last call, stop counting in the
+     * threads which have exited, and output the counts to builder.
+     */
+    Status collect(BSONObjBuilder* builder);
+
+    /**
+     * Get the category of the thread named 'threadName'.
+     * Public for use by unit tests only.
+     */
+    static std::string threadCategory(StringData threadName);
+
+private:
+    static constexpr std::size_t kNumEvents = 4;
+
+    using Counts = std::array<std::uint64_t, kNumEvents>;
+
+    /**
+     * The events counted in a thread. A file descriptor is -1 if the event is not supported.
+     * 'baseline' holds the counts already charged to the categories the thread had before it was
+     * last renamed.
+     */
+    struct ThreadCounters {
+        std::string category;
+        std::array<int, kNumEvents> fds;
+        Counts baseline{};
+    };
+
+    /**
+     * The totals of a thread category.
+     */
+    struct CategoryCounts {
+        std::size_t threads = 0;
+        Counts counts{};
+    };
+
+    PerfEventCollector(std::size_t maxThreads, std::array<bool, kNumEvents> supported);
+
+    /**
+     * Open the counters of thread 'tid'.
+     */
+    ThreadCounters openThread(pid_t tid, std::string category) const;
+
+    /**
+     * Add the counts of 'thread' since its baseline to 'counts'.
+     */
+    void readThread(const ThreadCounters& thread, Counts* counts) const;
+
+    /**
+     * If 'thread' has been renamed into another category, charge its counts so far to the old
+     * category and start counting towards the new one.
+     */
+    void updateCategory(ThreadCounters* thread, std::string category);
+
+    /**
+     * Close the counters of 'thread'.
+     */
+    static void closeThread(ThreadCounters* thread);
+
+private:
+    const std::size_t _maxThreads;
+
+    // Whether each event could be counted when the collector was created.
+    const std::array<bool, kNumEvents> _supported;
+
+    // The counters of the threads being counted, by thread id.
+    std::map<pid_t, ThreadCounters> _threads;
+
+    // The final counts of the threads which have exited, and the counts of renamed threads from
+    // before they were renamed, by category.
+    std::map<std::string, Counts> _exitedCounts;
+};
+
+}  // namespace mongo
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/perf_event_collect.h"
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+namespace {
+
+TEST(PerfEventCollectorTest, ThreadCategory) {
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("conn42"), "conn");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("conn"), "conn");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("repl writer worker 3"),
+                  "repl writer worker");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("thread-pool-12"), "thread-pool");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("WTJourn.Flusher"), "WTJourn_Flusher");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory("123"), "unknown");
+    ASSERT_EQUALS(PerfEventCollector::threadCategory(""), "unknown");
+}
+
+TEST(PerfEventCollectorTest, CountsByThreadCategory) {
+    auto swCollector = PerfEventCollector::create(64);
+    if (!swCollector.isOK()) {
+        // perf_event_open is not permitted on every test host.
+        unittest::log() << "Skipping test: " << swCollector.getStatus();
+        return;
+    }
+    auto collector = std::move(swCollector.getValue());
+
+    stdx::mutex mutex;
+    stdx::condition_variable condvar;
+    bool named = false;
+    bool done = false;
+
+    stdx::thread worker([&] {
+        setThreadName("perfworker7");
+        stdx::unique_lock<stdx::mutex> lock(mutex);
+        named = true;
+        condvar.notify_all();
+        condvar.wait(lock, [&] { return done; });
+    });
+
+    {
+        stdx::unique_lock<stdx::mutex> lock(mutex);
+        condvar.wait(lock, [&] { return named; });
+    }
+
+    BSONObjBuilder first;
+    ASSERT_OK(collector->collect(&first));
+    BSONObj firstObj = first.obj();
+    ASSERT_TRUE(firstObj["perfworker"].isABSONObj()) << firstObj;
+    ASSERT_EQUALS(firstObj["perfworker"]["threads"].numberLong(), 1) << firstObj;
+    ASSERT_EQUALS(firstObj["untrackedThreads"].numberLong(), 0) << firstObj;
+
+    {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        done = true;
+        condvar.notify_all();
+    }
+    worker.join();
+
+    // The counts of the exited thread remain.
+    BSONObjBuilder second;
+    ASSERT_OK(collector->collect(&second));
+    BSONObj secondObj = second.obj();
+    ASSERT_TRUE(secondObj["perfworker"].isABSONObj()) << secondObj;
+    ASSERT_EQUALS(secondObj["perfworker"]["threads"].numberLong(), 0) << secondObj;
+    for (auto&& element : firstObj["perfworker"].Obj()) {
+        ASSERT_GTE(secondObj["perfworker"].Obj()[element.fieldName()].numberLong(),
+                   element.numberLong())
+            << secondObj;
+    }
+}
+
+TEST(PerfEventCollectorTest, RenamedThreadMovesToNewCategory) {
+    auto swCollector = PerfEventCollector::create(64);
+    if (!swCollector.isOK()) {
+        unittest::log() << "Skipping test: " << swCollector.getStatus();
+        return;
+    }
+    auto collector = std::move(swCollector.getValue());
+
+    stdx::mutex mutex;
+    stdx::condition_variable condvar;
+    int step = 0;
+
+    // The worker names itself, waits for the first sample, then renames itself.
+    stdx::thread worker([&] {
+        stdx::unique_lock<stdx::mutex> lock(mutex);
+        setThreadName("perfbefore1");
+        step = 1;
+        condvar.notify_all();
+        condvar.wait(lock, [&] { return step == 2; });
+        setThreadName("perfafter1");
+        step = 3;
+        condvar.notify_all();
+        condvar.wait(lock, [&] { return step == 4; });
+    });
+
+    BSONObjBuilder first;
+    {
+        stdx::unique_lock<stdx::mutex> lock(mutex);
+        condvar.wait(lock, [&] { return step == 1; });
+        ASSERT_OK(collector->collect(&first));
+        step = 2;
+        condvar.notify_all();
+        condvar.wait(lock, [&] { return step == 3; });
+    }
+    BSONObj firstObj = first.obj();
+    ASSERT_EQUALS(firstObj["perfbefore"]["threads"].numberLong(), 1) << firstObj;
+
+    BSONObjBuilder second;
+    ASSERT_OK(collector->collect(&second));
+    BSONObj secondObj = second.obj();
+
+    {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        step = 4;
+        condvar.notify_all();
+    }
+    worker.join();
+
+    // The counts from before the rename stay with the old category.
+    ASSERT_EQUALS(secondObj["perfbefore"]["threads"].numberLong(), 0) << secondObj;
+    ASSERT_EQUALS(secondObj["perfafter"]["threads"].numberLong(), 1) << secondObj;
+    for (auto&& element : firstObj["perfbefore"].Obj()) {
+        ASSERT_GTE(secondObj["perfbefore"].Obj()[element.fieldName()].numberLong(),
+                   element.numberLong())
+            << secondObj;
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -80,6 +80,13 @@ public:
         return bool(_holder);
     }
 
+    /**
+     * Returns true if other SharedBuffer instances share this buffer.
+     */
+    bool isShared() const {
+        return _holder && _holder->isShared();
+    }
+
 private:
     class Holder {
     public:
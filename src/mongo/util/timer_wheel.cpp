@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/timer_wheel.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+constexpr TimerWheel::TimerId TimerWheel::kNoTimer;
+constexpr std::size_t TimerWheel::kLevels;
+constexpr std::size_t TimerWheel::kSlotBits;
+constexpr std::size_t TimerWheel::kSlots;
+
+TimerWheel::TimerWheel(Date_t start, Milliseconds resolution)
+    : _start(start), _resolution(resolution) {
+    invariant(_resolution > Milliseconds(0));
+}
+
+std::uint64_t TimerWheel::tickAt(Date_t date) const {
+    if (date <= _start) {
+        return 0;
+    }
+    return durationCount<Milliseconds>(date - _start) / durationCount<Milliseconds>(_resolution);
+}
+
+TimerWheel::TimerId TimerWheel::arm(Date_t deadline, Callback callback) {
+    // Round up, so that the timer does not expire before its deadline.
+    std::uint64_t expiry = tickAt(deadline);
+    if (_start + _resolution * static_cast<long long>(expiry) < deadline) {
+        ++expiry;
+    }
+
+    const auto id = _nextId++;
+    auto& timer = _timers[id];
+    timer.expiry = std::max(expiry, _currentTick);
+    timer.callback = std::move(callback);
+    insert(id, &timer);
+    return id;
+}
+
+bool TimerWheel::disarm(TimerId id) {
+    auto it = _timers.find(id);
+    if (it == _timers.end()) {
+        return false;
+    }
+    auto& timer = it->second;
+    _wheels[timer.level][timer.slot].erase(timer.position);
+    _timers.erase(it);
+    return true;
+}
+
+void TimerWheel::insert(TimerId id, Timer* timer) {
+    // Timers beyond the range of the wheels wait in the last slot of the highest level until they
+    // come within it.
+    const std::uint64_t delta = timer->expiry - _currentTick;
+    const std::uint64_t maxDelta = (std::uint64_t(1) << (kSlotBits * kLevels)) - 1;
+    const std::uint64_t expiry = _currentTick + std::min(delta, maxDelta);
+
+    std::size_t level = 0;
+    while (level + 1 < kLevels && delta >= (std::uint64_t(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    timer->level = level;
+    timer->slot = slotAt(level, expiry);
+    auto& slot = _wheels[level][timer->slot];
+    timer->position = slot.insert(slot.end(), id);
+}
+
+void TimerWheel::cascade(std::size_t level, std::size_t slot) {
+    Slot timers;
+    timers.swap(_wheels[level][slot]);
+    for (auto id : timers) {
+        insert(id, &_timers[id]);
+    }
+}
+
+std::vector<std::pair<TimerWheel::TimerId, TimerWheel::Callback>> TimerWheel::advance(Date_t now) {
+    std::vector<std::pair<TimerId, Callback>> expired;
+    const std::uint64_t endTick = tickAt(now) + 1;
+
+    while (_currentTick < endTick) {
+        // Skip the ticks at which there is nothing to do.
+        auto nextTick = nextActiveTick();
+        if (!nextTick || *nextTick >= endTick) {
+            _currentTick = endTick;
+            break;
+        }
+        _currentTick = *nextTick;
+
+        for (std::size_t level = kLevels - 1; level > 0; --level) {
+            const auto mask = (std::uint64_t(1) << (kSlotBits * level)) - 1;
+            if ((_currentTick & mask) == 0) {
+                cascade(level, slotAt(level, _currentTick));
+            }
+        }
+
+        Slot timers;
+        timers.swap(_wheels[0][slotAt(0, _currentTick)]);
+        for (auto id : timers) {
+            auto it = _timers.find(id);
+            expired.emplace_back(id, std::move(it->second.callback));
+            _timers.erase(it);
+        }
+
+        ++_currentTick;
+    }
+
+    return expired;
+}
+
+boost::optional<std::uint64_t> TimerWheel::nextActiveTick() const {
+    if (_timers.empty()) {
+        return boost::none;
+    }
+
+    boost::optional<std::uint64_t> next;
+    for (std::size_t k = 0; k < kSlots; ++k) {
+        if (!_wheels[0][slotAt(0, _currentTick + k)].empty()) {
+            next = _currentTick + k;
+            break;
+        }
+    }
+
+    // The timers of a level L slot are moved at the first tick of the block of kSlots^L ticks the
+    // slot is for. The current block's slot has already been moved, unless it starts now.
+    for (std::size_t level = 1; level < kLevels; ++level) {
+        const auto shift = kSlotBits * level;
+        const std::uint64_t block = _currentTick >> shift;
+        const bool blockStartsNow = (block << shift) == _currentTick;
+        for (std::size_t k = blockStartsNow ? 0 : 1; k <= kSlots; ++k) {
+            const std::uint64_t tick = (block + k) << shift;
+            if (next && tick >= *next) {
+                break;
+            }
+            if (!_wheels[level][slotAt(level, tick)].empty()) {
+                next = tick;
+                break;
+            }
+        }
+    }
+
+    invariant(next);
+    return next;
+}
+
+boost::optional<Date_t> TimerWheel::nextWakeup() const {
+    auto nextTick = nextActiveTick();
+    if (!nextTick) {
+        return boost::none;
+    }
+    return _start + _resolution * static_cast<long long>(*nextTick);
+}
+
+}  // namespace mongo
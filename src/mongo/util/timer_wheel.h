@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * A hierarchical timer wheel, which keeps timers so that arming and disarming one takes constant
+ * time however many are armed, and finding the expired ones takes time proportional to how many
+ * have expired rather than to how many are armed.
+ *
+ * Time is divided into ticks of 'resolution'. There are kLevels wheels of kSlots slots each: a
+ * slot of level 0 holds the timers which expire in one tick, and a slot of level L holds the
+ * timers which expire in one of kSlots^L consecutive ticks. As time advances past the start of a
+ * level L slot's ticks, its timers are moved to lower levels. Timers beyond the range of the
+ * wheels wait in the highest level until they come within it.
+ *
+ * A timer never expires before its deadline, and expires at most one tick after it if advance()
+ * is called on time.
+ *
+ * Not thread-safe.
+ */
+class TimerWheel {
+    MONGO_DISALLOW_COPYING(TimerWheel);
+
+public:
+    using TimerId = std::uint64_t;
+    using Callback = stdx::function<void()>;
+
+    // Never returned by arm().
+    static constexpr TimerId kNoTimer = 0;
+
+    static constexpr std::size_t kLevels = 4;
+    static constexpr std::size_t kSlotBits = 6;
+    static constexpr std::size_t kSlots = 1 << kSlotBits;
+
+    TimerWheel(Date_t start, Milliseconds resolution);
+
+    /**
+     * Arms a timer which expires at 'deadline'. A deadline which has already passed expires at the
+     * next call to advance().
+     */
+    TimerId arm(Date_t deadline, Callback callback);
+
+    /**
+     * Disarms a timer. Returns false if it has already expired or been disarmed.
+     */
+    bool disarm(TimerId id);
+
+    /**
+     * Advances the time to 'now', and removes and returns the timers which have expired, in the
+     * order of their deadlines.
+     */
+    std::vector<std::pair<TimerId, Callback>> advance(Date_t now);
+
+    /**
+     * Returns the time advance() next needs to be called at to expire timers on time, or none if
+     * no timers are armed.
+     */
+    boost::optional<Date_t> nextWakeup() const;
+
+    std::size_t size() const {
+        return _timers.size();
+    }
+
+private:
+    using Slot = std::list<TimerId>;
+
+    struct Timer {
+        std::uint64_t expiry;
+        Callback callback;
+        std::size_t level;
+        std::size_t slot;
+        Slot::iterator position;
+    };
+
+    static std::size_t slotAt(std::size_t level, std::uint64_t tick) {
+        return (tick >> (kSlotBits * level)) & (kSlots - 1);
+    }
+
+    std::uint64_t tickAt(Date_t date) const;
+
+    /**
+     * Places 'timer' in the slot for its expiry relative to the current tick.
+     */
+    void insert(TimerId id, Timer* timer);
+
+    /**
+     * Moves the timers of 'level' at 'slot' to the slots for their expiry.
+     */
+    void cascade(std::size_t level, std::size_t slot);
+
+    /**
+     * Returns the first tick, not before the current one, at which a timer expires or is moved to
+     * a lower level, or none if no timers are armed.
+     */
+    boost::optional<std::uint64_t> nextActiveTick() const;
+
+    const Date_t _start;
+    const Milliseconds _resolution;
+
+    // The first tick which has not been processed.
+    std::uint64_t _currentTick = 0;
+
+    TimerId _nextId = kNoTimer + 1;
+
+    stdx::unordered_map<TimerId, Timer> _timers;
+    std::array<std::array<Slot, kSlots>, kLevels> _wheels;
+};
+
+}  // namespace mongo
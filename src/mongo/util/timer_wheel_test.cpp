@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/timer_wheel.h"
+
+#include <map>
+#include <random>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1000000);
+
+TEST(TimerWheelTest, ExpiresAtDeadline) {
+    TimerWheel wheel(kStart, Milliseconds(1));
+    int fired = 0;
+    wheel.arm(kStart + Milliseconds(100), [&] { ++fired; });
+    ASSERT_EQUALS(wheel.size(), 1U);
+
+    ASSERT_TRUE(wheel.advance(kStart + Milliseconds(99)).empty());
+    auto expired = wheel.advance(kStart + Milliseconds(100));
+    ASSERT_EQUALS(expired.size(), 1U);
+    expired[0].second();
+    ASSERT_EQUALS(fired, 1);
+    ASSERT_EQUALS(wheel.size(), 0U);
+    ASSERT_FALSE(wheel.nextWakeup());
+}
+
+TEST(TimerWheelTest, RoundsDeadlinesUp) {
+    TimerWheel wheel(kStart, Milliseconds(10));
+    wheel.arm(kStart + Milliseconds(15), [] {});
+    ASSERT_TRUE(wheel.advance(kStart + Milliseconds(19)).empty());
+    ASSERT_EQUALS(wheel.advance(kStart + Milliseconds(20)).size(), 1U);
+}
+
+TEST(TimerWheelTest, PastDeadlineExpiresAtNextAdvance) {
+    TimerWheel wheel(kStart, Milliseconds(1));
+    ASSERT_TRUE(wheel.advance(kStart + Milliseconds(500)).empty());
+    auto id = wheel.arm(kStart, [] {});
+    auto expired = wheel.advance(kStart + Milliseconds(501));
+    ASSERT_EQUALS(expired.size(), 1U);
+    ASSERT_EQUALS(expired[0].first, id);
+}
+
+TEST(TimerWheelTest, Disarm) {
+    TimerWheel wheel(kStart, Milliseconds(1));
+    auto id = wheel.arm(kStart + Seconds(10), [] {});
+    ASSERT_TRUE(wheel.disarm(id));
+    ASSERT_FALSE(wheel.disarm(id));
+    ASSERT_FALSE(wheel.disarm(TimerWheel::kNoTimer));
+    ASSERT_TRUE(wheel.advance(kStart + Seconds(20)).empty());
+}
+
+TEST(TimerWheelTest, ExpiresTimersBeyondRangeOnTime) {
+    TimerWheel wheel(kStart, Milliseconds(1));
+    const auto deadline = kStart + Hours(10);
+    auto id = wheel.arm(deadline, [] {});
+
+    // Follow nextWakeup() as a scheduler would.
+    std::size_t wakeups = 0;
+    while (auto next = wheel.nextWakeup()) {
+        ASSERT_LTE(*next, deadline);
+        auto expired = wheel.advance(*next);
+        ++wakeups;
+        if (!expired.empty()) {
+            ASSERT_EQUALS(expired[0].first, id);
+            ASSERT_EQUALS(*next, deadline);
+        }
+    }
+    ASSERT_LT(wakeups, 50U);
+}
+
+TEST(TimerWheelTest, RandomDeadlines) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<long long> deadlineDist(0, 20 * 1000 * 1000);
+    std::uniform_int_distribution<long long> stepDist(1, 300 * 1000);
+
+    TimerWheel wheel(kStart, Milliseconds(1));
+    std::map<TimerWheel::TimerId, Date_t> deadlines;
+    for (int i = 0; i < 2000; ++i) {
+        auto deadline = kStart + Milliseconds(deadlineDist(gen));
+        deadlines[wheel.arm(deadline, [] {})] = deadline;
+    }
+
+    // Disarm every third timer.
+    std::size_t count = 0;
+    for (auto it = deadlines.begin(); it != deadlines.end(); ++count) {
+        if (count % 3 == 0) {
+            ASSERT_TRUE(wheel.disarm(it->first));
+            it = deadlines.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    Date_t previous = kStart;
+    Date_t now = kStart;
+    while (!deadlines.empty()) {
+        now += Milliseconds(stepDist(gen));
+        for (auto&& expired : wheel.advance(now)) {
+            auto it = deadlines.find(expired.first);
+            ASSERT_TRUE(it != deadlines.end());
+            ASSERT_LTE(it->second, now);
+            ASSERT_GT(it->second, previous);
+            deadlines.erase(it);
+        }
+        for (auto&& pending : deadlines) {
+            ASSERT_GT(pending.second, now);
+        }
+        previous = now;
+    }
+    ASSERT_EQUALS(wheel.size(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo